@@ -102,6 +102,19 @@ PatchTree::PatchTree() :
 PatchTree::~PatchTree() {
 }
 
+Far::MemoryUsage
+PatchTree::GetMemoryUsage() const {
+
+    Far::MemoryUsage usage("PatchTree");
+    usage.Add(sizeof(PatchTree), sizeof(PatchTree));
+    usage.Add(_patchPoints);
+    usage.Add(_patchParams);
+    usage.Add(_treeNodes);
+    usage.Add(_stencilMatrixFloat);
+    usage.Add(_stencilMatrixDouble);
+    return usage;
+}
+
 
 //
 //  Class methods supporting access to patches:
@@ -245,7 +258,7 @@ PatchTree::evalSubPatchStencils(int patchIndex, REAL u, REAL v,
                 sDvv[pIndex] += wDvv[i];
             }
         } else {
-            std::vector<REAL_MATRIX> const & pStencilMtx =
+            Vector<REAL_MATRIX> const & pStencilMtx =
                 getStencilMatrix<REAL_MATRIX>();
             assert(!pStencilMtx.empty());
 
@@ -421,6 +434,12 @@ PatchTree::buildQuadtree() {
             }
         }
     }
+
+    //  Release the excess of the initial estimate of the number of nodes,
+    //  as trees are retained (and potentially cached) once built:
+    if (_treeNodes.capacity() > _treeNodes.size()) {
+        Vector<TreeNode>(_treeNodes).swap(_treeNodes);
+    }
 }
 
 int
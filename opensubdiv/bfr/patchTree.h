@@ -27,8 +27,10 @@
 
 #include "../version.h"
 
+#include "../far/memoryUsage.h"
 #include "../far/patchDescriptor.h"
 #include "../far/patchParam.h"
+#include "../vtr/allocator.h"
 #include "../vtr/array.h"
 
 #include <vector>
@@ -91,6 +93,9 @@ public:
 
     int FindSubPatch(double u, double v, int subFace=0, int maxDep=-1) const;
 
+    //  Memory used and allocated (all vectors are allocated to size):
+    Far::MemoryUsage GetMemoryUsage() const;
+
     typedef Vtr::ConstArray<int> PatchPointArray;
     PatchPointArray GetSubPatchPoints(int subPatch) const;
     Far::PatchParam GetSubPatchParam( int subPatch) const;
@@ -110,11 +115,14 @@ protected:
     PatchTree();
     friend class PatchTreeBuilder;
 
+    //  Vectors of members allocate through the assigned Vtr::Allocator:
+    template <typename T> using Vector = Vtr::internal::Vector<T>;
+
     //
     //  Internal utilities to support the stencil matrix of variable precision
     //
-    template <typename REAL> std::vector<REAL> const & getStencilMatrix() const;
-    template <typename REAL> std::vector<REAL>       & getStencilMatrix();
+    template <typename REAL> Vector<REAL> const & getStencilMatrix() const;
+    template <typename REAL> Vector<REAL>       & getStencilMatrix();
 
     template <typename REAL_MATRIX, typename REAL>
     int evalSubPatchStencils(int subPatch, REAL u, REAL v, REAL s[],
@@ -180,17 +188,17 @@ private:
     //  separate "patch arrays" or separated in other ways and managed with
     //  a bit more book-keeping.
     //
-    std::vector<int>             _patchPoints;
-    std::vector<Far::PatchParam> _patchParams;
+    Vector<int>             _patchPoints;
+    Vector<Far::PatchParam> _patchParams;
 
     //  The quadtree organizing the patches:
-    std::vector<TreeNode>  _treeNodes;
-    int                    _treeDepth;
+    Vector<TreeNode>  _treeNodes;
+    int               _treeDepth;
 
     //  Array of stencils for computing patch points from control points
     //  (single or double to be used as specified on construction):
-    std::vector<float>  _stencilMatrixFloat;
-    std::vector<double> _stencilMatrixDouble;
+    Vector<float>  _stencilMatrixFloat;
+    Vector<double> _stencilMatrixDouble;
 };
 
 //
@@ -199,25 +207,25 @@ private:
 //  while non-const access may be used to populate it.
 //
 template <>
-inline std::vector<float> const &
+inline PatchTree::Vector<float> const &
 PatchTree::getStencilMatrix<float>() const {
     assert(!_stencilMatrixFloat.empty());
     return _stencilMatrixFloat;
 }
 template <>
-inline std::vector<double> const &
+inline PatchTree::Vector<double> const &
 PatchTree::getStencilMatrix<double>() const {
     assert(!_stencilMatrixDouble.empty());
     return _stencilMatrixDouble;
 }
 
 template <>
-inline std::vector<float> &
+inline PatchTree::Vector<float> &
 PatchTree::getStencilMatrix<float>() {
     return _stencilMatrixFloat;
 }
 template <>
-inline std::vector<double> &
+inline PatchTree::Vector<double> &
 PatchTree::getStencilMatrix<double>() {
     return _stencilMatrixDouble;
 }
@@ -459,7 +459,7 @@ PatchTreeBuilder::initializeStencilMatrix() {
                            _patchTree->_irregPatchSize);
     int numControlPoints = _patchTree->_numControlPoints;
 
-    std::vector<REAL> & stencilMatrix = _patchTree->getStencilMatrix<REAL>();
+    PatchTree::Vector<REAL> & stencilMatrix = _patchTree->getStencilMatrix<REAL>();
 
     stencilMatrix.resize(numPointStencils*numControlPoints);
 
@@ -520,7 +520,7 @@ PatchTreeBuilder::appendConversionStencilsToMatrix(
     int numControlPoints = _patchTree->_numControlPoints;
     int numPatchPoints   = conversionMatrix.GetNumRows();
 
-    std::vector<REAL> & stencilMatrix = _patchTree->getStencilMatrix<REAL>();
+    PatchTree::Vector<REAL> & stencilMatrix = _patchTree->getStencilMatrix<REAL>();
 
     StencilRow<REAL> srcStencils(&stencilMatrix[0], numControlPoints);
     StencilRow<REAL> dstStencils = srcStencils[stencilBaseIndex];
@@ -29,6 +29,7 @@
 #include "../far/patchParam.h"
 #include "../far/patchDescriptor.h"
 #include "../far/patchBasis.h"
+#include "../vtr/stackBuffer.h"
 
 #include <algorithm>
 #include <cassert>
@@ -612,6 +613,174 @@ Surface<REAL>::evalMultiLinearDerivs(REAL const uv[],
 }
 
 
+//
+//  Evaluation methods for grids of locations:
+//
+template <typename REAL>
+void
+Surface<REAL>::evaluateGridDerivs(int numU, REAL const u[],
+        int numV, REAL const v[],
+        REAL const patchPoints[], PointDescriptor const & pointDesc,
+        REAL * deriv[]) const {
+
+    if ((numU <= 0) || (numV <= 0)) return;
+
+    if (IsRegular() && ((getRegPatchType() == Far::PatchDescriptor::REGULAR) ||
+                        (getRegPatchType() == Far::PatchDescriptor::QUADS))) {
+        evalSeparableGridDerivs(numU, u, numV, v, patchPoints, pointDesc,
+                                deriv);
+        return;
+    }
+
+    //
+    //  Evaluate all other Surfaces independently at each location:
+    //
+    int pSize = pointDesc.size;
+    bool hasDerivs = deriv[1] && deriv[2];
+
+    for (int j = 0, k = 0; j < numV; ++j) {
+        for (int i = 0; i < numU; ++i, ++k) {
+            REAL uv[2] = { u[i], v[j] };
+
+            REAL * derivAtUV[6] = { deriv[0] + k * pSize, 0, 0, 0, 0, 0 };
+            if (hasDerivs) {
+                derivAtUV[1] = deriv[1] + k * pSize;
+                derivAtUV[2] = deriv[2] + k * pSize;
+            }
+            evaluateDerivs(uv, patchPoints, pointDesc, derivAtUV);
+        }
+    }
+}
+
+template <typename REAL>
+void
+Surface<REAL>::evalSeparableGridDerivs(int numU, REAL const u[],
+        int numV, REAL const v[],
+        REAL const patchPoints[], PointDescriptor const & pointDesc,
+        REAL * deriv[]) const {
+
+    //
+    //  The basis of the patch is the tensor product of a curve basis in
+    //  each direction, so its evaluation at (u,v) can be expressed as a
+    //  combination of the patch points of each row with the weights for
+    //  v, followed by a combination of the resulting row points with the
+    //  weights for u.  Each row is combined once for all locations with
+    //  the same v and each set of curve weights evaluated once.
+    //
+    int  pSize     = pointDesc.size;
+    bool hasDerivs = deriv[1] && deriv[2];
+
+    Far::PatchParam patchParam;
+    patchParam.Set(0, 0, 0, 0, 0, getRegPatchMask(), 0, true);
+
+    int patchType = getRegPatchType();
+
+    //
+    //  Evaluate the curve weights (and their derivatives) for all u and v
+    //  coordinates -- four for the B-spline curve and two for linear:
+    //
+    int nW = (patchType == Far::PatchDescriptor::REGULAR) ? 4 : 2;
+
+    Vtr::internal::StackBuffer<REAL, 2 * 4 * 32, true>
+        wBuffer(2 * nW * (numU + numV));
+
+    REAL * wU  = wBuffer;
+    REAL * wDU = wU  + nW * numU;
+    REAL * wV  = wDU + nW * numU;
+    REAL * wDV = wV  + nW * numV;
+
+    for (int i = 0; i < numU; ++i) {
+        Far::internal::EvaluatePatchBasisCurveNormalized(patchType,
+            patchParam, 0, u[i], wU + i * nW, hasDerivs ? wDU + i * nW : 0);
+    }
+    for (int j = 0; j < numV; ++j) {
+        Far::internal::EvaluatePatchBasisCurveNormalized(patchType,
+            patchParam, 1, v[j], wV + j * nW, hasDerivs ? wDV + j * nW : 0);
+    }
+
+    //
+    //  Identify the patch points of each column -- patch points of the
+    //  B-spline patch are ordered by row while those of the linear quad
+    //  are ordered counter-clockwise:
+    //
+    int columnPoints[4][4];
+    for (int col = 0; col < nW; ++col) {
+        for (int row = 0; row < nW; ++row) {
+            columnPoints[col][row] = (nW == 4) ? (4 * row + col) :
+                                     (row ? (3 - col) : col);
+        }
+    }
+
+    //
+    //  Points combined for each row (and their derivatives with respect
+    //  to v) are stored consecutively:
+    //
+    Vtr::internal::StackBuffer<REAL, 2 * 4 * 4, true>
+        rowBuffer(2 * nW * pSize);
+
+    REAL * rowP  = rowBuffer;
+    REAL * rowDv = rowP + nW * pSize;
+
+    points::CommonCombinationParameters<REAL> rowParams;
+    rowParams.pointData   = patchPoints;
+    rowParams.pointSize   = pSize;
+    rowParams.pointStride = pointDesc.stride;
+    rowParams.srcCount    = nW;
+
+    points::CommonCombinationParameters<REAL> gridParams;
+    gridParams.pointSize   = pSize;
+    gridParams.pointStride = pSize;
+    gridParams.srcCount    = nW;
+    gridParams.srcIndices  = 0;
+
+    for (int j = 0, k = 0; j < numV; ++j) {
+        REAL const * wRow[2] = { wV + j * nW, wDV + j * nW };
+
+        for (int col = 0; col < nW; ++col) {
+            REAL * pRow[2] = { rowP + col * pSize, rowDv + col * pSize };
+
+            rowParams.srcIndices  = columnPoints[col];
+            rowParams.resultCount = hasDerivs ? 2 : 1;
+            rowParams.resultArray = pRow;
+            rowParams.weightArray = wRow;
+
+            if (hasDerivs) {
+                points::CombineMultiple<REAL>::Apply(rowParams);
+            } else {
+                points::Combine1<REAL>::Apply(rowParams);
+            }
+        }
+
+        for (int i = 0; i < numU; ++i, ++k) {
+            REAL const * wGrid[2] = { wU + i * nW, wDU + i * nW };
+
+            REAL * pGrid[2] = { deriv[0] + k * pSize, 0 };
+            if (hasDerivs) {
+                pGrid[1] = deriv[1] + k * pSize;
+            }
+
+            gridParams.pointData   = rowP;
+            gridParams.resultCount = hasDerivs ? 2 : 1;
+            gridParams.resultArray = pGrid;
+            gridParams.weightArray = wGrid;
+
+            if (hasDerivs) {
+                points::CombineMultiple<REAL>::Apply(gridParams);
+
+                REAL * pDv = deriv[2] + k * pSize;
+
+                gridParams.pointData   = rowDv;
+                gridParams.resultCount = 1;
+                gridParams.resultArray = &pDv;
+
+                points::Combine1<REAL>::Apply(gridParams);
+            } else {
+                points::Combine1<REAL>::Apply(gridParams);
+            }
+        }
+    }
+}
+
 //
 //  Public methods to apply stencils:
 //
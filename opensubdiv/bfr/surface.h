@@ -240,6 +240,36 @@ public:
                   REAL Duu[], REAL Duv[], REAL Dvv[]) const;
     //@}
 
+    //@{
+    /// @name Evaluation of grids of positions and derivatives
+    ///
+    /// Grid evaluation methods evaluate the Surface at all locations of a
+    /// grid, i.e. the tensor product of an array of u coordinates and an
+    /// array of v coordinates, as is common for tessellation and baking.
+    ///
+    /// When the Surface is a single regular patch whose basis is separable
+    /// (the bicubic B-spline patch of a regular quad or a bilinear quad),
+    /// the basis is evaluated once for each u and each v coordinate rather
+    /// than for each location, and the patch points are combined by row
+    /// before the results of each row are combined at each location.  All
+    /// other Surfaces are evaluated independently at each location.
+    ///
+    /// Results for the location (u[i], v[j]) are written at index
+    /// (j * numU + i) of the output arrays, with pointDesc.size values
+    /// written for each location.
+    ///
+
+    /// @brief Evaluation of a grid of positions
+    void EvaluateGrid(int numU, REAL const u[], int numV, REAL const v[],
+                      REAL const patchPoints[], PointDescriptor const & pointDesc,
+                      REAL P[]) const;
+
+    /// @brief Overload of grid evaluation for 1st derivatives
+    void EvaluateGrid(int numU, REAL const u[], int numV, REAL const v[],
+                      REAL const patchPoints[], PointDescriptor const & pointDesc,
+                      REAL P[], REAL Du[], REAL Dv[]) const;
+    //@}
+
     //@{
     /// @name Evaluation and application of limit stencils
     ///
@@ -291,6 +321,14 @@ private:
     void evalMultiLinearDerivs(REAL const uv[2], REAL const patchPoints[],
                                PointDescriptor const &, REAL * derivs[]) const;
 
+    void evaluateGridDerivs(int numU, REAL const u[], int numV, REAL const v[],
+                            REAL const patchPoints[],
+                            PointDescriptor const &, REAL * derivs[]) const;
+    void evalSeparableGridDerivs(int numU, REAL const u[],
+                                 int numV, REAL const v[],
+                                 REAL const patchPoints[],
+                                 PointDescriptor const &, REAL * derivs[]) const;
+
     void       evalRegularBasis(REAL const uv[2], REAL * wDeriv[]) const;
     IndexArray evalIrregularBasis(REAL const uv[2], REAL * wDeriv[]) const;
     int        evalMultiLinearBasis(REAL const uv[2], REAL * wDeriv[]) const;
@@ -399,6 +437,27 @@ Surface<REAL>::Evaluate(REAL const uv[2],
     evaluateDerivs(uv, patchPoints, pointDesc, derivatives);
 }
 
+template <typename REAL>
+inline void
+Surface<REAL>::EvaluateGrid(int numU, REAL const u[], int numV, REAL const v[],
+                            REAL const patchPoints[],
+                            PointDescriptor const & pointDesc,
+                            REAL P[]) const {
+
+    REAL * derivatives[3] = { P, 0, 0 };
+    evaluateGridDerivs(numU, u, numV, v, patchPoints, pointDesc, derivatives);
+}
+template <typename REAL>
+inline void
+Surface<REAL>::EvaluateGrid(int numU, REAL const u[], int numV, REAL const v[],
+                            REAL const patchPoints[],
+                            PointDescriptor const & pointDesc,
+                            REAL P[], REAL Du[], REAL Dv[]) const {
+
+    REAL * derivatives[3] = { P, Du, Dv };
+    evaluateGridDerivs(numU, u, numV, v, patchPoints, pointDesc, derivatives);
+}
+
 template <typename REAL>
 inline int
 Surface<REAL>::evaluateStencils(REAL const uv[2], REAL * sDeriv[]) const {
@@ -32,6 +32,7 @@
 #include "../bfr/regularPatchBuilder.h"
 #include "../bfr/irregularPatchBuilder.h"
 #include "../bfr/patchTree.h"
+#include "../far/instrumentation.h"
 
 #include <map>
 #include <cstdio>
@@ -716,6 +717,7 @@ SurfaceFactory::assignLinearSurface(SurfaceType * surfacePtr,
     if (count < faceSize) return;
 
     surface.setValid(true);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_BFR_LINEAR_SURFACES, 1);
 #ifdef _BFR_DEBUG_TOP_TYPE_STATS
 __numLinearPatches ++;
 #endif
@@ -763,6 +765,7 @@ SurfaceFactory::assignRegularSurface(SurfaceType * surfacePtr,
     }
 
     surface.setValid(true);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_BFR_REGULAR_SURFACES, 1);
 #ifdef _BFR_DEBUG_TOP_TYPE_STATS
 __numExpRegularPatches ++;
 #endif
@@ -797,6 +800,7 @@ SurfaceFactory::assignRegularSurface(SurfaceType * surfacePtr,
             surface.resizeCVs(builder.GetNumControlVertices()));
 
     surface.setValid(true);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_BFR_REGULAR_SURFACES, 1);
 #ifdef _BFR_DEBUG_TOP_TYPE_STATS
 __numRegularPatches ++;
 #endif
@@ -824,6 +828,7 @@ SurfaceFactory::assignIrregularSurface(SurfaceType * surfacePtr,
     internal::IrregularPatchSharedPtr patch(0);
 
     if (_topologyCache == 0) {
+        OPENSUBDIV_INSTRUMENT_TIMER(TIMER_BUILD_IRREGULAR_PATCH, -1);
         patch = builder.Build();
     } else {
         //
@@ -840,10 +845,14 @@ SurfaceFactory::assignIrregularSurface(SurfaceType * surfacePtr,
 
         patch = _topologyCache->Find(key);
         if (patch == 0) {
+            OPENSUBDIV_INSTRUMENT_TIMER(TIMER_BUILD_IRREGULAR_PATCH, -1);
+            OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_BFR_CACHE_MISSES, 1);
             patch = _topologyCache->Add(key, builder.Build());
 #ifdef _BFR_DEBUG_TOP_TYPE_STATS
 __numIrregularInCache ++;
 #endif
+        } else {
+            OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_BFR_CACHE_HITS, 1);
         }
     }
 
@@ -864,6 +873,7 @@ __numIrregularInCache ++;
             surface.resizeCVs(patch->GetNumControlPoints()));
 
     surface.setValid(true);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_BFR_IRREGULAR_SURFACES, 1);
 #ifdef _BFR_DEBUG_TOP_TYPE_STATS
 __numIrregularPatches  ++;
 __numIrregularUncached += surface.ownsIrregPatch();
@@ -902,6 +912,7 @@ SurfaceFactory::copyNonLinearSurface(
         assert(builder.GetNumControlVertices() == surfaceDst.getNumCVs());
 
         builder.GatherControlVertexIndices(surfaceDst.getCVIndices());
+        OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_BFR_REGULAR_SURFACES, 1);
 #ifdef _BFR_DEBUG_TOP_TYPE_STATS
 __numRegularPatches ++;
 #endif
@@ -912,6 +923,7 @@ __numRegularPatches ++;
         assert(builder.GetNumControlVertices() == surfaceDst.getNumCVs());
 
         builder.GatherControlVertexIndices(surfaceDst.getCVIndices());
+        OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_BFR_IRREGULAR_SURFACES, 1);
 #ifdef _BFR_DEBUG_TOP_TYPE_STATS
 __numIrregularPatches  ++;
 #endif
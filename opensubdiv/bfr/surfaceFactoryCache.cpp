@@ -73,6 +73,38 @@ SurfaceFactoryCache::Add(KeyType const & key, DataType const & data) {
     return add(key, data);
 }
 
+Far::MemoryUsage
+SurfaceFactoryCache::GetMemoryUsage() const {
+
+    return getMemoryUsage();
+}
+
+//
+//  Memory usage of the map is estimated from the size of its entries and
+//  the typical overhead of a node in a balanced tree (three pointers and
+//  a color, padded):
+//
+Far::MemoryUsage
+SurfaceFactoryCache::getMemoryUsage() const {
+
+    Far::MemoryUsage usage("SurfaceFactoryCache");
+
+    size_t entrySize = sizeof(MapType::value_type) + 4 * sizeof(void *);
+
+    usage.Add(sizeof(*this), sizeof(*this));
+    usage.Add(_map.size() * entrySize, _map.size() * entrySize);
+
+    Far::MemoryUsage patchUsage("IrregularPatches");
+    for (MapType::const_iterator it = _map.begin(); it != _map.end(); ++it) {
+        if (it->second) {
+            Far::MemoryUsage treeUsage = it->second->GetMemoryUsage();
+            patchUsage.Add(treeUsage.used, treeUsage.allocated);
+        }
+    }
+    usage.AddComponent(patchUsage);
+    return usage;
+}
+
 } // end namespace Bfr
 
 } // end namespace OPENSUBDIV_VERSION
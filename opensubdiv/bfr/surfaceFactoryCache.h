@@ -28,6 +28,7 @@
 #include "../version.h"
 
 #include "../bfr/irregularPatchType.h"
+#include "../far/memoryUsage.h"
 
 #include <map>
 #include <cstdint>
@@ -46,8 +47,9 @@ namespace Bfr {
 /// so that they can be quickly identified and retrieved for reuse.
 ///
 /// It is intended for internal use by SurfaceFactory.  Public access is
-/// available but limited to construction only -- allowing an instance to
-/// be reused by assigning it to more than one SurfaceFactory.
+/// available but limited to construction -- allowing an instance to be
+/// reused by assigning it to more than one SurfaceFactory -- and to the
+/// inspection of its memory usage.
 ///
 //
 //  Initial/expected use requires simple searches of and additions to the
@@ -64,6 +66,14 @@ public:
     SurfaceFactoryCache(SurfaceFactoryCache const &) = delete;
     SurfaceFactoryCache & operator=(SurfaceFactoryCache const &) = delete;
 
+    /// @brief Returns the memory used and allocated by the cache
+    ///
+    /// The entries of the cache are reported with a nested component for
+    /// the irregular patches they refer to (which may also be referenced
+    /// by Surfaces that remain after the cache is destroyed).
+    ///
+    virtual Far::MemoryUsage GetMemoryUsage() const;
+
 protected:
     /// @cond PROTECTED
     //  Access restricted to the Factory, its Builders, etc.
@@ -88,6 +98,8 @@ protected:
     //
     DataType find(KeyType const & key) const;
     DataType add(KeyType const & key, DataType const & data);
+
+    Far::MemoryUsage getMemoryUsage() const;
     /// @endcond PROTECTED
 
 private:
@@ -120,6 +132,11 @@ public:
     SurfaceFactoryCacheThreaded() : SurfaceFactoryCache() { }
     ~SurfaceFactoryCacheThreaded() override = default;
 
+    Far::MemoryUsage GetMemoryUsage() const override {
+        READ_LOCK_GUARD_TYPE lockGuard(_mutex);
+        return getMemoryUsage();
+    }
+
 protected:
     /// @cond PROTECTED
     //
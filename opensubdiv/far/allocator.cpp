@@ -0,0 +1,201 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#include "../far/allocator.h"
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+
+#if defined(__linux__)
+    #include <sys/mman.h>
+#endif
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Far {
+
+void
+SetAllocator(Allocator * allocator) {
+    Vtr::internal::SetAllocator(allocator);
+}
+
+Allocator *
+GetAllocator() {
+    return Vtr::internal::GetAllocator();
+}
+
+//
+//  TrackingAllocator:
+//
+struct TrackingAllocator::Impl {
+    Impl(Allocator * allocatorArg) :
+        allocator(allocatorArg), currentBytes(0), peakBytes(0),
+        numAllocations(0) { }
+
+    Allocator *         allocator;
+    std::atomic<size_t> currentBytes;
+    std::atomic<size_t> peakBytes;
+    std::atomic<size_t> numAllocations;
+};
+
+TrackingAllocator::TrackingAllocator(Allocator * allocator) :
+    _impl(new Impl(allocator ? allocator
+                             : Vtr::internal::GetDefaultAllocator())) {
+}
+
+TrackingAllocator::~TrackingAllocator() {
+    delete _impl;
+}
+
+void *
+TrackingAllocator::Allocate(size_t numBytes) {
+
+    void * ptr = _impl->allocator->Allocate(numBytes);
+
+    size_t current = _impl->currentBytes.fetch_add(numBytes) + numBytes;
+    size_t peak    = _impl->peakBytes.load();
+    while ((current > peak) &&
+           !_impl->peakBytes.compare_exchange_weak(peak, current)) { }
+
+    _impl->numAllocations.fetch_add(1);
+    return ptr;
+}
+
+void
+TrackingAllocator::Deallocate(void * ptr, size_t numBytes) {
+
+    _impl->allocator->Deallocate(ptr, numBytes);
+
+    _impl->currentBytes.fetch_sub(numBytes);
+    _impl->numAllocations.fetch_sub(1);
+}
+
+size_t
+TrackingAllocator::GetCurrentBytes() const {
+    return _impl->currentBytes.load();
+}
+
+size_t
+TrackingAllocator::GetPeakBytes() const {
+    return _impl->peakBytes.load();
+}
+
+size_t
+TrackingAllocator::GetNumAllocations() const {
+    return _impl->numAllocations.load();
+}
+
+void
+TrackingAllocator::ResetPeakBytes() {
+    _impl->peakBytes.store(_impl->currentBytes.load());
+}
+
+//
+//  HugePageAllocator:
+//
+namespace {
+#if defined(__linux__)
+    //
+    //  Blocks are aligned to the size of a huge page so that they can be
+    //  backed by huge pages from their start, and rounded to it so that
+    //  their end is also backed by one.  Mappings are larger by one huge
+    //  page to allow for the alignment, and record their base and size
+    //  immediately preceding the block:
+    //
+    size_t const hugePageSize = 2 * 1024 * 1024;
+
+    inline size_t
+    roundToHugePage(size_t numBytes) {
+        return (numBytes + hugePageSize - 1) & ~(hugePageSize - 1);
+    }
+
+    struct Mapping {
+        void * base;
+        size_t size;
+    };
+#endif
+}
+
+HugePageAllocator::HugePageAllocator(size_t threshold) :
+    _threshold(threshold) {
+}
+
+HugePageAllocator::~HugePageAllocator() {
+}
+
+void *
+HugePageAllocator::Allocate(size_t numBytes) {
+
+#if defined(__linux__)
+    if (numBytes >= _threshold) {
+        size_t blockSize   = roundToHugePage(numBytes);
+        size_t mappingSize = blockSize + hugePageSize;
+
+        void * base = mmap(0, mappingSize, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+
+        //  The first aligned address leaving room for the Mapping (at most
+        //  one huge page past the base, as the base is page aligned):
+        uintptr_t address = reinterpret_cast<uintptr_t>(base) +
+                            sizeof(Mapping);
+        address = (address + hugePageSize - 1) & ~(uintptr_t)(hugePageSize - 1);
+
+        void * block = reinterpret_cast<void *>(address);
+
+        Mapping * mapping = static_cast<Mapping *>(block) - 1;
+        mapping->base = base;
+        mapping->size = mappingSize;
+
+    #if defined(MADV_HUGEPAGE)
+        //  Advisory only -- the mapping remains valid if refused:
+        madvise(block, blockSize, MADV_HUGEPAGE);
+    #endif
+        return block;
+    }
+#endif
+    return Vtr::internal::GetDefaultAllocator()->Allocate(numBytes);
+}
+
+void
+HugePageAllocator::Deallocate(void * ptr, size_t numBytes) {
+
+#if defined(__linux__)
+    if (numBytes >= _threshold) {
+        Mapping const * mapping = static_cast<Mapping const *>(ptr) - 1;
+        munmap(mapping->base, mapping->size);
+        return;
+    }
+#endif
+    Vtr::internal::GetDefaultAllocator()->Deallocate(ptr, numBytes);
+}
+
+} // end namespace Far
+
+} // end namespace OPENSUBDIV_VERSION
+} // end namespace OpenSubdiv
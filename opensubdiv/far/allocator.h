@@ -0,0 +1,156 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#ifndef OPENSUBDIV3_FAR_ALLOCATOR_H
+#define OPENSUBDIV3_FAR_ALLOCATOR_H
+
+#include "../version.h"
+
+#include "../vtr/allocator.h"
+
+#include <cstddef>
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Far {
+
+///
+///  \brief Interface for the allocation of the memory of the topology
+///
+///  The vectors holding the topology of the levels and refinements of a
+///  TopologyRefiner -- including their face-varying channels -- and of the
+///  irregular patches of Bfr::Surfaces are allocated through the Allocator
+///  assigned with SetAllocator().  Subclasses can allocate from huge pages,
+///  from arenas or pools, or track the memory used.
+///
+///  Each block records the allocator that allocated it and is returned to
+///  it when released, even if another allocator has since been assigned.
+///  An allocator must therefore outlive every object allocating through
+///  it: each TopologyRefiner refined, and each Bfr::SurfaceFactory and
+///  Bfr::Surface with irregular patches created, while it was assigned.
+///  Destroying an allocator before these objects is undefined behavior.
+///  Allocate() and Deallocate() may be called concurrently from multiple
+///  threads and must be thread-safe.
+///
+///  Note that the PatchTable and StencilTable hold their data in vectors
+///  that are accessed directly through their public interfaces, and so
+///  continue to use the standard allocator.
+///
+typedef Vtr::Allocator Allocator;
+
+///
+///  \brief Assigns the allocator used by the library
+///
+///  Assigning a null pointer restores the default allocator (which uses the
+///  global operator new and delete).  The allocator is not owned, and is
+///  typically assigned once, before any topology is created.  It must
+///  outlive all objects using it (see Allocator), including those created
+///  before it is replaced.
+///
+void SetAllocator(Allocator * allocator);
+
+///
+///  \brief Returns the allocator used by the library
+///
+Allocator * GetAllocator();
+
+///
+///  \brief Allocator recording the memory allocated through it
+///
+///  Allocations are forwarded to another allocator (the default allocator
+///  if none is specified) while the bytes and blocks currently allocated
+///  and the peak bytes allocated are recorded.
+///
+class TrackingAllocator : public Allocator {
+public:
+    /// \brief Constructor
+    ///
+    /// @param allocator  Allocator to forward allocations to (optional)
+    ///
+    TrackingAllocator(Allocator * allocator = 0);
+    virtual ~TrackingAllocator();
+
+    virtual void * Allocate(size_t numBytes);
+    virtual void   Deallocate(void * ptr, size_t numBytes);
+
+    /// \brief Returns the bytes currently allocated
+    size_t GetCurrentBytes() const;
+
+    /// \brief Returns the peak bytes allocated
+    size_t GetPeakBytes() const;
+
+    /// \brief Returns the number of blocks currently allocated
+    size_t GetNumAllocations() const;
+
+    /// \brief Resets the peak bytes allocated to those currently allocated
+    void ResetPeakBytes();
+
+private:
+    struct Impl;
+    Impl * _impl;
+};
+
+///
+///  \brief Allocator using huge pages for large blocks
+///
+///  Blocks at or above a threshold size are mapped directly from the system,
+///  aligned to 2MB and advised to be backed by transparent huge pages (2MB
+///  on most systems) to reduce the TLB misses when traversing the topology
+///  of large meshes.  Each mapping reserves an additional 2MB of address
+///  space for the alignment (of which only one small page is touched).
+///  Smaller blocks use the default allocator.  Huge pages are only supported
+///  on Linux -- all blocks use the default allocator on other platforms.
+///
+///  Memory is mapped on first touch, and so is placed on the NUMA node of
+///  the thread that first writes it, i.e. typically the thread refining or
+///  building the data.
+///
+class HugePageAllocator : public Allocator {
+public:
+    /// \brief Constructor
+    ///
+    /// @param threshold  Size in bytes of the smallest block to map with
+    ///                   huge pages
+    ///
+    HugePageAllocator(size_t threshold = 2 * 1024 * 1024);
+    virtual ~HugePageAllocator();
+
+    virtual void * Allocate(size_t numBytes);
+    virtual void   Deallocate(void * ptr, size_t numBytes);
+
+    /// \brief Returns the size of the smallest block mapped with huge pages
+    size_t GetThreshold() const { return _threshold; }
+
+private:
+    size_t _threshold;
+};
+
+} // end namespace Far
+
+} // end namespace OPENSUBDIV_VERSION
+using namespace OPENSUBDIV_VERSION;
+} // end namespace OpenSubdiv
+
+#endif /* OPENSUBDIV3_FAR_ALLOCATOR_H */
@@ -0,0 +1,137 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#include "../far/compactPatchVertices.h"
+
+#include <algorithm>
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Far {
+
+CompactPatchVertices::CompactPatchVertices(PatchTable const & patchTable,
+                                           int patchesPerBlock) :
+    _numPatches(patchTable.GetNumPatchesTotal()) {
+
+    //
+    //  Gather the patch arrays and the largest patch size to bound the
+    //  number of patches per block -- all local indices of a block must
+    //  be representable by a LocalIndex:
+    //
+    int numArrays = patchTable.GetNumPatchArrays();
+
+    _arrays.resize(numArrays);
+
+    int maxCVs = 1;
+    Index vertOffset = 0;
+    Index patchIndex = 0;
+    for (int i = 0; i < numArrays; ++i) {
+        Array & a = _arrays[i];
+        a.vertOffset = vertOffset;
+        a.patchIndex = patchIndex;
+        a.numPatches = patchTable.GetNumPatches(i);
+        a.numCVs     = patchTable.GetPatchArrayDescriptor(i).GetNumControlVertices();
+
+        vertOffset += a.numPatches * a.numCVs;
+        patchIndex += a.numPatches;
+        maxCVs = std::max(maxCVs, a.numCVs);
+    }
+    assert(patchIndex == _numPatches);
+
+    int const maxLocalIndices = 1 << (8 * sizeof(LocalIndex));
+
+    _patchesPerBlock = std::max(1,
+            std::min(patchesPerBlock, maxLocalIndices / maxCVs));
+
+    //
+    //  Local indices are assigned in the order vertices are first referenced
+    //  within a block. A single map from vertex to local index is reused for
+    //  all blocks, resetting only the entries assigned by the last block:
+    //
+    PatchTable::PatchVertsTable const & patchVerts =
+        patchTable.GetPatchControlVerticesTable();
+
+    _localIndices.resize(patchVerts.size());
+
+    Index maxVertex = patchVerts.empty() ? -1 :
+        *std::max_element(patchVerts.begin(), patchVerts.end());
+
+    std::vector<int> localIndexMap(maxVertex + 1, -1);
+
+    int numBlocks = (_numPatches + _patchesPerBlock - 1) / _patchesPerBlock;
+
+    _blockOffsets.reserve(numBlocks + 1);
+    _blockOffsets.push_back(0);
+
+    int block = 0;
+    for (int i = 0; i < numArrays; ++i) {
+        Array const & a = _arrays[i];
+
+        for (int patch = 0; patch < a.numPatches; ++patch) {
+            Index absPatch = a.patchIndex + patch;
+
+            if ((absPatch / _patchesPerBlock) != block) {
+                for (Index j = _blockOffsets.back(); j < (Index)_dictionary.size(); ++j) {
+                    localIndexMap[_dictionary[j]] = -1;
+                }
+                _blockOffsets.push_back((Index)_dictionary.size());
+                ++block;
+            }
+            Index blockOffset = _blockOffsets.back();
+
+            Index offset = a.vertOffset + patch * a.numCVs;
+            for (int j = 0; j < a.numCVs; ++j) {
+                Index vert = patchVerts[offset + j];
+                if (localIndexMap[vert] < 0) {
+                    localIndexMap[vert] = (int)_dictionary.size() - blockOffset;
+                    _dictionary.push_back(vert);
+                }
+                _localIndices[offset + j] = (LocalIndex)localIndexMap[vert];
+            }
+        }
+    }
+    if (_numPatches > 0) {
+        _blockOffsets.push_back((Index)_dictionary.size());
+    }
+    assert((int)_blockOffsets.size() == (numBlocks + 1));
+
+    //  Trim the dictionary, which was grown without knowing its final size:
+    std::vector<Index>(_dictionary).swap(_dictionary);
+}
+
+size_t
+CompactPatchVertices::GetByteSize() const {
+
+    return sizeof(*this) +
+           _arrays.size()       * sizeof(Array) +
+           _localIndices.size() * sizeof(LocalIndex) +
+           _blockOffsets.size() * sizeof(Index) +
+           _dictionary.size()   * sizeof(Index);
+}
+
+} // end namespace Far
+
+} // end namespace OPENSUBDIV_VERSION
+} // end namespace OpenSubdiv
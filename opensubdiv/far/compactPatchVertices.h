@@ -0,0 +1,188 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#ifndef OPENSUBDIV3_FAR_COMPACT_PATCH_VERTICES_H
+#define OPENSUBDIV3_FAR_COMPACT_PATCH_VERTICES_H
+
+#include "../version.h"
+
+#include "../far/patchTable.h"
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Far {
+
+/// \brief A compact encoding of the control vertex indices of a PatchTable
+///
+/// PatchTable stores a full Index for every control vertex of every patch,
+/// while neighboring patches largely share the same control vertices. For
+/// large tables the redundant indices account for most of the memory of the
+/// table and of its traversal during evaluation.
+///
+/// CompactPatchVertices partitions the patches of a PatchTable into blocks
+/// of consecutive patches. Each block is given a dictionary of the unique
+/// control vertices referenced by its patches, and the control vertices of
+/// each patch are stored as 16-bit local indices into the dictionary of its
+/// block. The layout of the local indices matches that of the control
+/// vertices in the PatchTable, so PatchHandles and (array, patch) pairs
+/// can be used directly to decode the indices of a patch.
+///
+/// Once constructed, CompactPatchVertices does not depend on the PatchTable
+/// it was created from.
+///
+class CompactPatchVertices {
+public:
+
+    typedef PatchTable::PatchHandle Handle;
+
+    /// \brief Constructor
+    ///
+    /// @param patchTable       A valid PatchTable
+    ///
+    /// @param patchesPerBlock  The number of consecutive patches sharing a
+    ///                         dictionary of control vertices. The value is
+    ///                         clamped to guarantee that all local indices of
+    ///                         a block fit in 16 bits.
+    ///
+    CompactPatchVertices(PatchTable const & patchTable,
+                         int patchesPerBlock = 256);
+
+    /// \brief Returns the total number of patches encoded
+    int GetNumPatches() const { return _numPatches; }
+
+    /// \brief Returns the number of patches sharing a dictionary
+    int GetPatchesPerBlock() const { return _patchesPerBlock; }
+
+    /// \brief Returns the number of blocks (and dictionaries)
+    int GetNumBlocks() const { return (int)_blockOffsets.size() - 1; }
+
+    /// \brief Returns the number of control vertices of the patches in \p array
+    int GetNumControlVertices(int array) const {
+        return _arrays[array].numCVs;
+    }
+
+    /// \brief Decodes the control vertex indices of the patch identified
+    /// by \p handle into \p cvs and returns the number of control vertices
+    int GetPatchVertices(Handle const & handle, Index cvs[]) const;
+
+    /// \brief Decodes the control vertex indices of \p patch in \p array
+    /// into \p cvs and returns the number of control vertices
+    int GetPatchVertices(int array, int patch, Index cvs[]) const;
+
+    /// \brief Returns the memory used by the encoding (in bytes)
+    size_t GetByteSize() const;
+
+    //@{
+    ///  @name Direct accessors
+    ///
+    /// \brief Accessors to the raw encoding, e.g. for use in device kernels
+    ///
+
+    /// \brief Returns the 16-bit local indices of all patches (the layout
+    /// matches PatchTable::GetPatchControlVerticesTable())
+    std::vector<LocalIndex> const & GetLocalIndices() const {
+        return _localIndices;
+    }
+
+    /// \brief Returns the offsets of the dictionaries of all blocks (one
+    /// more than the number of blocks)
+    std::vector<Index> const & GetBlockOffsets() const {
+        return _blockOffsets;
+    }
+
+    /// \brief Returns the concatenated dictionaries of all blocks
+    std::vector<Index> const & GetDictionary() const {
+        return _dictionary;
+    }
+    //@}
+
+private:
+    int decodePatchVertices(Index vertOffset, Index patchIndex, int numCVs,
+                            Index cvs[]) const;
+
+private:
+    struct Array {
+        Index vertOffset;  // offset of the first local index of the array
+        Index patchIndex;  // absolute index of the first patch of the array
+        int   numPatches;
+        int   numCVs;
+    };
+
+    int _numPatches;
+    int _patchesPerBlock;
+
+    std::vector<Array>      _arrays;
+    std::vector<LocalIndex> _localIndices;  // per patch control vertex
+    std::vector<Index>      _blockOffsets;  // per block dictionary offset
+    std::vector<Index>      _dictionary;    // unique vertices of each block
+};
+
+inline int
+CompactPatchVertices::decodePatchVertices(Index vertOffset, Index patchIndex,
+                                          int numCVs, Index cvs[]) const {
+
+    Index const * dictionary =
+        &_dictionary[_blockOffsets[patchIndex / _patchesPerBlock]];
+    LocalIndex const * local = &_localIndices[vertOffset];
+
+    for (int i = 0; i < numCVs; ++i) {
+        cvs[i] = dictionary[local[i]];
+    }
+    return numCVs;
+}
+
+inline int
+CompactPatchVertices::GetPatchVertices(Handle const & handle,
+                                       Index cvs[]) const {
+
+    assert(handle.arrayIndex < (Index)_arrays.size());
+    Array const & a = _arrays[handle.arrayIndex];
+    return decodePatchVertices(a.vertOffset + handle.vertIndex,
+                               handle.patchIndex, a.numCVs, cvs);
+}
+
+inline int
+CompactPatchVertices::GetPatchVertices(int array, int patch,
+                                       Index cvs[]) const {
+
+    assert(array < (int)_arrays.size());
+    Array const & a = _arrays[array];
+    assert(patch < a.numPatches);
+    return decodePatchVertices(a.vertOffset + patch * a.numCVs,
+                               a.patchIndex + patch, a.numCVs, cvs);
+}
+
+} // end namespace Far
+
+} // end namespace OPENSUBDIV_VERSION
+using namespace OPENSUBDIV_VERSION;
+
+} // end namespace OpenSubdiv
+
+#endif /* OPENSUBDIV3_FAR_COMPACT_PATCH_VERTICES_H */
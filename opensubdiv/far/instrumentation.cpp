@@ -0,0 +1,182 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#include "../far/instrumentation.h"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <mutex>
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Far {
+
+namespace {
+    //  The sink is read by every instrumentation point, possibly from
+    //  several threads, while it is installed
+    std::atomic<Instrumentation::Sink *> _sink(0);
+}
+
+char const *
+Instrumentation::GetTimerName(Timer timer) {
+
+    static char const * names[NUM_TIMERS] = {
+        "refineLevel",
+        "selectFeatures",
+        "identifyPatches",
+        "populatePatches",
+        "localPointStencils",
+        "createStencilTable",
+        "buildIrregularPatch",
+        "evalStencils",
+        "evalPatches" };
+
+    assert(timer >= 0 && timer < NUM_TIMERS);
+    return names[timer];
+}
+
+char const *
+Instrumentation::GetCounterName(Counter counter) {
+
+    static char const * names[NUM_COUNTERS] = {
+        "regularPatches",
+        "irregularPatches",
+        "localPoints",
+        "bfrLinearSurfaces",
+        "bfrRegularSurfaces",
+        "bfrIrregularSurfaces",
+        "bfrCacheHits",
+        "bfrCacheMisses",
+        "evalStencils",
+        "evalPatchCoords" };
+
+    assert(counter >= 0 && counter < NUM_COUNTERS);
+    return names[counter];
+}
+
+void
+Instrumentation::SetSink(Sink * sink) {
+    _sink.store(sink, std::memory_order_release);
+}
+
+Instrumentation::Sink *
+Instrumentation::GetSink() {
+    return _sink.load(std::memory_order_acquire);
+}
+
+bool
+Instrumentation::IsEnabled() {
+#ifdef OPENSUBDIV_ENABLE_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}
+
+double
+Instrumentation::getTime() {
+
+    typedef std::chrono::steady_clock Clock;
+    return std::chrono::duration<double>(
+        Clock::now().time_since_epoch()).count();
+}
+
+//
+//  Accumulator
+//
+struct Instrumentation::Accumulator::Impl {
+    Impl() { Reset(); }
+
+    void Reset() {
+        for (int i = 0; i < NUM_TIMERS; ++i) {
+            seconds[i] = 0.0;
+            calls[i] = 0;
+        }
+        for (int i = 0; i < NUM_COUNTERS; ++i) {
+            counts[i] = 0;
+        }
+    }
+
+    mutable std::mutex mutex;
+    double seconds[NUM_TIMERS];
+    int calls[NUM_TIMERS];
+    long counts[NUM_COUNTERS];
+};
+
+Instrumentation::Accumulator::Accumulator() : _impl(new Impl) {
+}
+
+Instrumentation::Accumulator::~Accumulator() {
+    delete _impl;
+}
+
+void
+Instrumentation::Accumulator::OnTimer(Timer timer, int, double seconds) {
+
+    std::lock_guard<std::mutex> lock(_impl->mutex);
+    _impl->seconds[timer] += seconds;
+    ++_impl->calls[timer];
+}
+
+void
+Instrumentation::Accumulator::OnCounter(Counter counter, int increment) {
+
+    std::lock_guard<std::mutex> lock(_impl->mutex);
+    _impl->counts[counter] += increment;
+}
+
+double
+Instrumentation::Accumulator::GetSeconds(Timer timer) const {
+
+    std::lock_guard<std::mutex> lock(_impl->mutex);
+    return _impl->seconds[timer];
+}
+
+int
+Instrumentation::Accumulator::GetCalls(Timer timer) const {
+
+    std::lock_guard<std::mutex> lock(_impl->mutex);
+    return _impl->calls[timer];
+}
+
+long
+Instrumentation::Accumulator::GetCount(Counter counter) const {
+
+    std::lock_guard<std::mutex> lock(_impl->mutex);
+    return _impl->counts[counter];
+}
+
+void
+Instrumentation::Accumulator::Reset() {
+
+    std::lock_guard<std::mutex> lock(_impl->mutex);
+    _impl->Reset();
+}
+
+}  // end namespace Far
+
+}  // end namespace OPENSUBDIV_VERSION
+}  // end namespace OpenSubdiv
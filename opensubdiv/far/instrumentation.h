@@ -0,0 +1,216 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#ifndef OPENSUBDIV3_FAR_INSTRUMENTATION_H
+#define OPENSUBDIV3_FAR_INSTRUMENTATION_H
+
+#include "../version.h"
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Far {
+
+///
+///  \brief Timers and counters reported by the stages of the library
+///
+///  Instrumentation points are compiled into the library only when it is
+///  built with OPENSUBDIV_ENABLE_INSTRUMENTATION defined (see the CMake
+///  option of the same name). Measurements are reported to the Sink
+///  installed with SetSink(), e.g. to forward them to the telemetry of a
+///  host application. No timing is performed while no sink is installed.
+///
+///  Measurements may be reported concurrently from several threads (e.g.
+///  by parallel evaluators), so sinks must be thread-safe.
+///
+class Instrumentation {
+public:
+
+    /// \brief Timed stages
+    enum Timer {
+        TIMER_REFINE_LEVEL = 0,        ///< refinement of one level, tags included
+        TIMER_SELECT_FEATURES,         ///< feature adaptive selection
+        TIMER_IDENTIFY_PATCHES,        ///< identification of patches
+        TIMER_POPULATE_PATCHES,        ///< population of patch tables
+        TIMER_LOCAL_POINT_STENCILS,    ///< appending local point stencils
+        TIMER_CREATE_STENCIL_TABLE,    ///< stencil table factory
+        TIMER_BUILD_IRREGULAR_PATCH,   ///< Bfr irregular patch builds
+        TIMER_EVAL_STENCILS,           ///< Osd stencil evaluations
+        TIMER_EVAL_PATCHES,            ///< Osd limit evaluations
+
+        NUM_TIMERS
+    };
+
+    /// \brief Counted events
+    enum Counter {
+        COUNTER_REGULAR_PATCHES = 0,   ///< regular patches in patch tables
+        COUNTER_IRREGULAR_PATCHES,     ///< irregular patches in patch tables
+        COUNTER_LOCAL_POINTS,          ///< local points of patch tables
+        COUNTER_BFR_LINEAR_SURFACES,   ///< linear Bfr surfaces
+        COUNTER_BFR_REGULAR_SURFACES,  ///< regular Bfr surfaces
+        COUNTER_BFR_IRREGULAR_SURFACES,///< irregular Bfr surfaces
+        COUNTER_BFR_CACHE_HITS,        ///< irregular patches found in cache
+        COUNTER_BFR_CACHE_MISSES,      ///< irregular patches added to cache
+        COUNTER_EVAL_STENCILS,         ///< stencils evaluated by Osd
+        COUNTER_EVAL_PATCH_COORDS,     ///< patch coordinates evaluated by Osd
+
+        NUM_COUNTERS
+    };
+
+    /// \brief Returns a short name for the timer, e.g. "refineLevel"
+    static char const * GetTimerName(Timer timer);
+
+    /// \brief Returns a short name for the counter, e.g. "bfrCacheHits"
+    static char const * GetCounterName(Counter counter);
+
+    /// \brief Receives the measurements
+    class Sink {
+    public:
+        virtual ~Sink() { }
+
+        /// \brief Reports the duration of a timed stage
+        ///
+        /// @param timer    the stage
+        ///
+        /// @param level    the refinement level for per-level stages,
+        ///                 or -1
+        ///
+        /// @param seconds  wall clock duration of the stage
+        ///
+        virtual void OnTimer(Timer timer, int level, double seconds) = 0;
+
+        /// \brief Reports an increment of a counter (non-positive increments
+    /// are ignored)
+        virtual void OnCounter(Counter counter, int increment) = 0;
+    };
+
+    /// \brief Installs the sink receiving subsequent measurements. The sink
+    ///        is not owned, and NULL disables reporting.
+    ///
+    /// The sink may be replaced while other threads report measurements,
+    /// which are delivered to either sink : the previous sink must remain
+    /// valid until those threads are done.
+    ///
+    static void SetSink(Sink * sink);
+
+    /// \brief Returns the installed sink, or NULL
+    static Sink * GetSink();
+
+    /// \brief Returns true if the library reports measurements, i.e. was
+    ///        built with OPENSUBDIV_ENABLE_INSTRUMENTATION
+    static bool IsEnabled();
+
+    /// \brief Reports the time elapsed from construction to destruction
+    class ScopedTimer {
+    public:
+        ScopedTimer(Timer timer, int level = -1) :
+            _target(Instrumentation::GetSink()), _timer(timer), _level(level),
+            _start(0) {
+            if (_target) _start = getTime();
+        }
+
+        ~ScopedTimer() {
+            if (_target) _target->OnTimer(_timer, _level, getTime() - _start);
+        }
+
+    private:
+        Sink * _target;
+        Timer _timer;
+        int _level;
+        double _start;
+    };
+
+    /// \brief Reports an increment of a counter (non-positive increments
+    /// are ignored)
+    static void Count(Counter counter, int increment = 1) {
+        if (increment > 0) {
+            if (Sink * sink = GetSink()) sink->OnCounter(counter, increment);
+        }
+    }
+
+    /// \brief Sink accumulating totals, e.g. for reporting by benchmarks
+    class Accumulator : public Sink {
+    public:
+        Accumulator();
+        virtual ~Accumulator();
+
+        virtual void OnTimer(Timer timer, int level, double seconds);
+        virtual void OnCounter(Counter counter, int increment);
+
+        /// \brief Returns the total duration of a timer over all levels
+        double GetSeconds(Timer timer) const;
+
+        /// \brief Returns the number of times a timer was reported
+        int GetCalls(Timer timer) const;
+
+        /// \brief Returns the total of a counter
+        long GetCount(Counter counter) const;
+
+        /// \brief Clears all totals
+        void Reset();
+
+    private:
+        // Non-copyable
+        Accumulator(Accumulator const &);
+        Accumulator & operator=(Accumulator const &);
+
+        struct Impl;
+        Impl * _impl;
+    };
+
+private:
+    static double getTime();
+};
+
+}  // end namespace Far
+
+}  // end namespace OPENSUBDIV_VERSION
+using namespace OPENSUBDIV_VERSION;
+
+}  // end namespace OpenSubdiv
+
+//
+//  Instrumentation points used within the library -- these expand to
+//  nothing unless the library is built with OPENSUBDIV_ENABLE_INSTRUMENTATION
+//
+#ifdef OPENSUBDIV_ENABLE_INSTRUMENTATION
+    #define OPENSUBDIV_INSTRUMENT_CONCAT_(a, b) a##b
+    #define OPENSUBDIV_INSTRUMENT_CONCAT(a, b) OPENSUBDIV_INSTRUMENT_CONCAT_(a, b)
+
+    #define OPENSUBDIV_INSTRUMENT_TIMER(timer, level)                         \
+        OpenSubdiv::OPENSUBDIV_VERSION::Far::Instrumentation::ScopedTimer     \
+            OPENSUBDIV_INSTRUMENT_CONCAT(_instrumentTimer, __LINE__)(         \
+                OpenSubdiv::OPENSUBDIV_VERSION::Far::Instrumentation::timer,  \
+                level)
+
+    #define OPENSUBDIV_INSTRUMENT_COUNT(counter, increment)                   \
+        OpenSubdiv::OPENSUBDIV_VERSION::Far::Instrumentation::Count(          \
+            OpenSubdiv::OPENSUBDIV_VERSION::Far::Instrumentation::counter,    \
+            increment)
+#else
+    #define OPENSUBDIV_INSTRUMENT_TIMER(timer, level)
+    #define OPENSUBDIV_INSTRUMENT_COUNT(counter, increment)
+#endif
+
+#endif  // OPENSUBDIV3_FAR_INSTRUMENTATION_H
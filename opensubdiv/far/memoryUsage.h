@@ -0,0 +1,91 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#ifndef OPENSUBDIV3_FAR_MEMORY_USAGE_H
+#define OPENSUBDIV3_FAR_MEMORY_USAGE_H
+
+#include "../version.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Far {
+
+///
+///  \brief Memory footprint of an object and of each of its components
+///
+///  Both the bytes of data in use (the sizes of the vectors holding it) and
+///  the bytes allocated (including the excess capacity of those vectors)
+///  are reported. Components of an object (e.g. the levels of refinement
+///  of a TopologyRefiner) are reported as nested instances whose totals are
+///  included in those of the object. The difference between the two totals
+///  is the memory that can be released by the ShrinkToFit() method of the
+///  object reporting it.
+///
+struct MemoryUsage {
+
+    /// \brief Constructor
+    MemoryUsage(char const * nameArg = 0, int indexArg = -1) :
+        name(nameArg), index(indexArg), used(0), allocated(0) { }
+
+    char const * name;      ///< name of the component
+    int          index;     ///< index of the component (e.g. level) or -1
+    size_t       used;      ///< bytes in use (including components)
+    size_t       allocated; ///< bytes allocated (including components)
+
+    std::vector<MemoryUsage> components; ///< nested components
+
+    /// \brief Returns the bytes allocated in excess of those in use
+    size_t GetExcess() const { return allocated - used; }
+
+    /// \brief Adds memory not associated with a nested component
+    void Add(size_t usedBytes, size_t allocatedBytes) {
+        used      += usedBytes;
+        allocated += allocatedBytes;
+    }
+
+    /// \brief Adds the memory held by a vector
+    template <typename T, typename A>
+    void Add(std::vector<T,A> const & v) {
+        Add(v.size() * sizeof(T), v.capacity() * sizeof(T));
+    }
+
+    /// \brief Adds a nested component (and its totals to those of this)
+    void AddComponent(MemoryUsage const & component) {
+        Add(component.used, component.allocated);
+        components.push_back(component);
+    }
+};
+
+} // end namespace Far
+
+} // end namespace OPENSUBDIV_VERSION
+using namespace OPENSUBDIV_VERSION;
+
+} // end namespace OpenSubdiv
+
+#endif /* OPENSUBDIV3_FAR_MEMORY_USAGE_H */
@@ -1371,6 +1371,70 @@ EvaluatePatchBasis(int patchType, PatchParam const & param, REAL s, REAL t,
     return nPoints;
 }
 
+template <typename REAL>
+void
+AdjustPatchBasisForBoundaries(int patchType, PatchParam const & param, REAL w[]) {
+
+    int boundaryMask = param.GetBoundary();
+    if (boundaryMask == 0) return;
+
+    if (patchType == PatchDescriptor::REGULAR) {
+        boundBasisBSpline<REAL>(boundaryMask, w, 0, 0, 0, 0, 0);
+    } else if (patchType == PatchDescriptor::LOOP) {
+        boundBasisBoxSplineTri<REAL>(boundaryMask, w, 0, 0, 0, 0, 0);
+    }
+}
+
+//
+//  Separable evaluation of the curve bases of quad patch types -- boundary
+//  adjustments of the BSpline curve at its start and end are the same as
+//  those applied to the rows or columns of the full set of weights above:
+//
+template <typename REAL>
+int
+EvaluatePatchBasisCurveNormalized(int patchType, PatchParam const & param,
+    int direction, REAL c, REAL w[], REAL wD[], REAL wDD[]) {
+
+    if (patchType == PatchDescriptor::REGULAR) {
+        evalBSplineCurve(c, w, wD, wDD);
+
+        int boundaryMask = param.GetBoundary();
+        int startBit = direction ? 1 : 8;
+        int endBit   = direction ? 4 : 2;
+
+        REAL * wCurve[3] = { w, wD, wDD };
+        for (int k = 0; k < 3; ++k) {
+            REAL * wk = wCurve[k];
+            if (wk == 0) continue;
+
+            if (boundaryMask & startBit) {
+                wk[2] -= wk[0];
+                wk[1] += wk[0] * 2.0f;
+                wk[0]  = 0.0f;
+            }
+            if (boundaryMask & endBit) {
+                wk[1] -= wk[3];
+                wk[2] += wk[3] * 2.0f;
+                wk[3]  = 0.0f;
+            }
+        }
+        return 4;
+    } else if (patchType == PatchDescriptor::QUADS) {
+        w[0] = 1.0f - c;
+        w[1] = c;
+        if (wD) {
+            wD[0] = -1.0f;
+            wD[1] =  1.0f;
+        }
+        if (wDD) {
+            wDD[0] = 0.0f;
+            wDD[1] = 0.0f;
+        }
+        return 2;
+    }
+    return 0;
+}
+
 //
 //  Explicit float and double instantiations:
 //
@@ -1384,6 +1448,16 @@ template int EvaluatePatchBasisNormalized<double>(int patchType, PatchParam cons
 template int EvaluatePatchBasis<double>(int patchType, PatchParam const & param,
     double s, double t, double wP[], double wDs[], double wDt[], double wDss[], double wDst[], double wDtt[]);
 
+template int EvaluatePatchBasisCurveNormalized<float>(int patchType, PatchParam const & param,
+    int direction, float c, float w[], float wD[], float wDD[]);
+template int EvaluatePatchBasisCurveNormalized<double>(int patchType, PatchParam const & param,
+    int direction, double c, double w[], double wD[], double wDD[]);
+
+template void AdjustPatchBasisForBoundaries<float>(int patchType, PatchParam const & param,
+    float w[]);
+template void AdjustPatchBasisForBoundaries<double>(int patchType, PatchParam const & param,
+    double w[]);
+
 //
 //   Most basis evaluation functions are implicitly instantiated above -- Bezier
 //   require explicit instantiation as they are not invoked via a patch type:
@@ -99,6 +99,32 @@ int EvaluatePatchBasis(int patchType, PatchParam const & param, REAL s, REAL t,
     REAL wP[], REAL wDs[] = 0, REAL wDt[] = 0, REAL wDss[] = 0, REAL wDst[] = 0, REAL wDtt[] = 0);
 
 
+//
+// Separable basis evaluation for the quad patch types whose basis is the
+// tensor product of curve bases (REGULAR and QUADS).  The curve weights in
+// one parametric direction (0 for s, 1 for t) are evaluated at a normalized
+// coordinate, including any boundary adjustments of PatchParam, so that the
+// basis weight of a patch point is the product of the weights of its column
+// (s) and its row (t).  Note that the points of the REGULAR type are ordered
+// by row while those of QUADS are ordered counter-clockwise.  Returns the
+// number of curve weights, or 0 if the basis of the type is not separable:
+//
+template <typename REAL>
+int EvaluatePatchBasisCurveNormalized(int patchType, PatchParam const & param, int direction, REAL c,
+    REAL w[], REAL wD[] = 0, REAL wDD[] = 0);
+
+
+//
+// Adjustment of basis weights for the boundaries of PatchParam, as applied by
+// EvaluatePatchBasisNormalized() to the REGULAR and LOOP types (weights of all
+// other types are unaffected).  The adjustment is linear, so applying it to a
+// unit weight identifies the combination of points that replaces a phantom
+// point beyond a boundary:
+//
+template <typename REAL>
+void AdjustPatchBasisForBoundaries(int patchType, PatchParam const & param, REAL w[]);
+
+
 } // end namespace internal
 } // end namespace Far
 
@@ -702,6 +702,134 @@ template void PatchTable::EvaluateBasisFaceVarying<double>(PatchHandle const & h
         double s, double t, double wP[], double wDs[], double wDt[],
         double wDss[], double wDst[], double wDtt[], int channel) const;
 
+//
+//  Memory usage and release of excess capacity:
+//
+namespace {
+    template <typename T>
+    MemoryUsage
+    getVectorMemoryUsage(char const * name, std::vector<T> const & v) {
+        MemoryUsage usage(name);
+        usage.Add(v);
+        return usage;
+    }
+
+    template <typename T>
+    void
+    shrinkVectorToFit(std::vector<T> & v) {
+        std::vector<T>(v).swap(v);
+    }
+
+    template <typename REAL>
+    MemoryUsage
+    getStencilMemoryUsage(char const * name, int index,
+                          StencilTableReal<REAL> const * stencils) {
+        MemoryUsage usage = stencils->GetMemoryUsage();
+        usage.name  = name;
+        usage.index = index;
+        return usage;
+    }
+}
+
+MemoryUsage
+PatchTable::GetMemoryUsage() const {
+
+    MemoryUsage usage("PatchTable");
+
+    usage.Add(sizeof(PatchTable), sizeof(PatchTable));
+    usage.Add(_fvarChannels);
+    usage.Add(_localPointFaceVaryingStencils);
+
+    usage.AddComponent(getVectorMemoryUsage("PatchArrays", _patchArrays));
+    usage.AddComponent(getVectorMemoryUsage("PatchVertices", _patchVerts));
+    usage.AddComponent(getVectorMemoryUsage("PatchParams", _paramTable));
+    usage.AddComponent(getVectorMemoryUsage("QuadOffsets", _quadOffsetsTable));
+    usage.AddComponent(getVectorMemoryUsage("VertexValences",
+                                            _vertexValenceTable));
+    usage.AddComponent(getVectorMemoryUsage("VaryingVertices", _varyingVerts));
+
+    MemoryUsage sharpnessUsage("SingleCreaseSharpness");
+    sharpnessUsage.Add(_sharpnessIndices);
+    sharpnessUsage.Add(_sharpnessValues);
+    usage.AddComponent(sharpnessUsage);
+
+    for (int fvc = 0; fvc < (int)_fvarChannels.size(); ++fvc) {
+        MemoryUsage fvarUsage("FVarPatchChannel", fvc);
+        fvarUsage.Add(_fvarChannels[fvc].patchValues);
+        fvarUsage.Add(_fvarChannels[fvc].patchParam);
+        usage.AddComponent(fvarUsage);
+    }
+
+    if (_localPointStencils) {
+        usage.AddComponent(_vertexPrecisionIsDouble ?
+            getStencilMemoryUsage("LocalPointStencils", -1,
+                                  _localPointStencils.Get<double>()) :
+            getStencilMemoryUsage("LocalPointStencils", -1,
+                                  _localPointStencils.Get<float>()));
+    }
+    if (_localPointVaryingStencils) {
+        usage.AddComponent(_varyingPrecisionIsDouble ?
+            getStencilMemoryUsage("LocalPointVaryingStencils", -1,
+                                  _localPointVaryingStencils.Get<double>()) :
+            getStencilMemoryUsage("LocalPointVaryingStencils", -1,
+                                  _localPointVaryingStencils.Get<float>()));
+    }
+    for (int fvc = 0; fvc < (int)_localPointFaceVaryingStencils.size(); ++fvc) {
+        StencilTablePtr const & stencils = _localPointFaceVaryingStencils[fvc];
+        if (stencils) {
+            usage.AddComponent(_faceVaryingPrecisionIsDouble ?
+                getStencilMemoryUsage("LocalPointFaceVaryingStencils", fvc,
+                                      stencils.Get<double>()) :
+                getStencilMemoryUsage("LocalPointFaceVaryingStencils", fvc,
+                                      stencils.Get<float>()));
+        }
+    }
+    return usage;
+}
+
+void
+PatchTable::ShrinkToFit() {
+
+    shrinkVectorToFit(_patchArrays);
+    shrinkVectorToFit(_patchVerts);
+    shrinkVectorToFit(_paramTable);
+    shrinkVectorToFit(_quadOffsetsTable);
+    shrinkVectorToFit(_vertexValenceTable);
+    shrinkVectorToFit(_varyingVerts);
+    shrinkVectorToFit(_sharpnessIndices);
+    shrinkVectorToFit(_sharpnessValues);
+
+    for (int fvc = 0; fvc < (int)_fvarChannels.size(); ++fvc) {
+        shrinkVectorToFit(_fvarChannels[fvc].patchValues);
+        shrinkVectorToFit(_fvarChannels[fvc].patchParam);
+    }
+
+    if (_localPointStencils) {
+        if (_vertexPrecisionIsDouble) {
+            _localPointStencils.Get<double>()->ShrinkToFit();
+        } else {
+            _localPointStencils.Get<float>()->ShrinkToFit();
+        }
+    }
+    if (_localPointVaryingStencils) {
+        if (_varyingPrecisionIsDouble) {
+            _localPointVaryingStencils.Get<double>()->ShrinkToFit();
+        } else {
+            _localPointVaryingStencils.Get<float>()->ShrinkToFit();
+        }
+    }
+    for (int fvc = 0; fvc < (int)_localPointFaceVaryingStencils.size(); ++fvc) {
+        StencilTablePtr & stencils = _localPointFaceVaryingStencils[fvc];
+        if (stencils) {
+            if (_faceVaryingPrecisionIsDouble) {
+                stencils.Get<double>()->ShrinkToFit();
+            } else {
+                stencils.Get<float>()->ShrinkToFit();
+            }
+        }
+    }
+}
+
 } // end namespace Far
 
 } // end namespace OPENSUBDIV_VERSION
@@ -27,6 +27,7 @@
 
 #include "../version.h"
 
+#include "../far/memoryUsage.h"
 #include "../far/patchDescriptor.h"
 #include "../far/patchParam.h"
 #include "../far/stencilTable.h"
@@ -94,6 +95,16 @@ public:
     /// \brief Returns the total number of ptex faces in the mesh
     int GetNumPtexFaces() const { return _numPtexFaces; }
 
+    /// \brief Returns the memory used and allocated by the table
+    ///
+    /// A component is reported for each table of patch data, each
+    /// face-varying channel and each table of local point stencils.
+    ///
+    MemoryUsage GetMemoryUsage() const;
+
+    /// \brief Releases the excess capacity of all tables
+    void ShrinkToFit();
+
 
     //@{
     ///  @name Individual patches
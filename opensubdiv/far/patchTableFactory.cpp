@@ -24,6 +24,7 @@
 #include "../far/patchTableFactory.h"
 #include "../far/patchBuilder.h"
 #include "../far/error.h"
+#include "../far/instrumentation.h"
 #include "../far/ptexIndices.h"
 #include "../far/topologyRefiner.h"
 #include "../vtr/level.h"
@@ -966,6 +967,8 @@ PatchTableBuilder::findDescendantPatches(int levelIndex, Index faceIndex, int ta
 void
 PatchTableBuilder::identifyPatches() {
 
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_IDENTIFY_PATCHES, -1);
+
     //
     //  First initialize the offsets for all levels
     //
@@ -1023,6 +1026,10 @@ PatchTableBuilder::identifyPatches() {
             }
         }
     }
+
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_REGULAR_PATCHES, _numRegularPatches);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_IRREGULAR_PATCHES,
+                                _numIrregularPatches);
 }
 
 //
@@ -1031,6 +1038,8 @@ PatchTableBuilder::identifyPatches() {
 void
 PatchTableBuilder::populatePatches() {
 
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_POPULATE_PATCHES, -1);
+
     // State needed to populate an array in the patch table.
     // Pointers in this structure are initialized after the patch array
     // data buffers have been allocated and are then incremented as we
@@ -1293,6 +1302,9 @@ PatchTableBuilder::populatePatches() {
     //  Finalizing and destroying StencilTable and other helpers:
     //
     if (_requiresLocalPoints) {
+        OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_LOCAL_POINTS,
+                                    vertexLocalPointHelper->GetNumLocalPoints());
+
         _table->_localPointStencils =
             vertexLocalPointHelper->AcquireStencilTable();
         if (_requiresVaryingLocalPoints) {
@@ -1975,6 +1987,12 @@ PatchTableFactory::Create(TopologyRefiner const & refiner,
                           Options options,
                           ConstIndexArray selectedFaces) {
 
+    if (refiner.IsRefinedTopologyReleased()) {
+        Error(FAR_RUNTIME_ERROR,
+            "Failure in PatchTableFactory::Create() -- refined topology was released.");
+        return NULL;
+    }
+
     PatchTableBuilder builder(refiner, options, selectedFaces);
 
     if (builder.UniformPolygonsSpecified()) {
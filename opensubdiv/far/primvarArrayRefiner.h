@@ -0,0 +1,866 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#ifndef OPENSUBDIV3_FAR_PRIMVAR_ARRAY_REFINER_H
+#define OPENSUBDIV3_FAR_PRIMVAR_ARRAY_REFINER_H
+
+#include "../version.h"
+
+#include "../far/primvarRefiner.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Far {
+
+namespace internal {
+
+//
+//  Element and array classes fulfilling the source and destination
+//  interfaces of PrimvarRefinerReal for raw strided arrays.  DATA is either
+//  REAL or (REAL const) and the number of elements is a compile-time
+//  constant unless NUM_ELEMENTS is 0:
+//
+template <typename REAL, typename DATA, int NUM_ELEMENTS>
+class PrimvarArrayElement {
+public:
+    PrimvarArrayElement(DATA * data, int numElements) :
+        _data(data), _numElements(numElements) { }
+
+    DATA * GetData() const { return _data; }
+
+    int GetNumElements() const {
+        return NUM_ELEMENTS ? NUM_ELEMENTS : _numElements;
+    }
+
+    void Clear() {
+        int const n = GetNumElements();
+        for (int i = 0; i < n; ++i) {
+            _data[i] = 0;
+        }
+    }
+
+    template <typename SRC_DATA>
+    void AddWithWeight(PrimvarArrayElement<REAL, SRC_DATA, NUM_ELEMENTS> const & src,
+                       REAL weight) {
+        REAL const * srcData = src.GetData();
+
+        //  Accumulate in blocks of four when the number of elements is not
+        //  known at compile time, to keep the loop free of dependencies:
+        int const n = GetNumElements();
+        int i = 0;
+        if (!NUM_ELEMENTS) {
+            for ( ; i + 4 <= n; i += 4) {
+                REAL s0 = srcData[i],   s1 = srcData[i+1],
+                     s2 = srcData[i+2], s3 = srcData[i+3];
+                _data[i]   += weight * s0;
+                _data[i+1] += weight * s1;
+                _data[i+2] += weight * s2;
+                _data[i+3] += weight * s3;
+            }
+        }
+        for ( ; i < n; ++i) {
+            _data[i] += weight * srcData[i];
+        }
+    }
+
+private:
+    DATA * _data;
+    int    _numElements;
+};
+
+template <typename REAL, typename DATA, int NUM_ELEMENTS>
+class PrimvarArray {
+public:
+    typedef PrimvarArrayElement<REAL, DATA, NUM_ELEMENTS> Element;
+
+    PrimvarArray(DATA * data, int numElements, int stride) :
+        _data(data), _numElements(numElements), _stride(stride) { }
+
+    Element operator[](int index) const {
+        return Element(_data + (std::ptrdiff_t)index * _stride, _numElements);
+    }
+
+private:
+    DATA * _data;
+    int    _numElements;
+    int    _stride;
+};
+
+//
+//  Recording of the masks of a block of child vertices (or values), which
+//  are then applied one element at a time across all vertices of the block.
+//  Each weight refers to element 0 of its source and the stride between
+//  the elements of that source, which differs for sources in the
+//  destination array (e.g. face points for edge points):
+//
+template <typename REAL>
+class PrimvarMaskRecorder {
+public:
+    void Reset() {
+        _rowDst.clear();
+        _entries.clear();
+        _interleaved = false;
+    }
+
+    void BeginRow(REAL * dst) {
+        _rowDst.push_back(dst);
+    }
+
+    void AddWeight(REAL * dst, REAL const * src, int srcElementStride, REAL weight) {
+        //  Rows of the two tangents of a limit vertex are interleaved, so
+        //  search back from the last one:
+        int row = (int)_rowDst.size() - 1;
+        if (_rowDst[row] != dst) {
+            _interleaved = true;
+            do {
+                --row;
+                assert(row >= 0);
+            } while (_rowDst[row] != dst);
+        }
+        Entry entry = { row, srcElementStride, src, weight };
+        _entries.push_back(entry);
+    }
+
+    //  The weights are first gathered by row, keeping the order in which
+    //  they were added so that the results are identical to those of
+    //  Clear() and AddWithWeight().  Consecutive rows with the same number
+    //  of weights are then applied together, one element at a time, with
+    //  the innermost loop across the rows:
+    void Apply(int numElements, int dstElementStride);
+
+private:
+    struct Entry {
+        int          row;
+        int          elementStride;
+        REAL const * src;
+        REAL         weight;
+    };
+
+    std::vector<REAL *> _rowDst;
+    std::vector<Entry>  _entries;
+    bool                _interleaved;
+
+    //  Weights gathered by row and the sums of a run of rows:
+    std::vector<int>    _rowOffsets;
+    std::vector<int>    _rowFill;
+    std::vector<Entry>  _rowEntries;
+    std::vector<REAL>   _sums;
+};
+
+template <typename REAL>
+inline void
+PrimvarMaskRecorder<REAL>::Apply(int numElements, int dstElementStride) {
+
+    int const numRows    = (int)_rowDst.size();
+    int const numEntries = (int)_entries.size();
+    if (numRows == 0) return;
+
+    _rowOffsets.assign(numRows + 1, 0);
+    for (int i = 0; i < numEntries; ++i) {
+        ++_rowOffsets[_entries[i].row + 1];
+    }
+    for (int row = 0; row < numRows; ++row) {
+        _rowOffsets[row + 1] += _rowOffsets[row];
+    }
+    if (_interleaved) {
+        _rowEntries.resize(numEntries);
+        _rowFill.assign(_rowOffsets.begin(), _rowOffsets.end() - 1);
+        for (int i = 0; i < numEntries; ++i) {
+            _rowEntries[_rowFill[_entries[i].row]++] = _entries[i];
+        }
+        _entries.swap(_rowEntries);
+    }
+    _sums.resize(4 * numRows);
+
+    int const *    offsets = &_rowOffsets[0];
+    Entry const *  entries = numEntries ? &_entries[0] : 0;
+    REAL * const * dst     = &_rowDst[0];
+    REAL *         sums    = &_sums[0];
+
+    for (int runBegin = 0, runEnd = 0; runBegin < numRows; runBegin = runEnd) {
+        int const size = offsets[runBegin + 1] - offsets[runBegin];
+        for (runEnd = runBegin + 1; runEnd < numRows; ++runEnd) {
+            if (offsets[runEnd + 1] - offsets[runEnd] != size) break;
+        }
+        int const numRunRows = runEnd - runBegin;
+
+        Entry const * runEntries = entries + offsets[runBegin];
+
+        //  Elements are applied in groups of four to share the loads of the
+        //  weights and source pointers:
+        int element = 0;
+        for ( ; element + 4 <= numElements; element += 4) {
+            REAL * sums0 = sums,
+                 * sums1 = sums + numRunRows,
+                 * sums2 = sums + 2 * numRunRows,
+                 * sums3 = sums + 3 * numRunRows;
+            for (int row = 0; row < numRunRows; ++row) {
+                sums0[row] = sums1[row] = sums2[row] = sums3[row] = 0;
+            }
+            for (int k = 0; k < size; ++k) {
+                for (int row = 0; row < numRunRows; ++row) {
+                    Entry const & entry = runEntries[row * size + k];
+                    REAL const * src = entry.src + (std::ptrdiff_t)element * entry.elementStride;
+                    sums0[row] += entry.weight * src[0];
+                    sums1[row] += entry.weight * src[entry.elementStride];
+                    sums2[row] += entry.weight * src[2 * entry.elementStride];
+                    sums3[row] += entry.weight * src[3 * entry.elementStride];
+                }
+            }
+            for (int i = 0; i < 4; ++i) {
+                std::ptrdiff_t dstOffset = (std::ptrdiff_t)(element + i) * dstElementStride;
+                REAL const * elementSums = sums + i * numRunRows;
+                for (int row = 0; row < numRunRows; ++row) {
+                    dst[runBegin + row][dstOffset] = elementSums[row];
+                }
+            }
+        }
+        for ( ; element < numElements; ++element) {
+            for (int row = 0; row < numRunRows; ++row) {
+                sums[row] = 0;
+            }
+            for (int k = 0; k < size; ++k) {
+                for (int row = 0; row < numRunRows; ++row) {
+                    Entry const & entry = runEntries[row * size + k];
+                    sums[row] += entry.weight *
+                        entry.src[(std::ptrdiff_t)element * entry.elementStride];
+                }
+            }
+            std::ptrdiff_t dstOffset = (std::ptrdiff_t)element * dstElementStride;
+            for (int row = 0; row < numRunRows; ++row) {
+                dst[runBegin + row][dstOffset] = sums[row];
+            }
+        }
+    }
+}
+
+//
+//  Element and array classes fulfilling the source and destination
+//  interfaces of PrimvarRefinerReal by recording the masks:
+//
+template <typename REAL, typename DATA>
+class PrimvarRecordingElement {
+public:
+    PrimvarRecordingElement(DATA * data, int elementStride,
+                            PrimvarMaskRecorder<REAL> * recorder) :
+        _data(data), _elementStride(elementStride), _recorder(recorder) { }
+
+    DATA * GetData() const { return _data; }
+
+    int GetElementStride() const { return _elementStride; }
+
+    void Clear() { _recorder->BeginRow(_data); }
+
+    template <typename SRC_DATA>
+    void AddWithWeight(PrimvarRecordingElement<REAL, SRC_DATA> const & src,
+                       REAL weight) {
+        _recorder->AddWeight(_data, src.GetData(), src.GetElementStride(), weight);
+    }
+
+private:
+    DATA *                      _data;
+    int                         _elementStride;
+    PrimvarMaskRecorder<REAL> * _recorder;
+};
+
+template <typename REAL, typename DATA>
+class PrimvarRecordingArray {
+public:
+    typedef PrimvarRecordingElement<REAL, DATA> Element;
+
+    PrimvarRecordingArray(DATA * data, int elementStride,
+                          PrimvarMaskRecorder<REAL> * recorder = 0) :
+        _data(data), _elementStride(elementStride), _recorder(recorder) { }
+
+    Element operator[](int index) const {
+        return Element(_data + index, _elementStride, _recorder);
+    }
+
+private:
+    DATA *                      _data;
+    int                         _elementStride;
+    PrimvarMaskRecorder<REAL> * _recorder;
+};
+
+} // end namespace internal
+
+///
+///  \brief Applies refinement operations to primvar data in raw arrays.
+///
+///  PrimvarArrayRefinerReal applies the same masks as PrimvarRefinerReal
+///  to primvar data stored as arrays of REAL with a given number of
+///  elements per vertex (or face-varying value), without requiring a class
+///  that implements Clear() and AddWithWeight().  Two layouts are supported:
+///
+///  - interleaved: the elements of a vertex are contiguous and vertices
+///    are separated by a stride.  Each weight is accumulated with a loop
+///    over the elements of a vertex, which is unrolled for primvars of up
+///    to four elements and vectorizes for larger ones.
+///
+///  - separate arrays ("SoA"): each element is stored in its own array of
+///    all vertices and the arrays are separated by an element stride.  The
+///    masks of blocks of child vertices are recorded first and then applied
+///    one element at a time with the innermost loop across the vertices of
+///    the block, so the masks are computed once for all elements.  The
+///    recording has a cost per weight that is only amortized for primvars
+///    with many elements -- data that is already interleaved should not be
+///    transposed to use it.
+///
+///  Results are identical to those of PrimvarRefinerReal in both cases.
+///
+///  Overloads taking a dispatcher distribute the work as described for
+///  PrimvarRefinerReal (see \ref dispatching).
+///
+template <typename REAL>
+class PrimvarArrayRefinerReal {
+
+public:
+    PrimvarArrayRefinerReal(TopologyRefiner const & refiner) : _primvarRefiner(refiner) { }
+    ~PrimvarArrayRefinerReal() { }
+
+    TopologyRefiner const & GetTopologyRefiner() const { return _primvarRefiner.GetTopologyRefiner(); }
+
+    //@{
+    ///  @name Primvar data interpolation
+    ///
+    /// The source and destination arrays are of the sizes required by the
+    /// corresponding methods of PrimvarRefinerReal, with \p numElements
+    /// values of type REAL per vertex (or value) separated by \p srcStride
+    /// and \p dstStride respectively.
+    ///
+
+    /// \brief Apply vertex interpolation weights for a single level of refinement
+    void Interpolate(int level, REAL const * src, REAL * dst,
+                     int numElements, int srcStride, int dstStride) const {
+        Interpolate(level, src, dst, numElements, srcStride, dstStride, SerialDispatcher());
+    }
+
+    template <class DISPATCHER>
+    void Interpolate(int level, REAL const * src, REAL * dst,
+                     int numElements, int srcStride, int dstStride,
+                     DISPATCHER const & dispatcher) const;
+
+    /// \brief Apply only varying interpolation weights for a single level of refinement
+    void InterpolateVarying(int level, REAL const * src, REAL * dst,
+                            int numElements, int srcStride, int dstStride) const;
+
+    /// \brief Apply face-varying interpolation weights for a single level of refinement
+    void InterpolateFaceVarying(int level, REAL const * src, REAL * dst,
+                                int numElements, int srcStride, int dstStride,
+                                int channel = 0) const {
+        InterpolateFaceVarying(level, src, dst, numElements, srcStride, dstStride,
+                               channel, SerialDispatcher());
+    }
+
+    template <class DISPATCHER>
+    void InterpolateFaceVarying(int level, REAL const * src, REAL * dst,
+                                int numElements, int srcStride, int dstStride,
+                                int channel, DISPATCHER const & dispatcher) const;
+
+    /// \brief Apply limit weights to the vertices of the last level
+    void Limit(REAL const * src, REAL * dstPos,
+               int numElements, int srcStride, int dstStride) const {
+        Limit(src, dstPos, numElements, srcStride, dstStride, SerialDispatcher());
+    }
+
+    template <class DISPATCHER>
+    void Limit(REAL const * src, REAL * dstPos,
+               int numElements, int srcStride, int dstStride,
+               DISPATCHER const & dispatcher) const;
+
+    /// \brief Apply limit and tangent weights to the vertices of the last
+    ///        level -- all destination arrays share the same stride
+    void Limit(REAL const * src, REAL * dstPos, REAL * dstTan1, REAL * dstTan2,
+               int numElements, int srcStride, int dstStride) const {
+        Limit(src, dstPos, dstTan1, dstTan2, numElements, srcStride, dstStride,
+              SerialDispatcher());
+    }
+
+    template <class DISPATCHER>
+    void Limit(REAL const * src, REAL * dstPos, REAL * dstTan1, REAL * dstTan2,
+               int numElements, int srcStride, int dstStride,
+               DISPATCHER const & dispatcher) const;
+
+    /// \brief Apply limit weights to the face-varying values of the last level
+    void LimitFaceVarying(REAL const * src, REAL * dst,
+                          int numElements, int srcStride, int dstStride,
+                          int channel = 0) const {
+        LimitFaceVarying(src, dst, numElements, srcStride, dstStride,
+                         channel, SerialDispatcher());
+    }
+
+    template <class DISPATCHER>
+    void LimitFaceVarying(REAL const * src, REAL * dst,
+                          int numElements, int srcStride, int dstStride,
+                          int channel, DISPATCHER const & dispatcher) const;
+
+    //@}
+
+    //@{
+    ///  @name Primvar data interpolation with separate element arrays
+    ///
+    /// Element i of vertex (or value) v is stored at
+    /// data[i * elementStride + v], where \p srcElementStride and
+    /// \p dstElementStride are at least the number of vertices (or values)
+    /// of the source and destination respectively.
+    ///
+
+    /// \brief Apply vertex interpolation weights for a single level of refinement
+    void InterpolateSoA(int level, REAL const * src, REAL * dst, int numElements,
+                        int srcElementStride, int dstElementStride) const {
+        InterpolateSoA(level, src, dst, numElements, srcElementStride, dstElementStride,
+                       SerialDispatcher());
+    }
+
+    template <class DISPATCHER>
+    void InterpolateSoA(int level, REAL const * src, REAL * dst, int numElements,
+                        int srcElementStride, int dstElementStride,
+                        DISPATCHER const & dispatcher) const {
+        interpolateSoA(level, src, dst, numElements, srcElementStride, dstElementStride,
+                       -1, dispatcher);
+    }
+
+    /// \brief Apply face-varying interpolation weights for a single level of refinement
+    void InterpolateFaceVaryingSoA(int level, REAL const * src, REAL * dst, int numElements,
+                                   int srcElementStride, int dstElementStride,
+                                   int channel = 0) const {
+        InterpolateFaceVaryingSoA(level, src, dst, numElements, srcElementStride,
+                                  dstElementStride, channel, SerialDispatcher());
+    }
+
+    template <class DISPATCHER>
+    void InterpolateFaceVaryingSoA(int level, REAL const * src, REAL * dst, int numElements,
+                                   int srcElementStride, int dstElementStride,
+                                   int channel, DISPATCHER const & dispatcher) const {
+        interpolateSoA(level, src, dst, numElements, srcElementStride, dstElementStride,
+                       channel, dispatcher);
+    }
+
+    /// \brief Apply limit weights to the vertices of the last level
+    void LimitSoA(REAL const * src, REAL * dstPos, int numElements,
+                  int srcElementStride, int dstElementStride) const {
+        LimitSoA(src, dstPos, 0, 0, numElements, srcElementStride, dstElementStride,
+                 SerialDispatcher());
+    }
+
+    template <class DISPATCHER>
+    void LimitSoA(REAL const * src, REAL * dstPos, int numElements,
+                  int srcElementStride, int dstElementStride,
+                  DISPATCHER const & dispatcher) const {
+        LimitSoA(src, dstPos, 0, 0, numElements, srcElementStride, dstElementStride,
+                 dispatcher);
+    }
+
+    /// \brief Apply limit and tangent weights to the vertices of the last
+    ///        level -- all destination arrays share the same element stride
+    void LimitSoA(REAL const * src, REAL * dstPos, REAL * dstTan1, REAL * dstTan2,
+                  int numElements, int srcElementStride, int dstElementStride) const {
+        LimitSoA(src, dstPos, dstTan1, dstTan2, numElements, srcElementStride,
+                 dstElementStride, SerialDispatcher());
+    }
+
+    template <class DISPATCHER>
+    void LimitSoA(REAL const * src, REAL * dstPos, REAL * dstTan1, REAL * dstTan2,
+                  int numElements, int srcElementStride, int dstElementStride,
+                  DISPATCHER const & dispatcher) const {
+        limitSoA(src, dstPos, dstTan1, dstTan2, numElements, srcElementStride,
+                 dstElementStride, -1, dispatcher);
+    }
+
+    /// \brief Apply limit weights to the face-varying values of the last level
+    void LimitFaceVaryingSoA(REAL const * src, REAL * dst, int numElements,
+                             int srcElementStride, int dstElementStride,
+                             int channel = 0) const {
+        LimitFaceVaryingSoA(src, dst, numElements, srcElementStride, dstElementStride,
+                            channel, SerialDispatcher());
+    }
+
+    template <class DISPATCHER>
+    void LimitFaceVaryingSoA(REAL const * src, REAL * dst, int numElements,
+                             int srcElementStride, int dstElementStride,
+                             int channel, DISPATCHER const & dispatcher) const {
+        limitSoA(src, dst, 0, 0, numElements, srcElementStride, dstElementStride,
+                 channel, dispatcher);
+    }
+
+    //@}
+
+private:
+    //  Non-copyable:
+    PrimvarArrayRefinerReal(PrimvarArrayRefinerReal const & src) :
+        _primvarRefiner(src.GetTopologyRefiner()) { }
+    PrimvarArrayRefinerReal & operator=(PrimvarArrayRefinerReal const &) { return *this; }
+
+    struct SerialDispatcher {
+        template <class TASK>
+        void operator()(int size, TASK const & task) const { task(0, size); }
+    };
+
+    //  Operations applied to recorded masks -- the components of a level
+    //  or the limit of the vertices (or values) of the last level:
+    enum Operation { INTERPOLATE_FACES, INTERPOLATE_EDGES, INTERPOLATE_VERTICES, LIMIT };
+
+    template <Sdc::SchemeType SCHEME>
+    class RecordedTask;
+
+    //  Vertex data if channel is negative, otherwise face-varying data:
+    template <class DISPATCHER>
+    void interpolateSoA(int level, REAL const * src, REAL * dst, int numElements,
+                        int srcElementStride, int dstElementStride,
+                        int channel, DISPATCHER const & dispatcher) const;
+
+    template <class DISPATCHER>
+    void limitSoA(REAL const * src, REAL * dstPos, REAL * dstTan1, REAL * dstTan2,
+                  int numElements, int srcElementStride, int dstElementStride,
+                  int channel, DISPATCHER const & dispatcher) const;
+
+    template <int NUM_ELEMENTS>
+    struct Arrays {
+        typedef internal::PrimvarArray<REAL, REAL const, NUM_ELEMENTS> Source;
+        typedef internal::PrimvarArray<REAL, REAL,       NUM_ELEMENTS> Destination;
+    };
+
+    template <int NUM_ELEMENTS, class DISPATCHER>
+    void interpolate(int level, REAL const * src, REAL * dst,
+                     int numElements, int srcStride, int dstStride,
+                     DISPATCHER const & dispatcher) const {
+        typename Arrays<NUM_ELEMENTS>::Source      srcArray(src, numElements, srcStride);
+        typename Arrays<NUM_ELEMENTS>::Destination dstArray(dst, numElements, dstStride);
+        _primvarRefiner.Interpolate(level, srcArray, dstArray, dispatcher);
+    }
+
+    template <int NUM_ELEMENTS, class DISPATCHER>
+    void interpolateFVar(int level, REAL const * src, REAL * dst,
+                         int numElements, int srcStride, int dstStride,
+                         int channel, DISPATCHER const & dispatcher) const {
+        typename Arrays<NUM_ELEMENTS>::Source      srcArray(src, numElements, srcStride);
+        typename Arrays<NUM_ELEMENTS>::Destination dstArray(dst, numElements, dstStride);
+        _primvarRefiner.InterpolateFaceVarying(level, srcArray, dstArray, channel, dispatcher);
+    }
+
+    template <int NUM_ELEMENTS, class DISPATCHER>
+    void limit(REAL const * src, REAL * dstPos, REAL * dstTan1, REAL * dstTan2,
+               int numElements, int srcStride, int dstStride,
+               DISPATCHER const & dispatcher) const {
+        typename Arrays<NUM_ELEMENTS>::Source      srcArray(src, numElements, srcStride);
+        typename Arrays<NUM_ELEMENTS>::Destination posArray(dstPos, numElements, dstStride);
+        if (dstTan1 && dstTan2) {
+            typename Arrays<NUM_ELEMENTS>::Destination tan1Array(dstTan1, numElements, dstStride);
+            typename Arrays<NUM_ELEMENTS>::Destination tan2Array(dstTan2, numElements, dstStride);
+            _primvarRefiner.Limit(srcArray, posArray, tan1Array, tan2Array, dispatcher);
+        } else {
+            _primvarRefiner.Limit(srcArray, posArray, dispatcher);
+        }
+    }
+
+    template <int NUM_ELEMENTS, class DISPATCHER>
+    void limitFVar(REAL const * src, REAL * dst,
+                   int numElements, int srcStride, int dstStride,
+                   int channel, DISPATCHER const & dispatcher) const {
+        typename Arrays<NUM_ELEMENTS>::Source      srcArray(src, numElements, srcStride);
+        typename Arrays<NUM_ELEMENTS>::Destination dstArray(dst, numElements, dstStride);
+        _primvarRefiner.LimitFaceVarying(srcArray, dstArray, channel, dispatcher);
+    }
+
+private:
+    PrimvarRefinerReal<REAL> _primvarRefiner;
+};
+
+//
+//  Task recording the masks of a range of components in blocks and applying
+//  them across the vertices of each block -- the recorder is local to the
+//  invocation and so to the thread executing it:
+//
+template <typename REAL>
+template <Sdc::SchemeType SCHEME>
+class PrimvarArrayRefinerReal<REAL>::RecordedTask {
+public:
+    RecordedTask(PrimvarRefinerReal<REAL> const & primvarRefiner,
+                 Operation operation, int level, int channel,
+                 REAL const * src, REAL * dst0, REAL * dst1, REAL * dst2,
+                 int numElements, int srcElementStride, int dstElementStride) :
+        _primvarRefiner(primvarRefiner), _operation(operation),
+        _level(level), _channel(channel), _src(src), _numElements(numElements),
+        _srcElementStride(srcElementStride), _dstElementStride(dstElementStride) {
+        _dst[0] = dst0;
+        _dst[1] = dst1;
+        _dst[2] = dst2;
+    }
+
+    void operator()(int begin, int end) const;
+
+private:
+    PrimvarRefinerReal<REAL> const & _primvarRefiner;
+    Operation    _operation;
+    int          _level;
+    int          _channel;
+    REAL const * _src;
+    REAL *       _dst[3];
+    int          _numElements;
+    int          _srcElementStride;
+    int          _dstElementStride;
+};
+
+template <typename REAL>
+template <Sdc::SchemeType SCHEME>
+inline void
+PrimvarArrayRefinerReal<REAL>::RecordedTask<SCHEME>::operator()(int begin, int end) const {
+
+    typedef internal::PrimvarRecordingArray<REAL, REAL const> Source;
+    typedef internal::PrimvarRecordingArray<REAL, REAL>       Destination;
+
+    int const blockSize = 64;
+
+    internal::PrimvarMaskRecorder<REAL> recorder;
+
+    Source      src(_src, _srcElementStride);
+    Destination dst0(_dst[0], _dstElementStride, &recorder),
+                dst1(_dst[1], _dstElementStride, &recorder),
+                dst2(_dst[2], _dstElementStride, &recorder);
+
+    bool hasTangents = _dst[1] && _dst[2];
+
+    for (int blockBegin = begin; blockBegin < end; blockBegin += blockSize) {
+        int blockEnd = std::min(blockBegin + blockSize, end);
+
+        recorder.Reset();
+        switch (_operation) {
+        case INTERPOLATE_FACES:
+            if (_channel < 0) {
+                _primvarRefiner.template interpFromFaces<SCHEME>(_level, src, dst0, blockBegin, blockEnd);
+            } else {
+                _primvarRefiner.template interpFVarFromFaces<SCHEME>(_level, src, dst0, _channel, blockBegin, blockEnd);
+            }
+            break;
+        case INTERPOLATE_EDGES:
+            if (_channel < 0) {
+                _primvarRefiner.template interpFromEdges<SCHEME>(_level, src, dst0, blockBegin, blockEnd);
+            } else {
+                _primvarRefiner.template interpFVarFromEdges<SCHEME>(_level, src, dst0, _channel, blockBegin, blockEnd);
+            }
+            break;
+        case INTERPOLATE_VERTICES:
+            if (_channel < 0) {
+                _primvarRefiner.template interpFromVerts<SCHEME>(_level, src, dst0, blockBegin, blockEnd);
+            } else {
+                _primvarRefiner.template interpFVarFromVerts<SCHEME>(_level, src, dst0, _channel, blockBegin, blockEnd);
+            }
+            break;
+        case LIMIT:
+            if (_channel < 0) {
+                _primvarRefiner.template limit<SCHEME>(src, dst0,
+                    hasTangents ? &dst1 : (Destination *)0,
+                    hasTangents ? &dst2 : (Destination *)0, blockBegin, blockEnd);
+            } else {
+                _primvarRefiner.template limitFVar<SCHEME>(src, dst0, _channel, blockBegin, blockEnd);
+            }
+            break;
+        }
+        recorder.Apply(_numElements, _dstElementStride);
+    }
+}
+
+template <typename REAL>
+template <class DISPATCHER>
+inline void
+PrimvarArrayRefinerReal<REAL>::interpolateSoA(int level, REAL const * src, REAL * dst,
+        int numElements, int srcElementStride, int dstElementStride,
+        int channel, DISPATCHER const & dispatcher) const {
+
+    if (!_primvarRefiner.hasRefinedTopology((channel < 0) ?
+            "PrimvarArrayRefiner::InterpolateSoA()" :
+            "PrimvarArrayRefiner::InterpolateFaceVaryingSoA()")) {
+        return;
+    }
+
+    //  As with PrimvarRefinerReal, all child vertices originating from faces
+    //  must be computed before those from edges and vertices:
+    TopologyLevel const & parent = GetTopologyRefiner().GetLevel(level - 1);
+
+    Operation const operations[3] = { INTERPOLATE_FACES, INTERPOLATE_EDGES, INTERPOLATE_VERTICES };
+    int const       sizes[3] = { parent.GetNumFaces(), parent.GetNumEdges(), parent.GetNumVertices() };
+
+    for (int i = 0; i < 3; ++i) {
+        switch (GetTopologyRefiner().GetSchemeType()) {
+        case Sdc::SCHEME_CATMARK:
+            dispatcher(sizes[i], RecordedTask<Sdc::SCHEME_CATMARK>(_primvarRefiner,
+                operations[i], level, channel, src, dst, 0, 0,
+                numElements, srcElementStride, dstElementStride));
+            break;
+        case Sdc::SCHEME_LOOP:
+            dispatcher(sizes[i], RecordedTask<Sdc::SCHEME_LOOP>(_primvarRefiner,
+                operations[i], level, channel, src, dst, 0, 0,
+                numElements, srcElementStride, dstElementStride));
+            break;
+        case Sdc::SCHEME_BILINEAR:
+            dispatcher(sizes[i], RecordedTask<Sdc::SCHEME_BILINEAR>(_primvarRefiner,
+                operations[i], level, channel, src, dst, 0, 0,
+                numElements, srcElementStride, dstElementStride));
+            break;
+        }
+    }
+}
+
+template <typename REAL>
+template <class DISPATCHER>
+inline void
+PrimvarArrayRefinerReal<REAL>::limitSoA(REAL const * src,
+        REAL * dstPos, REAL * dstTan1, REAL * dstTan2,
+        int numElements, int srcElementStride, int dstElementStride,
+        int channel, DISPATCHER const & dispatcher) const {
+
+    if (!_primvarRefiner.hasLimitTopology((channel < 0) ?
+            "PrimvarArrayRefiner::LimitSoA()" :
+            "PrimvarArrayRefiner::LimitFaceVaryingSoA()")) {
+        return;
+    }
+
+    TopologyRefiner const & refiner = GetTopologyRefiner();
+
+    int maxLevel = refiner.GetMaxLevel();
+    int size = refiner.GetLevel(maxLevel).GetNumVertices();
+
+    switch (refiner.GetSchemeType()) {
+    case Sdc::SCHEME_CATMARK:
+        dispatcher(size, RecordedTask<Sdc::SCHEME_CATMARK>(_primvarRefiner,
+            LIMIT, maxLevel, channel, src, dstPos, dstTan1, dstTan2,
+            numElements, srcElementStride, dstElementStride));
+        break;
+    case Sdc::SCHEME_LOOP:
+        dispatcher(size, RecordedTask<Sdc::SCHEME_LOOP>(_primvarRefiner,
+            LIMIT, maxLevel, channel, src, dstPos, dstTan1, dstTan2,
+            numElements, srcElementStride, dstElementStride));
+        break;
+    case Sdc::SCHEME_BILINEAR:
+        dispatcher(size, RecordedTask<Sdc::SCHEME_BILINEAR>(_primvarRefiner,
+            LIMIT, maxLevel, channel, src, dstPos, dstTan1, dstTan2,
+            numElements, srcElementStride, dstElementStride));
+        break;
+    }
+}
+
+//
+//  Public entry points -- dispatching the common small numbers of elements
+//  to instances for which the number of elements is known at compile time:
+//
+template <typename REAL>
+template <class DISPATCHER>
+inline void
+PrimvarArrayRefinerReal<REAL>::Interpolate(int level, REAL const * src, REAL * dst,
+        int numElements, int srcStride, int dstStride, DISPATCHER const & dispatcher) const {
+
+    switch (numElements) {
+    case 1:  interpolate<1>(level, src, dst, numElements, srcStride, dstStride, dispatcher); break;
+    case 2:  interpolate<2>(level, src, dst, numElements, srcStride, dstStride, dispatcher); break;
+    case 3:  interpolate<3>(level, src, dst, numElements, srcStride, dstStride, dispatcher); break;
+    case 4:  interpolate<4>(level, src, dst, numElements, srcStride, dstStride, dispatcher); break;
+    default: interpolate<0>(level, src, dst, numElements, srcStride, dstStride, dispatcher); break;
+    }
+}
+
+template <typename REAL>
+inline void
+PrimvarArrayRefinerReal<REAL>::InterpolateVarying(int level, REAL const * src, REAL * dst,
+        int numElements, int srcStride, int dstStride) const {
+
+    typename Arrays<0>::Source      srcArray(src, numElements, srcStride);
+    typename Arrays<0>::Destination dstArray(dst, numElements, dstStride);
+    _primvarRefiner.InterpolateVarying(level, srcArray, dstArray);
+}
+
+template <typename REAL>
+template <class DISPATCHER>
+inline void
+PrimvarArrayRefinerReal<REAL>::InterpolateFaceVarying(int level, REAL const * src, REAL * dst,
+        int numElements, int srcStride, int dstStride,
+        int channel, DISPATCHER const & dispatcher) const {
+
+    switch (numElements) {
+    case 1:  interpolateFVar<1>(level, src, dst, numElements, srcStride, dstStride, channel, dispatcher); break;
+    case 2:  interpolateFVar<2>(level, src, dst, numElements, srcStride, dstStride, channel, dispatcher); break;
+    case 3:  interpolateFVar<3>(level, src, dst, numElements, srcStride, dstStride, channel, dispatcher); break;
+    case 4:  interpolateFVar<4>(level, src, dst, numElements, srcStride, dstStride, channel, dispatcher); break;
+    default: interpolateFVar<0>(level, src, dst, numElements, srcStride, dstStride, channel, dispatcher); break;
+    }
+}
+
+template <typename REAL>
+template <class DISPATCHER>
+inline void
+PrimvarArrayRefinerReal<REAL>::Limit(REAL const * src, REAL * dstPos,
+        int numElements, int srcStride, int dstStride, DISPATCHER const & dispatcher) const {
+
+    Limit(src, dstPos, 0, 0, numElements, srcStride, dstStride, dispatcher);
+}
+
+template <typename REAL>
+template <class DISPATCHER>
+inline void
+PrimvarArrayRefinerReal<REAL>::Limit(REAL const * src, REAL * dstPos, REAL * dstTan1, REAL * dstTan2,
+        int numElements, int srcStride, int dstStride, DISPATCHER const & dispatcher) const {
+
+    switch (numElements) {
+    case 1:  limit<1>(src, dstPos, dstTan1, dstTan2, numElements, srcStride, dstStride, dispatcher); break;
+    case 2:  limit<2>(src, dstPos, dstTan1, dstTan2, numElements, srcStride, dstStride, dispatcher); break;
+    case 3:  limit<3>(src, dstPos, dstTan1, dstTan2, numElements, srcStride, dstStride, dispatcher); break;
+    case 4:  limit<4>(src, dstPos, dstTan1, dstTan2, numElements, srcStride, dstStride, dispatcher); break;
+    default: limit<0>(src, dstPos, dstTan1, dstTan2, numElements, srcStride, dstStride, dispatcher); break;
+    }
+}
+
+template <typename REAL>
+template <class DISPATCHER>
+inline void
+PrimvarArrayRefinerReal<REAL>::LimitFaceVarying(REAL const * src, REAL * dst,
+        int numElements, int srcStride, int dstStride,
+        int channel, DISPATCHER const & dispatcher) const {
+
+    switch (numElements) {
+    case 1:  limitFVar<1>(src, dst, numElements, srcStride, dstStride, channel, dispatcher); break;
+    case 2:  limitFVar<2>(src, dst, numElements, srcStride, dstStride, channel, dispatcher); break;
+    case 3:  limitFVar<3>(src, dst, numElements, srcStride, dstStride, channel, dispatcher); break;
+    case 4:  limitFVar<4>(src, dst, numElements, srcStride, dstStride, channel, dispatcher); break;
+    default: limitFVar<0>(src, dst, numElements, srcStride, dstStride, channel, dispatcher); break;
+    }
+}
+
+class PrimvarArrayRefiner : public PrimvarArrayRefinerReal<float> {
+public:
+    PrimvarArrayRefiner(TopologyRefiner const & refiner)
+        : PrimvarArrayRefinerReal<float>(refiner) { }
+};
+
+} // end namespace Far
+
+} // end namespace OPENSUBDIV_VERSION
+using namespace OPENSUBDIV_VERSION;
+} // end namespace OpenSubdiv
+
+#endif /* OPENSUBDIV3_FAR_PRIMVAR_ARRAY_REFINER_H */
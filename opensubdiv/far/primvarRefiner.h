@@ -181,6 +181,69 @@ public:
 
     //@}
 
+    //@{
+    ///  @name Parallel primvar data interpolation
+    ///
+    /// \anchor dispatching
+    ///
+    /// \note The following methods are equivalent to the ones above, but
+    ///       the components of each level are processed in ranges issued
+    ///       through a client-supplied dispatcher, e.g. to distribute them
+    ///       over multiple threads. The dispatcher must implement:
+    ///       <br><br> \code{.cpp}
+    ///
+    ///       class MyDispatcher {
+    ///           template <class TASK>
+    ///           void operator()(int size, TASK const & task) const;
+    ///       };
+    ///
+    ///       \endcode
+    ///       <br>
+    ///       which must invoke task(begin, end) over disjoint ranges covering
+    ///       [0, size) and return only once all of them have completed. The
+    ///       ranges may be processed concurrently, so the primvar buffers
+    ///       must support concurrent access to distinct elements. For example
+    ///       with OpenMP:
+    ///       <br><br> \code{.cpp}
+    ///
+    ///       template <class TASK>
+    ///       void operator()(int size, TASK const & task) const {
+    ///           int const grainSize = 256;
+    ///           #pragma omp parallel for
+    ///           for (int begin = 0; begin < size; begin += grainSize) {
+    ///               task(begin, std::min(begin + grainSize, size));
+    ///           }
+    ///       }
+    ///
+    ///       \endcode
+    ///
+
+    /// \brief Apply vertex interpolation weights to a primvar buffer for a single
+    ///        level of refinement using a dispatcher (see \ref dispatching)
+    template <class T, class U, class DISPATCHER>
+    void Interpolate(int level, T const & src, U & dst, DISPATCHER const & dispatcher) const;
+
+    /// \brief Apply face-varying interpolation weights to a primvar buffer
+    ///        using a dispatcher (see \ref dispatching)
+    template <class T, class U, class DISPATCHER>
+    void InterpolateFaceVarying(int level, T const & src, U & dst, int channel,
+                                DISPATCHER const & dispatcher) const;
+
+    /// \brief Apply limit weights to a primvar buffer using a dispatcher
+    ///        (see \ref dispatching)
+    template <class T, class U, class DISPATCHER>
+    void Limit(T const & src, U & dstPos, DISPATCHER const & dispatcher) const;
+
+    template <class T, class U, class U1, class U2, class DISPATCHER>
+    void Limit(T const & src, U & dstPos, U1 & dstTan1, U2 & dstTan2,
+               DISPATCHER const & dispatcher) const;
+
+    template <class T, class U, class DISPATCHER>
+    void LimitFaceVarying(T const & src, U & dst, int channel,
+                          DISPATCHER const & dispatcher) const;
+
+    //@}
+
 private:
     typedef REAL Weight;
 
@@ -188,19 +251,62 @@ private:
     PrimvarRefinerReal(PrimvarRefinerReal const & src) : _refiner(src._refiner) { }
     PrimvarRefinerReal & operator=(PrimvarRefinerReal const &) { return *this; }
 
-    template <Sdc::SchemeType SCHEME, class T, class U> void interpFromFaces(int, T const &, U &) const;
-    template <Sdc::SchemeType SCHEME, class T, class U> void interpFromEdges(int, T const &, U &) const;
-    template <Sdc::SchemeType SCHEME, class T, class U> void interpFromVerts(int, T const &, U &) const;
+    //  Interpolation of the child vertices (or values) originating from the
+    //  range [begin, end) of the parent faces, edges or vertices:
+    template <Sdc::SchemeType SCHEME, class T, class U> void interpFromFaces(int, T const &, U &, int, int) const;
+    template <Sdc::SchemeType SCHEME, class T, class U> void interpFromEdges(int, T const &, U &, int, int) const;
+    template <Sdc::SchemeType SCHEME, class T, class U> void interpFromVerts(int, T const &, U &, int, int) const;
+
+    template <Sdc::SchemeType SCHEME, class T, class U> void interpFVarFromFaces(int, T const &, U &, int, int, int) const;
+    template <Sdc::SchemeType SCHEME, class T, class U> void interpFVarFromEdges(int, T const &, U &, int, int, int) const;
+    template <Sdc::SchemeType SCHEME, class T, class U> void interpFVarFromVerts(int, T const &, U &, int, int, int) const;
+
+    //  Limit of the range [begin, end) of the vertices of the last level:
+    template <Sdc::SchemeType SCHEME, class T, class U, class U1, class U2>
+    void limit(T const & src, U & pos, U1 * tan1, U2 * tan2, int begin, int end) const;
+
+    template <Sdc::SchemeType SCHEME, class T, class U>
+    void limitFVar(T const & src, U & dst, int channel, int begin, int end) const;
+
+    //  Reports an error if the topology of refined levels was released:
+    bool hasRefinedTopology(char const * methodName) const;
+
+    //  Reports an error if the last level lacks the topology for limit masks:
+    bool hasLimitTopology(char const * methodName) const;
 
-    template <Sdc::SchemeType SCHEME, class T, class U> void interpFVarFromFaces(int, T const &, U &, int) const;
-    template <Sdc::SchemeType SCHEME, class T, class U> void interpFVarFromEdges(int, T const &, U &, int) const;
-    template <Sdc::SchemeType SCHEME, class T, class U> void interpFVarFromVerts(int, T const &, U &, int) const;
+    //  The array refiner records masks by invoking the range methods directly:
+    template <typename> friend class PrimvarArrayRefinerReal;
+
+    template <Sdc::SchemeType SCHEME, class T, class U, class DISPATCHER>
+    void interpolate(int level, T const & src, U & dst, DISPATCHER const & dispatcher) const;
+
+    template <Sdc::SchemeType SCHEME, class T, class U, class DISPATCHER>
+    void interpolateFVar(int level, T const & src, U & dst, int channel, DISPATCHER const & dispatcher) const;
+
+    //
+    //  Tasks invoked by the dispatcher for a range of components -- the
+    //  mask weights are allocated by each invocation and so are local to
+    //  the thread executing it:
+    //
+    enum Component { COMPONENT_FACES, COMPONENT_EDGES, COMPONENT_VERTICES };
+
+    template <Sdc::SchemeType SCHEME, class T, class U>
+    class InterpolateTask;
+
+    template <Sdc::SchemeType SCHEME, class T, class U>
+    class InterpolateFVarTask;
 
     template <Sdc::SchemeType SCHEME, class T, class U, class U1, class U2>
-    void limit(T const & src, U & pos, U1 * tan1, U2 * tan2) const;
+    class LimitTask;
 
     template <Sdc::SchemeType SCHEME, class T, class U>
-    void limitFVar(T const & src, U & dst, int channel) const;
+    class LimitFVarTask;
+
+    //  Dispatcher for the serial entry points:
+    struct SerialDispatcher {
+        template <class TASK>
+        void operator()(int size, TASK const & task) const { task(0, size); }
+    };
 
 private:
     TopologyRefiner const &  _refiner;
@@ -266,23 +372,27 @@ template <class T, class U>
 inline void
 PrimvarRefinerReal<REAL>::Interpolate(int level, T const & src, U & dst) const {
 
+    Interpolate(level, src, dst, SerialDispatcher());
+}
+
+template <typename REAL>
+template <class T, class U, class DISPATCHER>
+inline void
+PrimvarRefinerReal<REAL>::Interpolate(int level, T const & src, U & dst, DISPATCHER const & dispatcher) const {
+
+    if (!hasRefinedTopology("PrimvarRefiner::Interpolate()")) return;
+
     assert(level>0 && level<=(int)_refiner._refinements.size());
 
     switch (_refiner._subdivType) {
     case Sdc::SCHEME_CATMARK:
-        interpFromFaces<Sdc::SCHEME_CATMARK>(level, src, dst);
-        interpFromEdges<Sdc::SCHEME_CATMARK>(level, src, dst);
-        interpFromVerts<Sdc::SCHEME_CATMARK>(level, src, dst);
+        interpolate<Sdc::SCHEME_CATMARK>(level, src, dst, dispatcher);
         break;
     case Sdc::SCHEME_LOOP:
-        interpFromFaces<Sdc::SCHEME_LOOP>(level, src, dst);
-        interpFromEdges<Sdc::SCHEME_LOOP>(level, src, dst);
-        interpFromVerts<Sdc::SCHEME_LOOP>(level, src, dst);
+        interpolate<Sdc::SCHEME_LOOP>(level, src, dst, dispatcher);
         break;
     case Sdc::SCHEME_BILINEAR:
-        interpFromFaces<Sdc::SCHEME_BILINEAR>(level, src, dst);
-        interpFromEdges<Sdc::SCHEME_BILINEAR>(level, src, dst);
-        interpFromVerts<Sdc::SCHEME_BILINEAR>(level, src, dst);
+        interpolate<Sdc::SCHEME_BILINEAR>(level, src, dst, dispatcher);
         break;
     }
 }
@@ -292,23 +402,28 @@ template <class T, class U>
 inline void
 PrimvarRefinerReal<REAL>::InterpolateFaceVarying(int level, T const & src, U & dst, int channel) const {
 
+    InterpolateFaceVarying(level, src, dst, channel, SerialDispatcher());
+}
+
+template <typename REAL>
+template <class T, class U, class DISPATCHER>
+inline void
+PrimvarRefinerReal<REAL>::InterpolateFaceVarying(int level, T const & src, U & dst, int channel,
+                                                 DISPATCHER const & dispatcher) const {
+
+    if (!hasRefinedTopology("PrimvarRefiner::InterpolateFaceVarying()")) return;
+
     assert(level>0 && level<=(int)_refiner._refinements.size());
 
     switch (_refiner._subdivType) {
     case Sdc::SCHEME_CATMARK:
-        interpFVarFromFaces<Sdc::SCHEME_CATMARK>(level, src, dst, channel);
-        interpFVarFromEdges<Sdc::SCHEME_CATMARK>(level, src, dst, channel);
-        interpFVarFromVerts<Sdc::SCHEME_CATMARK>(level, src, dst, channel);
+        interpolateFVar<Sdc::SCHEME_CATMARK>(level, src, dst, channel, dispatcher);
         break;
     case Sdc::SCHEME_LOOP:
-        interpFVarFromFaces<Sdc::SCHEME_LOOP>(level, src, dst, channel);
-        interpFVarFromEdges<Sdc::SCHEME_LOOP>(level, src, dst, channel);
-        interpFVarFromVerts<Sdc::SCHEME_LOOP>(level, src, dst, channel);
+        interpolateFVar<Sdc::SCHEME_LOOP>(level, src, dst, channel, dispatcher);
         break;
     case Sdc::SCHEME_BILINEAR:
-        interpFVarFromFaces<Sdc::SCHEME_BILINEAR>(level, src, dst, channel);
-        interpFVarFromEdges<Sdc::SCHEME_BILINEAR>(level, src, dst, channel);
-        interpFVarFromVerts<Sdc::SCHEME_BILINEAR>(level, src, dst, channel);
+        interpolateFVar<Sdc::SCHEME_BILINEAR>(level, src, dst, channel, dispatcher);
         break;
     }
 }
@@ -318,22 +433,27 @@ template <class T, class U>
 inline void
 PrimvarRefinerReal<REAL>::Limit(T const & src, U & dst) const {
 
-    if (_refiner.getLevel(_refiner.GetMaxLevel()).getNumVertexEdgesTotal() == 0) {
-        Error(FAR_RUNTIME_ERROR,
-            "Failure in PrimvarRefiner::Limit() -- "
-            "last level of refinement does not include full topology.");
-        return;
-    }
+    Limit(src, dst, SerialDispatcher());
+}
+
+template <typename REAL>
+template <class T, class U, class DISPATCHER>
+inline void
+PrimvarRefinerReal<REAL>::Limit(T const & src, U & dst, DISPATCHER const & dispatcher) const {
+
+    if (!hasLimitTopology("PrimvarRefiner::Limit()")) return;
+
+    int numVertices = _refiner.getLevel(_refiner.GetMaxLevel()).getNumVertices();
 
     switch (_refiner._subdivType) {
     case Sdc::SCHEME_CATMARK:
-        limit<Sdc::SCHEME_CATMARK>(src, dst, (U*)0, (U*)0);
+        dispatcher(numVertices, LimitTask<Sdc::SCHEME_CATMARK,T,U,U,U>(*this, src, dst, (U*)0, (U*)0));
         break;
     case Sdc::SCHEME_LOOP:
-        limit<Sdc::SCHEME_LOOP>(src, dst, (U*)0, (U*)0);
+        dispatcher(numVertices, LimitTask<Sdc::SCHEME_LOOP,T,U,U,U>(*this, src, dst, (U*)0, (U*)0));
         break;
     case Sdc::SCHEME_BILINEAR:
-        limit<Sdc::SCHEME_BILINEAR>(src, dst, (U*)0, (U*)0);
+        dispatcher(numVertices, LimitTask<Sdc::SCHEME_BILINEAR,T,U,U,U>(*this, src, dst, (U*)0, (U*)0));
         break;
     }
 }
@@ -343,22 +463,28 @@ template <class T, class U, class U1, class U2>
 inline void
 PrimvarRefinerReal<REAL>::Limit(T const & src, U & dstPos, U1 & dstTan1, U2 & dstTan2) const {
 
-    if (_refiner.getLevel(_refiner.GetMaxLevel()).getNumVertexEdgesTotal() == 0) {
-        Error(FAR_RUNTIME_ERROR,
-            "Failure in PrimvarRefiner::Limit() -- "
-            "last level of refinement does not include full topology.");
-        return;
-    }
+    Limit(src, dstPos, dstTan1, dstTan2, SerialDispatcher());
+}
+
+template <typename REAL>
+template <class T, class U, class U1, class U2, class DISPATCHER>
+inline void
+PrimvarRefinerReal<REAL>::Limit(T const & src, U & dstPos, U1 & dstTan1, U2 & dstTan2,
+                                DISPATCHER const & dispatcher) const {
+
+    if (!hasLimitTopology("PrimvarRefiner::Limit()")) return;
+
+    int numVertices = _refiner.getLevel(_refiner.GetMaxLevel()).getNumVertices();
 
     switch (_refiner._subdivType) {
     case Sdc::SCHEME_CATMARK:
-        limit<Sdc::SCHEME_CATMARK>(src, dstPos, &dstTan1, &dstTan2);
+        dispatcher(numVertices, LimitTask<Sdc::SCHEME_CATMARK,T,U,U1,U2>(*this, src, dstPos, &dstTan1, &dstTan2));
         break;
     case Sdc::SCHEME_LOOP:
-        limit<Sdc::SCHEME_LOOP>(src, dstPos, &dstTan1, &dstTan2);
+        dispatcher(numVertices, LimitTask<Sdc::SCHEME_LOOP,T,U,U1,U2>(*this, src, dstPos, &dstTan1, &dstTan2));
         break;
     case Sdc::SCHEME_BILINEAR:
-        limit<Sdc::SCHEME_BILINEAR>(src, dstPos, &dstTan1, &dstTan2);
+        dispatcher(numVertices, LimitTask<Sdc::SCHEME_BILINEAR,T,U,U1,U2>(*this, src, dstPos, &dstTan1, &dstTan2));
         break;
     }
 }
@@ -368,22 +494,28 @@ template <class T, class U>
 inline void
 PrimvarRefinerReal<REAL>::LimitFaceVarying(T const & src, U & dst, int channel) const {
 
-    if (_refiner.getLevel(_refiner.GetMaxLevel()).getNumVertexEdgesTotal() == 0) {
-        Error(FAR_RUNTIME_ERROR,
-            "Failure in PrimvarRefiner::LimitFaceVarying() -- "
-            "last level of refinement does not include full topology.");
-        return;
-    }
+    LimitFaceVarying(src, dst, channel, SerialDispatcher());
+}
+
+template <typename REAL>
+template <class T, class U, class DISPATCHER>
+inline void
+PrimvarRefinerReal<REAL>::LimitFaceVarying(T const & src, U & dst, int channel,
+                                           DISPATCHER const & dispatcher) const {
+
+    if (!hasLimitTopology("PrimvarRefiner::LimitFaceVarying()")) return;
+
+    int numVertices = _refiner.getLevel(_refiner.GetMaxLevel()).getNumVertices();
 
     switch (_refiner._subdivType) {
     case Sdc::SCHEME_CATMARK:
-        limitFVar<Sdc::SCHEME_CATMARK>(src, dst, channel);
+        dispatcher(numVertices, LimitFVarTask<Sdc::SCHEME_CATMARK,T,U>(*this, src, dst, channel));
         break;
     case Sdc::SCHEME_LOOP:
-        limitFVar<Sdc::SCHEME_LOOP>(src, dst, channel);
+        dispatcher(numVertices, LimitFVarTask<Sdc::SCHEME_LOOP,T,U>(*this, src, dst, channel));
         break;
     case Sdc::SCHEME_BILINEAR:
-        limitFVar<Sdc::SCHEME_BILINEAR>(src, dst, channel);
+        dispatcher(numVertices, LimitFVarTask<Sdc::SCHEME_BILINEAR,T,U>(*this, src, dst, channel));
         break;
     }
 }
@@ -393,6 +525,8 @@ template <class T, class U>
 inline void
 PrimvarRefinerReal<REAL>::InterpolateFaceUniform(int level, T const & src, U & dst) const {
 
+    if (!hasRefinedTopology("PrimvarRefiner::InterpolateFaceUniform()")) return;
+
     assert(level>0 && level<=(int)_refiner._refinements.size());
 
     Vtr::internal::Refinement const & refinement = _refiner.getRefinement(level-1);
@@ -411,6 +545,8 @@ template <class T, class U>
 inline void
 PrimvarRefinerReal<REAL>::InterpolateVarying(int level, T const & src, U & dst) const {
 
+    if (!hasRefinedTopology("PrimvarRefiner::InterpolateVarying()")) return;
+
     assert(level>0 && level<=(int)_refiner._refinements.size());
 
     Vtr::internal::Refinement const & refinement = _refiner.getRefinement(level-1);
@@ -465,6 +601,177 @@ PrimvarRefinerReal<REAL>::InterpolateVarying(int level, T const & src, U & dst)
 }
 
 
+template <typename REAL>
+inline bool
+PrimvarRefinerReal<REAL>::hasRefinedTopology(char const * methodName) const {
+
+    if (_refiner.IsRefinedTopologyReleased()) {
+        Error(FAR_RUNTIME_ERROR,
+            "Failure in %s -- refined topology was released.", methodName);
+        return false;
+    }
+    return true;
+}
+
+template <typename REAL>
+inline bool
+PrimvarRefinerReal<REAL>::hasLimitTopology(char const * methodName) const {
+
+    if (!hasRefinedTopology(methodName)) return false;
+
+    if (_refiner.getLevel(_refiner.GetMaxLevel()).getNumVertexEdgesTotal() == 0) {
+        Error(FAR_RUNTIME_ERROR,
+            "Failure in %s -- "
+            "last level of refinement does not include full topology.", methodName);
+        return false;
+    }
+    return true;
+}
+
+
+//
+//  Tasks and their dispatch for each group of child vertices -- all child
+//  vertices originating from faces must be computed before those from
+//  edges and vertices, which may depend on them:
+//
+template <typename REAL>
+template <Sdc::SchemeType SCHEME, class T, class U>
+class PrimvarRefinerReal<REAL>::InterpolateTask {
+public:
+    InterpolateTask(PrimvarRefinerReal const & primvarRefiner, int level,
+                    T const & src, U & dst, Component component) :
+        _primvarRefiner(primvarRefiner), _level(level),
+        _src(src), _dst(dst), _component(component) { }
+
+    void operator()(int begin, int end) const {
+        switch (_component) {
+        case COMPONENT_FACES:
+            _primvarRefiner.template interpFromFaces<SCHEME>(_level, _src, _dst, begin, end);
+            break;
+        case COMPONENT_EDGES:
+            _primvarRefiner.template interpFromEdges<SCHEME>(_level, _src, _dst, begin, end);
+            break;
+        case COMPONENT_VERTICES:
+            _primvarRefiner.template interpFromVerts<SCHEME>(_level, _src, _dst, begin, end);
+            break;
+        }
+    }
+
+private:
+    PrimvarRefinerReal const & _primvarRefiner;
+    int                        _level;
+    T const &                  _src;
+    U &                        _dst;
+    Component                  _component;
+};
+
+template <typename REAL>
+template <Sdc::SchemeType SCHEME, class T, class U>
+class PrimvarRefinerReal<REAL>::InterpolateFVarTask {
+public:
+    InterpolateFVarTask(PrimvarRefinerReal const & primvarRefiner, int level,
+                        T const & src, U & dst, int channel, Component component) :
+        _primvarRefiner(primvarRefiner), _level(level),
+        _src(src), _dst(dst), _channel(channel), _component(component) { }
+
+    void operator()(int begin, int end) const {
+        switch (_component) {
+        case COMPONENT_FACES:
+            _primvarRefiner.template interpFVarFromFaces<SCHEME>(_level, _src, _dst, _channel, begin, end);
+            break;
+        case COMPONENT_EDGES:
+            _primvarRefiner.template interpFVarFromEdges<SCHEME>(_level, _src, _dst, _channel, begin, end);
+            break;
+        case COMPONENT_VERTICES:
+            _primvarRefiner.template interpFVarFromVerts<SCHEME>(_level, _src, _dst, _channel, begin, end);
+            break;
+        }
+    }
+
+private:
+    PrimvarRefinerReal const & _primvarRefiner;
+    int                        _level;
+    T const &                  _src;
+    U &                        _dst;
+    int                        _channel;
+    Component                  _component;
+};
+
+template <typename REAL>
+template <Sdc::SchemeType SCHEME, class T, class U, class U1, class U2>
+class PrimvarRefinerReal<REAL>::LimitTask {
+public:
+    LimitTask(PrimvarRefinerReal const & primvarRefiner,
+              T const & src, U & dstPos, U1 * dstTan1Ptr, U2 * dstTan2Ptr) :
+        _primvarRefiner(primvarRefiner), _src(src), _dstPos(dstPos),
+        _dstTan1Ptr(dstTan1Ptr), _dstTan2Ptr(dstTan2Ptr) { }
+
+    void operator()(int begin, int end) const {
+        _primvarRefiner.template limit<SCHEME>(_src, _dstPos, _dstTan1Ptr, _dstTan2Ptr, begin, end);
+    }
+
+private:
+    PrimvarRefinerReal const & _primvarRefiner;
+    T const &                  _src;
+    U &                        _dstPos;
+    U1 *                       _dstTan1Ptr;
+    U2 *                       _dstTan2Ptr;
+};
+
+template <typename REAL>
+template <Sdc::SchemeType SCHEME, class T, class U>
+class PrimvarRefinerReal<REAL>::LimitFVarTask {
+public:
+    LimitFVarTask(PrimvarRefinerReal const & primvarRefiner,
+                  T const & src, U & dst, int channel) :
+        _primvarRefiner(primvarRefiner), _src(src), _dst(dst), _channel(channel) { }
+
+    void operator()(int begin, int end) const {
+        _primvarRefiner.template limitFVar<SCHEME>(_src, _dst, _channel, begin, end);
+    }
+
+private:
+    PrimvarRefinerReal const & _primvarRefiner;
+    T const &                  _src;
+    U &                        _dst;
+    int                        _channel;
+};
+
+template <typename REAL>
+template <Sdc::SchemeType SCHEME, class T, class U, class DISPATCHER>
+inline void
+PrimvarRefinerReal<REAL>::interpolate(int level, T const & src, U & dst, DISPATCHER const & dispatcher) const {
+
+    Vtr::internal::Refinement const & refinement = _refiner.getRefinement(level-1);
+    Vtr::internal::Level const &      parent     = refinement.parent();
+
+    typedef InterpolateTask<SCHEME, T, U> Task;
+
+    if (refinement.getNumChildVerticesFromFaces() > 0) {
+        dispatcher(parent.getNumFaces(), Task(*this, level, src, dst, COMPONENT_FACES));
+    }
+    dispatcher(parent.getNumEdges(),    Task(*this, level, src, dst, COMPONENT_EDGES));
+    dispatcher(parent.getNumVertices(), Task(*this, level, src, dst, COMPONENT_VERTICES));
+}
+
+template <typename REAL>
+template <Sdc::SchemeType SCHEME, class T, class U, class DISPATCHER>
+inline void
+PrimvarRefinerReal<REAL>::interpolateFVar(int level, T const & src, U & dst, int channel, DISPATCHER const & dispatcher) const {
+
+    Vtr::internal::Refinement const & refinement = _refiner.getRefinement(level-1);
+    Vtr::internal::Level const &      parent     = refinement.parent();
+
+    typedef InterpolateFVarTask<SCHEME, T, U> Task;
+
+    if (refinement.getNumChildVerticesFromFaces() > 0) {
+        dispatcher(parent.getNumFaces(), Task(*this, level, src, dst, channel, COMPONENT_FACES));
+    }
+    dispatcher(parent.getNumEdges(),    Task(*this, level, src, dst, channel, COMPONENT_EDGES));
+    dispatcher(parent.getNumVertices(), Task(*this, level, src, dst, channel, COMPONENT_VERTICES));
+}
+
+
 //
 //  Internal implementation methods -- grouping vertices to be interpolated
 //  based on the type of parent component from which they originated:
@@ -472,7 +779,7 @@ PrimvarRefinerReal<REAL>::InterpolateVarying(int level, T const & src, U & dst)
 template <typename REAL>
 template <Sdc::SchemeType SCHEME, class T, class U>
 inline void
-PrimvarRefinerReal<REAL>::interpFromFaces(int level, T const & src, U & dst) const {
+PrimvarRefinerReal<REAL>::interpFromFaces(int level, T const & src, U & dst, int begin, int end) const {
 
     Vtr::internal::Refinement const & refinement = _refiner.getRefinement(level-1);
     Vtr::internal::Level const &      parent     = refinement.parent();
@@ -483,7 +790,7 @@ PrimvarRefinerReal<REAL>::interpFromFaces(int level, T const & src, U & dst) con
 
     Vtr::internal::StackBuffer<Weight,16> fVertWeights(parent.getMaxValence());
 
-    for (int face = 0; face < parent.getNumFaces(); ++face) {
+    for (int face = begin; face < end; ++face) {
 
         Vtr::Index cVert = refinement.getFaceChildVertex(face);
         if (!Vtr::IndexIsValid(cVert))
@@ -510,7 +817,7 @@ PrimvarRefinerReal<REAL>::interpFromFaces(int level, T const & src, U & dst) con
 template <typename REAL>
 template <Sdc::SchemeType SCHEME, class T, class U>
 inline void
-PrimvarRefinerReal<REAL>::interpFromEdges(int level, T const & src, U & dst) const {
+PrimvarRefinerReal<REAL>::interpFromEdges(int level, T const & src, U & dst, int begin, int end) const {
 
     Vtr::internal::Refinement const & refinement = _refiner.getRefinement(level-1);
     Vtr::internal::Level const &      parent     = refinement.parent();
@@ -523,7 +830,7 @@ PrimvarRefinerReal<REAL>::interpFromEdges(int level, T const & src, U & dst) con
     Weight                               eVertWeights[2];
     Vtr::internal::StackBuffer<Weight,8> eFaceWeights(parent.getMaxEdgeFaces());
 
-    for (int edge = 0; edge < parent.getNumEdges(); ++edge) {
+    for (int edge = begin; edge < end; ++edge) {
 
         Vtr::Index cVert = refinement.getEdgeChildVertex(edge);
         if (!Vtr::IndexIsValid(cVert))
@@ -580,7 +887,7 @@ PrimvarRefinerReal<REAL>::interpFromEdges(int level, T const & src, U & dst) con
 template <typename REAL>
 template <Sdc::SchemeType SCHEME, class T, class U>
 inline void
-PrimvarRefinerReal<REAL>::interpFromVerts(int level, T const & src, U & dst) const {
+PrimvarRefinerReal<REAL>::interpFromVerts(int level, T const & src, U & dst, int begin, int end) const {
 
     Vtr::internal::Refinement const & refinement = _refiner.getRefinement(level-1);
     Vtr::internal::Level const &      parent     = refinement.parent();
@@ -592,7 +899,7 @@ PrimvarRefinerReal<REAL>::interpFromVerts(int level, T const & src, U & dst) con
 
     Vtr::internal::StackBuffer<Weight,32> weightBuffer(2*parent.getMaxValence());
 
-    for (int vert = 0; vert < parent.getNumVertices(); ++vert) {
+    for (int vert = begin; vert < end; ++vert) {
 
         Vtr::Index cVert = refinement.getVertexChildVertex(vert);
         if (!Vtr::IndexIsValid(cVert))
@@ -654,7 +961,7 @@ PrimvarRefinerReal<REAL>::interpFromVerts(int level, T const & src, U & dst) con
 template <typename REAL>
 template <Sdc::SchemeType SCHEME, class T, class U>
 inline void
-PrimvarRefinerReal<REAL>::interpFVarFromFaces(int level, T const & src, U & dst, int channel) const {
+PrimvarRefinerReal<REAL>::interpFVarFromFaces(int level, T const & src, U & dst, int channel, int begin, int end) const {
 
     Vtr::internal::Refinement const & refinement = _refiner.getRefinement(level-1);
 
@@ -670,7 +977,7 @@ PrimvarRefinerReal<REAL>::interpFVarFromFaces(int level, T const & src, U & dst,
 
     Vtr::internal::StackBuffer<Weight,16> fValueWeights(parentLevel.getMaxValence());
 
-    for (int face = 0; face < parentLevel.getNumFaces(); ++face) {
+    for (int face = begin; face < end; ++face) {
 
         Vtr::Index cVert = refinement.getFaceChildVertex(face);
         if (!Vtr::IndexIsValid(cVert))
@@ -703,7 +1010,7 @@ PrimvarRefinerReal<REAL>::interpFVarFromFaces(int level, T const & src, U & dst,
 template <typename REAL>
 template <Sdc::SchemeType SCHEME, class T, class U>
 inline void
-PrimvarRefinerReal<REAL>::interpFVarFromEdges(int level, T const & src, U & dst, int channel) const {
+PrimvarRefinerReal<REAL>::interpFVarFromEdges(int level, T const & src, U & dst, int channel, int begin, int end) const {
 
     Vtr::internal::Refinement const & refinement = _refiner.getRefinement(level-1);
 
@@ -737,7 +1044,7 @@ PrimvarRefinerReal<REAL>::interpFVarFromEdges(int level, T const & src, U & dst,
 
     Vtr::internal::EdgeInterface eHood(parentLevel);
 
-    for (int edge = 0; edge < parentLevel.getNumEdges(); ++edge) {
+    for (int edge = begin; edge < end; ++edge) {
 
         Vtr::Index cVert = refinement.getEdgeChildVertex(edge);
         if (!Vtr::IndexIsValid(cVert))
@@ -848,7 +1155,7 @@ PrimvarRefinerReal<REAL>::interpFVarFromEdges(int level, T const & src, U & dst,
 template <typename REAL>
 template <Sdc::SchemeType SCHEME, class T, class U>
 inline void
-PrimvarRefinerReal<REAL>::interpFVarFromVerts(int level, T const & src, U & dst, int channel) const {
+PrimvarRefinerReal<REAL>::interpFVarFromVerts(int level, T const & src, U & dst, int channel, int begin, int end) const {
 
     Vtr::internal::Refinement const & refinement = _refiner.getRefinement(level-1);
 
@@ -869,7 +1176,7 @@ PrimvarRefinerReal<REAL>::interpFVarFromVerts(int level, T const & src, U & dst,
 
     Vtr::internal::VertexInterface vHood(parentLevel, childLevel);
 
-    for (int vert = 0; vert < parentLevel.getNumVertices(); ++vert) {
+    for (int vert = begin; vert < end; ++vert) {
 
         Vtr::Index cVert = refinement.getVertexChildVertex(vert);
         if (!Vtr::IndexIsValid(cVert))
@@ -1021,7 +1328,7 @@ PrimvarRefinerReal<REAL>::interpFVarFromVerts(int level, T const & src, U & dst,
 template <typename REAL>
 template <Sdc::SchemeType SCHEME, class T, class U, class U1, class U2>
 inline void
-PrimvarRefinerReal<REAL>::limit(T const & src, U & dstPos, U1 * dstTan1Ptr, U2 * dstTan2Ptr) const {
+PrimvarRefinerReal<REAL>::limit(T const & src, U & dstPos, U1 * dstTan1Ptr, U2 * dstTan2Ptr, int begin, int end) const {
 
     Sdc::Scheme<SCHEME> scheme(_refiner._subdivOptions);
 
@@ -1052,7 +1359,7 @@ PrimvarRefinerReal<REAL>::limit(T const & src, U & dstPos, U1 * dstTan1Ptr, U2 *
     //  this mask type was intended for another purpose.  Consider one for the limit:
     Vtr::internal::VertexInterface vHood(level, level);
 
-    for (int vert = 0; vert < level.getNumVertices(); ++vert) {
+    for (int vert = begin; vert < end; ++vert) {
         ConstIndexArray vEdges = level.getVertexEdges(vert);
 
         //  Incomplete vertices (present in sparse refinement) do not have their full
@@ -1156,7 +1463,7 @@ PrimvarRefinerReal<REAL>::limit(T const & src, U & dstPos, U1 * dstTan1Ptr, U2 *
 template <typename REAL>
 template <Sdc::SchemeType SCHEME, class T, class U>
 inline void
-PrimvarRefinerReal<REAL>::limitFVar(T const & src, U & dst, int channel) const {
+PrimvarRefinerReal<REAL>::limitFVar(T const & src, U & dst, int channel, int begin, int end) const {
 
     Sdc::Scheme<SCHEME> scheme(_refiner._subdivOptions);
 
@@ -1171,7 +1478,7 @@ PrimvarRefinerReal<REAL>::limitFVar(T const & src, U & dst, int channel) const {
     //  This is a bit obscure -- assign both parent and child as last level
     Vtr::internal::VertexInterface vHood(level, level);
 
-    for (int vert = 0; vert < level.getNumVertices(); ++vert) {
+    for (int vert = begin; vert < end; ++vert) {
 
         ConstIndexArray vEdges  = level.getVertexEdges(vert);
         ConstIndexArray vValues = fvarChannel.getVertexValues(vert);
@@ -0,0 +1,172 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#include "../far/stencilDependencyMap.h"
+
+#include <algorithm>
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Far {
+
+StencilDependencyMap::StencilDependencyMap(
+        StencilTableReal<float> const & stencilTable) {
+    initialize(stencilTable);
+}
+
+StencilDependencyMap::StencilDependencyMap(
+        StencilTableReal<double> const & stencilTable) {
+    initialize(stencilTable);
+}
+
+//
+//  The inverse index is built with a counting sort of the control indices:
+//  a first pass counts the stencils of each source, and a second pass
+//  distributes the stencils in increasing order. A source appearing more
+//  than once in a stencil is only recorded once, which requires the last
+//  stencil recorded for each source to be tracked in both passes.
+//
+template <typename REAL>
+void
+StencilDependencyMap::initialize(StencilTableReal<REAL> const & stencilTable) {
+
+    _numStencils = stencilTable.GetNumStencils();
+    _numControlVertices = stencilTable.GetNumControlVertices();
+
+    std::vector<int> const & sizes   = stencilTable.GetSizes();
+    std::vector<Index> const & indices = stencilTable.GetControlIndices();
+
+    int numSources = stencilTable.GetNumControlVertices();
+    for (int i = 0; i < (int)indices.size(); ++i) {
+        numSources = std::max(numSources, indices[i] + 1);
+    }
+
+    std::vector<Index> lastStencil(numSources, INDEX_INVALID);
+
+    _sourceOffsets.assign(numSources + 1, 0);
+
+    Index const * stencilIndices = indices.data();
+    for (int s = 0; s < _numStencils; ++s) {
+        for (int j = 0; j < sizes[s]; ++j, ++stencilIndices) {
+            Index source = *stencilIndices;
+            if (lastStencil[source] != s) {
+                lastStencil[source] = s;
+                ++_sourceOffsets[source + 1];
+            }
+        }
+    }
+    for (int i = 0; i < numSources; ++i) {
+        _sourceOffsets[i + 1] += _sourceOffsets[i];
+    }
+
+    _stencilIndices.resize(_sourceOffsets[numSources]);
+
+    std::vector<Index> fillOffsets(_sourceOffsets.begin(),
+                                   _sourceOffsets.end() - 1);
+    std::fill(lastStencil.begin(), lastStencil.end(), INDEX_INVALID);
+
+    stencilIndices = indices.data();
+    for (int s = 0; s < _numStencils; ++s) {
+        for (int j = 0; j < sizes[s]; ++j, ++stencilIndices) {
+            Index source = *stencilIndices;
+            if (lastStencil[source] != s) {
+                lastStencil[source] = s;
+                _stencilIndices[fillOffsets[source]++] = s;
+            }
+        }
+    }
+}
+
+//
+//  The stencils of the sources are merged by marking them in a bit mask of
+//  all stencils, which is then scanned to list them in increasing order.
+//  The mask is small relative to the table (one bit per stencil), so its
+//  cost remains small relative to that of gathering and sorting all of the
+//  (typically highly redundant) stencils of the sources.
+//
+//  Stencil s is itself the source following the control vertices at
+//  _numControlVertices + s. When referred to by other stencils (i.e. the
+//  table is not factorized), each newly marked stencil is added to the
+//  sources pending, so that the closure of the dependencies is gathered.
+//
+void
+StencilDependencyMap::GetDependentStencils(ConstIndexArray sources,
+                                           std::vector<Index> & stencils) const {
+
+    stencils.clear();
+
+    int numSources = GetNumSources();
+
+    //  The stencils of a single source are already sorted and unique, and
+    //  complete if no stencil refers to another:
+    bool factorized = (numSources <= _numControlVertices);
+    if ((sources.size() == 1) && factorized) {
+        if ((sources[0] >= 0) && (sources[0] < numSources)) {
+            ConstIndexArray sourceStencils = GetDependentStencils(sources[0]);
+            stencils.assign(sourceStencils.begin(), sourceStencils.end());
+        }
+        return;
+    }
+
+    std::vector<unsigned int> mask((_numStencils + 31) >> 5, 0);
+
+    std::vector<Index> pending(sources.begin(), sources.end());
+
+    int numStencils = 0;
+    while (!pending.empty()) {
+        Index source = pending.back();
+        pending.pop_back();
+        if ((source < 0) || (source >= numSources)) continue;
+
+        Index const * s    = _stencilIndices.data() + _sourceOffsets[source];
+        Index const * sEnd = _stencilIndices.data() + _sourceOffsets[source + 1];
+        for ( ; s < sEnd; ++s) {
+            unsigned int & word = mask[*s >> 5];
+            unsigned int   bit  = 1u << (*s & 31);
+
+            if (word & bit) continue;
+            word |= bit;
+            ++numStencils;
+
+            if (!factorized && (_numControlVertices + *s < numSources)) {
+                pending.push_back(_numControlVertices + *s);
+            }
+        }
+    }
+
+    stencils.reserve(numStencils);
+    for (int w = 0; w < (int)mask.size(); ++w) {
+        for (unsigned int word = mask[w]; word; word &= word - 1) {
+            int bit = 0;
+            while (((word >> bit) & 1u) == 0) ++bit;
+            stencils.push_back((w << 5) + bit);
+        }
+    }
+}
+
+} // end namespace Far
+
+} // end namespace OPENSUBDIV_VERSION
+} // end namespace OpenSubdiv
@@ -0,0 +1,132 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#ifndef OPENSUBDIV3_FAR_STENCIL_DEPENDENCY_MAP_H
+#define OPENSUBDIV3_FAR_STENCIL_DEPENDENCY_MAP_H
+
+#include "../version.h"
+
+#include "../far/stencilTable.h"
+
+#include <vector>
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Far {
+
+/// \brief An inverse index connecting the sources of a StencilTable to the
+///        stencils that depend on them
+///
+/// A StencilTable lists the control vertices contributing to each stencil.
+/// The StencilDependencyMap inverts this relation so that, when only a few
+/// control vertices change (e.g. under a sculpting brush), the stencils
+/// affected can be identified and re-evaluated without evaluating the whole
+/// table (see the EvalStencilsSubset() methods of the Osd CPU evaluators).
+///
+/// The map applies to the table from which it was constructed and must be
+/// rebuilt if the table changes. Local point stencils of end-cap patches
+/// are included when appended to the table (see StencilTableFactory::
+/// AppendLocalPointStencilTable()). For a local point stencil table kept
+/// separately, whose control indices refer to the refined vertices that
+/// follow the control vertices, build a second map and query it with the
+/// changed control vertices and the affected refined vertices, i.e. the
+/// number of control vertices plus the index of each affected stencil.
+///
+/// Tables whose stencils are not factorized to the control vertices (e.g.
+/// with StencilTableFactory::Options::factorizeIntermediateLevels unset)
+/// refer to the results of earlier stencils, i.e. to the sources following
+/// the control vertices. The dependencies gathered for a set of sources
+/// include those propagated through such stencils.
+///
+class StencilDependencyMap {
+public:
+
+    /// \brief Constructor
+    ///
+    /// @param stencilTable  A valid StencilTable
+    ///
+    StencilDependencyMap(StencilTableReal<float> const & stencilTable);
+
+    /// \brief Constructor
+    ///
+    /// @param stencilTable  A valid StencilTable
+    ///
+    StencilDependencyMap(StencilTableReal<double> const & stencilTable);
+
+    /// \brief Returns the number of sources, i.e. one more than the largest
+    /// control index in the table (and at least its number of control
+    /// vertices)
+    int GetNumSources() const { return (int)_sourceOffsets.size() - 1; }
+
+    /// \brief Returns the number of stencils in the table
+    int GetNumStencils() const { return _numStencils; }
+
+    /// \brief Returns the stencils referring directly to the given source,
+    /// in increasing order
+    ///
+    /// The stencils depending on those through the results of stencils
+    /// that are not factorized are not included (see the method below).
+    ///
+    ConstIndexArray GetDependentStencils(Index source) const;
+
+    /// \brief Gathers the stencils depending on any of the given sources,
+    /// directly or through the results of other stencils
+    ///
+    /// @param sources   The indices of the sources that changed. Indices out
+    ///                  of range of the map are ignored.
+    ///
+    /// @param stencils  Returns the indices of the dependent stencils, in
+    ///                  increasing order and without duplicates
+    ///
+    void GetDependentStencils(ConstIndexArray sources,
+                              std::vector<Index> & stencils) const;
+
+private:
+    template <typename REAL>
+    void initialize(StencilTableReal<REAL> const & stencilTable);
+
+private:
+    int _numStencils;
+    int _numControlVertices;
+
+    std::vector<Index> _sourceOffsets;   // offsets of each source's stencils
+    std::vector<Index> _stencilIndices;  // dependent stencils of all sources
+};
+
+inline ConstIndexArray
+StencilDependencyMap::GetDependentStencils(Index source) const {
+    int offset = _sourceOffsets[source];
+    int count = _sourceOffsets[source + 1] - offset;
+    return ConstIndexArray(count ? &_stencilIndices[offset] : 0, count);
+}
+
+} // end namespace Far
+
+} // end namespace OPENSUBDIV_VERSION
+using namespace OPENSUBDIV_VERSION;
+
+} // end namespace OpenSubdiv
+
+#endif /* OPENSUBDIV3_FAR_STENCIL_DEPENDENCY_MAP_H */
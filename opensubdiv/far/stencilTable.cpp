@@ -170,6 +170,26 @@ StencilTableReal<REAL>::Clear() {
     _weights.clear();
 }
 
+template <typename REAL>
+MemoryUsage
+StencilTableReal<REAL>::GetMemoryUsage() const {
+
+    MemoryUsage usage("StencilTable");
+    usage.Add(sizeof(*this), sizeof(*this));
+    usage.Add(_sizes);
+    usage.Add(_offsets);
+    usage.Add(_indices);
+    usage.Add(_weights);
+    return usage;
+}
+
+template <typename REAL>
+void
+StencilTableReal<REAL>::ShrinkToFit() {
+    shrinkToFit();
+    std::vector<Index>(_offsets).swap(_offsets);
+}
+
 template <typename REAL>
 LimitStencilTableReal<REAL>::LimitStencilTableReal(
                                      int numControlVerts,
@@ -210,6 +230,33 @@ LimitStencilTableReal<REAL>::Clear() {
     _dvvWeights.clear();
 }
 
+template <typename REAL>
+MemoryUsage
+LimitStencilTableReal<REAL>::GetMemoryUsage() const {
+
+    MemoryUsage usage = StencilTableReal<REAL>::GetMemoryUsage();
+    usage.name = "LimitStencilTable";
+    usage.Add(sizeof(*this) - sizeof(StencilTableReal<REAL>),
+              sizeof(*this) - sizeof(StencilTableReal<REAL>));
+    usage.Add(_duWeights);
+    usage.Add(_dvWeights);
+    usage.Add(_duuWeights);
+    usage.Add(_duvWeights);
+    usage.Add(_dvvWeights);
+    return usage;
+}
+
+template <typename REAL>
+void
+LimitStencilTableReal<REAL>::ShrinkToFit() {
+    StencilTableReal<REAL>::ShrinkToFit();
+    std::vector<REAL>(_duWeights).swap(_duWeights);
+    std::vector<REAL>(_dvWeights).swap(_dvWeights);
+    std::vector<REAL>(_duuWeights).swap(_duuWeights);
+    std::vector<REAL>(_duvWeights).swap(_duvWeights);
+    std::vector<REAL>(_dvvWeights).swap(_dvvWeights);
+}
+
 
 //
 //  Explicit instantiation for float and double:
@@ -28,6 +28,7 @@
 #include "../version.h"
 
 #include "../far/types.h"
+#include "../far/memoryUsage.h"
 
 #include <cassert>
 #include <cstring>
@@ -226,6 +227,12 @@ public:
     /// \brief Clears the stencils from the table
     void Clear();
 
+    /// \brief Returns the memory used and allocated by the table
+    virtual MemoryUsage GetMemoryUsage() const;
+
+    /// \brief Releases the excess capacity of the table
+    virtual void ShrinkToFit();
+
 protected:
 
     // Update values by applying cached stencil weights to new control values
@@ -564,6 +571,12 @@ public:
     /// \brief Clears the stencils from the table
     void Clear();
 
+    /// \brief Returns the memory used and allocated by the table
+    MemoryUsage GetMemoryUsage() const;
+
+    /// \brief Releases the excess capacity of the table
+    void ShrinkToFit();
+
 private:
     friend class LimitStencilTableFactoryReal<REAL>;
 
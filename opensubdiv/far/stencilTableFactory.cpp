@@ -24,6 +24,8 @@
 
 #include "../far/stencilTableFactory.h"
 #include "../far/stencilBuilder.h"
+#include "../far/error.h"
+#include "../far/instrumentation.h"
 #include "../far/patchTable.h"
 #include "../far/patchTableFactory.h"
 #include "../far/patchMap.h"
@@ -80,6 +82,14 @@ StencilTableReal<REAL> const *
 StencilTableFactoryReal<REAL>::Create(TopologyRefiner const & refiner,
     Options options) {
 
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_CREATE_STENCIL_TABLE, -1);
+
+    if (refiner.IsRefinedTopologyReleased()) {
+        Error(FAR_RUNTIME_ERROR,
+            "Failure in StencilTableFactory::Create() -- refined topology was released.");
+        return NULL;
+    }
+
     bool interpolateVertex = options.interpolationMode==INTERPOLATE_VERTEX;
     bool interpolateVarying = options.interpolationMode==INTERPOLATE_VARYING;
     bool interpolateFaceVarying = options.interpolationMode==INTERPOLATE_FACE_VARYING;
@@ -268,6 +278,8 @@ StencilTableFactoryReal<REAL>::appendLocalPointStencilTable(
         return NULL;
     }
 
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_LOCAL_POINT_STENCILS, -1);
+
     int nControlVerts = channel < 0
         ? refiner.GetLevel(0).GetNumVertices()
         : refiner.GetLevel(0).GetNumFVarValues(channel);
@@ -426,6 +438,12 @@ LimitStencilTableFactoryReal<REAL>::Create(TopologyRefiner const & refiner,
         return 0;
     }
 
+    if (refiner.IsRefinedTopologyReleased()) {
+        Error(FAR_RUNTIME_ERROR,
+            "Failure in LimitStencilTableFactory::Create() -- refined topology was released.");
+        return 0;
+    }
+
     bool uniform  = refiner.IsUniform();
     int  maxlevel = refiner.GetMaxLevel();
 
@@ -58,6 +58,10 @@ TopologyRefinerFactory<TopologyDescriptor>::resizeComponentTopology(
     setNumBaseVertices(refiner, desc.numVertices);
     setNumBaseFaces(refiner, desc.numFaces);
 
+    if ((desc.numEdges>0) && desc.edgeVertIndices && desc.edgeIndicesPerFace) {
+        setNumBaseEdges(refiner, desc.numEdges);
+    }
+
     for (int face=0; face<desc.numFaces; ++face) {
 
         setNumBaseFaceVertices(refiner, face, desc.numVertsPerFace[face]);
@@ -87,6 +91,36 @@ TopologyRefinerFactory<TopologyDescriptor>::assignComponentTopology(
             }
         }
     }
+
+    if (getNumBaseEdges(refiner) > 0) {
+
+        //  Reversing the order of the face-vertices for left-handed faces (all
+        //  but the first) reverses the order of all of the face-edges:
+        for (int face=0, idx=0; face<desc.numFaces; ++face) {
+
+            IndexArray dstFaceEdges = getBaseFaceEdges(refiner, face);
+
+            if (desc.isLeftHanded) {
+                for (int edge=dstFaceEdges.size()-1; edge >= 0; --edge) {
+
+                    dstFaceEdges[edge] = desc.edgeIndicesPerFace[idx++];
+                }
+            } else {
+                for (int edge=0; edge<dstFaceEdges.size(); ++edge) {
+
+                    dstFaceEdges[edge] = desc.edgeIndicesPerFace[idx++];
+                }
+            }
+        }
+
+        for (int edge=0; edge<desc.numEdges; ++edge) {
+
+            IndexArray dstEdgeVerts = getBaseEdgeVertices(refiner, edge);
+
+            dstEdgeVerts[0] = desc.edgeVertIndices[2*edge];
+            dstEdgeVerts[1] = desc.edgeVertIndices[2*edge+1];
+        }
+    }
     return true;
 }
 
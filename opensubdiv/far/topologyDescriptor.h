@@ -81,6 +81,17 @@ struct TopologyDescriptor {
     int                 numFVarChannels;
     FVarChannel const * fvarChannels;
 
+    //  Optional edges -- when known to the client, they can be specified to
+    //  avoid the search for the edges of each face.  Each edge is a pair of
+    //  vertices and each face has one edge for each of its vertices, i.e.
+    //  the edge following each vertex in the face (in the same winding order
+    //  as the vertices).  Declared last to preserve the layout of the
+    //  members preceding them:
+    //
+    int           numEdges;
+    Index const * edgeVertIndices;
+    Index const * edgeIndicesPerFace;
+
     TopologyDescriptor();
 };
 
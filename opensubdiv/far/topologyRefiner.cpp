@@ -23,7 +23,9 @@
 //
 #include "../far/topologyRefiner.h"
 #include "../far/error.h"
+#include "../far/instrumentation.h"
 #include "../vtr/fvarLevel.h"
+#include "../vtr/fvarRefinement.h"
 #include "../vtr/sparseSelector.h"
 #include "../vtr/quadRefinement.h"
 #include "../vtr/triRefinement.h"
@@ -49,6 +51,7 @@ TopologyRefiner::TopologyRefiner(Sdc::SchemeType schemeType, Sdc::Options scheme
     _hasIrregFaces(false),
     _regFaceSize(Sdc::SchemeTypeTraits::GetRegularFaceSize(schemeType)),
     _maxLevel(0),
+    _refinedTopologyReleased(false),
     _uniformOptions(0),
     _adaptiveOptions(0),
     _totalVertices(0),
@@ -80,6 +83,7 @@ TopologyRefiner::TopologyRefiner(TopologyRefiner const & source) :
     _hasIrregFaces(source._hasIrregFaces),
     _regFaceSize(source._regFaceSize),
     _maxLevel(0),
+    _refinedTopologyReleased(false),
     _uniformOptions(0),
     _adaptiveOptions(0),
     _baseLevelOwned(false) {
@@ -119,10 +123,90 @@ TopologyRefiner::Unrefine() {
     }
     _refinements.clear();
     _maxLevel = 0;
+    _refinedTopologyReleased = false;
 
     assembleFarLevels();
 }
 
+void
+TopologyRefiner::ReleaseRefinedTopology(ReleaseOptions options) {
+
+    if (_levels.size() <= 1) return;
+
+    for (int i=0; i<(int)_refinements.size(); ++i) {
+        delete _refinements[i];
+    }
+    _refinements.clear();
+
+    int lastLevel = (int)_levels.size() - 1;
+    for (int i=1; i<=lastLevel; ++i) {
+        bool isLast = (i == lastLevel);
+
+        _levels[i]->releaseTopology(isLast && options.retainLastLevelFaceVertices,
+                                    isLast && options.retainLastLevelFVarValues);
+    }
+    _refinedTopologyReleased = true;
+
+    assembleFarLevels();
+}
+
+//
+//  Memory usage and release of excess capacity:
+//
+MemoryUsage
+TopologyRefiner::GetMemoryUsage() const {
+
+    MemoryUsage usage("TopologyRefiner");
+
+    usage.Add(sizeof(TopologyRefiner), sizeof(TopologyRefiner));
+    usage.Add(_levels);
+    usage.Add(_refinements);
+    usage.Add(_farLevels);
+
+    for (int i = 0; i < (int)_levels.size(); ++i) {
+        Vtr::internal::Level const & level = *_levels[i];
+
+        MemoryUsage levelUsage("Level", i);
+        level.getMemoryUsage(levelUsage.used, levelUsage.allocated);
+
+        for (int c = 0; c < level.getNumFVarChannels(); ++c) {
+            MemoryUsage fvarUsage("FVarLevel", c);
+            level.getFVarLevel(c).getMemoryUsage(fvarUsage.used,
+                                                 fvarUsage.allocated);
+            levelUsage.AddComponent(fvarUsage);
+        }
+        usage.AddComponent(levelUsage);
+    }
+
+    for (int i = 0; i < (int)_refinements.size(); ++i) {
+        Vtr::internal::Refinement const & refinement = *_refinements[i];
+
+        MemoryUsage refinementUsage("Refinement", i);
+        refinement.getMemoryUsage(refinementUsage.used,
+                                  refinementUsage.allocated);
+
+        for (int c = 0; c < refinement.getNumFVarChannels(); ++c) {
+            MemoryUsage fvarUsage("FVarRefinement", c);
+            refinement.getFVarRefinement(c).getMemoryUsage(fvarUsage.used,
+                                                           fvarUsage.allocated);
+            refinementUsage.AddComponent(fvarUsage);
+        }
+        usage.AddComponent(refinementUsage);
+    }
+    return usage;
+}
+
+void
+TopologyRefiner::ShrinkToFit() {
+
+    for (int i = 0; i < (int)_levels.size(); ++i) {
+        if ((i > 0) || _baseLevelOwned) _levels[i]->shrinkToFit();
+    }
+    for (int i = 0; i < (int)_refinements.size(); ++i) {
+        _refinements[i]->shrinkToFit();
+    }
+}
+
 
 //
 //  Initializing and updating the component inventory:
@@ -185,6 +269,16 @@ TopologyRefiner::assembleFarLevels() {
     _farLevels[0]._level       = _levels[0];
     _farLevels[0]._refToChild  = 0;
 
+    //  Refinements are no longer available once refined topology is released:
+    if (_refinedTopologyReleased) {
+        for (int i = 1; i < (int)_levels.size(); ++i) {
+            _farLevels[i]._refToParent = 0;
+            _farLevels[i]._level       = _levels[i];
+            _farLevels[i]._refToChild  = 0;
+        }
+        return;
+    }
+
     int nRefinements = (int)_refinements.size();
     if (nRefinements) {
         _farLevels[0]._refToChild = _refinements[0];
@@ -226,7 +320,7 @@ TopologyRefiner::RefineUniform(UniformOptions options) {
             "Failure in TopologyRefiner::RefineUniform() -- base level is uninitialized.");
         return;
     }
-    if (_refinements.size()) {
+    if (_levels.size() > 1) {
         Error(FAR_RUNTIME_ERROR,
             "Failure in TopologyRefiner::RefineUniform() -- previous refinements already applied.");
         return;
@@ -262,7 +356,10 @@ TopologyRefiner::RefineUniform(UniformOptions options) {
         } else {
             refinement = new Vtr::internal::TriRefinement(parentLevel, childLevel, _subdivOptions);
         }
-        refinement->refine(refineOptions);
+        {
+            OPENSUBDIV_INSTRUMENT_TIMER(TIMER_REFINE_LEVEL, i);
+            refinement->refine(refineOptions);
+        }
 
         appendLevel(childLevel);
         appendRefinement(*refinement);
@@ -390,7 +487,7 @@ TopologyRefiner::RefineAdaptive(AdaptiveOptions options,
             "Failure in TopologyRefiner::RefineAdaptive() -- base level is uninitialized.");
         return;
     }
-    if (_refinements.size()) {
+    if (_levels.size() > 1) {
         Error(FAR_RUNTIME_ERROR,
             "Failure in TopologyRefiner::RefineAdaptive() -- previous refinements already applied.");
         return;
@@ -469,12 +566,15 @@ TopologyRefiner::RefineAdaptive(AdaptiveOptions options,
         internal::FeatureMask const & levelFeatures = (i <= shallowLevel) ? moreFeaturesMask
                                                                           : lessFeaturesMask;
 
-        if (i > 1) {
-            selectFeatureAdaptiveComponents(selector, levelFeatures, ConstIndexArray());
-        } else if (nonLinearScheme) {
-            selectFeatureAdaptiveComponents(selector, levelFeatures, baseFacesToRefine);
-        } else {
-            selectLinearIrregularFaces(selector, baseFacesToRefine);
+        {
+            OPENSUBDIV_INSTRUMENT_TIMER(TIMER_SELECT_FEATURES, i);
+            if (i > 1) {
+                selectFeatureAdaptiveComponents(selector, levelFeatures, ConstIndexArray());
+            } else if (nonLinearScheme) {
+                selectFeatureAdaptiveComponents(selector, levelFeatures, baseFacesToRefine);
+            } else {
+                selectLinearIrregularFaces(selector, baseFacesToRefine);
+            }
         }
 
         if (selector.isSelectionEmpty()) {
@@ -482,7 +582,10 @@ TopologyRefiner::RefineAdaptive(AdaptiveOptions options,
             delete &childLevel;
             break;
         } else {
-            refinement->refine(refineOptions);
+            {
+                OPENSUBDIV_INSTRUMENT_TIMER(TIMER_REFINE_LEVEL, i);
+                refinement->refine(refineOptions);
+            }
 
             appendLevel(childLevel);
             appendRefinement(*refinement);
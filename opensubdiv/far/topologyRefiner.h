@@ -29,6 +29,7 @@
 #include "../sdc/types.h"
 #include "../sdc/options.h"
 #include "../far/types.h"
+#include "../far/memoryUsage.h"
 #include "../far/topologyLevel.h"
 
 #include <vector>
@@ -198,6 +199,60 @@ public:
     /// \brief Unrefine the topology, keeping only the base level.
     void Unrefine();
 
+    /// \brief Returns the memory used and allocated by the refiner
+    ///
+    /// A component is reported for each level and for each refinement
+    /// between successive levels, each with a nested component for each of
+    /// its face-varying channels. The base level is included even when it
+    /// is shared with other refiners (i.e. copies).
+    ///
+    MemoryUsage GetMemoryUsage() const;
+
+    /// \brief Releases the excess capacity of all levels and refinements
+    ///
+    /// Intended to be applied once refinement is complete. A base level
+    /// shared with other refiners is not affected, nor is the small
+    /// inventory of levels reserved by the refiner itself (so references
+    /// to its TopologyLevels remain valid).
+    ///
+    void ShrinkToFit();
+
+    /// \brief Options for the release of refined topology
+    struct ReleaseOptions {
+
+        ReleaseOptions() :
+            retainLastLevelFaceVertices(false),
+            retainLastLevelFVarValues(false) { }
+
+        unsigned int retainLastLevelFaceVertices:1, ///< Retain the face-vertices and
+                                                    ///< holes of the last level (e.g.
+                                                    ///< for drawing)
+                     retainLastLevelFVarValues:1;   ///< Retain the face-varying values of
+                                                    ///< the last level (requires the above)
+    };
+
+    /// \brief Releases the topology of all refined levels and refinements
+    ///
+    /// A finer-grained alternative to Unrefine() intended to be applied once
+    /// all tables dependent on the refinement (e.g. stencil and patch tables)
+    /// have been constructed. All refinements between levels are discarded,
+    /// along with all topological relations, tags and sharpness values of
+    /// the refined levels -- leaving only their component counts and the
+    /// relations selectively retained by the given options. The base level
+    /// is not affected.
+    ///
+    /// Once released, the topology of refined levels can no longer be used
+    /// to interpolate primvar data or to construct tables (both of which
+    /// report a runtime error), and the refiner must be unrefined before it
+    /// can be refined again.
+    ///
+    /// @param options   Options selecting the relations to retain
+    ///
+    void ReleaseRefinedTopology(ReleaseOptions options = ReleaseOptions());
+
+    /// \brief Returns true if the topology of refined levels was released
+    bool IsRefinedTopologyReleased() const { return _refinedTopologyReleased; }
+
 
     //@{
     /// @name Number and properties of face-varying channels:
@@ -267,6 +322,7 @@ private:
     unsigned int _hasIrregFaces : 1;
     unsigned int _regFaceSize   : 3;
     unsigned int _maxLevel      : 4;
+    unsigned int _refinedTopologyReleased : 1;
 
     //  Options assigned on refinement:
     UniformOptions  _uniformOptions;
@@ -103,17 +103,24 @@ TopologyRefinerFactoryBase::prepareComponentTopologySizing(
     baseLevel.resizeFaceVertices(fVertCount);
 
     //
-    //  If edges were sized, all other topological relations must be sized
-    //  with it, in which case we allocate those members to be populated.
-    //  Otherwise, sizing of the other topology members is deferred until
-    //  the face-vertices are assigned and the resulting relationships
-    //  determined:
+    //  If edges were sized with their incident faces, all other topological
+    //  relations must be sized with it, in which case we allocate those
+    //  members to be populated.  If edges were sized alone, only the
+    //  face-edges and edge-vertices are allocated to be populated with the
+    //  face-vertices.  Otherwise, sizing of the other topology members is
+    //  deferred until the face-vertices are assigned and the resulting
+    //  relationships determined:
     //
     int eCount = baseLevel.getNumEdges();
 
     if (eCount > 0) {
         baseLevel.resizeFaceEdges(baseLevel.getNumFaceVerticesTotal());
         baseLevel.resizeEdgeVertices();
+
+        bool edgeFacesSized = (baseLevel.getNumEdgeFaces(eCount-1) +
+                               baseLevel.getOffsetOfEdgeFaces(eCount-1)) > 0;
+        if (!edgeFacesSized) return true;
+
         baseLevel.resizeEdgeFaces(  baseLevel.getNumEdgeFaces(eCount-1)   +
                                     baseLevel.getOffsetOfEdgeFaces(eCount-1));
         baseLevel.resizeVertexFaces(baseLevel.getNumVertexFaces(vCount-1) +
@@ -137,8 +144,9 @@ TopologyRefinerFactoryBase::prepareComponentTopologyAssignment(
 
     Vtr::internal::Level& baseLevel = refiner.getLevel(0);
 
-    bool completeMissingTopology = (baseLevel.getNumEdges() == 0);
-    if (completeMissingTopology) {
+    bool completeMissingTopology = (baseLevel.getNumEdges() == 0) ||
+                                   (baseLevel.getNumEdgeFacesTotal() == 0);
+    if (baseLevel.getNumEdges() == 0) {
         if (! baseLevel.completeTopologyFromFaceVertices()) {
             char msg[1024];
             snprintf(msg, 1024,
@@ -148,6 +156,22 @@ TopologyRefinerFactoryBase::prepareComponentTopologyAssignment(
             Error(FAR_RUNTIME_ERROR, msg);
             return false;
         }
+    } else if (completeMissingTopology) {
+        if (! baseLevel.completeTopologyFromFaceEdges(callback, callbackData)) {
+            char msg[1024];
+            if (baseLevel.getMaxValence() > Vtr::VALENCE_LIMIT) {
+                snprintf(msg, 1024,
+                    "Failure in TopologyRefinerFactory<>::Create() -- "
+                    "vertex with valence %d > %d max.",
+                    baseLevel.getMaxValence(), Vtr::VALENCE_LIMIT);
+            } else {
+                snprintf(msg, 1024,
+                    "Failure in TopologyRefinerFactory<>::Create() -- "
+                    "invalid edges detected from partial specification.");
+            }
+            Error(FAR_RUNTIME_ERROR, msg);
+            return false;
+        }
     } else {
         if (baseLevel.getMaxValence() == 0) {
             Error(FAR_RUNTIME_ERROR,
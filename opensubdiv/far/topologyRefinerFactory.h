@@ -181,6 +181,12 @@ protected:
     ///  will be constructed later in the assembly (though at greater cost than if
     ///  specified directly).
     ///
+    ///  If edges are available but not the other relations incident edges and
+    ///  vertices, the number of edges can be specified with only the face-vertices.
+    ///  The face-edges and edge-vertices are then to be assigned with the
+    ///  face-vertices and the remaining relationships are constructed from them,
+    ///  avoiding the more costly search for the edges of each face.
+    ///
     ///  The sizes for topological relationships between individual components should be
     ///  specified in order, i.e. the number of face-vertices for each successive face.
     ///
@@ -389,8 +395,10 @@ TopologyRefinerFactory<MESH>::populateBaseLevel(TopologyRefiner& refiner, MESH c
 
     //
     //  Assignment of the topology -- this is a required specialization for MESH.  If edges
-    //  are specified, all other topological relations are expected to be defined for them.
-    //  Otherwise edges and remaining topology will be completed from the face-vertices:
+    //  are specified with their incident faces, all other topological relations are expected
+    //  to be defined for them.  If edges are specified alone, the remaining topology will be
+    //  completed from the face-edges.  Otherwise edges and remaining topology will be
+    //  completed from the face-vertices:
     //
     bool             validate = options.validateFullTopology;
     TopologyCallback callback = reinterpret_cast<TopologyCallback>(reportInvalidTopologyAdapter);
@@ -0,0 +1,198 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#include "../osd/asyncQueue.h"
+#include "../osd/mesh.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Osd {
+
+struct AsyncQueue::Impl {
+
+    struct Item {
+        ThreadPool::Task const * task;
+        int begin,
+            end;
+    };
+
+    Impl() : numEnqueued(0), numCompleted(0), stop(false) { }
+
+    static void WorkerMain(Impl * impl) {
+
+        for (;;) {
+            Item item;
+            {
+                std::unique_lock<std::mutex> lock(impl->mutex);
+                while (!impl->stop && impl->items.empty()) {
+                    impl->wakeCondition.wait(lock);
+                }
+                // pending items are completed before stopping
+                if (impl->items.empty()) return;
+                item = impl->items.front();
+                impl->items.pop_front();
+            }
+
+            item.task->Run(item.begin, item.end);
+
+            {
+                std::lock_guard<std::mutex> lock(impl->mutex);
+                ++impl->numCompleted;
+            }
+            impl->doneCondition.notify_all();
+        }
+    }
+
+    std::thread worker;
+
+    mutable std::mutex mutex;
+    std::condition_variable wakeCondition;
+    mutable std::condition_variable doneCondition;
+
+    std::deque<Item> items;
+    unsigned int numEnqueued,
+                 numCompleted;
+    bool stop;
+};
+
+AsyncQueue::AsyncQueue() : _impl(new Impl) {
+
+    _impl->worker = std::thread(Impl::WorkerMain, _impl);
+}
+
+AsyncQueue::~AsyncQueue() {
+
+    {
+        std::lock_guard<std::mutex> lock(_impl->mutex);
+        _impl->stop = true;
+    }
+    _impl->wakeCondition.notify_one();
+    _impl->worker.join();
+
+    delete _impl;
+}
+
+AsyncQueue::Fence
+AsyncQueue::Enqueue(ThreadPool::Task const & task, int begin, int end) {
+
+    Impl::Item item;
+    item.task = &task;
+    item.begin = begin;
+    item.end = end;
+
+    unsigned int serial;
+    {
+        std::lock_guard<std::mutex> lock(_impl->mutex);
+        _impl->items.push_back(item);
+        serial = ++_impl->numEnqueued;
+    }
+    _impl->wakeCondition.notify_one();
+
+    return Fence(this, serial);
+}
+
+void
+AsyncQueue::Wait() const {
+
+    unsigned int serial;
+    {
+        std::lock_guard<std::mutex> lock(_impl->mutex);
+        serial = _impl->numEnqueued;
+    }
+    wait(serial);
+}
+
+bool
+AsyncQueue::isComplete(unsigned int serial) const {
+
+    std::lock_guard<std::mutex> lock(_impl->mutex);
+    return _impl->numCompleted >= serial;
+}
+
+void
+AsyncQueue::wait(unsigned int serial) const {
+
+    std::unique_lock<std::mutex> lock(_impl->mutex);
+    while (_impl->numCompleted < serial) {
+        _impl->doneCondition.wait(lock);
+    }
+}
+
+bool
+AsyncQueue::Fence::IsComplete() const {
+
+    return _queue ? _queue->isComplete(_serial) : true;
+}
+
+void
+AsyncQueue::Fence::Wait() const {
+
+    if (_queue) _queue->wait(_serial);
+}
+
+//
+//  MeshRefineQueue:
+//
+struct MeshRefineQueue::Impl {
+    AsyncQueue queue;
+    AsyncQueue::Fence fence;
+};
+
+MeshRefineQueue::MeshRefineQueue() : _impl(new Impl) {
+}
+
+MeshRefineQueue::~MeshRefineQueue() {
+
+    delete _impl;
+}
+
+void
+MeshRefineQueue::Refine(ThreadPool::Task const & task) {
+
+    _impl->fence.Wait();
+    _impl->fence = _impl->queue.Enqueue(task);
+}
+
+bool
+MeshRefineQueue::IsComplete() const {
+
+    return _impl->fence.IsComplete();
+}
+
+void
+MeshRefineQueue::Wait() const {
+
+    _impl->fence.Wait();
+}
+
+}  // end namespace Osd
+
+}  // end namespace OPENSUBDIV_VERSION
+}  // end namespace OpenSubdiv
@@ -0,0 +1,102 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#ifndef OPENSUBDIV3_OSD_ASYNC_QUEUE_H
+#define OPENSUBDIV3_OSD_ASYNC_QUEUE_H
+
+#include "../version.h"
+
+#include "../osd/threadPool.h"
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Osd {
+
+/// \brief Runs tasks in order on a background thread
+///
+/// Each call to Enqueue() returns a Fence, which can be used to wait for
+/// the completion of the task. Tasks are not owned by the queue, and must
+/// remain valid until they complete.
+///
+class AsyncQueue {
+public:
+    /// \brief Handle to the completion of an enqueued task
+    ///
+    /// A default constructed fence is always complete. Fences must not be
+    /// used once their queue is destroyed.
+    ///
+    class Fence {
+    public:
+        Fence() : _queue(0), _serial(0) { }
+
+        /// Returns true if the task has completed
+        bool IsComplete() const;
+
+        /// Blocks until the task has completed
+        void Wait() const;
+
+    private:
+        friend class AsyncQueue;
+
+        Fence(AsyncQueue const * queue, unsigned int serial) :
+            _queue(queue), _serial(serial) { }
+
+        AsyncQueue const * _queue;
+        unsigned int _serial;
+    };
+
+    /// Constructor. Starts the background thread.
+    AsyncQueue();
+
+    /// Destructor. Completes the pending tasks and joins the thread.
+    ~AsyncQueue();
+
+    /// \brief Enqueues task.Run(begin, end) for the background thread
+    Fence Enqueue(ThreadPool::Task const & task, int begin = 0, int end = 1);
+
+    /// \brief Blocks until all the enqueued tasks have completed
+    void Wait() const;
+
+private:
+    // Non-copyable
+    AsyncQueue(AsyncQueue const &);
+    AsyncQueue & operator=(AsyncQueue const &);
+
+    bool isComplete(unsigned int serial) const;
+    void wait(unsigned int serial) const;
+
+    // The implementation isolates the threading headers from clients
+    struct Impl;
+    Impl * _impl;
+};
+
+}  // end namespace Osd
+
+}  // end namespace OPENSUBDIV_VERSION
+using namespace OPENSUBDIV_VERSION;
+
+}  // end namespace OpenSubdiv
+
+#endif  // OPENSUBDIV3_OSD_ASYNC_QUEUE_H
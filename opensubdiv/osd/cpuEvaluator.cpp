@@ -27,8 +27,10 @@
 #include "../osd/patchBasisCommonTypes.h"
 #include "../osd/patchBasisCommon.h"
 #include "../osd/patchBasisCommonEval.h"
+#include "../far/instrumentation.h"
 
 #include <cstdlib>
+#include <vector>
 
 namespace OpenSubdiv {
 namespace OPENSUBDIV_VERSION {
@@ -45,6 +47,9 @@ CpuEvaluator::EvalStencils(const float *src, BufferDescriptor const &srcDesc,
                            const float * weights,
                            int start, int end) {
 
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
     if (end <= start) return true;
     if (srcDesc.length != dstDesc.length) return false;
 
@@ -68,6 +73,9 @@ CpuEvaluator::EvalStencils(const float *src, BufferDescriptor const &srcDesc,
                            const float * duWeights,
                            const float * dvWeights,
                            int start, int end) {
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
     if (end <= start) return true;
     if (srcDesc.length != dstDesc.length) return false;
     if (srcDesc.length != duDesc.length) return false;
@@ -103,6 +111,9 @@ CpuEvaluator::EvalStencils(const float *src, BufferDescriptor const &srcDesc,
                            const float * duvWeights,
                            const float * dvvWeights,
                            int start, int end) {
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
     if (end <= start) return true;
     if (srcDesc.length != dstDesc.length) return false;
     if (srcDesc.length != duDesc.length) return false;
@@ -131,7 +142,9 @@ struct BufferAdapter {
     BufferAdapter(T *p, int length, int stride) :
         _p(p), _length(length), _stride(stride) { }
     void Clear() {
-        for (int i = 0; i < _length; ++i) _p[i] = 0;
+        if (_p) {
+            for (int i = 0; i < _length; ++i) _p[i] = 0;
+        }
     }
     void AddWithWeight(T const *src, float w) {
         if (_p) {
@@ -164,6 +177,9 @@ CpuEvaluator::EvalPatches(const float *src, BufferDescriptor const &srcDesc,
                           const PatchArray *patchArrays,
                           const int *patchIndexBuffer,
                           const PatchParam *patchParamBuffer) {
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
     if (src) {
         src += srcDesc.offset;
     } else {
@@ -222,6 +238,9 @@ CpuEvaluator::EvalPatches(const float *src, BufferDescriptor const &srcDesc,
                           const PatchArray *patchArrays,
                           const int *patchIndexBuffer,
                           const PatchParam *patchParamBuffer) {
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
     if (src) {
         src += srcDesc.offset;
     } else {
@@ -297,6 +316,9 @@ CpuEvaluator::EvalPatches(const float *src, BufferDescriptor const &srcDesc,
                           const PatchArray *patchArrays,
                           const int *patchIndexBuffer,
                           const PatchParam *patchParamBuffer) {
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
     if (src) {
         src += srcDesc.offset;
     } else {
@@ -382,6 +404,697 @@ CpuEvaluator::EvalPatches(const float *src, BufferDescriptor const &srcDesc,
     return true;
 }
 
+//
+//  Limit evaluation decoding the patch control vertices from a compact
+//  table -- any of the outputs may be NULL:
+//
+static bool
+evalPatchesCompact(const float *src, BufferDescriptor const &srcDesc,
+                   float *dst,       BufferDescriptor const &dstDesc,
+                   float *du,        BufferDescriptor const &duDesc,
+                   float *dv,        BufferDescriptor const &dvDesc,
+                   float *duu,       BufferDescriptor const &duuDesc,
+                   float *duv,       BufferDescriptor const &duvDesc,
+                   float *dvv,       BufferDescriptor const &dvvDesc,
+                   int numPatchCoords,
+                   PatchCoord const *patchCoords,
+                   PatchArray const *patchArrays,
+                   Far::CompactPatchVertices const *patchVertices,
+                   PatchParam const *patchParamBuffer) {
+
+    if (src == NULL || patchVertices == NULL) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (du  && srcDesc.length != duDesc.length)  return false;
+    if (dv  && srcDesc.length != dvDesc.length)  return false;
+    if (duu && srcDesc.length != duuDesc.length) return false;
+    if (duv && srcDesc.length != duvDesc.length) return false;
+    if (dvv && srcDesc.length != dvvDesc.length) return false;
+
+    CpuEvalPatchesCompact(src, srcDesc, dst, dstDesc,
+                          du, duDesc, dv, dvDesc,
+                          duu, duuDesc, duv, duvDesc, dvv, dvvDesc,
+                          0, numPatchCoords, patchCoords, patchArrays,
+                          patchVertices, patchParamBuffer);
+    return true;
+}
+
+/* static */
+bool
+CpuEvaluator::EvalPatches(const float *src, BufferDescriptor const &srcDesc,
+                          float *dst,       BufferDescriptor const &dstDesc,
+                          int numPatchCoords,
+                          const PatchCoord *patchCoords,
+                          const PatchArray *patchArrays,
+                          Far::CompactPatchVertices const *patchVertices,
+                          const PatchParam *patchParamBuffer) {
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (!dst) return false;
+
+    return evalPatchesCompact(src, srcDesc, dst, dstDesc,
+                              0, BufferDescriptor(), 0, BufferDescriptor(),
+                              0, BufferDescriptor(), 0, BufferDescriptor(),
+                              0, BufferDescriptor(),
+                              numPatchCoords, patchCoords, patchArrays,
+                              patchVertices, patchParamBuffer);
+}
+
+/* static */
+bool
+CpuEvaluator::EvalPatches(const float *src, BufferDescriptor const &srcDesc,
+                          float *dst,       BufferDescriptor const &dstDesc,
+                          float *du,        BufferDescriptor const &duDesc,
+                          float *dv,        BufferDescriptor const &dvDesc,
+                          int numPatchCoords,
+                          const PatchCoord *patchCoords,
+                          const PatchArray *patchArrays,
+                          Far::CompactPatchVertices const *patchVertices,
+                          const PatchParam *patchParamBuffer) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    return evalPatchesCompact(src, srcDesc, dst, dstDesc,
+                              du, duDesc, dv, dvDesc,
+                              0, BufferDescriptor(), 0, BufferDescriptor(),
+                              0, BufferDescriptor(),
+                              numPatchCoords, patchCoords, patchArrays,
+                              patchVertices, patchParamBuffer);
+}
+
+/* static */
+bool
+CpuEvaluator::EvalPatches(const float *src, BufferDescriptor const &srcDesc,
+                          float *dst,       BufferDescriptor const &dstDesc,
+                          float *du,        BufferDescriptor const &duDesc,
+                          float *dv,        BufferDescriptor const &dvDesc,
+                          float *duu,       BufferDescriptor const &duuDesc,
+                          float *duv,       BufferDescriptor const &duvDesc,
+                          float *dvv,       BufferDescriptor const &dvvDesc,
+                          int numPatchCoords,
+                          const PatchCoord *patchCoords,
+                          const PatchArray *patchArrays,
+                          Far::CompactPatchVertices const *patchVertices,
+                          const PatchParam *patchParamBuffer) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    return evalPatchesCompact(src, srcDesc, dst, dstDesc,
+                              du, duDesc, dv, dvDesc,
+                              duu, duuDesc, duv, duvDesc, dvv, dvvDesc,
+                              numPatchCoords, patchCoords, patchArrays,
+                              patchVertices, patchParamBuffer);
+}
+
+// ---------------------------------------------------------------------------
+//
+//  Double precision evaluations
+//
+
+/* static */
+bool
+CpuEvaluator::EvalStencils(const double *src, BufferDescriptor const &srcDesc,
+                           double *dst,       BufferDescriptor const &dstDesc,
+                           const int * sizes,
+                           const int * offsets,
+                           const int * indices,
+                           const double * weights,
+                           int start, int end) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+    if (srcDesc.length != dstDesc.length) return false;
+
+    // XXX: we can probably expand cpuKernel.cpp to here.
+    CpuEvalStencils(src, srcDesc, dst, dstDesc,
+                    sizes, offsets, indices, weights, start, end);
+
+    return true;
+}
+
+/* static */
+bool
+CpuEvaluator::EvalStencils(const double *src, BufferDescriptor const &srcDesc,
+                           double *dst,       BufferDescriptor const &dstDesc,
+                           double *du,        BufferDescriptor const &duDesc,
+                           double *dv,        BufferDescriptor const &dvDesc,
+                           const int * sizes,
+                           const int * offsets,
+                           const int * indices,
+                           const double * weights,
+                           const double * duWeights,
+                           const double * dvWeights,
+                           int start, int end) {
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+    if (srcDesc.length != dstDesc.length) return false;
+    if (srcDesc.length != duDesc.length) return false;
+    if (srcDesc.length != dvDesc.length) return false;
+
+    CpuEvalStencils(src, srcDesc,
+                    dst, dstDesc,
+                    du,  duDesc,
+                    dv,  dvDesc,
+                    sizes, offsets, indices,
+                    weights, duWeights, dvWeights,
+                    start, end);
+
+    return true;
+}
+
+/* static */
+bool
+CpuEvaluator::EvalStencils(const double *src, BufferDescriptor const &srcDesc,
+                           double *dst,       BufferDescriptor const &dstDesc,
+                           double *du,        BufferDescriptor const &duDesc,
+                           double *dv,        BufferDescriptor const &dvDesc,
+                           double *duu,       BufferDescriptor const &duuDesc,
+                           double *duv,       BufferDescriptor const &duvDesc,
+                           double *dvv,       BufferDescriptor const &dvvDesc,
+                           const int * sizes,
+                           const int * offsets,
+                           const int * indices,
+                           const double * weights,
+                           const double * duWeights,
+                           const double * dvWeights,
+                           const double * duuWeights,
+                           const double * duvWeights,
+                           const double * dvvWeights,
+                           int start, int end) {
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+    if (srcDesc.length != dstDesc.length) return false;
+    if (srcDesc.length != duDesc.length) return false;
+    if (srcDesc.length != dvDesc.length) return false;
+    if (srcDesc.length != duuDesc.length) return false;
+    if (srcDesc.length != duvDesc.length) return false;
+    if (srcDesc.length != dvvDesc.length) return false;
+
+    CpuEvalStencils(src, srcDesc,
+                    dst, dstDesc,
+                    du,  duDesc,
+                    dv,  dvDesc,
+                    duu, duuDesc,
+                    duv, duvDesc,
+                    dvv, dvvDesc,
+                    sizes, offsets, indices,
+                    weights, duWeights, dvWeights,
+                    duuWeights, duvWeights, dvvWeights,
+                    start, end);
+
+    return true;
+}
+
+/* static */
+bool
+CpuEvaluator::EvalPatches(const double *src, BufferDescriptor const &srcDesc,
+                          double *dst,       BufferDescriptor const &dstDesc,
+                          int numPatchCoords,
+                          const PatchCoord *patchCoords,
+                          const PatchArray *patchArrays,
+                          const int *patchIndexBuffer,
+                          const PatchParam *patchParamBuffer) {
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (src == NULL) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+
+    CpuEvalPatches(src, srcDesc,
+                   dst, dstDesc,
+                   NULL, BufferDescriptor(),
+                   NULL, BufferDescriptor(),
+                   NULL, BufferDescriptor(),
+                   NULL, BufferDescriptor(),
+                   NULL, BufferDescriptor(),
+                   0, numPatchCoords, patchCoords, patchArrays,
+                   patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
+/* static */
+bool
+CpuEvaluator::EvalPatches(const double *src, BufferDescriptor const &srcDesc,
+                          double *dst,       BufferDescriptor const &dstDesc,
+                          double *du,        BufferDescriptor const &duDesc,
+                          double *dv,        BufferDescriptor const &dvDesc,
+                          int numPatchCoords,
+                          const PatchCoord *patchCoords,
+                          const PatchArray *patchArrays,
+                          const int *patchIndexBuffer,
+                          const PatchParam *patchParamBuffer) {
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (src == NULL) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (du && srcDesc.length != duDesc.length) return false;
+    if (dv && srcDesc.length != dvDesc.length) return false;
+
+    CpuEvalPatches(src, srcDesc,
+                   dst, dstDesc,
+                   du, duDesc,
+                   dv, dvDesc,
+                   NULL, BufferDescriptor(),
+                   NULL, BufferDescriptor(),
+                   NULL, BufferDescriptor(),
+                   0, numPatchCoords, patchCoords, patchArrays,
+                   patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
+/* static */
+bool
+CpuEvaluator::EvalPatches(const double *src, BufferDescriptor const &srcDesc,
+                          double *dst,       BufferDescriptor const &dstDesc,
+                          double *du,        BufferDescriptor const &duDesc,
+                          double *dv,        BufferDescriptor const &dvDesc,
+                          double *duu,       BufferDescriptor const &duuDesc,
+                          double *duv,       BufferDescriptor const &duvDesc,
+                          double *dvv,       BufferDescriptor const &dvvDesc,
+                          int numPatchCoords,
+                          const PatchCoord *patchCoords,
+                          const PatchArray *patchArrays,
+                          const int *patchIndexBuffer,
+                          const PatchParam *patchParamBuffer) {
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (src == NULL) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (du && srcDesc.length != duDesc.length) return false;
+    if (dv && srcDesc.length != dvDesc.length) return false;
+    if (duu && srcDesc.length != duuDesc.length) return false;
+    if (duv && srcDesc.length != duvDesc.length) return false;
+    if (dvv && srcDesc.length != dvvDesc.length) return false;
+
+    CpuEvalPatches(src, srcDesc,
+                   dst, dstDesc,
+                   du, duDesc,
+                   dv, dvDesc,
+                   duu, duuDesc,
+                   duv, duvDesc,
+                   dvv, dvvDesc,
+                   0, numPatchCoords, patchCoords, patchArrays,
+                   patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+//
+//  Instanced evaluations
+//
+
+/* static */
+bool
+CpuEvaluator::EvalStencilsInstanced(const float *src, BufferDescriptor const &srcDesc,
+                                    int srcInstanceStride,
+                                    float *dst,       BufferDescriptor const &dstDesc,
+                                    int dstInstanceStride,
+                                    int numInstances,
+                                    const int * sizes,
+                                    const int * offsets,
+                                    const int * indices,
+                                    const float * weights,
+                                    int start, int end) {
+
+    if (end <= start || numInstances <= 0) return true;
+    if (src == NULL || dst == NULL) return false;
+
+    std::vector<const float *> srcInstances;
+    std::vector<float *> dstInstances;
+    CpuGetInstancePointers(src, srcInstanceStride, numInstances, srcInstances);
+    CpuGetInstancePointers(dst, dstInstanceStride, numInstances, dstInstances);
+
+    return EvalStencilsInstanced(&srcInstances[0], srcDesc,
+                                 &dstInstances[0], dstDesc,
+                                 numInstances,
+                                 sizes, offsets, indices, weights,
+                                 start, end);
+}
+
+/* static */
+bool
+CpuEvaluator::EvalStencilsInstanced(const float * const *srcInstances, BufferDescriptor const &srcDesc,
+                                    float * const *dstInstances,       BufferDescriptor const &dstDesc,
+                                    int numInstances,
+                                    const int * sizes,
+                                    const int * offsets,
+                                    const int * indices,
+                                    const float * weights,
+                                    int start, int end) {
+
+    if (end <= start || numInstances <= 0) return true;
+    if (srcInstances == NULL || dstInstances == NULL) return false;
+    if (srcDesc.length != dstDesc.length) return false;
+
+    CpuEvalStencilsInstanced(srcInstances, srcDesc, dstInstances, dstDesc,
+                             0, numInstances,
+                             sizes, offsets, indices, weights, start, end);
+
+    return true;
+}
+
+/* static */
+bool
+CpuEvaluator::EvalPatchesInstanced(const float *src, BufferDescriptor const &srcDesc,
+                                   int srcInstanceStride,
+                                   float *dst,       BufferDescriptor const &dstDesc,
+                                   float *du,        BufferDescriptor const &duDesc,
+                                   float *dv,        BufferDescriptor const &dvDesc,
+                                   int dstInstanceStride,
+                                   int numInstances,
+                                   int numPatchCoords,
+                                   const PatchCoord *patchCoords,
+                                   const PatchArray *patchArrays,
+                                   const int *patchIndexBuffer,
+                                   const PatchParam *patchParamBuffer) {
+
+    if (numPatchCoords <= 0 || numInstances <= 0) return true;
+    if (src == NULL) return false;
+
+    std::vector<const float *> srcInstances;
+    std::vector<float *> dstInstances, duInstances, dvInstances;
+    CpuGetInstancePointers(src, srcInstanceStride, numInstances, srcInstances);
+    CpuGetInstancePointers(dst, dstInstanceStride, numInstances, dstInstances);
+    CpuGetInstancePointers(du,  dstInstanceStride, numInstances, duInstances);
+    CpuGetInstancePointers(dv,  dstInstanceStride, numInstances, dvInstances);
+
+    return EvalPatchesInstanced(&srcInstances[0], srcDesc,
+                                dst ? &dstInstances[0] : NULL, dstDesc,
+                                du  ? &duInstances[0]  : NULL, duDesc,
+                                dv  ? &dvInstances[0]  : NULL, dvDesc,
+                                numInstances, numPatchCoords,
+                                patchCoords, patchArrays,
+                                patchIndexBuffer, patchParamBuffer);
+}
+
+/* static */
+bool
+CpuEvaluator::EvalPatchesInstanced(const float * const *srcInstances, BufferDescriptor const &srcDesc,
+                                   float * const *dstInstances,       BufferDescriptor const &dstDesc,
+                                   float * const *duInstances,        BufferDescriptor const &duDesc,
+                                   float * const *dvInstances,        BufferDescriptor const &dvDesc,
+                                   int numInstances,
+                                   int numPatchCoords,
+                                   const PatchCoord *patchCoords,
+                                   const PatchArray *patchArrays,
+                                   const int *patchIndexBuffer,
+                                   const PatchParam *patchParamBuffer) {
+
+    if (numPatchCoords <= 0 || numInstances <= 0) return true;
+    if (srcInstances == NULL) return false;
+    if (dstInstances && srcDesc.length != dstDesc.length) return false;
+    if (duInstances && srcDesc.length != duDesc.length) return false;
+    if (dvInstances && srcDesc.length != dvDesc.length) return false;
+
+    CpuEvalPatchesInstanced(srcInstances, srcDesc,
+                            dstInstances, dstDesc,
+                            duInstances, duDesc,
+                            dvInstances, dvDesc,
+                            0, numInstances, 0, numPatchCoords,
+                            patchCoords, patchArrays,
+                            patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
+//
+//  Stencil subset evaluations
+//
+
+/* static */
+bool
+CpuEvaluator::EvalStencilsSubset(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const float * weights,
+    int numStencilIndices,
+    const int * stencilIndices) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, numStencilIndices);
+
+    if (numStencilIndices <= 0) return true;
+    if (srcDesc.length != dstDesc.length) return false;
+
+    CpuEvalStencilSubset(src, srcDesc, dst, dstDesc,
+                         sizes, offsets, indices, weights,
+                         stencilIndices, 0, numStencilIndices);
+
+    return true;
+}
+
+/* static */
+bool
+CpuEvaluator::EvalStencilsSubset(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const double * weights,
+    int numStencilIndices,
+    const int * stencilIndices) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, numStencilIndices);
+
+    if (numStencilIndices <= 0) return true;
+    if (srcDesc.length != dstDesc.length) return false;
+
+    CpuEvalStencilSubset(src, srcDesc, dst, dstDesc,
+                         sizes, offsets, indices, weights,
+                         stencilIndices, 0, numStencilIndices);
+
+    return true;
+}
+
+//
+//  Limit normal evaluations
+//
+
+/* static */
+bool
+CpuEvaluator::EvalStencilsNormals(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    float *normal,    BufferDescriptor const &normalDesc,
+    float *tangent,   BufferDescriptor const &tangentDesc,
+    float *bitangent, BufferDescriptor const &bitangentDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const float * weights,
+    const float * duWeights,
+    const float * dvWeights,
+    const float * duuWeights,
+    const float * duvWeights,
+    const float * dvvWeights,
+    int start, int end) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+    if (srcDesc.length < 3) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (normal && normalDesc.length < 3) return false;
+    if (tangent && tangentDesc.length < 3) return false;
+    if (bitangent && bitangentDesc.length < 3) return false;
+
+    CpuEvalStencilNormals(src, srcDesc, dst, dstDesc,
+                          normal, normalDesc, tangent, tangentDesc,
+                          bitangent, bitangentDesc,
+                          sizes, offsets, indices, weights,
+                          duWeights, dvWeights,
+                          duuWeights, duvWeights, dvvWeights,
+                          start, end);
+
+    return true;
+}
+
+/* static */
+bool
+CpuEvaluator::EvalStencilsNormals(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    double *normal,    BufferDescriptor const &normalDesc,
+    double *tangent,   BufferDescriptor const &tangentDesc,
+    double *bitangent, BufferDescriptor const &bitangentDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const double * weights,
+    const double * duWeights,
+    const double * dvWeights,
+    const double * duuWeights,
+    const double * duvWeights,
+    const double * dvvWeights,
+    int start, int end) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+    if (srcDesc.length < 3) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (normal && normalDesc.length < 3) return false;
+    if (tangent && tangentDesc.length < 3) return false;
+    if (bitangent && bitangentDesc.length < 3) return false;
+
+    CpuEvalStencilNormals(src, srcDesc, dst, dstDesc,
+                          normal, normalDesc, tangent, tangentDesc,
+                          bitangent, bitangentDesc,
+                          sizes, offsets, indices, weights,
+                          duWeights, dvWeights,
+                          duuWeights, duvWeights, dvvWeights,
+                          start, end);
+
+    return true;
+}
+
+/* static */
+bool
+CpuEvaluator::EvalPatchesNormals(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    float *normal,    BufferDescriptor const &normalDesc,
+    float *tangent,   BufferDescriptor const &tangentDesc,
+    float *bitangent, BufferDescriptor const &bitangentDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (numPatchCoords <= 0) return true;
+    if (src == NULL || srcDesc.length < 3) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (normal && normalDesc.length < 3) return false;
+    if (tangent && tangentDesc.length < 3) return false;
+    if (bitangent && bitangentDesc.length < 3) return false;
+
+    CpuEvalPatchNormals(src, srcDesc, dst, dstDesc,
+                        normal, normalDesc, tangent, tangentDesc,
+                        bitangent, bitangentDesc,
+                        0, numPatchCoords, patchCoords, patchArrays,
+                        patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
+/* static */
+bool
+CpuEvaluator::EvalPatchesNormals(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    double *normal,    BufferDescriptor const &normalDesc,
+    double *tangent,   BufferDescriptor const &tangentDesc,
+    double *bitangent, BufferDescriptor const &bitangentDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (numPatchCoords <= 0) return true;
+    if (src == NULL || srcDesc.length < 3) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (normal && normalDesc.length < 3) return false;
+    if (tangent && tangentDesc.length < 3) return false;
+    if (bitangent && bitangentDesc.length < 3) return false;
+
+    CpuEvalPatchNormals(src, srcDesc, dst, dstDesc,
+                        normal, normalDesc, tangent, tangentDesc,
+                        bitangent, bitangentDesc,
+                        0, numPatchCoords, patchCoords, patchArrays,
+                        patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
+//
+//  Packed output evaluations
+//
+
+/* static */
+bool
+CpuEvaluator::EvalStencilsPacked(
+    const float *src, BufferDescriptor const &srcDesc,
+    void *dst,        PackedBufferDescriptor const &dstDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const float * weights,
+    int start, int end) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+    if (dst == NULL || !dstDesc.IsValid()) return false;
+    if (srcDesc.length != dstDesc.length) return false;
+
+    CpuEvalStencilsPacked(src, srcDesc, dst, dstDesc,
+                          sizes, offsets, indices, weights,
+                          start, end);
+
+    return true;
+}
+
+/* static */
+bool
+CpuEvaluator::EvalPatchesPacked(
+    const float *src, BufferDescriptor const &srcDesc,
+    void *dst,        PackedBufferDescriptor const &dstDesc,
+    void *normal,     PackedBufferDescriptor const &normalDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (numPatchCoords <= 0) return true;
+    if (src == NULL) return false;
+    if (dst && (!dstDesc.IsValid() || srcDesc.length != dstDesc.length)) {
+        return false;
+    }
+    if (normal && (!normalDesc.IsValid() || normalDesc.length != 3 ||
+                   srcDesc.length < 3)) {
+        return false;
+    }
+
+    CpuEvalPatchesPacked(src, srcDesc, dst, dstDesc,
+                         normal, normalDesc,
+                         0, numPatchCoords, patchCoords, patchArrays,
+                         patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
 
 }  // end namespace Osd
 
@@ -24,10 +24,17 @@
 
 #include "../osd/cpuKernel.h"
 #include "../osd/bufferDescriptor.h"
+#include "../osd/grainPolicy.h"
+#include "../osd/packedBufferDescriptor.h"
+#include "../osd/types.h"
+#include "../far/patchBasis.h"
+#include "../far/compactPatchVertices.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstdlib>
+#include <limits>
 #include <vector>
 
 namespace OpenSubdiv {
@@ -41,15 +48,17 @@ elementAtIndex(T * src, int index, BufferDescriptor const &desc) {
     return src + index * desc.stride;
 }
 
+template <typename REAL>
 static inline void
-clear(float *dst, BufferDescriptor const &desc) {
+clear(REAL *dst, BufferDescriptor const &desc) {
 
     assert(dst);
-    memset(dst, 0, desc.length*sizeof(float));
+    memset(dst, 0, desc.length*sizeof(REAL));
 }
 
+template <typename REAL>
 static inline void
-addWithWeight(float *dst, const float *src, int srcIndex, float weight,
+addWithWeight(REAL *dst, const REAL *src, int srcIndex, REAL weight,
               BufferDescriptor const &desc) {
 
     assert(src && dst);
@@ -59,22 +68,23 @@ addWithWeight(float *dst, const float *src, int srcIndex, float weight,
     }
 }
 
+template <typename REAL>
 static inline void
-copy(float *dst, int dstIndex, const float *src, BufferDescriptor const &desc) {
+copy(REAL *dst, int dstIndex, const REAL *src, BufferDescriptor const &desc) {
 
     assert(src && dst);
 
     dst = elementAtIndex(dst, dstIndex, desc);
-    memcpy(dst, src, desc.length*sizeof(float));
+    memcpy(dst, src, desc.length*sizeof(REAL));
 }
 
-void
-CpuEvalStencils(float const * src, BufferDescriptor const &srcDesc,
-                float * dst,       BufferDescriptor const &dstDesc,
+template <typename REAL> void
+CpuEvalStencils(REAL const * src, BufferDescriptor const &srcDesc,
+                REAL * dst,       BufferDescriptor const &dstDesc,
                 int const * sizes,
                 int const * offsets,
                 int const * indices,
-                float const * weights,
+                REAL const * weights,
                 int start, int end) {
 
     assert(start>=0 && start<end);
@@ -91,21 +101,21 @@ CpuEvalStencils(float const * src, BufferDescriptor const &srcDesc,
     if (srcDesc.length == 4 && dstDesc.length == 4 &&
         srcDesc.stride == 4 && dstDesc.stride == 4) {
 
-        // SIMD fast path for aligned primvar data (4 floats)
+        // SIMD fast path for aligned primvar data (4 elements)
         ComputeStencilKernel<4>(src, dst,
             sizes, indices, weights, start,  end);
 
     } else if (srcDesc.length == 8 && dstDesc.length == 8 &&
                srcDesc.stride == 8 && dstDesc.stride == 8) {
 
-        // SIMD fast path for aligned primvar data (8 floats)
+        // SIMD fast path for aligned primvar data (8 elements)
         ComputeStencilKernel<8>(src, dst,
             sizes, indices, weights, start,  end);
     } else {
 
         // Slow path for non-aligned data
 
-        float * result = (float*)alloca(srcDesc.length * sizeof(float));
+        REAL * result = (REAL*)alloca(srcDesc.length * sizeof(REAL));
 
         int nstencils = end-start;
         for (int i=0; i<nstencils; ++i, ++sizes) {
@@ -121,17 +131,17 @@ CpuEvalStencils(float const * src, BufferDescriptor const &srcDesc,
     }
 }
 
-void
-CpuEvalStencils(float const * src, BufferDescriptor const &srcDesc,
-                float * dst,       BufferDescriptor const &dstDesc,
-                float * dstDu,     BufferDescriptor const &dstDuDesc,
-                float * dstDv,     BufferDescriptor const &dstDvDesc,
+template <typename REAL> void
+CpuEvalStencils(REAL const * src, BufferDescriptor const &srcDesc,
+                REAL * dst,       BufferDescriptor const &dstDesc,
+                REAL * dstDu,     BufferDescriptor const &dstDuDesc,
+                REAL * dstDv,     BufferDescriptor const &dstDvDesc,
                 int const * sizes,
                 int const * offsets,
                 int const * indices,
-                float const * weights,
-                float const * duWeights,
-                float const * dvWeights,
+                REAL const * weights,
+                REAL const * duWeights,
+                REAL const * dvWeights,
                 int start, int end) {
     if (start > 0) {
         sizes += start;
@@ -147,15 +157,15 @@ CpuEvalStencils(float const * src, BufferDescriptor const &srcDesc,
     dstDv += dstDvDesc.offset;
 
     int nOutLength = dstDesc.length + dstDuDesc.length + dstDvDesc.length;
-    float * result   = (float*)alloca(nOutLength * sizeof(float));
-    float * resultDu = result + dstDesc.length;
-    float * resultDv = resultDu + dstDuDesc.length;
+    REAL * result   = (REAL*)alloca(nOutLength * sizeof(REAL));
+    REAL * resultDu = result + dstDesc.length;
+    REAL * resultDv = resultDu + dstDuDesc.length;
 
     int nStencils = end - start;
     for (int i = 0; i < nStencils; ++i, ++sizes) {
 
         // clear
-        memset(result, 0, nOutLength * sizeof(float));
+        memset(result, 0, nOutLength * sizeof(REAL));
 
         for (int j=0; j<*sizes; ++j) {
             addWithWeight(result,   src, *indices, *weights++,   srcDesc);
@@ -169,23 +179,23 @@ CpuEvalStencils(float const * src, BufferDescriptor const &srcDesc,
     }
 }
 
-void
-CpuEvalStencils(float const * src, BufferDescriptor const &srcDesc,
-                float * dst,       BufferDescriptor const &dstDesc,
-                float * dstDu,     BufferDescriptor const &dstDuDesc,
-                float * dstDv,     BufferDescriptor const &dstDvDesc,
-                float * dstDuu,    BufferDescriptor const &dstDuuDesc,
-                float * dstDuv,    BufferDescriptor const &dstDuvDesc,
-                float * dstDvv,    BufferDescriptor const &dstDvvDesc,
+template <typename REAL> void
+CpuEvalStencils(REAL const * src, BufferDescriptor const &srcDesc,
+                REAL * dst,       BufferDescriptor const &dstDesc,
+                REAL * dstDu,     BufferDescriptor const &dstDuDesc,
+                REAL * dstDv,     BufferDescriptor const &dstDvDesc,
+                REAL * dstDuu,    BufferDescriptor const &dstDuuDesc,
+                REAL * dstDuv,    BufferDescriptor const &dstDuvDesc,
+                REAL * dstDvv,    BufferDescriptor const &dstDvvDesc,
                 int const * sizes,
                 int const * offsets,
                 int const * indices,
-                float const * weights,
-                float const * duWeights,
-                float const * dvWeights,
-                float const * duuWeights,
-                float const * duvWeights,
-                float const * dvvWeights,
+                REAL const * weights,
+                REAL const * duWeights,
+                REAL const * dvWeights,
+                REAL const * duuWeights,
+                REAL const * duvWeights,
+                REAL const * dvvWeights,
                 int start, int end) {
     if (start > 0) {
         sizes += start;
@@ -208,18 +218,18 @@ CpuEvalStencils(float const * src, BufferDescriptor const &srcDesc,
 
     int nOutLength = dstDesc.length + dstDuDesc.length + dstDvDesc.length
                    + dstDuuDesc.length + dstDuvDesc.length + dstDvvDesc.length;
-    float * result   = (float*)alloca(nOutLength * sizeof(float));
-    float * resultDu = result + dstDesc.length;
-    float * resultDv = resultDu + dstDuDesc.length;
-    float * resultDuu = resultDv + dstDvDesc.length;
-    float * resultDuv = resultDuu + dstDuuDesc.length;
-    float * resultDvv = resultDuv + dstDuvDesc.length;
+    REAL * result   = (REAL*)alloca(nOutLength * sizeof(REAL));
+    REAL * resultDu = result + dstDesc.length;
+    REAL * resultDv = resultDu + dstDuDesc.length;
+    REAL * resultDuu = resultDv + dstDvDesc.length;
+    REAL * resultDuv = resultDuu + dstDuuDesc.length;
+    REAL * resultDvv = resultDuv + dstDuvDesc.length;
 
     int nStencils = end - start;
     for (int i = 0; i < nStencils; ++i, ++sizes) {
 
         // clear
-        memset(result, 0, nOutLength * sizeof(float));
+        memset(result, 0, nOutLength * sizeof(REAL));
 
         for (int j=0; j<*sizes; ++j) {
             addWithWeight(result,   src, *indices, *weights++,   srcDesc);
@@ -239,6 +249,1059 @@ CpuEvalStencils(float const * src, BufferDescriptor const &srcDesc,
     }
 }
 
+template <typename REAL>
+static inline void
+applyWeights(REAL *dst, int dstIndex, BufferDescriptor const &dstDesc,
+             const REAL *src, BufferDescriptor const &srcDesc,
+             int const *cvs, REAL const *weights, int numWeights) {
+
+    if (!dst) return;
+
+    dst = elementAtIndex(dst, dstIndex, dstDesc);
+    clear(dst, dstDesc);
+    for (int j = 0; j < numWeights; ++j) {
+        addWithWeight(dst, src, cvs[j], weights[j], srcDesc);
+    }
+}
+
+template <typename REAL>
+static void
+evalPatches(REAL const * src, BufferDescriptor const &srcDesc,
+            REAL * dst,       BufferDescriptor const &dstDesc,
+            REAL * dstDu,     BufferDescriptor const &dstDuDesc,
+            REAL * dstDv,     BufferDescriptor const &dstDvDesc,
+            REAL * dstDuu,    BufferDescriptor const &dstDuuDesc,
+            REAL * dstDuv,    BufferDescriptor const &dstDuvDesc,
+            REAL * dstDvv,    BufferDescriptor const &dstDvvDesc,
+            int start, int end,
+            PatchCoord const * patchCoords,
+            PatchArray const * patchArrays,
+            int const * patchIndexBuffer,
+            Far::CompactPatchVertices const * patchVertices,
+            PatchParam const * patchParamBuffer) {
+
+    src += srcDesc.offset;
+    if (dst)    dst    += dstDesc.offset;
+    if (dstDu)  dstDu  += dstDuDesc.offset;
+    if (dstDv)  dstDv  += dstDvDesc.offset;
+    if (dstDuu) dstDuu += dstDuuDesc.offset;
+    if (dstDuv) dstDuv += dstDuvDesc.offset;
+    if (dstDvv) dstDvv += dstDvvDesc.offset;
+
+    //  Second derivative weights are only computed with the first:
+    bool needDeriv2 = dstDuu || dstDuv || dstDvv;
+    bool needDeriv1 = dstDu || dstDv || needDeriv2;
+
+    REAL wP[20], wDu[20], wDv[20], wDuu[20], wDuv[20], wDvv[20];
+    int  decodedCVs[20];
+
+    for (int i = start; i < end; ++i) {
+        PatchCoord const &coord = patchCoords[i];
+        PatchArray const &array = patchArrays[coord.handle.arrayIndex];
+        PatchParam const &param = patchParamBuffer[coord.handle.patchIndex];
+
+        int patchType = param.IsRegular()
+            ? array.GetPatchTypeRegular()
+            : array.GetPatchTypeIrregular();
+
+        int nPoints = Far::internal::EvaluatePatchBasis<REAL>(
+            patchType, param, coord.s, coord.t, wP,
+            needDeriv1 ? wDu  : 0, needDeriv1 ? wDv  : 0,
+            needDeriv2 ? wDuu : 0, needDeriv2 ? wDuv : 0,
+            needDeriv2 ? wDvv : 0);
+
+        //  Control vertices are decoded from the compact table if given:
+        int const *cvs = decodedCVs;
+        if (patchVertices) {
+            patchVertices->GetPatchVertices(coord.handle, decodedCVs);
+        } else {
+            int indexBase = array.GetIndexBase() + array.GetStride() *
+                    (coord.handle.patchIndex - array.GetPrimitiveIdBase());
+
+            cvs = &patchIndexBuffer[indexBase];
+        }
+
+        applyWeights(dst,    i, dstDesc,    src, srcDesc, cvs, wP,   nPoints);
+        applyWeights(dstDu,  i, dstDuDesc,  src, srcDesc, cvs, wDu,  nPoints);
+        applyWeights(dstDv,  i, dstDvDesc,  src, srcDesc, cvs, wDv,  nPoints);
+        applyWeights(dstDuu, i, dstDuuDesc, src, srcDesc, cvs, wDuu, nPoints);
+        applyWeights(dstDuv, i, dstDuvDesc, src, srcDesc, cvs, wDuv, nPoints);
+        applyWeights(dstDvv, i, dstDvvDesc, src, srcDesc, cvs, wDvv, nPoints);
+    }
+}
+
+void
+CpuEvalPatches(float const * src, BufferDescriptor const &srcDesc,
+               float * dst,        BufferDescriptor const &dstDesc,
+               float * dstDu,      BufferDescriptor const &dstDuDesc,
+               float * dstDv,      BufferDescriptor const &dstDvDesc,
+               float * dstDuu,     BufferDescriptor const &dstDuuDesc,
+               float * dstDuv,     BufferDescriptor const &dstDuvDesc,
+               float * dstDvv,     BufferDescriptor const &dstDvvDesc,
+               int start, int end,
+               PatchCoord const * patchCoords,
+               PatchArray const * patchArrays,
+               int const * patchIndexBuffer,
+               PatchParam const * patchParamBuffer) {
+
+    evalPatches(src, srcDesc, dst, dstDesc,
+                dstDu, dstDuDesc, dstDv, dstDvDesc,
+                dstDuu, dstDuuDesc, dstDuv, dstDuvDesc, dstDvv, dstDvvDesc,
+                start, end, patchCoords, patchArrays,
+                patchIndexBuffer, 0, patchParamBuffer);
+}
+
+void
+CpuEvalPatches(double const * src, BufferDescriptor const &srcDesc,
+               double * dst,       BufferDescriptor const &dstDesc,
+               double * dstDu,     BufferDescriptor const &dstDuDesc,
+               double * dstDv,     BufferDescriptor const &dstDvDesc,
+               double * dstDuu,    BufferDescriptor const &dstDuuDesc,
+               double * dstDuv,    BufferDescriptor const &dstDuvDesc,
+               double * dstDvv,    BufferDescriptor const &dstDvvDesc,
+               int start, int end,
+               PatchCoord const * patchCoords,
+               PatchArray const * patchArrays,
+               int const * patchIndexBuffer,
+               PatchParam const * patchParamBuffer) {
+
+    evalPatches(src, srcDesc, dst, dstDesc,
+                dstDu, dstDuDesc, dstDv, dstDvDesc,
+                dstDuu, dstDuuDesc, dstDuv, dstDuvDesc, dstDvv, dstDvvDesc,
+                start, end, patchCoords, patchArrays,
+                patchIndexBuffer, 0, patchParamBuffer);
+}
+
+void
+CpuEvalPatchesCompact(float const * src, BufferDescriptor const &srcDesc,
+                      float * dst,        BufferDescriptor const &dstDesc,
+                      float * dstDu,      BufferDescriptor const &dstDuDesc,
+                      float * dstDv,      BufferDescriptor const &dstDvDesc,
+                      float * dstDuu,     BufferDescriptor const &dstDuuDesc,
+                      float * dstDuv,     BufferDescriptor const &dstDuvDesc,
+                      float * dstDvv,     BufferDescriptor const &dstDvvDesc,
+                      int start, int end,
+                      PatchCoord const * patchCoords,
+                      PatchArray const * patchArrays,
+                      Far::CompactPatchVertices const * patchVertices,
+                      PatchParam const * patchParamBuffer) {
+
+    evalPatches(src, srcDesc, dst, dstDesc,
+                dstDu, dstDuDesc, dstDv, dstDvDesc,
+                dstDuu, dstDuuDesc, dstDuv, dstDuvDesc, dstDvv, dstDvvDesc,
+                start, end, patchCoords, patchArrays,
+                0, patchVertices, patchParamBuffer);
+}
+
+// ---------------------------------------------------------------------------
+//
+//  Surface normals and tangent frames, computed from the derivatives of the
+//  first three primvar elements (e.g. positions) as they are accumulated,
+//  rather than from derivatives written to memory and read back again.
+//
+//  The normal is the normalized cross product of the first derivatives.
+//  Where it is degenerate (e.g. where the parameterization is singular at
+//  the corner of an irregular patch), the first derivatives are expanded
+//  to second order at a point displaced slightly towards the interior of
+//  the patch and the normal is taken from those.  The displacement is
+//  small enough for the result to be the limit of the normals approaching
+//  the location, while resolving derivatives that are parallel as well as
+//  those that vanish.
+//
+template <typename REAL>
+static inline void
+accumulateVec3(REAL v[3], REAL const * src, BufferDescriptor const &srcDesc,
+               int const * cvs, REAL const * weights, int numWeights) {
+
+    v[0] = v[1] = v[2] = 0;
+    for (int j = 0; j < numWeights; ++j) {
+        REAL const * s = elementAtIndex(src, cvs[j], srcDesc);
+        REAL w = weights[j];
+        v[0] += s[0] * w;
+        v[1] += s[1] * w;
+        v[2] += s[2] * w;
+    }
+}
+
+template <typename REAL>
+static inline void
+cross(REAL r[3], REAL const a[3], REAL const b[3]) {
+
+    r[0] = a[1] * b[2] - a[2] * b[1];
+    r[1] = a[2] * b[0] - a[0] * b[2];
+    r[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+template <typename REAL>
+static inline REAL
+length(REAL const v[3]) {
+
+    return std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+}
+
+template <typename REAL>
+static inline void
+scaleOrZero(REAL v[3], REAL len) {
+
+    REAL s = (len > 0) ? (1 / len) : 0;
+    v[0] *= s;
+    v[1] *= s;
+    v[2] *= s;
+}
+
+template <typename REAL>
+static inline void
+writeVec3(REAL * dst, int dstIndex, BufferDescriptor const &dstDesc,
+          REAL const v[3]) {
+
+    if (!dst) return;
+
+    dst = elementAtIndex(dst, dstIndex, dstDesc);
+    dst[0] = v[0];
+    dst[1] = v[1];
+    dst[2] = v[2];
+}
+
+//  Returns true if the normal of the first derivatives is degenerate, i.e.
+//  the derivatives are (nearly) parallel or one of them vanishes:
+template <typename REAL>
+static inline bool
+isNormalDegenerate(REAL const N[3], REAL const du[3], REAL const dv[3]) {
+
+    REAL const tolerance = 16 * std::numeric_limits<REAL>::epsilon();
+    return length(N) <= tolerance * length(du) * length(dv);
+}
+
+//  First derivatives at the displacement (ds, dt) from the location, from
+//  their expansion to second order
+template <typename REAL>
+static inline void
+displaceDerivatives(REAL du[3], REAL dv[3],
+                    REAL const duu[3], REAL const duv[3], REAL const dvv[3],
+                    REAL ds, REAL dt) {
+
+    for (int k = 0; k < 3; ++k) {
+        du[k] += ds * duu[k] + dt * duv[k];
+        dv[k] += ds * duv[k] + dt * dvv[k];
+    }
+}
+
+//  Fraction of the distance to the center of the patch by which degenerate
+//  normals are displaced (and displacement of stencils, whose locations are
+//  unknown, in the direction of increasing u and v):
+static double const DEGENERATE_NORMAL_DISPLACEMENT = 1.0e-3;
+
+//  Writes the normalized normal N and the orthonormal tangent frame derived
+//  from du, falling back on dv where du is degenerate:
+template <typename REAL>
+static inline void
+writeFrame(REAL N[3], REAL const du[3], REAL const dv[3], int dstIndex,
+           REAL * normal,    BufferDescriptor const &normalDesc,
+           REAL * tangent,   BufferDescriptor const &tangentDesc,
+           REAL * bitangent, BufferDescriptor const &bitangentDesc) {
+
+    scaleOrZero(N, length(N));
+    writeVec3(normal, dstIndex, normalDesc, N);
+
+    if (!tangent && !bitangent) return;
+
+    REAL d = du[0] * N[0] + du[1] * N[1] + du[2] * N[2];
+    REAL T[3] = { du[0] - d * N[0], du[1] - d * N[1], du[2] - d * N[2] };
+
+    REAL lenT = length(T);
+    if (lenT <= (REAL) 1.0e-6 * length(du) || lenT == 0) {
+        cross(T, dv, N);
+        lenT = length(T);
+    }
+    scaleOrZero(T, lenT);
+
+    REAL B[3];
+    cross(B, N, T);
+
+    writeVec3(tangent,   dstIndex, tangentDesc,   T);
+    writeVec3(bitangent, dstIndex, bitangentDesc, B);
+}
+
+//  Unnormalized normal and first derivatives at a patch coordinate, given
+//  the first derivative weights of the patch -- the second derivative
+//  weights are only evaluated where the normal is degenerate:
+template <typename REAL>
+static void
+evalPatchNormal(REAL N[3], REAL du[3], REAL dv[3],
+                REAL const * src, BufferDescriptor const &srcDesc,
+                int const * cvs, int nPoints,
+                int patchType, PatchParam const &param,
+                PatchCoord const &coord,
+                REAL const * wDu, REAL const * wDv) {
+
+    accumulateVec3(du, src, srcDesc, cvs, wDu, nPoints);
+    accumulateVec3(dv, src, srcDesc, cvs, wDv, nPoints);
+    cross(N, du, dv);
+
+    if (!isNormalDegenerate(N, du, dv)) return;
+
+    REAL wP[20], wD1[20], wD2[20], wDuu[20], wDuv[20], wDvv[20];
+    Far::internal::EvaluatePatchBasis<REAL>(
+        patchType, param, coord.s, coord.t,
+        wP, wD1, wD2, wDuu, wDuv, wDvv);
+
+    REAL duu[3], duv[3], dvv[3];
+    accumulateVec3(duu, src, srcDesc, cvs, wDuu, nPoints);
+    accumulateVec3(duv, src, srcDesc, cvs, wDuv, nPoints);
+    accumulateVec3(dvv, src, srcDesc, cvs, wDvv, nPoints);
+
+    //  Displace towards the center of the patch (in the same
+    //  parameterization as the derivatives):
+    bool isTriangle =
+        (patchType == Far::PatchDescriptor::LOOP) ||
+        (patchType == Far::PatchDescriptor::GREGORY_TRIANGLE) ||
+        (patchType == Far::PatchDescriptor::TRIANGLES);
+
+    REAL cs = isTriangle ? (REAL)(1.0 / 3.0) : (REAL) 0.5;
+    REAL ct = cs;
+    if (isTriangle) {
+        param.UnnormalizeTriangle(cs, ct);
+    } else {
+        param.Unnormalize(cs, ct);
+    }
+    REAL d = (REAL) DEGENERATE_NORMAL_DISPLACEMENT;
+
+    displaceDerivatives(du, dv, duu, duv, dvv,
+                        d * (cs - coord.s), d * (ct - coord.t));
+    cross(N, du, dv);
+}
+
+template <typename REAL> void
+CpuEvalPatchNormals(REAL const * src, BufferDescriptor const &srcDesc,
+                    REAL * dst,       BufferDescriptor const &dstDesc,
+                    REAL * normal,    BufferDescriptor const &normalDesc,
+                    REAL * tangent,   BufferDescriptor const &tangentDesc,
+                    REAL * bitangent, BufferDescriptor const &bitangentDesc,
+                    int start, int end,
+                    PatchCoord const * patchCoords,
+                    PatchArray const * patchArrays,
+                    int const * patchIndexBuffer,
+                    PatchParam const * patchParamBuffer) {
+
+    src += srcDesc.offset;
+    if (dst)       dst       += dstDesc.offset;
+    if (normal)    normal    += normalDesc.offset;
+    if (tangent)   tangent   += tangentDesc.offset;
+    if (bitangent) bitangent += bitangentDesc.offset;
+
+    REAL wP[20], wDu[20], wDv[20];
+
+    for (int i = start; i < end; ++i) {
+        PatchCoord const &coord = patchCoords[i];
+        PatchArray const &array = patchArrays[coord.handle.arrayIndex];
+        PatchParam const &param = patchParamBuffer[coord.handle.patchIndex];
+
+        int patchType = param.IsRegular()
+            ? array.GetPatchTypeRegular()
+            : array.GetPatchTypeIrregular();
+
+        int nPoints = Far::internal::EvaluatePatchBasis<REAL>(
+            patchType, param, coord.s, coord.t, wP, wDu, wDv, 0, 0, 0);
+
+        int indexBase = array.GetIndexBase() + array.GetStride() *
+                (coord.handle.patchIndex - array.GetPrimitiveIdBase());
+
+        int const *cvs = &patchIndexBuffer[indexBase];
+
+        applyWeights(dst, i, dstDesc, src, srcDesc, cvs, wP, nPoints);
+
+        REAL du[3], dv[3], N[3];
+        evalPatchNormal(N, du, dv, src, srcDesc, cvs, nPoints,
+                        patchType, param, coord, wDu, wDv);
+
+        writeFrame(N, du, dv, i, normal, normalDesc,
+                   tangent, tangentDesc, bitangent, bitangentDesc);
+    }
+}
+
+template <typename REAL> void
+CpuEvalStencilNormals(REAL const * src, BufferDescriptor const &srcDesc,
+                      REAL * dst,       BufferDescriptor const &dstDesc,
+                      REAL * normal,    BufferDescriptor const &normalDesc,
+                      REAL * tangent,   BufferDescriptor const &tangentDesc,
+                      REAL * bitangent, BufferDescriptor const &bitangentDesc,
+                      int const * sizes,
+                      int const * offsets,
+                      int const * indices,
+                      REAL const * weights,
+                      REAL const * duWeights,
+                      REAL const * dvWeights,
+                      REAL const * duuWeights,
+                      REAL const * duvWeights,
+                      REAL const * dvvWeights,
+                      int start, int end) {
+
+    src += srcDesc.offset;
+    if (dst)       dst       += dstDesc.offset;
+    if (normal)    normal    += normalDesc.offset;
+    if (tangent)   tangent   += tangentDesc.offset;
+    if (bitangent) bitangent += bitangentDesc.offset;
+
+    bool hasDeriv2 = duuWeights && duvWeights && dvvWeights;
+
+    //  Destinations are relative to the first stencil, as with the other
+    //  CPU stencil kernels:
+    for (int i = start; i < end; ++i) {
+        int const * cvs = indices + offsets[i];
+        int offset = offsets[i];
+        int size = sizes[i];
+
+        applyWeights(dst, i - start, dstDesc,
+                     src, srcDesc, cvs, weights + offset, size);
+
+        REAL du[3], dv[3], N[3];
+        accumulateVec3(du, src, srcDesc, cvs, duWeights + offset, size);
+        accumulateVec3(dv, src, srcDesc, cvs, dvWeights + offset, size);
+        cross(N, du, dv);
+
+        if (hasDeriv2 && isNormalDegenerate(N, du, dv)) {
+            REAL duu[3], duv[3], dvv[3];
+            accumulateVec3(duu, src, srcDesc, cvs, duuWeights + offset, size);
+            accumulateVec3(duv, src, srcDesc, cvs, duvWeights + offset, size);
+            accumulateVec3(dvv, src, srcDesc, cvs, dvvWeights + offset, size);
+
+            REAL d = (REAL) DEGENERATE_NORMAL_DISPLACEMENT;
+            displaceDerivatives(du, dv, duu, duv, dvv, d, d);
+            cross(N, du, dv);
+        }
+
+        writeFrame(N, du, dv, i - start, normal, normalDesc,
+                   tangent, tangentDesc, bitangent, bitangentDesc);
+    }
+}
+
+// ---------------------------------------------------------------------------
+//
+//  Packed output encodings
+//
+
+//  Conversion to IEEE half floats, rounding to nearest even
+static inline unsigned short
+floatToHalf(float value) {
+
+    unsigned int f;
+    memcpy(&f, &value, sizeof(f));
+
+    unsigned int sign = f & 0x80000000u;
+    f ^= sign;
+
+    unsigned short h;
+    if (f >= ((127u + 16u) << 23)) {
+        //  overflow to infinity (NaN remains NaN)
+        h = (f > (255u << 23)) ? 0x7e00 : 0x7c00;
+    } else if (f < (113u << 23)) {
+        //  subnormal or zero : the float addition aligns and rounds the
+        //  mantissa of the result to the bits of the half
+        unsigned int magicBits = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+        float magic, sum;
+        memcpy(&magic, &magicBits, sizeof(magic));
+        memcpy(&sum, &f, sizeof(sum));
+        sum += magic;
+        memcpy(&f, &sum, sizeof(f));
+        h = (unsigned short)(f - magicBits);
+    } else {
+        unsigned int mantissaOdd = (f >> 13) & 1;
+        f += ((unsigned int)(15 - 127) << 23) + 0xfff;
+        f += mantissaOdd;
+        h = (unsigned short)(f >> 13);
+    }
+    return (unsigned short)(h | (sign >> 16));
+}
+
+static inline short
+floatToSnorm16(float value) {
+
+    value = std::max(-1.0f, std::min(1.0f, value));
+    return (short)(value * 32767.0f + ((value >= 0.0f) ? 0.5f : -0.5f));
+}
+
+static inline unsigned short
+floatToUnorm16(float value) {
+
+    value = std::max(0.0f, std::min(1.0f, value));
+    return (unsigned short)(value * 65535.0f + 0.5f);
+}
+
+//  Octahedral mapping of a unit vector to [-1,1]^2
+static inline void
+octahedralEncode(float const v[3], short encoded[2]) {
+
+    float l1 = std::fabs(v[0]) + std::fabs(v[1]) + std::fabs(v[2]);
+    float x = (l1 > 0.0f) ? (v[0] / l1) : 0.0f;
+    float y = (l1 > 0.0f) ? (v[1] / l1) : 0.0f;
+
+    if (v[2] < 0.0f) {
+        float ox = (1.0f - std::fabs(y)) * ((x >= 0.0f) ? 1.0f : -1.0f);
+        float oy = (1.0f - std::fabs(x)) * ((y >= 0.0f) ? 1.0f : -1.0f);
+        x = ox;
+        y = oy;
+    }
+    encoded[0] = floatToSnorm16(x);
+    encoded[1] = floatToSnorm16(y);
+}
+
+//  Encodes the elements of v at the element index of a packed buffer (the
+//  destination is not assumed to be aligned):
+static void
+encodePacked(void * dst, int dstIndex, PackedBufferDescriptor const &desc,
+             float const * v) {
+
+    unsigned char * d = (unsigned char *)dst + desc.offset +
+                        (size_t)dstIndex * desc.stride;
+
+    int const length = desc.length;
+
+    switch (desc.format) {
+    case PackedBufferDescriptor::FORMAT_FLOAT: {
+            float e[PackedBufferDescriptor::MAX_LENGTH];
+            for (int i = 0; i < length; ++i) {
+                e[i] = (v[i] - desc.origin[i]) * desc.scale[i];
+            }
+            memcpy(d, e, length * sizeof(float));
+        } break;
+    case PackedBufferDescriptor::FORMAT_HALF: {
+            unsigned short e[PackedBufferDescriptor::MAX_LENGTH];
+            for (int i = 0; i < length; ++i) {
+                e[i] = floatToHalf((v[i] - desc.origin[i]) * desc.scale[i]);
+            }
+            memcpy(d, e, length * sizeof(unsigned short));
+        } break;
+    case PackedBufferDescriptor::FORMAT_SNORM16: {
+            short e[PackedBufferDescriptor::MAX_LENGTH];
+            for (int i = 0; i < length; ++i) {
+                e[i] = floatToSnorm16((v[i] - desc.origin[i]) * desc.scale[i]);
+            }
+            memcpy(d, e, length * sizeof(short));
+        } break;
+    case PackedBufferDescriptor::FORMAT_UNORM16: {
+            unsigned short e[PackedBufferDescriptor::MAX_LENGTH];
+            for (int i = 0; i < length; ++i) {
+                e[i] = floatToUnorm16((v[i] - desc.origin[i]) * desc.scale[i]);
+            }
+            memcpy(d, e, length * sizeof(unsigned short));
+        } break;
+    case PackedBufferDescriptor::FORMAT_OCT16: {
+            short e[2];
+            octahedralEncode(v, e);
+            memcpy(d, e, sizeof(e));
+        } break;
+    }
+}
+
+void
+CpuEvalStencilsPacked(float const * src, BufferDescriptor const &srcDesc,
+                      void * dst, PackedBufferDescriptor const &dstDesc,
+                      int const * sizes,
+                      int const * offsets,
+                      int const * indices,
+                      float const * weights,
+                      int start, int end) {
+
+    src += srcDesc.offset;
+
+    int const length = dstDesc.length;
+
+    for (int i = start; i < end; ++i) {
+        int const * cvs = indices + offsets[i];
+        float const * w = weights + offsets[i];
+
+        float result[PackedBufferDescriptor::MAX_LENGTH] = { 0, 0, 0, 0 };
+        for (int j = 0; j < sizes[i]; ++j) {
+            float const * s = elementAtIndex(src, cvs[j], srcDesc);
+            for (int k = 0; k < length; ++k) {
+                result[k] += s[k] * w[j];
+            }
+        }
+        encodePacked(dst, i - start, dstDesc, result);
+    }
+}
+
+void
+CpuEvalPatchesPacked(float const * src, BufferDescriptor const &srcDesc,
+                     void * dst, PackedBufferDescriptor const &dstDesc,
+                     void * normal, PackedBufferDescriptor const &normalDesc,
+                     int start, int end,
+                     PatchCoord const * patchCoords,
+                     PatchArray const * patchArrays,
+                     int const * patchIndexBuffer,
+                     PatchParam const * patchParamBuffer) {
+
+    src += srcDesc.offset;
+
+    float wP[20], wDu[20], wDv[20];
+
+    for (int i = start; i < end; ++i) {
+        PatchCoord const &coord = patchCoords[i];
+        PatchArray const &array = patchArrays[coord.handle.arrayIndex];
+        PatchParam const &param = patchParamBuffer[coord.handle.patchIndex];
+
+        int patchType = param.IsRegular()
+            ? array.GetPatchTypeRegular()
+            : array.GetPatchTypeIrregular();
+
+        int nPoints = Far::internal::EvaluatePatchBasis<float>(
+            patchType, param, coord.s, coord.t, wP,
+            normal ? wDu : 0, normal ? wDv : 0, 0, 0, 0);
+
+        int indexBase = array.GetIndexBase() + array.GetStride() *
+                (coord.handle.patchIndex - array.GetPrimitiveIdBase());
+
+        int const *cvs = &patchIndexBuffer[indexBase];
+
+        if (dst) {
+            float result[PackedBufferDescriptor::MAX_LENGTH] = { 0, 0, 0, 0 };
+            for (int j = 0; j < nPoints; ++j) {
+                float const * s = elementAtIndex(src, cvs[j], srcDesc);
+                for (int k = 0; k < dstDesc.length; ++k) {
+                    result[k] += s[k] * wP[j];
+                }
+            }
+            encodePacked(dst, i, dstDesc, result);
+        }
+        if (normal) {
+            float du[3], dv[3], N[3];
+            evalPatchNormal(N, du, dv, src, srcDesc, cvs, nPoints,
+                            patchType, param, coord, wDu, wDv);
+
+            scaleOrZero(N, length(N));
+            encodePacked(normal, i, normalDesc, N);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+void
+CpuPartitionStencils(GrainPolicy const &policy,
+                     int const * sizes,
+                     int const * offsets,
+                     int start, int end,
+                     std::vector<int> & ranges) {
+
+    ranges.clear();
+    ranges.push_back(start);
+
+    if (end <= start) {
+        ranges.push_back(end);
+        return;
+    }
+
+    // the offsets are the running sums of the stencil sizes, so that the
+    // cost of any range of stencils is known in constant time
+    int firstWeight = offsets[start];
+    int totalCost = offsets[end-1] + sizes[end-1] - firstWeight;
+
+    if (totalCost < policy.serialCost) {
+        ranges.push_back(end);
+        return;
+    }
+
+    if (policy.mode == GrainPolicy::GRAIN_FIXED) {
+        int grainSize = std::max(1, policy.grainSize);
+        for (int i = start + grainSize; i < end; i += grainSize) {
+            ranges.push_back(i);
+        }
+    } else {
+        int grainCost = std::max(1, policy.grainCost);
+        int numRanges = (totalCost + grainCost - 1) / grainCost;
+
+        for (int i = 1; i < numRanges; ++i) {
+            int targetWeight = firstWeight +
+                (int)(((long long)totalCost * i) / numRanges);
+
+            int split = (int)(std::lower_bound(offsets + ranges.back() + 1,
+                offsets + end, targetWeight) - offsets);
+            if (split >= end) break;
+
+            ranges.push_back(split);
+        }
+    }
+    ranges.push_back(end);
+}
+
+void
+CpuPartitionStencilSubset(GrainPolicy const &policy,
+                          int const * sizes,
+                          int const * stencilIndices,
+                          int start, int end,
+                          std::vector<int> & ranges) {
+
+    ranges.clear();
+    ranges.push_back(start);
+
+    // the stencils of a subset are not contiguous, so the cost of each is
+    // accumulated -- the subset is expected to be small relative to the
+    // table, and the cost of the partition is that of the subset
+    int totalCost = 0;
+    for (int i = start; i < end; ++i) {
+        totalCost += sizes[stencilIndices[i]];
+    }
+
+    if (totalCost >= policy.serialCost) {
+        if (policy.mode == GrainPolicy::GRAIN_FIXED) {
+            int grainSize = std::max(1, policy.grainSize);
+            for (int i = start + grainSize; i < end; i += grainSize) {
+                ranges.push_back(i);
+            }
+        } else {
+            int grainCost = std::max(1, policy.grainCost);
+            int cost = 0;
+            for (int i = start; i < end - 1; ++i) {
+                cost += sizes[stencilIndices[i]];
+                if (cost >= grainCost) {
+                    ranges.push_back(i + 1);
+                    cost = 0;
+                }
+            }
+        }
+    }
+    ranges.push_back(end);
+}
+
+// ---------------------------------------------------------------------------
+
+template <int NUM_ELEMS>
+static void
+evalStencilBlock(float const * src, BufferDescriptor const &srcDesc,
+                 float * dst,        BufferDescriptor const &dstDesc,
+                 int const * sizes, int const * indices, float const * weights,
+                 int numStencils, float * result) {
+
+    // the primvar length is a compile-time constant for the common cases
+    int const length = NUM_ELEMS ? NUM_ELEMS : srcDesc.length;
+
+    for (int i = 0; i < numStencils; ++i) {
+
+        for (int k = 0; k < length; ++k) {
+            result[k] = 0.0f;
+        }
+        for (int j = 0; j < sizes[i]; ++j, ++indices, ++weights) {
+            float const * s = src + (*indices) * srcDesc.stride;
+            float w = *weights;
+            for (int k = 0; k < length; ++k) {
+                result[k] += s[k] * w;
+            }
+        }
+
+        float * d = dst + i * dstDesc.stride;
+        for (int k = 0; k < length; ++k) {
+            d[k] = result[k];
+        }
+    }
+}
+
+void
+CpuEvalStencilsInstanced(float const * const * srcInstances,
+                         BufferDescriptor const &srcDesc,
+                         float * const * dstInstances,
+                         BufferDescriptor const &dstDesc,
+                         int instanceStart, int instanceEnd,
+                         int const * sizes,
+                         int const * offsets,
+                         int const * indices,
+                         float const * weights,
+                         int start, int end) {
+
+    float * result = (float*)alloca(srcDesc.length * sizeof(float));
+
+    for (int blockStart = start; blockStart < end;
+            blockStart += INSTANCED_STENCIL_BLOCK_SIZE) {
+
+        int numStencils =
+            std::min((int)INSTANCED_STENCIL_BLOCK_SIZE, end - blockStart);
+
+        int const * blockSizes = sizes + blockStart;
+        int const * blockIndices = indices + offsets[blockStart];
+        float const * blockWeights = weights + offsets[blockStart];
+
+        // the stencils of the block remain in cache across the instances
+        for (int i = instanceStart; i < instanceEnd; ++i) {
+
+            float const * src = srcInstances[i] + srcDesc.offset;
+            float * dst = elementAtIndex(dstInstances[i] + dstDesc.offset,
+                                         blockStart - start, dstDesc);
+
+            switch (srcDesc.length) {
+            case 3:
+                evalStencilBlock<3>(src, srcDesc, dst, dstDesc, blockSizes,
+                    blockIndices, blockWeights, numStencils, result);
+                break;
+            case 4:
+                evalStencilBlock<4>(src, srcDesc, dst, dstDesc, blockSizes,
+                    blockIndices, blockWeights, numStencils, result);
+                break;
+            default:
+                evalStencilBlock<0>(src, srcDesc, dst, dstDesc, blockSizes,
+                    blockIndices, blockWeights, numStencils, result);
+                break;
+            }
+        }
+    }
+}
+
+void
+CpuEvalPatchesInstanced(float const * const * srcInstances,
+                        BufferDescriptor const &srcDesc,
+                        float * const * dstInstances,
+                        BufferDescriptor const &dstDesc,
+                        float * const * dstDuInstances,
+                        BufferDescriptor const &dstDuDesc,
+                        float * const * dstDvInstances,
+                        BufferDescriptor const &dstDvDesc,
+                        int instanceStart, int instanceEnd,
+                        int start, int end,
+                        PatchCoord const * patchCoords,
+                        PatchArray const * patchArrays,
+                        int const * patchIndexBuffer,
+                        PatchParam const * patchParamBuffer) {
+
+    bool needDeriv1 = dstDuInstances || dstDvInstances;
+
+    // the basis of a block of patch coordinates is evaluated once and
+    // applied to all the instances in turn
+    int const blockSize = 32;
+
+    float wP[blockSize][20], wDu[blockSize][20], wDv[blockSize][20];
+    int const * cvs[blockSize];
+    int nPoints[blockSize];
+
+    for (int blockStart = start; blockStart < end; blockStart += blockSize) {
+
+        int numCoords = std::min(blockSize, end - blockStart);
+
+        for (int i = 0; i < numCoords; ++i) {
+            PatchCoord const &coord = patchCoords[blockStart + i];
+            PatchArray const &array = patchArrays[coord.handle.arrayIndex];
+            PatchParam const &param =
+                patchParamBuffer[coord.handle.patchIndex];
+
+            int patchType = param.IsRegular()
+                ? array.GetPatchTypeRegular()
+                : array.GetPatchTypeIrregular();
+
+            nPoints[i] = Far::internal::EvaluatePatchBasis<float>(
+                patchType, param, coord.s, coord.t, wP[i],
+                needDeriv1 ? wDu[i] : 0, needDeriv1 ? wDv[i] : 0, 0, 0, 0);
+
+            int indexBase = array.GetIndexBase() + array.GetStride() *
+                    (coord.handle.patchIndex - array.GetPrimitiveIdBase());
+
+            cvs[i] = &patchIndexBuffer[indexBase];
+        }
+
+        for (int j = instanceStart; j < instanceEnd; ++j) {
+            float const * src = srcInstances[j] + srcDesc.offset;
+
+            float * dst = dstInstances ?
+                dstInstances[j] + dstDesc.offset : 0;
+            float * dstDu = dstDuInstances ?
+                dstDuInstances[j] + dstDuDesc.offset : 0;
+            float * dstDv = dstDvInstances ?
+                dstDvInstances[j] + dstDvDesc.offset : 0;
+
+            for (int i = 0; i < numCoords; ++i) {
+                int index = blockStart + i;
+                applyWeights(dst, index, dstDesc,
+                             src, srcDesc, cvs[i], wP[i], nPoints[i]);
+                applyWeights(dstDu, index, dstDuDesc,
+                             src, srcDesc, cvs[i], wDu[i], nPoints[i]);
+                applyWeights(dstDv, index, dstDvDesc,
+                             src, srcDesc, cvs[i], wDv[i], nPoints[i]);
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+template <int NUM_ELEMS, typename REAL>
+static void
+evalStencilSubset(REAL const * src, BufferDescriptor const &srcDesc,
+                  REAL * dst,       BufferDescriptor const &dstDesc,
+                  int const * sizes,
+                  int const * offsets,
+                  int const * indices,
+                  REAL const * weights,
+                  int const * stencilIndices, int start, int end,
+                  REAL * result) {
+
+    // the primvar length is a compile-time constant for the common cases
+    int const length = NUM_ELEMS ? NUM_ELEMS : srcDesc.length;
+
+    for (int i = start; i < end; ++i) {
+        int stencil = stencilIndices[i];
+
+        int const * stencilControls = indices + offsets[stencil];
+        REAL const * stencilWeights = weights + offsets[stencil];
+
+        for (int k = 0; k < length; ++k) {
+            result[k] = 0;
+        }
+        for (int j = 0; j < sizes[stencil]; ++j) {
+            REAL const * s = src + stencilControls[j] * srcDesc.stride;
+            REAL w = stencilWeights[j];
+            for (int k = 0; k < length; ++k) {
+                result[k] += s[k] * w;
+            }
+        }
+
+        REAL * d = elementAtIndex(dst, stencil, dstDesc);
+        for (int k = 0; k < length; ++k) {
+            d[k] = result[k];
+        }
+    }
+}
+
+template <typename REAL> void
+CpuEvalStencilSubset(REAL const * src, BufferDescriptor const &srcDesc,
+                     REAL * dst,       BufferDescriptor const &dstDesc,
+                     int const * sizes,
+                     int const * offsets,
+                     int const * indices,
+                     REAL const * weights,
+                     int const * stencilIndices,
+                     int start, int end) {
+
+    REAL * result = (REAL*)alloca(srcDesc.length * sizeof(REAL));
+
+    src += srcDesc.offset;
+    dst += dstDesc.offset;
+
+    switch (srcDesc.length) {
+    case 3:
+        evalStencilSubset<3>(src, srcDesc, dst, dstDesc,
+            sizes, offsets, indices, weights,
+            stencilIndices, start, end, result);
+        break;
+    case 4:
+        evalStencilSubset<4>(src, srcDesc, dst, dstDesc,
+            sizes, offsets, indices, weights,
+            stencilIndices, start, end, result);
+        break;
+    default:
+        evalStencilSubset<0>(src, srcDesc, dst, dstDesc,
+            sizes, offsets, indices, weights,
+            stencilIndices, start, end, result);
+        break;
+    }
+}
+
+//
+//  Explicit instantiation for single and double precision:
+//
+template void
+CpuEvalStencils<float>(float const *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       int const *, int const *, int const *, float const *,
+                       int, int);
+
+template void
+CpuEvalStencils<float>(float const *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       int const *, int const *, int const *,
+                       float const *, float const *, float const *,
+                       int, int);
+
+template void
+CpuEvalStencils<float>(float const *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       int const *, int const *, int const *,
+                       float const *, float const *, float const *,
+                       float const *, float const *, float const *,
+                       int, int);
+
+template void
+CpuEvalStencils<double>(double const *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        int const *, int const *, int const *, double const *,
+                        int, int);
+
+template void
+CpuEvalStencils<double>(double const *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        int const *, int const *, int const *,
+                        double const *, double const *, double const *,
+                        int, int);
+
+template void
+CpuEvalStencils<double>(double const *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        int const *, int const *, int const *,
+                        double const *, double const *, double const *,
+                        double const *, double const *, double const *,
+                        int, int);
+
+template void
+CpuEvalStencilSubset<float>(float const *, BufferDescriptor const &,
+                            float *, BufferDescriptor const &,
+                            int const *, int const *, int const *,
+                            float const *, int const *, int, int);
+
+template void
+CpuEvalStencilSubset<double>(double const *, BufferDescriptor const &,
+                             double *, BufferDescriptor const &,
+                             int const *, int const *, int const *,
+                             double const *, int const *, int, int);
+
+template void
+CpuEvalPatchNormals<float>(float const *, BufferDescriptor const &,
+                           float *, BufferDescriptor const &,
+                           float *, BufferDescriptor const &,
+                           float *, BufferDescriptor const &,
+                           float *, BufferDescriptor const &,
+                           int, int, PatchCoord const *, PatchArray const *,
+                           int const *, PatchParam const *);
+
+template void
+CpuEvalPatchNormals<double>(double const *, BufferDescriptor const &,
+                            double *, BufferDescriptor const &,
+                            double *, BufferDescriptor const &,
+                            double *, BufferDescriptor const &,
+                            double *, BufferDescriptor const &,
+                            int, int, PatchCoord const *, PatchArray const *,
+                            int const *, PatchParam const *);
+
+template void
+CpuEvalStencilNormals<float>(float const *, BufferDescriptor const &,
+                             float *, BufferDescriptor const &,
+                             float *, BufferDescriptor const &,
+                             float *, BufferDescriptor const &,
+                             float *, BufferDescriptor const &,
+                             int const *, int const *, int const *,
+                             float const *, float const *, float const *,
+                             float const *, float const *, float const *,
+                             int, int);
+
+template void
+CpuEvalStencilNormals<double>(double const *, BufferDescriptor const &,
+                              double *, BufferDescriptor const &,
+                              double *, BufferDescriptor const &,
+                              double *, BufferDescriptor const &,
+                              double *, BufferDescriptor const &,
+                              int const *, int const *, int const *,
+                              double const *, double const *, double const *,
+                              double const *, double const *, double const *,
+                              int, int);
+
 }  // end namespace Osd
 
 }  // end namespace OPENSUBDIV_VERSION
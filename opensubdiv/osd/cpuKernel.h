@@ -27,55 +27,285 @@
 
 #include "../version.h"
 #include <cstring>
+#include <vector>
 
 namespace OpenSubdiv {
 namespace OPENSUBDIV_VERSION {
 
+namespace Far {
+    class CompactPatchVertices;
+}
+
 namespace Osd {
 
 struct BufferDescriptor;
+struct GrainPolicy;
+struct PatchArray;
+struct PatchCoord;
+struct PatchParam;
+struct PackedBufferDescriptor;
 
-void
-CpuEvalStencils(float const * src, BufferDescriptor const &srcDesc,
-                float * dst,       BufferDescriptor const &dstDesc,
+//
+// Stencil kernels, instantiated for float and double precision
+//
+
+template <typename REAL> void
+CpuEvalStencils(REAL const * src, BufferDescriptor const &srcDesc,
+                REAL * dst,       BufferDescriptor const &dstDesc,
                 int const * sizes,
                 int const * offsets,
                 int const * indices,
-                float const * weights,
+                REAL const * weights,
                 int start, int end);
 
-void
-CpuEvalStencils(float const * src, BufferDescriptor const &srcDesc,
-                float * dst,       BufferDescriptor const &dstDesc,
-                float * dstDu,     BufferDescriptor const &dstDuDesc,
-                float * dstDv,     BufferDescriptor const &dstDvDesc,
+template <typename REAL> void
+CpuEvalStencils(REAL const * src, BufferDescriptor const &srcDesc,
+                REAL * dst,       BufferDescriptor const &dstDesc,
+                REAL * dstDu,     BufferDescriptor const &dstDuDesc,
+                REAL * dstDv,     BufferDescriptor const &dstDvDesc,
                 int const * sizes,
                 int const * offsets,
                 int const * indices,
-                float const * weights,
-                float const * duWeights,
-                float const * dvWeights,
+                REAL const * weights,
+                REAL const * duWeights,
+                REAL const * dvWeights,
                 int start, int end);
 
-void
-CpuEvalStencils(float const * src, BufferDescriptor const &srcDesc,
-                float * dst,       BufferDescriptor const &dstDesc,
-                float * dstDu,     BufferDescriptor const &dstDuDesc,
-                float * dstDv,     BufferDescriptor const &dstDvDesc,
-                float * dstDuu,    BufferDescriptor const &dstDuuDesc,
-                float * dstDuv,    BufferDescriptor const &dstDuvDesc,
-                float * dstDvv,    BufferDescriptor const &dstDvvDesc,
+template <typename REAL> void
+CpuEvalStencils(REAL const * src, BufferDescriptor const &srcDesc,
+                REAL * dst,       BufferDescriptor const &dstDesc,
+                REAL * dstDu,     BufferDescriptor const &dstDuDesc,
+                REAL * dstDv,     BufferDescriptor const &dstDvDesc,
+                REAL * dstDuu,    BufferDescriptor const &dstDuuDesc,
+                REAL * dstDuv,    BufferDescriptor const &dstDuvDesc,
+                REAL * dstDvv,    BufferDescriptor const &dstDvvDesc,
                 int const * sizes,
                 int const * offsets,
                 int const * indices,
-                float const * weights,
-                float const * duWeights,
-                float const * dvWeights,
-                float const * duuWeights,
-                float const * duvWeights,
-                float const * dvvWeights,
+                REAL const * weights,
+                REAL const * duWeights,
+                REAL const * dvWeights,
+                REAL const * duuWeights,
+                REAL const * duvWeights,
+                REAL const * dvvWeights,
                 int start, int end);
 
+//
+// Evaluates the subset of stencils stencilIndices[start, end), writing
+// stencil i to element i of the destination (see Far::StencilDependencyMap)
+//
+// Note : this function is re-used in the parallel evaluators
+template <typename REAL> void
+CpuEvalStencilSubset(REAL const * src, BufferDescriptor const &srcDesc,
+                     REAL * dst,       BufferDescriptor const &dstDesc,
+                     int const * sizes,
+                     int const * offsets,
+                     int const * indices,
+                     REAL const * weights,
+                     int const * stencilIndices,
+                     int start, int end);
+
+//
+// Limit evaluation kernels over the patch coordinates [start, end) -- any
+// of the outputs may be NULL.
+//
+// Note : these functions are re-used in the parallel evaluators
+void
+CpuEvalPatches(float const * src, BufferDescriptor const &srcDesc,
+               float * dst,        BufferDescriptor const &dstDesc,
+               float * dstDu,      BufferDescriptor const &dstDuDesc,
+               float * dstDv,      BufferDescriptor const &dstDvDesc,
+               float * dstDuu,     BufferDescriptor const &dstDuuDesc,
+               float * dstDuv,     BufferDescriptor const &dstDuvDesc,
+               float * dstDvv,     BufferDescriptor const &dstDvvDesc,
+               int start, int end,
+               PatchCoord const * patchCoords,
+               PatchArray const * patchArrays,
+               int const * patchIndexBuffer,
+               PatchParam const * patchParamBuffer);
+
+void
+CpuEvalPatches(double const * src, BufferDescriptor const &srcDesc,
+               double * dst,       BufferDescriptor const &dstDesc,
+               double * dstDu,     BufferDescriptor const &dstDuDesc,
+               double * dstDv,     BufferDescriptor const &dstDvDesc,
+               double * dstDuu,    BufferDescriptor const &dstDuuDesc,
+               double * dstDuv,    BufferDescriptor const &dstDuvDesc,
+               double * dstDvv,    BufferDescriptor const &dstDvvDesc,
+               int start, int end,
+               PatchCoord const * patchCoords,
+               PatchArray const * patchArrays,
+               int const * patchIndexBuffer,
+               PatchParam const * patchParamBuffer);
+
+//
+// Limit evaluation decoding the patch control vertices from a compact table
+//
+void
+CpuEvalPatchesCompact(float const * src, BufferDescriptor const &srcDesc,
+                      float * dst,        BufferDescriptor const &dstDesc,
+                      float * dstDu,      BufferDescriptor const &dstDuDesc,
+                      float * dstDv,      BufferDescriptor const &dstDvDesc,
+                      float * dstDuu,     BufferDescriptor const &dstDuuDesc,
+                      float * dstDuv,     BufferDescriptor const &dstDuvDesc,
+                      float * dstDvv,     BufferDescriptor const &dstDvvDesc,
+                      int start, int end,
+                      PatchCoord const * patchCoords,
+                      PatchArray const * patchArrays,
+                      Far::CompactPatchVertices const * patchVertices,
+                      PatchParam const * patchParamBuffer);
+
+//
+// Normals and tangent frames of the limit surface, computed from the first
+// three elements of the source primvars, over the patch coordinates or the
+// limit stencils [start, end). The outputs may be NULL and the second
+// derivative weights of the stencils may be NULL.
+//
+// Note : these functions are re-used in the parallel evaluators
+template <typename REAL> void
+CpuEvalPatchNormals(REAL const * src, BufferDescriptor const &srcDesc,
+                    REAL * dst,       BufferDescriptor const &dstDesc,
+                    REAL * normal,    BufferDescriptor const &normalDesc,
+                    REAL * tangent,   BufferDescriptor const &tangentDesc,
+                    REAL * bitangent, BufferDescriptor const &bitangentDesc,
+                    int start, int end,
+                    PatchCoord const * patchCoords,
+                    PatchArray const * patchArrays,
+                    int const * patchIndexBuffer,
+                    PatchParam const * patchParamBuffer);
+
+template <typename REAL> void
+CpuEvalStencilNormals(REAL const * src, BufferDescriptor const &srcDesc,
+                      REAL * dst,       BufferDescriptor const &dstDesc,
+                      REAL * normal,    BufferDescriptor const &normalDesc,
+                      REAL * tangent,   BufferDescriptor const &tangentDesc,
+                      REAL * bitangent, BufferDescriptor const &bitangentDesc,
+                      int const * sizes,
+                      int const * offsets,
+                      int const * indices,
+                      REAL const * weights,
+                      REAL const * duWeights,
+                      REAL const * dvWeights,
+                      REAL const * duuWeights,
+                      REAL const * duvWeights,
+                      REAL const * dvvWeights,
+                      int start, int end);
+
+//
+// Packed output : the primvars of the stencils [start, end) or of the patch
+// coordinates [start, end) are encoded as they are evaluated, optionally
+// with the limit normals of the patches (see CpuEvalPatchNormals). Outputs
+// are indexed as with the kernels above and the normal may be NULL.
+//
+// Note : these functions are re-used in the parallel evaluators
+void
+CpuEvalStencilsPacked(float const * src, BufferDescriptor const &srcDesc,
+                      void * dst, PackedBufferDescriptor const &dstDesc,
+                      int const * sizes,
+                      int const * offsets,
+                      int const * indices,
+                      float const * weights,
+                      int start, int end);
+
+void
+CpuEvalPatchesPacked(float const * src, BufferDescriptor const &srcDesc,
+                     void * dst, PackedBufferDescriptor const &dstDesc,
+                     void * normal, PackedBufferDescriptor const &normalDesc,
+                     int start, int end,
+                     PatchCoord const * patchCoords,
+                     PatchArray const * patchArrays,
+                     int const * patchIndexBuffer,
+                     PatchParam const * patchParamBuffer);
+
+//
+// Splits the stencils [start, end) into ranges for parallel evaluation, as
+// described by the grain policy : range i is [ranges[i], ranges[i+1]). A
+// single range is returned when the evaluation should remain serial.
+//
+// Note : this function is re-used in the OpenMP and TBB kernels
+void
+CpuPartitionStencils(GrainPolicy const &policy,
+                     int const * sizes,
+                     int const * offsets,
+                     int start, int end,
+                     std::vector<int> & ranges);
+
+//
+// Splits the subset of stencils stencilIndices[start, end) into ranges of
+// the subset in the same way (see CpuEvalStencilSubset)
+//
+// Note : this function is re-used in the OpenMP, TBB and thread pool
+// evaluators
+void
+CpuPartitionStencilSubset(GrainPolicy const &policy,
+                          int const * sizes,
+                          int const * stencilIndices,
+                          int start, int end,
+                          std::vector<int> & ranges);
+
+//
+// Instanced kernels : the stencils [start, end) or the patch coordinates
+// [start, end) are applied to the instances [instanceStart, instanceEnd)
+// of a table of primvar buffers sharing the same topology. The buffer
+// descriptors apply to every instance. As with CpuEvalStencils(), stencil
+// start is written to the first destination element, while patch
+// coordinates are written at their own index.
+//
+// Note : these functions are re-used in the OpenMP and TBB evaluators
+void
+CpuEvalStencilsInstanced(float const * const * srcInstances,
+                         BufferDescriptor const &srcDesc,
+                         float * const * dstInstances,
+                         BufferDescriptor const &dstDesc,
+                         int instanceStart, int instanceEnd,
+                         int const * sizes,
+                         int const * offsets,
+                         int const * indices,
+                         float const * weights,
+                         int start, int end);
+
+// Derivative instance tables may be NULL
+void
+CpuEvalPatchesInstanced(float const * const * srcInstances,
+                        BufferDescriptor const &srcDesc,
+                        float * const * dstInstances,
+                        BufferDescriptor const &dstDesc,
+                        float * const * dstDuInstances,
+                        BufferDescriptor const &dstDuDesc,
+                        float * const * dstDvInstances,
+                        BufferDescriptor const &dstDvDesc,
+                        int instanceStart, int instanceEnd,
+                        int start, int end,
+                        PatchCoord const * patchCoords,
+                        PatchArray const * patchArrays,
+                        int const * patchIndexBuffer,
+                        PatchParam const * patchParamBuffer);
+
+// Number of stencils applied to every instance in turn : the weights and
+// indices of a block are streamed from memory once for all the instances
+enum { INSTANCED_STENCIL_BLOCK_SIZE = 256 };
+
+// Expands instances laid out contiguously with a constant stride (in
+// elements) into a table of instance pointers
+template <typename T> void
+CpuGetInstancePointers(T * base, int instanceStride, int numInstances,
+                       std::vector<T *> & pointers) {
+
+    pointers.resize(numInstances);
+    for (int i = 0; i < numInstances; ++i) {
+        pointers[i] = base ? base + (size_t)i * instanceStride : NULL;
+    }
+}
+
+// Returns the pointer to element index of an optional buffer (NULL if the
+// buffer is NULL), e.g. to evaluate a range of stencils into its part of
+// outputs indexed relative to the first stencil
+template <typename T> T *
+CpuGetElementPointer(T * base, int index, int stride) {
+
+    return base ? base + (size_t)index * stride : NULL;
+}
+
 //
 // SIMD ICC optimization of the stencil kernel
 //
@@ -87,20 +317,20 @@ CpuEvalStencils(float const * src, BufferDescriptor const &srcDesc,
 #endif
 
 // Note : this function is re-used in the TBB Compute kernel
-template <int numElems> void
-ComputeStencilKernel(float const * vertexSrc,
-                     float * vertexDst,
+template <int numElems, typename REAL> void
+ComputeStencilKernel(REAL const * vertexSrc,
+                     REAL * vertexDst,
                      int const * sizes,
                      int const * indices,
-                     float const * weights,
+                     REAL const * weights,
                      int start,
                      int end) {
 
-    __ALIGN_DATA float result[numElems],
+    __ALIGN_DATA REAL result[numElems],
                        result1[numElems];
 
-    float const * src;
-    float * dst, weight;
+    REAL const * src;
+    REAL * dst, weight;
 
     for (int i=start; i<end; ++i) {
 
@@ -110,7 +340,7 @@ ComputeStencilKernel(float const * vertexSrc,
     #pragma vector aligned
 #endif
         for (int k = 0; k<numElems; ++k)
-            result[k] = 0.0f;
+            result[k] = 0;
 
         for (int j=0; j<sizes[i]; ++j, ++indices, ++weights) {
 
@@ -136,7 +366,7 @@ ComputeStencilKernel(float const * vertexSrc,
         }
 
         dst = vertexDst + i*numElems;
-        memcpy(dst, result1, numElems*sizeof(float));
+        memcpy(dst, result1, numElems*sizeof(REAL));
     }
 }
 
@@ -0,0 +1,472 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#include "../osd/cpuUniformRefiner.h"
+#include "../far/topologyRefiner.h"
+#include "../far/primvarRefiner.h"
+
+#include <cassert>
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Osd {
+
+namespace {
+
+    //
+    //  Records the general stencils of a level from PrimvarRefiner.  Both
+    //  the parent and child vertices refer to the buffer of all levels and
+    //  child vertices computed by fixed-mask kernels are ignored:
+    //
+    class StencilRecorder {
+    public:
+        StencilRecorder(std::vector<int> & dstIndices,
+                        std::vector<int> & sizes,
+                        std::vector<int> & offsets,
+                        std::vector<int> & indices,
+                        std::vector<float> & weights,
+                        std::vector<bool> const & isFixed, int childOffset) :
+            _dstIndices(dstIndices), _sizes(sizes), _offsets(offsets),
+            _indices(indices), _weights(weights),
+            _isFixed(isFixed), _childOffset(childOffset), _recording(false) { }
+
+        void Begin(int dst) {
+            _recording = !_isFixed[dst - _childOffset];
+            if (_recording) {
+                _dstIndices.push_back(dst);
+                _sizes.push_back(0);
+                _offsets.push_back((int)_indices.size());
+            }
+        }
+
+        void Add(int src, float weight) {
+            if (_recording && weight != 0.0f) {
+                _indices.push_back(src);
+                _weights.push_back(weight);
+                ++_sizes.back();
+            }
+        }
+
+    private:
+        std::vector<int>   & _dstIndices;
+        std::vector<int>   & _sizes;
+        std::vector<int>   & _offsets;
+        std::vector<int>   & _indices;
+        std::vector<float> & _weights;
+
+        std::vector<bool> const & _isFixed;
+        int  _childOffset;
+        bool _recording;
+    };
+
+    class RecordedVertex {
+    public:
+        RecordedVertex(int index, StencilRecorder * recorder) :
+            _index(index), _recorder(recorder) { }
+
+        void Clear() { _recorder->Begin(_index); }
+
+        void AddWithWeight(RecordedVertex const & src, float weight) {
+            _recorder->Add(src._index, weight);
+        }
+
+    private:
+        int               _index;
+        StencilRecorder * _recorder;
+    };
+
+    class RecordedBuffer {
+    public:
+        RecordedBuffer(int offset, StencilRecorder * recorder) :
+            _offset(offset), _recorder(recorder) { }
+
+        RecordedVertex operator[](int index) const {
+            return RecordedVertex(_offset + index, _recorder);
+        }
+
+    private:
+        int               _offset;
+        StencilRecorder * _recorder;
+    };
+
+    //
+    //  Fixed-mask kernels -- each entry of the table holds the destination
+    //  index followed by the source indices.  The number of elements of
+    //  each primvar is given by NUM_ELEMS when known at compile time:
+    //
+    template <int NUM_ELEMS>
+    inline void
+    evalAverage4(std::vector<int> const & table,
+                 float * vertices, BufferDescriptor const & desc) {
+
+        int const length = NUM_ELEMS ? NUM_ELEMS : desc.length;
+
+        for (size_t i = 0; i < table.size(); i += 5) {
+            int const * idx = &table[i];
+            float       * dst = vertices + idx[0] * desc.stride;
+            float const * a   = vertices + idx[1] * desc.stride;
+            float const * b   = vertices + idx[2] * desc.stride;
+            float const * c   = vertices + idx[3] * desc.stride;
+            float const * d   = vertices + idx[4] * desc.stride;
+            for (int k = 0; k < length; ++k) {
+                dst[k] = 0.25f * ((a[k] + b[k]) + (c[k] + d[k]));
+            }
+        }
+    }
+
+    template <int NUM_ELEMS>
+    inline void
+    evalAverage2(std::vector<int> const & table,
+                 float * vertices, BufferDescriptor const & desc) {
+
+        int const length = NUM_ELEMS ? NUM_ELEMS : desc.length;
+
+        for (size_t i = 0; i < table.size(); i += 3) {
+            int const * idx = &table[i];
+            float       * dst = vertices + idx[0] * desc.stride;
+            float const * a   = vertices + idx[1] * desc.stride;
+            float const * b   = vertices + idx[2] * desc.stride;
+            for (int k = 0; k < length; ++k) {
+                dst[k] = 0.5f * (a[k] + b[k]);
+            }
+        }
+    }
+
+    template <int NUM_ELEMS>
+    inline void
+    evalSmoothValence4(std::vector<int> const & table,
+                       float * vertices, BufferDescriptor const & desc) {
+
+        int const length = NUM_ELEMS ? NUM_ELEMS : desc.length;
+
+        for (size_t i = 0; i < table.size(); i += 10) {
+            int const * idx = &table[i];
+            float       * dst = vertices + idx[0] * desc.stride;
+            float const * v   = vertices + idx[1] * desc.stride;
+            for (int k = 0; k < length; ++k) {
+                float sum = 0.0f;
+                for (int j = 2; j < 10; ++j) {
+                    sum += vertices[idx[j] * desc.stride + k];
+                }
+                dst[k] = 0.0625f * sum + 0.5f * v[k];
+            }
+        }
+    }
+
+    template <int NUM_ELEMS>
+    inline void
+    evalCopy(std::vector<int> const & table,
+             float * vertices, BufferDescriptor const & desc) {
+
+        int const length = NUM_ELEMS ? NUM_ELEMS : desc.length;
+
+        for (size_t i = 0; i < table.size(); i += 2) {
+            float       * dst = vertices + table[i]   * desc.stride;
+            float const * src = vertices + table[i+1] * desc.stride;
+            for (int k = 0; k < length; ++k) {
+                dst[k] = src[k];
+            }
+        }
+    }
+
+    template <int NUM_ELEMS>
+    inline void
+    evalStencils(int const * dstIndices, int const * sizes,
+                 int const * offsets, int const * indices,
+                 float const * weights, int start, int end,
+                 float * vertices, BufferDescriptor const & desc) {
+
+        int const length = NUM_ELEMS ? NUM_ELEMS : desc.length;
+
+        for (int i = start; i < end; ++i) {
+            float * dst = vertices + dstIndices[i] * desc.stride;
+            for (int k = 0; k < length; ++k) {
+                dst[k] = 0.0f;
+            }
+            int const   * index  = indices + offsets[i];
+            float const * weight = weights + offsets[i];
+            for (int j = 0; j < sizes[i]; ++j) {
+                float const * src = vertices + index[j] * desc.stride;
+                for (int k = 0; k < length; ++k) {
+                    dst[k] += weight[j] * src[k];
+                }
+            }
+        }
+    }
+} // end namespace
+
+CpuUniformRefiner *
+CpuUniformRefiner::Create(Far::TopologyRefiner const & refiner) {
+
+    if (!refiner.IsUniform()) return 0;
+
+    return new CpuUniformRefiner(refiner);
+}
+
+CpuUniformRefiner::CpuUniformRefiner(Far::TopologyRefiner const & refiner) {
+
+    typedef Far::ConstIndexArray ConstIndexArray;
+
+    int numLevels = refiner.GetNumLevels();
+
+    _levelOffsets.resize(numLevels + 1, 0);
+    for (int level = 0; level < numLevels; ++level) {
+        _levelOffsets[level + 1] = _levelOffsets[level] +
+            refiner.GetLevel(level).GetNumVertices();
+    }
+
+    _levels.resize(numLevels - 1);
+
+    Sdc::SchemeType scheme = refiner.GetSchemeType();
+    bool isBilinear = (scheme == Sdc::SCHEME_BILINEAR);
+    bool isCatmark  = (scheme == Sdc::SCHEME_CATMARK);
+
+    //  Faces have no child vertices when splitting to triangles:
+    bool hasFaceChildVertices = (Sdc::SchemeTypeTraits::GetTopologicalSplitType(
+                                    scheme) == Sdc::SPLIT_TO_QUADS);
+
+    Far::PrimvarRefiner primvarRefiner(refiner);
+
+    std::vector<bool> isFixed;
+
+    for (int level = 1; level < numLevels; ++level) {
+
+        Far::TopologyLevel const & parent = refiner.GetLevel(level - 1);
+        Far::TopologyLevel const & child  = refiner.GetLevel(level);
+
+        int pOffset = _levelOffsets[level - 1];
+        int cOffset = _levelOffsets[level];
+
+        LevelTables & tables = _levels[level - 1];
+
+        isFixed.assign(child.GetNumVertices(), false);
+
+        //  Face points of quads:
+        int numFaces = hasFaceChildVertices ? parent.GetNumFaces() : 0;
+        for (int face = 0; face < numFaces; ++face) {
+            Far::Index cVert = parent.GetFaceChildVertex(face);
+            if (!Far::IndexIsValid(cVert)) continue;
+
+            ConstIndexArray fVerts = parent.GetFaceVertices(face);
+            if (fVerts.size() != 4) continue;
+
+            tables.quadFacePoints.push_back(cOffset + cVert);
+            for (int i = 0; i < 4; ++i) {
+                tables.quadFacePoints.push_back(pOffset + fVerts[i]);
+            }
+            isFixed[cVert] = true;
+        }
+
+        //  Edge points of smooth Catmark edges between quads and of creases:
+        for (int edge = 0; edge < parent.GetNumEdges(); ++edge) {
+            Far::Index cVert = parent.GetEdgeChildVertex(edge);
+            if (!Far::IndexIsValid(cVert)) continue;
+
+            ConstIndexArray eVerts = parent.GetEdgeVertices(edge);
+
+            bool isCrease = isBilinear ||
+                ((parent.GetEdgeSharpness(edge) > 0.0f) &&
+                 (child.GetVertexRule(cVert) == Sdc::Crease::RULE_CREASE));
+            if (isCrease) {
+                tables.creaseEdgePoints.push_back(cOffset + cVert);
+                tables.creaseEdgePoints.push_back(pOffset + eVerts[0]);
+                tables.creaseEdgePoints.push_back(pOffset + eVerts[1]);
+                isFixed[cVert] = true;
+                continue;
+            }
+
+            if (!isCatmark || (parent.GetEdgeSharpness(edge) > 0.0f)) continue;
+
+            ConstIndexArray eFaces = parent.GetEdgeFaces(edge);
+            if ((eFaces.size() != 2) ||
+                (parent.GetFaceVertices(eFaces[0]).size() != 4) ||
+                (parent.GetFaceVertices(eFaces[1]).size() != 4)) continue;
+
+            Far::Index cVert0 = parent.GetFaceChildVertex(eFaces[0]);
+            Far::Index cVert1 = parent.GetFaceChildVertex(eFaces[1]);
+            if (!Far::IndexIsValid(cVert0) || !Far::IndexIsValid(cVert1)) continue;
+
+            tables.smoothEdgePoints.push_back(cOffset + cVert);
+            tables.smoothEdgePoints.push_back(pOffset + eVerts[0]);
+            tables.smoothEdgePoints.push_back(pOffset + eVerts[1]);
+            tables.smoothEdgePoints.push_back(cOffset + cVert0);
+            tables.smoothEdgePoints.push_back(cOffset + cVert1);
+            isFixed[cVert] = true;
+        }
+
+        //  Vertex points of corners and of smooth regular Catmark vertices:
+        for (int vert = 0; vert < parent.GetNumVertices(); ++vert) {
+            Far::Index cVert = parent.GetVertexChildVertex(vert);
+            if (!Far::IndexIsValid(cVert)) continue;
+
+            Sdc::Crease::Rule pRule = parent.GetVertexRule(vert);
+            Sdc::Crease::Rule cRule = child.GetVertexRule(cVert);
+
+            if (isBilinear || ((pRule == Sdc::Crease::RULE_CORNER) &&
+                               (cRule == Sdc::Crease::RULE_CORNER))) {
+                tables.cornerVertexPoints.push_back(cOffset + cVert);
+                tables.cornerVertexPoints.push_back(pOffset + vert);
+                isFixed[cVert] = true;
+                continue;
+            }
+
+            if (!isCatmark ||
+                (pRule != Sdc::Crease::RULE_SMOOTH) ||
+                (cRule != Sdc::Crease::RULE_SMOOTH) ||
+                parent.IsVertexBoundary(vert) ||
+                parent.IsVertexNonManifold(vert)) continue;
+
+            ConstIndexArray vEdges = parent.GetVertexEdges(vert);
+            ConstIndexArray vFaces = parent.GetVertexFaces(vert);
+            if ((vEdges.size() != 4) || (vFaces.size() != 4)) continue;
+
+            int entry = (int)tables.smoothVertexPoints.size();
+            tables.smoothVertexPoints.push_back(cOffset + cVert);
+            tables.smoothVertexPoints.push_back(pOffset + vert);
+            for (int i = 0; i < 4; ++i) {
+                ConstIndexArray eVerts = parent.GetEdgeVertices(vEdges[i]);
+                tables.smoothVertexPoints.push_back(pOffset +
+                    ((eVerts[0] == vert) ? eVerts[1] : eVerts[0]));
+            }
+            bool hasFacePoints = true;
+            for (int i = 0; i < 4; ++i) {
+                Far::Index cVertOfFace = parent.GetFaceChildVertex(vFaces[i]);
+                hasFacePoints &= Far::IndexIsValid(cVertOfFace);
+                tables.smoothVertexPoints.push_back(cOffset + cVertOfFace);
+            }
+            if (hasFacePoints) {
+                isFixed[cVert] = true;
+            } else {
+                tables.smoothVertexPoints.resize(entry);
+            }
+        }
+
+        //  Stencils for all remaining vertices -- PrimvarRefiner computes
+        //  the child vertices of faces, edges and vertices in that order:
+        StencilRecorder recorder(tables.dstIndices, tables.sizes,
+            tables.offsets, tables.indices, tables.weights, isFixed, cOffset);
+
+        RecordedBuffer src(pOffset, &recorder);
+        RecordedBuffer dst(cOffset, &recorder);
+        primvarRefiner.Interpolate(level, src, dst);
+
+        tables.numFaceStencils = 0;
+        tables.numEdgeStencils = 0;
+        for (int face = 0; face < numFaces; ++face) {
+            Far::Index cVert = parent.GetFaceChildVertex(face);
+            tables.numFaceStencils +=
+                Far::IndexIsValid(cVert) && !isFixed[cVert];
+        }
+        for (int edge = 0; edge < parent.GetNumEdges(); ++edge) {
+            Far::Index cVert = parent.GetEdgeChildVertex(edge);
+            tables.numEdgeStencils +=
+                Far::IndexIsValid(cVert) && !isFixed[cVert];
+        }
+        assert(tables.numFaceStencils + tables.numEdgeStencils <=
+               (int)tables.sizes.size());
+    }
+}
+
+bool
+CpuUniformRefiner::Refine(float * vertices, BufferDescriptor const & desc,
+                          int startLevel, int endLevel) const {
+
+    if (endLevel < 0) endLevel = GetNumRefinementLevels();
+
+    if ((startLevel < 1) || (endLevel > GetNumRefinementLevels())) return false;
+
+    vertices += desc.offset;
+
+    for (int level = startLevel; level <= endLevel; ++level) {
+        LevelTables const & tables = _levels[level - 1];
+
+        switch (desc.length) {
+        case 3:  refineLevel<3>(tables, vertices, desc); break;
+        case 4:  refineLevel<4>(tables, vertices, desc); break;
+        default: refineLevel<0>(tables, vertices, desc); break;
+        }
+    }
+    return true;
+}
+
+template <int NUM_ELEMS>
+void
+CpuUniformRefiner::refineLevel(LevelTables const & tables,
+                               float * vertices,
+                               BufferDescriptor const & desc) const {
+
+    int numStencils = (int)tables.sizes.size();
+
+    int   const * dstIndices = numStencils ? &tables.dstIndices[0] : 0;
+    int   const * sizes      = numStencils ? &tables.sizes[0] : 0;
+    int   const * offsets    = numStencils ? &tables.offsets[0] : 0;
+    int   const * indices    = tables.indices.empty() ? 0 : &tables.indices[0];
+    float const * weights    = tables.weights.empty() ? 0 : &tables.weights[0];
+
+    int edgeStart = tables.numFaceStencils;
+    int vertStart = tables.numFaceStencils + tables.numEdgeStencils;
+
+    //  Face points:
+    evalAverage4<NUM_ELEMS>(tables.quadFacePoints, vertices, desc);
+    evalStencils<NUM_ELEMS>(dstIndices, sizes, offsets, indices, weights,
+                 0, edgeStart, vertices, desc);
+
+    //  Edge points (depending on face points):
+    evalAverage4<NUM_ELEMS>(tables.smoothEdgePoints, vertices, desc);
+    evalAverage2<NUM_ELEMS>(tables.creaseEdgePoints, vertices, desc);
+    evalStencils<NUM_ELEMS>(dstIndices, sizes, offsets, indices, weights,
+                 edgeStart, vertStart, vertices, desc);
+
+    //  Vertex points (depending on face points):
+    evalSmoothValence4<NUM_ELEMS>(tables.smoothVertexPoints, vertices, desc);
+    evalCopy<NUM_ELEMS>(tables.cornerVertexPoints, vertices, desc);
+    evalStencils<NUM_ELEMS>(dstIndices, sizes, offsets, indices, weights,
+                 vertStart, numStencils, vertices, desc);
+}
+
+size_t
+CpuUniformRefiner::LevelTables::GetByteSize() const {
+
+    return sizeof(int) * (quadFacePoints.size() + smoothEdgePoints.size() +
+                          creaseEdgePoints.size() + smoothVertexPoints.size() +
+                          cornerVertexPoints.size() + dstIndices.size() +
+                          sizes.size() + offsets.size() + indices.size()) +
+           sizeof(float) * weights.size();
+}
+
+size_t
+CpuUniformRefiner::GetByteSize() const {
+
+    size_t size = sizeof(int) * _levelOffsets.size();
+    for (size_t i = 0; i < _levels.size(); ++i) {
+        size += _levels[i].GetByteSize();
+    }
+    return size;
+}
+
+}  // end namespace Osd
+
+}  // end namespace OPENSUBDIV_VERSION
+}  // end namespace OpenSubdiv
@@ -0,0 +1,160 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#ifndef OPENSUBDIV3_OSD_CPU_UNIFORM_REFINER_H
+#define OPENSUBDIV3_OSD_CPU_UNIFORM_REFINER_H
+
+#include "../version.h"
+#include "../osd/bufferDescriptor.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Far {
+    class TopologyRefiner;
+}
+
+namespace Osd {
+
+/// \brief Uniform refinement of vertex primvar data without stencil tables
+///
+/// CpuUniformRefiner applies the subdivision rules level by level, in the
+/// same way as Far::PrimvarRefiner, but from compact per-level tables that
+/// are built once from a uniformly refined Far::TopologyRefiner.
+///
+/// Vertices of regular regions are computed with fixed-mask kernels that
+/// only store the indices of their parent components:
+///
+///   - face points of quads
+///   - edge points of smooth interior Catmark edges between quads
+///   - vertex points of smooth interior Catmark vertices of valence 4
+///   - edge points of creases and vertex points of corners
+///
+/// All other vertices are computed from small stencils relative to the
+/// previous level. Unlike a factorized Far::StencilTable, the size of the
+/// tables grows linearly with the number of refined vertices.
+///
+/// The primvar buffer holds the vertices of all levels consecutively,
+/// i.e. the control vertices followed by the vertices of each refined
+/// level, as with Far::StencilTable with intermediate levels.
+///
+class CpuUniformRefiner {
+public:
+    /// \brief Returns a new refiner for the uniformly refined \p refiner,
+    ///        or NULL if \p refiner is not uniformly refined.
+    static CpuUniformRefiner * Create(Far::TopologyRefiner const & refiner);
+
+    /// \brief Destructor
+    ~CpuUniformRefiner() { }
+
+    /// \brief Returns the number of levels of refinement
+    int GetNumRefinementLevels() const { return (int)_levels.size(); }
+
+    /// \brief Returns the number of vertices of all levels
+    int GetNumVerticesTotal() const { return _levelOffsets.back(); }
+
+    /// \brief Returns the number of vertices of \p level
+    int GetNumVertices(int level) const {
+        return _levelOffsets[level + 1] - _levelOffsets[level];
+    }
+
+    /// \brief Returns the offset of the first vertex of \p level
+    int GetLevelVertexOffset(int level) const { return _levelOffsets[level]; }
+
+    /// \brief Refines the vertices of levels \p startLevel to \p endLevel
+    ///        (inclusive) from those of the preceding levels.
+    ///
+    /// @param vertices    Primvar pointer holding the vertices of all levels.
+    ///                    An offset of desc will be applied internally.
+    ///
+    /// @param desc        vertex buffer descriptor for the primvar buffer
+    ///
+    /// @param startLevel  first level to refine
+    ///
+    /// @param endLevel    last level to refine, or -1 for the last level
+    ///
+    bool Refine(float * vertices, BufferDescriptor const & desc,
+                int startLevel = 1, int endLevel = -1) const;
+
+    /// \brief Generic refinement function for vertex buffers that have a
+    ///        BindCpuBuffer() method returning a float pointer for write
+    template <typename VERTEX_BUFFER>
+    bool Refine(VERTEX_BUFFER * vertexBuffer, BufferDescriptor const & desc,
+                int startLevel = 1, int endLevel = -1) const {
+        return Refine(vertexBuffer->BindCpuBuffer(), desc,
+                      startLevel, endLevel);
+    }
+
+    /// \brief Returns the memory used by the tables (in bytes)
+    size_t GetByteSize() const;
+
+protected:
+    explicit CpuUniformRefiner(Far::TopologyRefiner const & refiner);
+
+private:
+    //
+    //  Tables to refine the vertices of a level from the previous one --
+    //  all indices refer to the buffer of all levels and fixed-mask
+    //  kernels store the destination index first:
+    //
+    struct LevelTables {
+        std::vector<int> quadFacePoints;     // dst, 4 face vertices
+        std::vector<int> smoothEdgePoints;   // dst, 2 edge vertices, 2 face points
+        std::vector<int> creaseEdgePoints;   // dst, 2 edge vertices
+        std::vector<int> smoothVertexPoints; // dst, vertex, 4 edge ends, 4 face points
+        std::vector<int> cornerVertexPoints; // dst, vertex
+
+        //  Stencils of the remaining vertices, ordered by the type of their
+        //  parent component (faces, edges, then vertices):
+        int numFaceStencils;
+        int numEdgeStencils;
+
+        std::vector<int>   dstIndices;
+        std::vector<int>   sizes;
+        std::vector<int>   offsets;
+        std::vector<int>   indices;
+        std::vector<float> weights;
+
+        size_t GetByteSize() const;
+    };
+
+    template <int NUM_ELEMS>
+    void refineLevel(LevelTables const & tables,
+                     float * vertices, BufferDescriptor const & desc) const;
+
+    std::vector<int>         _levelOffsets;
+    std::vector<LevelTables> _levels;
+};
+
+}  // end namespace Osd
+
+}  // end namespace OPENSUBDIV_VERSION
+using namespace OPENSUBDIV_VERSION;
+
+}  // end namespace OpenSubdiv
+
+#endif  // OPENSUBDIV3_OSD_CPU_UNIFORM_REFINER_H
@@ -31,52 +31,74 @@ namespace OPENSUBDIV_VERSION {
 
 namespace Osd {
 
-CpuVertexBuffer::CpuVertexBuffer(int numElements, int numVertices)
+template <typename REAL>
+CpuVertexBufferReal<REAL>::CpuVertexBufferReal(int numElements,
+                                               int numVertices)
     : _numElements(numElements),
       _numVertices(numVertices),
       _cpuBuffer(NULL) {
 
-    _cpuBuffer = new float[numElements * numVertices];
+    _cpuBuffer = new REAL[numElements * numVertices];
 }
 
-CpuVertexBuffer::~CpuVertexBuffer() {
+template <typename REAL>
+CpuVertexBufferReal<REAL>::~CpuVertexBufferReal() {
 
     delete[] _cpuBuffer;
 }
 
-CpuVertexBuffer *
-CpuVertexBuffer::Create(int numElements, int numVertices,
-                        void * /*deviceContext*/) {
+template <typename REAL>
+CpuVertexBufferReal<REAL> *
+CpuVertexBufferReal<REAL>::Create(int numElements, int numVertices,
+                                  void * /*deviceContext*/) {
 
-    return new CpuVertexBuffer(numElements, numVertices);
+    return new CpuVertexBufferReal<REAL>(numElements, numVertices);
 }
 
+template <typename REAL>
 void
-CpuVertexBuffer::UpdateData(const float *src, int startVertex, int numVertices,
-                            void * /*deviceContext*/) {
+CpuVertexBufferReal<REAL>::UpdateData(const REAL *src,
+                                      int startVertex, int numVertices,
+                                      void * /*deviceContext*/) {
 
     memcpy(_cpuBuffer + startVertex * _numElements,
-           src, GetNumElements() * numVertices * sizeof(float));
+           src, GetNumElements() * numVertices * sizeof(REAL));
 }
 
+template <typename REAL>
 int
-CpuVertexBuffer::GetNumElements() const {
+CpuVertexBufferReal<REAL>::GetNumElements() const {
 
     return _numElements;
 }
 
+template <typename REAL>
 int
-CpuVertexBuffer::GetNumVertices() const {
+CpuVertexBufferReal<REAL>::GetNumVertices() const {
 
     return _numVertices;
 }
 
-float*
-CpuVertexBuffer::BindCpuBuffer() {
+template <typename REAL>
+REAL*
+CpuVertexBufferReal<REAL>::BindCpuBuffer() {
 
     return _cpuBuffer;
 }
 
+CpuVertexBuffer *
+CpuVertexBuffer::Create(int numElements, int numVertices,
+                        void * /*deviceContext*/) {
+
+    return new CpuVertexBuffer(numElements, numVertices);
+}
+
+//
+//  Explicit instantiation for single and double precision:
+//
+template class CpuVertexBufferReal<float>;
+template class CpuVertexBufferReal<double>;
+
 }  // end namespace Osd
 
 }  // end namespace OPENSUBDIV_VERSION
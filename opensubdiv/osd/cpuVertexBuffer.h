@@ -34,23 +34,27 @@ namespace OPENSUBDIV_VERSION {
 
 namespace Osd {
 
-/// \brief Concrete vertex buffer class for CPU subdivision.
+/// \brief Concrete vertex buffer class for CPU subdivision, templated on
+///        the precision of its primvar data.
 ///
-/// CpuVertexBuffer implements the VertexBufferInterface. An instance
-/// of this buffer class can be passed to CpuEvaluator
+/// CpuVertexBufferReal implements the VertexBufferInterface. An instance
+/// of this buffer class can be passed to CpuEvaluator (as well as the
+/// OpenMP and TBB evaluators), which provide both single and double
+/// precision kernels.
 ///
-class CpuVertexBuffer {
+template <typename REAL>
+class CpuVertexBufferReal {
 public:
     /// Creator. Returns NULL if error.
-    static CpuVertexBuffer * Create(int numElements, int numVertices,
-                                    void *deviceContext = NULL);
+    static CpuVertexBufferReal * Create(int numElements, int numVertices,
+                                        void *deviceContext = NULL);
 
     /// Destructor.
-    ~CpuVertexBuffer();
+    virtual ~CpuVertexBufferReal();
 
     /// This method is meant to be used in client code in order to provide
     /// coarse vertices data to Osd.
-    void UpdateData(const float *src, int startVertex, int numVertices,
+    void UpdateData(const REAL *src, int startVertex, int numVertices,
                     void *deviceContext = NULL);
 
     /// Returns how many elements defined in this vertex buffer.
@@ -60,16 +64,33 @@ public:
     int GetNumVertices() const;
 
     /// Returns the address of CPU buffer
-    float * BindCpuBuffer();
+    REAL * BindCpuBuffer();
 
 protected:
     /// Constructor.
-    CpuVertexBuffer(int numElements, int numVertices);
+    CpuVertexBufferReal(int numElements, int numVertices);
 
 private:
     int _numElements;
     int _numVertices;
-    float *_cpuBuffer;
+    REAL *_cpuBuffer;
+};
+
+/// \brief Concrete vertex buffer class for CPU subdivision.
+///
+/// CpuVertexBuffer implements the VertexBufferInterface. An instance
+/// of this buffer class can be passed to CpuEvaluator
+///
+class CpuVertexBuffer : public CpuVertexBufferReal<float> {
+public:
+    /// Creator. Returns NULL if error.
+    static CpuVertexBuffer * Create(int numElements, int numVertices,
+                                    void *deviceContext = NULL);
+
+protected:
+    /// Constructor.
+    CpuVertexBuffer(int numElements, int numVertices) :
+        CpuVertexBufferReal<float>(numElements, numVertices) { }
 };
 
 
@@ -0,0 +1,84 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#ifndef OPENSUBDIV3_OSD_GRAIN_POLICY_H
+#define OPENSUBDIV3_OSD_GRAIN_POLICY_H
+
+#include "../version.h"
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Osd {
+
+/// \brief GrainPolicy describes how the multi-threaded CPU evaluators
+///        (OmpEvaluator, TbbEvaluator, ThreadPoolEvaluator) split stencil
+///        evaluation into tasks.
+///
+///        The policy is passed to each evaluation: the raw pointer stencil
+///        functions take it as their last argument, and the generic ones
+///        use the policy of the evaluator instance they are given, so that
+///        concurrent clients never share a policy.
+///
+///        The cost of a stencil is its number of weights, which varies from
+///        a handful for regular vertices to several hundreds for vertices of
+///        high valence or end cap points. With GRAIN_BALANCED, the stencils
+///        are split into ranges of similar cost rather than into ranges of
+///        the same number of stencils.
+///
+///        Evaluations whose total cost is below serialCost are not worth
+///        the overhead of the threading runtime and run on the calling
+///        thread.
+///
+struct GrainPolicy {
+
+    enum Mode {
+        GRAIN_FIXED,     ///< tasks of grainSize stencils
+        GRAIN_BALANCED   ///< tasks of about grainCost stencil weights
+    };
+
+    /// Default Constructor
+    GrainPolicy() :
+        mode(GRAIN_BALANCED), grainSize(200), grainCost(4096),
+        serialCost(16384) { }
+
+    /// Constructor
+    GrainPolicy(Mode m, int size, int cost, int serial) :
+        mode(m), grainSize(size), grainCost(cost), serialCost(serial) { }
+
+    Mode mode;
+
+    int grainSize;   ///< number of stencils per task (GRAIN_FIXED)
+    int grainCost;   ///< number of weights per task (GRAIN_BALANCED)
+    int serialCost;  ///< minimum number of weights to evaluate in parallel
+};
+
+}  // end namespace Osd
+
+}  // end namespace OPENSUBDIV_VERSION
+using namespace OPENSUBDIV_VERSION;
+
+}  // end namespace OpenSubdiv
+
+#endif  // OPENSUBDIV3_OSD_GRAIN_POLICY_H
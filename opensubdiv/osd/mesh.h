@@ -32,12 +32,14 @@
 #include <cstring>
 #include <vector>
 
+#include "../far/error.h"
 #include "../far/topologyRefiner.h"
 #include "../far/patchTableFactory.h"
 #include "../far/stencilTable.h"
 #include "../far/stencilTableFactory.h"
 
 #include "../osd/bufferDescriptor.h"
+#include "../osd/threadPool.h"
 
 struct ID3D11DeviceContext;
 
@@ -58,7 +60,8 @@ enum MeshBits {
     MeshEndCapBSplineBasis   = 8,  // exclusive
     MeshEndCapGregoryBasis   = 9,  // exclusive
     MeshEndCapLegacyGregory  = 10, // exclusive
-    NUM_MESH_BITS            = 11,
+    MeshAsyncRefine          = 11,
+    NUM_MESH_BITS            = 12,
 };
 typedef std::bitset<NUM_MESH_BITS> MeshBitset;
 
@@ -408,8 +411,61 @@ static EVALUATOR *GetEvaluator(
     return NULL;
 }
 
+// template helper to see if the buffers can be refined on a background
+// thread, i.e. by a CPU evaluator without device context.
+template <typename STENCIL_TABLE, typename DEVICE_CONTEXT>
+struct asyncRefinable { static bool const value = false; };
+template <>
+struct asyncRefinable<Far::StencilTable, void> { static bool const value = true; };
+
+// ---------------------------------------------------------------------------
+
+/// \brief Runs the refinements of a Mesh with MeshAsyncRefine, one at a
+///        time, on a background thread
+///
+class MeshRefineQueue {
+public:
+    /// Constructor. Starts the background thread.
+    MeshRefineQueue();
+
+    /// Destructor. Completes the pending refinement.
+    ~MeshRefineQueue();
+
+    /// \brief Waits for the previous refinement, then runs task.Run(0, 1)
+    ///        on the background thread
+    void Refine(ThreadPool::Task const & task);
+
+    /// Returns true if the last refinement has completed
+    bool IsComplete() const;
+
+    /// Blocks until the last refinement has completed
+    void Wait() const;
+
+private:
+    // Non-copyable
+    MeshRefineQueue(MeshRefineQueue const &);
+    MeshRefineQueue & operator=(MeshRefineQueue const &);
+
+    // The implementation isolates the threading headers from clients
+    struct Impl;
+    Impl * _impl;
+};
+
 // ---------------------------------------------------------------------------
 
+/// \brief Refines primvar buffers with the stencils of a topology
+///
+/// With MeshAsyncRefine, the vertex and varying buffers are double
+/// buffered : Refine() evaluates the stencils on a background thread,
+/// while UpdateVertexBuffer() and UpdateVaryingBuffer() already fill the
+/// buffers of the next frame. The buffers of the last Refine() are the
+/// ones bound for drawing, once Synchronize() or the fence returned by
+/// IsRefineComplete() returns true. Since the buffers alternate, all the
+/// control vertices must be updated every frame. The asynchronous mode is
+/// restricted to the CPU evaluators (CPU, OpenMP, TBB, thread pool), i.e.
+/// to meshes of Far::StencilTable without device context : other meshes
+/// ignore MeshAsyncRefine with a warning and refine synchronously.
+///
 template <typename VERTEX_BUFFER,
           typename STENCIL_TABLE,
           typename EVALUATOR,
@@ -437,16 +493,27 @@ public:
             _farPatchTable(NULL),
             _numVertices(0),
             _maxValence(0),
-            _vertexBuffer(NULL),
-            _varyingBuffer(NULL),
+            _updateIndex(0),
+            _refineIndex(0),
             _vertexStencilTable(NULL),
             _varyingStencilTable(NULL),
             _evaluatorCache(evaluatorCache),
             _patchTable(NULL),
-            _deviceContext(deviceContext) {
+            _deviceContext(deviceContext),
+            _refineQueue(NULL) {
 
         assert(_refiner);
 
+        _vertexBuffers[0] = _vertexBuffers[1] = NULL;
+        _varyingBuffers[0] = _varyingBuffers[1] = NULL;
+
+        bool async = bits.test(MeshAsyncRefine);
+        if (async && !asyncRefinable<STENCIL_TABLE, DEVICE_CONTEXT>::value) {
+            Far::Warning("MeshAsyncRefine requires a CPU evaluator, "
+                         "refining synchronously");
+            async = false;
+        }
+
         MeshInterface<PATCH_TABLE>::refineMesh(
             *_refiner, level, bits);
 
@@ -459,9 +526,16 @@ public:
                           numVaryingElements,
                           level, bits);
 
-        initializeVertexBuffers(_numVertices,
-                                vertexBufferStride,
-                                varyingBufferStride);
+        int numBuffers = async ? 2 : 1;
+        for (int i = 0; i < numBuffers; ++i) {
+            initializeVertexBuffers(i, _numVertices,
+                                    vertexBufferStride,
+                                    varyingBufferStride);
+            _refineTasks[i] = RefineTask(this, i);
+        }
+        if (async) {
+            _refineQueue = new MeshRefineQueue();
+        }
 
         // configure vertex buffer descriptor
         _vertexDesc =
@@ -476,10 +550,15 @@ public:
     }
 
     virtual ~Mesh() {
+        // completes the pending refinement
+        delete _refineQueue;
+
         delete _refiner;
         delete _farPatchTable;
-        delete _vertexBuffer;
-        delete _varyingBuffer;
+        for (int i = 0; i < 2; ++i) {
+            delete _vertexBuffers[i];
+            delete _varyingBuffers[i];
+        }
         delete _vertexStencilTable;
         delete _varyingStencilTable;
         delete _patchTable;
@@ -488,17 +567,86 @@ public:
 
     virtual void UpdateVertexBuffer(float const *vertexData,
                                     int startVertex, int numVerts) {
-        _vertexBuffer->UpdateData(vertexData, startVertex, numVerts,
-                                  _deviceContext);
+        _vertexBuffers[_updateIndex]->UpdateData(
+            vertexData, startVertex, numVerts, _deviceContext);
     }
 
     virtual void UpdateVaryingBuffer(float const *varyingData,
                                      int startVertex, int numVerts) {
-        _varyingBuffer->UpdateData(varyingData, startVertex, numVerts,
-                                   _deviceContext);
+        _varyingBuffers[_updateIndex]->UpdateData(
+            varyingData, startVertex, numVerts, _deviceContext);
     }
 
+    /// \brief Refines the buffers of the last updates. Returns once done,
+    ///        unless MeshAsyncRefine is set.
     virtual void Refine() {
+        if (_refineQueue) {
+            // the buffers to be updated next must no longer be in use
+            _refineQueue->Wait();
+
+            _refineIndex = _updateIndex;
+            _refineQueue->Refine(_refineTasks[_refineIndex]);
+            _updateIndex = 1 - _updateIndex;
+        } else {
+            refineBuffers(_vertexBuffers[0], _varyingBuffers[0]);
+        }
+    }
+
+    virtual void Synchronize() {
+        waitForRefine();
+        Evaluator::Synchronize(_deviceContext);
+    }
+
+    /// \brief Returns true if the last Refine() has completed, always the
+    ///        case if the refinement is synchronous
+    bool IsRefineComplete() const {
+        return _refineQueue ? _refineQueue->IsComplete() : true;
+    }
+
+    virtual PatchTable * GetPatchTable() const {
+        return _patchTable;
+    }
+
+    virtual Far::PatchTable const *GetFarPatchTable() const {
+        return _farPatchTable;
+    }
+
+    virtual int GetNumVertices() const { return _numVertices; }
+
+    virtual int GetMaxValence() const { return _maxValence; }
+
+    virtual VertexBufferBinding BindVertexBuffer() {
+        waitForRefine();
+        return _vertexBuffers[_refineIndex]->BindVBO(_deviceContext);
+    }
+
+    virtual VertexBufferBinding BindVaryingBuffer() {
+        waitForRefine();
+        return _varyingBuffers[_refineIndex]->BindVBO(_deviceContext);
+    }
+
+    /// Returns the vertex buffer of the last Refine()
+    virtual VertexBuffer * GetVertexBuffer() {
+        return _vertexBuffers[_refineIndex];
+    }
+
+    /// Returns the varying buffer of the last Refine()
+    virtual VertexBuffer * GetVaryingBuffer() {
+        return _varyingBuffers[_refineIndex];
+    }
+
+    virtual Far::TopologyRefiner const * GetTopologyRefiner() const {
+        return _refiner;
+    }
+
+private:
+    void waitForRefine() const {
+        if (_refineQueue) _refineQueue->Wait();
+    }
+
+    // Evaluates the stencils of the given buffers
+    void refineBuffers(VertexBuffer * vertexBuffer,
+                       VertexBuffer * varyingBuffer) {
 
         int numControlVertices = _refiner->GetLevel(0).GetNumVertices();
 
@@ -513,8 +661,8 @@ public:
             _evaluatorCache, srcDesc, dstDesc,
             _deviceContext);
 
-        Evaluator::EvalStencils(_vertexBuffer, srcDesc,
-                                _vertexBuffer, dstDesc,
+        Evaluator::EvalStencils(vertexBuffer, srcDesc,
+                                vertexBuffer, dstDesc,
                                 _vertexStencilTable,
                                 instance, _deviceContext);
 
@@ -527,59 +675,38 @@ public:
                 _evaluatorCache, vSrcDesc, vDstDesc,
                 _deviceContext);
 
-            if (_varyingBuffer) {
+            if (varyingBuffer) {
                 // non-interleaved
-                Evaluator::EvalStencils(_varyingBuffer, vSrcDesc,
-                                        _varyingBuffer, vDstDesc,
+                Evaluator::EvalStencils(varyingBuffer, vSrcDesc,
+                                        varyingBuffer, vDstDesc,
                                         _varyingStencilTable,
                                         instance, _deviceContext);
             } else {
                 // interleaved
-                Evaluator::EvalStencils(_vertexBuffer, vSrcDesc,
-                                        _vertexBuffer, vDstDesc,
+                Evaluator::EvalStencils(vertexBuffer, vSrcDesc,
+                                        vertexBuffer, vDstDesc,
                                         _varyingStencilTable,
                                         instance, _deviceContext);
             }
         }
     }
 
-    virtual void Synchronize() {
-        Evaluator::Synchronize(_deviceContext);
-    }
-
-    virtual PatchTable * GetPatchTable() const {
-        return _patchTable;
-    }
-
-    virtual Far::PatchTable const *GetFarPatchTable() const {
-        return _farPatchTable;
-    }
-
-    virtual int GetNumVertices() const { return _numVertices; }
-
-    virtual int GetMaxValence() const { return _maxValence; }
-
-    virtual VertexBufferBinding BindVertexBuffer() {
-        return _vertexBuffer->BindVBO(_deviceContext);
-    }
-
-    virtual VertexBufferBinding BindVaryingBuffer() {
-        return _varyingBuffer->BindVBO(_deviceContext);
-    }
-
-    virtual VertexBuffer * GetVertexBuffer() {
-        return _vertexBuffer;
-    }
+    // Background refinement of one of the double buffers
+    class RefineTask : public ThreadPool::Task {
+    public:
+        RefineTask() : _mesh(NULL), _index(0) { }
+        RefineTask(Mesh * mesh, int index) : _mesh(mesh), _index(index) { }
 
-    virtual VertexBuffer * GetVaryingBuffer() {
-        return _varyingBuffer;
-    }
+        virtual void Run(int /* begin */, int /* end */) const {
+            _mesh->refineBuffers(_mesh->_vertexBuffers[_index],
+                                 _mesh->_varyingBuffers[_index]);
+        }
 
-    virtual Far::TopologyRefiner const * GetTopologyRefiner() const {
-        return _refiner;
-    }
+    private:
+        Mesh * _mesh;
+        int _index;
+    };
 
-private:
     void initializeContext(int numVertexElements,
                            int numVaryingElements,
                            int level, MeshBitset bits) {
@@ -678,18 +805,19 @@ private:
         delete varyingStencils;
     }
 
-    void initializeVertexBuffers(int numVertices,
+    void initializeVertexBuffers(int index,
+                                 int numVertices,
                                  int numVertexElements,
                                  int numVaryingElements) {
 
         if (numVertexElements) {
-            _vertexBuffer = VertexBuffer::Create(numVertexElements,
-                                                 numVertices, _deviceContext);
+            _vertexBuffers[index] = VertexBuffer::Create(
+                numVertexElements, numVertices, _deviceContext);
         }
 
         if (numVaryingElements) {
-            _varyingBuffer = VertexBuffer::Create(numVaryingElements,
-                                                  numVertices, _deviceContext);
+            _varyingBuffers[index] = VertexBuffer::Create(
+                numVaryingElements, numVertices, _deviceContext);
         }
     }
 
@@ -699,8 +827,11 @@ private:
     int _numVertices;
     int _maxValence;
 
-    VertexBuffer * _vertexBuffer;
-    VertexBuffer * _varyingBuffer;
+    // the buffers are double buffered with MeshAsyncRefine
+    VertexBuffer * _vertexBuffers[2];
+    VertexBuffer * _varyingBuffers[2];
+    int _updateIndex,
+        _refineIndex;
 
     BufferDescriptor _vertexDesc;
     BufferDescriptor _varyingDesc;
@@ -711,6 +842,9 @@ private:
 
     PatchTable *_patchTable;
     DeviceContext *_deviceContext;
+
+    RefineTask _refineTasks[2];
+    MeshRefineQueue * _refineQueue;
 };
 
 } // end namespace Osd
@@ -0,0 +1,422 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#include "../osd/numaEvaluator.h"
+#include "../osd/cpuKernel.h"
+#include "../osd/numaThreadPool.h"
+#include "../far/stencilTable.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Osd {
+
+namespace {
+
+//
+//  Copies the stencils of ranges of the partitions -- run on the threads of
+//  the node of each partition so that the copies are placed on that node:
+//
+class CopyTask : public ThreadPool::Task {
+public:
+    typedef NumaStencilTable::Partition Partition;
+
+    CopyTask(Far::StencilTableReal<float> const *stencilTable,
+             float const *duWeights, float const *dvWeights,
+             Partition const *partitions,
+             int const *ranges, int const *rangePartitions) :
+        _sizes(&stencilTable->GetSizes()[0]),
+        _offsets(&stencilTable->GetOffsets()[0]),
+        _indices(&stencilTable->GetControlIndices()[0]),
+        _weights(&stencilTable->GetWeights()[0]),
+        _duWeights(duWeights), _dvWeights(dvWeights),
+        _partitions(partitions),
+        _ranges(ranges), _rangePartitions(rangePartitions) { }
+
+    virtual void Run(int begin, int end) const {
+        for (int r = begin; r < end; ++r) {
+            Partition const & p = _partitions[_rangePartitions[r]];
+
+            int start = _ranges[r];
+            int n = _ranges[r+1] - start;
+
+            int firstWeight = _offsets[p.begin];
+            int offset = _offsets[start];
+            int numWeights = _offsets[start+n-1] + _sizes[start+n-1] - offset;
+
+            int localStart = start - p.begin;
+            int localOffset = offset - firstWeight;
+
+            std::memcpy(p.sizes + localStart, _sizes + start, n * sizeof(int));
+            for (int i = 0; i < n; ++i) {
+                p.offsets[localStart + i] = _offsets[start + i] - firstWeight;
+            }
+            std::memcpy(p.indices + localOffset, _indices + offset,
+                        numWeights * sizeof(int));
+            std::memcpy(p.weights + localOffset, _weights + offset,
+                        numWeights * sizeof(float));
+            if (_duWeights && _dvWeights) {
+                std::memcpy(p.duWeights + localOffset, _duWeights + offset,
+                            numWeights * sizeof(float));
+                std::memcpy(p.dvWeights + localOffset, _dvWeights + offset,
+                            numWeights * sizeof(float));
+            }
+        }
+    }
+
+private:
+    int const * _sizes;
+    int const * _offsets;
+    int const * _indices;
+    float const * _weights;
+    float const * _duWeights;
+    float const * _dvWeights;
+    Partition const * _partitions;
+    int const * _ranges;
+    int const * _rangePartitions;
+};
+
+//
+//  Zeroes the destination elements of ranges of the partitions:
+//
+class FirstTouchTask : public ThreadPool::Task {
+public:
+    FirstTouchTask(float * buffer, BufferDescriptor const &desc,
+                   int const * ranges) :
+        _buffer(buffer), _desc(desc), _ranges(ranges) { }
+
+    virtual void Run(int begin, int end) const {
+        for (int r = begin; r < end; ++r) {
+            float * dst = _buffer + _desc.offset + _ranges[r] * _desc.stride;
+            for (int i = _ranges[r]; i < _ranges[r+1]; ++i) {
+                std::memset(dst, 0, _desc.length * sizeof(float));
+                dst += _desc.stride;
+            }
+        }
+    }
+
+private:
+    float * _buffer;
+    BufferDescriptor _desc;
+    int const * _ranges;
+};
+
+//
+//  Evaluates ranges of the partitions from the copies of their stencils,
+//  re-using the serial CPU kernels.
+//
+class StencilsTask : public ThreadPool::Task {
+public:
+    typedef NumaStencilTable::Partition Partition;
+
+    StencilsTask(float const * src, BufferDescriptor const &srcDesc,
+                 float * dst, BufferDescriptor const &dstDesc,
+                 float * du,  BufferDescriptor const &duDesc,
+                 float * dv,  BufferDescriptor const &dvDesc,
+                 Partition const *partitions,
+                 int const *ranges, int const *rangePartitions) :
+        _src(src), _srcDesc(srcDesc),
+        _dst(dst), _dstDesc(dstDesc),
+        _du(du), _duDesc(duDesc),
+        _dv(dv), _dvDesc(dvDesc),
+        _partitions(partitions),
+        _ranges(ranges), _rangePartitions(rangePartitions) { }
+
+    virtual void Run(int begin, int end) const {
+        for (int r = begin; r < end; ++r) {
+            evalRange(_partitions[_rangePartitions[r]],
+                      _ranges[r], _ranges[r+1]);
+        }
+    }
+
+private:
+    void evalRange(Partition const & p, int start, int end) const {
+        int localStart = start - p.begin;
+        int offset = p.offsets[localStart];
+
+        int const * sizes = p.sizes + localStart;
+        int const * indices = p.indices + offset;
+        int n = end - start;
+
+        float * dst = _dst + start * _dstDesc.stride;
+        if (_du == NULL) {
+            CpuEvalStencils(_src, _srcDesc,
+                            dst, _dstDesc,
+                            sizes, p.offsets, indices, p.weights + offset,
+                            0, n);
+        } else {
+            float * du = _du + start * _duDesc.stride;
+            float * dv = _dv + start * _dvDesc.stride;
+            CpuEvalStencils(_src, _srcDesc,
+                            dst, _dstDesc,
+                            du, _duDesc,
+                            dv, _dvDesc,
+                            sizes, p.offsets, indices,
+                            p.weights + offset,
+                            p.duWeights + offset,
+                            p.dvWeights + offset,
+                            0, n);
+        }
+    }
+
+    float const * _src;
+    BufferDescriptor _srcDesc;
+    float * _dst;
+    BufferDescriptor _dstDesc;
+    float * _du;
+    BufferDescriptor _duDesc;
+    float * _dv;
+    BufferDescriptor _dvDesc;
+    Partition const * _partitions;
+    int const * _ranges;
+    int const * _rangePartitions;
+};
+
+bool
+evalStencils(float const * src, BufferDescriptor const &srcDesc,
+             float * dst, BufferDescriptor const &dstDesc,
+             float * du,  BufferDescriptor const &duDesc,
+             float * dv,  BufferDescriptor const &dvDesc,
+             NumaStencilTable const * stencilTable,
+             NumaStencilTable::Partition const * partitions,
+             int const * ranges,
+             int const * rangePartitions,
+             int const * partitionRanges,
+             NumaEvaluator::NodeStats * nodeStats) {
+
+    StencilsTask task(src, srcDesc, dst, dstDesc, du, duDesc, dv, dvDesc,
+                      partitions, ranges, rangePartitions);
+
+    int numPartitions = stencilTable->GetNumPartitions();
+
+    std::vector<double> nodeSeconds(numPartitions);
+    stencilTable->GetThreadPool()->ParallelForNodes(
+        partitionRanges, 1, task, &nodeSeconds[0]);
+
+    if (nodeStats) {
+        for (int i = 0; i < numPartitions; ++i) {
+            nodeStats[i].numStencils =
+                partitions[i].end - partitions[i].begin;
+            nodeStats[i].numWeights = partitions[i].numWeights;
+            nodeStats[i].seconds = nodeSeconds[i];
+        }
+    }
+    return true;
+}
+
+} // end namespace
+
+//
+//  NumaStencilTable:
+//
+NumaStencilTable *
+NumaStencilTable::Create(Far::StencilTable const *stencilTable,
+                         NumaThreadPool *threadPool,
+                         GrainPolicy const &grainPolicy) {
+
+    return new NumaStencilTable(stencilTable, NULL, NULL,
+                                threadPool, grainPolicy);
+}
+
+NumaStencilTable *
+NumaStencilTable::Create(Far::LimitStencilTable const *limitStencilTable,
+                         NumaThreadPool *threadPool,
+                         GrainPolicy const &grainPolicy) {
+
+    bool hasDerivatives = !limitStencilTable->GetDuWeights().empty() &&
+                          !limitStencilTable->GetDvWeights().empty();
+
+    return new NumaStencilTable(limitStencilTable,
+        hasDerivatives ? &limitStencilTable->GetDuWeights()[0] : NULL,
+        hasDerivatives ? &limitStencilTable->GetDvWeights()[0] : NULL,
+        threadPool, grainPolicy);
+}
+
+NumaStencilTable::NumaStencilTable(
+    Far::StencilTableReal<float> const *stencilTable,
+    float const *duWeights,
+    float const *dvWeights,
+    NumaThreadPool *threadPool,
+    GrainPolicy const &grainPolicy) :
+    _numStencils(stencilTable->GetNumStencils()),
+    _hasDerivatives(duWeights && dvWeights),
+    _threadPool(threadPool) {
+
+    int numNodes = threadPool->GetNumNodes();
+    int numThreads = threadPool->GetNumThreads();
+
+    int const * sizes = _numStencils ? &stencilTable->GetSizes()[0] : NULL;
+    int const * offsets = _numStencils ? &stencilTable->GetOffsets()[0] : NULL;
+
+    long long totalWeights = _numStencils
+        ? offsets[_numStencils-1] + sizes[_numStencils-1] : 0;
+
+    //  Split the stencils into partitions whose weights are proportional to
+    //  the number of threads of each node (offsets are running sums):
+    _partitions.resize(numNodes);
+
+    int threadsBefore = 0;
+    for (int i = 0; i < numNodes; ++i) {
+        Partition & p = _partitions[i];
+
+        if (i == 0) {
+            p.begin = 0;
+        } else {
+            int targetWeight = (int)(totalWeights * threadsBefore / numThreads);
+            p.begin = (int)(std::lower_bound(offsets,
+                offsets + _numStencils, targetWeight) - offsets);
+            p.begin = std::max(p.begin, _partitions[i-1].begin);
+            _partitions[i-1].end = p.begin;
+        }
+        threadsBefore += threadPool->GetNumNodeThreads(i);
+    }
+    _partitions[numNodes-1].end = _numStencils;
+
+    //  Allocate the partitions -- left uninitialized so that the pages are
+    //  first touched when copied on the threads of their node:
+    for (int i = 0; i < numNodes; ++i) {
+        Partition & p = _partitions[i];
+
+        int n = p.end - p.begin;
+        p.numWeights = n ? (offsets[p.end-1] + sizes[p.end-1] -
+                            offsets[p.begin]) : 0;
+
+        p.sizes = new int[n];
+        p.offsets = new int[n];
+        p.indices = new int[p.numWeights];
+        p.weights = new float[p.numWeights];
+        p.duWeights = _hasDerivatives ? new float[p.numWeights] : NULL;
+        p.dvWeights = _hasDerivatives ? new float[p.numWeights] : NULL;
+    }
+
+    //  Split the partitions into the ranges of the tasks of their nodes:
+    GrainPolicy policy = grainPolicy;
+    policy.serialCost = 0;
+
+    _ranges.push_back(0);
+    _partitionRanges.resize(numNodes + 1);
+
+    std::vector<int> ranges;
+    for (int i = 0; i < numNodes; ++i) {
+        Partition const & p = _partitions[i];
+
+        _partitionRanges[i] = (int)_rangePartitions.size();
+        if (p.end > p.begin) {
+            CpuPartitionStencils(policy, sizes, offsets, p.begin, p.end,
+                                 ranges);
+            for (size_t j = 1; j < ranges.size(); ++j) {
+                _ranges.push_back(ranges[j]);
+                _rangePartitions.push_back(i);
+            }
+        }
+    }
+    _partitionRanges[numNodes] = (int)_rangePartitions.size();
+
+    if (_numStencils) {
+        CopyTask task(stencilTable, duWeights, dvWeights, &_partitions[0],
+                      &_ranges[0], &_rangePartitions[0]);
+        _threadPool->ParallelForNodes(&_partitionRanges[0], 1, task);
+    }
+}
+
+NumaStencilTable::~NumaStencilTable() {
+
+    for (size_t i = 0; i < _partitions.size(); ++i) {
+        Partition & p = _partitions[i];
+
+        delete [] p.sizes;
+        delete [] p.offsets;
+        delete [] p.indices;
+        delete [] p.weights;
+        delete [] p.duWeights;
+        delete [] p.dvWeights;
+    }
+}
+
+void
+NumaStencilTable::FirstTouchBuffer(float *buffer,
+                                   BufferDescriptor const &desc) const {
+
+    if (_numStencils == 0) return;
+
+    FirstTouchTask task(buffer, desc, &_ranges[0]);
+    _threadPool->ParallelForNodes(&_partitionRanges[0], 1, task);
+}
+
+//
+//  NumaEvaluator:
+//
+bool
+NumaEvaluator::EvalStencils(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    NumaStencilTable const *stencilTable,
+    NodeStats *nodeStats) {
+
+    if (stencilTable->GetNumStencils() == 0) return false;
+
+    if (srcDesc.length != dstDesc.length) return false;
+
+    return evalStencils(src, srcDesc, dst, dstDesc,
+                        NULL, BufferDescriptor(), NULL, BufferDescriptor(),
+                        stencilTable, &stencilTable->_partitions[0],
+                        &stencilTable->_ranges[0],
+                        &stencilTable->_rangePartitions[0],
+                        &stencilTable->_partitionRanges[0],
+                        nodeStats);
+}
+
+bool
+NumaEvaluator::EvalStencils(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    float *du,        BufferDescriptor const &duDesc,
+    float *dv,        BufferDescriptor const &dvDesc,
+    NumaStencilTable const *stencilTable,
+    NodeStats *nodeStats) {
+
+    if (stencilTable->GetNumStencils() == 0) return false;
+
+    if (!stencilTable->HasDerivatives()) return false;
+
+    if (srcDesc.length != dstDesc.length) return false;
+    if (srcDesc.length != duDesc.length) return false;
+    if (srcDesc.length != dvDesc.length) return false;
+
+    return evalStencils(src, srcDesc, dst, dstDesc,
+                        du, duDesc, dv, dvDesc,
+                        stencilTable, &stencilTable->_partitions[0],
+                        &stencilTable->_ranges[0],
+                        &stencilTable->_rangePartitions[0],
+                        &stencilTable->_partitionRanges[0],
+                        nodeStats);
+}
+
+}  // end namespace Osd
+
+}  // end namespace OPENSUBDIV_VERSION
+}  // end namespace OpenSubdiv
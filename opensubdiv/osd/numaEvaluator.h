@@ -0,0 +1,316 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#ifndef OPENSUBDIV3_OSD_NUMA_EVALUATOR_H
+#define OPENSUBDIV3_OSD_NUMA_EVALUATOR_H
+
+#include "../version.h"
+#include "../osd/bufferDescriptor.h"
+#include "../osd/grainPolicy.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Far {
+    template <typename REAL> class StencilTableReal;
+    class StencilTable;
+    class LimitStencilTable;
+}
+
+namespace Osd {
+
+class NumaThreadPool;
+
+/// \brief Stencil table partitioned across the nodes of a NumaThreadPool
+///
+/// The stencils are split into one contiguous partition per node, of a
+/// cost (number of weights) proportional to the number of threads of the
+/// node. The sizes, indices and weights of each partition are copied by
+/// the threads of its node, so that they are placed in the memory of that
+/// node on first touch, and NumaEvaluator evaluates each partition on the
+/// threads of its node.
+///
+/// The destination buffers are written by the same partitions, and their
+/// placement can be similarly controlled with FirstTouchBuffer().
+///
+class NumaStencilTable {
+public:
+    /// \brief Creates a partitioned copy of a stencil table
+    ///
+    /// @param stencilTable  Far::StencilTable to partition
+    ///
+    /// @param threadPool    NumaThreadPool used for the evaluation -- the
+    ///                      table is partitioned according to its nodes
+    ///                      and only remains valid while the pool exists
+    ///
+    /// @param grainPolicy   Policy used to split the partitions into tasks
+    ///                      (its serial cost is ignored)
+    ///
+    static NumaStencilTable *Create(Far::StencilTable const *stencilTable,
+                                    NumaThreadPool *threadPool,
+                                    GrainPolicy const &grainPolicy =
+                                        GrainPolicy());
+
+    /// \brief Creates a partitioned copy of a limit stencil table, including
+    ///        its first derivative weights
+    static NumaStencilTable *Create(
+        Far::LimitStencilTable const *limitStencilTable,
+        NumaThreadPool *threadPool,
+        GrainPolicy const &grainPolicy = GrainPolicy());
+
+    ~NumaStencilTable();
+
+    /// Returns the number of stencils
+    int GetNumStencils() const { return _numStencils; }
+
+    /// Returns true if the first derivative weights were copied
+    bool HasDerivatives() const { return _hasDerivatives; }
+
+    /// Returns the NumaThreadPool the table was partitioned for
+    NumaThreadPool *GetThreadPool() const { return _threadPool; }
+
+    /// Returns the number of partitions (the number of nodes of the pool)
+    int GetNumPartitions() const { return (int)_partitions.size(); }
+
+    /// Returns the first stencil of a partition
+    int GetPartitionBegin(int partition) const {
+        return _partitions[partition].begin;
+    }
+
+    /// Returns the end (one past the last stencil) of a partition
+    int GetPartitionEnd(int partition) const {
+        return _partitions[partition].end;
+    }
+
+    /// Returns the number of weights of a partition
+    int GetPartitionNumWeights(int partition) const {
+        return _partitions[partition].numWeights;
+    }
+
+    /// \brief Zeroes the elements of a buffer written by each stencil on the
+    ///        threads of the node evaluating it
+    ///
+    /// Intended for newly allocated destination buffers (whose memory has
+    /// not been touched), so that the pages written by each node are placed
+    /// in the memory of that node.  Pages shared by two partitions are
+    /// placed on either node.
+    ///
+    /// @param buffer  Destination buffer, indexed from the first stencil
+    ///
+    /// @param desc    Buffer descriptor of the primvar written
+    ///
+    void FirstTouchBuffer(float *buffer, BufferDescriptor const &desc) const;
+
+    /// @cond PROTECTED
+    //  The copy of the stencils of each partition, indexed from its first
+    //  stencil and its first weight:
+    struct Partition {
+        int begin, end;
+        int numWeights;
+
+        int * sizes;
+        int * offsets;
+        int * indices;
+        float * weights;
+        float * duWeights;
+        float * dvWeights;
+    };
+    /// @endcond PROTECTED
+
+protected:
+    /// @cond PROTECTED
+    friend class NumaEvaluator;
+
+    NumaStencilTable(Far::StencilTableReal<float> const *stencilTable,
+                     float const *duWeights, float const *dvWeights,
+                     NumaThreadPool *threadPool,
+                     GrainPolicy const &grainPolicy);
+
+    int _numStencils;
+    bool _hasDerivatives;
+
+    NumaThreadPool * _threadPool;
+
+    std::vector<Partition> _partitions;
+
+    //  Ranges of stencils of the tasks of all partitions, and the first
+    //  range of each partition (GetNumPartitions()+1):
+    std::vector<int> _ranges;
+    std::vector<int> _rangePartitions;
+    std::vector<int> _partitionRanges;
+    /// @endcond PROTECTED
+
+private:
+    // Non-copyable
+    NumaStencilTable(NumaStencilTable const &);
+    NumaStencilTable & operator=(NumaStencilTable const &);
+};
+
+/// \brief Stencil evaluator placing the evaluation of each partition of a
+///        NumaStencilTable on the threads of its node
+///
+/// Each node evaluates the stencils of its partition, reading the copy of
+/// the stencils in its own memory and writing the destination elements of
+/// its partition. The source primvars are read by all nodes.
+///
+/// The time taken by each node can be reported to monitor the throughput
+/// of the nodes and the balance between them.
+///
+class NumaEvaluator {
+public:
+    /// \brief Statistics of the evaluation of a partition by its node
+    struct NodeStats {
+        NodeStats() : numStencils(0), numWeights(0), seconds(0.0) { }
+
+        int    numStencils;   ///< stencils evaluated by the node
+        int    numWeights;    ///< weights of those stencils
+        double seconds;       ///< elapsed time of the node
+
+        /// Returns the weights evaluated per second (per output primvar)
+        double GetWeightsPerSecond() const {
+            return (seconds > 0.0) ? (double)numWeights / seconds : 0.0;
+        }
+    };
+
+    /// \brief Generic static eval stencils function. This function has a same
+    ///        signature as other device kernels have so that it can be called
+    ///        in the same way.
+    ///
+    /// @param srcBuffer      Input primvar buffer.
+    ///                       must have BindCpuBuffer() method returning a
+    ///                       const float pointer for read
+    ///
+    /// @param srcDesc        vertex buffer descriptor for the input buffer
+    ///
+    /// @param dstBuffer      Output primvar buffer
+    ///                       must have BindCpuBuffer() method returning a
+    ///                       float pointer for write
+    ///
+    /// @param dstDesc        vertex buffer descriptor for the output buffer
+    ///
+    /// @param stencilTable   NumaStencilTable
+    ///
+    /// @param instance       not used in the NUMA evaluator (but required,
+    ///                       unlike other evaluators, to distinguish this
+    ///                       function from the one taking raw pointers)
+    ///
+    /// @param deviceContext  not used in the NUMA evaluator
+    ///
+    template <typename SRC_BUFFER, typename DST_BUFFER>
+    static bool EvalStencils(
+        SRC_BUFFER *srcBuffer, BufferDescriptor const &srcDesc,
+        DST_BUFFER *dstBuffer, BufferDescriptor const &dstDesc,
+        NumaStencilTable const *stencilTable,
+        const NumaEvaluator *instance,
+        void * deviceContext = NULL) {
+
+        (void)instance;       // unused
+        (void)deviceContext;  // unused
+
+        return EvalStencils(srcBuffer->BindCpuBuffer(), srcDesc,
+                            dstBuffer->BindCpuBuffer(), dstDesc,
+                            stencilTable);
+    }
+
+    /// \brief Static eval stencils function which takes raw CPU pointers for
+    ///        input and output.
+    ///
+    /// @param src            Input primvar pointer. An offset of srcDesc
+    ///                       will be applied internally (i.e. the pointer
+    ///                       should not include the offset)
+    ///
+    /// @param srcDesc        vertex buffer descriptor for the input buffer
+    ///
+    /// @param dst            Output primvar pointer. An offset of dstDesc
+    ///                       will be applied internally.
+    ///
+    /// @param dstDesc        vertex buffer descriptor for the output buffer
+    ///
+    /// @param stencilTable   NumaStencilTable
+    ///
+    /// @param nodeStats      Optional array of GetNumPartitions() statistics
+    ///                       filled for each node
+    ///
+    static bool EvalStencils(
+        const float *src, BufferDescriptor const &srcDesc,
+        float *dst,       BufferDescriptor const &dstDesc,
+        NumaStencilTable const *stencilTable,
+        NodeStats *nodeStats = NULL);
+
+    /// \brief Generic static eval stencils function with derivatives.
+    ///
+    /// The stencil table must have been created from a Far::LimitStencilTable.
+    ///
+    /// @see EvalStencils() for a description of the arguments.
+    ///
+    template <typename SRC_BUFFER, typename DST_BUFFER>
+    static bool EvalStencils(
+        SRC_BUFFER *srcBuffer, BufferDescriptor const &srcDesc,
+        DST_BUFFER *dstBuffer, BufferDescriptor const &dstDesc,
+        DST_BUFFER *duBuffer,  BufferDescriptor const &duDesc,
+        DST_BUFFER *dvBuffer,  BufferDescriptor const &dvDesc,
+        NumaStencilTable const *stencilTable,
+        const NumaEvaluator *instance,
+        void * deviceContext = NULL) {
+
+        (void)instance;       // unused
+        (void)deviceContext;  // unused
+
+        return EvalStencils(srcBuffer->BindCpuBuffer(), srcDesc,
+                            dstBuffer->BindCpuBuffer(), dstDesc,
+                            duBuffer->BindCpuBuffer(),  duDesc,
+                            dvBuffer->BindCpuBuffer(),  dvDesc,
+                            stencilTable);
+    }
+
+    /// \brief Static eval stencils function with derivatives, which takes
+    ///        raw CPU pointers for input and output.
+    ///
+    /// @see EvalStencils() for a description of the arguments.
+    ///
+    static bool EvalStencils(
+        const float *src, BufferDescriptor const &srcDesc,
+        float *dst,       BufferDescriptor const &dstDesc,
+        float *du,        BufferDescriptor const &duDesc,
+        float *dv,        BufferDescriptor const &dvDesc,
+        NumaStencilTable const *stencilTable,
+        NodeStats *nodeStats = NULL);
+
+    /// \brief synchronize all asynchronous computation invoked on this device.
+    static void Synchronize(void * /*deviceContext = NULL*/) {
+        // nothing.
+    }
+};
+
+}  // end namespace Osd
+
+}  // end namespace OPENSUBDIV_VERSION
+using namespace OPENSUBDIV_VERSION;
+
+}  // end namespace OpenSubdiv
+
+#endif  // OPENSUBDIV3_OSD_NUMA_EVALUATOR_H
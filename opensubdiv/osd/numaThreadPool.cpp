@@ -0,0 +1,391 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#include "../osd/numaThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Osd {
+
+namespace {
+
+    typedef std::vector<int> CpuList;
+
+#if defined(__linux__)
+    //
+    //  Reads a list of integers in the sysfs format, e.g. "0-3,8-11":
+    //
+    bool
+    readList(char const * path, std::vector<int> & values) {
+
+        FILE * file = fopen(path, "r");
+        if (!file) return false;
+
+        char buffer[4096];
+        bool success = (fgets(buffer, sizeof(buffer), file) != 0);
+        fclose(file);
+        if (!success) return false;
+
+        char const * s = buffer;
+        while (*s >= '0' && *s <= '9') {
+            int first = 0;
+            for ( ; *s >= '0' && *s <= '9'; ++s) first = first * 10 + (*s - '0');
+
+            int last = first;
+            if (*s == '-') {
+                last = 0;
+                for (++s; *s >= '0' && *s <= '9'; ++s) last = last*10 + (*s-'0');
+            }
+            for (int i = first; i <= last; ++i) {
+                values.push_back(i);
+            }
+            if (*s == ',') ++s;
+        }
+        return !values.empty();
+    }
+#endif
+
+    //
+    //  Returns the CPUs available to the process for each node of the
+    //  system -- a single node with no CPUs (i.e. unbound) if unknown:
+    //
+    void
+    getSystemNodes(std::vector<CpuList> & nodes) {
+
+#if defined(__linux__)
+        cpu_set_t available;
+        CPU_ZERO(&available);
+        if (sched_getaffinity(0, sizeof(available), &available) == 0) {
+
+            std::vector<int> nodeIds;
+            readList("/sys/devices/system/node/online", nodeIds);
+
+            for (size_t i = 0; i < nodeIds.size(); ++i) {
+                char path[128];
+                snprintf(path, sizeof(path),
+                    "/sys/devices/system/node/node%d/cpulist", nodeIds[i]);
+
+                CpuList nodeCpus, cpus;
+                readList(path, nodeCpus);
+                for (size_t j = 0; j < nodeCpus.size(); ++j) {
+                    if ((nodeCpus[j] < CPU_SETSIZE) &&
+                            CPU_ISSET(nodeCpus[j], &available)) {
+                        cpus.push_back(nodeCpus[j]);
+                    }
+                }
+                //  Nodes with memory but no (available) CPUs are ignored:
+                if (!cpus.empty()) {
+                    nodes.push_back(cpus);
+                }
+            }
+        }
+#endif
+        if (nodes.empty()) {
+            nodes.push_back(CpuList());
+        }
+    }
+
+    void
+    bindCurrentThread(CpuList const & cpus) {
+
+#if defined(__linux__)
+        if (cpus.empty()) return;
+
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        for (size_t i = 0; i < cpus.size(); ++i) {
+            CPU_SET(cpus[i], &cpuSet);
+        }
+        pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+#else
+        (void)cpus;
+#endif
+    }
+
+    typedef std::chrono::steady_clock Clock;
+
+    //  The pool of which the current thread is a worker, if any:
+    thread_local void const * workerPool = 0;
+
+    inline double
+    secondsSince(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+}
+
+struct NumaThreadPool::Impl {
+
+    struct Node {
+        Node() : numThreads(0), begin(0), end(0), numChunks(0),
+            nextChunk(0), numPendingChunks(0), seconds(0.0) { }
+
+        CpuList cpus;
+        int     numThreads;
+
+        // current job
+        int begin,
+            end,
+            numChunks;
+        std::atomic<int> nextChunk;
+        std::atomic<int> numPendingChunks;
+        double seconds;
+    };
+
+    explicit Impl(int numNodes) : nodes(numNodes), task(0), grainSize(1),
+        numActiveWorkers(0), generation(0), stop(false) { }
+
+    // Claims and runs chunks of the range of a node until none are left
+    void RunChunks(Node & node) {
+        for (;;) {
+            int chunk = node.nextChunk.fetch_add(1);
+            if (chunk >= node.numChunks) break;
+
+            int chunkBegin = node.begin + chunk * grainSize;
+            int chunkEnd = std::min(chunkBegin + grainSize, node.end);
+            task->Run(chunkBegin, chunkEnd);
+
+            if (node.numPendingChunks.fetch_sub(1) == 1) {
+                node.seconds = secondsSince(start);
+            }
+        }
+    }
+
+    static void WorkerMain(Impl * impl, int nodeIndex) {
+
+        Node & node = impl->nodes[nodeIndex];
+
+        bindCurrentThread(node.cpus);
+        workerPool = impl;
+
+        unsigned int lastGeneration = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(impl->mutex);
+                while (!impl->stop && impl->generation == lastGeneration) {
+                    impl->wakeCondition.wait(lock);
+                }
+                if (impl->stop) return;
+                lastGeneration = impl->generation;
+            }
+
+            impl->RunChunks(node);
+
+            {
+                std::lock_guard<std::mutex> lock(impl->mutex);
+                if (--impl->numActiveWorkers == 0) {
+                    impl->doneCondition.notify_one();
+                }
+            }
+        }
+    }
+
+    std::vector<Node>        nodes;
+    std::vector<std::thread> workers;
+
+    std::mutex submitMutex;     // held for the duration of a job (and
+                                // so queues concurrent submissions)
+    std::mutex mutex;           // guards the job state below
+    std::condition_variable wakeCondition,
+                            doneCondition;
+
+    // current job
+    Task const *      task;
+    int               grainSize;
+    Clock::time_point start;
+
+    int numActiveWorkers;
+    unsigned int generation;
+    bool stop;
+};
+
+NumaThreadPool::NumaThreadPool(int numNodes, int numThreadsPerNode) {
+
+    std::vector<CpuList> systemNodes;
+    getSystemNodes(systemNodes);
+
+    if (numNodes <= 0) {
+        numNodes = (int)systemNodes.size();
+    }
+
+    _impl = new Impl(numNodes);
+
+    for (int i = 0; i < numNodes; ++i) {
+        Impl::Node & node = _impl->nodes[i];
+
+        node.cpus = systemNodes[i % systemNodes.size()];
+        node.numThreads = numThreadsPerNode;
+        if (node.numThreads <= 0) {
+            node.numThreads = node.cpus.empty()
+                ? std::max(1, (int)std::thread::hardware_concurrency())
+                : (int)node.cpus.size();
+        }
+    }
+
+    for (int i = 0; i < numNodes; ++i) {
+        for (int j = 0; j < _impl->nodes[i].numThreads; ++j) {
+            _impl->workers.push_back(std::thread(Impl::WorkerMain, _impl, i));
+        }
+    }
+}
+
+NumaThreadPool::~NumaThreadPool() {
+
+    {
+        std::lock_guard<std::mutex> lock(_impl->mutex);
+        _impl->stop = true;
+    }
+    _impl->wakeCondition.notify_all();
+
+    for (size_t i = 0; i < _impl->workers.size(); ++i) {
+        _impl->workers[i].join();
+    }
+    delete _impl;
+}
+
+int
+NumaThreadPool::GetNumThreads() const {
+
+    return (int)_impl->workers.size();
+}
+
+int
+NumaThreadPool::GetNumNodes() const {
+
+    return (int)_impl->nodes.size();
+}
+
+int
+NumaThreadPool::GetNumNodeThreads(int node) const {
+
+    return _impl->nodes[node].numThreads;
+}
+
+bool
+NumaThreadPool::IsBound() const {
+
+    return !_impl->nodes[0].cpus.empty();
+}
+
+void
+NumaThreadPool::ParallelFor(int begin, int end, int grainSize,
+                            Task const &task) {
+
+    if (end <= begin) return;
+
+    //  Split the items according to the number of threads of each node:
+    int numNodes = GetNumNodes();
+    int numThreads = GetNumThreads();
+
+    std::vector<int> nodeBegins(numNodes + 1);
+
+    long long numItems = end - begin;
+    int threadsBefore = 0;
+    for (int i = 0; i < numNodes; ++i) {
+        nodeBegins[i] = begin + (int)(numItems * threadsBefore / numThreads);
+        threadsBefore += _impl->nodes[i].numThreads;
+    }
+    nodeBegins[numNodes] = end;
+
+    ParallelForNodes(&nodeBegins[0], grainSize, task);
+}
+
+void
+NumaThreadPool::ParallelForNodes(int const * nodeBegins, int grainSize,
+                                 Task const &task, double * nodeSeconds) {
+
+    int numNodes = GetNumNodes();
+
+    grainSize = std::max(1, grainSize);
+
+    //  Calls from within a task run serially on the calling worker (which
+    //  would otherwise wait for its own job to complete), while calls from
+    //  other threads wait for the current job of the pool to complete:
+    if (workerPool == _impl) {
+        for (int i = 0; i < numNodes; ++i) {
+            Clock::time_point start = Clock::now();
+            if (nodeBegins[i+1] > nodeBegins[i]) {
+                task.Run(nodeBegins[i], nodeBegins[i+1]);
+            }
+            if (nodeSeconds) nodeSeconds[i] = secondsSince(start);
+        }
+        return;
+    }
+    _impl->submitMutex.lock();
+
+    {
+        std::lock_guard<std::mutex> lock(_impl->mutex);
+        _impl->task = &task;
+        _impl->grainSize = grainSize;
+        for (int i = 0; i < numNodes; ++i) {
+            Impl::Node & node = _impl->nodes[i];
+
+            node.begin = nodeBegins[i];
+            node.end = std::max(nodeBegins[i], nodeBegins[i+1]);
+            node.numChunks = (node.end - node.begin + grainSize - 1) /
+                             grainSize;
+            node.nextChunk = 0;
+            node.numPendingChunks = node.numChunks;
+            node.seconds = 0.0;
+        }
+        _impl->numActiveWorkers = (int)_impl->workers.size();
+        _impl->start = Clock::now();
+        ++_impl->generation;
+    }
+    _impl->wakeCondition.notify_all();
+
+    {
+        std::unique_lock<std::mutex> lock(_impl->mutex);
+        while (_impl->numActiveWorkers > 0) {
+            _impl->doneCondition.wait(lock);
+        }
+        _impl->task = 0;
+
+        if (nodeSeconds) {
+            for (int i = 0; i < numNodes; ++i) {
+                nodeSeconds[i] = _impl->nodes[i].seconds;
+            }
+        }
+    }
+    _impl->submitMutex.unlock();
+}
+
+}  // end namespace Osd
+
+}  // end namespace OPENSUBDIV_VERSION
+}  // end namespace OpenSubdiv
@@ -0,0 +1,128 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#ifndef OPENSUBDIV3_OSD_NUMA_THREAD_POOL_H
+#define OPENSUBDIV3_OSD_NUMA_THREAD_POOL_H
+
+#include "../version.h"
+#include "../osd/threadPool.h"
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Osd {
+
+/// \brief ThreadPool with its threads grouped by NUMA node
+///
+/// The worker threads are created once per node and are bound to the CPUs
+/// of their node (on Linux, where the nodes are read from sysfs -- on other
+/// platforms or when no topology is found, a single node is used and the
+/// threads are not bound).
+///
+/// ParallelForNodes() applies a task to a separate range of items on each
+/// node, so that memory first touched by the threads of a node when
+/// processing its range is placed on that node, and later processed by the
+/// same node. Chunks are not exchanged between nodes, so the ranges should
+/// be balanced according to the number of threads of each node.
+///
+/// Unlike StdThreadPool, the calling thread does not take part in the work
+/// (as it is not bound to any node) and waits for the workers to finish.
+/// Calls issued from other threads while the pool is busy are queued, and
+/// run on the workers once the current call has completed. Calls issued
+/// from within a task run serially on the worker running the task (which
+/// remains on its node), with the time of each node reported as usual.
+///
+/// As a ThreadPool, it can also be installed for use by ThreadPoolEvaluator
+/// -- ParallelFor() splits the items across the nodes according to their
+/// number of threads.
+///
+class NumaThreadPool : public ThreadPool {
+public:
+    /// \brief Constructor
+    ///
+    /// @param numNodes          Number of nodes -- the nodes of the system
+    ///                          if not positive. When more nodes than those
+    ///                          of the system are requested, the threads of
+    ///                          the extra nodes share the CPUs of the system
+    ///                          nodes in turn (e.g. to emulate nodes)
+    ///
+    /// @param numThreadsPerNode Number of threads per node -- the number of
+    ///                          CPUs of each node available to the process
+    ///                          if not positive
+    ///
+    explicit NumaThreadPool(int numNodes = 0, int numThreadsPerNode = 0);
+
+    /// Destructor. Joins the worker threads.
+    virtual ~NumaThreadPool();
+
+    /// Returns the total number of worker threads
+    virtual int GetNumThreads() const;
+
+    /// Applies the task to the items [begin, end), split across the nodes
+    virtual void ParallelFor(int begin, int end, int grainSize,
+                             Task const &task);
+
+    /// Returns the number of nodes
+    int GetNumNodes() const;
+
+    /// Returns the number of worker threads of a node
+    int GetNumNodeThreads(int node) const;
+
+    /// Returns true if the worker threads are bound to the CPUs of their node
+    bool IsBound() const;
+
+    /// \brief Applies the task to a range of items per node, on the threads
+    ///        of each node, and returns once all items are processed.
+    ///
+    /// @param nodeBegins   GetNumNodes() + 1 item boundaries, i.e. node n
+    ///                     processes [nodeBegins[n], nodeBegins[n+1])
+    ///
+    /// @param grainSize    Number of items per chunk
+    ///
+    /// @param task         Task applied to the chunks
+    ///
+    /// @param nodeSeconds  Optional array of GetNumNodes() elapsed times,
+    ///                     in seconds, for each node to process its range
+    ///
+    void ParallelForNodes(int const * nodeBegins, int grainSize,
+                          Task const &task, double * nodeSeconds = 0);
+
+private:
+    // Non-copyable
+    NumaThreadPool(NumaThreadPool const &);
+    NumaThreadPool & operator=(NumaThreadPool const &);
+
+    // The implementation isolates the threading headers from clients
+    struct Impl;
+    Impl * _impl;
+};
+
+}  // end namespace Osd
+
+}  // end namespace OPENSUBDIV_VERSION
+using namespace OPENSUBDIV_VERSION;
+
+}  // end namespace OpenSubdiv
+
+#endif  // OPENSUBDIV3_OSD_NUMA_THREAD_POOL_H
@@ -24,11 +24,16 @@
 
 #include "../osd/ompEvaluator.h"
 #include "../osd/ompKernel.h"
+#include "../osd/cpuKernel.h"
 #include "../osd/patchBasisCommonTypes.h"
 #include "../osd/patchBasisCommon.h"
 #include "../osd/patchBasisCommonEval.h"
+#include "../far/instrumentation.h"
 #include <omp.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace OpenSubdiv {
 namespace OPENSUBDIV_VERSION {
 
@@ -43,14 +48,19 @@ OmpEvaluator::EvalStencils(
     const int * offsets,
     const int * indices,
     const float * weights,
-    int start, int end) {
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
 
     if (end <= start) return true;
     if (srcDesc.length != dstDesc.length) return false;
 
     // XXX: we can probably expand cpuKernel.cpp to here.
     OmpEvalStencils(src, srcDesc, dst, dstDesc,
-                    sizes, offsets, indices, weights, start, end);
+                    sizes, offsets, indices, weights, start, end,
+                    grainPolicy);
 
     return true;
 }
@@ -68,7 +78,11 @@ OmpEvaluator::EvalStencils(
     const float * weights,
     const float * duWeights,
     const float * dvWeights,
-    int start, int end) {
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
 
     if (end <= start) return true;
     if (srcDesc.length != dstDesc.length) return false;
@@ -81,7 +95,8 @@ OmpEvaluator::EvalStencils(
                     dv,  dvDesc,
                     sizes, offsets, indices,
                     weights, duWeights, dvWeights,
-                    start, end);
+                    start, end,
+                    grainPolicy);
 
     return true;
 }
@@ -105,7 +120,11 @@ OmpEvaluator::EvalStencils(
     const float * duuWeights,
     const float * duvWeights,
     const float * dvvWeights,
-    int start, int end) {
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
 
     if (end <= start) return true;
     if (srcDesc.length != dstDesc.length) return false;
@@ -125,7 +144,8 @@ OmpEvaluator::EvalStencils(
                     sizes, offsets, indices,
                     weights, duWeights, dvWeights,
                     duuWeights, duvWeights, dvvWeights,
-                    start, end);
+                    start, end,
+                    grainPolicy);
 
     return true;
 }
@@ -178,6 +198,9 @@ OmpEvaluator::EvalPatches(
 
 #pragma omp parallel for
     for (int i = 0; i < numPatchCoords; ++i) {
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
         BufferAdapter<float> dstT(dst + dstDesc.stride*i, dstDesc.length, dstDesc.stride);
 
         float wP[20];
@@ -222,6 +245,9 @@ OmpEvaluator::EvalPatches(
     const int *patchIndexBuffer,
     PatchParam const *patchParamBuffer) {
 
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
     src += srcDesc.offset;
     if (dst) dst += dstDesc.offset;
     if (du)  du += duDesc.offset;
@@ -287,6 +313,9 @@ OmpEvaluator::EvalPatches(
     const int *patchIndexBuffer,
     PatchParam const *patchParamBuffer) {
 
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
     src += srcDesc.offset;
     if (dst) dst += dstDesc.offset;
     if (du)  du += duDesc.offset;
@@ -352,6 +381,954 @@ OmpEvaluator::EvalPatches(
 }
 
 
+//
+//  Limit evaluation decoding the patch control vertices from a compact
+//  table -- any of the outputs may be NULL:
+//
+static bool
+evalPatchesCompact(const float *src, BufferDescriptor const &srcDesc,
+                   float *dst,       BufferDescriptor const &dstDesc,
+                   float *du,        BufferDescriptor const &duDesc,
+                   float *dv,        BufferDescriptor const &dvDesc,
+                   float *duu,       BufferDescriptor const &duuDesc,
+                   float *duv,       BufferDescriptor const &duvDesc,
+                   float *dvv,       BufferDescriptor const &dvvDesc,
+                   int numPatchCoords,
+                   PatchCoord const *patchCoords,
+                   PatchArray const *patchArrays,
+                   Far::CompactPatchVertices const *patchVertices,
+                   PatchParam const *patchParamBuffer) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (src == NULL || patchVertices == NULL) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (du  && srcDesc.length != duDesc.length)  return false;
+    if (dv  && srcDesc.length != dvDesc.length)  return false;
+    if (duu && srcDesc.length != duuDesc.length) return false;
+    if (duv && srcDesc.length != duvDesc.length) return false;
+    if (dvv && srcDesc.length != dvvDesc.length) return false;
+
+    int const blockSize = 256;
+    int numBlocks = (numPatchCoords + blockSize - 1) / blockSize;
+
+#pragma omp parallel for
+    for (int i = 0; i < numBlocks; ++i) {
+        int start = i * blockSize;
+        int end = std::min(start + blockSize, numPatchCoords);
+
+        CpuEvalPatchesCompact(src, srcDesc, dst, dstDesc,
+                              du, duDesc, dv, dvDesc,
+                              duu, duuDesc, duv, duvDesc, dvv, dvvDesc,
+                              start, end, patchCoords, patchArrays,
+                              patchVertices, patchParamBuffer);
+    }
+    return true;
+}
+
+/* static */
+bool
+OmpEvaluator::EvalPatches(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    Far::CompactPatchVertices const *patchVertices,
+    const PatchParam *patchParamBuffer) {
+
+    if (dst == NULL) return false;
+
+    return evalPatchesCompact(src, srcDesc, dst, dstDesc,
+                              0, BufferDescriptor(), 0, BufferDescriptor(),
+                              0, BufferDescriptor(), 0, BufferDescriptor(),
+                              0, BufferDescriptor(),
+                              numPatchCoords, patchCoords, patchArrays,
+                              patchVertices, patchParamBuffer);
+}
+
+/* static */
+bool
+OmpEvaluator::EvalPatches(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    float *du,        BufferDescriptor const &duDesc,
+    float *dv,        BufferDescriptor const &dvDesc,
+    int numPatchCoords,
+    PatchCoord const *patchCoords,
+    PatchArray const *patchArrays,
+    Far::CompactPatchVertices const *patchVertices,
+    PatchParam const *patchParamBuffer) {
+
+    return evalPatchesCompact(src, srcDesc, dst, dstDesc,
+                              du, duDesc, dv, dvDesc,
+                              0, BufferDescriptor(), 0, BufferDescriptor(),
+                              0, BufferDescriptor(),
+                              numPatchCoords, patchCoords, patchArrays,
+                              patchVertices, patchParamBuffer);
+}
+
+/* static */
+bool
+OmpEvaluator::EvalPatches(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    float *du,        BufferDescriptor const &duDesc,
+    float *dv,        BufferDescriptor const &dvDesc,
+    float *duu,       BufferDescriptor const &duuDesc,
+    float *duv,       BufferDescriptor const &duvDesc,
+    float *dvv,       BufferDescriptor const &dvvDesc,
+    int numPatchCoords,
+    PatchCoord const *patchCoords,
+    PatchArray const *patchArrays,
+    Far::CompactPatchVertices const *patchVertices,
+    PatchParam const *patchParamBuffer) {
+
+    return evalPatchesCompact(src, srcDesc, dst, dstDesc,
+                              du, duDesc, dv, dvDesc,
+                              duu, duuDesc, duv, duvDesc, dvv, dvvDesc,
+                              numPatchCoords, patchCoords, patchArrays,
+                              patchVertices, patchParamBuffer);
+}
+
+
+// ---------------------------------------------------------------------------
+//
+//  Double precision evaluations
+//
+
+//
+//  Limit evaluation re-uses the serial CPU kernel over blocks of patch
+//  coordinates, so that the basis evaluation is shared between evaluators:
+//
+static void
+ompEvalPatches(double const * src, BufferDescriptor const &srcDesc,
+               double * dst,       BufferDescriptor const &dstDesc,
+               double * du,        BufferDescriptor const &duDesc,
+               double * dv,        BufferDescriptor const &dvDesc,
+               double * duu,       BufferDescriptor const &duuDesc,
+               double * duv,       BufferDescriptor const &duvDesc,
+               double * dvv,       BufferDescriptor const &dvvDesc,
+               int numPatchCoords,
+               PatchCoord const * patchCoords,
+               PatchArray const * patchArrays,
+               int const * patchIndexBuffer,
+               PatchParam const * patchParamBuffer) {
+
+    int const blockSize = 256;
+    int numBlocks = (numPatchCoords + blockSize - 1) / blockSize;
+
+#pragma omp parallel for
+    for (int i = 0; i < numBlocks; ++i) {
+        int start = i * blockSize;
+        int end = std::min(start + blockSize, numPatchCoords);
+
+        CpuEvalPatches(src, srcDesc, dst, dstDesc,
+                       du, duDesc, dv, dvDesc,
+                       duu, duuDesc, duv, duvDesc, dvv, dvvDesc,
+                       start, end, patchCoords, patchArrays,
+                       patchIndexBuffer, patchParamBuffer);
+    }
+}
+
+/* static */
+bool
+OmpEvaluator::EvalStencils(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const double * weights,
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+    if (srcDesc.length != dstDesc.length) return false;
+
+    // XXX: we can probably expand cpuKernel.cpp to here.
+    OmpEvalStencils(src, srcDesc, dst, dstDesc,
+                    sizes, offsets, indices, weights, start, end,
+                    grainPolicy);
+
+    return true;
+}
+
+/* static */
+bool
+OmpEvaluator::EvalStencils(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    double *du,        BufferDescriptor const &duDesc,
+    double *dv,        BufferDescriptor const &dvDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const double * weights,
+    const double * duWeights,
+    const double * dvWeights,
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+    if (srcDesc.length != dstDesc.length) return false;
+    if (srcDesc.length != duDesc.length) return false;
+    if (srcDesc.length != dvDesc.length) return false;
+
+    OmpEvalStencils(src, srcDesc,
+                    dst, dstDesc,
+                    du,  duDesc,
+                    dv,  dvDesc,
+                    sizes, offsets, indices,
+                    weights, duWeights, dvWeights,
+                    start, end,
+                    grainPolicy);
+
+    return true;
+}
+
+/* static */
+bool
+OmpEvaluator::EvalStencils(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    double *du,        BufferDescriptor const &duDesc,
+    double *dv,        BufferDescriptor const &dvDesc,
+    double *duu,       BufferDescriptor const &duuDesc,
+    double *duv,       BufferDescriptor const &duvDesc,
+    double *dvv,       BufferDescriptor const &dvvDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const double * weights,
+    const double * duWeights,
+    const double * dvWeights,
+    const double * duuWeights,
+    const double * duvWeights,
+    const double * dvvWeights,
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+    if (srcDesc.length != dstDesc.length) return false;
+    if (srcDesc.length != duDesc.length) return false;
+    if (srcDesc.length != dvDesc.length) return false;
+    if (srcDesc.length != duuDesc.length) return false;
+    if (srcDesc.length != duvDesc.length) return false;
+    if (srcDesc.length != dvvDesc.length) return false;
+
+    OmpEvalStencils(src, srcDesc,
+                    dst, dstDesc,
+                    du,  duDesc,
+                    dv,  dvDesc,
+                    duu, duuDesc,
+                    duv, duvDesc,
+                    dvv, dvvDesc,
+                    sizes, offsets, indices,
+                    weights, duWeights, dvWeights,
+                    duuWeights, duvWeights, dvvWeights,
+                    start, end,
+                    grainPolicy);
+
+    return true;
+}
+
+/* static */
+bool
+OmpEvaluator::EvalPatches(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (src == NULL) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+
+    ompEvalPatches(src, srcDesc,
+                   dst, dstDesc,
+                   NULL, BufferDescriptor(),
+                   NULL, BufferDescriptor(),
+                   NULL, BufferDescriptor(),
+                   NULL, BufferDescriptor(),
+                   NULL, BufferDescriptor(),
+                   numPatchCoords, patchCoords, patchArrays,
+                   patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
+/* static */
+bool
+OmpEvaluator::EvalPatches(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    double *du,        BufferDescriptor const &duDesc,
+    double *dv,        BufferDescriptor const &dvDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (src == NULL) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (du && srcDesc.length != duDesc.length) return false;
+    if (dv && srcDesc.length != dvDesc.length) return false;
+
+    ompEvalPatches(src, srcDesc,
+                   dst, dstDesc,
+                   du, duDesc,
+                   dv, dvDesc,
+                   NULL, BufferDescriptor(),
+                   NULL, BufferDescriptor(),
+                   NULL, BufferDescriptor(),
+                   numPatchCoords, patchCoords, patchArrays,
+                   patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
+/* static */
+bool
+OmpEvaluator::EvalPatches(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    double *du,        BufferDescriptor const &duDesc,
+    double *dv,        BufferDescriptor const &dvDesc,
+    double *duu,       BufferDescriptor const &duuDesc,
+    double *duv,       BufferDescriptor const &duvDesc,
+    double *dvv,       BufferDescriptor const &dvvDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (src == NULL) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (du && srcDesc.length != duDesc.length) return false;
+    if (dv && srcDesc.length != dvDesc.length) return false;
+    if (duu && srcDesc.length != duuDesc.length) return false;
+    if (duv && srcDesc.length != duvDesc.length) return false;
+    if (dvv && srcDesc.length != dvvDesc.length) return false;
+
+    ompEvalPatches(src, srcDesc,
+                   dst, dstDesc,
+                   du, duDesc,
+                   dv, dvDesc,
+                   duu, duuDesc,
+                   duv, duvDesc,
+                   dvv, dvvDesc,
+                   numPatchCoords, patchCoords, patchArrays,
+                   patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+//
+//  Instanced evaluations
+//
+
+/* static */
+bool
+OmpEvaluator::EvalStencilsInstanced(
+    const float *src, BufferDescriptor const &srcDesc,
+    int srcInstanceStride,
+    float *dst,       BufferDescriptor const &dstDesc,
+    int dstInstanceStride,
+    int numInstances,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const float * weights,
+    int start, int end) {
+
+    if (end <= start || numInstances <= 0) return true;
+    if (src == NULL || dst == NULL) return false;
+
+    std::vector<const float *> srcInstances;
+    std::vector<float *> dstInstances;
+    CpuGetInstancePointers(src, srcInstanceStride, numInstances, srcInstances);
+    CpuGetInstancePointers(dst, dstInstanceStride, numInstances, dstInstances);
+
+    return EvalStencilsInstanced(&srcInstances[0], srcDesc,
+                                 &dstInstances[0], dstDesc,
+                                 numInstances,
+                                 sizes, offsets, indices, weights,
+                                 start, end);
+}
+
+/* static */
+bool
+OmpEvaluator::EvalStencilsInstanced(
+    const float * const *srcInstances, BufferDescriptor const &srcDesc,
+    float * const *dstInstances,       BufferDescriptor const &dstDesc,
+    int numInstances,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const float * weights,
+    int start, int end) {
+
+    if (end <= start || numInstances <= 0) return true;
+    if (srcInstances == NULL || dstInstances == NULL) return false;
+    if (srcDesc.length != dstDesc.length) return false;
+
+    // tiles of instances x stencil blocks : consecutive tiles share the
+    // same stencil block, so its weights are likely to remain in cache
+    int const instanceBlockSize = 16;
+    int numInstanceBlocks =
+        (numInstances + instanceBlockSize - 1) / instanceBlockSize;
+    int numStencilBlocks = (end - start + INSTANCED_STENCIL_BLOCK_SIZE - 1) /
+                           INSTANCED_STENCIL_BLOCK_SIZE;
+    int numTiles = numInstanceBlocks * numStencilBlocks;
+
+#pragma omp parallel for
+    for (int i = 0; i < numTiles; ++i) {
+        int instanceStart = (i % numInstanceBlocks) * instanceBlockSize;
+        int instanceEnd =
+            std::min(instanceStart + instanceBlockSize, numInstances);
+        int stencilStart =
+            start + (i / numInstanceBlocks) * INSTANCED_STENCIL_BLOCK_SIZE;
+        int stencilEnd =
+            std::min(stencilStart + (int)INSTANCED_STENCIL_BLOCK_SIZE, end);
+
+        BufferDescriptor blockDesc = dstDesc;
+        blockDesc.offset += (stencilStart - start) * dstDesc.stride;
+
+        CpuEvalStencilsInstanced(srcInstances, srcDesc,
+                                 dstInstances, blockDesc,
+                                 instanceStart, instanceEnd,
+                                 sizes, offsets, indices, weights,
+                                 stencilStart, stencilEnd);
+    }
+
+    return true;
+}
+
+/* static */
+bool
+OmpEvaluator::EvalPatchesInstanced(
+    const float *src, BufferDescriptor const &srcDesc,
+    int srcInstanceStride,
+    float *dst,       BufferDescriptor const &dstDesc,
+    float *du,        BufferDescriptor const &duDesc,
+    float *dv,        BufferDescriptor const &dvDesc,
+    int dstInstanceStride,
+    int numInstances,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+
+    if (numPatchCoords <= 0 || numInstances <= 0) return true;
+    if (src == NULL) return false;
+
+    std::vector<const float *> srcInstances;
+    std::vector<float *> dstInstances, duInstances, dvInstances;
+    CpuGetInstancePointers(src, srcInstanceStride, numInstances, srcInstances);
+    CpuGetInstancePointers(dst, dstInstanceStride, numInstances, dstInstances);
+    CpuGetInstancePointers(du,  dstInstanceStride, numInstances, duInstances);
+    CpuGetInstancePointers(dv,  dstInstanceStride, numInstances, dvInstances);
+
+    return EvalPatchesInstanced(&srcInstances[0], srcDesc,
+                                dst ? &dstInstances[0] : NULL, dstDesc,
+                                du  ? &duInstances[0]  : NULL, duDesc,
+                                dv  ? &dvInstances[0]  : NULL, dvDesc,
+                                numInstances, numPatchCoords,
+                                patchCoords, patchArrays,
+                                patchIndexBuffer, patchParamBuffer);
+}
+
+/* static */
+bool
+OmpEvaluator::EvalPatchesInstanced(
+    const float * const *srcInstances, BufferDescriptor const &srcDesc,
+    float * const *dstInstances,       BufferDescriptor const &dstDesc,
+    float * const *duInstances,        BufferDescriptor const &duDesc,
+    float * const *dvInstances,        BufferDescriptor const &dvDesc,
+    int numInstances,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+
+    if (numPatchCoords <= 0 || numInstances <= 0) return true;
+    if (srcInstances == NULL) return false;
+    if (dstInstances && srcDesc.length != dstDesc.length) return false;
+    if (duInstances && srcDesc.length != duDesc.length) return false;
+    if (dvInstances && srcDesc.length != dvDesc.length) return false;
+
+    // blocks of patch coordinates, each evaluated for all the instances
+    int const blockSize = 64;
+    int numBlocks = (numPatchCoords + blockSize - 1) / blockSize;
+
+#pragma omp parallel for
+    for (int i = 0; i < numBlocks; ++i) {
+        int start = i * blockSize;
+        int end = std::min(start + blockSize, numPatchCoords);
+
+        CpuEvalPatchesInstanced(srcInstances, srcDesc,
+                                dstInstances, dstDesc,
+                                duInstances, duDesc,
+                                dvInstances, dvDesc,
+                                0, numInstances, start, end,
+                                patchCoords, patchArrays,
+                                patchIndexBuffer, patchParamBuffer);
+    }
+
+    return true;
+}
+
+//
+//  Stencil subset evaluations
+//
+
+template <typename REAL>
+static void
+ompEvalStencilSubset(REAL const * src, BufferDescriptor const &srcDesc,
+                     REAL * dst,       BufferDescriptor const &dstDesc,
+                     int const * sizes,
+                     int const * offsets,
+                     int const * indices,
+                     REAL const * weights,
+                     int numStencilIndices,
+                     int const * stencilIndices,
+                     GrainPolicy const &grainPolicy) {
+
+    std::vector<int> ranges;
+    CpuPartitionStencilSubset(grainPolicy, sizes, stencilIndices,
+                              0, numStencilIndices, ranges);
+    int numRanges = (int)ranges.size() - 1;
+
+#pragma omp parallel for schedule(dynamic, 1) if (numRanges > 1)
+    for (int r = 0; r < numRanges; ++r) {
+        CpuEvalStencilSubset(src, srcDesc, dst, dstDesc,
+                             sizes, offsets, indices, weights,
+                             stencilIndices, ranges[r], ranges[r+1]);
+    }
+}
+
+/* static */
+bool
+OmpEvaluator::EvalStencilsSubset(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const float * weights,
+    int numStencilIndices,
+    const int * stencilIndices,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, numStencilIndices);
+
+    if (numStencilIndices <= 0) return true;
+    if (srcDesc.length != dstDesc.length) return false;
+
+    ompEvalStencilSubset(src, srcDesc, dst, dstDesc,
+                         sizes, offsets, indices, weights,
+                         numStencilIndices, stencilIndices,
+                         grainPolicy);
+
+    return true;
+}
+
+/* static */
+bool
+OmpEvaluator::EvalStencilsSubset(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const double * weights,
+    int numStencilIndices,
+    const int * stencilIndices,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, numStencilIndices);
+
+    if (numStencilIndices <= 0) return true;
+    if (srcDesc.length != dstDesc.length) return false;
+
+    ompEvalStencilSubset(src, srcDesc, dst, dstDesc,
+                         sizes, offsets, indices, weights,
+                         numStencilIndices, stencilIndices,
+                         grainPolicy);
+
+    return true;
+}
+
+//
+//  Limit normal evaluations re-use the serial CPU kernels over ranges of
+//  stencils or blocks of patch coordinates:
+//
+
+template <typename REAL>
+static void
+ompEvalStencilNormals(REAL const * src, BufferDescriptor const &srcDesc,
+                      REAL * dst,       BufferDescriptor const &dstDesc,
+                      REAL * normal,    BufferDescriptor const &normalDesc,
+                      REAL * tangent,   BufferDescriptor const &tangentDesc,
+                      REAL * bitangent, BufferDescriptor const &bitangentDesc,
+                      int const * sizes,
+                      int const * offsets,
+                      int const * indices,
+                      REAL const * weights,
+                      REAL const * duWeights,
+                      REAL const * dvWeights,
+                      REAL const * duuWeights,
+                      REAL const * duvWeights,
+                      REAL const * dvvWeights,
+                      int start, int end,
+                      GrainPolicy const &grainPolicy) {
+
+    std::vector<int> ranges;
+    CpuPartitionStencils(grainPolicy, sizes, offsets,
+                         start, end, ranges);
+    int numRanges = (int)ranges.size() - 1;
+
+#pragma omp parallel for schedule(dynamic, 1) if (numRanges > 1)
+    for (int r = 0; r < numRanges; ++r) {
+        // outputs are indexed relative to the first stencil of the range
+        int i = ranges[r] - start;
+
+        CpuEvalStencilNormals(
+            src, srcDesc,
+            CpuGetElementPointer(dst,       i, dstDesc.stride),    dstDesc,
+            CpuGetElementPointer(normal,    i, normalDesc.stride), normalDesc,
+            CpuGetElementPointer(tangent,   i, tangentDesc.stride),
+            tangentDesc,
+            CpuGetElementPointer(bitangent, i, bitangentDesc.stride),
+            bitangentDesc,
+            sizes, offsets, indices, weights, duWeights, dvWeights,
+            duuWeights, duvWeights, dvvWeights,
+            ranges[r], ranges[r+1]);
+    }
+}
+
+template <typename REAL>
+static void
+ompEvalPatchNormals(REAL const * src, BufferDescriptor const &srcDesc,
+                    REAL * dst,       BufferDescriptor const &dstDesc,
+                    REAL * normal,    BufferDescriptor const &normalDesc,
+                    REAL * tangent,   BufferDescriptor const &tangentDesc,
+                    REAL * bitangent, BufferDescriptor const &bitangentDesc,
+                    int numPatchCoords,
+                    PatchCoord const * patchCoords,
+                    PatchArray const * patchArrays,
+                    int const * patchIndexBuffer,
+                    PatchParam const * patchParamBuffer) {
+
+    int const blockSize = 256;
+    int numBlocks = (numPatchCoords + blockSize - 1) / blockSize;
+
+#pragma omp parallel for
+    for (int i = 0; i < numBlocks; ++i) {
+        int start = i * blockSize;
+        int end = std::min(start + blockSize, numPatchCoords);
+
+        CpuEvalPatchNormals(src, srcDesc, dst, dstDesc,
+                            normal, normalDesc, tangent, tangentDesc,
+                            bitangent, bitangentDesc,
+                            start, end, patchCoords, patchArrays,
+                            patchIndexBuffer, patchParamBuffer);
+    }
+}
+
+/* static */
+bool
+OmpEvaluator::EvalStencilsNormals(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    float *normal,    BufferDescriptor const &normalDesc,
+    float *tangent,   BufferDescriptor const &tangentDesc,
+    float *bitangent, BufferDescriptor const &bitangentDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const float * weights,
+    const float * duWeights,
+    const float * dvWeights,
+    const float * duuWeights,
+    const float * duvWeights,
+    const float * dvvWeights,
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+    if (srcDesc.length < 3) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (normal && normalDesc.length < 3) return false;
+    if (tangent && tangentDesc.length < 3) return false;
+    if (bitangent && bitangentDesc.length < 3) return false;
+
+    ompEvalStencilNormals(src, srcDesc, dst, dstDesc,
+                          normal, normalDesc, tangent, tangentDesc,
+                          bitangent, bitangentDesc,
+                          sizes, offsets, indices, weights,
+                          duWeights, dvWeights,
+                          duuWeights, duvWeights, dvvWeights,
+                          start, end,
+                          grainPolicy);
+
+    return true;
+}
+
+/* static */
+bool
+OmpEvaluator::EvalStencilsNormals(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    double *normal,    BufferDescriptor const &normalDesc,
+    double *tangent,   BufferDescriptor const &tangentDesc,
+    double *bitangent, BufferDescriptor const &bitangentDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const double * weights,
+    const double * duWeights,
+    const double * dvWeights,
+    const double * duuWeights,
+    const double * duvWeights,
+    const double * dvvWeights,
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+    if (srcDesc.length < 3) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (normal && normalDesc.length < 3) return false;
+    if (tangent && tangentDesc.length < 3) return false;
+    if (bitangent && bitangentDesc.length < 3) return false;
+
+    ompEvalStencilNormals(src, srcDesc, dst, dstDesc,
+                          normal, normalDesc, tangent, tangentDesc,
+                          bitangent, bitangentDesc,
+                          sizes, offsets, indices, weights,
+                          duWeights, dvWeights,
+                          duuWeights, duvWeights, dvvWeights,
+                          start, end,
+                          grainPolicy);
+
+    return true;
+}
+
+/* static */
+bool
+OmpEvaluator::EvalPatchesNormals(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    float *normal,    BufferDescriptor const &normalDesc,
+    float *tangent,   BufferDescriptor const &tangentDesc,
+    float *bitangent, BufferDescriptor const &bitangentDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (numPatchCoords <= 0) return true;
+    if (src == NULL || srcDesc.length < 3) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (normal && normalDesc.length < 3) return false;
+    if (tangent && tangentDesc.length < 3) return false;
+    if (bitangent && bitangentDesc.length < 3) return false;
+
+    ompEvalPatchNormals(src, srcDesc, dst, dstDesc,
+                        normal, normalDesc, tangent, tangentDesc,
+                        bitangent, bitangentDesc,
+                        numPatchCoords, patchCoords, patchArrays,
+                        patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
+/* static */
+bool
+OmpEvaluator::EvalPatchesNormals(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    double *normal,    BufferDescriptor const &normalDesc,
+    double *tangent,   BufferDescriptor const &tangentDesc,
+    double *bitangent, BufferDescriptor const &bitangentDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (numPatchCoords <= 0) return true;
+    if (src == NULL || srcDesc.length < 3) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (normal && normalDesc.length < 3) return false;
+    if (tangent && tangentDesc.length < 3) return false;
+    if (bitangent && bitangentDesc.length < 3) return false;
+
+    ompEvalPatchNormals(src, srcDesc, dst, dstDesc,
+                        normal, normalDesc, tangent, tangentDesc,
+                        bitangent, bitangentDesc,
+                        numPatchCoords, patchCoords, patchArrays,
+                        patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
+//
+//  Packed output evaluations re-use the serial CPU kernels over ranges of
+//  stencils or blocks of patch coordinates:
+//
+
+static void
+ompEvalStencilsPacked(float const * src, BufferDescriptor const &srcDesc,
+                      void * dst, PackedBufferDescriptor const &dstDesc,
+                      int const * sizes,
+                      int const * offsets,
+                      int const * indices,
+                      float const * weights,
+                      int start, int end,
+                      GrainPolicy const &grainPolicy) {
+
+    std::vector<int> ranges;
+    CpuPartitionStencils(grainPolicy, sizes, offsets,
+                         start, end, ranges);
+    int numRanges = (int)ranges.size() - 1;
+
+#pragma omp parallel for schedule(dynamic, 1) if (numRanges > 1)
+    for (int r = 0; r < numRanges; ++r) {
+        // outputs are indexed relative to the first stencil of the range
+        unsigned char * rangeDst = CpuGetElementPointer(
+            (unsigned char *)dst, ranges[r] - start, dstDesc.stride);
+
+        CpuEvalStencilsPacked(src, srcDesc, rangeDst, dstDesc,
+                              sizes, offsets, indices, weights,
+                              ranges[r], ranges[r+1]);
+    }
+}
+
+static void
+ompEvalPatchesPacked(float const * src, BufferDescriptor const &srcDesc,
+                     void * dst, PackedBufferDescriptor const &dstDesc,
+                     void * normal, PackedBufferDescriptor const &normalDesc,
+                     int numPatchCoords,
+                     PatchCoord const * patchCoords,
+                     PatchArray const * patchArrays,
+                     int const * patchIndexBuffer,
+                     PatchParam const * patchParamBuffer) {
+
+    int const blockSize = 256;
+    int numBlocks = (numPatchCoords + blockSize - 1) / blockSize;
+
+#pragma omp parallel for
+    for (int i = 0; i < numBlocks; ++i) {
+        int start = i * blockSize;
+        int end = std::min(start + blockSize, numPatchCoords);
+
+        CpuEvalPatchesPacked(src, srcDesc, dst, dstDesc,
+                             normal, normalDesc,
+                             start, end, patchCoords, patchArrays,
+                             patchIndexBuffer, patchParamBuffer);
+    }
+}
+
+/* static */
+bool
+OmpEvaluator::EvalStencilsPacked(
+    const float *src, BufferDescriptor const &srcDesc,
+    void *dst,        PackedBufferDescriptor const &dstDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const float * weights,
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+    if (dst == NULL || !dstDesc.IsValid()) return false;
+    if (srcDesc.length != dstDesc.length) return false;
+
+    ompEvalStencilsPacked(src, srcDesc, dst, dstDesc,
+                          sizes, offsets, indices, weights,
+                          start, end,
+                          grainPolicy);
+
+    return true;
+}
+
+/* static */
+bool
+OmpEvaluator::EvalPatchesPacked(
+    const float *src, BufferDescriptor const &srcDesc,
+    void *dst,        PackedBufferDescriptor const &dstDesc,
+    void *normal,     PackedBufferDescriptor const &normalDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (numPatchCoords <= 0) return true;
+    if (src == NULL) return false;
+    if (dst && (!dstDesc.IsValid() || srcDesc.length != dstDesc.length)) {
+        return false;
+    }
+    if (normal && (!normalDesc.IsValid() || normalDesc.length != 3 ||
+                   srcDesc.length < 3)) {
+        return false;
+    }
+
+    ompEvalPatchesPacked(src, srcDesc, dst, dstDesc,
+                         normal, normalDesc,
+                         numPatchCoords, patchCoords, patchArrays,
+                         patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
 /* static */
 void
 OmpEvaluator::Synchronize(void * /*deviceContext*/) {
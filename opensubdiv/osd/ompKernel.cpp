@@ -24,6 +24,8 @@
 
 #include "../osd/ompKernel.h"
 #include "../osd/bufferDescriptor.h"
+#include "../osd/cpuKernel.h"
+#include "../osd/grainPolicy.h"
 
 #include <cassert>
 #include <cstdlib>
@@ -41,15 +43,17 @@ elementAtIndex(T * src, int index, BufferDescriptor const &desc) {
     return src + index * desc.stride;
 }
 
+template <typename REAL>
 static inline void
-clear(float *dst, BufferDescriptor const &desc) {
+clear(REAL *dst, BufferDescriptor const &desc) {
 
     assert(dst);
-    memset(dst, 0, desc.length*sizeof(float));
+    memset(dst, 0, desc.length*sizeof(REAL));
 }
 
+template <typename REAL>
 static inline void
-addWithWeight(float *dst, const float *src, int srcIndex, float weight,
+addWithWeight(REAL *dst, const REAL *src, int srcIndex, REAL weight,
               BufferDescriptor const &desc) {
 
     assert(src && dst);
@@ -59,73 +63,81 @@ addWithWeight(float *dst, const float *src, int srcIndex, float weight,
     }
 }
 
+template <typename REAL>
 static inline void
-copy(float *dst, int dstIndex, const float *src,
+copy(REAL *dst, int dstIndex, const REAL *src,
      BufferDescriptor const &desc) {
 
     assert(src && dst);
 
     dst = elementAtIndex(dst, dstIndex, desc);
-    memcpy(dst, src, desc.length*sizeof(float));
+    memcpy(dst, src, desc.length*sizeof(REAL));
 }
 
 
 // XXXX manuelk this should be optimized further by using SIMD - considering
 //              OMP is somewhat obsolete - this is probably not worth it.
-void
-OmpEvalStencils(float const * src, BufferDescriptor const &srcDesc,
-                float * dst,       BufferDescriptor const &dstDesc,
+template <typename REAL> void
+OmpEvalStencils(REAL const * src, BufferDescriptor const &srcDesc,
+                REAL * dst,       BufferDescriptor const &dstDesc,
                 int const * sizes,
                 int const * offsets,
                 int const * indices,
-                float const * weights,
-                int start, int end) {
+                REAL const * weights,
+                int start, int end,
+                GrainPolicy const &grainPolicy) {
     start = (start > 0 ? start : 0);
     
     src += srcDesc.offset;
     dst += dstDesc.offset;
 
     int numThreads = omp_get_max_threads();
-    int n = end - start;
 
-    float * result = (float*)alloca(srcDesc.length * numThreads * sizeof(float));
+    std::vector<int> ranges;
+    CpuPartitionStencils(grainPolicy, sizes, offsets, start, end, ranges);
+    int numRanges = (int)ranges.size() - 1;
 
-#pragma omp parallel for
-    for (int i = 0; i < n; ++i) {
+    REAL * result = (REAL*)alloca(srcDesc.length * numThreads * sizeof(REAL));
 
-        int index = i + start; // Stencil index
+#pragma omp parallel for schedule(dynamic, 1) if (numRanges > 1)
+    for (int r = 0; r < numRanges; ++r) {
+        for (int index = ranges[r]; index < ranges[r+1]; ++index) {
 
-        // Get thread-local pointers
-        int const           * threadIndices = indices + offsets[index];
-        float const         * threadWeights = weights + offsets[index];
+            int i = index - start; // Destination index
 
-        int threadId = omp_get_thread_num();
+            // Get thread-local pointers
+            int const           * threadIndices = indices + offsets[index];
+            REAL const         * threadWeights = weights + offsets[index];
 
-        float * threadResult = result + threadId*srcDesc.length;
+            int threadId = omp_get_thread_num();
 
-        clear(threadResult, dstDesc);
+            REAL * threadResult = result + threadId*srcDesc.length;
 
-        for (int j=0; j<(int)sizes[index]; ++j) {
-            addWithWeight(threadResult, src,
-                threadIndices[j], threadWeights[j], srcDesc);
-        }
+            clear(threadResult, dstDesc);
+
+            for (int j=0; j<(int)sizes[index]; ++j) {
+                addWithWeight(threadResult, src,
+                    threadIndices[j], threadWeights[j], srcDesc);
+            }
 
-        copy(dst, i, threadResult, dstDesc);
+            copy(dst, i, threadResult, dstDesc);
+        }
     }
 }
 
-void
-OmpEvalStencils(float const * src, BufferDescriptor const &srcDesc,
-                float * dst,       BufferDescriptor const &dstDesc,
-                float * dstDu,     BufferDescriptor const &dstDuDesc,
-                float * dstDv,     BufferDescriptor const &dstDvDesc,
+template <typename REAL> void
+OmpEvalStencils(REAL const * src, BufferDescriptor const &srcDesc,
+                REAL * dst,       BufferDescriptor const &dstDesc,
+                REAL * dstDu,     BufferDescriptor const &dstDuDesc,
+                REAL * dstDv,     BufferDescriptor const &dstDvDesc,
                 int const * sizes,
                 int const * offsets,
                 int const * indices,
-                float const * weights,
-                float const * duWeights,
-                float const * dvWeights,
-                int start, int end) {
+                REAL const * weights,
+                REAL const * duWeights,
+                REAL const * dvWeights,
+                int start, int end,
+                GrainPolicy const &grainPolicy) {
     start = (start > 0 ? start : 0);
 
     src += srcDesc.offset;
@@ -134,67 +146,73 @@ OmpEvalStencils(float const * src, BufferDescriptor const &srcDesc,
     dstDv += dstDvDesc.offset;
 
     int numThreads = omp_get_max_threads();
-    int n = end - start;
 
-    float * result = (float*)alloca(srcDesc.length * numThreads * sizeof(float));
-    float * resultDu = (float*)alloca(srcDesc.length * numThreads * sizeof(float));
-    float * resultDv = (float*)alloca(srcDesc.length * numThreads * sizeof(float));
+    std::vector<int> ranges;
+    CpuPartitionStencils(grainPolicy, sizes, offsets, start, end, ranges);
+    int numRanges = (int)ranges.size() - 1;
 
-#pragma omp parallel for
-    for (int i = 0; i < n; ++i) {
+    REAL * result = (REAL*)alloca(srcDesc.length * numThreads * sizeof(REAL));
+    REAL * resultDu = (REAL*)alloca(srcDesc.length * numThreads * sizeof(REAL));
+    REAL * resultDv = (REAL*)alloca(srcDesc.length * numThreads * sizeof(REAL));
 
-        int index = i + start; // Stencil index
+#pragma omp parallel for schedule(dynamic, 1) if (numRanges > 1)
+    for (int r = 0; r < numRanges; ++r) {
+        for (int index = ranges[r]; index < ranges[r+1]; ++index) {
 
-        // Get thread-local pointers
-        int const           * threadIndices = indices + offsets[index];
-        float const         * threadWeights = weights + offsets[index];
-        float const         * threadWeightsDu = duWeights + offsets[index];
-        float const         * threadWeightsDv = dvWeights + offsets[index];
+            int i = index - start; // Destination index
 
-        int threadId = omp_get_thread_num();
+            // Get thread-local pointers
+            int const           * threadIndices = indices + offsets[index];
+            REAL const         * threadWeights = weights + offsets[index];
+            REAL const         * threadWeightsDu = duWeights + offsets[index];
+            REAL const         * threadWeightsDv = dvWeights + offsets[index];
 
-        float * threadResult = result + threadId*srcDesc.length;
-        float * threadResultDu = resultDu + threadId*srcDesc.length;
-        float * threadResultDv = resultDv + threadId*srcDesc.length;
+            int threadId = omp_get_thread_num();
 
-        clear(threadResult, dstDesc);
-        clear(threadResultDu, dstDuDesc);
-        clear(threadResultDv, dstDvDesc);
+            REAL * threadResult = result + threadId*srcDesc.length;
+            REAL * threadResultDu = resultDu + threadId*srcDesc.length;
+            REAL * threadResultDv = resultDv + threadId*srcDesc.length;
 
-        for (int j=0; j<(int)sizes[index]; ++j) {
-            addWithWeight(threadResult, src,
-                threadIndices[j], threadWeights[j], srcDesc);
-            addWithWeight(threadResultDu, src,
-                threadIndices[j], threadWeightsDu[j], srcDesc);
-            addWithWeight(threadResultDv, src,
-                threadIndices[j], threadWeightsDv[j], srcDesc);
-        }
+            clear(threadResult, dstDesc);
+            clear(threadResultDu, dstDuDesc);
+            clear(threadResultDv, dstDvDesc);
+
+            for (int j=0; j<(int)sizes[index]; ++j) {
+                addWithWeight(threadResult, src,
+                    threadIndices[j], threadWeights[j], srcDesc);
+                addWithWeight(threadResultDu, src,
+                    threadIndices[j], threadWeightsDu[j], srcDesc);
+                addWithWeight(threadResultDv, src,
+                    threadIndices[j], threadWeightsDv[j], srcDesc);
+            }
 
-        copy(dst, i, threadResult, dstDesc);
-        copy(dstDu, i, threadResultDu, dstDuDesc);
-        copy(dstDv, i, threadResultDv, dstDvDesc);
+            copy(dst, i, threadResult, dstDesc);
+            copy(dstDu, i, threadResultDu, dstDuDesc);
+            copy(dstDv, i, threadResultDv, dstDvDesc);
+        }
     }
 
 }
 
-void
-OmpEvalStencils(float const * src, BufferDescriptor const &srcDesc,
-                float * dst,       BufferDescriptor const &dstDesc,
-                float * dstDu,     BufferDescriptor const &dstDuDesc,
-                float * dstDv,     BufferDescriptor const &dstDvDesc,
-                float * dstDuu,    BufferDescriptor const &dstDuuDesc,
-                float * dstDuv,    BufferDescriptor const &dstDuvDesc,
-                float * dstDvv,    BufferDescriptor const &dstDvvDesc,
+template <typename REAL> void
+OmpEvalStencils(REAL const * src, BufferDescriptor const &srcDesc,
+                REAL * dst,       BufferDescriptor const &dstDesc,
+                REAL * dstDu,     BufferDescriptor const &dstDuDesc,
+                REAL * dstDv,     BufferDescriptor const &dstDvDesc,
+                REAL * dstDuu,    BufferDescriptor const &dstDuuDesc,
+                REAL * dstDuv,    BufferDescriptor const &dstDuvDesc,
+                REAL * dstDvv,    BufferDescriptor const &dstDvvDesc,
                 int const * sizes,
                 int const * offsets,
                 int const * indices,
-                float const * weights,
-                float const * duWeights,
-                float const * dvWeights,
-                float const * duuWeights,
-                float const * duvWeights,
-                float const * dvvWeights,
-                int start, int end) {
+                REAL const * weights,
+                REAL const * duWeights,
+                REAL const * dvWeights,
+                REAL const * duuWeights,
+                REAL const * duvWeights,
+                REAL const * dvvWeights,
+                int start, int end,
+                GrainPolicy const &grainPolicy) {
     start = (start > 0 ? start : 0);
 
     src += srcDesc.offset;
@@ -206,70 +224,140 @@ OmpEvalStencils(float const * src, BufferDescriptor const &srcDesc,
     dstDvv += dstDvvDesc.offset;
 
     int numThreads = omp_get_max_threads();
-    int n = end - start;
-
-    float * result = (float*)alloca(srcDesc.length * numThreads * sizeof(float));
-    float * resultDu = (float*)alloca(srcDesc.length * numThreads * sizeof(float));
-    float * resultDv = (float*)alloca(srcDesc.length * numThreads * sizeof(float));
-    float * resultDuu = (float*)alloca(srcDesc.length * numThreads * sizeof(float));
-    float * resultDuv = (float*)alloca(srcDesc.length * numThreads * sizeof(float));
-    float * resultDvv = (float*)alloca(srcDesc.length * numThreads * sizeof(float));
-
-#pragma omp parallel for
-    for (int i = 0; i < n; ++i) {
-
-        int index = i + start; // Stencil index
-
-        // Get thread-local pointers
-        int const           * threadIndices = indices + offsets[index];
-        float const         * threadWeights = weights + offsets[index];
-        float const         * threadWeightsDu = duWeights + offsets[index];
-        float const         * threadWeightsDv = dvWeights + offsets[index];
-        float const         * threadWeightsDuu = duuWeights + offsets[index];
-        float const         * threadWeightsDuv = duvWeights + offsets[index];
-        float const         * threadWeightsDvv = dvvWeights + offsets[index];
-
-        int threadId = omp_get_thread_num();
-
-        float * threadResult = result + threadId*srcDesc.length;
-        float * threadResultDu = resultDu + threadId*srcDesc.length;
-        float * threadResultDv = resultDv + threadId*srcDesc.length;
-        float * threadResultDuu = resultDuu + threadId*srcDesc.length;
-        float * threadResultDuv = resultDuv + threadId*srcDesc.length;
-        float * threadResultDvv = resultDvv + threadId*srcDesc.length;
-
-        clear(threadResult, dstDesc);
-        clear(threadResultDu, dstDuDesc);
-        clear(threadResultDv, dstDvDesc);
-        clear(threadResultDuu, dstDuuDesc);
-        clear(threadResultDuv, dstDuvDesc);
-        clear(threadResultDvv, dstDvvDesc);
-
-        for (int j=0; j<(int)sizes[index]; ++j) {
-            addWithWeight(threadResult, src,
-                threadIndices[j], threadWeights[j], srcDesc);
-            addWithWeight(threadResultDu, src,
-                threadIndices[j], threadWeightsDu[j], srcDesc);
-            addWithWeight(threadResultDv, src,
-                threadIndices[j], threadWeightsDv[j], srcDesc);
-            addWithWeight(threadResultDuu, src,
-                threadIndices[j], threadWeightsDuu[j], srcDesc);
-            addWithWeight(threadResultDuv, src,
-                threadIndices[j], threadWeightsDuv[j], srcDesc);
-            addWithWeight(threadResultDvv, src,
-                threadIndices[j], threadWeightsDvv[j], srcDesc);
-        }
 
-        copy(dst, i, threadResult, dstDesc);
-        copy(dstDu, i, threadResultDu, dstDuDesc);
-        copy(dstDv, i, threadResultDv, dstDvDesc);
-        copy(dstDuu, i, threadResultDuu, dstDuuDesc);
-        copy(dstDuv, i, threadResultDuv, dstDuvDesc);
-        copy(dstDvv, i, threadResultDvv, dstDvvDesc);
+    std::vector<int> ranges;
+    CpuPartitionStencils(grainPolicy, sizes, offsets, start, end, ranges);
+    int numRanges = (int)ranges.size() - 1;
+
+    REAL * result = (REAL*)alloca(srcDesc.length * numThreads * sizeof(REAL));
+    REAL * resultDu = (REAL*)alloca(srcDesc.length * numThreads * sizeof(REAL));
+    REAL * resultDv = (REAL*)alloca(srcDesc.length * numThreads * sizeof(REAL));
+    REAL * resultDuu = (REAL*)alloca(srcDesc.length * numThreads * sizeof(REAL));
+    REAL * resultDuv = (REAL*)alloca(srcDesc.length * numThreads * sizeof(REAL));
+    REAL * resultDvv = (REAL*)alloca(srcDesc.length * numThreads * sizeof(REAL));
+
+#pragma omp parallel for schedule(dynamic, 1) if (numRanges > 1)
+    for (int r = 0; r < numRanges; ++r) {
+        for (int index = ranges[r]; index < ranges[r+1]; ++index) {
+
+            int i = index - start; // Destination index
+
+            // Get thread-local pointers
+            int const           * threadIndices = indices + offsets[index];
+            REAL const         * threadWeights = weights + offsets[index];
+            REAL const         * threadWeightsDu = duWeights + offsets[index];
+            REAL const         * threadWeightsDv = dvWeights + offsets[index];
+            REAL const         * threadWeightsDuu = duuWeights + offsets[index];
+            REAL const         * threadWeightsDuv = duvWeights + offsets[index];
+            REAL const         * threadWeightsDvv = dvvWeights + offsets[index];
+
+            int threadId = omp_get_thread_num();
+
+            REAL * threadResult = result + threadId*srcDesc.length;
+            REAL * threadResultDu = resultDu + threadId*srcDesc.length;
+            REAL * threadResultDv = resultDv + threadId*srcDesc.length;
+            REAL * threadResultDuu = resultDuu + threadId*srcDesc.length;
+            REAL * threadResultDuv = resultDuv + threadId*srcDesc.length;
+            REAL * threadResultDvv = resultDvv + threadId*srcDesc.length;
+
+            clear(threadResult, dstDesc);
+            clear(threadResultDu, dstDuDesc);
+            clear(threadResultDv, dstDvDesc);
+            clear(threadResultDuu, dstDuuDesc);
+            clear(threadResultDuv, dstDuvDesc);
+            clear(threadResultDvv, dstDvvDesc);
+
+            for (int j=0; j<(int)sizes[index]; ++j) {
+                addWithWeight(threadResult, src,
+                    threadIndices[j], threadWeights[j], srcDesc);
+                addWithWeight(threadResultDu, src,
+                    threadIndices[j], threadWeightsDu[j], srcDesc);
+                addWithWeight(threadResultDv, src,
+                    threadIndices[j], threadWeightsDv[j], srcDesc);
+                addWithWeight(threadResultDuu, src,
+                    threadIndices[j], threadWeightsDuu[j], srcDesc);
+                addWithWeight(threadResultDuv, src,
+                    threadIndices[j], threadWeightsDuv[j], srcDesc);
+                addWithWeight(threadResultDvv, src,
+                    threadIndices[j], threadWeightsDvv[j], srcDesc);
+            }
+
+            copy(dst, i, threadResult, dstDesc);
+            copy(dstDu, i, threadResultDu, dstDuDesc);
+            copy(dstDv, i, threadResultDv, dstDvDesc);
+            copy(dstDuu, i, threadResultDuu, dstDuuDesc);
+            copy(dstDuv, i, threadResultDuv, dstDuvDesc);
+            copy(dstDvv, i, threadResultDvv, dstDvvDesc);
+        }
     }
 
 }
 
+//
+//  Explicit instantiation for single and double precision:
+//
+template void
+OmpEvalStencils<float>(float const *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       int const *, int const *, int const *, float const *,
+                       int, int,
+                       GrainPolicy const &);
+
+template void
+OmpEvalStencils<float>(float const *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       int const *, int const *, int const *,
+                       float const *, float const *, float const *,
+                       int, int,
+                       GrainPolicy const &);
+
+template void
+OmpEvalStencils<float>(float const *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       int const *, int const *, int const *,
+                       float const *, float const *, float const *,
+                       float const *, float const *, float const *,
+                       int, int,
+                       GrainPolicy const &);
+
+template void
+OmpEvalStencils<double>(double const *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        int const *, int const *, int const *, double const *,
+                        int, int,
+                        GrainPolicy const &);
+
+template void
+OmpEvalStencils<double>(double const *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        int const *, int const *, int const *,
+                        double const *, double const *, double const *,
+                        int, int,
+                        GrainPolicy const &);
+
+template void
+OmpEvalStencils<double>(double const *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        int const *, int const *, int const *,
+                        double const *, double const *, double const *,
+                        double const *, double const *, double const *,
+                        int, int,
+                        GrainPolicy const &);
+
 }  // end namespace Osd
 
 }  // end namespace OPENSUBDIV_VERSION
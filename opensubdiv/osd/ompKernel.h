@@ -33,47 +33,56 @@ namespace OPENSUBDIV_VERSION {
 namespace Osd {
 
 struct BufferDescriptor;
+struct GrainPolicy;
 
-void
-OmpEvalStencils(float const * src, BufferDescriptor const &srcDesc,
-                float * dst,       BufferDescriptor const &dstDesc,
+//
+// Stencil kernels, instantiated for float and double precision, partitioned
+// into tasks according to a grain policy
+//
+
+template <typename REAL> void
+OmpEvalStencils(REAL const * src, BufferDescriptor const &srcDesc,
+                REAL * dst,       BufferDescriptor const &dstDesc,
                 int const * sizes,
                 int const * offsets,
                 int const * indices,
-                float const * weights,
-                int start, int end);
+                REAL const * weights,
+                int start, int end,
+                GrainPolicy const &grainPolicy);
 
-void
-OmpEvalStencils(float const * src, BufferDescriptor const &srcDesc,
-                float * dst,       BufferDescriptor const &dstDesc,
-                float * dstDu,     BufferDescriptor const &dstDuDesc,
-                float * dstDv,     BufferDescriptor const &dstDvDesc,
+template <typename REAL> void
+OmpEvalStencils(REAL const * src, BufferDescriptor const &srcDesc,
+                REAL * dst,       BufferDescriptor const &dstDesc,
+                REAL * dstDu,     BufferDescriptor const &dstDuDesc,
+                REAL * dstDv,     BufferDescriptor const &dstDvDesc,
                 int const * sizes,
                 int const * offsets,
                 int const * indices,
-                float const * weights,
-                float const * duWeights,
-                float const * dvWeights,
-                int start, int end);
+                REAL const * weights,
+                REAL const * duWeights,
+                REAL const * dvWeights,
+                int start, int end,
+                GrainPolicy const &grainPolicy);
 
-void
-OmpEvalStencils(float const * src, BufferDescriptor const &srcDesc,
-                float * dst,       BufferDescriptor const &dstDesc,
-                float * dstDu,     BufferDescriptor const &dstDuDesc,
-                float * dstDv,     BufferDescriptor const &dstDvDesc,
-                float * dstDuu,    BufferDescriptor const &dstDuuDesc,
-                float * dstDuv,    BufferDescriptor const &dstDuvDesc,
-                float * dstDvv,    BufferDescriptor const &dstDvvDesc,
+template <typename REAL> void
+OmpEvalStencils(REAL const * src, BufferDescriptor const &srcDesc,
+                REAL * dst,       BufferDescriptor const &dstDesc,
+                REAL * dstDu,     BufferDescriptor const &dstDuDesc,
+                REAL * dstDv,     BufferDescriptor const &dstDvDesc,
+                REAL * dstDuu,    BufferDescriptor const &dstDuuDesc,
+                REAL * dstDuv,    BufferDescriptor const &dstDuvDesc,
+                REAL * dstDvv,    BufferDescriptor const &dstDvvDesc,
                 int const * sizes,
                 int const * offsets,
                 int const * indices,
-                float const * weights,
-                float const * duWeights,
-                float const * dvWeights,
-                float const * duuWeights,
-                float const * duvWeights,
-                float const * dvvWeights,
-                int start, int end);
+                REAL const * weights,
+                REAL const * duWeights,
+                REAL const * dvWeights,
+                REAL const * duuWeights,
+                REAL const * duvWeights,
+                REAL const * dvvWeights,
+                int start, int end,
+                GrainPolicy const &grainPolicy);
 
 } // end namespace Osd
 
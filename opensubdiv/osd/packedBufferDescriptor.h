@@ -0,0 +1,133 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#ifndef OPENSUBDIV3_OSD_PACKED_BUFFER_DESCRIPTOR_H
+#define OPENSUBDIV3_OSD_PACKED_BUFFER_DESCRIPTOR_H
+
+#include "../version.h"
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Osd {
+
+/// \brief PackedBufferDescriptor describes primvar elements written in a
+///        compact encoding to interleaved data buffers, e.g. to vertex
+///        buffers consumed directly by a renderer.
+///
+///        The CPU evaluators encode the elements as they are evaluated, so
+///        the float results are never written to memory. Before they are
+///        encoded, the elements are mapped as (value - origin) * scale,
+///        e.g. to positions relative to the origin of their bounds or to
+///        uvs in [0,1].
+///
+///        * Note that unlike BufferDescriptor, offsets and strides are in
+///          bytes since the size of an element depends on its format.
+///
+
+//  example:
+//       n
+//  -----+-----------------------------------+------------------------------
+//       |             vertex  0             |
+//  -----+-----------------------------------+------------------------------
+//       |  X  Y  Z  -  Nx Ny  U  V          |
+//  -----+-----------------------------------+------------------------------
+//       <--------- stride = 16 bytes ------->
+//
+//     - XYZ  (offset = n+0,  length = 3, stride = 16, FORMAT_HALF)
+//     - N    (offset = n+8,  length = 3, stride = 16, FORMAT_OCT16)
+//     - UV   (offset = n+12, length = 2, stride = 16, FORMAT_UNORM16)
+//
+struct PackedBufferDescriptor {
+
+    enum Format {
+        FORMAT_FLOAT,    ///< 32-bit floats
+        FORMAT_HALF,     ///< 16-bit IEEE half floats
+        FORMAT_SNORM16,  ///< 16-bit signed normalized integers in [-1,1]
+        FORMAT_UNORM16,  ///< 16-bit unsigned normalized integers in [0,1]
+        FORMAT_OCT16     ///< unit 3-vectors (e.g. normals) mapped to the
+                         ///< octahedron, as two 16-bit signed normalized
+                         ///< integers -- origin and scale are not applied
+    };
+
+    /// Maximum number of elements that can be encoded
+    enum { MAX_LENGTH = 4 };
+
+    /// Default Constructor
+    PackedBufferDescriptor() :
+        offset(0), length(0), stride(0), format(FORMAT_FLOAT) {
+        SetTransform(0, 0);
+    }
+
+    /// Constructor
+    PackedBufferDescriptor(int o, int l, int s, Format f) :
+        offset(o), length(l), stride(s), format(f) {
+        SetTransform(0, 0);
+    }
+
+    /// \brief Sets the origin and scale mapping the elements before they
+    ///        are encoded (NULL for an origin of 0 or a scale of 1)
+    void SetTransform(float const * originIn, float const * scaleIn) {
+        for (int i = 0; i < MAX_LENGTH; ++i) {
+            origin[i] = originIn ? originIn[i] : 0.0f;
+            scale[i]  = scaleIn  ? scaleIn[i]  : 1.0f;
+        }
+    }
+
+    /// Returns the size in bytes of the encoded elements
+    int GetEncodedSize() const {
+        if (format == FORMAT_OCT16) return 4;
+        return length * ((format == FORMAT_FLOAT) ? 4 : 2);
+    }
+
+    /// True if the descriptor values are internally consistent
+    bool IsValid() const {
+        if (length <= 0 || length > MAX_LENGTH) return false;
+        if (format == FORMAT_OCT16 && length != 3) return false;
+        return (offset >= 0) && (GetEncodedSize() <= stride);
+    }
+
+    /// offset in bytes to the first element
+    int offset;
+    /// number of elements (of the source primvar)
+    int length;
+    /// stride in bytes to the next set of elements
+    int stride;
+    /// encoding of the elements
+    Format format;
+
+    /// origin subtracted from the elements before they are encoded
+    float origin[MAX_LENGTH];
+    /// scale applied to the elements before they are encoded
+    float scale[MAX_LENGTH];
+};
+
+} // end namespace Osd
+
+} // end namespace OPENSUBDIV_VERSION
+using namespace OPENSUBDIV_VERSION;
+
+} // end namespace OpenSubdiv
+
+#endif  // OPENSUBDIV3_OSD_PACKED_BUFFER_DESCRIPTOR_H
@@ -0,0 +1,1237 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#include "../osd/patchBVH.h"
+#include "../osd/threadPool.h"
+#include "../far/patchBasis.h"
+#include "../far/patchDescriptor.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Osd {
+
+namespace {
+
+    inline bool
+    isTriangle(int patchType) {
+        return (patchType == Far::PatchDescriptor::LOOP) ||
+               (patchType == Far::PatchDescriptor::GREGORY_TRIANGLE) ||
+               (patchType == Far::PatchDescriptor::TRIANGLES);
+    }
+
+    inline bool
+    isSupported(int patchType) {
+        return (patchType == Far::PatchDescriptor::REGULAR) ||
+               (patchType == Far::PatchDescriptor::GREGORY_BASIS) ||
+               (patchType == Far::PatchDescriptor::QUADS) ||
+               isTriangle(patchType);
+    }
+
+    inline float
+    dot(float const a[3], float const b[3]) {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+
+    inline void
+    extendBounds(float lower[3], float upper[3], float const p[3]) {
+        for (int k = 0; k < 3; ++k) {
+            lower[k] = std::min(lower[k], p[k]);
+            upper[k] = std::max(upper[k], p[k]);
+        }
+    }
+
+    inline float
+    boundsDistanceSqrd(float const lower[3], float const upper[3],
+                       float const p[3]) {
+        float d2 = 0.0f;
+        for (int k = 0; k < 3; ++k) {
+            float d = std::max(std::max(lower[k] - p[k], p[k] - upper[k]), 0.0f);
+            d2 += d * d;
+        }
+        return d2;
+    }
+
+    inline void
+    clearBounds(float lower[3], float upper[3]) {
+        lower[0] = lower[1] = lower[2] =  FLT_MAX;
+        upper[0] = upper[1] = upper[2] = -FLT_MAX;
+    }
+
+    //  Pads bounds by the precision of their coordinates, so that bounds
+    //  of adjacent sub-patches overlap despite the rounding of the points
+    //  bounded by each (rays along their shared edge cross both):
+    inline void
+    padBounds(float lower[3], float upper[3]) {
+        for (int k = 0; k < 3; ++k) {
+            float pad = 16.0f * FLT_EPSILON *
+                        std::max(std::abs(lower[k]), std::abs(upper[k]));
+            lower[k] -= pad;
+            upper[k] += pad;
+        }
+    }
+
+    //
+    //  Conversion of a cubic B-spline curve to Bezier form, and extraction
+    //  of the Bezier curve of a sub-interval [a,b] by de Casteljau splits
+    //  (applied to points of three floats separated by a stride):
+    //
+    void
+    convertBSplineToBezier(float * p, int stride) {
+
+        float * p0 = p;
+        float * p1 = p + stride;
+        float * p2 = p + stride * 2;
+        float * p3 = p + stride * 3;
+
+        for (int k = 0; k < 3; ++k) {
+            float b0 = p0[k], b1 = p1[k], b2 = p2[k], b3 = p3[k];
+
+            p0[k] = (b0 + 4.0f * b1 + b2) / 6.0f;
+            p1[k] = (2.0f * b1 + b2) / 3.0f;
+            p2[k] = (b1 + 2.0f * b2) / 3.0f;
+            p3[k] = (b1 + 4.0f * b2 + b3) / 6.0f;
+        }
+    }
+
+    void
+    splitBezier(float * p, int stride, float x, bool keepLeft) {
+
+        float * p0 = p;
+        float * p1 = p + stride;
+        float * p2 = p + stride * 2;
+        float * p3 = p + stride * 3;
+
+        for (int k = 0; k < 3; ++k) {
+            float a0 = p0[k] + x * (p1[k] - p0[k]);
+            float a1 = p1[k] + x * (p2[k] - p1[k]);
+            float a2 = p2[k] + x * (p3[k] - p2[k]);
+            float b0 = a0 + x * (a1 - a0);
+            float b1 = a1 + x * (a2 - a1);
+            float c0 = b0 + x * (b1 - b0);
+
+            if (keepLeft) {
+                p1[k] = a0;
+                p2[k] = b0;
+                p3[k] = c0;
+            } else {
+                p0[k] = c0;
+                p1[k] = b1;
+                p2[k] = a2;
+            }
+        }
+    }
+
+    void
+    extractBezier(float * p, int stride, float a, float b) {
+
+        if (b < 1.0f) {
+            splitBezier(p, stride, b, true);
+        }
+        if (a > 0.0f) {
+            splitBezier(p, stride, a / b, false);
+        }
+    }
+
+    //  Comparison of leaves by the coordinate of their centroids:
+    struct CompareCentroids {
+        CompareCentroids(float const * c, int a) : centroids(c), axis(a) { }
+
+        bool operator()(int a, int b) const {
+            return centroids[3 * a + axis] < centroids[3 * b + axis];
+        }
+
+        float const * centroids;
+        int           axis;
+    };
+
+    //  Number of rays of a packet traversing the hierarchy together:
+    int const PACKET_SIZE = 64;
+
+    //  Depth of the traversal stacks -- the hierarchy is balanced:
+    int const STACK_SIZE = 128;
+
+} // end namespace
+
+//
+//  Data of a ray precomputed for traversal and intersection -- the ray is
+//  also represented as the intersection of two planes for the Newton
+//  iteration (the hit is where the surface lies on both planes):
+//
+struct PatchBVH::RayData {
+
+    void Initialize(Ray const & ray) {
+        std::memcpy(origin, ray.origin, 3 * sizeof(float));
+        std::memcpy(direction, ray.direction, 3 * sizeof(float));
+        tMin = ray.tMin;
+
+        for (int k = 0; k < 3; ++k) {
+            invDirection[k] = 1.0f / direction[k];
+        }
+
+        float const * d = direction;
+        if ((std::abs(d[0]) > std::abs(d[1])) &&
+            (std::abs(d[0]) > std::abs(d[2]))) {
+            n1[0] = d[1]; n1[1] = -d[0]; n1[2] = 0.0f;
+        } else {
+            n1[0] = 0.0f; n1[1] = d[2];  n1[2] = -d[1];
+        }
+        float l1 = std::sqrt(dot(n1, n1));
+
+        n2[0] = n1[1] * d[2] - n1[2] * d[1];
+        n2[1] = n1[2] * d[0] - n1[0] * d[2];
+        n2[2] = n1[0] * d[1] - n1[1] * d[0];
+        float l2 = std::sqrt(dot(n2, n2));
+
+        valid = (l1 > 0.0f) && (l2 > 0.0f);
+        if (valid) {
+            for (int k = 0; k < 3; ++k) {
+                n1[k] /= l1;
+                n2[k] /= l2;
+            }
+            d1 = dot(n1, origin);
+            d2 = dot(n2, origin);
+            invDirectionLengthSqrd = 1.0f / dot(direction, direction);
+        }
+    }
+
+    //  Returns the ray parameter where the ray enters the bounds, if it
+    //  does so within [tMin, tMax]:
+    bool IntersectBounds(float const lower[3], float const upper[3],
+                         float tMax, float * tEntry) const {
+
+        float t0 = tMin;
+        float t1 = tMax;
+        for (int k = 0; k < 3; ++k) {
+            //  A ray parallel to the slab is either within it or misses
+            //  (the products below are NaN for an origin on its planes):
+            if (direction[k] == 0.0f) {
+                if ((origin[k] < lower[k]) || (origin[k] > upper[k])) {
+                    return false;
+                }
+                continue;
+            }
+            float tNear = (lower[k] - origin[k]) * invDirection[k];
+            float tFar  = (upper[k] - origin[k]) * invDirection[k];
+            if (tNear > tFar) std::swap(tNear, tFar);
+
+            t0 = (tNear > t0) ? tNear : t0;
+            t1 = (tFar  < t1) ? tFar  : t1;
+            if (t0 > t1) return false;
+        }
+        *tEntry = t0;
+        return true;
+    }
+
+    float origin[3];
+    float direction[3];
+    float invDirection[3];
+    float invDirectionLengthSqrd;
+    float tMin;
+
+    float n1[3], n2[3];
+    float d1, d2;
+    bool  valid;
+};
+
+// ---------------------------------------------------------------------------
+//
+//  Construction:
+//
+PatchBVH *
+PatchBVH::Create(Far::PatchTable const & patchTable,
+                 float const * points, int pointStride,
+                 Options const & options) {
+
+    PatchBVH * bvh = new PatchBVH();
+    bvh->_options = options;
+
+    //
+    //  Gather the patches of all supported types and their points:
+    //
+    int numArrays = patchTable.GetNumPatchArrays();
+    int numPoints = 0;
+
+    for (int array = 0, patchIndex = 0; array < numArrays; ++array) {
+        Far::PatchDescriptor desc = patchTable.GetPatchArrayDescriptor(array);
+
+        int numPatches = patchTable.GetNumPatches(array);
+        int patchSize  = desc.GetNumControlVertices();
+
+        if (!isSupported(desc.GetType())) {
+            patchIndex += numPatches;
+            continue;
+        }
+
+        for (int i = 0; i < numPatches; ++i, ++patchIndex) {
+            Patch patch;
+            patch.handle.arrayIndex = array;
+            patch.handle.patchIndex = patchIndex;
+            patch.handle.vertIndex  = i * patchSize;
+            patch.param       = patchTable.GetPatchParam(array, i);
+            patch.type        = desc.GetType();
+            patch.numPoints   = patchSize;
+            patch.pointOffset = (int)bvh->_patchPoints.size();
+
+            Far::ConstIndexArray cvs = patchTable.GetPatchVertices(array, i);
+            for (int j = 0; j < cvs.size(); ++j) {
+                bvh->_patchPoints.push_back(cvs[j]);
+                numPoints = std::max(numPoints, cvs[j] + 1);
+            }
+            bvh->_patches.push_back(patch);
+        }
+    }
+
+    bvh->_points.resize(numPoints * 3);
+    for (int i = 0; i < numPoints; ++i) {
+        std::memcpy(&bvh->_points[3 * i], points + i * pointStride,
+                    3 * sizeof(float));
+    }
+
+    bvh->buildSubPatches(std::max(options.subPatchDepth, 0),
+                         options.threadPool);
+    bvh->buildNodes(options.threadPool);
+    return bvh;
+}
+
+//
+//  Sub-patches and their bounds are computed independently for each patch:
+//
+struct PatchBVH::SubPatchesTask : public ThreadPool::Task {
+
+    SubPatchesTask(PatchBVH * bvh, int const * offsets, int depth) :
+        _bvh(bvh), _offsets(offsets), _depth(depth) { }
+
+    virtual void Run(int begin, int end) const {
+        for (int i = begin; i < end; ++i) {
+            buildPatch(i);
+        }
+    }
+
+    void buildPatch(int patchIndex) const {
+
+        Patch const & patch = _bvh->_patches[patchIndex];
+
+        int const * cvs = &_bvh->_patchPoints[patch.pointOffset];
+        int numCVs = patch.numPoints;
+
+        //
+        //  Points whose combinations by the (non-negative) basis without
+        //  boundary adjustments are the limit surface -- phantom points
+        //  are replaced by the combinations implied by the adjustments:
+        //
+        float hull[20 * 3];
+        for (int k = 0; k < numCVs; ++k) {
+            float w[20];
+            std::memset(w, 0, numCVs * sizeof(float));
+            w[k] = 1.0f;
+            Far::internal::AdjustPatchBasisForBoundaries(
+                patch.type, patch.param, w);
+
+            float * h = hull + 3 * k;
+            h[0] = h[1] = h[2] = 0.0f;
+            for (int m = 0; m < numCVs; ++m) {
+                if (w[m] == 0.0f) continue;
+                float const * p = &_bvh->_points[3 * cvs[m]];
+                h[0] += w[m] * p[0];
+                h[1] += w[m] * p[1];
+                h[2] += w[m] * p[2];
+            }
+        }
+
+        SubPatch * subPatches = &_bvh->_subPatches[_offsets[patchIndex]];
+        float    * bounds     = &_bvh->_subPatchBounds[6 * _offsets[patchIndex]];
+
+        if (patch.type != Far::PatchDescriptor::REGULAR) {
+            subPatches[0].patch = patchIndex;
+            subPatches[0].s0 = 0.0f;
+            subPatches[0].t0 = 0.0f;
+            subPatches[0].s1 = 1.0f;
+            subPatches[0].t1 = 1.0f;
+
+            clearBounds(bounds, bounds + 3);
+            for (int k = 0; k < numCVs; ++k) {
+                extendBounds(bounds, bounds + 3, hull + 3 * k);
+            }
+            padBounds(bounds, bounds + 3);
+            return;
+        }
+
+        //
+        //  Regular patches are converted to Bezier form (rows of 4 points
+        //  with increasing t) and the Bezier points of each sub-patch are
+        //  bounded:
+        //
+        for (int row = 0; row < 4; ++row) {
+            convertBSplineToBezier(hull + 12 * row, 3);
+        }
+        for (int col = 0; col < 4; ++col) {
+            convertBSplineToBezier(hull + 3 * col, 12);
+        }
+
+        int   n  = 1 << _depth;
+        float dx = 1.0f / (float)n;
+
+        for (int j = 0, k = 0; j < n; ++j) {
+            for (int i = 0; i < n; ++i, ++k) {
+                SubPatch & sub = subPatches[k];
+                sub.patch = patchIndex;
+                sub.s0 = (float)i * dx;
+                sub.t0 = (float)j * dx;
+                sub.s1 = (i == n - 1) ? 1.0f : (float)(i + 1) * dx;
+                sub.t1 = (j == n - 1) ? 1.0f : (float)(j + 1) * dx;
+
+                float bezier[16 * 3];
+                std::memcpy(bezier, hull, sizeof(bezier));
+                for (int row = 0; row < 4; ++row) {
+                    extractBezier(bezier + 12 * row, 3, sub.s0, sub.s1);
+                }
+                for (int col = 0; col < 4; ++col) {
+                    extractBezier(bezier + 3 * col, 12, sub.t0, sub.t1);
+                }
+
+                float * b = bounds + 6 * k;
+                clearBounds(b, b + 3);
+                for (int m = 0; m < 16; ++m) {
+                    extendBounds(b, b + 3, bezier + 3 * m);
+                }
+                padBounds(b, b + 3);
+            }
+        }
+    }
+
+    PatchBVH  * _bvh;
+    int const * _offsets;
+    int         _depth;
+};
+
+void
+PatchBVH::buildSubPatches(int subPatchDepth, ThreadPool * threadPool) {
+
+    int numPatches = (int)_patches.size();
+
+    std::vector<int> offsets(numPatches + 1, 0);
+    for (int i = 0; i < numPatches; ++i) {
+        bool split = (_patches[i].type == Far::PatchDescriptor::REGULAR);
+        offsets[i + 1] = offsets[i] + (split ? (1 << (2 * subPatchDepth)) : 1);
+    }
+
+    _subPatches.resize(offsets[numPatches]);
+    _subPatchBounds.resize(6 * offsets[numPatches]);
+
+    if (numPatches == 0) return;
+
+    SubPatchesTask task(this, &offsets[0], subPatchDepth);
+    if (threadPool) {
+        threadPool->ParallelFor(0, numPatches, 64, task);
+    } else {
+        task.Run(0, numPatches);
+    }
+}
+
+//
+//  The hierarchy is built top-down by splitting leaves at the median of
+//  their centroids along the axis of largest extent.  A subtree of N leaves
+//  occupies 2N-1 consecutive nodes, with the left child following its
+//  parent, so subtrees are independent and built in parallel once the top
+//  of the hierarchy has been split into tasks:
+//
+void
+PatchBVH::buildNode(int nodeIndex, int * leaves, int numLeaves,
+                    float const * centroids, int taskSize,
+                    std::vector<int> * tasks) {
+
+    Node & node = _nodes[nodeIndex];
+
+    if (numLeaves <= taskSize) {
+        //  Deferred to a task (recorded with its offset in the leaves):
+        tasks->push_back(nodeIndex);
+        tasks->push_back(numLeaves);
+        return;
+    }
+
+    float cLower[3], cUpper[3];
+    clearBounds(node.lower, node.upper);
+    clearBounds(cLower, cUpper);
+    for (int i = 0; i < numLeaves; ++i) {
+        float const * b = &_subPatchBounds[6 * leaves[i]];
+        extendBounds(node.lower, node.upper, b);
+        extendBounds(node.lower, node.upper, b + 3);
+        extendBounds(cLower, cUpper, centroids + 3 * leaves[i]);
+    }
+
+    if (numLeaves == 1) {
+        node.index = leaves[0];
+        node.axis  = -1;
+        return;
+    }
+
+    int axis = 0;
+    for (int k = 1; k < 3; ++k) {
+        if ((cUpper[k] - cLower[k]) > (cUpper[axis] - cLower[axis])) {
+            axis = k;
+        }
+    }
+
+    int numLeft = numLeaves / 2;
+    std::nth_element(leaves, leaves + numLeft, leaves + numLeaves,
+                     CompareCentroids(centroids, axis));
+
+    node.index = nodeIndex + 2 * numLeft;
+    node.axis  = axis;
+
+    buildNode(nodeIndex + 1, leaves, numLeft,
+              centroids, taskSize, tasks);
+    buildNode(nodeIndex + 2 * numLeft, leaves + numLeft, numLeaves - numLeft,
+              centroids, taskSize, tasks);
+}
+
+struct PatchBVH::NodesTask : public ThreadPool::Task {
+
+    NodesTask(PatchBVH * bvh, int * leaves, float const * centroids,
+              std::vector<int> const & tasks, std::vector<int> const & offsets) :
+        _bvh(bvh), _leaves(leaves), _centroids(centroids),
+        _tasks(tasks), _offsets(offsets) { }
+
+    virtual void Run(int begin, int end) const {
+        for (int i = begin; i < end; ++i) {
+            _bvh->buildNode(_tasks[2 * i], _leaves + _offsets[i],
+                            _tasks[2 * i + 1], _centroids, 0, 0);
+        }
+    }
+
+    PatchBVH               * _bvh;
+    int                    * _leaves;
+    float const            * _centroids;
+    std::vector<int> const & _tasks;
+    std::vector<int> const & _offsets;
+};
+
+void
+PatchBVH::buildNodes(ThreadPool * threadPool) {
+
+    int numLeaves = (int)_subPatches.size();
+
+    _nodes.clear();
+    if (numLeaves == 0) return;
+
+    _nodes.resize(2 * numLeaves - 1);
+
+    std::vector<int>   leaves(numLeaves);
+    std::vector<float> centroids(3 * numLeaves);
+    for (int i = 0; i < numLeaves; ++i) {
+        leaves[i] = i;
+        float const * b = &_subPatchBounds[6 * i];
+        for (int k = 0; k < 3; ++k) {
+            centroids[3 * i + k] = 0.5f * (b[k] + b[3 + k]);
+        }
+    }
+
+    //
+    //  Without a thread pool the hierarchy is built in one pass, otherwise
+    //  the top is split serially until subtrees are small enough to give
+    //  several tasks to each thread:
+    //
+    int taskSize = 0;
+    if (threadPool && (threadPool->GetNumThreads() > 1)) {
+        taskSize = std::max(numLeaves / (8 * threadPool->GetNumThreads()),
+                            1024);
+    }
+
+    std::vector<int> tasks;
+    buildNode(0, &leaves[0], numLeaves, &centroids[0], taskSize, &tasks);
+
+    if (!tasks.empty()) {
+        //  Tasks were recorded in order of their leaves:
+        int numTasks = (int)tasks.size() / 2;
+
+        std::vector<int> offsets(numTasks, 0);
+        for (int i = 1; i < numTasks; ++i) {
+            offsets[i] = offsets[i - 1] + tasks[2 * (i - 1) + 1];
+        }
+
+        NodesTask task(this, &leaves[0], &centroids[0], tasks, offsets);
+        threadPool->ParallelFor(0, numTasks, 1, task);
+    }
+}
+
+size_t
+PatchBVH::GetMemoryUsage() const {
+
+    return sizeof(PatchBVH) +
+           _patches.capacity()        * sizeof(Patch) +
+           _patchPoints.capacity()    * sizeof(int) +
+           _points.capacity()         * sizeof(float) +
+           _subPatches.capacity()     * sizeof(SubPatch) +
+           _subPatchBounds.capacity() * sizeof(float) +
+           _nodes.capacity()          * sizeof(Node);
+}
+
+// ---------------------------------------------------------------------------
+//
+//  Intersection:
+//
+void
+PatchBVH::evaluatePatch(Patch const & patch, float s, float t,
+                        float P[3], float Ds[3], float Dt[3]) const {
+
+    float wP[20], wDs[20], wDt[20];
+
+    Far::internal::EvaluatePatchBasisNormalized(
+        patch.type, patch.param, s, t, wP, wDs, wDt);
+
+    int const * cvs = &_patchPoints[patch.pointOffset];
+
+    P[0]  = P[1]  = P[2]  = 0.0f;
+    Ds[0] = Ds[1] = Ds[2] = 0.0f;
+    Dt[0] = Dt[1] = Dt[2] = 0.0f;
+    for (int i = 0; i < patch.numPoints; ++i) {
+        float const * p = &_points[3 * cvs[i]];
+        for (int k = 0; k < 3; ++k) {
+            P[k]  += wP[i]  * p[k];
+            Ds[k] += wDs[i] * p[k];
+            Dt[k] += wDt[i] * p[k];
+        }
+    }
+}
+
+bool
+PatchBVH::intersectSubPatch(int subPatchIndex, RayData const & ray,
+                            float tMax, Hit * hit) const {
+
+    SubPatch const & sub   = _subPatches[subPatchIndex];
+    Patch    const & patch = _patches[sub.patch];
+    float    const * b     = &_subPatchBounds[6 * subPatchIndex];
+
+    bool triangle = isTriangle(patch.type);
+
+    //
+    //  The distance to both planes of the ray is tolerated relative to
+    //  the size of the sub-patch, but no less than the precision of its
+    //  coordinates:
+    //
+    float diag = 0.0f, extent = 0.0f;
+    for (int k = 0; k < 3; ++k) {
+        diag  += (b[3 + k] - b[k]) * (b[3 + k] - b[k]);
+        extent = std::max(extent, std::max(std::abs(b[k]), std::abs(b[3 + k])));
+    }
+    float tolerance = std::max(_options.tolerance * std::sqrt(diag),
+                               8.0f * FLT_EPSILON * extent);
+
+    //  Intersections converged just outside the sub-patch are accepted
+    //  (and clamped) within a margin only wide enough for the precision
+    //  of the iteration, so that those on shared edges are not missed --
+    //  any wider and the clamped point is no longer on the ray:
+    float size   = std::max(sub.s1 - sub.s0, sub.t1 - sub.t0);
+    float margin = 1.0e-4f * size;
+
+    //
+    //  Newton iteration starts at the centers of the cells of an n x n grid
+    //  over the sub-patch and at its center (or at the centroids of the
+    //  n^2 triangles of a triangle), with a finer grid for patches that
+    //  are not split into sub-patches.  A sub-patch curved back towards
+    //  the ray may be intersected more than once and a start may converge
+    //  to any of the intersections, so all starts are evaluated and the
+    //  nearest intersection is kept:
+    //
+    int n = (patch.type == Far::PatchDescriptor::REGULAR) ? 2 : 4;
+
+    float starts[2 * (4 * 4 + 1)];
+    int numStarts = 0;
+    if (triangle) {
+        for (int j = 0; j < n; ++j) {
+            for (int i = 0; i + j < n; ++i) {
+                starts[2 * numStarts]     = ((float)i + 1.0f / 3.0f) / (float)n;
+                starts[2 * numStarts + 1] = ((float)j + 1.0f / 3.0f) / (float)n;
+                ++numStarts;
+                if (i + j < n - 1) {
+                    starts[2 * numStarts]     = ((float)i + 2.0f / 3.0f) / (float)n;
+                    starts[2 * numStarts + 1] = ((float)j + 2.0f / 3.0f) / (float)n;
+                    ++numStarts;
+                }
+            }
+        }
+    } else {
+        starts[0] = starts[1] = 0.5f;
+        numStarts = 1;
+        for (int j = 0; j < n; ++j) {
+            for (int i = 0; i < n; ++i, ++numStarts) {
+                starts[2 * numStarts]     = ((float)i + 0.5f) / (float)n;
+                starts[2 * numStarts + 1] = ((float)j + 0.5f) / (float)n;
+            }
+        }
+    }
+
+    bool  found = false;
+    float sHit = 0.0f, tParamHit = 0.0f;
+
+    for (int start = 0; start < numStarts; ++start) {
+        float const * st = starts + 2 * start;
+
+        float s = sub.s0 + st[0] * (sub.s1 - sub.s0);
+        float t = sub.t0 + st[1] * (sub.t1 - sub.t0);
+
+        float P[3], Ds[3], Dt[3];
+        bool converged = false;
+        for (int iter = 0; iter <= _options.maxNewtonIterations; ++iter) {
+            evaluatePatch(patch, s, t, P, Ds, Dt);
+
+            float f1 = dot(ray.n1, P) - ray.d1;
+            float f2 = dot(ray.n2, P) - ray.d2;
+            if ((std::abs(f1) + std::abs(f2)) <= tolerance) {
+                converged = true;
+                break;
+            }
+            if (iter == _options.maxNewtonIterations) break;
+
+            float j11 = dot(ray.n1, Ds), j12 = dot(ray.n1, Dt);
+            float j21 = dot(ray.n2, Ds), j22 = dot(ray.n2, Dt);
+
+            float det = j11 * j22 - j12 * j21;
+            if (det == 0.0f) break;
+
+            s -= (j22 * f1 - j12 * f2) / det;
+            t -= (j11 * f2 - j21 * f1) / det;
+
+            //  Abandon iterations diverging away from the sub-patch:
+            if ((s < sub.s0 - size) || (s > sub.s1 + size) ||
+                (t < sub.t0 - size) || (t > sub.t1 + size)) break;
+        }
+        if (!converged) continue;
+
+        if (triangle) {
+            if ((s < -margin) || (t < -margin) || (s + t > 1.0f + margin)) {
+                continue;
+            }
+        } else {
+            if ((s < sub.s0 - margin) || (s > sub.s1 + margin) ||
+                (t < sub.t0 - margin) || (t > sub.t1 + margin)) {
+                continue;
+            }
+        }
+
+        float d[3] = { P[0] - ray.origin[0],
+                       P[1] - ray.origin[1],
+                       P[2] - ray.origin[2] };
+        float tHit = dot(d, ray.direction) * ray.invDirectionLengthSqrd;
+        if ((tHit < ray.tMin) || (tHit > tMax)) continue;
+
+        //  Later starts must find a nearer intersection:
+        found     = true;
+        sHit      = s;
+        tParamHit = t;
+        tMax      = tHit;
+    }
+    if (!found) return false;
+
+    //  Clamp to the domain of the patch before conversion to the face:
+    float s = std::min(std::max(sHit, 0.0f), 1.0f);
+    float t = std::min(std::max(tParamHit, 0.0f), 1.0f);
+    if (triangle) {
+        if (s + t > 1.0f) {
+            float scale = 1.0f / (s + t);
+            s *= scale;
+            t *= scale;
+        }
+        patch.param.UnnormalizeTriangle(s, t);
+    } else {
+        patch.param.Unnormalize(s, t);
+    }
+
+    hit->faceId = patch.param.GetFaceId();
+    hit->u      = s;
+    hit->v      = t;
+    hit->t      = tMax;
+    hit->handle = patch.handle;
+    return true;
+}
+
+bool
+PatchBVH::Intersect(Ray const & ray, Hit * hit) const {
+
+    *hit = Hit();
+
+    RayData data;
+    data.Initialize(ray);
+    if (!data.valid || _nodes.empty()) return false;
+
+    struct Entry {
+        int   node;
+        float tEntry;
+    } stack[STACK_SIZE];
+
+    float tMax = ray.tMax;
+    float tEntry;
+    if (!data.IntersectBounds(_nodes[0].lower, _nodes[0].upper,
+                              tMax, &tEntry)) {
+        return false;
+    }
+
+    int stackSize = 0;
+    stack[stackSize].node   = 0;
+    stack[stackSize].tEntry = tEntry;
+    ++stackSize;
+
+    while (stackSize > 0) {
+        Entry entry = stack[--stackSize];
+        if (entry.tEntry > tMax) continue;
+
+        Node const & node = _nodes[entry.node];
+        if (node.axis < 0) {
+            if (intersectSubPatch(node.index, data, tMax, hit)) {
+                tMax = hit->t;
+            }
+            continue;
+        }
+
+        //  Push the nearer child last so that it is visited first:
+        int   children[2] = { entry.node + 1, node.index };
+        float tChild[2];
+        bool  hitChild[2];
+        for (int i = 0; i < 2; ++i) {
+            Node const & child = _nodes[children[i]];
+            hitChild[i] = data.IntersectBounds(child.lower, child.upper,
+                                               tMax, &tChild[i]);
+        }
+        int nearer = (hitChild[1] && (!hitChild[0] || (tChild[1] < tChild[0])))
+                   ? 1 : 0;
+        int farther = 1 - nearer;
+
+        if (hitChild[farther]) {
+            stack[stackSize].node   = children[farther];
+            stack[stackSize].tEntry = tChild[farther];
+            ++stackSize;
+        }
+        if (hitChild[nearer]) {
+            stack[stackSize].node   = children[nearer];
+            stack[stackSize].tEntry = tChild[nearer];
+            ++stackSize;
+        }
+    }
+    return hit->IsValid();
+}
+
+//
+//  Packets of rays traverse the hierarchy together, with a mask of the
+//  rays of the packet that cross each node:
+//
+int
+PatchBVH::intersectPacket(int numRays, Ray const * rays, Hit * hits) const {
+
+    typedef unsigned long long Mask;
+
+    RayData data[PACKET_SIZE];
+    float   tMax[PACKET_SIZE];
+
+    Mask active = 0;
+    for (int i = 0; i < numRays; ++i) {
+        hits[i] = Hit();
+        data[i].Initialize(rays[i]);
+        tMax[i] = rays[i].tMax;
+        if (data[i].valid) active |= (Mask)1 << i;
+    }
+    if ((active == 0) || _nodes.empty()) return 0;
+
+    struct Entry {
+        int  node;
+        Mask mask;
+    } stack[STACK_SIZE];
+
+    int stackSize = 0;
+    stack[stackSize].node = 0;
+    stack[stackSize].mask = active;
+    ++stackSize;
+
+    while (stackSize > 0) {
+        Entry entry = stack[--stackSize];
+        Node const & node = _nodes[entry.node];
+
+        Mask mask = 0;
+        int  first = -1;
+        for (int i = 0; i < numRays; ++i) {
+            if ((entry.mask & ((Mask)1 << i)) == 0) continue;
+
+            float tEntry;
+            if (data[i].IntersectBounds(node.lower, node.upper,
+                                        tMax[i], &tEntry)) {
+                mask |= (Mask)1 << i;
+                if (first < 0) first = i;
+            }
+        }
+        if (mask == 0) continue;
+
+        if (node.axis < 0) {
+            for (int i = first; i < numRays; ++i) {
+                if ((mask & ((Mask)1 << i)) == 0) continue;
+
+                if (intersectSubPatch(node.index, data[i], tMax[i], &hits[i])) {
+                    tMax[i] = hits[i].t;
+                }
+            }
+            continue;
+        }
+
+        //  Children are ordered by the direction of the first active ray:
+        int nearer  = entry.node + 1;
+        int farther = node.index;
+        if (data[first].direction[node.axis] < 0.0f) {
+            std::swap(nearer, farther);
+        }
+        stack[stackSize].node = farther;
+        stack[stackSize].mask = mask;
+        ++stackSize;
+        stack[stackSize].node = nearer;
+        stack[stackSize].mask = mask;
+        ++stackSize;
+    }
+
+    int numHits = 0;
+    for (int i = 0; i < numRays; ++i) {
+        numHits += hits[i].IsValid();
+    }
+    return numHits;
+}
+
+struct PatchBVH::StreamTask : public ThreadPool::Task {
+
+    StreamTask(PatchBVH const * bvh, int numRays, Ray const * rays,
+               Hit * hits) :
+        _bvh(bvh), _numRays(numRays), _rays(rays), _hits(hits) { }
+
+    virtual void Run(int begin, int end) const {
+        for (int packet = begin; packet < end; ++packet) {
+            int first = packet * PACKET_SIZE;
+            _bvh->intersectPacket(std::min(PACKET_SIZE, _numRays - first),
+                                  _rays + first, _hits + first);
+        }
+    }
+
+    PatchBVH const * _bvh;
+    int              _numRays;
+    Ray const      * _rays;
+    Hit            * _hits;
+};
+
+int
+PatchBVH::IntersectStream(int numRays, Ray const * rays, Hit * hits,
+                          ThreadPool * threadPool) const {
+
+    if (numRays <= 0) return 0;
+
+    int numPackets = (numRays + PACKET_SIZE - 1) / PACKET_SIZE;
+
+    StreamTask task(this, numRays, rays, hits);
+    if (threadPool) {
+        threadPool->ParallelFor(0, numPackets, 1, task);
+    } else {
+        task.Run(0, numPackets);
+    }
+
+    int numHits = 0;
+    for (int i = 0; i < numRays; ++i) {
+        numHits += hits[i].IsValid();
+    }
+    return numHits;
+}
+
+// ---------------------------------------------------------------------------
+//
+//  Closest points:
+//
+bool
+PatchBVH::projectSubPatch(int subPatchIndex, float const point[3],
+                          float maxDistance, ClosestPoint * closest) const {
+
+    SubPatch const & sub   = _subPatches[subPatchIndex];
+    Patch    const & patch = _patches[sub.patch];
+
+    bool triangle = isTriangle(patch.type);
+
+    float sSize = sub.s1 - sub.s0;
+    float tSize = sub.t1 - sub.t0;
+
+    //
+    //  The projection starts from the closest of a grid of samples of the
+    //  sub-patch (those within the domain of a triangle):
+    //
+    float const samples[3] = { 1.0f / 6.0f, 0.5f, 5.0f / 6.0f };
+
+    float P[3], Ds[3], Dt[3], r[3];
+    float s = 0.0f, t = 0.0f;
+    float bestP[3] = { 0.0f, 0.0f, 0.0f };
+    float bestS = 0.0f, bestT = 0.0f;
+    float bestDistSqrd = FLT_MAX;
+
+    for (int j = 0; j < 3; ++j) {
+        for (int i = 0; i < 3; ++i) {
+            if (triangle && ((samples[i] + samples[j]) > 1.0f)) continue;
+
+            s = sub.s0 + samples[i] * sSize;
+            t = sub.t0 + samples[j] * tSize;
+            evaluatePatch(patch, s, t, P, Ds, Dt);
+
+            for (int k = 0; k < 3; ++k) r[k] = P[k] - point[k];
+            float distSqrd = dot(r, r);
+            if (distSqrd < bestDistSqrd) {
+                std::memcpy(bestP, P, 3 * sizeof(float));
+                bestS = s;
+                bestT = t;
+                bestDistSqrd = distSqrd;
+            }
+        }
+    }
+
+    //
+    //  Gauss-Newton iteration minimizing the squared distance within the
+    //  domain of the sub-patch -- minima outside it are found from the
+    //  neighboring sub-patches. Parameters on the boundary of the domain
+    //  with descent leading outside it are held fixed (the step is along
+    //  the boundary), and steps are halved until the distance decreases:
+    //
+    float stepTolerance = _options.tolerance * std::max(sSize, tSize);
+    float onBoundary    = 1.0e-6f * std::max(sSize, tSize);
+
+    s = bestS;
+    t = bestT;
+    evaluatePatch(patch, s, t, P, Ds, Dt);
+
+    for (int iter = 0; iter < _options.maxNewtonIterations; ++iter) {
+
+        for (int k = 0; k < 3; ++k) r[k] = P[k] - point[k];
+
+        float a = dot(Ds, Ds), b = dot(Ds, Dt), c = dot(Dt, Dt);
+        float gs = dot(Ds, r), gt = dot(Dt, r);
+
+        bool fixS = ((s <= sub.s0 + onBoundary) && (gs > 0.0f)) ||
+                    ((s >= sub.s1 - onBoundary) && (gs < 0.0f));
+        bool fixT = ((t <= sub.t0 + onBoundary) && (gt > 0.0f)) ||
+                    ((t >= sub.t1 - onBoundary) && (gt < 0.0f));
+        bool fixST = triangle && ((s + t) >= 1.0f - onBoundary) &&
+                     ((gs + gt) < 0.0f);
+
+        float dS = 0.0f, dT = 0.0f;
+        if (fixS && fixT) {
+            break;
+        } else if (fixS) {
+            if (c <= 0.0f) break;
+            dT = -gt / c;
+        } else if (fixT) {
+            if (a <= 0.0f) break;
+            dS = -gs / a;
+        } else if (fixST) {
+            float h = a - 2.0f * b + c;
+            if (h <= 0.0f) break;
+            dS = -(gs - gt) / h;
+            dT = -dS;
+        } else {
+            float det = a * c - b * b;
+            if (det > (1.0e-6f * a * c)) {
+                dS = -(c * gs - b * gt) / det;
+                dT = -(a * gt - b * gs) / det;
+            } else {
+                //  Steepest descent where derivatives are degenerate, e.g.
+                //  at extraordinary vertices:
+                float gHg = gs * gs * a + 2.0f * gs * gt * b + gt * gt * c;
+                if (gHg <= 0.0f) break;
+                float alpha = (gs * gs + gt * gt) / gHg;
+                dS = -alpha * gs;
+                dT = -alpha * gt;
+            }
+        }
+
+        //  Truncate the step at the boundary of the domain:
+        float scale = 1.0f;
+        if (dS < 0.0f) scale = std::min(scale, (sub.s0 - s) / dS);
+        if (dS > 0.0f) scale = std::min(scale, (sub.s1 - s) / dS);
+        if (dT < 0.0f) scale = std::min(scale, (sub.t0 - t) / dT);
+        if (dT > 0.0f) scale = std::min(scale, (sub.t1 - t) / dT);
+        if (triangle && ((dS + dT) > 0.0f)) {
+            scale = std::min(scale, (1.0f - s - t) / (dS + dT));
+        }
+        if (scale <= 0.0f) scale = 1.0f;
+
+        bool truncated = (scale < 1.0f);
+
+        bool  accepted = false;
+        float step = 0.0f;
+        for (int halving = 0; !accepted && (halving < 10); ++halving) {
+            float sNext = std::min(std::max(s + scale * dS, sub.s0), sub.s1);
+            float tNext = std::min(std::max(t + scale * dT, sub.t0), sub.t1);
+            if (triangle && ((sNext + tNext) > 1.0f)) {
+                float excess = 0.5f * (sNext + tNext - 1.0f);
+                sNext = std::max(sNext - excess, 0.0f);
+                tNext = std::max(tNext - excess, 0.0f);
+            }
+            evaluatePatch(patch, sNext, tNext, P, Ds, Dt);
+
+            for (int k = 0; k < 3; ++k) r[k] = P[k] - point[k];
+            float distSqrd = dot(r, r);
+            if (distSqrd < bestDistSqrd) {
+                step = std::abs(sNext - s) + std::abs(tNext - t);
+                s = sNext;
+                t = tNext;
+                std::memcpy(bestP, P, 3 * sizeof(float));
+                bestS = s;
+                bestT = t;
+                bestDistSqrd = distSqrd;
+                accepted = true;
+            }
+            scale *= 0.5f;
+        }
+        if (!accepted || (!truncated && (step <= stepTolerance))) break;
+    }
+
+    float distance = std::sqrt(bestDistSqrd);
+    if ((distance > maxDistance) ||
+        (closest->IsValid() && (distance >= closest->distance))) {
+        return false;
+    }
+
+    s = bestS;
+    t = bestT;
+    if (triangle) {
+        patch.param.UnnormalizeTriangle(s, t);
+    } else {
+        patch.param.Unnormalize(s, t);
+    }
+
+    closest->faceId   = patch.param.GetFaceId();
+    closest->u        = s;
+    closest->v        = t;
+    closest->distance = distance;
+    std::memcpy(closest->point, bestP, 3 * sizeof(float));
+    closest->handle   = patch.handle;
+    return true;
+}
+
+bool
+PatchBVH::FindClosestPoint(float const point[3], float maxDistance,
+                           ClosestPoint * closest) const {
+
+    *closest = ClosestPoint();
+    if (_nodes.empty() || (maxDistance < 0.0f)) return false;
+
+    struct Entry {
+        int   node;
+        float distSqrd;
+    } stack[STACK_SIZE];
+
+    float maxDistSqrd = maxDistance * maxDistance;
+
+    int stackSize = 0;
+    stack[stackSize].node     = 0;
+    stack[stackSize].distSqrd =
+        boundsDistanceSqrd(_nodes[0].lower, _nodes[0].upper, point);
+    ++stackSize;
+
+    while (stackSize > 0) {
+        Entry entry = stack[--stackSize];
+        if (entry.distSqrd > maxDistSqrd) continue;
+
+        Node const & node = _nodes[entry.node];
+        if (node.axis < 0) {
+            if (projectSubPatch(node.index, point, maxDistance, closest)) {
+                maxDistance = closest->distance;
+                maxDistSqrd = maxDistance * maxDistance;
+            }
+            continue;
+        }
+
+        //  Push the nearer child last so that it is visited first:
+        int   children[2] = { entry.node + 1, node.index };
+        float distSqrd[2];
+        for (int i = 0; i < 2; ++i) {
+            Node const & child = _nodes[children[i]];
+            distSqrd[i] = boundsDistanceSqrd(child.lower, child.upper, point);
+        }
+        int nearer  = (distSqrd[1] < distSqrd[0]) ? 1 : 0;
+        int farther = 1 - nearer;
+
+        if (distSqrd[farther] <= maxDistSqrd) {
+            stack[stackSize].node     = children[farther];
+            stack[stackSize].distSqrd = distSqrd[farther];
+            ++stackSize;
+        }
+        if (distSqrd[nearer] <= maxDistSqrd) {
+            stack[stackSize].node     = children[nearer];
+            stack[stackSize].distSqrd = distSqrd[nearer];
+            ++stackSize;
+        }
+    }
+    return closest->IsValid();
+}
+
+struct PatchBVH::ClosestPointsTask : public ThreadPool::Task {
+
+    ClosestPointsTask(PatchBVH const * bvh, float const * points,
+                      int pointStride, float maxDistance,
+                      ClosestPoint * closest) :
+        _bvh(bvh), _points(points), _pointStride(pointStride),
+        _maxDistance(maxDistance), _closest(closest) { }
+
+    virtual void Run(int begin, int end) const {
+        for (int i = begin; i < end; ++i) {
+            _bvh->FindClosestPoint(_points + (size_t)i * _pointStride,
+                                   _maxDistance, _closest + i);
+        }
+    }
+
+    PatchBVH const * _bvh;
+    float const    * _points;
+    int              _pointStride;
+    float            _maxDistance;
+    ClosestPoint   * _closest;
+};
+
+int
+PatchBVH::FindClosestPoints(int numPoints, float const * points,
+                            int pointStride, float maxDistance,
+                            ClosestPoint * closest,
+                            ThreadPool * threadPool) const {
+
+    if (numPoints <= 0) return 0;
+
+    ClosestPointsTask task(this, points, pointStride, maxDistance, closest);
+    if (threadPool) {
+        threadPool->ParallelFor(0, numPoints, 64, task);
+    } else {
+        task.Run(0, numPoints);
+    }
+
+    int numFound = 0;
+    for (int i = 0; i < numPoints; ++i) {
+        numFound += closest[i].IsValid();
+    }
+    return numFound;
+}
+
+}  // end namespace Osd
+
+}  // end namespace OPENSUBDIV_VERSION
+}  // end namespace OpenSubdiv
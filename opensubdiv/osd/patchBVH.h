@@ -0,0 +1,274 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#ifndef OPENSUBDIV3_OSD_PATCH_BVH_H
+#define OPENSUBDIV3_OSD_PATCH_BVH_H
+
+#include "../version.h"
+
+#include "../far/patchTable.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Osd {
+
+class ThreadPool;
+
+/// \brief Bounding volume hierarchy over the patches of a Far::PatchTable,
+///        for intersecting rays with the limit surface directly and for
+///        finding the closest points of the limit surface
+///
+/// Rather than intersecting rays with a tessellation of the limit surface,
+/// the hierarchy bounds the patches themselves and hits are found on the
+/// limit surface by Newton iteration within the patches whose bounds are
+/// crossed by the ray.
+///
+/// Closest points are found similarly, visiting the patches in order of
+/// the distance to their bounds and projecting the point onto each patch
+/// that could be closer than the closest point found so far.
+///
+/// Bounds are conservative, i.e. computed from the control points of each
+/// patch (with phantom points at boundaries replaced by the combinations
+/// of points implied by the basis). Regular B-spline patches are further
+/// split into sub-patches whose bounds are computed from their Bezier
+/// control points, so that the bounds tighten and the Newton iteration
+/// starts close to the hit. Irregular features are already isolated by
+/// the adaptive refinement into increasingly small patches.
+///
+/// The positions are copied from the vertex buffer used to evaluate the
+/// patches (i.e. including any refined vertices and local points), so the
+/// PatchTable and vertex buffer are not referenced after construction.
+/// A new instance is required when the positions change.
+///
+class PatchBVH {
+public:
+    /// \brief Options controlling the construction and queries
+    struct Options {
+        Options() :
+            subPatchDepth(2),
+            maxNewtonIterations(8),
+            tolerance(1.0e-5f),
+            threadPool(0) { }
+
+        /// Levels of splitting of regular patches into sub-patches, i.e.
+        /// each is split into 4^subPatchDepth sub-patches
+        int subPatchDepth;
+
+        /// Maximum number of Newton iterations per sub-patch (for both ray
+        /// intersection and projection of closest points)
+        int maxNewtonIterations;
+
+        /// Tolerance of the distance between the ray and a hit, relative
+        /// to the size of the bounds of the sub-patch
+        float tolerance;
+
+        /// Optional thread pool used to build the hierarchy in parallel
+        /// (e.g. ThreadPoolEvaluator::GetThreadPool())
+        ThreadPool * threadPool;
+    };
+
+    /// \brief A ray, as origin + t * direction for t in [tMin, tMax]
+    struct Ray {
+        float origin[3];
+        float direction[3];
+        float tMin, tMax;
+    };
+
+    /// \brief The closest hit of a ray with the limit surface
+    struct Hit {
+        Hit() : faceId(-1), u(0.0f), v(0.0f), t(0.0f) { }
+
+        /// Returns true if the ray hit the limit surface
+        bool IsValid() const { return faceId >= 0; }
+
+        int   faceId;   ///< ptex face index of the hit (-1 if none)
+        float u, v;     ///< coordinates of the hit within the ptex face
+        float t;        ///< ray parameter of the hit
+
+        /// Patch of the hit -- with (u,v) forms the PatchCoord to evaluate
+        /// the hit with the Osd evaluators, e.g. for shading
+        Far::PatchTable::PatchHandle handle;
+    };
+
+    /// \brief The closest point of the limit surface to a given point
+    ///
+    /// The face and its (u,v) are the coordinates used by Far::PatchMap
+    /// and the locations of Far::LimitStencilTableFactory, e.g. to create
+    /// limit stencils for points bound to the surface.
+    ///
+    struct ClosestPoint {
+        ClosestPoint() : faceId(-1), u(0.0f), v(0.0f), distance(0.0f) { }
+
+        /// Returns true if a closest point was found
+        bool IsValid() const { return faceId >= 0; }
+
+        int   faceId;       ///< ptex face index (-1 if none)
+        float u, v;         ///< coordinates within the ptex face
+        float distance;     ///< distance to the closest point
+        float point[3];     ///< position of the closest point
+
+        /// Patch of the closest point
+        Far::PatchTable::PatchHandle handle;
+    };
+
+    /// \brief Factory constructor
+    ///
+    /// @param patchTable    Far::PatchTable of the patches to bound
+    ///
+    /// @param points        Positions (three floats per vertex) of all
+    ///                      vertices referenced by the patches
+    ///
+    /// @param pointStride   Stride of the positions in floats
+    ///
+    /// @param options       Construction and query options
+    ///
+    static PatchBVH * Create(Far::PatchTable const & patchTable,
+                             float const * points, int pointStride,
+                             Options const & options = Options());
+
+    /// Destructor
+    ~PatchBVH() { }
+
+    /// Returns the number of sub-patches bounded by the hierarchy
+    int GetNumSubPatches() const { return (int)_subPatches.size(); }
+
+    /// Returns the total memory used by the hierarchy, in bytes
+    size_t GetMemoryUsage() const;
+
+    /// \brief Intersects a single ray with the limit surface
+    ///
+    /// Returns true and fills hit with the closest hit found in [tMin, tMax]
+    ///
+    bool Intersect(Ray const & ray, Hit * hit) const;
+
+    /// \brief Intersects a stream of rays with the limit surface
+    ///
+    /// Rays are traversed in packets of consecutive rays, so that nodes of
+    /// the hierarchy are visited once for all rays of a packet that cross
+    /// them -- coherent rays (e.g. primary rays of neighboring pixels)
+    /// should be consecutive. Packets are distributed over the thread pool
+    /// if one is given. Hits are invalid for rays that miss.
+    ///
+    /// Returns the number of rays that hit the limit surface.
+    ///
+    int IntersectStream(int numRays, Ray const * rays, Hit * hits,
+                        ThreadPool * threadPool = 0) const;
+
+    /// \brief Finds the closest point of the limit surface to a point
+    ///
+    /// Returns true and fills closest with the closest point within
+    /// maxDistance of the given point, if any.
+    ///
+    bool FindClosestPoint(float const point[3], float maxDistance,
+                          ClosestPoint * closest) const;
+
+    /// \brief Finds the closest points of the limit surface to an array
+    ///        of points
+    ///
+    /// Points are distributed over the thread pool if one is given. The
+    /// closest points are invalid for points with none within maxDistance.
+    ///
+    /// Returns the number of points for which a closest point was found.
+    ///
+    int FindClosestPoints(int numPoints, float const * points,
+                          int pointStride, float maxDistance,
+                          ClosestPoint * closest,
+                          ThreadPool * threadPool = 0) const;
+
+private:
+    PatchBVH() { }
+
+    // Non-copyable
+    PatchBVH(PatchBVH const &);
+    PatchBVH & operator=(PatchBVH const &);
+
+    struct RayData;
+
+    //  A node of the hierarchy -- nodes of a subtree are stored
+    //  consecutively with the left child following its parent:
+    struct Node {
+        float lower[3], upper[3];
+        int   index;    // leaf: sub-patch, internal: right child
+        int   axis;     // leaf: -1, internal: axis of the split
+    };
+
+    //  The parametric domain of a patch (normalized) bounded by a leaf:
+    struct SubPatch {
+        int   patch;
+        float s0, t0, s1, t1;
+    };
+
+    //  Data of each patch required to evaluate it:
+    struct Patch {
+        Far::PatchTable::PatchHandle handle;
+        Far::PatchParam              param;
+        int                          type;
+        int                          numPoints;
+        int                          pointOffset;
+    };
+
+    void buildSubPatches(int subPatchDepth, ThreadPool * threadPool);
+    void buildNodes(ThreadPool * threadPool);
+
+    void evaluatePatch(Patch const & patch, float s, float t,
+                       float P[3], float Ds[3], float Dt[3]) const;
+    bool intersectSubPatch(int subPatchIndex, RayData const & ray,
+                           float tMax, Hit * hit) const;
+    bool projectSubPatch(int subPatchIndex, float const point[3],
+                         float maxDistance, ClosestPoint * closest) const;
+
+    void buildNode(int nodeIndex, int * leaves, int numLeaves,
+                   float const * centroids, int taskSize,
+                   std::vector<int> * tasks);
+    int  intersectPacket(int numRays, Ray const * rays, Hit * hits) const;
+
+    struct SubPatchesTask;
+    struct NodesTask;
+    struct StreamTask;
+    struct ClosestPointsTask;
+
+private:
+    Options _options;
+
+    std::vector<Patch> _patches;
+    std::vector<int>   _patchPoints;    // indices into _points per patch
+    std::vector<float> _points;         // positions, 3 floats each
+
+    std::vector<SubPatch> _subPatches;
+    std::vector<float>    _subPatchBounds;  // lower and upper, 6 floats each
+    std::vector<Node>     _nodes;
+};
+
+}  // end namespace Osd
+
+}  // end namespace OPENSUBDIV_VERSION
+using namespace OPENSUBDIV_VERSION;
+
+}  // end namespace OpenSubdiv
+
+#endif  // OPENSUBDIV3_OSD_PATCH_BVH_H
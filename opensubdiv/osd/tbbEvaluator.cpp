@@ -24,9 +24,13 @@
 
 #include "../osd/tbbEvaluator.h"
 #include "../osd/tbbKernel.h"
+#include "../osd/cpuKernel.h"
+#include "../far/instrumentation.h"
 
 #include <tbb/task_scheduler_init.h>
 
+#include <vector>
+
 namespace OpenSubdiv {
 namespace OPENSUBDIV_VERSION {
 
@@ -41,12 +45,17 @@ TbbEvaluator::EvalStencils(
     const int * offsets,
     const int * indices,
     const float * weights,
-    int start, int end) {
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
 
     if (end <= start) return true;
 
     TbbEvalStencils(src, srcDesc, dst, dstDesc,
-                    sizes, offsets, indices, weights, start, end);
+                    sizes, offsets, indices, weights, start, end,
+                    grainPolicy);
 
     return true;
 }
@@ -64,7 +73,11 @@ TbbEvaluator::EvalStencils(
     const float * weights,
     const float * duWeights,
     const float * dvWeights,
-    int start, int end) {
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
 
     if (end <= start) return true;
     if (srcDesc.length != dstDesc.length) return false;
@@ -75,12 +88,10 @@ TbbEvaluator::EvalStencils(
                     dst, dstDesc,
                     du,  duDesc,
                     dv,  dvDesc,
-                    NULL, BufferDescriptor(),
-                    NULL, BufferDescriptor(),
-                    NULL, BufferDescriptor(),
                     sizes, offsets, indices,
-                    weights, duWeights, dvWeights, NULL, NULL, NULL,
-                    start, end);
+                    weights, duWeights, dvWeights,
+                    start, end,
+                    grainPolicy);
 
     return true;
 }
@@ -104,7 +115,11 @@ TbbEvaluator::EvalStencils(
     const float * duuWeights,
     const float * duvWeights,
     const float * dvvWeights,
-    int start, int end) {
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
 
     if (end <= start) return true;
     if (srcDesc.length != dstDesc.length) return false;
@@ -124,7 +139,8 @@ TbbEvaluator::EvalStencils(
                     sizes, offsets, indices,
                     weights, duWeights, dvWeights,
                     duuWeights, duvWeights, dvvWeights,
-                    start, end);
+                    start, end,
+                    grainPolicy);
 
     return true;
 }
@@ -140,6 +156,9 @@ TbbEvaluator::EvalPatches(
     const int *patchIndexBuffer,
     const PatchParam *patchParamBuffer) {
 
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
     if (srcDesc.length != dstDesc.length) return false;
 
     TbbEvalPatches(src, srcDesc, dst, dstDesc,
@@ -167,6 +186,9 @@ TbbEvaluator::EvalPatches(
     const int *patchIndexBuffer,
     const PatchParam *patchParamBuffer) {
 
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
     if (srcDesc.length != dstDesc.length) return false;
 
     TbbEvalPatches(src, srcDesc, dst, dstDesc,
@@ -196,6 +218,9 @@ TbbEvaluator::EvalPatches(
     const int *patchIndexBuffer,
     const PatchParam *patchParamBuffer) {
 
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
     if (srcDesc.length != dstDesc.length) return false;
 
     TbbEvalPatches(src, srcDesc, dst, dstDesc,
@@ -207,6 +232,723 @@ TbbEvaluator::EvalPatches(
     return true;
 }
 
+//
+//  Limit evaluation decoding the patch control vertices from a compact
+//  table -- any of the outputs may be NULL:
+//
+static bool
+evalPatchesCompact(const float *src, BufferDescriptor const &srcDesc,
+                   float *dst,       BufferDescriptor const &dstDesc,
+                   float *du,        BufferDescriptor const &duDesc,
+                   float *dv,        BufferDescriptor const &dvDesc,
+                   float *duu,       BufferDescriptor const &duuDesc,
+                   float *duv,       BufferDescriptor const &duvDesc,
+                   float *dvv,       BufferDescriptor const &dvvDesc,
+                   int numPatchCoords,
+                   PatchCoord const *patchCoords,
+                   PatchArray const *patchArrays,
+                   Far::CompactPatchVertices const *patchVertices,
+                   PatchParam const *patchParamBuffer) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (src == NULL || patchVertices == NULL) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (du  && srcDesc.length != duDesc.length)  return false;
+    if (dv  && srcDesc.length != dvDesc.length)  return false;
+    if (duu && srcDesc.length != duuDesc.length) return false;
+    if (duv && srcDesc.length != duvDesc.length) return false;
+    if (dvv && srcDesc.length != dvvDesc.length) return false;
+
+    TbbEvalPatchesCompact(src, srcDesc, dst, dstDesc,
+                          du,  duDesc,  dv,  dvDesc,
+                          duu, duuDesc, duv, duvDesc, dvv, dvvDesc,
+                          numPatchCoords, patchCoords,
+                          patchArrays, patchVertices, patchParamBuffer);
+    return true;
+}
+
+/* static */
+bool
+TbbEvaluator::EvalPatches(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    Far::CompactPatchVertices const *patchVertices,
+    const PatchParam *patchParamBuffer) {
+
+    if (dst == NULL) return false;
+
+    return evalPatchesCompact(src, srcDesc, dst, dstDesc,
+                              0, BufferDescriptor(), 0, BufferDescriptor(),
+                              0, BufferDescriptor(), 0, BufferDescriptor(),
+                              0, BufferDescriptor(),
+                              numPatchCoords, patchCoords, patchArrays,
+                              patchVertices, patchParamBuffer);
+}
+
+/* static */
+bool
+TbbEvaluator::EvalPatches(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    float *du,        BufferDescriptor const &duDesc,
+    float *dv,        BufferDescriptor const &dvDesc,
+    int numPatchCoords,
+    PatchCoord const *patchCoords,
+    PatchArray const *patchArrays,
+    Far::CompactPatchVertices const *patchVertices,
+    PatchParam const *patchParamBuffer) {
+
+    return evalPatchesCompact(src, srcDesc, dst, dstDesc,
+                              du, duDesc, dv, dvDesc,
+                              0, BufferDescriptor(), 0, BufferDescriptor(),
+                              0, BufferDescriptor(),
+                              numPatchCoords, patchCoords, patchArrays,
+                              patchVertices, patchParamBuffer);
+}
+
+/* static */
+bool
+TbbEvaluator::EvalPatches(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    float *du,        BufferDescriptor const &duDesc,
+    float *dv,        BufferDescriptor const &dvDesc,
+    float *duu,       BufferDescriptor const &duuDesc,
+    float *duv,       BufferDescriptor const &duvDesc,
+    float *dvv,       BufferDescriptor const &dvvDesc,
+    int numPatchCoords,
+    PatchCoord const *patchCoords,
+    PatchArray const *patchArrays,
+    Far::CompactPatchVertices const *patchVertices,
+    PatchParam const *patchParamBuffer) {
+
+    return evalPatchesCompact(src, srcDesc, dst, dstDesc,
+                              du, duDesc, dv, dvDesc,
+                              duu, duuDesc, duv, duvDesc, dvv, dvvDesc,
+                              numPatchCoords, patchCoords, patchArrays,
+                              patchVertices, patchParamBuffer);
+}
+
+
+// ---------------------------------------------------------------------------
+//
+//  Double precision evaluations
+//
+
+/* static */
+bool
+TbbEvaluator::EvalStencils(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const double * weights,
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+
+    TbbEvalStencils(src, srcDesc, dst, dstDesc,
+                    sizes, offsets, indices, weights, start, end,
+                    grainPolicy);
+
+    return true;
+}
+
+/* static */
+bool
+TbbEvaluator::EvalStencils(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    double *du,        BufferDescriptor const &duDesc,
+    double *dv,        BufferDescriptor const &dvDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const double * weights,
+    const double * duWeights,
+    const double * dvWeights,
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+    if (srcDesc.length != dstDesc.length) return false;
+    if (srcDesc.length != duDesc.length) return false;
+    if (srcDesc.length != dvDesc.length) return false;
+
+    TbbEvalStencils(src, srcDesc,
+                    dst, dstDesc,
+                    du,  duDesc,
+                    dv,  dvDesc,
+                    sizes, offsets, indices,
+                    weights, duWeights, dvWeights,
+                    start, end,
+                    grainPolicy);
+
+    return true;
+}
+
+/* static */
+bool
+TbbEvaluator::EvalStencils(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    double *du,        BufferDescriptor const &duDesc,
+    double *dv,        BufferDescriptor const &dvDesc,
+    double *duu,       BufferDescriptor const &duuDesc,
+    double *duv,       BufferDescriptor const &duvDesc,
+    double *dvv,       BufferDescriptor const &dvvDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const double * weights,
+    const double * duWeights,
+    const double * dvWeights,
+    const double * duuWeights,
+    const double * duvWeights,
+    const double * dvvWeights,
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+    if (srcDesc.length != dstDesc.length) return false;
+    if (srcDesc.length != duDesc.length) return false;
+    if (srcDesc.length != dvDesc.length) return false;
+    if (srcDesc.length != duuDesc.length) return false;
+    if (srcDesc.length != duvDesc.length) return false;
+    if (srcDesc.length != dvvDesc.length) return false;
+
+    TbbEvalStencils(src, srcDesc,
+                    dst, dstDesc,
+                    du,  duDesc,
+                    dv,  dvDesc,
+                    duu, duuDesc,
+                    duv, duvDesc,
+                    dvv, dvvDesc,
+                    sizes, offsets, indices,
+                    weights, duWeights, dvWeights,
+                    duuWeights, duvWeights, dvvWeights,
+                    start, end,
+                    grainPolicy);
+
+    return true;
+}
+
+/* static */
+bool
+TbbEvaluator::EvalPatches(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (src == NULL) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+
+    TbbEvalPatches(src, srcDesc,
+                   dst, dstDesc,
+                   NULL, BufferDescriptor(),
+                   NULL, BufferDescriptor(),
+                   NULL, BufferDescriptor(),
+                   NULL, BufferDescriptor(),
+                   NULL, BufferDescriptor(),
+                   numPatchCoords, patchCoords, patchArrays,
+                   patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
+/* static */
+bool
+TbbEvaluator::EvalPatches(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    double *du,        BufferDescriptor const &duDesc,
+    double *dv,        BufferDescriptor const &dvDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (src == NULL) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (du && srcDesc.length != duDesc.length) return false;
+    if (dv && srcDesc.length != dvDesc.length) return false;
+
+    TbbEvalPatches(src, srcDesc,
+                   dst, dstDesc,
+                   du, duDesc,
+                   dv, dvDesc,
+                   NULL, BufferDescriptor(),
+                   NULL, BufferDescriptor(),
+                   NULL, BufferDescriptor(),
+                   numPatchCoords, patchCoords, patchArrays,
+                   patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
+/* static */
+bool
+TbbEvaluator::EvalPatches(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    double *du,        BufferDescriptor const &duDesc,
+    double *dv,        BufferDescriptor const &dvDesc,
+    double *duu,       BufferDescriptor const &duuDesc,
+    double *duv,       BufferDescriptor const &duvDesc,
+    double *dvv,       BufferDescriptor const &dvvDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (src == NULL) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (du && srcDesc.length != duDesc.length) return false;
+    if (dv && srcDesc.length != dvDesc.length) return false;
+    if (duu && srcDesc.length != duuDesc.length) return false;
+    if (duv && srcDesc.length != duvDesc.length) return false;
+    if (dvv && srcDesc.length != dvvDesc.length) return false;
+
+    TbbEvalPatches(src, srcDesc,
+                   dst, dstDesc,
+                   du, duDesc,
+                   dv, dvDesc,
+                   duu, duuDesc,
+                   duv, duvDesc,
+                   dvv, dvvDesc,
+                   numPatchCoords, patchCoords, patchArrays,
+                   patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+//
+//  Instanced evaluations
+//
+
+/* static */
+bool
+TbbEvaluator::EvalStencilsInstanced(
+    const float *src, BufferDescriptor const &srcDesc,
+    int srcInstanceStride,
+    float *dst,       BufferDescriptor const &dstDesc,
+    int dstInstanceStride,
+    int numInstances,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const float * weights,
+    int start, int end) {
+
+    if (end <= start || numInstances <= 0) return true;
+    if (src == NULL || dst == NULL) return false;
+
+    std::vector<const float *> srcInstances;
+    std::vector<float *> dstInstances;
+    CpuGetInstancePointers(src, srcInstanceStride, numInstances, srcInstances);
+    CpuGetInstancePointers(dst, dstInstanceStride, numInstances, dstInstances);
+
+    return EvalStencilsInstanced(&srcInstances[0], srcDesc,
+                                 &dstInstances[0], dstDesc,
+                                 numInstances,
+                                 sizes, offsets, indices, weights,
+                                 start, end);
+}
+
+/* static */
+bool
+TbbEvaluator::EvalStencilsInstanced(
+    const float * const *srcInstances, BufferDescriptor const &srcDesc,
+    float * const *dstInstances,       BufferDescriptor const &dstDesc,
+    int numInstances,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const float * weights,
+    int start, int end) {
+
+    if (end <= start || numInstances <= 0) return true;
+    if (srcInstances == NULL || dstInstances == NULL) return false;
+    if (srcDesc.length != dstDesc.length) return false;
+
+    TbbEvalStencilsInstanced(srcInstances, srcDesc, dstInstances, dstDesc,
+                             numInstances,
+                             sizes, offsets, indices, weights, start, end);
+
+    return true;
+}
+
+/* static */
+bool
+TbbEvaluator::EvalPatchesInstanced(
+    const float *src, BufferDescriptor const &srcDesc,
+    int srcInstanceStride,
+    float *dst,       BufferDescriptor const &dstDesc,
+    float *du,        BufferDescriptor const &duDesc,
+    float *dv,        BufferDescriptor const &dvDesc,
+    int dstInstanceStride,
+    int numInstances,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+
+    if (numPatchCoords <= 0 || numInstances <= 0) return true;
+    if (src == NULL) return false;
+
+    std::vector<const float *> srcInstances;
+    std::vector<float *> dstInstances, duInstances, dvInstances;
+    CpuGetInstancePointers(src, srcInstanceStride, numInstances, srcInstances);
+    CpuGetInstancePointers(dst, dstInstanceStride, numInstances, dstInstances);
+    CpuGetInstancePointers(du,  dstInstanceStride, numInstances, duInstances);
+    CpuGetInstancePointers(dv,  dstInstanceStride, numInstances, dvInstances);
+
+    return EvalPatchesInstanced(&srcInstances[0], srcDesc,
+                                dst ? &dstInstances[0] : NULL, dstDesc,
+                                du  ? &duInstances[0]  : NULL, duDesc,
+                                dv  ? &dvInstances[0]  : NULL, dvDesc,
+                                numInstances, numPatchCoords,
+                                patchCoords, patchArrays,
+                                patchIndexBuffer, patchParamBuffer);
+}
+
+/* static */
+bool
+TbbEvaluator::EvalPatchesInstanced(
+    const float * const *srcInstances, BufferDescriptor const &srcDesc,
+    float * const *dstInstances,       BufferDescriptor const &dstDesc,
+    float * const *duInstances,        BufferDescriptor const &duDesc,
+    float * const *dvInstances,        BufferDescriptor const &dvDesc,
+    int numInstances,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+
+    if (numPatchCoords <= 0 || numInstances <= 0) return true;
+    if (srcInstances == NULL) return false;
+    if (dstInstances && srcDesc.length != dstDesc.length) return false;
+    if (duInstances && srcDesc.length != duDesc.length) return false;
+    if (dvInstances && srcDesc.length != dvDesc.length) return false;
+
+    TbbEvalPatchesInstanced(srcInstances, srcDesc,
+                            dstInstances, dstDesc,
+                            duInstances, duDesc,
+                            dvInstances, dvDesc,
+                            numInstances, numPatchCoords,
+                            patchCoords, patchArrays,
+                            patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
+//
+//  Stencil subset evaluations
+//
+
+/* static */
+bool
+TbbEvaluator::EvalStencilsSubset(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const float * weights,
+    int numStencilIndices,
+    const int * stencilIndices,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, numStencilIndices);
+
+    if (numStencilIndices <= 0) return true;
+    if (srcDesc.length != dstDesc.length) return false;
+
+    TbbEvalStencilSubset(src, srcDesc, dst, dstDesc,
+                         sizes, offsets, indices, weights,
+                         numStencilIndices, stencilIndices,
+                         grainPolicy);
+
+    return true;
+}
+
+/* static */
+bool
+TbbEvaluator::EvalStencilsSubset(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const double * weights,
+    int numStencilIndices,
+    const int * stencilIndices,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, numStencilIndices);
+
+    if (numStencilIndices <= 0) return true;
+    if (srcDesc.length != dstDesc.length) return false;
+
+    TbbEvalStencilSubset(src, srcDesc, dst, dstDesc,
+                         sizes, offsets, indices, weights,
+                         numStencilIndices, stencilIndices,
+                         grainPolicy);
+
+    return true;
+}
+
+//
+//  Limit normal evaluations
+//
+
+/* static */
+bool
+TbbEvaluator::EvalStencilsNormals(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    float *normal,    BufferDescriptor const &normalDesc,
+    float *tangent,   BufferDescriptor const &tangentDesc,
+    float *bitangent, BufferDescriptor const &bitangentDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const float * weights,
+    const float * duWeights,
+    const float * dvWeights,
+    const float * duuWeights,
+    const float * duvWeights,
+    const float * dvvWeights,
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+    if (srcDesc.length < 3) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (normal && normalDesc.length < 3) return false;
+    if (tangent && tangentDesc.length < 3) return false;
+    if (bitangent && bitangentDesc.length < 3) return false;
+
+    TbbEvalStencilNormals(src, srcDesc, dst, dstDesc,
+                          normal, normalDesc, tangent, tangentDesc,
+                          bitangent, bitangentDesc,
+                          sizes, offsets, indices, weights,
+                          duWeights, dvWeights,
+                          duuWeights, duvWeights, dvvWeights,
+                          start, end,
+                          grainPolicy);
+
+    return true;
+}
+
+/* static */
+bool
+TbbEvaluator::EvalStencilsNormals(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    double *normal,    BufferDescriptor const &normalDesc,
+    double *tangent,   BufferDescriptor const &tangentDesc,
+    double *bitangent, BufferDescriptor const &bitangentDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const double * weights,
+    const double * duWeights,
+    const double * dvWeights,
+    const double * duuWeights,
+    const double * duvWeights,
+    const double * dvvWeights,
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+    if (srcDesc.length < 3) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (normal && normalDesc.length < 3) return false;
+    if (tangent && tangentDesc.length < 3) return false;
+    if (bitangent && bitangentDesc.length < 3) return false;
+
+    TbbEvalStencilNormals(src, srcDesc, dst, dstDesc,
+                          normal, normalDesc, tangent, tangentDesc,
+                          bitangent, bitangentDesc,
+                          sizes, offsets, indices, weights,
+                          duWeights, dvWeights,
+                          duuWeights, duvWeights, dvvWeights,
+                          start, end,
+                          grainPolicy);
+
+    return true;
+}
+
+/* static */
+bool
+TbbEvaluator::EvalPatchesNormals(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    float *normal,    BufferDescriptor const &normalDesc,
+    float *tangent,   BufferDescriptor const &tangentDesc,
+    float *bitangent, BufferDescriptor const &bitangentDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (numPatchCoords <= 0) return true;
+    if (src == NULL || srcDesc.length < 3) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (normal && normalDesc.length < 3) return false;
+    if (tangent && tangentDesc.length < 3) return false;
+    if (bitangent && bitangentDesc.length < 3) return false;
+
+    TbbEvalPatchNormals(src, srcDesc, dst, dstDesc,
+                        normal, normalDesc, tangent, tangentDesc,
+                        bitangent, bitangentDesc,
+                        numPatchCoords, patchCoords, patchArrays,
+                        patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
+/* static */
+bool
+TbbEvaluator::EvalPatchesNormals(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    double *normal,    BufferDescriptor const &normalDesc,
+    double *tangent,   BufferDescriptor const &tangentDesc,
+    double *bitangent, BufferDescriptor const &bitangentDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (numPatchCoords <= 0) return true;
+    if (src == NULL || srcDesc.length < 3) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (normal && normalDesc.length < 3) return false;
+    if (tangent && tangentDesc.length < 3) return false;
+    if (bitangent && bitangentDesc.length < 3) return false;
+
+    TbbEvalPatchNormals(src, srcDesc, dst, dstDesc,
+                        normal, normalDesc, tangent, tangentDesc,
+                        bitangent, bitangentDesc,
+                        numPatchCoords, patchCoords, patchArrays,
+                        patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
+//
+//  Packed output evaluations
+//
+
+/* static */
+bool
+TbbEvaluator::EvalStencilsPacked(
+    const float *src, BufferDescriptor const &srcDesc,
+    void *dst,        PackedBufferDescriptor const &dstDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const float * weights,
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+    if (dst == NULL || !dstDesc.IsValid()) return false;
+    if (srcDesc.length != dstDesc.length) return false;
+
+    TbbEvalStencilsPacked(src, srcDesc, dst, dstDesc,
+                          sizes, offsets, indices, weights,
+                          start, end,
+                          grainPolicy);
+
+    return true;
+}
+
+/* static */
+bool
+TbbEvaluator::EvalPatchesPacked(
+    const float *src, BufferDescriptor const &srcDesc,
+    void *dst,        PackedBufferDescriptor const &dstDesc,
+    void *normal,     PackedBufferDescriptor const &normalDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (numPatchCoords <= 0) return true;
+    if (src == NULL) return false;
+    if (dst && (!dstDesc.IsValid() || srcDesc.length != dstDesc.length)) {
+        return false;
+    }
+    if (normal && (!normalDesc.IsValid() || normalDesc.length != 3 ||
+                   srcDesc.length < 3)) {
+        return false;
+    }
+
+    TbbEvalPatchesPacked(src, srcDesc, dst, dstDesc,
+                         normal, normalDesc,
+                         numPatchCoords, patchCoords, patchArrays,
+                         patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
 /* static */
 void
 TbbEvaluator::Synchronize(void *) {
@@ -27,6 +27,8 @@
 
 #include "../version.h"
 #include "../osd/bufferDescriptor.h"
+#include "../osd/grainPolicy.h"
+#include "../osd/packedBufferDescriptor.h"
 #include "../osd/types.h"
 
 #include <cstddef>
@@ -34,6 +36,10 @@
 namespace OpenSubdiv {
 namespace OPENSUBDIV_VERSION {
 
+namespace Far {
+    class CompactPatchVertices;
+}
+
 namespace Osd {
 
 class TbbEvaluator {
@@ -62,7 +68,7 @@ public:
     ///
     /// @param stencilTable   Far::StencilTable or equivalent
     ///
-    /// @param instance       not used in the tbb kernel
+    /// @param instance       evaluator providing the grain policy (optional)
     ///                       (declared as a typed pointer to prevent
     ///                        undesirable template resolution)
     ///
@@ -76,7 +82,6 @@ public:
         TbbEvaluator const *instance = NULL,
         void *deviceContext = NULL) {
 
-        (void)instance;       // unused
         (void)deviceContext;  // unused
 
         if (stencilTable->GetNumStencils() == 0)
@@ -89,7 +94,8 @@ public:
                             &stencilTable->GetControlIndices()[0],
                             &stencilTable->GetWeights()[0],
                             /*start = */ 0,
-                            /*end   = */ stencilTable->GetNumStencils());
+                            /*end   = */ stencilTable->GetNumStencils(),
+                            getGrainPolicy(instance));
     }
 
     /// \brief Static eval stencils function which takes raw CPU pointers for
@@ -118,6 +124,8 @@ public:
     ///
     /// @param end            end index of stencil table
     ///
+    /// @param grainPolicy    how the stencils are split into tasks
+    ///
     static bool EvalStencils(
         const float *src, BufferDescriptor const &srcDesc,
         float *dst,       BufferDescriptor const &dstDesc,
@@ -125,7 +133,8 @@ public:
         const int * offsets,
         const int * indices,
         const float * weights,
-        int start, int end);
+        int start, int end,
+        GrainPolicy const &grainPolicy = GrainPolicy());
 
     /// \brief Generic static eval stencils function with derivatives.
     ///        This function has a same signature as other device kernels
@@ -158,7 +167,7 @@ public:
     ///
     /// @param stencilTable   Far::StencilTable or equivalent
     ///
-    /// @param instance       not used in the tbb kernel
+    /// @param instance       evaluator providing the grain policy (optional)
     ///                       (declared as a typed pointer to prevent
     ///                        undesirable template resolution)
     ///
@@ -174,7 +183,6 @@ public:
         const TbbEvaluator *instance = NULL,
         void * deviceContext = NULL) {
 
-        (void)instance;       // unused
         (void)deviceContext;  // unused
 
         return EvalStencils(srcBuffer->BindCpuBuffer(), srcDesc,
@@ -188,7 +196,8 @@ public:
                             &stencilTable->GetDuWeights()[0],
                             &stencilTable->GetDvWeights()[0],
                             /*start = */ 0,
-                            /*end   = */ stencilTable->GetNumStencils());
+                            /*end   = */ stencilTable->GetNumStencils(),
+                            getGrainPolicy(instance));
     }
 
     /// \brief Static eval stencils function with derivatives, which takes
@@ -231,6 +240,8 @@ public:
     ///
     /// @param end            end index of stencil table
     ///
+    /// @param grainPolicy    how the stencils are split into tasks
+    ///
     static bool EvalStencils(
         const float *src, BufferDescriptor const &srcDesc,
         float *dst,       BufferDescriptor const &dstDesc,
@@ -242,7 +253,8 @@ public:
         const float * weights,
         const float * duWeights,
         const float * dvWeights,
-        int start, int end);
+        int start, int end,
+        GrainPolicy const &grainPolicy = GrainPolicy());
 
     /// \brief Generic static eval stencils function with derivatives.
     ///        This function has a same signature as other device kernels
@@ -293,7 +305,7 @@ public:
     ///
     /// @param stencilTable   Far::StencilTable or equivalent
     ///
-    /// @param instance       not used in the tbb kernel
+    /// @param instance       evaluator providing the grain policy (optional)
     ///                       (declared as a typed pointer to prevent
     ///                        undesirable template resolution)
     ///
@@ -312,7 +324,6 @@ public:
         const TbbEvaluator *instance = NULL,
         void * deviceContext = NULL) {
 
-        (void)instance;       // unused
         (void)deviceContext;  // unused
 
         return EvalStencils(srcBuffer->BindCpuBuffer(), srcDesc,
@@ -332,7 +343,8 @@ public:
                             &stencilTable->GetDuvWeights()[0],
                             &stencilTable->GetDvvWeights()[0],
                             /*start = */ 0,
-                            /*end   = */ stencilTable->GetNumStencils());
+                            /*end   = */ stencilTable->GetNumStencils(),
+                            getGrainPolicy(instance));
     }
 
     /// \brief Static eval stencils function with derivatives, which takes
@@ -396,6 +408,8 @@ public:
     ///
     /// @param end            end index of stencil table
     ///
+    /// @param grainPolicy    how the stencils are split into tasks
+    ///
     static bool EvalStencils(
         const float *src, BufferDescriptor const &srcDesc,
         float *dst,       BufferDescriptor const &dstDesc,
@@ -413,7 +427,8 @@ public:
         const float * duuWeights,
         const float * duvWeights,
         const float * dvvWeights,
-        int start, int end);
+        int start, int end,
+        GrainPolicy const &grainPolicy = GrainPolicy());
 
     /// ----------------------------------------------------------------------
     ///
@@ -790,6 +805,55 @@ public:
         const int *patchIndexBuffer,
         PatchParam const *patchParamBuffer);
 
+    /// \brief Static limit eval function. It takes an array of PatchCoord
+    ///        and evaluate limit values on given PatchTable, decoding the
+    ///        patch control vertices from a Far::CompactPatchVertices.
+    ///
+    /// @see CpuEvaluator::EvalPatches() with a Far::CompactPatchVertices
+    ///      for a description of the arguments.
+    ///
+    static bool EvalPatches(
+        const float *src, BufferDescriptor const &srcDesc,
+        float *dst,       BufferDescriptor const &dstDesc,
+        int numPatchCoords,
+        const PatchCoord *patchCoords,
+        const PatchArray *patchArrays,
+        Far::CompactPatchVertices const *patchVertices,
+        const PatchParam *patchParamBuffer);
+
+    /// \brief Static limit eval function with derivatives, decoding the
+    ///        patch control vertices from a Far::CompactPatchVertices.
+    ///        Derivative outputs may be NULL.
+    ///
+    static bool EvalPatches(
+        const float *src, BufferDescriptor const &srcDesc,
+        float *dst,       BufferDescriptor const &dstDesc,
+        float *du,        BufferDescriptor const &duDesc,
+        float *dv,        BufferDescriptor const &dvDesc,
+        int numPatchCoords,
+        PatchCoord const *patchCoords,
+        PatchArray const *patchArrays,
+        Far::CompactPatchVertices const *patchVertices,
+        PatchParam const *patchParamBuffer);
+
+    /// \brief Static limit eval function with 1st and 2nd derivatives,
+    ///        decoding the patch control vertices from a
+    ///        Far::CompactPatchVertices. Derivative outputs may be NULL.
+    ///
+    static bool EvalPatches(
+        const float *src, BufferDescriptor const &srcDesc,
+        float *dst,       BufferDescriptor const &dstDesc,
+        float *du,        BufferDescriptor const &duDesc,
+        float *dv,        BufferDescriptor const &dvDesc,
+        float *duu,       BufferDescriptor const &duuDesc,
+        float *duv,       BufferDescriptor const &duvDesc,
+        float *dvv,       BufferDescriptor const &dvvDesc,
+        int numPatchCoords,
+        PatchCoord const *patchCoords,
+        PatchArray const *patchArrays,
+        Far::CompactPatchVertices const *patchVertices,
+        PatchParam const *patchParamBuffer);
+
     /// \brief Generic limit eval function. This function has a same
     ///        signature as other device kernels have so that it can be called
     ///        in the same way.
@@ -1217,6 +1281,806 @@ public:
                            patchTable->GetFVarPatchParamBuffer(fvarChannel));
     }
 
+    /// ----------------------------------------------------------------------
+    ///
+    ///   Double precision evaluations
+    ///
+    /// ----------------------------------------------------------------------
+
+    /// \brief Static eval stencils function which takes raw CPU pointers for
+    ///        double precision input and output, e.g. as computed from a
+    ///        Far::StencilTableReal<double>.
+    ///
+    /// The generic EvalStencils() functions above resolve to these when
+    /// BindCpuBuffer() returns a double pointer (see CpuVertexBufferReal).
+    ///
+    /// @see EvalStencils() for a description of the arguments.
+    ///
+    static bool EvalStencils(
+        const double *src, BufferDescriptor const &srcDesc,
+        double *dst,       BufferDescriptor const &dstDesc,
+        const int * sizes,
+        const int * offsets,
+        const int * indices,
+        const double * weights,
+        int start, int end,
+        GrainPolicy const &grainPolicy = GrainPolicy());
+
+    /// \brief Double precision eval stencils function with derivatives.
+    ///
+    /// @see EvalStencils() for a description of the arguments.
+    ///
+    static bool EvalStencils(
+        const double *src, BufferDescriptor const &srcDesc,
+        double *dst,       BufferDescriptor const &dstDesc,
+        double *du,        BufferDescriptor const &duDesc,
+        double *dv,        BufferDescriptor const &dvDesc,
+        const int * sizes,
+        const int * offsets,
+        const int * indices,
+        const double * weights,
+        const double * duWeights,
+        const double * dvWeights,
+        int start, int end,
+        GrainPolicy const &grainPolicy = GrainPolicy());
+
+    /// \brief Double precision eval stencils function with 1st and 2nd
+    ///        derivatives.
+    ///
+    /// @see EvalStencils() for a description of the arguments.
+    ///
+    static bool EvalStencils(
+        const double *src, BufferDescriptor const &srcDesc,
+        double *dst,       BufferDescriptor const &dstDesc,
+        double *du,        BufferDescriptor const &duDesc,
+        double *dv,        BufferDescriptor const &dvDesc,
+        double *duu,       BufferDescriptor const &duuDesc,
+        double *duv,       BufferDescriptor const &duvDesc,
+        double *dvv,       BufferDescriptor const &dvvDesc,
+        const int * sizes,
+        const int * offsets,
+        const int * indices,
+        const double * weights,
+        const double * duWeights,
+        const double * dvWeights,
+        const double * duuWeights,
+        const double * duvWeights,
+        const double * dvvWeights,
+        int start, int end,
+        GrainPolicy const &grainPolicy = GrainPolicy());
+
+    /// \brief Static limit eval function for double precision primvar data.
+    ///
+    /// Patch coordinates remain single precision, but the patch basis
+    /// weights are evaluated and accumulated in double precision.
+    ///
+    /// @see EvalPatches() for a description of the arguments.
+    ///
+    static bool EvalPatches(
+        const double *src, BufferDescriptor const &srcDesc,
+        double *dst,       BufferDescriptor const &dstDesc,
+        int numPatchCoords,
+        const PatchCoord *patchCoords,
+        const PatchArray *patchArrays,
+        const int *patchIndexBuffer,
+        const PatchParam *patchParamBuffer);
+
+    /// \brief Double precision limit eval function with derivatives.
+    ///
+    /// @see EvalPatches() for a description of the arguments.
+    ///
+    static bool EvalPatches(
+        const double *src, BufferDescriptor const &srcDesc,
+        double *dst,       BufferDescriptor const &dstDesc,
+        double *du,        BufferDescriptor const &duDesc,
+        double *dv,        BufferDescriptor const &dvDesc,
+        int numPatchCoords,
+        PatchCoord const *patchCoords,
+        PatchArray const *patchArrays,
+        const int *patchIndexBuffer,
+        PatchParam const *patchParamBuffer);
+
+    /// \brief Double precision limit eval function with 1st and 2nd
+    ///        derivatives.
+    ///
+    /// @see EvalPatches() for a description of the arguments.
+    ///
+    static bool EvalPatches(
+        const double *src, BufferDescriptor const &srcDesc,
+        double *dst,       BufferDescriptor const &dstDesc,
+        double *du,        BufferDescriptor const &duDesc,
+        double *dv,        BufferDescriptor const &dvDesc,
+        double *duu,       BufferDescriptor const &duuDesc,
+        double *duv,       BufferDescriptor const &duvDesc,
+        double *dvv,       BufferDescriptor const &dvvDesc,
+        int numPatchCoords,
+        PatchCoord const *patchCoords,
+        PatchArray const *patchArrays,
+        const int *patchIndexBuffer,
+        PatchParam const *patchParamBuffer);
+
+    /// ----------------------------------------------------------------------
+    ///
+    ///   Instanced evaluations
+    ///
+    /// ----------------------------------------------------------------------
+
+    /// \brief Generic instanced eval stencils function. Applies the same
+    ///        stencil table to numInstances primvar buffers sharing its
+    ///        topology (e.g. a crowd of deformed copies of one mesh).
+    ///
+    /// The instances are laid out contiguously in the source and destination
+    /// buffers; the buffer descriptors apply to every instance.
+    /// The work is distributed over blocks of instances and stencils.
+    ///
+    /// @param srcBuffer          Input primvar buffer holding all instances.
+    ///                           must have BindCpuBuffer() method returning a
+    ///                           const float pointer for read
+    ///
+    /// @param srcDesc            vertex buffer descriptor for an instance of
+    ///                           the input buffer
+    ///
+    /// @param srcInstanceStride  number of elements between two consecutive
+    ///                           instances of the input buffer
+    ///
+    /// @param dstBuffer          Output primvar buffer holding all instances.
+    ///                           must have BindCpuBuffer() method returning a
+    ///                           float pointer for write
+    ///
+    /// @param dstDesc            vertex buffer descriptor for an instance of
+    ///                           the output buffer
+    ///
+    /// @param dstInstanceStride  number of elements between two consecutive
+    ///                           instances of the output buffer
+    ///
+    /// @param numInstances       number of instances
+    ///
+    /// @param stencilTable       Far::StencilTable or equivalent
+    ///
+    template <typename SRC_BUFFER, typename DST_BUFFER, typename STENCIL_TABLE>
+    static bool EvalStencilsInstanced(
+        SRC_BUFFER *srcBuffer, BufferDescriptor const &srcDesc,
+        int srcInstanceStride,
+        DST_BUFFER *dstBuffer, BufferDescriptor const &dstDesc,
+        int dstInstanceStride,
+        int numInstances,
+        STENCIL_TABLE const *stencilTable) {
+
+        if (stencilTable->GetNumStencils() == 0)
+            return false;
+
+        return EvalStencilsInstanced(srcBuffer->BindCpuBuffer(), srcDesc,
+                                     srcInstanceStride,
+                                     dstBuffer->BindCpuBuffer(), dstDesc,
+                                     dstInstanceStride,
+                                     numInstances,
+                                     &stencilTable->GetSizes()[0],
+                                     &stencilTable->GetOffsets()[0],
+                                     &stencilTable->GetControlIndices()[0],
+                                     &stencilTable->GetWeights()[0],
+                                     /*start = */ 0,
+                                     /*end   = */ stencilTable->GetNumStencils());
+    }
+
+    /// \brief Static instanced eval stencils function which takes raw CPU
+    ///        pointers to instances laid out contiguously.
+    ///
+    /// As with EvalStencils(), stencil start + i is written to element i
+    /// of each output instance.
+    ///
+    /// @see EvalStencils() and the generic EvalStencilsInstanced() for a
+    ///      description of the arguments.
+    ///
+    static bool EvalStencilsInstanced(
+        const float *src, BufferDescriptor const &srcDesc,
+        int srcInstanceStride,
+        float *dst,       BufferDescriptor const &dstDesc,
+        int dstInstanceStride,
+        int numInstances,
+        const int * sizes,
+        const int * offsets,
+        const int * indices,
+        const float * weights,
+        int start, int end);
+
+    /// \brief Static instanced eval stencils function which takes a table of
+    ///        pointers to the instances, which may be allocated separately.
+    ///
+    /// As with EvalStencils(), stencil start + i is written to element i
+    /// of each output instance.
+    ///
+    /// @param srcInstances   array of numInstances input primvar pointers.
+    ///                       An offset of srcDesc will be applied internally
+    ///
+    /// @param dstInstances   array of numInstances output primvar pointers.
+    ///                       An offset of dstDesc will be applied internally
+    ///
+    /// @see EvalStencils() for a description of the other arguments.
+    ///
+    static bool EvalStencilsInstanced(
+        const float * const *srcInstances, BufferDescriptor const &srcDesc,
+        float * const *dstInstances,       BufferDescriptor const &dstDesc,
+        int numInstances,
+        const int * sizes,
+        const int * offsets,
+        const int * indices,
+        const float * weights,
+        int start, int end);
+
+    /// \brief Static instanced limit eval function. Evaluates the same patch
+    ///        coordinates on numInstances primvar buffers laid out
+    ///        contiguously, computing the patch basis once per coordinate.
+    ///
+    /// The outputs of an instance, including the optional derivatives, are
+    /// dstInstanceStride elements apart.
+    ///
+    /// @see EvalPatches() and the generic EvalStencilsInstanced() for a
+    ///      description of the arguments.
+    ///
+    static bool EvalPatchesInstanced(
+        const float *src, BufferDescriptor const &srcDesc,
+        int srcInstanceStride,
+        float *dst,       BufferDescriptor const &dstDesc,
+        float *du,        BufferDescriptor const &duDesc,
+        float *dv,        BufferDescriptor const &dvDesc,
+        int dstInstanceStride,
+        int numInstances,
+        int numPatchCoords,
+        const PatchCoord *patchCoords,
+        const PatchArray *patchArrays,
+        const int *patchIndexBuffer,
+        const PatchParam *patchParamBuffer);
+
+    /// \brief Static instanced limit eval function which takes tables of
+    ///        pointers to the instances. duInstances and dvInstances may be
+    ///        NULL.
+    ///
+    /// @see EvalPatches() and EvalStencilsInstanced() for a description of
+    ///      the arguments.
+    ///
+    static bool EvalPatchesInstanced(
+        const float * const *srcInstances, BufferDescriptor const &srcDesc,
+        float * const *dstInstances,       BufferDescriptor const &dstDesc,
+        float * const *duInstances,        BufferDescriptor const &duDesc,
+        float * const *dvInstances,        BufferDescriptor const &dvDesc,
+        int numInstances,
+        int numPatchCoords,
+        const PatchCoord *patchCoords,
+        const PatchArray *patchArrays,
+        const int *patchIndexBuffer,
+        const PatchParam *patchParamBuffer);
+
+    /// ----------------------------------------------------------------------
+    ///
+    ///   Stencil subset evaluations
+    ///
+    /// ----------------------------------------------------------------------
+
+    /// \brief Generic eval stencils function for a subset of the stencils,
+    ///        e.g. those affected by a change to a few control vertices as
+    ///        identified by a Far::StencilDependencyMap.
+    ///
+    /// Stencil i is written to element i of the output buffer, so the
+    /// outputs of the stencils not listed are left unchanged and the cost
+    /// of the evaluation is that of the subset rather than of the table.
+    ///
+    /// The subset is distributed over threads according to the grain
+    /// policy, the cost of each stencil being its number of weights.
+    ///
+    /// @param srcBuffer          Input primvar buffer.
+    ///                           must have BindCpuBuffer() method returning a
+    ///                           const float or double pointer for read
+    ///
+    /// @param srcDesc            vertex buffer descriptor for the input buffer
+    ///
+    /// @param dstBuffer          Output primvar buffer
+    ///                           must have BindCpuBuffer() method returning a
+    ///                           float or double pointer for write
+    ///
+    /// @param dstDesc            vertex buffer descriptor for the output buffer
+    ///
+    /// @param stencilTable       Far::StencilTable or equivalent
+    ///
+    /// @param numStencilIndices  number of stencils to evaluate
+    ///
+    /// @param stencilIndices     indices of the stencils to evaluate
+    ///
+    /// @param instance           evaluator providing the grain policy
+    ///                           (optional)
+    ///
+    template <typename SRC_BUFFER, typename DST_BUFFER, typename STENCIL_TABLE>
+    static bool EvalStencilsSubset(
+        SRC_BUFFER *srcBuffer, BufferDescriptor const &srcDesc,
+        DST_BUFFER *dstBuffer, BufferDescriptor const &dstDesc,
+        STENCIL_TABLE const *stencilTable,
+        int numStencilIndices,
+        const int * stencilIndices,
+        const TbbEvaluator *instance = NULL) {
+
+        if (stencilTable->GetNumStencils() == 0)
+            return false;
+
+        return EvalStencilsSubset(srcBuffer->BindCpuBuffer(), srcDesc,
+                                  dstBuffer->BindCpuBuffer(), dstDesc,
+                                  &stencilTable->GetSizes()[0],
+                                  &stencilTable->GetOffsets()[0],
+                                  &stencilTable->GetControlIndices()[0],
+                                  &stencilTable->GetWeights()[0],
+                                  numStencilIndices, stencilIndices,
+                                  getGrainPolicy(instance));
+    }
+
+    /// \brief Static eval stencils function for a subset of the stencils,
+    ///        which takes raw CPU pointers for input and output.
+    ///
+    /// @see EvalStencils() and the generic EvalStencilsSubset() for a
+    ///      description of the arguments.
+    ///
+    static bool EvalStencilsSubset(
+        const float *src, BufferDescriptor const &srcDesc,
+        float *dst,       BufferDescriptor const &dstDesc,
+        const int * sizes,
+        const int * offsets,
+        const int * indices,
+        const float * weights,
+        int numStencilIndices,
+        const int * stencilIndices,
+        GrainPolicy const &grainPolicy = GrainPolicy());
+
+    /// \brief Double precision eval stencils function for a subset of the
+    ///        stencils.
+    ///
+    /// @see EvalStencils() and the generic EvalStencilsSubset() for a
+    ///      description of the arguments.
+    ///
+    static bool EvalStencilsSubset(
+        const double *src, BufferDescriptor const &srcDesc,
+        double *dst,       BufferDescriptor const &dstDesc,
+        const int * sizes,
+        const int * offsets,
+        const int * indices,
+        const double * weights,
+        int numStencilIndices,
+        const int * stencilIndices,
+        GrainPolicy const &grainPolicy = GrainPolicy());
+
+    /// ----------------------------------------------------------------------
+    ///
+    ///   Limit normal evaluations
+    ///
+    /// ----------------------------------------------------------------------
+
+    /// \brief Generic eval stencils function computing the limit normals
+    ///        along with the limit positions.
+    ///
+    /// The normals are computed from the first three elements of the source
+    /// primvars (e.g. the positions) as the derivatives are accumulated, so
+    /// the derivatives are neither written nor read back. Where the first
+    /// derivatives are degenerate, the second derivatives of the stencil
+    /// table (if any) are used to resolve the normal -- since the locations
+    /// of the stencils within their patches are not known, it is resolved
+    /// in the direction of increasing u and v.
+    ///
+    /// @param srcBuffer      Input primvar buffer.
+    ///                       must have BindCpuBuffer() method returning a
+    ///                       const float or double pointer for read
+    ///
+    /// @param srcDesc        vertex buffer descriptor for the input buffer
+    ///                       (of length 3 or more)
+    ///
+    /// @param dstBuffer      Output primvar buffer
+    ///                       must have BindCpuBuffer() method returning a
+    ///                       float or double pointer for write
+    ///
+    /// @param dstDesc        vertex buffer descriptor for the output buffer
+    ///
+    /// @param normalBuffer   Output buffer of unit normals, which may be
+    ///                       interleaved with the output primvars
+    ///
+    /// @param normalDesc     vertex buffer descriptor for the normalBuffer
+    ///                       (of length 3 or more)
+    ///
+    /// @param stencilTable   Far::LimitStencilTable or equivalent
+    ///
+    /// @param instance       evaluator providing the grain policy (optional)
+    ///
+    template <typename SRC_BUFFER, typename DST_BUFFER, typename STENCIL_TABLE>
+    static bool EvalStencilsNormals(
+        SRC_BUFFER *srcBuffer,    BufferDescriptor const &srcDesc,
+        DST_BUFFER *dstBuffer,    BufferDescriptor const &dstDesc,
+        DST_BUFFER *normalBuffer, BufferDescriptor const &normalDesc,
+        STENCIL_TABLE const *stencilTable,
+        const TbbEvaluator *instance = NULL) {
+
+        if (stencilTable->GetNumStencils() == 0)
+            return false;
+
+        bool hasDeriv2 = !stencilTable->GetDuuWeights().empty();
+
+        return EvalStencilsNormals(srcBuffer->BindCpuBuffer(), srcDesc,
+                                   dstBuffer->BindCpuBuffer(), dstDesc,
+                                   normalBuffer->BindCpuBuffer(), normalDesc,
+                                   NULL, BufferDescriptor(),
+                                   NULL, BufferDescriptor(),
+                                   &stencilTable->GetSizes()[0],
+                                   &stencilTable->GetOffsets()[0],
+                                   &stencilTable->GetControlIndices()[0],
+                                   &stencilTable->GetWeights()[0],
+                                   &stencilTable->GetDuWeights()[0],
+                                   &stencilTable->GetDvWeights()[0],
+                                   hasDeriv2 ? &stencilTable->GetDuuWeights()[0]
+                                             : NULL,
+                                   hasDeriv2 ? &stencilTable->GetDuvWeights()[0]
+                                             : NULL,
+                                   hasDeriv2 ? &stencilTable->GetDvvWeights()[0]
+                                             : NULL,
+                                   /*start = */ 0,
+                                   /*end   = */ stencilTable->GetNumStencils(),
+                                   getGrainPolicy(instance));
+    }
+
+    /// \brief Static eval stencils function computing the limit normals and
+    ///        tangent frames, which takes raw CPU pointers for input and
+    ///        output.
+    ///
+    /// Any of the outputs may be NULL. The tangent is the first derivative
+    /// wrt u made orthogonal to the normal, and the bitangent completes the
+    /// right-handed orthonormal frame, i.e. it is the normal x the tangent.
+    /// Outputs are indexed relative to the first stencil evaluated.
+    ///
+    /// @param src            Input primvar pointer. An offset of srcDesc
+    ///                       will be applied internally (i.e. the pointer
+    ///                       should not include the offset)
+    ///
+    /// @param srcDesc        vertex buffer descriptor for the input buffer
+    ///                       (of length 3 or more)
+    ///
+    /// @param dst            Output primvar pointer (or NULL)
+    ///
+    /// @param dstDesc        vertex buffer descriptor for the output buffer
+    ///
+    /// @param normal         Output pointer of unit normals (or NULL)
+    ///
+    /// @param normalDesc     vertex buffer descriptor for the normals
+    ///
+    /// @param tangent        Output pointer of unit tangents (or NULL)
+    ///
+    /// @param tangentDesc    vertex buffer descriptor for the tangents
+    ///
+    /// @param bitangent      Output pointer of unit bitangents (or NULL)
+    ///
+    /// @param bitangentDesc  vertex buffer descriptor for the bitangents
+    ///
+    /// @param sizes          pointer to the sizes buffer of the stencil table
+    ///
+    /// @param offsets        pointer to the offsets buffer of the stencil table
+    ///
+    /// @param indices        pointer to the indices buffer of the stencil table
+    ///
+    /// @param weights        pointer to the weights buffer of the stencil table
+    ///
+    /// @param duWeights      pointer to the du-weights buffer of the stencil table
+    ///
+    /// @param dvWeights      pointer to the dv-weights buffer of the stencil table
+    ///
+    /// @param duuWeights     pointer to the duu-weights buffer of the stencil
+    ///                       table (or NULL)
+    ///
+    /// @param duvWeights     pointer to the duv-weights buffer of the stencil
+    ///                       table (or NULL)
+    ///
+    /// @param dvvWeights     pointer to the dvv-weights buffer of the stencil
+    ///                       table (or NULL)
+    ///
+    /// @param start          start index of stencil table
+    ///
+    /// @param end            end index of stencil table
+    ///
+    /// @param grainPolicy    how the stencils are split into tasks
+    ///
+    static bool EvalStencilsNormals(
+        const float *src, BufferDescriptor const &srcDesc,
+        float *dst,       BufferDescriptor const &dstDesc,
+        float *normal,    BufferDescriptor const &normalDesc,
+        float *tangent,   BufferDescriptor const &tangentDesc,
+        float *bitangent, BufferDescriptor const &bitangentDesc,
+        const int * sizes,
+        const int * offsets,
+        const int * indices,
+        const float * weights,
+        const float * duWeights,
+        const float * dvWeights,
+        const float * duuWeights,
+        const float * duvWeights,
+        const float * dvvWeights,
+        int start, int end,
+        GrainPolicy const &grainPolicy = GrainPolicy());
+
+    /// \brief Double precision eval stencils function computing the limit
+    ///        normals and tangent frames.
+    ///
+    /// @see the float version of EvalStencilsNormals() for a description
+    ///      of the arguments.
+    ///
+    static bool EvalStencilsNormals(
+        const double *src, BufferDescriptor const &srcDesc,
+        double *dst,       BufferDescriptor const &dstDesc,
+        double *normal,    BufferDescriptor const &normalDesc,
+        double *tangent,   BufferDescriptor const &tangentDesc,
+        double *bitangent, BufferDescriptor const &bitangentDesc,
+        const int * sizes,
+        const int * offsets,
+        const int * indices,
+        const double * weights,
+        const double * duWeights,
+        const double * dvWeights,
+        const double * duuWeights,
+        const double * duvWeights,
+        const double * dvvWeights,
+        int start, int end,
+        GrainPolicy const &grainPolicy = GrainPolicy());
+
+    /// \brief Generic limit eval function computing the limit normals along
+    ///        with the limit positions.
+    ///
+    /// The normals are computed from the first three elements of the source
+    /// primvars as the derivatives are accumulated. Where the first
+    /// derivatives are degenerate (e.g. at the corners of irregular patches)
+    /// the second derivatives are evaluated to resolve the normal from the
+    /// interior of the patch.
+    ///
+    /// @param srcBuffer        Input primvar buffer.
+    ///                         must have BindCpuBuffer() method returning a
+    ///                         const float or double pointer for read
+    ///
+    /// @param srcDesc          vertex buffer descriptor for the input buffer
+    ///                         (of length 3 or more)
+    ///
+    /// @param dstBuffer        Output primvar buffer
+    ///                         must have BindCpuBuffer() method returning a
+    ///                         float or double pointer for write
+    ///
+    /// @param dstDesc          vertex buffer descriptor for the output buffer
+    ///
+    /// @param normalBuffer     Output buffer of unit normals, which may be
+    ///                         interleaved with the output primvars
+    ///
+    /// @param normalDesc       vertex buffer descriptor for the normalBuffer
+    ///                         (of length 3 or more)
+    ///
+    /// @param numPatchCoords   number of patchCoords.
+    ///
+    /// @param patchCoords      array of locations to be evaluated.
+    ///
+    /// @param patchTable       CpuPatchTable or equivalent
+    ///
+    template <typename SRC_BUFFER, typename DST_BUFFER,
+              typename PATCHCOORD_BUFFER, typename PATCH_TABLE>
+    static bool EvalPatchesNormals(
+        SRC_BUFFER *srcBuffer,    BufferDescriptor const &srcDesc,
+        DST_BUFFER *dstBuffer,    BufferDescriptor const &dstDesc,
+        DST_BUFFER *normalBuffer, BufferDescriptor const &normalDesc,
+        int numPatchCoords,
+        PATCHCOORD_BUFFER *patchCoords,
+        PATCH_TABLE *patchTable) {
+
+        return EvalPatchesNormals(srcBuffer->BindCpuBuffer(), srcDesc,
+                                  dstBuffer->BindCpuBuffer(), dstDesc,
+                                  normalBuffer->BindCpuBuffer(), normalDesc,
+                                  NULL, BufferDescriptor(),
+                                  NULL, BufferDescriptor(),
+                                  numPatchCoords,
+                                  (const PatchCoord*)patchCoords->BindCpuBuffer(),
+                                  patchTable->GetPatchArrayBuffer(),
+                                  patchTable->GetPatchIndexBuffer(),
+                                  patchTable->GetPatchParamBuffer());
+    }
+
+    /// \brief Static limit eval function computing the limit normals and
+    ///        tangent frames, which takes raw CPU pointers for input and
+    ///        output.
+    ///
+    /// Any of the outputs may be NULL -- the tangent frame is defined as
+    /// for EvalStencilsNormals().
+    ///
+    /// @param src              Input primvar pointer. An offset of srcDesc
+    ///                         will be applied internally (i.e. the pointer
+    ///                         should not include the offset)
+    ///
+    /// @param srcDesc          vertex buffer descriptor for the input buffer
+    ///                         (of length 3 or more)
+    ///
+    /// @param dst              Output primvar pointer (or NULL)
+    ///
+    /// @param dstDesc          vertex buffer descriptor for the output buffer
+    ///
+    /// @param normal           Output pointer of unit normals (or NULL)
+    ///
+    /// @param normalDesc       vertex buffer descriptor for the normals
+    ///
+    /// @param tangent          Output pointer of unit tangents (or NULL)
+    ///
+    /// @param tangentDesc      vertex buffer descriptor for the tangents
+    ///
+    /// @param bitangent        Output pointer of unit bitangents (or NULL)
+    ///
+    /// @param bitangentDesc    vertex buffer descriptor for the bitangents
+    ///
+    /// @param numPatchCoords   number of patchCoords.
+    ///
+    /// @param patchCoords      array of locations to be evaluated.
+    ///
+    /// @param patchArrays      an array of Osd::PatchArray struct
+    ///                         indexed by PatchCoord::arrayIndex
+    ///
+    /// @param patchIndexBuffer an array of patch indices
+    ///                         indexed by PatchCoord::vertIndex
+    ///
+    /// @param patchParamBuffer an array of Osd::PatchParam struct
+    ///                         indexed by PatchCoord::patchIndex
+    ///
+    static bool EvalPatchesNormals(
+        const float *src, BufferDescriptor const &srcDesc,
+        float *dst,       BufferDescriptor const &dstDesc,
+        float *normal,    BufferDescriptor const &normalDesc,
+        float *tangent,   BufferDescriptor const &tangentDesc,
+        float *bitangent, BufferDescriptor const &bitangentDesc,
+        int numPatchCoords,
+        const PatchCoord *patchCoords,
+        const PatchArray *patchArrays,
+        const int *patchIndexBuffer,
+        const PatchParam *patchParamBuffer);
+
+    /// \brief Double precision limit eval function computing the limit
+    ///        normals and tangent frames.
+    ///
+    /// @see the float version of EvalPatchesNormals() for a description
+    ///      of the arguments.
+    ///
+    static bool EvalPatchesNormals(
+        const double *src, BufferDescriptor const &srcDesc,
+        double *dst,       BufferDescriptor const &dstDesc,
+        double *normal,    BufferDescriptor const &normalDesc,
+        double *tangent,   BufferDescriptor const &tangentDesc,
+        double *bitangent, BufferDescriptor const &bitangentDesc,
+        int numPatchCoords,
+        const PatchCoord *patchCoords,
+        const PatchArray *patchArrays,
+        const int *patchIndexBuffer,
+        const PatchParam *patchParamBuffer);
+
+    /// ----------------------------------------------------------------------
+    ///
+    ///   Packed output evaluations
+    ///
+    /// ----------------------------------------------------------------------
+
+    /// \brief Generic eval stencils function writing packed output, e.g.
+    ///        half float positions or 16-bit uvs for a renderer.
+    ///
+    /// The primvars are encoded as they are evaluated, so no float output
+    /// is written and no separate conversion pass is needed.
+    ///
+    /// @param srcBuffer      Input primvar buffer.
+    ///                       must have BindCpuBuffer() method returning a
+    ///                       const float pointer for read
+    ///
+    /// @param srcDesc        vertex buffer descriptor for the input buffer
+    ///
+    /// @param dst            Output pointer. An offset of dstDesc will be
+    ///                       applied internally.
+    ///
+    /// @param dstDesc        packed buffer descriptor for the output, of
+    ///                       the length of the input primvars (which must
+    ///                       be 3 for FORMAT_OCT16)
+    ///
+    /// @param stencilTable   Far::StencilTable or equivalent
+    ///
+    /// @param instance       evaluator providing the grain policy (optional)
+    ///
+    template <typename SRC_BUFFER, typename STENCIL_TABLE>
+    static bool EvalStencilsPacked(
+        SRC_BUFFER *srcBuffer, BufferDescriptor const &srcDesc,
+        void *dst,             PackedBufferDescriptor const &dstDesc,
+        STENCIL_TABLE const *stencilTable,
+        const TbbEvaluator *instance = NULL) {
+
+        if (stencilTable->GetNumStencils() == 0)
+            return false;
+
+        return EvalStencilsPacked(srcBuffer->BindCpuBuffer(), srcDesc,
+                                  dst, dstDesc,
+                                  &stencilTable->GetSizes()[0],
+                                  &stencilTable->GetOffsets()[0],
+                                  &stencilTable->GetControlIndices()[0],
+                                  &stencilTable->GetWeights()[0],
+                                  /*start = */ 0,
+                                  /*end   = */ stencilTable->GetNumStencils(),
+                                  getGrainPolicy(instance));
+    }
+
+    /// \brief Static eval stencils function writing packed output, which
+    ///        takes raw CPU pointers for input and output.
+    ///
+    /// Outputs are indexed relative to the first stencil evaluated.
+    ///
+    /// @see EvalStencils() and the generic EvalStencilsPacked() for a
+    ///      description of the arguments.
+    ///
+    static bool EvalStencilsPacked(
+        const float *src, BufferDescriptor const &srcDesc,
+        void *dst,        PackedBufferDescriptor const &dstDesc,
+        const int * sizes,
+        const int * offsets,
+        const int * indices,
+        const float * weights,
+        int start, int end,
+        GrainPolicy const &grainPolicy = GrainPolicy());
+
+    /// \brief Generic limit eval function writing packed output, with
+    ///        optional limit normals, e.g. octahedral encoded normals.
+    ///
+    /// The normals are computed from the first three elements of the input
+    /// primvars as for EvalPatchesNormals().
+    ///
+    /// @param srcBuffer        Input primvar buffer.
+    ///                         must have BindCpuBuffer() method returning a
+    ///                         const float pointer for read
+    ///
+    /// @param srcDesc          vertex buffer descriptor for the input buffer
+    ///
+    /// @param dst              Output pointer of the primvars (or NULL)
+    ///
+    /// @param dstDesc          packed buffer descriptor for the primvars
+    ///
+    /// @param normal           Output pointer of the normals (or NULL),
+    ///                         which may be interleaved with the primvars
+    ///
+    /// @param normalDesc       packed buffer descriptor for the normals, of
+    ///                         length 3
+    ///
+    /// @param numPatchCoords   number of patchCoords.
+    ///
+    /// @param patchCoords      array of locations to be evaluated.
+    ///
+    /// @param patchTable       CpuPatchTable or equivalent
+    ///
+    template <typename SRC_BUFFER, typename PATCHCOORD_BUFFER,
+              typename PATCH_TABLE>
+    static bool EvalPatchesPacked(
+        SRC_BUFFER *srcBuffer, BufferDescriptor const &srcDesc,
+        void *dst,             PackedBufferDescriptor const &dstDesc,
+        void *normal,          PackedBufferDescriptor const &normalDesc,
+        int numPatchCoords,
+        PATCHCOORD_BUFFER *patchCoords,
+        PATCH_TABLE *patchTable) {
+
+        return EvalPatchesPacked(srcBuffer->BindCpuBuffer(), srcDesc,
+                                 dst, dstDesc,
+                                 normal, normalDesc,
+                                 numPatchCoords,
+                                 (const PatchCoord*)patchCoords->BindCpuBuffer(),
+                                 patchTable->GetPatchArrayBuffer(),
+                                 patchTable->GetPatchIndexBuffer(),
+                                 patchTable->GetPatchParamBuffer());
+    }
+
+    /// \brief Static limit eval function writing packed output, which takes
+    ///        raw CPU pointers for input and output.
+    ///
+    /// @see EvalPatches() and the generic EvalPatchesPacked() for a
+    ///      description of the arguments.
+    ///
+    static bool EvalPatchesPacked(
+        const float *src, BufferDescriptor const &srcDesc,
+        void *dst,        PackedBufferDescriptor const &dstDesc,
+        void *normal,     PackedBufferDescriptor const &normalDesc,
+        int numPatchCoords,
+        const PatchCoord *patchCoords,
+        const PatchArray *patchArrays,
+        const int *patchIndexBuffer,
+        const PatchParam *patchParamBuffer);
+
     /// ----------------------------------------------------------------------
     ///
     ///   Other methods
@@ -1232,6 +2096,32 @@ public:
     /// @param numThreads      how many threads
     ///
     static void SetNumThreads(int numThreads);
+
+    /// \brief Constructor
+    ///
+    /// Evaluators are only instantiated to hold a grain policy: the stencil
+    /// evaluations to which an instance is passed are split into tasks
+    /// according to its policy, and evaluations without an instance (or
+    /// with raw pointers and no policy) use the default GrainPolicy.
+    ///
+    /// @param grainPolicy     see GrainPolicy
+    ///
+    explicit TbbEvaluator(GrainPolicy const &grainPolicy = GrainPolicy()) :
+        _grainPolicy(grainPolicy) { }
+
+    /// \brief Sets how the stencil evaluations using this instance are
+    ///        split into tasks
+    void SetGrainPolicy(GrainPolicy const &policy) { _grainPolicy = policy; }
+
+    /// \brief Returns the grain policy of this instance
+    GrainPolicy const &GetGrainPolicy() const { return _grainPolicy; }
+
+private:
+    static GrainPolicy getGrainPolicy(TbbEvaluator const *instance) {
+        return instance ? instance->_grainPolicy : GrainPolicy();
+    }
+
+    GrainPolicy _grainPolicy;
 };
 
 
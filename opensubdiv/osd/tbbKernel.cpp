@@ -26,13 +26,17 @@
 #include "../osd/tbbKernel.h"
 #include "../osd/types.h"
 #include "../osd/bufferDescriptor.h"
+#include "../osd/packedBufferDescriptor.h"
+#include "../osd/grainPolicy.h"
 #include "../osd/patchBasisCommonTypes.h"
 #include "../osd/patchBasisCommon.h"
 #include "../osd/patchBasisCommonEval.h"
 
 #include <cassert>
 #include <cstdlib>
+#include <tbb/blocked_range2d.h>
 #include <tbb/parallel_for.h>
+#include <vector>
 
 namespace OpenSubdiv {
 namespace OPENSUBDIV_VERSION {
@@ -47,15 +51,17 @@ elementAtIndex(T * src, int index, BufferDescriptor const &desc) {
     return src + index * desc.stride;
 }
 
+template <typename REAL>
 static inline void
-clear(float *dst, BufferDescriptor const &desc) {
+clear(REAL *dst, BufferDescriptor const &desc) {
 
     assert(dst);
-    memset(dst, 0, desc.length*sizeof(float));
+    memset(dst, 0, desc.length*sizeof(REAL));
 }
 
+template <typename REAL>
 static inline void
-addWithWeight(float *dst, const float *src, int srcIndex, float weight,
+addWithWeight(REAL *dst, const REAL *src, int srcIndex, REAL weight,
               BufferDescriptor const &desc) {
 
     assert(src && dst);
@@ -65,35 +71,40 @@ addWithWeight(float *dst, const float *src, int srcIndex, float weight,
     }
 }
 
+template <typename REAL>
 static inline void
-copy(float *dst, int dstIndex, const float *src,
+copy(REAL *dst, int dstIndex, const REAL *src,
      BufferDescriptor const &desc) {
 
     assert(src && dst);
 
     dst = elementAtIndex(dst, dstIndex, desc);
-    memcpy(dst, src, desc.length*sizeof(float));
+    memcpy(dst, src, desc.length*sizeof(REAL));
 }
 
 
+template <typename REAL>
 class TBBStencilKernel {
 
     BufferDescriptor _srcDesc;
     BufferDescriptor _dstDesc;
-    float const * _vertexSrc;
-    float * _vertexDst;
+    REAL const * _vertexSrc;
+    REAL * _vertexDst;
 
     int const * _sizes;
     int const * _offsets,
               * _indices;
-    float const * _weights;
+    REAL const * _weights;
+
+    int const * _ranges;
 
 
 public:
-    TBBStencilKernel(float const *src, BufferDescriptor srcDesc,
-                     float *dst,       BufferDescriptor dstDesc,
+    TBBStencilKernel(REAL const *src, BufferDescriptor srcDesc,
+                     REAL *dst,       BufferDescriptor dstDesc,
                      int const * sizes, int const * offsets,
-                     int const * indices, float const * weights) :
+                     int const * indices, REAL const * weights,
+                     int const * ranges) :
          _srcDesc(srcDesc),
          _dstDesc(dstDesc),
          _vertexSrc(src),
@@ -101,7 +112,8 @@ public:
          _sizes(sizes),
          _offsets(offsets),
          _indices(indices),
-         _weights(weights) { }
+         _weights(weights),
+         _ranges(ranges) { }
 
     TBBStencilKernel(TBBStencilKernel const & other) {
         _srcDesc    = other._srcDesc;
@@ -112,24 +124,30 @@ public:
         _weights    = other._weights;
         _vertexSrc  = other._vertexSrc;
         _vertexDst  = other._vertexDst;
+        _ranges     = other._ranges;
     }
 
+    // the range iterates over the partition of the stencils
     void operator() (tbb::blocked_range<int> const &r) const {
+        evaluate(_ranges[r.begin()], _ranges[r.end()]);
+    }
+
+    void evaluate(int begin, int end) const {
 #define USE_SIMD
 #ifdef USE_SIMD
         if (_srcDesc.length==4 && _srcDesc.stride==4 && _dstDesc.stride==4) {
 
             // SIMD fast path for aligned primvar data (4 floats)
-            int offset = _offsets[r.begin()];
+            int offset = _offsets[begin];
             ComputeStencilKernel<4>(_vertexSrc, _vertexDst,
-                _sizes, _indices+offset, _weights+offset, r.begin(), r.end());
+                _sizes, _indices+offset, _weights+offset, begin, end);
 
         } else if (_srcDesc.length==8 && _srcDesc.stride==4 && _dstDesc.stride==4) {
 
             // SIMD fast path for aligned primvar data (8 floats)
-            int offset = _offsets[r.begin()];
+            int offset = _offsets[begin];
             ComputeStencilKernel<8>(_vertexSrc, _vertexDst,
-                _sizes, _indices+offset, _weights+offset, r.begin(), r.end());
+                _sizes, _indices+offset, _weights+offset, begin, end);
 
         } else {
 #else
@@ -137,18 +155,18 @@ public:
 #endif
             int const * sizes = _sizes;
             int const * indices = _indices;
-            float const * weights = _weights;
+            REAL const * weights = _weights;
 
-            if (r.begin()>0) {
-                sizes += r.begin();
-                indices += _offsets[r.begin()];
-                weights += _offsets[r.begin()];
+            if (begin>0) {
+                sizes += begin;
+                indices += _offsets[begin];
+                weights += _offsets[begin];
             }
 
             // Slow path for non-aligned data
-            float * result = (float*)alloca(_srcDesc.length * sizeof(float));
+            REAL * result = (REAL*)alloca(_srcDesc.length * sizeof(REAL));
 
-            for (int i=r.begin(); i<r.end(); ++i, ++sizes) {
+            for (int i=begin; i<end; ++i, ++sizes) {
 
                 clear(result, _dstDesc);
 
@@ -162,38 +180,59 @@ public:
     }
 };
 
-void
-TbbEvalStencils(float const * src, BufferDescriptor const &srcDesc,
-                float * dst,       BufferDescriptor const &dstDesc,
+// Evaluates the stencil ranges in parallel, or serially if the evaluation
+// was not partitioned
+template <typename REAL>
+static void
+evalStencilRanges(TBBStencilKernel<REAL> const &kernel,
+                  std::vector<int> const &ranges) {
+
+    int numRanges = (int)ranges.size() - 1;
+    if (numRanges > 1) {
+        tbb::parallel_for(tbb::blocked_range<int>(0, numRanges, 1), kernel);
+    } else {
+        kernel.evaluate(ranges[0], ranges[1]);
+    }
+}
+
+template <typename REAL> void
+TbbEvalStencils(REAL const * src, BufferDescriptor const &srcDesc,
+                REAL * dst,       BufferDescriptor const &dstDesc,
                 int const * sizes,
                 int const * offsets,
                 int const * indices,
-                float const * weights,
-                int start, int end) {
+                REAL const * weights,
+                int start, int end,
+                GrainPolicy const &grainPolicy) {
+
+    std::vector<int> ranges;
+    CpuPartitionStencils(grainPolicy, sizes, offsets, start, end, ranges);
 
     src += srcDesc.offset;
     dst += dstDesc.offset;
 
-    TBBStencilKernel kernel(src, srcDesc, dst, dstDesc,
-                            sizes, offsets, indices, weights);
-
-    tbb::blocked_range<int> range(start, end, grain_size);
-
-    tbb::parallel_for(range, kernel);
+    TBBStencilKernel<REAL> kernel(src, srcDesc, dst, dstDesc,
+                                  sizes, offsets, indices, weights,
+                                  &ranges[0]);
+    evalStencilRanges(kernel, ranges);
 }
 
-void
-TbbEvalStencils(float const * src, BufferDescriptor const &srcDesc,
-                float * dst,       BufferDescriptor const &dstDesc,
-                float * du,        BufferDescriptor const &duDesc,
-                float * dv,        BufferDescriptor const &dvDesc,
+template <typename REAL> void
+TbbEvalStencils(REAL const * src, BufferDescriptor const &srcDesc,
+                REAL * dst,       BufferDescriptor const &dstDesc,
+                REAL * du,        BufferDescriptor const &duDesc,
+                REAL * dv,        BufferDescriptor const &dvDesc,
                 int const * sizes,
                 int const * offsets,
                 int const * indices,
-                float const * weights,
-                float const * duWeights,
-                float const * dvWeights,
-                int start, int end) {
+                REAL const * weights,
+                REAL const * duWeights,
+                REAL const * dvWeights,
+                int start, int end,
+                GrainPolicy const &grainPolicy) {
+
+    std::vector<int> ranges;
+    CpuPartitionStencils(grainPolicy, sizes, offsets, start, end, ranges);
 
     if (src) src += srcDesc.offset;
     if (dst) dst += dstDesc.offset;
@@ -202,46 +241,50 @@ TbbEvalStencils(float const * src, BufferDescriptor const &srcDesc,
 
     // PERFORMANCE: need to combine 3 launches together
     if (dst) {
-        TBBStencilKernel kernel(src, srcDesc, dst, dstDesc,
-                                sizes, offsets, indices, weights);
-        tbb::blocked_range<int> range(start, end, grain_size);
-        tbb::parallel_for(range, kernel);
+        TBBStencilKernel<REAL> kernel(src, srcDesc, dst, dstDesc,
+                                      sizes, offsets, indices, weights,
+                                      &ranges[0]);
+        evalStencilRanges(kernel, ranges);
     }
 
     if (du) {
-        TBBStencilKernel kernel(src, srcDesc, du, duDesc,
-                                sizes, offsets, indices, duWeights);
-        tbb::blocked_range<int> range(start, end, grain_size);
-        tbb::parallel_for(range, kernel);
+        TBBStencilKernel<REAL> kernel(src, srcDesc, du, duDesc,
+                                      sizes, offsets, indices, duWeights,
+                                      &ranges[0]);
+        evalStencilRanges(kernel, ranges);
     }
 
     if (dv) {
-        TBBStencilKernel kernel(src, srcDesc, dv, dvDesc,
-                                sizes, offsets, indices, dvWeights);
-        tbb::blocked_range<int> range(start, end, grain_size);
-        tbb::parallel_for(range, kernel);
+        TBBStencilKernel<REAL> kernel(src, srcDesc, dv, dvDesc,
+                                      sizes, offsets, indices, dvWeights,
+                                      &ranges[0]);
+        evalStencilRanges(kernel, ranges);
     }
 
 }
 
-void
-TbbEvalStencils(float const * src, BufferDescriptor const &srcDesc,
-                float * dst,       BufferDescriptor const &dstDesc,
-                float * du,        BufferDescriptor const &duDesc,
-                float * dv,        BufferDescriptor const &dvDesc,
-                float * duu,       BufferDescriptor const &duuDesc,
-                float * duv,       BufferDescriptor const &duvDesc,
-                float * dvv,       BufferDescriptor const &dvvDesc,
+template <typename REAL> void
+TbbEvalStencils(REAL const * src, BufferDescriptor const &srcDesc,
+                REAL * dst,       BufferDescriptor const &dstDesc,
+                REAL * du,        BufferDescriptor const &duDesc,
+                REAL * dv,        BufferDescriptor const &dvDesc,
+                REAL * duu,       BufferDescriptor const &duuDesc,
+                REAL * duv,       BufferDescriptor const &duvDesc,
+                REAL * dvv,       BufferDescriptor const &dvvDesc,
                 int const * sizes,
                 int const * offsets,
                 int const * indices,
-                float const * weights,
-                float const * duWeights,
-                float const * dvWeights,
-                float const * duuWeights,
-                float const * duvWeights,
-                float const * dvvWeights,
-                int start, int end) {
+                REAL const * weights,
+                REAL const * duWeights,
+                REAL const * dvWeights,
+                REAL const * duuWeights,
+                REAL const * duvWeights,
+                REAL const * dvvWeights,
+                int start, int end,
+                GrainPolicy const &grainPolicy) {
+
+    std::vector<int> ranges;
+    CpuPartitionStencils(grainPolicy, sizes, offsets, start, end, ranges);
 
     if (src) src += srcDesc.offset;
     if (dst) dst += dstDesc.offset;
@@ -253,45 +296,45 @@ TbbEvalStencils(float const * src, BufferDescriptor const &srcDesc,
 
     // PERFORMANCE: need to combine 3 launches together
     if (dst) {
-        TBBStencilKernel kernel(src, srcDesc, dst, dstDesc,
-                                sizes, offsets, indices, weights);
-        tbb::blocked_range<int> range(start, end, grain_size);
-        tbb::parallel_for(range, kernel);
+        TBBStencilKernel<REAL> kernel(src, srcDesc, dst, dstDesc,
+                                      sizes, offsets, indices, weights,
+                                      &ranges[0]);
+        evalStencilRanges(kernel, ranges);
     }
 
     if (du) {
-        TBBStencilKernel kernel(src, srcDesc, du, duDesc,
-                                sizes, offsets, indices, duWeights);
-        tbb::blocked_range<int> range(start, end, grain_size);
-        tbb::parallel_for(range, kernel);
+        TBBStencilKernel<REAL> kernel(src, srcDesc, du, duDesc,
+                                      sizes, offsets, indices, duWeights,
+                                      &ranges[0]);
+        evalStencilRanges(kernel, ranges);
     }
 
     if (dv) {
-        TBBStencilKernel kernel(src, srcDesc, dv, dvDesc,
-                                sizes, offsets, indices, dvWeights);
-        tbb::blocked_range<int> range(start, end, grain_size);
-        tbb::parallel_for(range, kernel);
+        TBBStencilKernel<REAL> kernel(src, srcDesc, dv, dvDesc,
+                                      sizes, offsets, indices, dvWeights,
+                                      &ranges[0]);
+        evalStencilRanges(kernel, ranges);
     }
 
     if (duu) {
-        TBBStencilKernel kernel(src, srcDesc, duu, duuDesc,
-                                sizes, offsets, indices, duuWeights);
-        tbb::blocked_range<int> range(start, end, grain_size);
-        tbb::parallel_for(range, kernel);
+        TBBStencilKernel<REAL> kernel(src, srcDesc, duu, duuDesc,
+                                      sizes, offsets, indices, duuWeights,
+                                      &ranges[0]);
+        evalStencilRanges(kernel, ranges);
     }
 
     if (duv) {
-        TBBStencilKernel kernel(src, srcDesc, duv, duvDesc,
-                                sizes, offsets, indices, duvWeights);
-        tbb::blocked_range<int> range(start, end, grain_size);
-        tbb::parallel_for(range, kernel);
+        TBBStencilKernel<REAL> kernel(src, srcDesc, duv, duvDesc,
+                                      sizes, offsets, indices, duvWeights,
+                                      &ranges[0]);
+        evalStencilRanges(kernel, ranges);
     }
 
     if (dvv) {
-        TBBStencilKernel kernel(src, srcDesc, dvv, dvvDesc,
-                                sizes, offsets, indices, dvvWeights);
-        tbb::blocked_range<int> range(start, end, grain_size);
-        tbb::parallel_for(range, kernel);
+        TBBStencilKernel<REAL> kernel(src, srcDesc, dvv, dvvDesc,
+                                      sizes, offsets, indices, dvvWeights,
+                                      &ranges[0]);
+        evalStencilRanges(kernel, ranges);
     }
 }
 
@@ -608,6 +651,813 @@ TbbEvalPatches(float const *src, BufferDescriptor const &srcDesc,
 
 }
 
+// ---------------------------------------------------------------------------
+
+class TbbEvalPatchesDoubleKernel {
+    BufferDescriptor _srcDesc;
+    BufferDescriptor _dstDesc;
+    BufferDescriptor _dstDuDesc;
+    BufferDescriptor _dstDvDesc;
+    BufferDescriptor _dstDuuDesc;
+    BufferDescriptor _dstDuvDesc;
+    BufferDescriptor _dstDvvDesc;
+    double const * _src;
+    double * _dst;
+    double * _dstDu;
+    double * _dstDv;
+    double * _dstDuu;
+    double * _dstDuv;
+    double * _dstDvv;
+    const PatchCoord *_patchCoords;
+    const PatchArray *_patchArrayBuffer;
+    const int        *_patchIndexBuffer;
+    const PatchParam *_patchParamBuffer;
+
+public:
+    TbbEvalPatchesDoubleKernel(double const *src, BufferDescriptor srcDesc,
+                               double *dst,       BufferDescriptor dstDesc,
+                               double *dstDu,     BufferDescriptor dstDuDesc,
+                               double *dstDv,     BufferDescriptor dstDvDesc,
+                               double *dstDuu,    BufferDescriptor dstDuuDesc,
+                               double *dstDuv,    BufferDescriptor dstDuvDesc,
+                               double *dstDvv,    BufferDescriptor dstDvvDesc,
+                               const PatchCoord *patchCoords,
+                               const PatchArray *patchArrayBuffer,
+                               const int *patchIndexBuffer,
+                               const PatchParam *patchParamBuffer) :
+        _srcDesc(srcDesc), _dstDesc(dstDesc),
+        _dstDuDesc(dstDuDesc), _dstDvDesc(dstDvDesc),
+        _dstDuuDesc(dstDuuDesc), _dstDuvDesc(dstDuvDesc), _dstDvvDesc(dstDvvDesc),
+        _src(src), _dst(dst),
+        _dstDu(dstDu), _dstDv(dstDv),
+        _dstDuu(dstDuu), _dstDuv(dstDuv), _dstDvv(dstDvv),
+        _patchCoords(patchCoords),
+        _patchArrayBuffer(patchArrayBuffer),
+        _patchIndexBuffer(patchIndexBuffer),
+        _patchParamBuffer(patchParamBuffer) {
+    }
+
+    void operator() (tbb::blocked_range<int> const &r) const {
+        // the basis evaluation is shared with the serial CPU kernel
+        CpuEvalPatches(_src, _srcDesc, _dst, _dstDesc,
+                       _dstDu, _dstDuDesc, _dstDv, _dstDvDesc,
+                       _dstDuu, _dstDuuDesc,
+                       _dstDuv, _dstDuvDesc,
+                       _dstDvv, _dstDvvDesc,
+                       r.begin(), r.end(),
+                       _patchCoords, _patchArrayBuffer,
+                       _patchIndexBuffer, _patchParamBuffer);
+    }
+};
+
+void
+TbbEvalPatches(double const *src, BufferDescriptor const &srcDesc,
+               double *dst,       BufferDescriptor const &dstDesc,
+               double *dstDu,     BufferDescriptor const &dstDuDesc,
+               double *dstDv,     BufferDescriptor const &dstDvDesc,
+               double *dstDuu,    BufferDescriptor const &dstDuuDesc,
+               double *dstDuv,    BufferDescriptor const &dstDuvDesc,
+               double *dstDvv,    BufferDescriptor const &dstDvvDesc,
+               int numPatchCoords,
+               const PatchCoord *patchCoords,
+               const PatchArray *patchArrayBuffer,
+               const int *patchIndexBuffer,
+               const PatchParam *patchParamBuffer) {
+
+    TbbEvalPatchesDoubleKernel kernel(src, srcDesc, dst, dstDesc,
+                                      dstDu, dstDuDesc, dstDv, dstDvDesc,
+                                      dstDuu, dstDuuDesc,
+                                      dstDuv, dstDuvDesc,
+                                      dstDvv, dstDvvDesc,
+                                      patchCoords,
+                                      patchArrayBuffer,
+                                      patchIndexBuffer,
+                                      patchParamBuffer);
+
+    tbb::blocked_range<int> range(0, numPatchCoords, grain_size);
+    tbb::parallel_for(range, kernel);
+}
+
+// ---------------------------------------------------------------------------
+
+class TbbEvalPatchesCompactKernel {
+    BufferDescriptor _srcDesc;
+    BufferDescriptor _dstDesc;
+    BufferDescriptor _dstDuDesc;
+    BufferDescriptor _dstDvDesc;
+    BufferDescriptor _dstDuuDesc;
+    BufferDescriptor _dstDuvDesc;
+    BufferDescriptor _dstDvvDesc;
+    float const * _src;
+    float * _dst;
+    float * _dstDu;
+    float * _dstDv;
+    float * _dstDuu;
+    float * _dstDuv;
+    float * _dstDvv;
+    const PatchCoord *_patchCoords;
+    const PatchArray *_patchArrayBuffer;
+    Far::CompactPatchVertices const *_patchVertices;
+    const PatchParam *_patchParamBuffer;
+
+public:
+    TbbEvalPatchesCompactKernel(float const *src, BufferDescriptor srcDesc,
+                                float *dst,       BufferDescriptor dstDesc,
+                                float *dstDu,     BufferDescriptor dstDuDesc,
+                                float *dstDv,     BufferDescriptor dstDvDesc,
+                                float *dstDuu,    BufferDescriptor dstDuuDesc,
+                                float *dstDuv,    BufferDescriptor dstDuvDesc,
+                                float *dstDvv,    BufferDescriptor dstDvvDesc,
+                                const PatchCoord *patchCoords,
+                                const PatchArray *patchArrayBuffer,
+                                Far::CompactPatchVertices const *patchVertices,
+                                const PatchParam *patchParamBuffer) :
+        _srcDesc(srcDesc), _dstDesc(dstDesc),
+        _dstDuDesc(dstDuDesc), _dstDvDesc(dstDvDesc),
+        _dstDuuDesc(dstDuuDesc), _dstDuvDesc(dstDuvDesc), _dstDvvDesc(dstDvvDesc),
+        _src(src), _dst(dst),
+        _dstDu(dstDu), _dstDv(dstDv),
+        _dstDuu(dstDuu), _dstDuv(dstDuv), _dstDvv(dstDvv),
+        _patchCoords(patchCoords),
+        _patchArrayBuffer(patchArrayBuffer),
+        _patchVertices(patchVertices),
+        _patchParamBuffer(patchParamBuffer) {
+    }
+
+    void operator() (tbb::blocked_range<int> const &r) const {
+        CpuEvalPatchesCompact(_src, _srcDesc, _dst, _dstDesc,
+                              _dstDu, _dstDuDesc, _dstDv, _dstDvDesc,
+                              _dstDuu, _dstDuuDesc,
+                              _dstDuv, _dstDuvDesc,
+                              _dstDvv, _dstDvvDesc,
+                              r.begin(), r.end(),
+                              _patchCoords, _patchArrayBuffer,
+                              _patchVertices, _patchParamBuffer);
+    }
+};
+
+void
+TbbEvalPatchesCompact(float const *src, BufferDescriptor const &srcDesc,
+                      float *dst,       BufferDescriptor const &dstDesc,
+                      float *dstDu,     BufferDescriptor const &dstDuDesc,
+                      float *dstDv,     BufferDescriptor const &dstDvDesc,
+                      float *dstDuu,    BufferDescriptor const &dstDuuDesc,
+                      float *dstDuv,    BufferDescriptor const &dstDuvDesc,
+                      float *dstDvv,    BufferDescriptor const &dstDvvDesc,
+                      int numPatchCoords,
+                      const PatchCoord *patchCoords,
+                      const PatchArray *patchArrayBuffer,
+                      Far::CompactPatchVertices const *patchVertices,
+                      const PatchParam *patchParamBuffer) {
+
+    TbbEvalPatchesCompactKernel kernel(src, srcDesc, dst, dstDesc,
+                                       dstDu, dstDuDesc, dstDv, dstDvDesc,
+                                       dstDuu, dstDuuDesc,
+                                       dstDuv, dstDuvDesc,
+                                       dstDvv, dstDvvDesc,
+                                       patchCoords,
+                                       patchArrayBuffer,
+                                       patchVertices,
+                                       patchParamBuffer);
+
+    tbb::blocked_range<int> range(0, numPatchCoords, grain_size);
+    tbb::parallel_for(range, kernel);
+}
+
+// ---------------------------------------------------------------------------
+
+template <typename REAL>
+class TbbEvalStencilSubsetKernel {
+    BufferDescriptor _srcDesc;
+    BufferDescriptor _dstDesc;
+    REAL const * _src;
+    REAL * _dst;
+    int const * _sizes;
+    int const * _offsets;
+    int const * _indices;
+    REAL const * _weights;
+    int const * _stencilIndices;
+    int const * _ranges;
+
+public:
+    TbbEvalStencilSubsetKernel(REAL const * src, BufferDescriptor srcDesc,
+                               REAL * dst,       BufferDescriptor dstDesc,
+                               int const * sizes,
+                               int const * offsets,
+                               int const * indices,
+                               REAL const * weights,
+                               int const * stencilIndices,
+                               int const * ranges) :
+        _srcDesc(srcDesc), _dstDesc(dstDesc), _src(src), _dst(dst),
+        _sizes(sizes), _offsets(offsets), _indices(indices),
+        _weights(weights), _stencilIndices(stencilIndices),
+        _ranges(ranges) {
+    }
+
+    void operator() (tbb::blocked_range<int> const &r) const {
+        for (int i = r.begin(); i < r.end(); ++i) {
+            CpuEvalStencilSubset(_src, _srcDesc, _dst, _dstDesc,
+                                 _sizes, _offsets, _indices, _weights,
+                                 _stencilIndices, _ranges[i], _ranges[i+1]);
+        }
+    }
+};
+
+template <typename REAL> void
+TbbEvalStencilSubset(REAL const * src, BufferDescriptor const &srcDesc,
+                     REAL * dst,       BufferDescriptor const &dstDesc,
+                     int const * sizes,
+                     int const * offsets,
+                     int const * indices,
+                     REAL const * weights,
+                     int numStencilIndices,
+                     int const * stencilIndices,
+                     GrainPolicy const &grainPolicy) {
+
+    std::vector<int> ranges;
+    CpuPartitionStencilSubset(grainPolicy, sizes, stencilIndices,
+                              0, numStencilIndices, ranges);
+
+    TbbEvalStencilSubsetKernel<REAL> kernel(src, srcDesc, dst, dstDesc,
+                                            sizes, offsets, indices, weights,
+                                            stencilIndices, &ranges[0]);
+
+    int numRanges = (int)ranges.size() - 1;
+    if (numRanges > 1) {
+        tbb::parallel_for(tbb::blocked_range<int>(0, numRanges, 1), kernel);
+    } else {
+        kernel(tbb::blocked_range<int>(0, 1));
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+template <typename REAL>
+class TbbEvalStencilNormalsKernel {
+    BufferDescriptor _srcDesc;
+    BufferDescriptor _dstDesc;
+    BufferDescriptor _normalDesc;
+    BufferDescriptor _tangentDesc;
+    BufferDescriptor _bitangentDesc;
+    REAL const * _src;
+    REAL * _dst;
+    REAL * _normal;
+    REAL * _tangent;
+    REAL * _bitangent;
+    int const * _sizes;
+    int const * _offsets;
+    int const * _indices;
+    REAL const * _weights;
+    REAL const * _duWeights;
+    REAL const * _dvWeights;
+    REAL const * _duuWeights;
+    REAL const * _duvWeights;
+    REAL const * _dvvWeights;
+    int const * _ranges;
+
+public:
+    TbbEvalStencilNormalsKernel(REAL const * src, BufferDescriptor srcDesc,
+                                REAL * dst,       BufferDescriptor dstDesc,
+                                REAL * normal,    BufferDescriptor normalDesc,
+                                REAL * tangent,   BufferDescriptor tangentDesc,
+                                REAL * bitangent, BufferDescriptor bitangentDesc,
+                                int const * sizes,
+                                int const * offsets,
+                                int const * indices,
+                                REAL const * weights,
+                                REAL const * duWeights,
+                                REAL const * dvWeights,
+                                REAL const * duuWeights,
+                                REAL const * duvWeights,
+                                REAL const * dvvWeights,
+                                int const * ranges) :
+        _srcDesc(srcDesc), _dstDesc(dstDesc), _normalDesc(normalDesc),
+        _tangentDesc(tangentDesc), _bitangentDesc(bitangentDesc),
+        _src(src), _dst(dst), _normal(normal),
+        _tangent(tangent), _bitangent(bitangent),
+        _sizes(sizes), _offsets(offsets), _indices(indices),
+        _weights(weights), _duWeights(duWeights), _dvWeights(dvWeights),
+        _duuWeights(duuWeights), _duvWeights(duvWeights),
+        _dvvWeights(dvvWeights), _ranges(ranges) {
+    }
+
+    void operator() (tbb::blocked_range<int> const &r) const {
+        for (int k = r.begin(); k < r.end(); ++k) {
+            // outputs are indexed relative to the first stencil of the range
+            int i = _ranges[k] - _ranges[0];
+
+            CpuEvalStencilNormals(
+                _src, _srcDesc,
+                CpuGetElementPointer(_dst, i, _dstDesc.stride), _dstDesc,
+                CpuGetElementPointer(_normal, i, _normalDesc.stride),
+                _normalDesc,
+                CpuGetElementPointer(_tangent, i, _tangentDesc.stride),
+                _tangentDesc,
+                CpuGetElementPointer(_bitangent, i, _bitangentDesc.stride),
+                _bitangentDesc,
+                _sizes, _offsets, _indices,
+                _weights, _duWeights, _dvWeights,
+                _duuWeights, _duvWeights, _dvvWeights,
+                _ranges[k], _ranges[k+1]);
+        }
+    }
+};
+
+template <typename REAL> void
+TbbEvalStencilNormals(REAL const * src, BufferDescriptor const &srcDesc,
+                      REAL * dst,       BufferDescriptor const &dstDesc,
+                      REAL * normal,    BufferDescriptor const &normalDesc,
+                      REAL * tangent,   BufferDescriptor const &tangentDesc,
+                      REAL * bitangent, BufferDescriptor const &bitangentDesc,
+                      int const * sizes,
+                      int const * offsets,
+                      int const * indices,
+                      REAL const * weights,
+                      REAL const * duWeights,
+                      REAL const * dvWeights,
+                      REAL const * duuWeights,
+                      REAL const * duvWeights,
+                      REAL const * dvvWeights,
+                      int start, int end,
+                      GrainPolicy const &grainPolicy) {
+
+    std::vector<int> ranges;
+    CpuPartitionStencils(grainPolicy, sizes, offsets, start, end, ranges);
+
+    TbbEvalStencilNormalsKernel<REAL> kernel(src, srcDesc, dst, dstDesc,
+                                             normal, normalDesc,
+                                             tangent, tangentDesc,
+                                             bitangent, bitangentDesc,
+                                             sizes, offsets, indices,
+                                             weights, duWeights, dvWeights,
+                                             duuWeights, duvWeights,
+                                             dvvWeights, &ranges[0]);
+
+    int numRanges = (int)ranges.size() - 1;
+    if (numRanges > 1) {
+        tbb::parallel_for(tbb::blocked_range<int>(0, numRanges, 1), kernel);
+    } else {
+        kernel(tbb::blocked_range<int>(0, 1));
+    }
+}
+
+template <typename REAL>
+class TbbEvalPatchNormalsKernel {
+    BufferDescriptor _srcDesc;
+    BufferDescriptor _dstDesc;
+    BufferDescriptor _normalDesc;
+    BufferDescriptor _tangentDesc;
+    BufferDescriptor _bitangentDesc;
+    REAL const * _src;
+    REAL * _dst;
+    REAL * _normal;
+    REAL * _tangent;
+    REAL * _bitangent;
+    const PatchCoord *_patchCoords;
+    const PatchArray *_patchArrayBuffer;
+    const int        *_patchIndexBuffer;
+    const PatchParam *_patchParamBuffer;
+
+public:
+    TbbEvalPatchNormalsKernel(REAL const * src, BufferDescriptor srcDesc,
+                              REAL * dst,       BufferDescriptor dstDesc,
+                              REAL * normal,    BufferDescriptor normalDesc,
+                              REAL * tangent,   BufferDescriptor tangentDesc,
+                              REAL * bitangent, BufferDescriptor bitangentDesc,
+                              const PatchCoord *patchCoords,
+                              const PatchArray *patchArrayBuffer,
+                              const int *patchIndexBuffer,
+                              const PatchParam *patchParamBuffer) :
+        _srcDesc(srcDesc), _dstDesc(dstDesc), _normalDesc(normalDesc),
+        _tangentDesc(tangentDesc), _bitangentDesc(bitangentDesc),
+        _src(src), _dst(dst), _normal(normal),
+        _tangent(tangent), _bitangent(bitangent),
+        _patchCoords(patchCoords),
+        _patchArrayBuffer(patchArrayBuffer),
+        _patchIndexBuffer(patchIndexBuffer),
+        _patchParamBuffer(patchParamBuffer) {
+    }
+
+    void operator() (tbb::blocked_range<int> const &r) const {
+        CpuEvalPatchNormals(_src, _srcDesc, _dst, _dstDesc,
+                            _normal, _normalDesc,
+                            _tangent, _tangentDesc,
+                            _bitangent, _bitangentDesc,
+                            r.begin(), r.end(),
+                            _patchCoords, _patchArrayBuffer,
+                            _patchIndexBuffer, _patchParamBuffer);
+    }
+};
+
+template <typename REAL> void
+TbbEvalPatchNormals(REAL const * src, BufferDescriptor const &srcDesc,
+                    REAL * dst,       BufferDescriptor const &dstDesc,
+                    REAL * normal,    BufferDescriptor const &normalDesc,
+                    REAL * tangent,   BufferDescriptor const &tangentDesc,
+                    REAL * bitangent, BufferDescriptor const &bitangentDesc,
+                    int numPatchCoords,
+                    const PatchCoord *patchCoords,
+                    const PatchArray *patchArrayBuffer,
+                    const int *patchIndexBuffer,
+                    const PatchParam *patchParamBuffer) {
+
+    TbbEvalPatchNormalsKernel<REAL> kernel(src, srcDesc, dst, dstDesc,
+                                           normal, normalDesc,
+                                           tangent, tangentDesc,
+                                           bitangent, bitangentDesc,
+                                           patchCoords, patchArrayBuffer,
+                                           patchIndexBuffer, patchParamBuffer);
+
+    tbb::blocked_range<int> range(0, numPatchCoords, grain_size);
+    tbb::parallel_for(range, kernel);
+}
+
+// ---------------------------------------------------------------------------
+
+class TbbEvalStencilsPackedKernel {
+    BufferDescriptor _srcDesc;
+    PackedBufferDescriptor _dstDesc;
+    float const * _src;
+    unsigned char * _dst;
+    int const * _sizes;
+    int const * _offsets;
+    int const * _indices;
+    float const * _weights;
+    int const * _ranges;
+
+public:
+    TbbEvalStencilsPackedKernel(float const * src, BufferDescriptor srcDesc,
+                                void * dst, PackedBufferDescriptor dstDesc,
+                                int const * sizes,
+                                int const * offsets,
+                                int const * indices,
+                                float const * weights,
+                                int const * ranges) :
+        _srcDesc(srcDesc), _dstDesc(dstDesc),
+        _src(src), _dst((unsigned char *)dst),
+        _sizes(sizes), _offsets(offsets), _indices(indices),
+        _weights(weights), _ranges(ranges) {
+    }
+
+    void operator() (tbb::blocked_range<int> const &r) const {
+        for (int k = r.begin(); k < r.end(); ++k) {
+            // outputs are indexed relative to the first stencil of the range
+            unsigned char * dst = CpuGetElementPointer(
+                _dst, _ranges[k] - _ranges[0], _dstDesc.stride);
+
+            CpuEvalStencilsPacked(_src, _srcDesc, dst, _dstDesc,
+                                  _sizes, _offsets, _indices, _weights,
+                                  _ranges[k], _ranges[k+1]);
+        }
+    }
+};
+
+void
+TbbEvalStencilsPacked(float const * src, BufferDescriptor const &srcDesc,
+                      void * dst, PackedBufferDescriptor const &dstDesc,
+                      int const * sizes,
+                      int const * offsets,
+                      int const * indices,
+                      float const * weights,
+                      int start, int end,
+                      GrainPolicy const &grainPolicy) {
+
+    std::vector<int> ranges;
+    CpuPartitionStencils(grainPolicy, sizes, offsets, start, end, ranges);
+
+    TbbEvalStencilsPackedKernel kernel(src, srcDesc, dst, dstDesc,
+                                       sizes, offsets, indices, weights,
+                                       &ranges[0]);
+
+    int numRanges = (int)ranges.size() - 1;
+    if (numRanges > 1) {
+        tbb::parallel_for(tbb::blocked_range<int>(0, numRanges, 1), kernel);
+    } else {
+        kernel(tbb::blocked_range<int>(0, 1));
+    }
+}
+
+class TbbEvalPatchesPackedKernel {
+    BufferDescriptor _srcDesc;
+    PackedBufferDescriptor _dstDesc;
+    PackedBufferDescriptor _normalDesc;
+    float const * _src;
+    void * _dst;
+    void * _normal;
+    const PatchCoord *_patchCoords;
+    const PatchArray *_patchArrayBuffer;
+    const int        *_patchIndexBuffer;
+    const PatchParam *_patchParamBuffer;
+
+public:
+    TbbEvalPatchesPackedKernel(float const * src, BufferDescriptor srcDesc,
+                               void * dst, PackedBufferDescriptor dstDesc,
+                               void * normal, PackedBufferDescriptor normalDesc,
+                               const PatchCoord *patchCoords,
+                               const PatchArray *patchArrayBuffer,
+                               const int *patchIndexBuffer,
+                               const PatchParam *patchParamBuffer) :
+        _srcDesc(srcDesc), _dstDesc(dstDesc), _normalDesc(normalDesc),
+        _src(src), _dst(dst), _normal(normal),
+        _patchCoords(patchCoords),
+        _patchArrayBuffer(patchArrayBuffer),
+        _patchIndexBuffer(patchIndexBuffer),
+        _patchParamBuffer(patchParamBuffer) {
+    }
+
+    void operator() (tbb::blocked_range<int> const &r) const {
+        CpuEvalPatchesPacked(_src, _srcDesc, _dst, _dstDesc,
+                             _normal, _normalDesc,
+                             r.begin(), r.end(),
+                             _patchCoords, _patchArrayBuffer,
+                             _patchIndexBuffer, _patchParamBuffer);
+    }
+};
+
+void
+TbbEvalPatchesPacked(float const * src, BufferDescriptor const &srcDesc,
+                     void * dst, PackedBufferDescriptor const &dstDesc,
+                     void * normal, PackedBufferDescriptor const &normalDesc,
+                     int numPatchCoords,
+                     const PatchCoord *patchCoords,
+                     const PatchArray *patchArrayBuffer,
+                     const int *patchIndexBuffer,
+                     const PatchParam *patchParamBuffer) {
+
+    TbbEvalPatchesPackedKernel kernel(src, srcDesc, dst, dstDesc,
+                                      normal, normalDesc,
+                                      patchCoords, patchArrayBuffer,
+                                      patchIndexBuffer, patchParamBuffer);
+
+    tbb::blocked_range<int> range(0, numPatchCoords, grain_size);
+    tbb::parallel_for(range, kernel);
+}
+
+// ---------------------------------------------------------------------------
+
+class TbbEvalStencilsInstancedKernel {
+    BufferDescriptor _srcDesc;
+    BufferDescriptor _dstDesc;
+    float const * const * _srcInstances;
+    float * const * _dstInstances;
+    int const * _sizes;
+    int const * _offsets;
+    int const * _indices;
+    float const * _weights;
+    int _start;
+
+public:
+    TbbEvalStencilsInstancedKernel(float const * const * srcInstances,
+                                   BufferDescriptor srcDesc,
+                                   float * const * dstInstances,
+                                   BufferDescriptor dstDesc,
+                                   int const * sizes,
+                                   int const * offsets,
+                                   int const * indices,
+                                   float const * weights,
+                                   int start) :
+        _srcDesc(srcDesc), _dstDesc(dstDesc),
+        _srcInstances(srcInstances), _dstInstances(dstInstances),
+        _sizes(sizes), _offsets(offsets),
+        _indices(indices), _weights(weights), _start(start) {
+    }
+
+    // rows are instances, columns are stencils
+    void operator() (tbb::blocked_range2d<int> const &r) const {
+        BufferDescriptor blockDesc = _dstDesc;
+        blockDesc.offset += (r.cols().begin() - _start) * _dstDesc.stride;
+
+        CpuEvalStencilsInstanced(_srcInstances, _srcDesc,
+                                 _dstInstances, blockDesc,
+                                 r.rows().begin(), r.rows().end(),
+                                 _sizes, _offsets, _indices, _weights,
+                                 r.cols().begin(), r.cols().end());
+    }
+};
+
+void
+TbbEvalStencilsInstanced(float const * const * srcInstances,
+                         BufferDescriptor const &srcDesc,
+                         float * const * dstInstances,
+                         BufferDescriptor const &dstDesc,
+                         int numInstances,
+                         int const * sizes,
+                         int const * offsets,
+                         int const * indices,
+                         float const * weights,
+                         int start, int end) {
+
+    TbbEvalStencilsInstancedKernel kernel(srcInstances, srcDesc,
+                                          dstInstances, dstDesc,
+                                          sizes, offsets, indices, weights,
+                                          start);
+
+    tbb::blocked_range2d<int> range(0, numInstances, 16,
+                                    start, end, INSTANCED_STENCIL_BLOCK_SIZE);
+    tbb::parallel_for(range, kernel);
+}
+
+class TbbEvalPatchesInstancedKernel {
+    BufferDescriptor _srcDesc;
+    BufferDescriptor _dstDesc;
+    BufferDescriptor _dstDuDesc;
+    BufferDescriptor _dstDvDesc;
+    float const * const * _srcInstances;
+    float * const * _dstInstances;
+    float * const * _dstDuInstances;
+    float * const * _dstDvInstances;
+    int _numInstances;
+    const PatchCoord *_patchCoords;
+    const PatchArray *_patchArrayBuffer;
+    const int        *_patchIndexBuffer;
+    const PatchParam *_patchParamBuffer;
+
+public:
+    TbbEvalPatchesInstancedKernel(float const * const * srcInstances,
+                                  BufferDescriptor srcDesc,
+                                  float * const * dstInstances,
+                                  BufferDescriptor dstDesc,
+                                  float * const * dstDuInstances,
+                                  BufferDescriptor dstDuDesc,
+                                  float * const * dstDvInstances,
+                                  BufferDescriptor dstDvDesc,
+                                  int numInstances,
+                                  const PatchCoord *patchCoords,
+                                  const PatchArray *patchArrayBuffer,
+                                  const int *patchIndexBuffer,
+                                  const PatchParam *patchParamBuffer) :
+        _srcDesc(srcDesc), _dstDesc(dstDesc),
+        _dstDuDesc(dstDuDesc), _dstDvDesc(dstDvDesc),
+        _srcInstances(srcInstances), _dstInstances(dstInstances),
+        _dstDuInstances(dstDuInstances), _dstDvInstances(dstDvInstances),
+        _numInstances(numInstances),
+        _patchCoords(patchCoords),
+        _patchArrayBuffer(patchArrayBuffer),
+        _patchIndexBuffer(patchIndexBuffer),
+        _patchParamBuffer(patchParamBuffer) {
+    }
+
+    // the patch basis is evaluated once per coordinate for all instances
+    void operator() (tbb::blocked_range<int> const &r) const {
+        CpuEvalPatchesInstanced(_srcInstances, _srcDesc,
+                                _dstInstances, _dstDesc,
+                                _dstDuInstances, _dstDuDesc,
+                                _dstDvInstances, _dstDvDesc,
+                                0, _numInstances, r.begin(), r.end(),
+                                _patchCoords, _patchArrayBuffer,
+                                _patchIndexBuffer, _patchParamBuffer);
+    }
+};
+
+void
+TbbEvalPatchesInstanced(float const * const * srcInstances,
+                        BufferDescriptor const &srcDesc,
+                        float * const * dstInstances,
+                        BufferDescriptor const &dstDesc,
+                        float * const * dstDuInstances,
+                        BufferDescriptor const &dstDuDesc,
+                        float * const * dstDvInstances,
+                        BufferDescriptor const &dstDvDesc,
+                        int numInstances,
+                        int numPatchCoords,
+                        const PatchCoord *patchCoords,
+                        const PatchArray *patchArrayBuffer,
+                        const int *patchIndexBuffer,
+                        const PatchParam *patchParamBuffer) {
+
+    TbbEvalPatchesInstancedKernel kernel(srcInstances, srcDesc,
+                                         dstInstances, dstDesc,
+                                         dstDuInstances, dstDuDesc,
+                                         dstDvInstances, dstDvDesc,
+                                         numInstances, patchCoords,
+                                         patchArrayBuffer,
+                                         patchIndexBuffer,
+                                         patchParamBuffer);
+
+    tbb::blocked_range<int> range(0, numPatchCoords, 64);
+    tbb::parallel_for(range, kernel);
+}
+
+//
+//  Explicit instantiation for single and double precision:
+//
+template void
+TbbEvalStencils<float>(float const *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       int const *, int const *, int const *, float const *,
+                       int, int,
+                       GrainPolicy const &);
+
+template void
+TbbEvalStencils<float>(float const *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       int const *, int const *, int const *,
+                       float const *, float const *, float const *,
+                       int, int,
+                       GrainPolicy const &);
+
+template void
+TbbEvalStencils<float>(float const *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       float *, BufferDescriptor const &,
+                       int const *, int const *, int const *,
+                       float const *, float const *, float const *,
+                       float const *, float const *, float const *,
+                       int, int,
+                       GrainPolicy const &);
+
+template void
+TbbEvalStencils<double>(double const *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        int const *, int const *, int const *, double const *,
+                        int, int,
+                        GrainPolicy const &);
+
+template void
+TbbEvalStencils<double>(double const *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        int const *, int const *, int const *,
+                        double const *, double const *, double const *,
+                        int, int,
+                        GrainPolicy const &);
+
+template void
+TbbEvalStencils<double>(double const *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        double *, BufferDescriptor const &,
+                        int const *, int const *, int const *,
+                        double const *, double const *, double const *,
+                        double const *, double const *, double const *,
+                        int, int,
+                        GrainPolicy const &);
+
+template void
+TbbEvalStencilSubset<float>(float const *, BufferDescriptor const &,
+                            float *, BufferDescriptor const &,
+                            int const *, int const *, int const *,
+                            float const *, int, int const *,
+                            GrainPolicy const &);
+
+template void
+TbbEvalStencilSubset<double>(double const *, BufferDescriptor const &,
+                             double *, BufferDescriptor const &,
+                             int const *, int const *, int const *,
+                             double const *, int, int const *,
+                             GrainPolicy const &);
+
+template void
+TbbEvalStencilNormals<float>(float const *, BufferDescriptor const &,
+                             float *, BufferDescriptor const &,
+                             float *, BufferDescriptor const &,
+                             float *, BufferDescriptor const &,
+                             float *, BufferDescriptor const &,
+                             int const *, int const *, int const *,
+                             float const *, float const *, float const *,
+                             float const *, float const *, float const *,
+                             int, int,
+                             GrainPolicy const &);
+
+template void
+TbbEvalStencilNormals<double>(double const *, BufferDescriptor const &,
+                              double *, BufferDescriptor const &,
+                              double *, BufferDescriptor const &,
+                              double *, BufferDescriptor const &,
+                              double *, BufferDescriptor const &,
+                              int const *, int const *, int const *,
+                              double const *, double const *, double const *,
+                              double const *, double const *, double const *,
+                              int, int,
+                              GrainPolicy const &);
+
+template void
+TbbEvalPatchNormals<float>(float const *, BufferDescriptor const &,
+                           float *, BufferDescriptor const &,
+                           float *, BufferDescriptor const &,
+                           float *, BufferDescriptor const &,
+                           float *, BufferDescriptor const &,
+                           int, const PatchCoord *, const PatchArray *,
+                           const int *, const PatchParam *);
+
+template void
+TbbEvalPatchNormals<double>(double const *, BufferDescriptor const &,
+                            double *, BufferDescriptor const &,
+                            double *, BufferDescriptor const &,
+                            double *, BufferDescriptor const &,
+                            double *, BufferDescriptor const &,
+                            int, const PatchCoord *, const PatchArray *,
+                            const int *, const PatchParam *);
 
 }  // end namespace Osd
 
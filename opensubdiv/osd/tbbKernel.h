@@ -32,53 +32,67 @@
 namespace OpenSubdiv {
 namespace OPENSUBDIV_VERSION {
 
+namespace Far {
+    class CompactPatchVertices;
+}
+
 namespace Osd {
 
 struct PatchArray;
 struct PatchCoord;
 struct PatchParam;
 struct BufferDescriptor;
+struct PackedBufferDescriptor;
+struct GrainPolicy;
 
-void
-TbbEvalStencils(float const * src, BufferDescriptor const &srcDesc,
-                float * dst,       BufferDescriptor const &dstDesc,
+//
+// Stencil kernels, instantiated for float and double precision, partitioned
+// into tasks according to a grain policy
+//
+
+template <typename REAL> void
+TbbEvalStencils(REAL const * src, BufferDescriptor const &srcDesc,
+                REAL * dst,       BufferDescriptor const &dstDesc,
                 int const * sizes,
                 int const * offsets,
                 int const * indices,
-                float const * weights,
-                int start, int end);
+                REAL const * weights,
+                int start, int end,
+                GrainPolicy const &grainPolicy);
 
-void
-TbbEvalStencils(float const * src, BufferDescriptor const &srcDesc,
-                float * dst,       BufferDescriptor const &dstDesc,
-                float * dstDu,     BufferDescriptor const &dstDuDesc,
-                float * dstDv,     BufferDescriptor const &dstDvDesc,
+template <typename REAL> void
+TbbEvalStencils(REAL const * src, BufferDescriptor const &srcDesc,
+                REAL * dst,       BufferDescriptor const &dstDesc,
+                REAL * dstDu,     BufferDescriptor const &dstDuDesc,
+                REAL * dstDv,     BufferDescriptor const &dstDvDesc,
                 int const * sizes,
                 int const * offsets,
                 int const * indices,
-                float const * weights,
-                float const * duWeights,
-                float const * dvWeights,
-                int start, int end);
+                REAL const * weights,
+                REAL const * duWeights,
+                REAL const * dvWeights,
+                int start, int end,
+                GrainPolicy const &grainPolicy);
 
-void
-TbbEvalStencils(float const * src, BufferDescriptor const &srcDesc,
-                float * dst,       BufferDescriptor const &dstDesc,
-                float * dstDu,     BufferDescriptor const &dstDuDesc,
-                float * dstDv,     BufferDescriptor const &dstDvDesc,
-                float * dstDuu,    BufferDescriptor const &dstDuuDesc,
-                float * dstDuv,    BufferDescriptor const &dstDuvDesc,
-                float * dstDvv,    BufferDescriptor const &dstDvvDesc,
+template <typename REAL> void
+TbbEvalStencils(REAL const * src, BufferDescriptor const &srcDesc,
+                REAL * dst,       BufferDescriptor const &dstDesc,
+                REAL * dstDu,     BufferDescriptor const &dstDuDesc,
+                REAL * dstDv,     BufferDescriptor const &dstDvDesc,
+                REAL * dstDuu,    BufferDescriptor const &dstDuuDesc,
+                REAL * dstDuv,    BufferDescriptor const &dstDuvDesc,
+                REAL * dstDvv,    BufferDescriptor const &dstDvvDesc,
                 int const * sizes,
                 int const * offsets,
                 int const * indices,
-                float const * weights,
-                float const * duWeights,
-                float const * dvWeights,
-                float const * duuWeights,
-                float const * duvWeights,
-                float const * dvvWeights,
-                int start, int end);
+                REAL const * weights,
+                REAL const * duWeights,
+                REAL const * dvWeights,
+                REAL const * duuWeights,
+                REAL const * duvWeights,
+                REAL const * dvvWeights,
+                int start, int end,
+                GrainPolicy const &grainPolicy);
 
 void
 TbbEvalPatches(float const *src, BufferDescriptor const &srcDesc,
@@ -105,6 +119,133 @@ TbbEvalPatches(float const *src, BufferDescriptor const &srcDesc,
                const int *patchIndexBuffer,
                const PatchParam *patchParamBuffer);
 
+// Double precision limit evaluation -- any of the outputs may be NULL
+void
+TbbEvalPatches(double const *src, BufferDescriptor const &srcDesc,
+               double *dst,       BufferDescriptor const &dstDesc,
+               double *dstDu,     BufferDescriptor const &dstDuDesc,
+               double *dstDv,     BufferDescriptor const &dstDvDesc,
+               double *dstDuu,    BufferDescriptor const &dstDuuDesc,
+               double *dstDuv,    BufferDescriptor const &dstDuvDesc,
+               double *dstDvv,    BufferDescriptor const &dstDvvDesc,
+               int numPatchCoords,
+               const PatchCoord *patchCoords,
+               const PatchArray *patchArrayBuffer,
+               const int *patchIndexBuffer,
+               const PatchParam *patchParamBuffer);
+
+// Limit evaluation with control vertices decoded from a compact table --
+// any of the outputs may be NULL
+void
+TbbEvalPatchesCompact(float const *src, BufferDescriptor const &srcDesc,
+                      float *dst,       BufferDescriptor const &dstDesc,
+                      float *dstDu,     BufferDescriptor const &dstDuDesc,
+                      float *dstDv,     BufferDescriptor const &dstDvDesc,
+                      float *dstDuu,    BufferDescriptor const &dstDuuDesc,
+                      float *dstDuv,    BufferDescriptor const &dstDuvDesc,
+                      float *dstDvv,    BufferDescriptor const &dstDvvDesc,
+                      int numPatchCoords,
+                      const PatchCoord *patchCoords,
+                      const PatchArray *patchArrayBuffer,
+                      Far::CompactPatchVertices const *patchVertices,
+                      const PatchParam *patchParamBuffer);
+
+// Evaluation of the subset of stencils stencilIndices[0, numStencilIndices),
+// distributed over ranges of the subset
+template <typename REAL> void
+TbbEvalStencilSubset(REAL const * src, BufferDescriptor const &srcDesc,
+                     REAL * dst,       BufferDescriptor const &dstDesc,
+                     int const * sizes,
+                     int const * offsets,
+                     int const * indices,
+                     REAL const * weights,
+                     int numStencilIndices,
+                     int const * stencilIndices,
+                     GrainPolicy const &grainPolicy);
+
+// Limit normals and tangent frames, re-using the serial CPU kernels over
+// ranges of stencils or of patch coordinates
+template <typename REAL> void
+TbbEvalStencilNormals(REAL const * src, BufferDescriptor const &srcDesc,
+                      REAL * dst,       BufferDescriptor const &dstDesc,
+                      REAL * normal,    BufferDescriptor const &normalDesc,
+                      REAL * tangent,   BufferDescriptor const &tangentDesc,
+                      REAL * bitangent, BufferDescriptor const &bitangentDesc,
+                      int const * sizes,
+                      int const * offsets,
+                      int const * indices,
+                      REAL const * weights,
+                      REAL const * duWeights,
+                      REAL const * dvWeights,
+                      REAL const * duuWeights,
+                      REAL const * duvWeights,
+                      REAL const * dvvWeights,
+                      int start, int end,
+                      GrainPolicy const &grainPolicy);
+
+template <typename REAL> void
+TbbEvalPatchNormals(REAL const * src, BufferDescriptor const &srcDesc,
+                    REAL * dst,       BufferDescriptor const &dstDesc,
+                    REAL * normal,    BufferDescriptor const &normalDesc,
+                    REAL * tangent,   BufferDescriptor const &tangentDesc,
+                    REAL * bitangent, BufferDescriptor const &bitangentDesc,
+                    int numPatchCoords,
+                    const PatchCoord *patchCoords,
+                    const PatchArray *patchArrayBuffer,
+                    const int *patchIndexBuffer,
+                    const PatchParam *patchParamBuffer);
+
+// Packed output, re-using the serial CPU kernels over ranges of stencils or
+// of patch coordinates
+void
+TbbEvalStencilsPacked(float const * src, BufferDescriptor const &srcDesc,
+                      void * dst, PackedBufferDescriptor const &dstDesc,
+                      int const * sizes,
+                      int const * offsets,
+                      int const * indices,
+                      float const * weights,
+                      int start, int end,
+                      GrainPolicy const &grainPolicy);
+
+void
+TbbEvalPatchesPacked(float const * src, BufferDescriptor const &srcDesc,
+                     void * dst, PackedBufferDescriptor const &dstDesc,
+                     void * normal, PackedBufferDescriptor const &normalDesc,
+                     int numPatchCoords,
+                     const PatchCoord *patchCoords,
+                     const PatchArray *patchArrayBuffer,
+                     const int *patchIndexBuffer,
+                     const PatchParam *patchParamBuffer);
+
+// Instanced evaluation, distributed over blocks of instances and stencils
+void
+TbbEvalStencilsInstanced(float const * const * srcInstances,
+                         BufferDescriptor const &srcDesc,
+                         float * const * dstInstances,
+                         BufferDescriptor const &dstDesc,
+                         int numInstances,
+                         int const * sizes,
+                         int const * offsets,
+                         int const * indices,
+                         float const * weights,
+                         int start, int end);
+
+void
+TbbEvalPatchesInstanced(float const * const * srcInstances,
+                        BufferDescriptor const &srcDesc,
+                        float * const * dstInstances,
+                        BufferDescriptor const &dstDesc,
+                        float * const * dstDuInstances,
+                        BufferDescriptor const &dstDuDesc,
+                        float * const * dstDvInstances,
+                        BufferDescriptor const &dstDvDesc,
+                        int numInstances,
+                        int numPatchCoords,
+                        const PatchCoord *patchCoords,
+                        const PatchArray *patchArrayBuffer,
+                        const int *patchIndexBuffer,
+                        const PatchParam *patchParamBuffer);
+
 }  // end namespace Osd
 
 }  // end namespace OPENSUBDIV_VERSION
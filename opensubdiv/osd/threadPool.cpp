@@ -0,0 +1,179 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#include "../osd/threadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Osd {
+
+struct StdThreadPool::Impl {
+
+    Impl() : busy(false), task(0), begin(0), end(0), grainSize(1),
+        numChunks(0), nextChunk(0), numActiveWorkers(0), generation(0),
+        stop(false) { }
+
+    // Claims and runs chunks of the current job until none are left
+    void RunChunks() {
+        for (;;) {
+            int chunk = nextChunk.fetch_add(1);
+            if (chunk >= numChunks) break;
+
+            int chunkBegin = begin + chunk * grainSize;
+            int chunkEnd = std::min(chunkBegin + grainSize, end);
+            task->Run(chunkBegin, chunkEnd);
+        }
+    }
+
+    static void WorkerMain(Impl * impl) {
+
+        unsigned int lastGeneration = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(impl->mutex);
+                while (!impl->stop && impl->generation == lastGeneration) {
+                    impl->wakeCondition.wait(lock);
+                }
+                if (impl->stop) return;
+                lastGeneration = impl->generation;
+            }
+
+            impl->RunChunks();
+
+            {
+                std::lock_guard<std::mutex> lock(impl->mutex);
+                if (--impl->numActiveWorkers == 0) {
+                    impl->doneCondition.notify_one();
+                }
+            }
+        }
+    }
+
+    std::vector<std::thread> workers;
+
+    std::atomic<bool> busy;     // set for the duration of a job
+    std::mutex mutex;           // guards the job state below
+    std::condition_variable wakeCondition,
+                            doneCondition;
+
+    // current job
+    Task const * task;
+    int begin,
+        end,
+        grainSize,
+        numChunks;
+    std::atomic<int> nextChunk;
+
+    int numActiveWorkers;
+    unsigned int generation;
+    bool stop;
+};
+
+StdThreadPool::StdThreadPool(int numThreads) : _impl(new Impl) {
+
+    if (numThreads <= 0) {
+        numThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+
+    // the calling thread takes part in the work
+    for (int i = 1; i < numThreads; ++i) {
+        _impl->workers.push_back(std::thread(Impl::WorkerMain, _impl));
+    }
+}
+
+StdThreadPool::~StdThreadPool() {
+
+    {
+        std::lock_guard<std::mutex> lock(_impl->mutex);
+        _impl->stop = true;
+    }
+    _impl->wakeCondition.notify_all();
+
+    for (size_t i = 0; i < _impl->workers.size(); ++i) {
+        _impl->workers[i].join();
+    }
+    delete _impl;
+}
+
+int
+StdThreadPool::GetNumThreads() const {
+
+    return (int)_impl->workers.size() + 1;
+}
+
+void
+StdThreadPool::ParallelFor(int begin, int end, int grainSize,
+                           Task const &task) {
+
+    if (end <= begin) return;
+
+    grainSize = std::max(1, grainSize);
+    int numChunks = (end - begin + grainSize - 1) / grainSize;
+
+    // run serially if there is nothing to share or if the pool is busy,
+    // which includes calls made from within a task of the current job
+    bool idle = false;
+    if (numChunks == 1 || _impl->workers.empty() ||
+        !_impl->busy.compare_exchange_strong(idle, true)) {
+        task.Run(begin, end);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_impl->mutex);
+        _impl->task = &task;
+        _impl->begin = begin;
+        _impl->end = end;
+        _impl->grainSize = grainSize;
+        _impl->numChunks = numChunks;
+        _impl->nextChunk = 0;
+        _impl->numActiveWorkers = (int)_impl->workers.size();
+        ++_impl->generation;
+    }
+    _impl->wakeCondition.notify_all();
+
+    _impl->RunChunks();
+
+    {
+        std::unique_lock<std::mutex> lock(_impl->mutex);
+        while (_impl->numActiveWorkers > 0) {
+            _impl->doneCondition.wait(lock);
+        }
+        _impl->task = 0;
+    }
+    _impl->busy.store(false);
+}
+
+}  // end namespace Osd
+
+}  // end namespace OPENSUBDIV_VERSION
+}  // end namespace OpenSubdiv
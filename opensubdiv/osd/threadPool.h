@@ -0,0 +1,109 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#ifndef OPENSUBDIV3_OSD_THREAD_POOL_H
+#define OPENSUBDIV3_OSD_THREAD_POOL_H
+
+#include "../version.h"
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Osd {
+
+/// \brief Interface to the threads executing the work of ThreadPoolEvaluator
+///
+/// Applications which already manage their own threads (e.g. the scheduler
+/// of a DCC host) can implement ParallelFor() on top of them, and install
+/// their pool with ThreadPoolEvaluator::SetThreadPool(). Otherwise the
+/// evaluator uses a StdThreadPool.
+///
+class ThreadPool {
+public:
+    /// \brief A unit of work, applied to ranges of items
+    class Task {
+    public:
+        virtual ~Task() { }
+
+        /// Processes the items [begin, end). Ranges of the same ParallelFor
+        /// are disjoint, and may be processed concurrently.
+        virtual void Run(int begin, int end) const = 0;
+    };
+
+    virtual ~ThreadPool() { }
+
+    /// Returns the number of threads processing tasks, including the
+    /// calling thread
+    virtual int GetNumThreads() const = 0;
+
+    /// \brief Applies the task to the items [begin, end), split into chunks
+    ///        of grainSize items, and returns once all items are processed.
+    virtual void ParallelFor(int begin, int end, int grainSize,
+                             Task const &task) = 0;
+};
+
+/// \brief ThreadPool implementation over a persistent set of std::thread
+///
+/// The worker threads are created once, and wait for work in between
+/// calls to ParallelFor(). The chunks of a ParallelFor() are claimed one
+/// at a time by the workers and the calling thread, so that threads which
+/// finish early take over the remaining chunks.
+///
+/// Calls to ParallelFor() issued while the pool is busy (e.g. from
+/// another thread or from within a task) run on the calling thread.
+///
+class StdThreadPool : public ThreadPool {
+public:
+    /// Constructor. Uses the hardware concurrency if numThreads is not
+    /// positive.
+    explicit StdThreadPool(int numThreads = 0);
+
+    /// Destructor. Joins the worker threads.
+    virtual ~StdThreadPool();
+
+    /// Returns the number of threads, including the calling thread
+    virtual int GetNumThreads() const;
+
+    /// Applies the task to the items [begin, end)
+    virtual void ParallelFor(int begin, int end, int grainSize,
+                             Task const &task);
+
+private:
+    // Non-copyable
+    StdThreadPool(StdThreadPool const &);
+    StdThreadPool & operator=(StdThreadPool const &);
+
+    // The implementation isolates the threading headers from clients
+    struct Impl;
+    Impl * _impl;
+};
+
+}  // end namespace Osd
+
+}  // end namespace OPENSUBDIV_VERSION
+using namespace OPENSUBDIV_VERSION;
+
+}  // end namespace OpenSubdiv
+
+#endif  // OPENSUBDIV3_OSD_THREAD_POOL_H
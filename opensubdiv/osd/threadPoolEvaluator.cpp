@@ -0,0 +1,1702 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#include "../osd/threadPoolEvaluator.h"
+#include "../osd/cpuKernel.h"
+#include "../far/instrumentation.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Osd {
+
+// ---------------------------------------------------------------------------
+//
+//  Thread pool state
+//
+
+namespace {
+
+// Owns the default thread pool, created on first use
+struct DefaultThreadPool {
+    DefaultThreadPool() : pool(0), numThreads(0) { }
+    ~DefaultThreadPool() { delete pool; }
+
+    ThreadPool * Get() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!pool) {
+            pool = new StdThreadPool(numThreads);
+        }
+        return pool;
+    }
+
+    void Reset(int n) {
+        std::lock_guard<std::mutex> lock(mutex);
+        delete pool;
+        pool = 0;
+        numThreads = n;
+    }
+
+    std::mutex mutex;
+    StdThreadPool * pool;
+    int numThreads;
+};
+
+DefaultThreadPool _defaultThreadPool;
+ThreadPool * _threadPool = 0;
+
+//  Number of patch coordinates per task -- unlike that of stencils, the
+//  cost of patch coordinates is uniform:
+int const _patchGrainSize = 200;
+
+ThreadPool *
+getThreadPool() {
+    return _threadPool ? _threadPool : _defaultThreadPool.Get();
+}
+
+//
+//  Stencil evaluation over the ranges of stencils partitioned by the grain
+//  policy. Each range is evaluated by the serial kernel, from pointers
+//  shifted to its first stencil. Destinations are indexed relative to the
+//  first stencil evaluated, as with the CPU and OpenMP evaluators.
+//
+template <typename REAL>
+class StencilsTask : public ThreadPool::Task {
+public:
+    StencilsTask(REAL const * src, BufferDescriptor const &srcDesc,
+                 int numOutputs,
+                 REAL * const * dst, BufferDescriptor const * dstDesc,
+                 int const * sizes,
+                 int const * offsets,
+                 int const * indices,
+                 REAL const * const * weights,
+                 int const * ranges) :
+        _src(src), _srcDesc(srcDesc), _numOutputs(numOutputs),
+        _dst(dst), _dstDesc(dstDesc),
+        _sizes(sizes), _offsets(offsets), _indices(indices),
+        _weights(weights), _ranges(ranges) { }
+
+    virtual void Run(int begin, int end) const {
+        for (int r = begin; r < end; ++r) {
+            evalRange(_ranges[r], _ranges[r+1]);
+        }
+    }
+
+private:
+    void evalRange(int start, int end) const {
+        int offset = _offsets[start];
+
+        REAL * dst[7];
+        REAL const * weights[7];
+        for (int i = 0; i < _numOutputs; ++i) {
+            dst[i] = _dst[i] + (start - _ranges[0]) * _dstDesc[i].stride;
+            weights[i] = _weights[i] + offset;
+        }
+
+        int const * sizes = _sizes + start;
+        int const * indices = _indices + offset;
+        int n = end - start;
+
+        if (_numOutputs == 1) {
+            CpuEvalStencils(_src, _srcDesc,
+                            dst[0], _dstDesc[0],
+                            sizes, _offsets, indices, weights[0],
+                            0, n);
+        } else if (_numOutputs == 3) {
+            CpuEvalStencils(_src, _srcDesc,
+                            dst[0], _dstDesc[0],
+                            dst[1], _dstDesc[1],
+                            dst[2], _dstDesc[2],
+                            sizes, _offsets, indices,
+                            weights[0], weights[1], weights[2],
+                            0, n);
+        } else {
+            CpuEvalStencils(_src, _srcDesc,
+                            dst[0], _dstDesc[0],
+                            dst[1], _dstDesc[1],
+                            dst[2], _dstDesc[2],
+                            dst[3], _dstDesc[3],
+                            dst[4], _dstDesc[4],
+                            dst[5], _dstDesc[5],
+                            sizes, _offsets, indices,
+                            weights[0], weights[1], weights[2],
+                            weights[3], weights[4], weights[5],
+                            0, n);
+        }
+    }
+
+    REAL const * _src;
+    BufferDescriptor _srcDesc;
+    int _numOutputs;
+    REAL * const * _dst;
+    BufferDescriptor const * _dstDesc;
+    int const * _sizes;
+    int const * _offsets;
+    int const * _indices;
+    REAL const * const * _weights;
+    int const * _ranges;
+};
+
+template <typename REAL>
+void
+evalStencils(REAL const * src, BufferDescriptor const &srcDesc,
+             int numOutputs,
+             REAL * const * dst, BufferDescriptor const * dstDesc,
+             int const * sizes,
+             int const * offsets,
+             int const * indices,
+             REAL const * const * weights,
+             int start, int end,
+             GrainPolicy const &grainPolicy) {
+
+    std::vector<int> ranges;
+    CpuPartitionStencils(grainPolicy, sizes, offsets, start, end, ranges);
+
+    StencilsTask<REAL> task(src, srcDesc, numOutputs, dst, dstDesc,
+                            sizes, offsets, indices, weights, &ranges[0]);
+
+    getThreadPool()->ParallelFor(0, (int)ranges.size() - 1, 1, task);
+}
+
+//
+//  Limit evaluation over ranges of patch coordinates, re-using the serial
+//  CPU evaluator.
+//
+template <typename REAL>
+class PatchesTask : public ThreadPool::Task {
+public:
+    PatchesTask(REAL const * src, BufferDescriptor const &srcDesc,
+                REAL * const * dst, BufferDescriptor const * dstDesc,
+                PatchCoord const * patchCoords,
+                PatchArray const * patchArrays,
+                int const * patchIndexBuffer,
+                PatchParam const * patchParamBuffer) :
+        _src(src), _srcDesc(srcDesc), _dst(dst), _dstDesc(dstDesc),
+        _patchCoords(patchCoords), _patchArrays(patchArrays),
+        _patchIndexBuffer(patchIndexBuffer),
+        _patchParamBuffer(patchParamBuffer) { }
+
+    virtual void Run(int begin, int end) const;
+
+private:
+    REAL const * _src;
+    BufferDescriptor _srcDesc;
+    REAL * const * _dst;
+    BufferDescriptor const * _dstDesc;
+    PatchCoord const * _patchCoords;
+    PatchArray const * _patchArrays;
+    int const * _patchIndexBuffer;
+    PatchParam const * _patchParamBuffer;
+};
+
+template <typename REAL>
+void
+PatchesTask<REAL>::Run(int begin, int end) const {
+
+    CpuEvalPatches(_src, _srcDesc,
+                   _dst[0], _dstDesc[0],
+                   _dst[1], _dstDesc[1],
+                   _dst[2], _dstDesc[2],
+                   _dst[3], _dstDesc[3],
+                   _dst[4], _dstDesc[4],
+                   _dst[5], _dstDesc[5],
+                   begin, end, _patchCoords, _patchArrays,
+                   _patchIndexBuffer, _patchParamBuffer);
+}
+
+template <typename REAL>
+void
+evalPatches(REAL const * src, BufferDescriptor const &srcDesc,
+            REAL * const * dst, BufferDescriptor const * dstDesc,
+            int numPatchCoords,
+            PatchCoord const * patchCoords,
+            PatchArray const * patchArrays,
+            int const * patchIndexBuffer,
+            PatchParam const * patchParamBuffer) {
+
+    PatchesTask<REAL> task(src, srcDesc, dst, dstDesc,
+                           patchCoords, patchArrays,
+                           patchIndexBuffer, patchParamBuffer);
+
+    getThreadPool()->ParallelFor(0, numPatchCoords,
+                                 _patchGrainSize, task);
+}
+
+//
+//  Limit evaluation with the patch control vertices decoded from a compact
+//  table
+//
+class PatchesCompactTask : public ThreadPool::Task {
+public:
+    PatchesCompactTask(float const * src, BufferDescriptor const &srcDesc,
+                       float * const * dst, BufferDescriptor const * dstDesc,
+                       PatchCoord const * patchCoords,
+                       PatchArray const * patchArrays,
+                       Far::CompactPatchVertices const * patchVertices,
+                       PatchParam const * patchParamBuffer) :
+        _src(src), _srcDesc(srcDesc), _dst(dst), _dstDesc(dstDesc),
+        _patchCoords(patchCoords), _patchArrays(patchArrays),
+        _patchVertices(patchVertices),
+        _patchParamBuffer(patchParamBuffer) { }
+
+    virtual void Run(int begin, int end) const {
+        CpuEvalPatchesCompact(_src, _srcDesc,
+                              _dst[0], _dstDesc[0],
+                              _dst[1], _dstDesc[1],
+                              _dst[2], _dstDesc[2],
+                              _dst[3], _dstDesc[3],
+                              _dst[4], _dstDesc[4],
+                              _dst[5], _dstDesc[5],
+                              begin, end, _patchCoords, _patchArrays,
+                              _patchVertices, _patchParamBuffer);
+    }
+
+private:
+    float const * _src;
+    BufferDescriptor _srcDesc;
+    float * const * _dst;
+    BufferDescriptor const * _dstDesc;
+    PatchCoord const * _patchCoords;
+    PatchArray const * _patchArrays;
+    Far::CompactPatchVertices const * _patchVertices;
+    PatchParam const * _patchParamBuffer;
+};
+
+//
+//  Instanced evaluations : see OmpEvaluator for the tiling
+//
+class StencilsInstancedTask : public ThreadPool::Task {
+public:
+    StencilsInstancedTask(float const * const * srcInstances,
+                          BufferDescriptor const &srcDesc,
+                          float * const * dstInstances,
+                          BufferDescriptor const &dstDesc,
+                          int numInstances, int instanceBlockSize,
+                          int const * sizes,
+                          int const * offsets,
+                          int const * indices,
+                          float const * weights,
+                          int start, int end) :
+        _srcInstances(srcInstances), _srcDesc(srcDesc),
+        _dstInstances(dstInstances), _dstDesc(dstDesc),
+        _numInstances(numInstances), _instanceBlockSize(instanceBlockSize),
+        _sizes(sizes), _offsets(offsets), _indices(indices),
+        _weights(weights), _start(start), _end(end) { }
+
+    virtual void Run(int begin, int end) const {
+        int numInstanceBlocks = (_numInstances + _instanceBlockSize - 1) /
+                                _instanceBlockSize;
+
+        for (int i = begin; i < end; ++i) {
+            int instanceStart = (i % numInstanceBlocks) * _instanceBlockSize;
+            int instanceEnd =
+                std::min(instanceStart + _instanceBlockSize, _numInstances);
+            int stencilStart = _start +
+                (i / numInstanceBlocks) * INSTANCED_STENCIL_BLOCK_SIZE;
+            int stencilEnd = std::min(
+                stencilStart + (int)INSTANCED_STENCIL_BLOCK_SIZE, _end);
+
+            BufferDescriptor blockDesc = _dstDesc;
+            blockDesc.offset += (stencilStart - _start) * _dstDesc.stride;
+
+            CpuEvalStencilsInstanced(_srcInstances, _srcDesc,
+                                     _dstInstances, blockDesc,
+                                     instanceStart, instanceEnd,
+                                     _sizes, _offsets, _indices, _weights,
+                                     stencilStart, stencilEnd);
+        }
+    }
+
+private:
+    float const * const * _srcInstances;
+    BufferDescriptor _srcDesc;
+    float * const * _dstInstances;
+    BufferDescriptor _dstDesc;
+    int _numInstances,
+        _instanceBlockSize;
+    int const * _sizes;
+    int const * _offsets;
+    int const * _indices;
+    float const * _weights;
+    int _start,
+        _end;
+};
+
+class PatchesInstancedTask : public ThreadPool::Task {
+public:
+    PatchesInstancedTask(float const * const * srcInstances,
+                         BufferDescriptor const &srcDesc,
+                         float * const * dstInstances,
+                         BufferDescriptor const &dstDesc,
+                         float * const * duInstances,
+                         BufferDescriptor const &duDesc,
+                         float * const * dvInstances,
+                         BufferDescriptor const &dvDesc,
+                         int numInstances,
+                         PatchCoord const * patchCoords,
+                         PatchArray const * patchArrays,
+                         int const * patchIndexBuffer,
+                         PatchParam const * patchParamBuffer) :
+        _srcInstances(srcInstances), _srcDesc(srcDesc),
+        _dstInstances(dstInstances), _dstDesc(dstDesc),
+        _duInstances(duInstances), _duDesc(duDesc),
+        _dvInstances(dvInstances), _dvDesc(dvDesc),
+        _numInstances(numInstances),
+        _patchCoords(patchCoords), _patchArrays(patchArrays),
+        _patchIndexBuffer(patchIndexBuffer),
+        _patchParamBuffer(patchParamBuffer) { }
+
+    virtual void Run(int begin, int end) const {
+        CpuEvalPatchesInstanced(_srcInstances, _srcDesc,
+                                _dstInstances, _dstDesc,
+                                _duInstances, _duDesc,
+                                _dvInstances, _dvDesc,
+                                0, _numInstances, begin, end,
+                                _patchCoords, _patchArrays,
+                                _patchIndexBuffer, _patchParamBuffer);
+    }
+
+private:
+    float const * const * _srcInstances;
+    BufferDescriptor _srcDesc;
+    float * const * _dstInstances;
+    BufferDescriptor _dstDesc;
+    float * const * _duInstances;
+    BufferDescriptor _duDesc;
+    float * const * _dvInstances;
+    BufferDescriptor _dvDesc;
+    int _numInstances;
+    PatchCoord const * _patchCoords;
+    PatchArray const * _patchArrays;
+    int const * _patchIndexBuffer;
+    PatchParam const * _patchParamBuffer;
+};
+
+//
+//  Stencil subset evaluation over the ranges of the subset partitioned by
+//  the grain policy
+//
+template <typename REAL>
+class StencilSubsetTask : public ThreadPool::Task {
+public:
+    StencilSubsetTask(REAL const * src, BufferDescriptor const &srcDesc,
+                      REAL * dst, BufferDescriptor const &dstDesc,
+                      int const * sizes,
+                      int const * offsets,
+                      int const * indices,
+                      REAL const * weights,
+                      int const * stencilIndices,
+                      int const * ranges) :
+        _src(src), _srcDesc(srcDesc), _dst(dst), _dstDesc(dstDesc),
+        _sizes(sizes), _offsets(offsets), _indices(indices),
+        _weights(weights), _stencilIndices(stencilIndices),
+        _ranges(ranges) { }
+
+    virtual void Run(int begin, int end) const {
+        for (int r = begin; r < end; ++r) {
+            CpuEvalStencilSubset(_src, _srcDesc, _dst, _dstDesc,
+                                 _sizes, _offsets, _indices, _weights,
+                                 _stencilIndices, _ranges[r], _ranges[r+1]);
+        }
+    }
+
+private:
+    REAL const * _src;
+    BufferDescriptor _srcDesc;
+    REAL * _dst;
+    BufferDescriptor _dstDesc;
+    int const * _sizes;
+    int const * _offsets;
+    int const * _indices;
+    REAL const * _weights;
+    int const * _stencilIndices;
+    int const * _ranges;
+};
+
+template <typename REAL>
+void
+evalStencilSubset(REAL const * src, BufferDescriptor const &srcDesc,
+                  REAL * dst, BufferDescriptor const &dstDesc,
+                  int const * sizes,
+                  int const * offsets,
+                  int const * indices,
+                  REAL const * weights,
+                  int numStencilIndices,
+                  int const * stencilIndices,
+                  GrainPolicy const &grainPolicy) {
+
+    std::vector<int> ranges;
+    CpuPartitionStencilSubset(grainPolicy, sizes, stencilIndices,
+                              0, numStencilIndices, ranges);
+
+    StencilSubsetTask<REAL> task(src, srcDesc, dst, dstDesc,
+                                 sizes, offsets, indices, weights,
+                                 stencilIndices, &ranges[0]);
+
+    getThreadPool()->ParallelFor(0, (int)ranges.size() - 1, 1, task);
+}
+
+
+//
+//  Limit normal evaluations, re-using the serial CPU kernels : the outputs
+//  are the primvars, normals, tangents and bitangents, and the weights are
+//  those of the stencils and of their five derivatives.
+//
+template <typename REAL>
+class StencilNormalsTask : public ThreadPool::Task {
+public:
+    StencilNormalsTask(REAL const * src, BufferDescriptor const &srcDesc,
+                       REAL * const * dst, BufferDescriptor const * dstDesc,
+                       int const * sizes,
+                       int const * offsets,
+                       int const * indices,
+                       REAL const * const * weights,
+                       int const * ranges) :
+        _src(src), _srcDesc(srcDesc), _dst(dst), _dstDesc(dstDesc),
+        _sizes(sizes), _offsets(offsets), _indices(indices),
+        _weights(weights), _ranges(ranges) { }
+
+    virtual void Run(int begin, int end) const {
+        for (int r = begin; r < end; ++r) {
+            // outputs are indexed relative to the first stencil of the range
+            REAL * dst[4];
+            for (int i = 0; i < 4; ++i) {
+                dst[i] = CpuGetElementPointer(_dst[i],
+                    _ranges[r] - _ranges[0], _dstDesc[i].stride);
+            }
+            CpuEvalStencilNormals(_src, _srcDesc,
+                                  dst[0], _dstDesc[0],
+                                  dst[1], _dstDesc[1],
+                                  dst[2], _dstDesc[2],
+                                  dst[3], _dstDesc[3],
+                                  _sizes, _offsets, _indices,
+                                  _weights[0], _weights[1], _weights[2],
+                                  _weights[3], _weights[4], _weights[5],
+                                  _ranges[r], _ranges[r+1]);
+        }
+    }
+
+private:
+    REAL const * _src;
+    BufferDescriptor _srcDesc;
+    REAL * const * _dst;
+    BufferDescriptor const * _dstDesc;
+    int const * _sizes;
+    int const * _offsets;
+    int const * _indices;
+    REAL const * const * _weights;
+    int const * _ranges;
+};
+
+template <typename REAL>
+void
+evalStencilNormals(REAL const * src, BufferDescriptor const &srcDesc,
+                   REAL * dst,       BufferDescriptor const &dstDesc,
+                   REAL * normal,    BufferDescriptor const &normalDesc,
+                   REAL * tangent,   BufferDescriptor const &tangentDesc,
+                   REAL * bitangent, BufferDescriptor const &bitangentDesc,
+                   int const * sizes,
+                   int const * offsets,
+                   int const * indices,
+                   REAL const * weights,
+                   REAL const * duWeights,
+                   REAL const * dvWeights,
+                   REAL const * duuWeights,
+                   REAL const * duvWeights,
+                   REAL const * dvvWeights,
+                   int start, int end,
+                   GrainPolicy const &grainPolicy) {
+
+    std::vector<int> ranges;
+    CpuPartitionStencils(grainPolicy, sizes, offsets, start, end, ranges);
+
+    REAL * outputs[4] = { dst, normal, tangent, bitangent };
+    BufferDescriptor outputDescs[4] = {
+        dstDesc, normalDesc, tangentDesc, bitangentDesc };
+    REAL const * allWeights[6] = {
+        weights, duWeights, dvWeights, duuWeights, duvWeights, dvvWeights };
+
+    StencilNormalsTask<REAL> task(src, srcDesc, outputs, outputDescs,
+                                  sizes, offsets, indices, allWeights,
+                                  &ranges[0]);
+
+    getThreadPool()->ParallelFor(0, (int)ranges.size() - 1, 1, task);
+}
+
+template <typename REAL>
+class PatchNormalsTask : public ThreadPool::Task {
+public:
+    PatchNormalsTask(REAL const * src, BufferDescriptor const &srcDesc,
+                     REAL * const * dst, BufferDescriptor const * dstDesc,
+                     PatchCoord const * patchCoords,
+                     PatchArray const * patchArrays,
+                     int const * patchIndexBuffer,
+                     PatchParam const * patchParamBuffer) :
+        _src(src), _srcDesc(srcDesc), _dst(dst), _dstDesc(dstDesc),
+        _patchCoords(patchCoords), _patchArrays(patchArrays),
+        _patchIndexBuffer(patchIndexBuffer),
+        _patchParamBuffer(patchParamBuffer) { }
+
+    virtual void Run(int begin, int end) const {
+        CpuEvalPatchNormals(_src, _srcDesc,
+                            _dst[0], _dstDesc[0],
+                            _dst[1], _dstDesc[1],
+                            _dst[2], _dstDesc[2],
+                            _dst[3], _dstDesc[3],
+                            begin, end, _patchCoords, _patchArrays,
+                            _patchIndexBuffer, _patchParamBuffer);
+    }
+
+private:
+    REAL const * _src;
+    BufferDescriptor _srcDesc;
+    REAL * const * _dst;
+    BufferDescriptor const * _dstDesc;
+    PatchCoord const * _patchCoords;
+    PatchArray const * _patchArrays;
+    int const * _patchIndexBuffer;
+    PatchParam const * _patchParamBuffer;
+};
+
+template <typename REAL>
+void
+evalPatchNormals(REAL const * src, BufferDescriptor const &srcDesc,
+                 REAL * dst,       BufferDescriptor const &dstDesc,
+                 REAL * normal,    BufferDescriptor const &normalDesc,
+                 REAL * tangent,   BufferDescriptor const &tangentDesc,
+                 REAL * bitangent, BufferDescriptor const &bitangentDesc,
+                 int numPatchCoords,
+                 PatchCoord const * patchCoords,
+                 PatchArray const * patchArrays,
+                 int const * patchIndexBuffer,
+                 PatchParam const * patchParamBuffer) {
+
+    REAL * outputs[4] = { dst, normal, tangent, bitangent };
+    BufferDescriptor outputDescs[4] = {
+        dstDesc, normalDesc, tangentDesc, bitangentDesc };
+
+    PatchNormalsTask<REAL> task(src, srcDesc, outputs, outputDescs,
+                                patchCoords, patchArrays,
+                                patchIndexBuffer, patchParamBuffer);
+
+    getThreadPool()->ParallelFor(0, numPatchCoords,
+                                 _patchGrainSize, task);
+}
+
+
+//
+//  Packed output evaluations, re-using the serial CPU kernels
+//
+class StencilsPackedTask : public ThreadPool::Task {
+public:
+    StencilsPackedTask(float const * src, BufferDescriptor const &srcDesc,
+                       void * dst, PackedBufferDescriptor const &dstDesc,
+                       int const * sizes,
+                       int const * offsets,
+                       int const * indices,
+                       float const * weights,
+                       int const * ranges) :
+        _src(src), _srcDesc(srcDesc),
+        _dst((unsigned char *)dst), _dstDesc(dstDesc),
+        _sizes(sizes), _offsets(offsets), _indices(indices),
+        _weights(weights), _ranges(ranges) { }
+
+    virtual void Run(int begin, int end) const {
+        for (int r = begin; r < end; ++r) {
+            // outputs are indexed relative to the first stencil of the range
+            unsigned char * dst = CpuGetElementPointer(
+                _dst, _ranges[r] - _ranges[0], _dstDesc.stride);
+
+            CpuEvalStencilsPacked(_src, _srcDesc, dst, _dstDesc,
+                                  _sizes, _offsets, _indices, _weights,
+                                  _ranges[r], _ranges[r+1]);
+        }
+    }
+
+private:
+    float const * _src;
+    BufferDescriptor _srcDesc;
+    unsigned char * _dst;
+    PackedBufferDescriptor _dstDesc;
+    int const * _sizes;
+    int const * _offsets;
+    int const * _indices;
+    float const * _weights;
+    int const * _ranges;
+};
+
+void
+evalStencilsPacked(float const * src, BufferDescriptor const &srcDesc,
+                   void * dst, PackedBufferDescriptor const &dstDesc,
+                   int const * sizes,
+                   int const * offsets,
+                   int const * indices,
+                   float const * weights,
+                   int start, int end,
+                   GrainPolicy const &grainPolicy) {
+
+    std::vector<int> ranges;
+    CpuPartitionStencils(grainPolicy, sizes, offsets, start, end, ranges);
+
+    StencilsPackedTask task(src, srcDesc, dst, dstDesc,
+                            sizes, offsets, indices, weights, &ranges[0]);
+
+    getThreadPool()->ParallelFor(0, (int)ranges.size() - 1, 1, task);
+}
+
+class PatchesPackedTask : public ThreadPool::Task {
+public:
+    PatchesPackedTask(float const * src, BufferDescriptor const &srcDesc,
+                      void * dst, PackedBufferDescriptor const &dstDesc,
+                      void * normal, PackedBufferDescriptor const &normalDesc,
+                      PatchCoord const * patchCoords,
+                      PatchArray const * patchArrays,
+                      int const * patchIndexBuffer,
+                      PatchParam const * patchParamBuffer) :
+        _src(src), _srcDesc(srcDesc), _dst(dst), _dstDesc(dstDesc),
+        _normal(normal), _normalDesc(normalDesc),
+        _patchCoords(patchCoords), _patchArrays(patchArrays),
+        _patchIndexBuffer(patchIndexBuffer),
+        _patchParamBuffer(patchParamBuffer) { }
+
+    virtual void Run(int begin, int end) const {
+        CpuEvalPatchesPacked(_src, _srcDesc, _dst, _dstDesc,
+                             _normal, _normalDesc,
+                             begin, end, _patchCoords, _patchArrays,
+                             _patchIndexBuffer, _patchParamBuffer);
+    }
+
+private:
+    float const * _src;
+    BufferDescriptor _srcDesc;
+    void * _dst;
+    PackedBufferDescriptor _dstDesc;
+    void * _normal;
+    PackedBufferDescriptor _normalDesc;
+    PatchCoord const * _patchCoords;
+    PatchArray const * _patchArrays;
+    int const * _patchIndexBuffer;
+    PatchParam const * _patchParamBuffer;
+};
+
+void
+evalPatchesPacked(float const * src, BufferDescriptor const &srcDesc,
+                  void * dst, PackedBufferDescriptor const &dstDesc,
+                  void * normal, PackedBufferDescriptor const &normalDesc,
+                  int numPatchCoords,
+                  PatchCoord const * patchCoords,
+                  PatchArray const * patchArrays,
+                  int const * patchIndexBuffer,
+                  PatchParam const * patchParamBuffer) {
+
+    PatchesPackedTask task(src, srcDesc, dst, dstDesc, normal, normalDesc,
+                           patchCoords, patchArrays,
+                           patchIndexBuffer, patchParamBuffer);
+
+    getThreadPool()->ParallelFor(0, numPatchCoords,
+                                 _patchGrainSize, task);
+}
+
+} // end namespace
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalStencils(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const float * weights,
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+    if (srcDesc.length != dstDesc.length) return false;
+
+    float * outputs[] = { dst };
+    BufferDescriptor const descs[] = { dstDesc };
+    const float * outputWeights[] = { weights };
+
+    evalStencils(src, srcDesc, 1, outputs, descs,
+                 sizes, offsets, indices, outputWeights, start, end,
+                 grainPolicy);
+
+    return true;
+}
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalStencils(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    float *du,        BufferDescriptor const &duDesc,
+    float *dv,        BufferDescriptor const &dvDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const float * weights,
+    const float * duWeights,
+    const float * dvWeights,
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+    if (srcDesc.length != dstDesc.length) return false;
+    if (srcDesc.length != duDesc.length) return false;
+    if (srcDesc.length != dvDesc.length) return false;
+
+    float * outputs[] = { dst, du, dv };
+    BufferDescriptor const descs[] = { dstDesc, duDesc, dvDesc };
+    const float * outputWeights[] = { weights, duWeights, dvWeights };
+
+    evalStencils(src, srcDesc, 3, outputs, descs,
+                 sizes, offsets, indices, outputWeights, start, end,
+                 grainPolicy);
+
+    return true;
+}
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalStencils(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    float *du,        BufferDescriptor const &duDesc,
+    float *dv,        BufferDescriptor const &dvDesc,
+    float *duu,       BufferDescriptor const &duuDesc,
+    float *duv,       BufferDescriptor const &duvDesc,
+    float *dvv,       BufferDescriptor const &dvvDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const float * weights,
+    const float * duWeights,
+    const float * dvWeights,
+    const float * duuWeights,
+    const float * duvWeights,
+    const float * dvvWeights,
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+    if (srcDesc.length != dstDesc.length) return false;
+    if (srcDesc.length != duDesc.length) return false;
+    if (srcDesc.length != dvDesc.length) return false;
+    if (srcDesc.length != duuDesc.length) return false;
+    if (srcDesc.length != duvDesc.length) return false;
+    if (srcDesc.length != dvvDesc.length) return false;
+
+    float * outputs[] = { dst, du, dv, duu, duv, dvv };
+    BufferDescriptor const descs[] = {
+        dstDesc, duDesc, dvDesc, duuDesc, duvDesc, dvvDesc };
+    const float * outputWeights[] = {
+        weights, duWeights, dvWeights, duuWeights, duvWeights, dvvWeights };
+
+    evalStencils(src, srcDesc, 6, outputs, descs,
+                 sizes, offsets, indices, outputWeights, start, end,
+                 grainPolicy);
+
+    return true;
+}
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalPatches(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (src == NULL) return false;
+    if (dst == NULL) return false;
+    if (srcDesc.length != dstDesc.length) return false;
+
+    float * outputs[] = { dst, NULL, NULL, NULL, NULL, NULL };
+    BufferDescriptor const descs[] = {
+        dstDesc,            BufferDescriptor(), BufferDescriptor(),
+        BufferDescriptor(), BufferDescriptor(), BufferDescriptor() };
+
+    evalPatches(src, srcDesc, outputs, descs,
+                numPatchCoords, patchCoords, patchArrays,
+                patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalPatches(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    float *du,        BufferDescriptor const &duDesc,
+    float *dv,        BufferDescriptor const &dvDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (src == NULL) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (du && srcDesc.length != duDesc.length) return false;
+    if (dv && srcDesc.length != dvDesc.length) return false;
+
+    float * outputs[] = { dst, du, dv, NULL, NULL, NULL };
+    BufferDescriptor const descs[] = {
+        dstDesc, duDesc, dvDesc,
+        BufferDescriptor(), BufferDescriptor(), BufferDescriptor() };
+
+    evalPatches(src, srcDesc, outputs, descs,
+                numPatchCoords, patchCoords, patchArrays,
+                patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalPatches(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    float *du,        BufferDescriptor const &duDesc,
+    float *dv,        BufferDescriptor const &dvDesc,
+    float *duu,       BufferDescriptor const &duuDesc,
+    float *duv,       BufferDescriptor const &duvDesc,
+    float *dvv,       BufferDescriptor const &dvvDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (src == NULL) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (du && srcDesc.length != duDesc.length) return false;
+    if (dv && srcDesc.length != dvDesc.length) return false;
+    if (duu && srcDesc.length != duuDesc.length) return false;
+    if (duv && srcDesc.length != duvDesc.length) return false;
+    if (dvv && srcDesc.length != dvvDesc.length) return false;
+
+    float * outputs[] = { dst, du, dv, duu, duv, dvv };
+    BufferDescriptor const descs[] = {
+        dstDesc, duDesc, dvDesc, duuDesc, duvDesc, dvvDesc };
+
+    evalPatches(src, srcDesc, outputs, descs,
+                numPatchCoords, patchCoords, patchArrays,
+                patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
+//
+//  Limit evaluation decoding the patch control vertices from a compact
+//  table -- any of the outputs may be NULL:
+//
+static bool
+evalPatchesCompact(const float *src, BufferDescriptor const &srcDesc,
+                   float *dst,       BufferDescriptor const &dstDesc,
+                   float *du,        BufferDescriptor const &duDesc,
+                   float *dv,        BufferDescriptor const &dvDesc,
+                   float *duu,       BufferDescriptor const &duuDesc,
+                   float *duv,       BufferDescriptor const &duvDesc,
+                   float *dvv,       BufferDescriptor const &dvvDesc,
+                   int numPatchCoords,
+                   PatchCoord const *patchCoords,
+                   PatchArray const *patchArrays,
+                   Far::CompactPatchVertices const *patchVertices,
+                   PatchParam const *patchParamBuffer) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (src == NULL || patchVertices == NULL) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (du  && srcDesc.length != duDesc.length)  return false;
+    if (dv  && srcDesc.length != dvDesc.length)  return false;
+    if (duu && srcDesc.length != duuDesc.length) return false;
+    if (duv && srcDesc.length != duvDesc.length) return false;
+    if (dvv && srcDesc.length != dvvDesc.length) return false;
+
+    float * outputs[] = { dst, du, dv, duu, duv, dvv };
+    BufferDescriptor const descs[] = {
+        dstDesc, duDesc, dvDesc, duuDesc, duvDesc, dvvDesc };
+
+    PatchesCompactTask task(src, srcDesc, outputs, descs,
+                            patchCoords, patchArrays,
+                            patchVertices, patchParamBuffer);
+
+    getThreadPool()->ParallelFor(0, numPatchCoords,
+                                 _patchGrainSize, task);
+    return true;
+}
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalPatches(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    Far::CompactPatchVertices const *patchVertices,
+    const PatchParam *patchParamBuffer) {
+
+    if (dst == NULL) return false;
+
+    return evalPatchesCompact(src, srcDesc, dst, dstDesc,
+                              0, BufferDescriptor(), 0, BufferDescriptor(),
+                              0, BufferDescriptor(), 0, BufferDescriptor(),
+                              0, BufferDescriptor(),
+                              numPatchCoords, patchCoords, patchArrays,
+                              patchVertices, patchParamBuffer);
+}
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalPatches(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    float *du,        BufferDescriptor const &duDesc,
+    float *dv,        BufferDescriptor const &dvDesc,
+    int numPatchCoords,
+    PatchCoord const *patchCoords,
+    PatchArray const *patchArrays,
+    Far::CompactPatchVertices const *patchVertices,
+    PatchParam const *patchParamBuffer) {
+
+    return evalPatchesCompact(src, srcDesc, dst, dstDesc,
+                              du, duDesc, dv, dvDesc,
+                              0, BufferDescriptor(), 0, BufferDescriptor(),
+                              0, BufferDescriptor(),
+                              numPatchCoords, patchCoords, patchArrays,
+                              patchVertices, patchParamBuffer);
+}
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalPatches(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    float *du,        BufferDescriptor const &duDesc,
+    float *dv,        BufferDescriptor const &dvDesc,
+    float *duu,       BufferDescriptor const &duuDesc,
+    float *duv,       BufferDescriptor const &duvDesc,
+    float *dvv,       BufferDescriptor const &dvvDesc,
+    int numPatchCoords,
+    PatchCoord const *patchCoords,
+    PatchArray const *patchArrays,
+    Far::CompactPatchVertices const *patchVertices,
+    PatchParam const *patchParamBuffer) {
+
+    return evalPatchesCompact(src, srcDesc, dst, dstDesc,
+                              du, duDesc, dv, dvDesc,
+                              duu, duuDesc, duv, duvDesc, dvv, dvvDesc,
+                              numPatchCoords, patchCoords, patchArrays,
+                              patchVertices, patchParamBuffer);
+}
+
+
+// ---------------------------------------------------------------------------
+//
+//  Double precision evaluations
+//
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalStencils(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const double * weights,
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+    if (srcDesc.length != dstDesc.length) return false;
+
+    double * outputs[] = { dst };
+    BufferDescriptor const descs[] = { dstDesc };
+    const double * outputWeights[] = { weights };
+
+    evalStencils(src, srcDesc, 1, outputs, descs,
+                 sizes, offsets, indices, outputWeights, start, end,
+                 grainPolicy);
+
+    return true;
+}
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalStencils(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    double *du,        BufferDescriptor const &duDesc,
+    double *dv,        BufferDescriptor const &dvDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const double * weights,
+    const double * duWeights,
+    const double * dvWeights,
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+    if (srcDesc.length != dstDesc.length) return false;
+    if (srcDesc.length != duDesc.length) return false;
+    if (srcDesc.length != dvDesc.length) return false;
+
+    double * outputs[] = { dst, du, dv };
+    BufferDescriptor const descs[] = { dstDesc, duDesc, dvDesc };
+    const double * outputWeights[] = { weights, duWeights, dvWeights };
+
+    evalStencils(src, srcDesc, 3, outputs, descs,
+                 sizes, offsets, indices, outputWeights, start, end,
+                 grainPolicy);
+
+    return true;
+}
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalStencils(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    double *du,        BufferDescriptor const &duDesc,
+    double *dv,        BufferDescriptor const &dvDesc,
+    double *duu,       BufferDescriptor const &duuDesc,
+    double *duv,       BufferDescriptor const &duvDesc,
+    double *dvv,       BufferDescriptor const &dvvDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const double * weights,
+    const double * duWeights,
+    const double * dvWeights,
+    const double * duuWeights,
+    const double * duvWeights,
+    const double * dvvWeights,
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+    if (srcDesc.length != dstDesc.length) return false;
+    if (srcDesc.length != duDesc.length) return false;
+    if (srcDesc.length != dvDesc.length) return false;
+    if (srcDesc.length != duuDesc.length) return false;
+    if (srcDesc.length != duvDesc.length) return false;
+    if (srcDesc.length != dvvDesc.length) return false;
+
+    double * outputs[] = { dst, du, dv, duu, duv, dvv };
+    BufferDescriptor const descs[] = {
+        dstDesc, duDesc, dvDesc, duuDesc, duvDesc, dvvDesc };
+    const double * outputWeights[] = {
+        weights, duWeights, dvWeights, duuWeights, duvWeights, dvvWeights };
+
+    evalStencils(src, srcDesc, 6, outputs, descs,
+                 sizes, offsets, indices, outputWeights, start, end,
+                 grainPolicy);
+
+    return true;
+}
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalPatches(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (src == NULL) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+
+    double * outputs[] = { dst, NULL, NULL, NULL, NULL, NULL };
+    BufferDescriptor const descs[] = {
+        dstDesc,            BufferDescriptor(), BufferDescriptor(),
+        BufferDescriptor(), BufferDescriptor(), BufferDescriptor() };
+
+    evalPatches(src, srcDesc, outputs, descs,
+                numPatchCoords, patchCoords, patchArrays,
+                patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalPatches(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    double *du,        BufferDescriptor const &duDesc,
+    double *dv,        BufferDescriptor const &dvDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (src == NULL) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (du && srcDesc.length != duDesc.length) return false;
+    if (dv && srcDesc.length != dvDesc.length) return false;
+
+    double * outputs[] = { dst, du, dv, NULL, NULL, NULL };
+    BufferDescriptor const descs[] = {
+        dstDesc, duDesc, dvDesc,
+        BufferDescriptor(), BufferDescriptor(), BufferDescriptor() };
+
+    evalPatches(src, srcDesc, outputs, descs,
+                numPatchCoords, patchCoords, patchArrays,
+                patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalPatches(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    double *du,        BufferDescriptor const &duDesc,
+    double *dv,        BufferDescriptor const &dvDesc,
+    double *duu,       BufferDescriptor const &duuDesc,
+    double *duv,       BufferDescriptor const &duvDesc,
+    double *dvv,       BufferDescriptor const &dvvDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (src == NULL) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (du && srcDesc.length != duDesc.length) return false;
+    if (dv && srcDesc.length != dvDesc.length) return false;
+    if (duu && srcDesc.length != duuDesc.length) return false;
+    if (duv && srcDesc.length != duvDesc.length) return false;
+    if (dvv && srcDesc.length != dvvDesc.length) return false;
+
+    double * outputs[] = { dst, du, dv, duu, duv, dvv };
+    BufferDescriptor const descs[] = {
+        dstDesc, duDesc, dvDesc, duuDesc, duvDesc, dvvDesc };
+
+    evalPatches(src, srcDesc, outputs, descs,
+                numPatchCoords, patchCoords, patchArrays,
+                patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+//
+//  Instanced evaluations
+//
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalStencilsInstanced(
+    const float *src, BufferDescriptor const &srcDesc,
+    int srcInstanceStride,
+    float *dst,       BufferDescriptor const &dstDesc,
+    int dstInstanceStride,
+    int numInstances,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const float * weights,
+    int start, int end) {
+
+    if (end <= start || numInstances <= 0) return true;
+    if (src == NULL || dst == NULL) return false;
+
+    std::vector<const float *> srcInstances;
+    std::vector<float *> dstInstances;
+    CpuGetInstancePointers(src, srcInstanceStride, numInstances, srcInstances);
+    CpuGetInstancePointers(dst, dstInstanceStride, numInstances, dstInstances);
+
+    return EvalStencilsInstanced(&srcInstances[0], srcDesc,
+                                 &dstInstances[0], dstDesc,
+                                 numInstances,
+                                 sizes, offsets, indices, weights,
+                                 start, end);
+}
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalStencilsInstanced(
+    const float * const *srcInstances, BufferDescriptor const &srcDesc,
+    float * const *dstInstances,       BufferDescriptor const &dstDesc,
+    int numInstances,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const float * weights,
+    int start, int end) {
+
+    if (end <= start || numInstances <= 0) return true;
+    if (srcInstances == NULL || dstInstances == NULL) return false;
+    if (srcDesc.length != dstDesc.length) return false;
+
+    int const instanceBlockSize = 16;
+    int numInstanceBlocks =
+        (numInstances + instanceBlockSize - 1) / instanceBlockSize;
+    int numStencilBlocks = (end - start + INSTANCED_STENCIL_BLOCK_SIZE - 1) /
+                           INSTANCED_STENCIL_BLOCK_SIZE;
+
+    StencilsInstancedTask task(srcInstances, srcDesc,
+                               dstInstances, dstDesc,
+                               numInstances, instanceBlockSize,
+                               sizes, offsets, indices, weights,
+                               start, end);
+
+    getThreadPool()->ParallelFor(0, numInstanceBlocks * numStencilBlocks,
+                                 1, task);
+
+    return true;
+}
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalPatchesInstanced(
+    const float *src, BufferDescriptor const &srcDesc,
+    int srcInstanceStride,
+    float *dst,       BufferDescriptor const &dstDesc,
+    float *du,        BufferDescriptor const &duDesc,
+    float *dv,        BufferDescriptor const &dvDesc,
+    int dstInstanceStride,
+    int numInstances,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+
+    if (numPatchCoords <= 0 || numInstances <= 0) return true;
+    if (src == NULL) return false;
+
+    std::vector<const float *> srcInstances;
+    std::vector<float *> dstInstances, duInstances, dvInstances;
+    CpuGetInstancePointers(src, srcInstanceStride, numInstances, srcInstances);
+    CpuGetInstancePointers(dst, dstInstanceStride, numInstances, dstInstances);
+    CpuGetInstancePointers(du,  dstInstanceStride, numInstances, duInstances);
+    CpuGetInstancePointers(dv,  dstInstanceStride, numInstances, dvInstances);
+
+    return EvalPatchesInstanced(&srcInstances[0], srcDesc,
+                                dst ? &dstInstances[0] : NULL, dstDesc,
+                                du  ? &duInstances[0]  : NULL, duDesc,
+                                dv  ? &dvInstances[0]  : NULL, dvDesc,
+                                numInstances, numPatchCoords,
+                                patchCoords, patchArrays,
+                                patchIndexBuffer, patchParamBuffer);
+}
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalPatchesInstanced(
+    const float * const *srcInstances, BufferDescriptor const &srcDesc,
+    float * const *dstInstances,       BufferDescriptor const &dstDesc,
+    float * const *duInstances,        BufferDescriptor const &duDesc,
+    float * const *dvInstances,        BufferDescriptor const &dvDesc,
+    int numInstances,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+
+    if (numPatchCoords <= 0 || numInstances <= 0) return true;
+    if (srcInstances == NULL) return false;
+    if (dstInstances && srcDesc.length != dstDesc.length) return false;
+    if (duInstances && srcDesc.length != duDesc.length) return false;
+    if (dvInstances && srcDesc.length != dvDesc.length) return false;
+
+    PatchesInstancedTask task(srcInstances, srcDesc,
+                              dstInstances, dstDesc,
+                              duInstances, duDesc,
+                              dvInstances, dvDesc,
+                              numInstances, patchCoords, patchArrays,
+                              patchIndexBuffer, patchParamBuffer);
+
+    // blocks of patch coordinates, each evaluated for all the instances
+    getThreadPool()->ParallelFor(0, numPatchCoords, 64, task);
+
+    return true;
+}
+
+//
+//  Stencil subset evaluations
+//
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalStencilsSubset(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const float * weights,
+    int numStencilIndices,
+    const int * stencilIndices,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, numStencilIndices);
+
+    if (numStencilIndices <= 0) return true;
+    if (srcDesc.length != dstDesc.length) return false;
+
+    evalStencilSubset(src, srcDesc, dst, dstDesc,
+                      sizes, offsets, indices, weights,
+                      numStencilIndices, stencilIndices,
+                      grainPolicy);
+
+    return true;
+}
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalStencilsSubset(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const double * weights,
+    int numStencilIndices,
+    const int * stencilIndices,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, numStencilIndices);
+
+    if (numStencilIndices <= 0) return true;
+    if (srcDesc.length != dstDesc.length) return false;
+
+    evalStencilSubset(src, srcDesc, dst, dstDesc,
+                      sizes, offsets, indices, weights,
+                      numStencilIndices, stencilIndices,
+                      grainPolicy);
+
+    return true;
+}
+
+//
+//  Limit normal evaluations
+//
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalStencilsNormals(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    float *normal,    BufferDescriptor const &normalDesc,
+    float *tangent,   BufferDescriptor const &tangentDesc,
+    float *bitangent, BufferDescriptor const &bitangentDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const float * weights,
+    const float * duWeights,
+    const float * dvWeights,
+    const float * duuWeights,
+    const float * duvWeights,
+    const float * dvvWeights,
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+    if (srcDesc.length < 3) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (normal && normalDesc.length < 3) return false;
+    if (tangent && tangentDesc.length < 3) return false;
+    if (bitangent && bitangentDesc.length < 3) return false;
+
+    evalStencilNormals(src, srcDesc, dst, dstDesc,
+                       normal, normalDesc, tangent, tangentDesc,
+                       bitangent, bitangentDesc,
+                       sizes, offsets, indices, weights,
+                       duWeights, dvWeights,
+                       duuWeights, duvWeights, dvvWeights,
+                       start, end,
+                       grainPolicy);
+
+    return true;
+}
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalStencilsNormals(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    double *normal,    BufferDescriptor const &normalDesc,
+    double *tangent,   BufferDescriptor const &tangentDesc,
+    double *bitangent, BufferDescriptor const &bitangentDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const double * weights,
+    const double * duWeights,
+    const double * dvWeights,
+    const double * duuWeights,
+    const double * duvWeights,
+    const double * dvvWeights,
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+    if (srcDesc.length < 3) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (normal && normalDesc.length < 3) return false;
+    if (tangent && tangentDesc.length < 3) return false;
+    if (bitangent && bitangentDesc.length < 3) return false;
+
+    evalStencilNormals(src, srcDesc, dst, dstDesc,
+                       normal, normalDesc, tangent, tangentDesc,
+                       bitangent, bitangentDesc,
+                       sizes, offsets, indices, weights,
+                       duWeights, dvWeights,
+                       duuWeights, duvWeights, dvvWeights,
+                       start, end,
+                       grainPolicy);
+
+    return true;
+}
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalPatchesNormals(
+    const float *src, BufferDescriptor const &srcDesc,
+    float *dst,       BufferDescriptor const &dstDesc,
+    float *normal,    BufferDescriptor const &normalDesc,
+    float *tangent,   BufferDescriptor const &tangentDesc,
+    float *bitangent, BufferDescriptor const &bitangentDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (numPatchCoords <= 0) return true;
+    if (src == NULL || srcDesc.length < 3) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (normal && normalDesc.length < 3) return false;
+    if (tangent && tangentDesc.length < 3) return false;
+    if (bitangent && bitangentDesc.length < 3) return false;
+
+    evalPatchNormals(src, srcDesc, dst, dstDesc,
+                     normal, normalDesc, tangent, tangentDesc,
+                     bitangent, bitangentDesc,
+                     numPatchCoords, patchCoords, patchArrays,
+                     patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalPatchesNormals(
+    const double *src, BufferDescriptor const &srcDesc,
+    double *dst,       BufferDescriptor const &dstDesc,
+    double *normal,    BufferDescriptor const &normalDesc,
+    double *tangent,   BufferDescriptor const &tangentDesc,
+    double *bitangent, BufferDescriptor const &bitangentDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (numPatchCoords <= 0) return true;
+    if (src == NULL || srcDesc.length < 3) return false;
+    if (dst && srcDesc.length != dstDesc.length) return false;
+    if (normal && normalDesc.length < 3) return false;
+    if (tangent && tangentDesc.length < 3) return false;
+    if (bitangent && bitangentDesc.length < 3) return false;
+
+    evalPatchNormals(src, srcDesc, dst, dstDesc,
+                     normal, normalDesc, tangent, tangentDesc,
+                     bitangent, bitangentDesc,
+                     numPatchCoords, patchCoords, patchArrays,
+                     patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
+//
+//  Packed output evaluations
+//
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalStencilsPacked(
+    const float *src, BufferDescriptor const &srcDesc,
+    void *dst,        PackedBufferDescriptor const &dstDesc,
+    const int * sizes,
+    const int * offsets,
+    const int * indices,
+    const float * weights,
+    int start, int end,
+    GrainPolicy const &grainPolicy) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_STENCILS, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_STENCILS, end - start);
+
+    if (end <= start) return true;
+    if (dst == NULL || !dstDesc.IsValid()) return false;
+    if (srcDesc.length != dstDesc.length) return false;
+
+    evalStencilsPacked(src, srcDesc, dst, dstDesc,
+                       sizes, offsets, indices, weights,
+                       start, end,
+                       grainPolicy);
+
+    return true;
+}
+
+/* static */
+bool
+ThreadPoolEvaluator::EvalPatchesPacked(
+    const float *src, BufferDescriptor const &srcDesc,
+    void *dst,        PackedBufferDescriptor const &dstDesc,
+    void *normal,     PackedBufferDescriptor const &normalDesc,
+    int numPatchCoords,
+    const PatchCoord *patchCoords,
+    const PatchArray *patchArrays,
+    const int *patchIndexBuffer,
+    const PatchParam *patchParamBuffer) {
+
+    OPENSUBDIV_INSTRUMENT_TIMER(TIMER_EVAL_PATCHES, -1);
+    OPENSUBDIV_INSTRUMENT_COUNT(COUNTER_EVAL_PATCH_COORDS, numPatchCoords);
+
+    if (numPatchCoords <= 0) return true;
+    if (src == NULL) return false;
+    if (dst && (!dstDesc.IsValid() || srcDesc.length != dstDesc.length)) {
+        return false;
+    }
+    if (normal && (!normalDesc.IsValid() || normalDesc.length != 3 ||
+                   srcDesc.length < 3)) {
+        return false;
+    }
+
+    evalPatchesPacked(src, srcDesc, dst, dstDesc,
+                      normal, normalDesc,
+                      numPatchCoords, patchCoords, patchArrays,
+                      patchIndexBuffer, patchParamBuffer);
+
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+
+/* static */
+void
+ThreadPoolEvaluator::Synchronize(void * /*deviceContext*/) {
+    // ParallelFor() returns once all of its tasks are complete
+}
+
+/* static */
+void
+ThreadPoolEvaluator::SetNumThreads(int numThreads) {
+    _defaultThreadPool.Reset(numThreads);
+}
+
+/* static */
+void
+ThreadPoolEvaluator::SetThreadPool(ThreadPool *threadPool) {
+    _threadPool = threadPool;
+}
+
+/* static */
+ThreadPool *
+ThreadPoolEvaluator::GetThreadPool() {
+    return getThreadPool();
+}
+
+}  // end namespace Osd
+
+}  // end namespace OPENSUBDIV_VERSION
+}  // end namespace OpenSubdiv
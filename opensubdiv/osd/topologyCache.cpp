@@ -0,0 +1,480 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#include "../osd/topologyCache.h"
+#include "../osd/threadPool.h"
+#include "../far/patchTable.h"
+#include "../far/stencilTableFactory.h"
+#include "../far/topologyRefiner.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Osd {
+
+namespace {
+
+    //
+    //  128-bit hash of a block of bytes in the manner of MurmurHash3 (x64
+    //  variant) -- fast and well distributed, and not required to be
+    //  portable since keys are not persistent:
+    //
+    inline std::uint64_t
+    rotl64(std::uint64_t x, int r) {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    inline std::uint64_t
+    fmix64(std::uint64_t k) {
+        k ^= k >> 33;
+        k *= 0xff51afd7ed558ccdULL;
+        k ^= k >> 33;
+        k *= 0xc4ceb9fe1a85ec53ULL;
+        k ^= k >> 33;
+        return k;
+    }
+
+    void
+    hashBytes(void const * data, size_t size, std::uint64_t seed,
+              std::uint64_t hash[2]) {
+
+        unsigned char const * bytes = static_cast<unsigned char const *>(data);
+
+        std::uint64_t const c1 = 0x87c37b91114253d5ULL;
+        std::uint64_t const c2 = 0x4cf5ad432745937fULL;
+
+        std::uint64_t h1 = seed;
+        std::uint64_t h2 = seed;
+
+        size_t numBlocks = size / 16;
+        for (size_t i = 0; i < numBlocks; ++i) {
+            std::uint64_t k1, k2;
+            std::memcpy(&k1, bytes + 16 * i, 8);
+            std::memcpy(&k2, bytes + 16 * i + 8, 8);
+
+            k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+            h1 = rotl64(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+
+            k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+            h2 = rotl64(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+        }
+
+        size_t tailSize = size & 15;
+        if (tailSize) {
+            unsigned char tail[16];
+            std::memset(tail, 0, 16);
+            std::memcpy(tail, bytes + 16 * numBlocks, tailSize);
+
+            std::uint64_t k1, k2;
+            std::memcpy(&k1, tail, 8);
+            std::memcpy(&k2, tail + 8, 8);
+            if (tailSize > 8) {
+                k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+            }
+            k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+        }
+
+        h1 ^= (std::uint64_t)size;
+        h2 ^= (std::uint64_t)size;
+        h1 += h2;
+        h2 += h1;
+        h1 = fmix64(h1);
+        h2 = fmix64(h2);
+        h1 += h2;
+        h2 += h1;
+
+        hash[0] = h1;
+        hash[1] = h2;
+    }
+
+    //
+    //  The arrays of the descriptor are hashed in chunks of a fixed size,
+    //  so the key is independent of the number of threads hashing them:
+    //
+    size_t const CHUNK_SIZE = 64 * 1024;
+
+    struct Chunk {
+        void const * data;
+        size_t       size;
+    };
+
+    void
+    addChunks(std::vector<Chunk> & chunks, void const * data, size_t size) {
+
+        if (data == 0) return;
+
+        unsigned char const * bytes = static_cast<unsigned char const *>(data);
+        for (size_t offset = 0; offset < size; offset += CHUNK_SIZE) {
+            Chunk chunk;
+            chunk.data = bytes + offset;
+            chunk.size = std::min(CHUNK_SIZE, size - offset);
+            chunks.push_back(chunk);
+        }
+    }
+
+    class HashChunksTask : public ThreadPool::Task {
+    public:
+        HashChunksTask(Chunk const * chunks, std::uint64_t * hashes) :
+            _chunks(chunks), _hashes(hashes) { }
+
+        virtual void Run(int begin, int end) const {
+            for (int i = begin; i < end; ++i) {
+                hashBytes(_chunks[i].data, _chunks[i].size, i, _hashes + 2 * i);
+            }
+        }
+
+    private:
+        Chunk const   * _chunks;
+        std::uint64_t * _hashes;
+    };
+
+    //  Cached entries are created once -- concurrent acquisitions of the
+    //  same topology wait for the first to create it:
+    struct Slot {
+        std::once_flag            once;
+        TopologyCache::EntryPtr   entry;
+    };
+
+    typedef std::shared_ptr<Slot> SlotPtr;
+
+} // end namespace
+
+struct TopologyCache::Impl {
+    typedef std::map<Key, SlotPtr> MapType;
+
+    mutable std::mutex mutex;
+    MapType            map;
+};
+
+// ---------------------------------------------------------------------------
+
+TopologyCache::Entry::~Entry() {
+    delete _stencilTable;
+    delete _patchTable;
+    delete _refiner;
+}
+
+Far::MemoryUsage
+TopologyCache::Entry::GetMemoryUsage() const {
+
+    Far::MemoryUsage usage("TopologyCache::Entry");
+    usage.Add(sizeof(*this), sizeof(*this));
+    if (_refiner) {
+        usage.AddComponent(_refiner->GetMemoryUsage());
+    }
+    if (_patchTable) {
+        usage.AddComponent(_patchTable->GetMemoryUsage());
+    }
+    if (_stencilTable) {
+        usage.AddComponent(_stencilTable->GetMemoryUsage());
+    }
+    return usage;
+}
+
+// ---------------------------------------------------------------------------
+
+TopologyCache::TopologyCache() : _impl(new Impl) {
+}
+
+TopologyCache::~TopologyCache() {
+    delete _impl;
+}
+
+TopologyCache::Key
+TopologyCache::ComputeKey(Far::TopologyDescriptor const & desc,
+                          Options const & options,
+                          ThreadPool * threadPool) {
+
+    //
+    //  The sizes of all arrays and the options are hashed with the hashes
+    //  of the chunks of the arrays:
+    //
+    std::vector<std::uint64_t> header;
+
+    header.push_back(desc.numVertices);
+    header.push_back(desc.numFaces);
+    header.push_back(desc.numCreases);
+    header.push_back(desc.numCorners);
+    header.push_back(desc.numHoles);
+    header.push_back(desc.isLeftHanded);
+    header.push_back(desc.numFVarChannels);
+
+    //  Edges are only used when all of their arrays are specified:
+    int numEdges = (desc.edgeVertIndices && desc.edgeIndicesPerFace)
+                 ? std::max(desc.numEdges, 0) : 0;
+    header.push_back(numEdges);
+
+    int numFaceVerts = 0;
+    for (int i = 0; (i < desc.numFaces) && desc.numVertsPerFace; ++i) {
+        numFaceVerts += desc.numVertsPerFace[i];
+    }
+    header.push_back(numFaceVerts);
+
+    for (int i = 0; (i < desc.numFVarChannels) && desc.fvarChannels; ++i) {
+        header.push_back(desc.fvarChannels[i].numValues);
+    }
+
+    header.push_back(options.schemeType);
+    header.push_back(options.schemeOptions.GetVtxBoundaryInterpolation());
+    header.push_back(options.schemeOptions.GetFVarLinearInterpolation());
+    header.push_back(options.schemeOptions.GetCreasingMethod());
+    header.push_back(options.schemeOptions.GetTriangleSubdivision());
+
+    header.push_back(options.refineAdaptive);
+    header.push_back(options.refineAdaptive ? 0 : options.uniformLevel);
+    header.push_back(options.createPatchTable);
+    header.push_back(options.createStencilTable);
+
+    Far::PatchTableFactory::Options const & po = options.patchOptions;
+    header.push_back(po.generateAllLevels);
+    header.push_back(po.includeBaseLevelIndices);
+    header.push_back(po.includeFVarBaseLevelIndices);
+    header.push_back(po.triangulateQuads);
+    header.push_back(po.useSingleCreasePatch);
+    header.push_back(po.useInfSharpPatch);
+    header.push_back(po.maxIsolationLevel);
+    header.push_back(po.endCapType);
+    header.push_back(po.shareEndCapPatchPoints);
+    header.push_back(po.generateVaryingTables);
+    header.push_back(po.generateVaryingLocalPoints);
+    header.push_back(po.generateFVarTables);
+    header.push_back(po.patchPrecisionDouble);
+    header.push_back(po.fvarPatchPrecisionDouble);
+    header.push_back(po.generateFVarLegacyLinearPatches);
+    header.push_back(po.generateLegacySharpCornerPatches);
+    header.push_back(po.numFVarChannels);
+    for (int i = 0; (i < po.numFVarChannels) && po.fvarChannelIndices; ++i) {
+        header.push_back(po.fvarChannelIndices[i]);
+    }
+
+    std::vector<Chunk> chunks;
+    addChunks(chunks, desc.numVertsPerFace,
+              desc.numFaces * sizeof(int));
+    addChunks(chunks, desc.vertIndicesPerFace,
+              numFaceVerts * sizeof(Far::Index));
+    addChunks(chunks, desc.creaseVertexIndexPairs,
+              2 * desc.numCreases * sizeof(Far::Index));
+    addChunks(chunks, desc.creaseWeights,
+              desc.numCreases * sizeof(float));
+    addChunks(chunks, desc.cornerVertexIndices,
+              desc.numCorners * sizeof(Far::Index));
+    addChunks(chunks, desc.cornerWeights,
+              desc.numCorners * sizeof(float));
+    addChunks(chunks, desc.holeIndices,
+              desc.numHoles * sizeof(Far::Index));
+    for (int i = 0; (i < desc.numFVarChannels) && desc.fvarChannels; ++i) {
+        addChunks(chunks, desc.fvarChannels[i].valueIndices,
+                  numFaceVerts * sizeof(Far::Index));
+    }
+    if (numEdges) {
+        addChunks(chunks, desc.edgeVertIndices,
+                  2 * numEdges * sizeof(Far::Index));
+        addChunks(chunks, desc.edgeIndicesPerFace,
+                  numFaceVerts * sizeof(Far::Index));
+    }
+
+    int numChunks = (int)chunks.size();
+
+    size_t headerSize = header.size();
+    header.resize(headerSize + 2 * numChunks);
+
+    if (numChunks) {
+        HashChunksTask task(&chunks[0], &header[headerSize]);
+        if (threadPool && (numChunks > 1)) {
+            threadPool->ParallelFor(0, numChunks, 1, task);
+        } else {
+            task.Run(0, numChunks);
+        }
+    }
+
+    Key key;
+    hashBytes(&header[0], header.size() * sizeof(std::uint64_t), 0, key.hash);
+    return key;
+}
+
+TopologyCache::Entry *
+TopologyCache::createEntry(Key const & key,
+                           Far::TopologyDescriptor const & desc,
+                           Options const & options) {
+
+    typedef Far::TopologyRefinerFactory<Far::TopologyDescriptor> Factory;
+
+    Far::TopologyRefiner * refiner = Factory::Create(desc,
+        Factory::Options(options.schemeType, options.schemeOptions));
+    if (refiner == 0) return 0;
+
+    if (options.refineAdaptive) {
+        refiner->RefineAdaptive(
+            options.patchOptions.GetRefineAdaptiveOptions());
+    } else {
+        refiner->RefineUniform(
+            Far::TopologyRefiner::UniformOptions(options.uniformLevel));
+    }
+
+    Entry * entry = new Entry(key);
+    entry->_refiner = refiner;
+
+    if (options.createPatchTable) {
+        entry->_patchTable =
+            Far::PatchTableFactory::Create(*refiner, options.patchOptions);
+    }
+
+    if (options.createStencilTable) {
+        Far::StencilTableFactory::Options stencilOptions;
+        stencilOptions.generateOffsets = true;
+        stencilOptions.generateIntermediateLevels = !refiner->IsUniform();
+
+        Far::StencilTable const * stencilTable =
+            Far::StencilTableFactory::Create(*refiner, stencilOptions);
+
+        //  Local points of the PatchTable are appended to the stencils:
+        if (entry->_patchTable &&
+            entry->_patchTable->GetLocalPointStencilTable()) {
+            if (Far::StencilTable const * stencilTableWithLocalPoints =
+                Far::StencilTableFactory::AppendLocalPointStencilTable(
+                    *refiner, stencilTable,
+                    entry->_patchTable->GetLocalPointStencilTable())) {
+                delete stencilTable;
+                stencilTable = stencilTableWithLocalPoints;
+            }
+        }
+        entry->_stencilTable = stencilTable;
+    }
+    return entry;
+}
+
+TopologyCache::EntryPtr
+TopologyCache::Acquire(Far::TopologyDescriptor const & descriptor,
+                       Options const & options,
+                       ThreadPool * threadPool) {
+
+    Key key = ComputeKey(descriptor, options, threadPool);
+
+    SlotPtr slot;
+    {
+        std::lock_guard<std::mutex> lock(_impl->mutex);
+        SlotPtr & mapSlot = _impl->map[key];
+        if (!mapSlot) {
+            mapSlot = std::make_shared<Slot>();
+        }
+        slot = mapSlot;
+    }
+
+    std::call_once(slot->once, [&]() {
+        EntryPtr entry(createEntry(key, descriptor, options));
+
+        std::lock_guard<std::mutex> lock(_impl->mutex);
+        slot->entry = entry;
+        if (!entry) {
+            //  Invalid topologies are not cached:
+            Impl::MapType::iterator it = _impl->map.find(key);
+            if ((it != _impl->map.end()) && (it->second == slot)) {
+                _impl->map.erase(it);
+            }
+        }
+    });
+    return slot->entry;
+}
+
+TopologyCache::EntryPtr
+TopologyCache::Find(Key const & key) const {
+
+    std::lock_guard<std::mutex> lock(_impl->mutex);
+
+    //  Entries still being created are not found:
+    Impl::MapType::const_iterator it = _impl->map.find(key);
+    return (it != _impl->map.end()) ? it->second->entry : EntryPtr();
+}
+
+int
+TopologyCache::GetNumEntries() const {
+
+    std::lock_guard<std::mutex> lock(_impl->mutex);
+    return (int)_impl->map.size();
+}
+
+int
+TopologyCache::Prune() {
+
+    std::lock_guard<std::mutex> lock(_impl->mutex);
+
+    int numRemoved = 0;
+    Impl::MapType::iterator it = _impl->map.begin();
+    while (it != _impl->map.end()) {
+        EntryPtr const & entry = it->second->entry;
+        if (entry && (entry.use_count() == 1)) {
+            _impl->map.erase(it++);
+            ++numRemoved;
+        } else {
+            ++it;
+        }
+    }
+    return numRemoved;
+}
+
+void
+TopologyCache::Clear() {
+
+    std::lock_guard<std::mutex> lock(_impl->mutex);
+
+    //  Entries still being created are completed by their acquisitions:
+    _impl->map.clear();
+}
+
+//
+//  Memory usage of the map is estimated from the size of its entries and
+//  the typical overhead of a node in a balanced tree:
+//
+Far::MemoryUsage
+TopologyCache::GetMemoryUsage() const {
+
+    std::lock_guard<std::mutex> lock(_impl->mutex);
+
+    Far::MemoryUsage usage("TopologyCache");
+
+    size_t entrySize = sizeof(Impl::MapType::value_type) + 4 * sizeof(void *) +
+                       sizeof(Slot);
+
+    usage.Add(sizeof(*this) + sizeof(Impl), sizeof(*this) + sizeof(Impl));
+    usage.Add(_impl->map.size() * entrySize, _impl->map.size() * entrySize);
+
+    for (Impl::MapType::const_iterator it = _impl->map.begin();
+         it != _impl->map.end(); ++it) {
+        if (it->second->entry) {
+            usage.AddComponent(it->second->entry->GetMemoryUsage());
+        }
+    }
+    return usage;
+}
+
+}  // end namespace Osd
+
+}  // end namespace OPENSUBDIV_VERSION
+}  // end namespace OpenSubdiv
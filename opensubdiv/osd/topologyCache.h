@@ -0,0 +1,221 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#ifndef OPENSUBDIV3_OSD_TOPOLOGY_CACHE_H
+#define OPENSUBDIV3_OSD_TOPOLOGY_CACHE_H
+
+#include "../version.h"
+
+#include "../far/memoryUsage.h"
+#include "../far/patchTableFactory.h"
+#include "../far/stencilTable.h"
+#include "../far/topologyDescriptor.h"
+#include "../sdc/options.h"
+#include "../sdc/types.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Osd {
+
+class ThreadPool;
+
+/// \brief Process-wide sharing of the refiner and tables of meshes with
+///        identical topology
+///
+/// Scenes often contain many separate meshes with identical topology
+/// (e.g. instances deformed independently), whose TopologyRefiner,
+/// PatchTable and StencilTable are identical. TopologyCache identifies
+/// them by a hash of their Far::TopologyDescriptor and of the options of
+/// the refinement and tables, so that they are created once and shared
+/// by all meshes with the same topology.
+///
+/// Entries are immutable and reference counted: they remain valid while
+/// referenced, even after removal from the cache or its destruction.
+///
+/// All methods are thread-safe. When several threads acquire the same
+/// topology concurrently, one creates the entry while the others wait for
+/// it to complete.
+///
+/// Topologies are identified by a 128-bit hash of their content only, so
+/// distinct topologies sharing a key (which is improbable in the extreme)
+/// cannot be distinguished.
+///
+class TopologyCache {
+public:
+    /// \brief Options of the refinement and tables created for a topology
+    struct Options {
+        Options() :
+            schemeType(Sdc::SCHEME_CATMARK),
+            refineAdaptive(true),
+            uniformLevel(2),
+            createPatchTable(true),
+            createStencilTable(true) { }
+
+        Sdc::SchemeType schemeType;     ///< subdivision scheme
+        Sdc::Options    schemeOptions;  ///< options of the scheme
+
+        /// Adaptive refinement (isolated as specified by patchOptions)
+        /// rather than uniform refinement to uniformLevel
+        bool refineAdaptive;
+        int  uniformLevel;
+
+        /// Options of the PatchTable, including the isolation level and
+        /// other options of adaptive refinement
+        Far::PatchTableFactory::Options patchOptions;
+
+        /// Create the PatchTable of the refined topology
+        bool createPatchTable;
+
+        /// Create the StencilTable of the vertices of the refined topology
+        /// (including local points of the PatchTable, if any)
+        bool createStencilTable;
+    };
+
+    /// \brief Key identifying a topology and the options of its tables
+    struct Key {
+        Key() { hash[0] = hash[1] = 0; }
+
+        bool operator==(Key const & k) const {
+            return (hash[0] == k.hash[0]) && (hash[1] == k.hash[1]);
+        }
+        bool operator!=(Key const & k) const { return !(*this == k); }
+        bool operator<(Key const & k) const {
+            return (hash[0] != k.hash[0]) ? (hash[0] < k.hash[0])
+                                          : (hash[1] < k.hash[1]);
+        }
+
+        std::uint64_t hash[2];
+    };
+
+    /// \brief The immutable refiner and tables shared by all meshes with
+    ///        the same topology
+    class Entry {
+    public:
+        ~Entry();
+
+        /// Returns the key of the topology
+        Key const & GetKey() const { return _key; }
+
+        /// Returns the refiner (refined as specified by the options)
+        Far::TopologyRefiner const * GetRefiner() const { return _refiner; }
+
+        /// Returns the PatchTable, if created
+        Far::PatchTable const * GetPatchTable() const { return _patchTable; }
+
+        /// Returns the StencilTable, if created
+        Far::StencilTable const * GetStencilTable() const {
+            return _stencilTable;
+        }
+
+        /// Returns the memory used by the refiner and tables
+        Far::MemoryUsage GetMemoryUsage() const;
+
+    private:
+        friend class TopologyCache;
+
+        Entry(Key const & key) : _key(key),
+            _refiner(0), _patchTable(0), _stencilTable(0) { }
+
+        // Non-copyable
+        Entry(Entry const &);
+        Entry & operator=(Entry const &);
+
+        Key                       _key;
+        Far::TopologyRefiner    * _refiner;
+        Far::PatchTable const   * _patchTable;
+        Far::StencilTable const * _stencilTable;
+    };
+
+    typedef std::shared_ptr<Entry const> EntryPtr;
+
+public:
+    /// Constructor
+    TopologyCache();
+
+    /// Destructor. Entries still referenced remain valid.
+    ~TopologyCache();
+
+    /// \brief Computes the key of a topology and options
+    ///
+    /// The arrays of the descriptor are hashed in fixed size chunks, which
+    /// are distributed over the thread pool if one is given (the key does
+    /// not depend on it).
+    ///
+    static Key ComputeKey(Far::TopologyDescriptor const & descriptor,
+                          Options const & options,
+                          ThreadPool * threadPool = 0);
+
+    /// \brief Returns the entry of a topology, creating it if not cached
+    ///
+    /// Returns an empty pointer if the topology is invalid (i.e. the
+    /// TopologyRefiner could not be created).
+    ///
+    EntryPtr Acquire(Far::TopologyDescriptor const & descriptor,
+                     Options const & options,
+                     ThreadPool * threadPool = 0);
+
+    /// \brief Returns the cached entry of a key, if any
+    EntryPtr Find(Key const & key) const;
+
+    /// Returns the number of cached entries
+    int GetNumEntries() const;
+
+    /// \brief Removes the entries not referenced outside of the cache
+    ///
+    /// Returns the number of entries removed.
+    ///
+    int Prune();
+
+    /// \brief Removes all entries (entries still referenced remain valid)
+    void Clear();
+
+    /// Returns the memory used by the cache and its entries
+    Far::MemoryUsage GetMemoryUsage() const;
+
+private:
+    // Non-copyable
+    TopologyCache(TopologyCache const &);
+    TopologyCache & operator=(TopologyCache const &);
+
+    static Entry * createEntry(Key const & key,
+                               Far::TopologyDescriptor const & descriptor,
+                               Options const & options);
+
+    // The implementation isolates the threading headers from clients
+    struct Impl;
+    Impl * _impl;
+};
+
+}  // end namespace Osd
+
+}  // end namespace OPENSUBDIV_VERSION
+using namespace OPENSUBDIV_VERSION;
+
+}  // end namespace OpenSubdiv
+
+#endif  // OPENSUBDIV3_OSD_TOPOLOGY_CACHE_H
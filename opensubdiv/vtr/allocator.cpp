@@ -0,0 +1,121 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#include "../vtr/allocator.h"
+
+#include <atomic>
+#include <new>
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Vtr {
+
+Allocator::~Allocator() {
+}
+
+namespace internal {
+
+namespace {
+    //
+    //  The default allocator simply uses the global operator new and delete:
+    //
+    class DefaultAllocator : public Allocator {
+    public:
+        virtual void * Allocate(size_t numBytes) {
+            return ::operator new(numBytes);
+        }
+        virtual void Deallocate(void * ptr, size_t) {
+            ::operator delete(ptr);
+        }
+    };
+
+    //  The assigned allocator is null (constant initialized) when the default
+    //  is to be used, so that allocations during static initialization of
+    //  other translation units are safe:
+    std::atomic<Allocator *> assignedAllocator(nullptr);
+
+    //
+    //  Header preceding each block to identify the allocator and size of the
+    //  allocation -- padded to preserve the alignment of operator new:
+    //
+    union BlockHeader {
+        struct {
+            Allocator * allocator;
+            size_t      numBytes;
+        } block;
+        long double     alignment;
+        char            padding[16];
+    };
+}
+
+Allocator *
+GetAllocator() {
+    Allocator * allocator = assignedAllocator.load(std::memory_order_acquire);
+    return allocator ? allocator : GetDefaultAllocator();
+}
+
+Allocator *
+GetDefaultAllocator() {
+    //  Never destroyed, as blocks may be deallocated during static destruction:
+    static DefaultAllocator * defaultAllocator = new DefaultAllocator;
+    return defaultAllocator;
+}
+
+void
+SetAllocator(Allocator * allocator) {
+    assignedAllocator.store(allocator, std::memory_order_release);
+}
+
+void *
+allocateBlock(size_t numBytes) {
+
+    Allocator * allocator = GetAllocator();
+
+    size_t blockBytes = numBytes + sizeof(BlockHeader);
+
+    void * block = allocator->Allocate(blockBytes);
+    if (block == 0) {
+        throw std::bad_alloc();
+    }
+    BlockHeader * header = static_cast<BlockHeader *>(block);
+    header->block.allocator = allocator;
+    header->block.numBytes  = blockBytes;
+    return header + 1;
+}
+
+void
+deallocateBlock(void * ptr) {
+
+    if (ptr == 0) return;
+
+    BlockHeader * header = static_cast<BlockHeader *>(ptr) - 1;
+    header->block.allocator->Deallocate(header, header->block.numBytes);
+}
+
+} // end namespace internal
+} // end namespace Vtr
+
+} // end namespace OPENSUBDIV_VERSION
+} // end namespace OpenSubdiv
@@ -0,0 +1,112 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#ifndef OPENSUBDIV3_VTR_ALLOCATOR_H
+#define OPENSUBDIV3_VTR_ALLOCATOR_H
+
+#include "../version.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace OpenSubdiv {
+namespace OPENSUBDIV_VERSION {
+
+namespace Vtr {
+
+//
+//  Abstract interface for the allocation of the memory of the vectors held
+//  by the Levels and Refinements (and their face-varying counterparts) --
+//  exported publicly by Far (see far/allocator.h) where it is documented.
+//
+class Allocator {
+public:
+    Allocator() { }
+    virtual ~Allocator();
+
+    virtual void * Allocate(size_t numBytes) = 0;
+    virtual void   Deallocate(void * ptr, size_t numBytes) = 0;
+
+private:
+    Allocator(Allocator const &);
+    Allocator & operator=(Allocator const &);
+};
+
+namespace internal {
+
+//
+//  The allocator assigned for use by the library -- the default allocator
+//  (using operator new and delete) when none is assigned:
+//
+Allocator * GetAllocator();
+Allocator * GetDefaultAllocator();
+void        SetAllocator(Allocator * allocator);
+
+//
+//  Allocation of blocks through the assigned allocator.  Each block records
+//  the allocator that allocated it, so that it is returned to it even if a
+//  different allocator has since been assigned:
+//
+void * allocateBlock(size_t numBytes);
+void   deallocateBlock(void * ptr);
+
+//
+//  Stateless STL allocator routing through the assigned allocator, and the
+//  vector type using it for the members of the Vtr classes:
+//
+template <typename T>
+class StdAllocator {
+public:
+    typedef T value_type;
+
+    StdAllocator() { }
+    template <typename U> StdAllocator(StdAllocator<U> const &) { }
+
+    T * allocate(size_t n) {
+        return static_cast<T *>(allocateBlock(n * sizeof(T)));
+    }
+    void deallocate(T * ptr, size_t) {
+        deallocateBlock(ptr);
+    }
+};
+
+template <typename T, typename U>
+inline bool
+operator==(StdAllocator<T> const &, StdAllocator<U> const &) { return true; }
+
+template <typename T, typename U>
+inline bool
+operator!=(StdAllocator<T> const &, StdAllocator<U> const &) { return false; }
+
+template <typename T>
+using Vector = std::vector<T, StdAllocator<T> >;
+
+} // end namespace internal
+} // end namespace Vtr
+
+} // end namespace OPENSUBDIV_VERSION
+using namespace OPENSUBDIV_VERSION;
+} // end namespace OpenSubdiv
+
+#endif /* OPENSUBDIV3_VTR_ALLOCATOR_H */
@@ -778,6 +778,53 @@ FVarLevel::print() const {
     }
 }
 
+//
+//  Memory usage and release of excess capacity:
+//
+void
+FVarLevel::getMemoryUsage(size_t & used, size_t & allocated) const {
+
+    used      += sizeof(FVarLevel);
+    allocated += sizeof(FVarLevel);
+
+    addVectorMemory(_faceVertValues,      used, allocated);
+    addVectorMemory(_edgeTags,            used, allocated);
+    addVectorMemory(_vertSiblingCounts,   used, allocated);
+    addVectorMemory(_vertSiblingOffsets,  used, allocated);
+    addVectorMemory(_vertFaceSiblings,    used, allocated);
+    addVectorMemory(_vertValueIndices,    used, allocated);
+    addVectorMemory(_vertValueTags,       used, allocated);
+    addVectorMemory(_vertValueCreaseEnds, used, allocated);
+}
+
+void
+FVarLevel::shrinkToFit() {
+
+    shrinkVectorToFit(_faceVertValues);
+    shrinkVectorToFit(_edgeTags);
+    shrinkVectorToFit(_vertSiblingCounts);
+    shrinkVectorToFit(_vertSiblingOffsets);
+    shrinkVectorToFit(_vertFaceSiblings);
+    shrinkVectorToFit(_vertValueIndices);
+    shrinkVectorToFit(_vertValueTags);
+    shrinkVectorToFit(_vertValueCreaseEnds);
+}
+
+void
+FVarLevel::releaseTopology(bool retainFaceValues) {
+
+    if (!retainFaceValues) {
+        releaseVector(_faceVertValues);
+    }
+    releaseVector(_edgeTags);
+    releaseVector(_vertSiblingCounts);
+    releaseVector(_vertSiblingOffsets);
+    releaseVector(_vertFaceSiblings);
+    releaseVector(_vertValueIndices);
+    releaseVector(_vertValueTags);
+    releaseVector(_vertValueCreaseEnds);
+}
+
 
 
 void
@@ -247,6 +247,12 @@ public:
     //  Debugging methods:
     bool validate() const;
     void print() const;
+
+    //  Memory in use and allocated, the release of any excess capacity and
+    //  the release of all but the (optional) face-values:
+    void getMemoryUsage(size_t & used, size_t & allocated) const;
+    void shrinkToFit();
+    void releaseTopology(bool retainFaceValues);
     void buildFaceVertexSiblingsFromVertexFaceSiblings(std::vector<Sibling>& fvSiblings) const;
 
 private:
@@ -275,20 +281,20 @@ private:
     //  both if we are willing to compute these on demand for clients.
     //
     //  Per-face (matches face-verts of corresponding level):
-    std::vector<Index> _faceVertValues;
+    Vector<Index> _faceVertValues;
 
     //  Per-edge:
-    std::vector<ETag> _edgeTags;
+    Vector<ETag> _edgeTags;
 
     //  Per-vertex:
-    std::vector<Sibling>  _vertSiblingCounts;
-    std::vector<int>      _vertSiblingOffsets;
-    std::vector<Sibling>  _vertFaceSiblings;
+    Vector<Sibling> _vertSiblingCounts;
+    Vector<int>     _vertSiblingOffsets;
+    Vector<Sibling> _vertFaceSiblings;
 
     //  Per-value:
-    std::vector<Index>         _vertValueIndices;
-    std::vector<ValueTag>      _vertValueTags;
-    std::vector<CreaseEndPair> _vertValueCreaseEnds;
+    Vector<Index>         _vertValueIndices;
+    Vector<ValueTag>      _vertValueTags;
+    Vector<CreaseEndPair> _vertValueCreaseEnds;
 };
 
 //
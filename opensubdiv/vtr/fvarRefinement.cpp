@@ -178,6 +178,24 @@ FVarRefinement::trimAndFinalizeChildValues() {
     }
 }
 
+//
+//  Memory usage and release of excess capacity:
+//
+void
+FVarRefinement::getMemoryUsage(size_t & used, size_t & allocated) const {
+
+    used      += sizeof(FVarRefinement);
+    allocated += sizeof(FVarRefinement);
+
+    addVectorMemory(_childValueParentSource, used, allocated);
+}
+
+void
+FVarRefinement::shrinkToFit() {
+
+    shrinkVectorToFit(_childValueParentSource);
+}
+
 inline int
 FVarRefinement::populateChildValuesForEdgeVertex(Index cVert, Index pEdge) {
 
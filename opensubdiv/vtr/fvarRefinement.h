@@ -81,6 +81,10 @@ public:
     int  populateChildValuesForVertexVertex(Index cVert, Index pVert);
     void trimAndFinalizeChildValues();
 
+    //  Memory in use and allocated and the release of any excess capacity:
+    void getMemoryUsage(size_t & used, size_t & allocated) const;
+    void shrinkToFit();
+
     void propagateEdgeTags();
     void propagateValueTags();
     void propagateValueCreases();
@@ -104,7 +108,7 @@ private:
     //  be a parent value, in which case the source of the parent component will
     //  be stored.  So we refer to the parent "source" rather than "sibling":
     //
-    std::vector<LocalIndex> _childValueParentSource;
+    Vector<LocalIndex> _childValueParentSource;
 };
 
 } // end namespace internal
@@ -547,6 +547,100 @@ Level::print(const Refinement* pRefinement) const {
     fflush(stdout);
 }
 
+//
+//  Memory usage and release of excess capacity:
+//
+void
+Level::getMemoryUsage(size_t & used, size_t & allocated) const {
+
+    used      += sizeof(Level);
+    allocated += sizeof(Level);
+
+    addVectorMemory(_faceVertCountsAndOffsets, used, allocated);
+    addVectorMemory(_faceVertIndices,          used, allocated);
+    addVectorMemory(_faceEdgeIndices,          used, allocated);
+    addVectorMemory(_faceTags,                 used, allocated);
+    addVectorMemory(_edgeVertIndices,          used, allocated);
+    addVectorMemory(_edgeFaceCountsAndOffsets, used, allocated);
+    addVectorMemory(_edgeFaceIndices,          used, allocated);
+    addVectorMemory(_edgeFaceLocalIndices,     used, allocated);
+    addVectorMemory(_edgeSharpness,            used, allocated);
+    addVectorMemory(_edgeTags,                 used, allocated);
+    addVectorMemory(_vertFaceCountsAndOffsets, used, allocated);
+    addVectorMemory(_vertFaceIndices,          used, allocated);
+    addVectorMemory(_vertFaceLocalIndices,     used, allocated);
+    addVectorMemory(_vertEdgeCountsAndOffsets, used, allocated);
+    addVectorMemory(_vertEdgeIndices,          used, allocated);
+    addVectorMemory(_vertEdgeLocalIndices,     used, allocated);
+    addVectorMemory(_vertSharpness,            used, allocated);
+    addVectorMemory(_vertTags,                 used, allocated);
+    addVectorMemory(_fvarChannels,             used, allocated);
+}
+
+void
+Level::shrinkToFit() {
+
+    //  Face-vertex counts and offsets are not affected -- they are shared
+    //  with the Refinement of this Level and are allocated to size:
+    shrinkVectorToFit(_faceVertIndices);
+    shrinkVectorToFit(_faceEdgeIndices);
+    shrinkVectorToFit(_faceTags);
+    shrinkVectorToFit(_edgeVertIndices);
+    shrinkVectorToFit(_edgeFaceCountsAndOffsets);
+    shrinkVectorToFit(_edgeFaceIndices);
+    shrinkVectorToFit(_edgeFaceLocalIndices);
+    shrinkVectorToFit(_edgeSharpness);
+    shrinkVectorToFit(_edgeTags);
+    shrinkVectorToFit(_vertFaceCountsAndOffsets);
+    shrinkVectorToFit(_vertFaceIndices);
+    shrinkVectorToFit(_vertFaceLocalIndices);
+    shrinkVectorToFit(_vertEdgeCountsAndOffsets);
+    shrinkVectorToFit(_vertEdgeIndices);
+    shrinkVectorToFit(_vertEdgeLocalIndices);
+    shrinkVectorToFit(_vertSharpness);
+    shrinkVectorToFit(_vertTags);
+    shrinkVectorToFit(_fvarChannels);
+
+    for (int i = 0; i < (int)_fvarChannels.size(); ++i) {
+        _fvarChannels[i]->shrinkToFit();
+    }
+}
+
+void
+Level::releaseTopology(bool retainFaceVertices, bool retainFVarValues) {
+
+    //  Face-varying values are located using the face-vertex offsets, so
+    //  they can only be retained with the face-vertices:
+    retainFVarValues = retainFVarValues && retainFaceVertices;
+
+    //  Face tags identify holes, so they are retained with the face-vertices
+    //  for drawing:
+    if (!retainFaceVertices) {
+        releaseVector(_faceVertCountsAndOffsets);
+        releaseVector(_faceVertIndices);
+        releaseVector(_faceTags);
+    }
+    releaseVector(_faceEdgeIndices);
+    releaseVector(_edgeVertIndices);
+    releaseVector(_edgeFaceCountsAndOffsets);
+    releaseVector(_edgeFaceIndices);
+    releaseVector(_edgeFaceLocalIndices);
+    releaseVector(_edgeSharpness);
+    releaseVector(_edgeTags);
+    releaseVector(_vertFaceCountsAndOffsets);
+    releaseVector(_vertFaceIndices);
+    releaseVector(_vertFaceLocalIndices);
+    releaseVector(_vertEdgeCountsAndOffsets);
+    releaseVector(_vertEdgeIndices);
+    releaseVector(_vertEdgeLocalIndices);
+    releaseVector(_vertSharpness);
+    releaseVector(_vertTags);
+
+    for (int i = 0; i < (int)_fvarChannels.size(); ++i) {
+        _fvarChannels[i]->releaseTopology(retainFVarValues);
+    }
+}
+
 //
 //  Methods for retrieving and combining tags:
 //
@@ -1636,6 +1730,13 @@ Level::findEdge(Index v0Index, Index v1Index) const {
     return this->findEdge(v0Index, v1Index, this->getVertexEdges(v0Index));
 }
 
+namespace {
+    inline int
+    findInArray(ConstIndexArray array, Index value) {
+        return (int)(std::find(array.begin(), array.end(), value) - array.begin());
+    }
+}
+
 bool
 Level::completeTopologyFromFaceVertices() {
 
@@ -1810,6 +1911,205 @@ Level::completeTopologyFromFaceVertices() {
     return true;
 }
 
+bool
+Level::completeTopologyFromFaceEdges(ValidationCallback callback, void const * clientData) {
+
+    //
+    //  It's assumed (a pre-condition) that face-vertices, face-edges and edge-vertices
+    //  have been fully specified and that the remaining relations -- all incident to
+    //  edges and vertices -- are to be constructed.  Since the edges are known, there
+    //  is no need to search for them:  counts of the incident faces and edges for each
+    //  component are accumulated in a first pass (along with a test that each edge of
+    //  each face connects its pair of vertices) and the incident components scattered
+    //  into place in a second.
+    //
+    int vCount = this->getNumVertices();
+    int fCount = this->getNumFaces();
+    int eCount = this->getNumEdges();
+    assert((vCount > 0) && (fCount > 0) && (eCount > 0));
+    assert(this->getNumFaceEdgesTotal() == this->getNumFaceVerticesTotal());
+    assert(this->getNumEdgeVerticesTotal() == 2 * eCount);
+
+    //  The counts of each relation are temporarily kept with the offsets:
+    std::fill(this->_edgeFaceCountsAndOffsets.begin(), this->_edgeFaceCountsAndOffsets.end(), 0);
+    std::fill(this->_vertFaceCountsAndOffsets.begin(), this->_vertFaceCountsAndOffsets.end(), 0);
+    std::fill(this->_vertEdgeCountsAndOffsets.begin(), this->_vertEdgeCountsAndOffsets.end(), 0);
+
+    for (Index eIndex = 0; eIndex < eCount; ++eIndex) {
+        ConstIndexArray eVerts = this->getEdgeVertices(eIndex);
+
+        if ((eVerts[0] < 0) || (eVerts[0] >= vCount) ||
+            (eVerts[1] < 0) || (eVerts[1] >= vCount)) {
+            REPORT(TOPOLOGY_MISSING_EDGE_VERTS,
+                "edge %d vertices (%d, %d) out of range", eIndex, eVerts[0], eVerts[1]);
+            return false;
+        }
+        this->_vertEdgeCountsAndOffsets[2*eVerts[0]] ++;
+        this->_vertEdgeCountsAndOffsets[2*eVerts[1]] ++;
+    }
+
+    for (Index fIndex = 0; fIndex < fCount; ++fIndex) {
+        ConstIndexArray fVerts = this->getFaceVertices(fIndex);
+        ConstIndexArray fEdges = this->getFaceEdges(fIndex);
+
+        for (int i = 0; i < fVerts.size(); ++i) {
+            Index v0Index = fVerts[i];
+            Index v1Index = fVerts[(i+1) % fVerts.size()];
+            Index eIndex  = fEdges[i];
+
+            if ((v0Index < 0) || (v0Index >= vCount)) {
+                REPORT(TOPOLOGY_MISSING_FACE_VERTS,
+                    "face %d vertex %d index %d out of range", fIndex, i, v0Index);
+                return false;
+            }
+            if ((eIndex < 0) || (eIndex >= eCount)) {
+                REPORT(TOPOLOGY_MISSING_FACE_EDGES,
+                    "face %d edge %d index %d out of range", fIndex, i, eIndex);
+                return false;
+            }
+            ConstIndexArray eVerts = this->getEdgeVertices(eIndex);
+            if (!(((eVerts[0] == v0Index) && (eVerts[1] == v1Index)) ||
+                  ((eVerts[0] == v1Index) && (eVerts[1] == v0Index)))) {
+                REPORT(TOPOLOGY_FAILED_CORRELATION_FACE_EDGE,
+                    "face %d edge %d (%d, %d) does not connect vertices %d and %d",
+                    fIndex, i, eVerts[0], eVerts[1], v0Index, v1Index);
+                return false;
+            }
+            this->_edgeFaceCountsAndOffsets[2*eIndex] ++;
+            this->_vertFaceCountsAndOffsets[2*v0Index] ++;
+        }
+    }
+
+    //
+    //  Assign offsets from the counts (determining the maximum of each) and allocate
+    //  the incident members -- then reset the counts to serve as the fill position of
+    //  each component as its incident members are scattered:
+    //
+    int maxEdgeFaces = 0;
+    int maxVertFaces = 0;
+    int maxVertEdges = 0;
+
+    for (Index eIndex = 0; eIndex < eCount; ++eIndex) {
+        int eFaceCount = this->_edgeFaceCountsAndOffsets[2*eIndex];
+        if (eFaceCount == 0) {
+            REPORT(TOPOLOGY_MISSING_EDGE_FACES, "edge %d has no incident faces", eIndex);
+            return false;
+        }
+        maxEdgeFaces = std::max(maxEdgeFaces, eFaceCount);
+        this->resizeEdgeFaces(eIndex, eFaceCount);
+    }
+    for (Index vIndex = 0; vIndex < vCount; ++vIndex) {
+        maxVertFaces = std::max(maxVertFaces, this->_vertFaceCountsAndOffsets[2*vIndex]);
+        maxVertEdges = std::max(maxVertEdges, this->_vertEdgeCountsAndOffsets[2*vIndex]);
+
+        this->resizeVertexFaces(vIndex, this->_vertFaceCountsAndOffsets[2*vIndex]);
+        this->resizeVertexEdges(vIndex, this->_vertEdgeCountsAndOffsets[2*vIndex]);
+    }
+
+    _maxEdgeFaces = maxEdgeFaces;
+
+    assert(_maxValence > 0);
+    _maxValence = std::max(maxVertFaces, _maxValence);
+    _maxValence = std::max(maxVertEdges, _maxValence);
+
+    if (_maxValence > VALENCE_LIMIT) {
+        return false;
+    }
+
+    this->resizeEdgeFaces(this->getNumEdgeFaces(eCount-1) + this->getOffsetOfEdgeFaces(eCount-1));
+    this->resizeVertexFaces(this->getNumVertexFaces(vCount-1) + this->getOffsetOfVertexFaces(vCount-1));
+    this->resizeVertexEdges(this->getNumVertexEdges(vCount-1) + this->getOffsetOfVertexEdges(vCount-1));
+
+    for (Index eIndex = 0; eIndex < eCount; ++eIndex) {
+        this->trimEdgeFaces(eIndex, 0);
+    }
+    for (Index vIndex = 0; vIndex < vCount; ++vIndex) {
+        this->trimVertexFaces(vIndex, 0);
+        this->trimVertexEdges(vIndex, 0);
+    }
+
+    //
+    //  Scatter the incident faces of edges and vertices in the order of the faces, and
+    //  the incident edges of vertices in the order of the edges -- the same order in
+    //  which they would be gathered when the edges are constructed from face-vertices:
+    //
+    for (Index fIndex = 0; fIndex < fCount; ++fIndex) {
+        ConstIndexArray fVerts = this->getFaceVertices(fIndex);
+        ConstIndexArray fEdges = this->getFaceEdges(fIndex);
+
+        for (int i = 0; i < fVerts.size(); ++i) {
+            int & eFaceCount = this->_edgeFaceCountsAndOffsets[2*fEdges[i]];
+            int & vFaceCount = this->_vertFaceCountsAndOffsets[2*fVerts[i]];
+
+            this->_edgeFaceIndices[this->getOffsetOfEdgeFaces(fEdges[i]) + eFaceCount++] = fIndex;
+            this->_vertFaceIndices[this->getOffsetOfVertexFaces(fVerts[i]) + vFaceCount++] = fIndex;
+        }
+    }
+    for (Index eIndex = 0; eIndex < eCount; ++eIndex) {
+        ConstIndexArray eVerts = this->getEdgeVertices(eIndex);
+
+        for (int i = 0; i < 2; ++i) {
+            int & vEdgeCount = this->_vertEdgeCountsAndOffsets[2*eVerts[i]];
+
+            this->_vertEdgeIndices[this->getOffsetOfVertexEdges(eVerts[i]) + vEdgeCount++] = eIndex;
+        }
+    }
+
+    //
+    //  Identify the non-manifold edges as they would be identified when constructed
+    //  from face-vertices:  degenerate edges, edges with more than two incident faces
+    //  and edges whose two faces are oppositely wound.  Unlike that case, where new
+    //  instances of edges are created as needed, a degenerate edge with more than one
+    //  incident face or an edge occurring more than once in a face cannot be resolved
+    //  and are rejected:
+    //
+    for (Index eIndex = 0; eIndex < eCount; ++eIndex) {
+        ConstIndexArray eVerts = this->getEdgeVertices(eIndex);
+        ConstIndexArray eFaces = this->getEdgeFaces(eIndex);
+
+        bool nonManifold = false;
+        if (eVerts[0] == eVerts[1]) {
+            if (eFaces.size() > 1) {
+                REPORT(TOPOLOGY_DEGENERATE_EDGE,
+                    "degenerate edge %d has %d incident faces", eIndex, eFaces.size());
+                return false;
+            }
+            nonManifold = true;
+        } else {
+            for (int i = 1; i < eFaces.size(); ++i) {
+                if (eFaces[i] == eFaces[i-1]) {
+                    REPORT(TOPOLOGY_NON_MANIFOLD_EDGE,
+                        "edge %d occurs more than once in face %d", eIndex, eFaces[i]);
+                    return false;
+                }
+            }
+            if (eFaces.size() > 2) {
+                nonManifold = true;
+            } else if (eFaces.size() == 2) {
+                ConstIndexArray f0Edges = this->getFaceEdges(eFaces[0]);
+                ConstIndexArray f1Edges = this->getFaceEdges(eFaces[1]);
+
+                int e0InFace = findInArray(f0Edges, eIndex);
+                int e1InFace = findInArray(f1Edges, eIndex);
+
+                nonManifold = ((this->getFaceVertices(eFaces[0])[e0InFace] == eVerts[0]) ==
+                               (this->getFaceVertices(eFaces[1])[e1InFace] == eVerts[0]));
+            }
+        }
+        if (nonManifold) {
+            _edgeTags[eIndex]._nonManifold = true;
+            _vertTags[eVerts[0]]._nonManifold = true;
+            _vertTags[eVerts[1]]._nonManifold = true;
+        }
+    }
+
+    orientIncidentComponents();
+
+    populateLocalIndices();
+
+    return true;
+}
+
 void
 Level::populateLocalIndices() {
 
@@ -1905,13 +2205,6 @@ Level::orientIncidentComponents() {
     }
 }
 
-namespace {
-    inline int
-    findInArray(ConstIndexArray array, Index value) {
-        return (int)(std::find(array.begin(), array.end(), value) - array.begin());
-    }
-}
-
 bool
 Level::orderVertexFacesAndEdges(Index vIndex, Index * vFacesOrdered, Index * vEdgesOrdered) const {
 
@@ -318,6 +318,17 @@ public:
 
     void print(const Refinement* parentRefinement = 0) const;
 
+    //  Memory in use and allocated (excluding that of face-varying channels,
+    //  which report their own) and the release of any excess capacity (for
+    //  all face-varying channels as well):
+    void getMemoryUsage(size_t & used, size_t & allocated) const;
+    void shrinkToFit();
+
+    //  Release of all topological relations, tags and sharpness values (and
+    //  those of all face-varying channels) while retaining component counts,
+    //  optionally retaining the face-vertices and tags (and face-varying values):
+    void releaseTopology(bool retainFaceVertices, bool retainFVarValues);
+
 public:
     //  High-level topology queries -- these may be moved elsewhere:
 
@@ -468,6 +479,12 @@ public:
     bool completeTopologyFromFaceVertices();
     Index findEdge(Index v0, Index v1, ConstIndexArray v0Edges) const;
 
+    //  Completes the topology when edges have also been specified, i.e. face-edges
+    //  and edge-vertices in addition to face-vertices (errors are reported through
+    //  the optional callback as with validateTopology()):
+    bool completeTopologyFromFaceEdges(ValidationCallback callback = 0,
+                                       void const * clientData = 0);
+
     //  Methods supporting the above:
     void orientIncidentComponents();
     bool orderVertexFacesAndEdges(Index vIndex, Index* vFaces, Index* vEdges) const;
@@ -523,31 +540,31 @@ private:
     //
 
     //  Per-face:
-    std::vector<Index> _faceVertCountsAndOffsets;  // 2 per face, redundant after level 0
-    std::vector<Index> _faceVertIndices;           // 3 or 4 per face, variable at level 0
-    std::vector<Index> _faceEdgeIndices;           // matches face-vert indices
-    std::vector<FTag>  _faceTags;                  // 1 per face:  includes "hole" tag
+    Vector<Index> _faceVertCountsAndOffsets;  // 2 per face, redundant after level 0
+    Vector<Index> _faceVertIndices;           // 3 or 4 per face, variable at level 0
+    Vector<Index> _faceEdgeIndices;           // matches face-vert indices
+    Vector<FTag>  _faceTags;                  // 1 per face:  includes "hole" tag
 
     //  Per-edge:
-    std::vector<Index>      _edgeVertIndices;           // 2 per edge
-    std::vector<Index>      _edgeFaceCountsAndOffsets;  // 2 per edge
-    std::vector<Index>      _edgeFaceIndices;           // varies with faces per edge
-    std::vector<LocalIndex> _edgeFaceLocalIndices;      // varies with faces per edge
+    Vector<Index>      _edgeVertIndices;           // 2 per edge
+    Vector<Index>      _edgeFaceCountsAndOffsets;  // 2 per edge
+    Vector<Index>      _edgeFaceIndices;           // varies with faces per edge
+    Vector<LocalIndex> _edgeFaceLocalIndices;      // varies with faces per edge
 
-    std::vector<float>      _edgeSharpness;             // 1 per edge
-    std::vector<ETag>       _edgeTags;                  // 1 per edge:  manifold, boundary, etc.
+    Vector<float>      _edgeSharpness;             // 1 per edge
+    Vector<ETag>       _edgeTags;                  // 1 per edge:  manifold, boundary, etc.
 
     //  Per-vertex:
-    std::vector<Index>      _vertFaceCountsAndOffsets;  // 2 per vertex
-    std::vector<Index>      _vertFaceIndices;           // varies with valence
-    std::vector<LocalIndex> _vertFaceLocalIndices;      // varies with valence, 8-bit for now
+    Vector<Index>      _vertFaceCountsAndOffsets;  // 2 per vertex
+    Vector<Index>      _vertFaceIndices;           // varies with valence
+    Vector<LocalIndex> _vertFaceLocalIndices;      // varies with valence, 8-bit for now
 
-    std::vector<Index>      _vertEdgeCountsAndOffsets;  // 2 per vertex
-    std::vector<Index>      _vertEdgeIndices;           // varies with valence
-    std::vector<LocalIndex> _vertEdgeLocalIndices;      // varies with valence, 8-bit for now
+    Vector<Index>      _vertEdgeCountsAndOffsets;  // 2 per vertex
+    Vector<Index>      _vertEdgeIndices;           // varies with valence
+    Vector<LocalIndex> _vertEdgeLocalIndices;      // varies with valence, 8-bit for now
 
-    std::vector<float>      _vertSharpness;             // 1 per vertex
-    std::vector<VTag>       _vertTags;                  // 1 per vertex:  manifold, Sdc::Rule, etc.
+    Vector<float>      _vertSharpness;             // 1 per vertex
+    Vector<VTag>       _vertTags;                  // 1 per vertex:  manifold, Sdc::Rule, etc.
 
     //  Face-varying channels:
     std::vector<FVarLevel*> _fvarChannels;
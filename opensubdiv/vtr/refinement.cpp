@@ -339,6 +339,71 @@ Refinement::printParentToChildMapping() const {
     }
 }
 
+//
+//  Memory usage and release of excess capacity:
+//
+void
+Refinement::getMemoryUsage(size_t & used, size_t & allocated) const {
+
+    used      += sizeof(Refinement);
+    allocated += sizeof(Refinement);
+
+    //  Face-child face counts and offsets are usually shared with the parent
+    //  Level, but are local to some subclasses:
+    ConstIndexArray faceChildFaceCountsAndOffsets =
+            _faceChildFaceCountsAndOffsets;
+    ConstIndexArray parentFaceVertCountsAndOffsets =
+            _parent->shareFaceVertCountsAndOffsets();
+    if (faceChildFaceCountsAndOffsets.begin() !=
+            parentFaceVertCountsAndOffsets.begin()) {
+        size_t localSize = faceChildFaceCountsAndOffsets.size() * sizeof(Index);
+        used      += localSize;
+        allocated += localSize;
+    }
+
+    addVectorMemory(_faceChildFaceIndices,   used, allocated);
+    addVectorMemory(_faceChildEdgeIndices,   used, allocated);
+    addVectorMemory(_faceChildVertIndex,     used, allocated);
+    addVectorMemory(_edgeChildEdgeIndices,   used, allocated);
+    addVectorMemory(_edgeChildVertIndex,     used, allocated);
+    addVectorMemory(_vertChildVertIndex,     used, allocated);
+    addVectorMemory(_childFaceParentIndex,   used, allocated);
+    addVectorMemory(_childEdgeParentIndex,   used, allocated);
+    addVectorMemory(_childVertexParentIndex, used, allocated);
+    addVectorMemory(_childFaceTag,           used, allocated);
+    addVectorMemory(_childEdgeTag,           used, allocated);
+    addVectorMemory(_childVertexTag,         used, allocated);
+    addVectorMemory(_parentFaceTag,          used, allocated);
+    addVectorMemory(_parentEdgeTag,          used, allocated);
+    addVectorMemory(_parentVertexTag,        used, allocated);
+    addVectorMemory(_fvarChannels,           used, allocated);
+}
+
+void
+Refinement::shrinkToFit() {
+
+    shrinkVectorToFit(_faceChildFaceIndices);
+    shrinkVectorToFit(_faceChildEdgeIndices);
+    shrinkVectorToFit(_faceChildVertIndex);
+    shrinkVectorToFit(_edgeChildEdgeIndices);
+    shrinkVectorToFit(_edgeChildVertIndex);
+    shrinkVectorToFit(_vertChildVertIndex);
+    shrinkVectorToFit(_childFaceParentIndex);
+    shrinkVectorToFit(_childEdgeParentIndex);
+    shrinkVectorToFit(_childVertexParentIndex);
+    shrinkVectorToFit(_childFaceTag);
+    shrinkVectorToFit(_childEdgeTag);
+    shrinkVectorToFit(_childVertexTag);
+    shrinkVectorToFit(_parentFaceTag);
+    shrinkVectorToFit(_parentEdgeTag);
+    shrinkVectorToFit(_parentVertexTag);
+    shrinkVectorToFit(_fvarChannels);
+
+    for (int i = 0; i < (int)_fvarChannels.size(); ++i) {
+        _fvarChannels[i]->shrinkToFit();
+    }
+}
+
 
 //
 //  Methods to construct the child-to-parent mapping:
@@ -228,6 +228,12 @@ public:
     void populateParentChildIndices();
     void printParentToChildMapping() const;
 
+    //  Memory in use and allocated (excluding that of face-varying channels,
+    //  which report their own) and the release of any excess capacity (for
+    //  all face-varying channels as well):
+    void getMemoryUsage(size_t & used, size_t & allocated) const;
+    void shrinkToFit();
+
     virtual void allocateParentChildIndices() = 0;
 
     //  Supporting method for sparse refinement:
@@ -390,16 +396,16 @@ protected:
     IndexVector _childEdgeParentIndex;
     IndexVector _childVertexParentIndex;
 
-    std::vector<ChildTag> _childFaceTag;
-    std::vector<ChildTag> _childEdgeTag;
-    std::vector<ChildTag> _childVertexTag;
+    Vector<ChildTag> _childFaceTag;
+    Vector<ChildTag> _childEdgeTag;
+    Vector<ChildTag> _childVertexTag;
 
     //
     //  Tags for sparse selection of components:
     //
-    std::vector<SparseTag> _parentFaceTag;
-    std::vector<SparseTag> _parentEdgeTag;
-    std::vector<SparseTag> _parentVertexTag;
+    Vector<SparseTag> _parentFaceTag;
+    Vector<SparseTag> _parentEdgeTag;
+    Vector<SparseTag> _parentVertexTag;
 
     //
     //  Refinement data for face-varying channels present in the Levels being refined:
@@ -26,8 +26,10 @@
 
 #include "../version.h"
 
+#include "../vtr/allocator.h"
 #include "../vtr/array.h"
 
+#include <cstddef>
 #include <vector>
 
 namespace OpenSubdiv {
@@ -72,9 +74,10 @@ static const int VALENCE_LIMIT = ((1 << 16) - 1);  // std::numeric_limits<LocalI
 //  Collections of integer types in variable or fixed sized arrays.  Note that the use
 //  of "vector" in the name indicates a class that wraps an std::vector (typically a
 //  member variable) which is fully resizable and owns its own storage, whereas "array"
-//  wraps a vtr::Array which uses a fixed block of pre-allocated memory.
+//  wraps a vtr::Array which uses a fixed block of pre-allocated memory.  Vectors
+//  allocate their storage through the assigned Vtr::Allocator.
 //
-typedef std::vector<Index>  IndexVector;
+typedef internal::Vector<Index>  IndexVector;
 
 typedef Array<Index>             IndexArray;
 typedef ConstArray<Index>        ConstIndexArray;
@@ -82,6 +85,33 @@ typedef ConstArray<Index>        ConstIndexArray;
 typedef Array<LocalIndex>        LocalIndexArray;
 typedef ConstArray<LocalIndex>   ConstLocalIndexArray;
 
+//
+//  Utilities for the memory held by vectors -- accumulating the bytes in use
+//  and allocated, releasing excess capacity and releasing all memory (the
+//  swap is used as it is guaranteed to release it, unlike clear() or
+//  std::vector::shrink_to_fit()):
+//
+template <typename T, typename A>
+inline void
+addVectorMemory(std::vector<T,A> const & v, size_t & used, size_t & allocated) {
+    used      += v.size()     * sizeof(T);
+    allocated += v.capacity() * sizeof(T);
+}
+
+template <typename T, typename A>
+inline void
+shrinkVectorToFit(std::vector<T,A> & v) {
+    if (v.capacity() > v.size()) {
+        std::vector<T,A>(v).swap(v);
+    }
+}
+
+template <typename T, typename A>
+inline void
+releaseVector(std::vector<T,A> & v) {
+    std::vector<T,A>().swap(v);
+}
+
 
 } // end namespace Vtr
 
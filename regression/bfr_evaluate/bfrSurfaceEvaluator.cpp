@@ -24,6 +24,8 @@
 
 #include "bfrSurfaceEvaluator.h"
 
+#include <algorithm>
+
 
 template <typename REAL>
 BfrSurfaceEvaluator<REAL>::BfrSurfaceEvaluator(
@@ -76,9 +78,17 @@ BfrSurfaceEvaluator<REAL>::Evaluate(IndexType                 baseFace,
     assert(pSurface.IsValid());
     assert(uvSurface.IsValid() == results.evalUV);
 
-    //  Evaluate directly or using stencils:
+    //  Evaluate directly, using stencils or as a grid -- the coordinates
+    //  of the uniform tessellation of a quad form a grid, and grids are
+    //  evaluated without 2nd derivatives:
+    bool useGrid = results.useGrid && !results.eval2ndDeriv &&
+                   (pSurface.GetParameterization().GetType() ==
+                    Bfr::Parameterization::QUAD);
+
     if (results.useStencils) {
         evaluateByStencils(pSurface, uvSurface, tessCoords, results);
+    } else if (useGrid) {
+        evaluateByGrid(pSurface, uvSurface, tessCoords, results);
     } else {
         evaluateDirectly(pSurface, uvSurface, tessCoords, results);
     }
@@ -199,6 +209,86 @@ BfrSurfaceEvaluator<REAL>::evaluateByStencils(
     }
 }
 
+template <typename REAL>
+void
+BfrSurfaceEvaluator<REAL>::evaluateByGrid(
+        SurfaceType const & pSurface, SurfaceType const & uvSurface,
+        TessCoordVector const & tessCoords, EvalResults<REAL> & results) const {
+
+    int numCoords = (int) tessCoords.size() / 2;
+
+    //  Gather the distinct u and v coordinates and the index of each
+    //  (u,v) pair in the grid that they span:
+    TessCoordVector uCoords(numCoords);
+    TessCoordVector vCoords(numCoords);
+    for (int i = 0; i < numCoords; ++i) {
+        uCoords[i] = tessCoords[2*i];
+        vCoords[i] = tessCoords[2*i + 1];
+    }
+    std::sort(uCoords.begin(), uCoords.end());
+    uCoords.erase(std::unique(uCoords.begin(), uCoords.end()), uCoords.end());
+    std::sort(vCoords.begin(), vCoords.end());
+    vCoords.erase(std::unique(vCoords.begin(), vCoords.end()), vCoords.end());
+
+    int numU = (int) uCoords.size();
+    int numV = (int) vCoords.size();
+
+    std::vector<int> gridIndices(numCoords);
+    for (int i = 0; i < numCoords; ++i) {
+        int uIndex = (int) (std::lower_bound(uCoords.begin(), uCoords.end(),
+                            tessCoords[2*i]) - uCoords.begin());
+        int vIndex = (int) (std::lower_bound(vCoords.begin(), vCoords.end(),
+                            tessCoords[2*i + 1]) - vCoords.begin());
+        gridIndices[i] = vIndex * numU + uIndex;
+    }
+
+    if (results.evalPosition) {
+        Vec3Vector baseFacePos(pSurface.GetNumPatchPoints());
+
+        REAL const * meshPoints  = &_baseMeshPos[0][0];
+        REAL       * patchPoints = &baseFacePos[0][0];
+
+        pSurface.PreparePatchPoints(meshPoints, 3, patchPoints, 3);
+
+        Vec3Vector gridP(numU * numV);
+        Vec3Vector gridDu;
+        Vec3Vector gridDv;
+        if (!results.eval1stDeriv) {
+            pSurface.EvaluateGrid(numU, &uCoords[0], numV, &vCoords[0],
+                patchPoints, 3, &gridP[0][0]);
+        } else {
+            gridDu.resize(numU * numV);
+            gridDv.resize(numU * numV);
+            pSurface.EvaluateGrid(numU, &uCoords[0], numV, &vCoords[0],
+                patchPoints, 3, &gridP[0][0], &gridDu[0][0], &gridDv[0][0]);
+        }
+
+        for (int i = 0; i < numCoords; ++i) {
+            results.p[i] = gridP[gridIndices[i]];
+            if (results.eval1stDeriv) {
+                results.du[i] = gridDu[gridIndices[i]];
+                results.dv[i] = gridDv[gridIndices[i]];
+            }
+        }
+    }
+    if (results.evalUV) {
+        Vec3Vector baseFaceUVs(uvSurface.GetNumPatchPoints());
+
+        REAL const * meshPoints  = &_baseMeshUVs[0][0];
+        REAL       * patchPoints = &baseFaceUVs[0][0];
+
+        uvSurface.PreparePatchPoints(meshPoints, 3, patchPoints, 3);
+
+        Vec3Vector gridUV(numU * numV);
+        uvSurface.EvaluateGrid(numU, &uCoords[0], numV, &vCoords[0],
+            patchPoints, 3, &gridUV[0][0]);
+
+        for (int i = 0; i < numCoords; ++i) {
+            results.uv[i] = gridUV[gridIndices[i]];
+        }
+    }
+}
+
 
 //
 //  Explicit instantiation for float and double:
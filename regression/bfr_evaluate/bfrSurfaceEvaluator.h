@@ -73,6 +73,11 @@ private:
                             TessCoordVector const & tessCoords,
                             EvalResults<REAL>     & results) const;
 
+    void evaluateByGrid(SurfaceType     const & posSurface,
+                        SurfaceType     const & uvSurface,
+                        TessCoordVector const & tessCoords,
+                        EvalResults<REAL>     & results) const;
+
 private:
     Far::TopologyRefiner const & _baseMesh;
     Vec3Vector           const & _baseMeshPos;
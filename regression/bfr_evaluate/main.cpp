@@ -70,6 +70,7 @@ public:
 
     //  options affecting configuration and execution:
     unsigned int evalByStencils : 1;
+    unsigned int evalByGrid : 1;
     unsigned int doublePrecision : 1;
     unsigned int noCacheFlag : 1;
 
@@ -113,6 +114,7 @@ public:
         printWarnings(true),
         ptexConvert(false),
         evalByStencils(false),
+        evalByGrid(false),
         doublePrecision(false),
         noCacheFlag(false),
         depthSharp(-1),
@@ -213,6 +215,8 @@ public:
             //  Options controlling other internal processing:
             } else if (!strcmp(arg, "-stencils")) {
                 evalByStencils = true;
+            } else if (!strcmp(arg, "-grid")) {
+                evalByGrid = true;
             } else if (!strcmp(arg, "-double")) {
                 doublePrecision = true;
             } else if (!strcmp(arg, "-nocache")) {
@@ -646,6 +650,7 @@ testMesh(Far::TopologyRefiner      const & mesh,
     bfrResults.eval2ndDeriv = evalD2;
     bfrResults.evalUV       = evalUV;
     bfrResults.useStencils  = args.evalByStencils;
+    bfrResults.useGrid      = args.evalByGrid;
 
     EvalResults<REAL> farResults;
     farResults.evalPosition = evalPos;
@@ -104,13 +104,15 @@ struct EvalResults {
                     eval1stDeriv(true),
                     eval2ndDeriv(false),
                     evalUV(false),
-                    useStencils(false) { }
+                    useStencils(false),
+                    useGrid(false) { }
 
     bool evalPosition;
     bool eval1stDeriv;
     bool eval2ndDeriv;
     bool evalUV;
     bool useStencils;
+    bool useGrid;
 
     std::vector< Vec3<REAL> > p;
     std::vector< Vec3<REAL> > du;
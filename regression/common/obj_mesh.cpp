@@ -0,0 +1,722 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#include "obj_mesh.h"
+#include "shape_utils.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+    #include <fstream>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+
+    //
+    //  Read-only view of the contents of a file -- mapped into memory where
+    //  supported, otherwise read into a buffer:
+    //
+    class MappedFile {
+    public:
+        MappedFile() : _data(0), _size(0) { }
+        ~MappedFile() { close(); }
+
+        bool open(char const * filename);
+        void close();
+
+        char const * data() const { return _data; }
+        size_t       size() const { return _size; }
+
+    private:
+        char const *      _data;
+        size_t            _size;
+#ifdef _WIN32
+        std::vector<char> _buffer;
+#endif
+    };
+
+#ifdef _WIN32
+    bool
+    MappedFile::open(char const * filename) {
+
+        std::ifstream ifs(filename, std::ios::in | std::ios::binary);
+        if (!ifs) return false;
+
+        ifs.seekg(0, std::ios::end);
+        _buffer.resize((size_t)ifs.tellg());
+        ifs.seekg(0, std::ios::beg);
+        if (!_buffer.empty()) {
+            ifs.read(&_buffer[0], _buffer.size());
+        }
+        _data = _buffer.empty() ? 0 : &_buffer[0];
+        _size = _buffer.size();
+        return true;
+    }
+
+    void
+    MappedFile::close() {
+        std::vector<char>().swap(_buffer);
+        _data = 0;
+        _size = 0;
+    }
+#else
+    bool
+    MappedFile::open(char const * filename) {
+
+        int fd = ::open(filename, O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+        _size = (size_t)st.st_size;
+        if (_size > 0) {
+            void * addr = mmap(0, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                ::close(fd);
+                _size = 0;
+                return false;
+            }
+            madvise(addr, _size, MADV_SEQUENTIAL);
+            _data = static_cast<char const *>(addr);
+        }
+        ::close(fd);
+        return true;
+    }
+
+    void
+    MappedFile::close() {
+        if (_data) {
+            munmap(const_cast<char *>(_data), _size);
+        }
+        _data = 0;
+        _size = 0;
+    }
+#endif
+
+    //
+    //  Low level parsing -- the data is not null terminated, so all scanning
+    //  is bounded by the end of the chunk:
+    //
+    inline bool
+    isSpace(char c) {
+        return (c == ' ') || (c == '\t') || (c == '\r');
+    }
+
+    inline bool
+    isDigit(char c) {
+        return (c >= '0') && (c <= '9');
+    }
+
+    inline bool
+    isEndOfLine(char const * p, char const * end) {
+        return (p == end) || (*p == '\n') || (*p == '#');
+    }
+
+    inline char const *
+    skipSpace(char const * p, char const * end) {
+        while ((p < end) && isSpace(*p)) ++p;
+        return p;
+    }
+
+    inline char const *
+    skipLine(char const * p, char const * end) {
+        p = static_cast<char const *>(memchr(p, '\n', end - p));
+        return p ? (p + 1) : end;
+    }
+
+    inline bool
+    parseInt(char const *& p, char const * end, int & value) {
+
+        bool negative = false;
+        if ((p < end) && ((*p == '-') || (*p == '+'))) {
+            negative = (*p == '-');
+            ++p;
+        }
+        if ((p == end) || !isDigit(*p)) return false;
+
+        int result = 0;
+        for ( ; (p < end) && isDigit(*p); ++p) {
+            result = result * 10 + (*p - '0');
+        }
+        value = negative ? -result : result;
+        return true;
+    }
+
+    //
+    //  Decimals with at most 15 significant digits and exponents within
+    //  [-22,22] are the quotient (or product) of two exactly representable
+    //  doubles, so the double result is correctly rounded.  Rounding that to
+    //  float gives the same result as strtof() unless the double lies exactly
+    //  halfway between two floats -- those and all other cases are deferred
+    //  to strtof() (as used by Shape::parseObj()):
+    //
+    bool
+    parseFloatSlow(char const *& p, char const * end, float & value) {
+
+        char buffer[64];
+        size_t n = std::min((size_t)(end - p), sizeof(buffer) - 1);
+        memcpy(buffer, p, n);
+        buffer[n] = 0;
+
+        char * last = 0;
+        value = strtof(buffer, &last);
+        if (last == buffer) return false;
+        p += (last - buffer);
+        return true;
+    }
+
+    inline bool
+    isFloatMidpoint(double d) {
+        //  The 29 low bits of the double mantissa are lost in the conversion:
+        unsigned long long bits;
+        memcpy(&bits, &d, sizeof(d));
+        return (bits & 0x1fffffffULL) == 0x10000000ULL;
+    }
+
+    inline bool
+    parseFloat(char const *& p, char const * end, float & value) {
+
+        static double const powersOf10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5,
+            1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16,
+            1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+        char const * start = p;
+
+        bool negative = false;
+        if ((p < end) && ((*p == '-') || (*p == '+'))) {
+            negative = (*p == '-');
+            ++p;
+        }
+
+        long long mantissa = 0;
+        int numDigits = 0,
+            exponent = 0;
+        for ( ; (p < end) && isDigit(*p); ++p, ++numDigits) {
+            mantissa = mantissa * 10 + (*p - '0');
+        }
+        if ((p < end) && (*p == '.')) {
+            for (++p; (p < end) && isDigit(*p); ++p, ++numDigits, --exponent) {
+                mantissa = mantissa * 10 + (*p - '0');
+            }
+        }
+        if ((p < end) && ((*p == 'e') || (*p == 'E'))) {
+            int e = 0;
+            if (!parseInt(++p, end, e)) {
+                numDigits = 0;
+            }
+            exponent += e;
+        }
+        if ((numDigits == 0) || (numDigits > 15) ||
+                (exponent < -22) || (exponent > 22)) {
+            p = start;
+            return parseFloatSlow(p, end, value);
+        }
+
+        double result = (double)mantissa;
+        result = (exponent < 0) ? (result / powersOf10[-exponent])
+                                : (result * powersOf10[exponent]);
+        if (isFloatMidpoint(result)) {
+            p = start;
+            return parseFloatSlow(p, end, value);
+        }
+        value = (float)(negative ? -result : result);
+        return true;
+    }
+
+    //
+    //  Element counts for a chunk -- used both for the sizes of the chunks
+    //  and (after the prefix sums) for the offsets of each chunk:
+    //
+    struct Counts {
+        Counts() { memset(this, 0, sizeof(Counts)); }
+
+        Counts & operator+=(Counts const & c) {
+            numPositions   += c.numPositions;
+            numUVs         += c.numUVs;
+            numNormals     += c.numNormals;
+            numFaces       += c.numFaces;
+            numFaceVerts   += c.numFaceVerts;
+            numFaceUVs     += c.numFaceUVs;
+            numFaceNormals += c.numFaceNormals;
+            return *this;
+        }
+
+        int numPositions,
+            numUVs,
+            numNormals,
+            numFaces,
+            numFaceVerts,
+            numFaceUVs,
+            numFaceNormals;
+    };
+
+    //
+    //  Each chunk is a range of whole lines -- tags are rare and so are
+    //  simply gathered per chunk and applied in order after parsing:
+    //
+    struct Chunk {
+        Chunk() : begin(0), end(0), error(0) { }
+        ~Chunk() {
+            for (int i = 0; i < (int)tags.size(); ++i) delete tags[i];
+        }
+
+        char const * begin;
+        char const * end;
+
+        Counts sizes;
+        Counts offsets;
+
+        std::vector<Shape::tag *> tags;
+
+        char const * error;
+    };
+
+    enum LineType {
+        LINE_OTHER,
+        LINE_POSITION,
+        LINE_UV,
+        LINE_NORMAL,
+        LINE_FACE,
+        LINE_TAG
+    };
+
+    inline LineType
+    getLineType(char const *& p, char const * end) {
+
+        if ((end - p) < 2) return LINE_OTHER;
+
+        if (p[0] == 'v') {
+            if (isSpace(p[1])) {
+                p += 2;
+                return LINE_POSITION;
+            }
+            if (((end - p) > 2) && isSpace(p[2])) {
+                if (p[1] == 't') { p += 3; return LINE_UV; }
+                if (p[1] == 'n') { p += 3; return LINE_NORMAL; }
+            }
+        } else if (isSpace(p[1])) {
+            if (p[0] == 'f') { p += 2; return LINE_FACE; }
+            if (p[0] == 't') { return LINE_TAG; }
+        }
+        return LINE_OTHER;
+    }
+
+    //  First pass -- counts elements of the chunk:
+    void
+    countChunk(Chunk & chunk) {
+
+        Counts & c = chunk.sizes;
+
+        char const * end = chunk.end;
+        for (char const * p = chunk.begin; p < end; p = skipLine(p, end)) {
+
+            p = skipSpace(p, end);
+
+            switch (getLineType(p, end)) {
+                case LINE_POSITION: ++c.numPositions; break;
+                case LINE_UV:       ++c.numUVs;       break;
+                case LINE_NORMAL:   ++c.numNormals;   break;
+                case LINE_FACE: {
+                    ++c.numFaces;
+                    //  Count the vertices of the face and the fields
+                    //  present in each (v, v/t, v//n or v/t/n):
+                    for (p = skipSpace(p, end); !isEndOfLine(p, end);
+                            p = skipSpace(p, end)) {
+                        ++c.numFaceVerts;
+                        int field = 0;
+                        for ( ; !isEndOfLine(p, end) && !isSpace(*p); ++p) {
+                            if (*p == '/') {
+                                ++field;
+                            } else if (field == 1 && (p[-1] == '/')) {
+                                ++c.numFaceUVs;
+                            } else if (field == 2 && (p[-1] == '/')) {
+                                ++c.numFaceNormals;
+                            }
+                        }
+                    }
+                } break;
+                default: break;
+            }
+            if (p == end) break;
+        }
+    }
+
+    //  Resolves a 1-based or negative (relative) Obj index:
+    inline int
+    resolveIndex(int index, int numDefined) {
+        return (index > 0) ? (index - 1) : (numDefined + index);
+    }
+
+    //  Second pass -- parses the chunk into its ranges of the arrays:
+    void
+    parseChunk(Chunk & chunk, ObjMesh & mesh) {
+
+        Counts const & offsets = chunk.offsets;
+
+        float * positions   = mesh.positions.empty()   ? 0 :
+                              &mesh.positions[offsets.numPositions * 3];
+        float * uvs         = mesh.uvs.empty()         ? 0 :
+                              &mesh.uvs[offsets.numUVs * 2];
+        float * normals     = mesh.normals.empty()     ? 0 :
+                              &mesh.normals[offsets.numNormals * 3];
+        int   * faceSizes   = mesh.faceSizes.empty()   ? 0 :
+                              &mesh.faceSizes[offsets.numFaces];
+        int   * faceVerts   = mesh.faceVerts.empty()   ? 0 :
+                              &mesh.faceVerts[offsets.numFaceVerts];
+        int   * faceUVs     = mesh.faceUVs.empty()     ? 0 :
+                              &mesh.faceUVs[offsets.numFaceUVs];
+        int   * faceNormals = mesh.faceNormals.empty() ? 0 :
+                              &mesh.faceNormals[offsets.numFaceNormals];
+
+        //  Elements defined so far, for relative indices:
+        int numPositions = offsets.numPositions,
+            numUVs       = offsets.numUVs,
+            numNormals   = offsets.numNormals;
+
+        char const * end = chunk.end;
+        for (char const * p = chunk.begin; p < end; p = skipLine(p, end)) {
+
+            char const * line = p = skipSpace(p, end);
+
+            switch (getLineType(p, end)) {
+                case LINE_POSITION: {
+                    for (int i = 0; i < 3; ++i) {
+                        p = skipSpace(p, end);
+                        if (!parseFloat(p, end, *positions++)) {
+                            chunk.error = line;
+                            return;
+                        }
+                    }
+                    ++numPositions;
+                } break;
+                case LINE_UV: {
+                    //  Only the first two coordinates are retained:
+                    for (int i = 0; i < 2; ++i) {
+                        p = skipSpace(p, end);
+                        if (!parseFloat(p, end, *uvs++)) {
+                            chunk.error = line;
+                            return;
+                        }
+                    }
+                    ++numUVs;
+                } break;
+                case LINE_NORMAL: {
+                    for (int i = 0; i < 3; ++i) {
+                        p = skipSpace(p, end);
+                        if (!parseFloat(p, end, *normals++)) {
+                            chunk.error = line;
+                            return;
+                        }
+                    }
+                    ++numNormals;
+                } break;
+                case LINE_FACE: {
+                    int size = 0;
+                    for (p = skipSpace(p, end); !isEndOfLine(p, end);
+                            p = skipSpace(p, end)) {
+                        int index = 0;
+                        if (!parseInt(p, end, index)) {
+                            chunk.error = line;
+                            return;
+                        }
+                        *faceVerts++ = resolveIndex(index, numPositions);
+                        if ((p < end) && (*p == '/')) {
+                            if (parseInt(++p, end, index) && faceUVs) {
+                                *faceUVs++ = resolveIndex(index, numUVs);
+                            }
+                            if ((p < end) && (*p == '/')) {
+                                if (parseInt(++p, end, index) && faceNormals) {
+                                    *faceNormals++ =
+                                        resolveIndex(index, numNormals);
+                                }
+                            }
+                        }
+                        ++size;
+                    }
+                    *faceSizes++ = size;
+                } break;
+                case LINE_TAG: {
+                    char const * eol = skipLine(p, end);
+                    std::string tagLine(p, eol);
+                    Shape::tag * t = Shape::tag::parseTag(tagLine.c_str());
+                    if (t) {
+                        chunk.tags.push_back(t);
+                    }
+                } break;
+                default: break;
+            }
+            if (p == end) break;
+        }
+    }
+
+    //  Applies the tags of the mesh -- consistent with far_utils.h:
+    void
+    applyTag(Shape::tag const & t, ObjMesh & mesh) {
+
+        typedef OpenSubdiv::Sdc::Options Options;
+
+        Options & options = mesh.sdcOptions;
+
+        int nfloat = (int)t.floatargs.size();
+
+        if (t.name == "crease") {
+            for (int j = 0; j < ((int)t.intargs.size() - 1); j += 2) {
+                mesh.creaseVerts.push_back(t.intargs[j]);
+                mesh.creaseVerts.push_back(t.intargs[j+1]);
+                float w = (nfloat > 1) ? t.floatargs[std::min(j, nfloat-1)] :
+                                         (nfloat ? t.floatargs[0] : 0.0f);
+                mesh.creaseWeights.push_back(std::max(0.0f, w));
+            }
+        } else if (t.name == "corner") {
+            for (int j = 0; j < (int)t.intargs.size(); ++j) {
+                mesh.cornerVerts.push_back(t.intargs[j]);
+                float w = (nfloat > 1) ? t.floatargs[std::min(j, nfloat-1)] :
+                                         (nfloat ? t.floatargs[0] : 0.0f);
+                mesh.cornerWeights.push_back(std::max(0.0f, w));
+            }
+        } else if (t.name == "hole") {
+            mesh.holes.insert(mesh.holes.end(),
+                              t.intargs.begin(), t.intargs.end());
+        } else if (t.name == "interpolateboundary") {
+            if (t.intargs.size() != 1) return;
+            switch (t.intargs[0]) {
+                case 0 : options.SetVtxBoundaryInterpolation(
+                             Options::VTX_BOUNDARY_NONE); break;
+                case 1 : options.SetVtxBoundaryInterpolation(
+                             Options::VTX_BOUNDARY_EDGE_AND_CORNER); break;
+                case 2 : options.SetVtxBoundaryInterpolation(
+                             Options::VTX_BOUNDARY_EDGE_ONLY); break;
+                default: break;
+            }
+        } else if (t.name == "facevaryinginterpolateboundary") {
+            if (t.intargs.size() != 1) return;
+            switch (t.intargs[0]) {
+                case 0 : options.SetFVarLinearInterpolation(
+                             Options::FVAR_LINEAR_NONE); break;
+                case 1 : options.SetFVarLinearInterpolation(
+                             Options::FVAR_LINEAR_CORNERS_ONLY); break;
+                case 2 : options.SetFVarLinearInterpolation(
+                             Options::FVAR_LINEAR_CORNERS_PLUS1); break;
+                case 3 : options.SetFVarLinearInterpolation(
+                             Options::FVAR_LINEAR_CORNERS_PLUS2); break;
+                case 4 : options.SetFVarLinearInterpolation(
+                             Options::FVAR_LINEAR_BOUNDARIES); break;
+                case 5 : options.SetFVarLinearInterpolation(
+                             Options::FVAR_LINEAR_ALL); break;
+                default: break;
+            }
+        } else if (t.name == "creasemethod") {
+            if (t.stringargs.empty()) return;
+            if (t.stringargs[0] == "normal") {
+                options.SetCreasingMethod(Options::CREASE_UNIFORM);
+            } else if (t.stringargs[0] == "chaikin") {
+                options.SetCreasingMethod(Options::CREASE_CHAIKIN);
+            }
+        } else if (t.name == "smoothtriangles") {
+            if (t.stringargs.empty()) return;
+            if (t.stringargs[0] == "catmark") {
+                options.SetTriangleSubdivision(Options::TRI_SUB_CATMARK);
+            } else if (t.stringargs[0] == "smooth") {
+                options.SetTriangleSubdivision(Options::TRI_SUB_SMOOTH);
+            }
+        }
+    }
+
+    template <typename T>
+    inline void
+    clearVector(std::vector<T> & v) {
+        std::vector<T>().swap(v);
+    }
+
+    template <typename T>
+    inline T const *
+    dataOrNull(std::vector<T> const & v) {
+        return v.empty() ? 0 : &v[0];
+    }
+} // end namespace
+
+//------------------------------------------------------------------------------
+
+ObjMesh *
+ObjMesh::Read(char const * filename, int numThreads) {
+
+    MappedFile file;
+    if (!file.open(filename)) {
+        printf("Error opening file \"%s\"\n", filename);
+        return 0;
+    }
+    return Parse(file.data(), file.size(), numThreads);
+}
+
+ObjMesh *
+ObjMesh::Parse(char const * data, size_t size, int numThreads) {
+
+    //  Chunks of at least 1 MB, no more than one per thread:
+    size_t const minChunkSize = 1 << 20;
+
+    if (numThreads <= 0) {
+        numThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    int numChunks = (int)std::min((size_t)numThreads,
+                                  (size / minChunkSize) + 1);
+
+    std::vector<Chunk> chunks(numChunks);
+
+    char const * end = data + size;
+    char const * begin = data;
+    for (int i = 0; i < numChunks; ++i) {
+        char const * split = (i == (numChunks - 1)) ? end :
+                             data + (size / numChunks) * (i + 1);
+        split = std::max(begin, split);
+        if (split < end) {
+            split = skipLine(split, end);
+        }
+        chunks[i].begin = begin;
+        chunks[i].end   = split;
+        begin = split;
+    }
+
+    //  Run the given pass over all chunks -- one thread per chunk:
+    struct Pass {
+        static void run(std::vector<Chunk> & chunks,
+                        void (*func)(Chunk &, ObjMesh *), ObjMesh * mesh) {
+            std::vector<std::thread> threads;
+            for (int i = 1; i < (int)chunks.size(); ++i) {
+                threads.push_back(std::thread(func, std::ref(chunks[i]), mesh));
+            }
+            func(chunks[0], mesh);
+            for (int i = 0; i < (int)threads.size(); ++i) {
+                threads[i].join();
+            }
+        }
+        static void count(Chunk & chunk, ObjMesh *) { countChunk(chunk); }
+        static void parse(Chunk & chunk, ObjMesh * mesh) { parseChunk(chunk, *mesh); }
+    };
+
+    Pass::run(chunks, &Pass::count, 0);
+
+    //  Prefix sums of the chunk sizes determine the offsets of each chunk:
+    Counts total;
+    for (int i = 0; i < numChunks; ++i) {
+        chunks[i].offsets = total;
+        total += chunks[i].sizes;
+    }
+
+    ObjMesh * mesh = new ObjMesh;
+
+    mesh->sdcOptions.SetVtxBoundaryInterpolation(
+        OpenSubdiv::Sdc::Options::VTX_BOUNDARY_EDGE_ONLY);
+    mesh->sdcOptions.SetCreasingMethod(
+        OpenSubdiv::Sdc::Options::CREASE_UNIFORM);
+    mesh->sdcOptions.SetTriangleSubdivision(
+        OpenSubdiv::Sdc::Options::TRI_SUB_CATMARK);
+
+    mesh->positions.resize(total.numPositions * 3);
+    mesh->uvs.resize(total.numUVs * 2);
+    mesh->normals.resize(total.numNormals * 3);
+    mesh->faceSizes.resize(total.numFaces);
+    mesh->faceVerts.resize(total.numFaceVerts);
+    //  Face-varying indices are only retained if present for all faces:
+    if (total.numFaceUVs == total.numFaceVerts) {
+        mesh->faceUVs.resize(total.numFaceUVs);
+    }
+    if (total.numFaceNormals == total.numFaceVerts) {
+        mesh->faceNormals.resize(total.numFaceNormals);
+    }
+
+    Pass::run(chunks, &Pass::parse, mesh);
+
+    for (int i = 0; i < numChunks; ++i) {
+        if (chunks[i].error) {
+            char const * eol = skipLine(chunks[i].error, end);
+            printf("Error parsing Obj line \"%.*s\"\n",
+                   (int)(eol - chunks[i].error), chunks[i].error);
+            delete mesh;
+            return 0;
+        }
+        for (int j = 0; j < (int)chunks[i].tags.size(); ++j) {
+            applyTag(*chunks[i].tags[j], *mesh);
+        }
+    }
+
+    if (total.numFaceUVs && (total.numFaceUVs != total.numFaceVerts)) {
+        printf("Warning: uvs not assigned to all faces -- ignored\n");
+        clearVector(mesh->uvs);
+    }
+    if (total.numFaceNormals && (total.numFaceNormals != total.numFaceVerts)) {
+        clearVector(mesh->normals);
+    }
+    return mesh;
+}
+
+//------------------------------------------------------------------------------
+
+void
+ObjMesh::GetTopologyDescriptor(TopologyDescriptor & descriptor,
+                               bool isLeftHanded) const {
+
+    descriptor.numVertices        = GetNumVertices();
+    descriptor.numFaces           = GetNumFaces();
+    descriptor.numVertsPerFace    = dataOrNull(faceSizes);
+    descriptor.vertIndicesPerFace = dataOrNull(faceVerts);
+
+    descriptor.numCreases             = (int)creaseWeights.size();
+    descriptor.creaseVertexIndexPairs = dataOrNull(creaseVerts);
+    descriptor.creaseWeights          = dataOrNull(creaseWeights);
+
+    descriptor.numCorners          = (int)cornerWeights.size();
+    descriptor.cornerVertexIndices = dataOrNull(cornerVerts);
+    descriptor.cornerWeights       = dataOrNull(cornerWeights);
+
+    descriptor.numHoles    = (int)holes.size();
+    descriptor.holeIndices = dataOrNull(holes);
+
+    descriptor.isLeftHanded = isLeftHanded;
+
+    if (HasUVs()) {
+        _uvChannel.numValues    = (int)uvs.size() / 2;
+        _uvChannel.valueIndices = dataOrNull(faceUVs);
+
+        descriptor.numFVarChannels = 1;
+        descriptor.fvarChannels    = &_uvChannel;
+    } else {
+        descriptor.numFVarChannels = 0;
+        descriptor.fvarChannels    = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
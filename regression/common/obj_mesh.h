@@ -0,0 +1,98 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#ifndef OBJ_MESH_H
+#define OBJ_MESH_H
+
+#include <opensubdiv/far/topologyDescriptor.h>
+#include <opensubdiv/sdc/options.h>
+
+#include <cstddef>
+#include <vector>
+
+//------------------------------------------------------------------------------
+//
+//  Parallel Obj reader for large meshes.
+//
+//  Unlike Shape::parseObj(), which parses a copy of the file held in a
+//  string one line at a time, ObjMesh maps the file into memory and parses
+//  chunks of lines concurrently in two passes: the first counts the
+//  elements of each chunk, from which the offsets of each chunk into the
+//  final arrays are determined (prefix sums), and the second parses the
+//  chunks directly into those arrays.  Relative (negative) indices are
+//  resolved using the same offsets.
+//
+//  Supported are vertices ("v"), uvs ("vt"), normals ("vn"), faces ("f")
+//  and the tags ("t") supported by Shape -- creases, corners and holes are
+//  gathered for the TopologyDescriptor, and options (boundary interpolation,
+//  creasing method, etc.) are gathered as Sdc::Options.  Materials, groups
+//  and line continuations are not supported.
+//
+class ObjMesh {
+public:
+    typedef OpenSubdiv::Far::TopologyDescriptor TopologyDescriptor;
+
+    //  Reads the given file -- returns NULL on failure.  Uses all hardware
+    //  threads if numThreads is not specified.
+    static ObjMesh * Read(char const * filename, int numThreads = 0);
+
+    //  Parses Obj data of the given size (not necessarily null terminated)
+    static ObjMesh * Parse(char const * data, size_t size, int numThreads = 0);
+
+    int GetNumVertices() const { return (int)positions.size() / 3; }
+
+    int GetNumFaces() const { return (int)faceSizes.size(); }
+
+    bool HasUVs() const { return !faceUVs.empty(); }
+
+    //  Initializes a descriptor referring to the data of this mesh (which
+    //  must remain valid while the descriptor is in use) -- uvs, if present,
+    //  are included as the single face-varying channel
+    void GetTopologyDescriptor(TopologyDescriptor & descriptor,
+                               bool isLeftHanded = false) const;
+
+    std::vector<float> positions;
+    std::vector<float> uvs;
+    std::vector<float> normals;
+
+    std::vector<int>   faceSizes;
+    std::vector<int>   faceVerts;
+    std::vector<int>   faceUVs;         // empty unless all faces have uvs
+    std::vector<int>   faceNormals;     // empty unless all faces have normals
+
+    std::vector<int>   creaseVerts;     // pairs of vertices
+    std::vector<float> creaseWeights;
+
+    std::vector<int>   cornerVerts;
+    std::vector<float> cornerWeights;
+
+    std::vector<int>   holes;
+
+    OpenSubdiv::Sdc::Options sdcOptions;
+
+private:
+    mutable TopologyDescriptor::FVarChannel _uvChannel;
+};
+
+#endif /* OBJ_MESH_H */
@@ -0,0 +1,438 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#include "synthetic_mesh.h"
+
+#include <algorithm>
+#include <cmath>
+
+//------------------------------------------------------------------------------
+
+namespace {
+
+    enum Feature {
+        FEATURE_EXTRAORDINARY,
+        FEATURE_NGON,
+        FEATURE_NON_MANIFOLD,
+        FEATURE_CREASE,
+        FEATURE_CORNER,
+        FEATURE_HOLE,
+        FEATURE_SEAM
+    };
+
+    inline unsigned long long
+    mix(unsigned long long z) {
+        //  splitmix64 finalizer
+        z += 0x9e3779b97f4a7c15ULL;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    //  Deterministic random value in [0,1) for a feature at a location:
+    inline float
+    random(unsigned seed, Feature feature, int i, int j) {
+        unsigned long long h = mix((unsigned long long)seed ^
+                                   ((unsigned long long)feature << 48));
+        h = mix(h ^ (unsigned long long)(unsigned int)i);
+        h = mix(h ^ ((unsigned long long)(unsigned int)j << 32));
+        return (float)(h >> 40) / (float)(1 << 24);
+    }
+
+    inline float
+    probability(float density, float scale) {
+        return std::min(std::max(density, 0.0f) * scale, 1.0f);
+    }
+
+    int const TILE_SIZE = 4;
+
+    //
+    //  Builds the faces of the mesh tile by tile -- grid vertices are
+    //  addressed by their (x,y) location, with x in [0,W] and y in [0,H],
+    //  and wrapped when the mesh is closed:
+    //
+    class Builder {
+    public:
+        Builder(SyntheticMeshOptions const & options, SyntheticMesh & mesh);
+
+        void Build();
+
+    private:
+        int vertex(int x, int y) const {
+            return _closed ? ((x % _width) + (y % _height) * _width)
+                           : (x + y * (_width + 1));
+        }
+
+        int uv(int tx, int x, int y) const {
+            //  Faces of a tile use the values right of a seam on its left:
+            if ((x == tx * TILE_SIZE) && (_seamUVs[tx] >= 0)) {
+                return _seamUVs[tx] + y;
+            }
+            return x + y * (_width + 1);
+        }
+
+        void position(int x, int y, float P[3], float N[3]) const;
+
+        void addVertices();
+        void addSeams();
+        void addTile(int tx, int ty);
+        void addFace(int tx, int size, int const xy[][2]);
+        void addFin(int tx, int x, int y);
+        void addCreases();
+        void addCorners();
+        void addHoles();
+
+        SyntheticMeshOptions const & _options;
+        SyntheticMesh & _mesh;
+
+        int  _width;
+        int  _height;
+        bool _closed;
+
+        std::vector<int> _seamUVs;
+    };
+
+    Builder::Builder(SyntheticMeshOptions const & options,
+                     SyntheticMesh & mesh) :
+        _options(options), _mesh(mesh), _closed(options.closed) {
+
+        //  Round the grid up to whole tiles, as square as possible:
+        int numFaces = std::max(options.numFaces, 1);
+
+        int width = (int)std::ceil(std::sqrt((double)numFaces));
+        _width = std::max(
+            (width + TILE_SIZE - 1) / TILE_SIZE * TILE_SIZE, TILE_SIZE);
+
+        int height = (numFaces + _width - 1) / _width;
+        _height = std::max(
+            (height + TILE_SIZE - 1) / TILE_SIZE * TILE_SIZE, TILE_SIZE);
+    }
+
+    void
+    Builder::position(int x, int y, float P[3], float N[3]) const {
+
+        if (_closed) {
+            float const twoPi = 6.28318530717958647692f;
+            float const R = 1.0f, r = 0.4f;
+
+            float theta = twoPi * (float)x / (float)_width;
+            float phi   = twoPi * (float)y / (float)_height;
+
+            N[0] = std::cos(phi) * std::cos(theta);
+            N[1] = std::cos(phi) * std::sin(theta);
+            N[2] = std::sin(phi);
+
+            P[0] = (R + r * std::cos(phi)) * std::cos(theta);
+            P[1] = (R + r * std::cos(phi)) * std::sin(theta);
+            P[2] = r * N[2];
+        } else {
+            float spacing = 1.0f / (float)std::max(_width, _height);
+
+            P[0] = ((float)x - 0.5f * (float)_width) * spacing;
+            P[1] = ((float)y - 0.5f * (float)_height) * spacing;
+            P[2] = 0.0f;
+
+            N[0] = 0.0f;
+            N[1] = 0.0f;
+            N[2] = 1.0f;
+        }
+    }
+
+    void
+    Builder::addVertices() {
+
+        int numX = _closed ? _width  : (_width + 1);
+        int numY = _closed ? _height : (_height + 1);
+
+        _mesh.positions.reserve(numX * numY * 3);
+        for (int y = 0; y < numY; ++y) {
+            for (int x = 0; x < numX; ++x) {
+                float P[3], N[3];
+                position(x, y, P, N);
+                _mesh.positions.insert(_mesh.positions.end(), P, P + 3);
+            }
+        }
+
+        //  The uvs are never wrapped, i.e. a closed mesh has seams where
+        //  the grid wraps around:
+        _mesh.uvs.reserve((_width + 1) * (_height + 1) * 2);
+        for (int y = 0; y <= _height; ++y) {
+            for (int x = 0; x <= _width; ++x) {
+                _mesh.uvs.push_back((float)x / (float)_width);
+                _mesh.uvs.push_back((float)y / (float)_height);
+            }
+        }
+    }
+
+    void
+    Builder::addSeams() {
+
+        //  Seams split the uvs of a column at the left of a tile:
+        int numTilesX = _width / TILE_SIZE;
+        float p = probability(_options.fvarSeamDensity, (float)TILE_SIZE);
+
+        _seamUVs.resize(numTilesX, -1);
+        for (int tx = 1; tx < numTilesX; ++tx) {
+            if (random(_options.seed, FEATURE_SEAM, tx, 0) < p) {
+                _seamUVs[tx] = (int)_mesh.uvs.size() / 2;
+
+                int x = tx * TILE_SIZE;
+                for (int y = 0; y <= _height; ++y) {
+                    int value = x + y * (_width + 1);
+                    _mesh.uvs.push_back(_mesh.uvs[2 * value]);
+                    _mesh.uvs.push_back(_mesh.uvs[2 * value + 1]);
+                }
+            }
+        }
+    }
+
+    void
+    Builder::addFace(int tx, int size, int const xy[][2]) {
+
+        _mesh.faceSizes.push_back(size);
+        for (int i = 0; i < size; ++i) {
+            _mesh.faceVerts.push_back(vertex(xy[i][0], xy[i][1]));
+            _mesh.faceUVs.push_back(uv(tx, xy[i][0], xy[i][1]));
+        }
+    }
+
+    void
+    Builder::addFin(int tx, int x, int y) {
+
+        //  A quad extruded from the edge (x,y)-(x+1,y), which is then shared
+        //  by three faces:
+        float P0[3], P1[3], N0[3], N1[3];
+        position(x,     y, P0, N0);
+        position(x + 1, y, P1, N1);
+
+        float d[3] = { P1[0] - P0[0], P1[1] - P0[1], P1[2] - P0[2] };
+        float length = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+
+        int finVertex = (int)_mesh.positions.size() / 3;
+        for (int k = 0; k < 3; ++k) {
+            _mesh.positions.push_back(P0[k] + N0[k] * length);
+        }
+        for (int k = 0; k < 3; ++k) {
+            _mesh.positions.push_back(P1[k] + N1[k] * length);
+        }
+
+        int finUV = (int)_mesh.uvs.size() / 2;
+        int uv0 = uv(tx, x, y);
+        int uv1 = uv(tx, x + 1, y);
+        _mesh.uvs.push_back(_mesh.uvs[2 * uv0]);
+        _mesh.uvs.push_back(_mesh.uvs[2 * uv0 + 1]);
+        _mesh.uvs.push_back(_mesh.uvs[2 * uv1]);
+        _mesh.uvs.push_back(_mesh.uvs[2 * uv1 + 1]);
+
+        _mesh.faceSizes.push_back(4);
+
+        _mesh.faceVerts.push_back(vertex(x + 1, y));
+        _mesh.faceVerts.push_back(vertex(x, y));
+        _mesh.faceVerts.push_back(finVertex);
+        _mesh.faceVerts.push_back(finVertex + 1);
+
+        _mesh.faceUVs.push_back(uv1);
+        _mesh.faceUVs.push_back(uv0);
+        _mesh.faceUVs.push_back(finUV);
+        _mesh.faceUVs.push_back(finUV + 1);
+    }
+
+    void
+    Builder::addTile(int tx, int ty) {
+
+        int x0 = tx * TILE_SIZE;
+        int y0 = ty * TILE_SIZE;
+
+        unsigned seed = _options.seed;
+
+        bool rotate = random(seed, FEATURE_EXTRAORDINARY, tx, ty) <
+                      probability(_options.extraordinaryDensity, 4.0f);
+        bool merge  = random(seed, FEATURE_NGON, tx, ty) <
+                      probability(_options.ngonDensity, 8.0f);
+        bool fin    = random(seed, FEATURE_NON_MANIFOLD, tx, ty) <
+                      probability(_options.nonManifoldDensity, 16.0f);
+
+        for (int cy = 0; cy < TILE_SIZE; ++cy) {
+            for (int cx = 0; cx < TILE_SIZE; ++cx) {
+                int x = x0 + cx;
+                int y = y0 + cy;
+
+                if (rotate && (cy == 1) && (cx == 1)) {
+                    //  Rotate the edge shared by faces (1,1) and (2,1) of
+                    //  the tile -- from (2,1)-(2,2) to (3,1)-(1,2):
+                    int const quad0[4][2] = {
+                        { x,     y + 1 }, { x,     y     },
+                        { x + 1, y     }, { x + 2, y     } };
+                    int const quad1[4][2] = {
+                        { x + 2, y     }, { x + 2, y + 1 },
+                        { x + 1, y + 1 }, { x,     y + 1 } };
+                    addFace(tx, 4, quad0);
+                    addFace(tx, 4, quad1);
+                    continue;
+                }
+                if (rotate && (cy == 1) && (cx == 2)) continue;
+
+                if (merge && (cy == 3) && (cx == 0)) {
+                    //  Merge faces (0,3) and (1,3) of the tile:
+                    int const hexagon[6][2] = {
+                        { x,     y     }, { x + 1, y     }, { x + 2, y     },
+                        { x + 2, y + 1 }, { x + 1, y + 1 }, { x,     y + 1 } };
+                    addFace(tx, 6, hexagon);
+                    continue;
+                }
+                if (merge && (cy == 3) && (cx == 1)) continue;
+
+                int const quad[4][2] = {
+                    { x,     y     }, { x + 1, y     },
+                    { x + 1, y + 1 }, { x,     y + 1 } };
+                addFace(tx, 4, quad);
+            }
+        }
+
+        if (fin) {
+            addFin(tx, x0, y0 + 2);
+        }
+    }
+
+    void
+    Builder::addCreases() {
+
+        //  Runs of creases along the rows of the grid, whose edges are
+        //  never removed by the features of the tiles:
+        int runLength = std::max(_options.creaseLength, 1);
+        int numRows = _closed ? _height : (_height + 1);
+
+        for (int y = 0; y < numRows; ++y) {
+            for (int x = 0; x < _width; ++x) {
+                if (random(_options.seed, FEATURE_CREASE, x / runLength, y) <
+                    _options.creaseDensity) {
+                    _mesh.creaseVerts.push_back(vertex(x,     y));
+                    _mesh.creaseVerts.push_back(vertex(x + 1, y));
+                    _mesh.creaseWeights.push_back(_options.creaseSharpness);
+                }
+            }
+        }
+    }
+
+    void
+    Builder::addCorners() {
+
+        int numX = _closed ? _width  : (_width + 1);
+        int numY = _closed ? _height : (_height + 1);
+
+        for (int y = 0; y < numY; ++y) {
+            for (int x = 0; x < numX; ++x) {
+                if (random(_options.seed, FEATURE_CORNER, x, y) <
+                    _options.cornerDensity) {
+                    _mesh.cornerVerts.push_back(vertex(x, y));
+                    _mesh.cornerWeights.push_back(_options.cornerSharpness);
+                }
+            }
+        }
+    }
+
+    void
+    Builder::addHoles() {
+
+        int numFaces = _mesh.GetNumFaces();
+        for (int face = 0; face < numFaces; ++face) {
+            if (random(_options.seed, FEATURE_HOLE, face, 0) <
+                _options.holeDensity) {
+                _mesh.holes.push_back(face);
+            }
+        }
+    }
+
+    void
+    Builder::Build() {
+
+        addVertices();
+        addSeams();
+
+        _mesh.faceSizes.reserve(_width * _height);
+        _mesh.faceVerts.reserve(_width * _height * 4);
+        _mesh.faceUVs.reserve(_width * _height * 4);
+
+        for (int ty = 0; ty < _height / TILE_SIZE; ++ty) {
+            for (int tx = 0; tx < _width / TILE_SIZE; ++tx) {
+                addTile(tx, ty);
+            }
+        }
+
+        if (_options.creaseDensity > 0.0f) addCreases();
+        if (_options.cornerDensity > 0.0f) addCorners();
+        if (_options.holeDensity   > 0.0f) addHoles();
+    }
+}
+
+//------------------------------------------------------------------------------
+
+SyntheticMesh *
+SyntheticMesh::Create(SyntheticMeshOptions const & options) {
+
+    SyntheticMesh * mesh = new SyntheticMesh;
+
+    Builder builder(options, *mesh);
+    builder.Build();
+
+    return mesh;
+}
+
+namespace {
+    template <typename T>
+    inline T const *
+    dataOrNull(std::vector<T> const & v) {
+        return v.empty() ? 0 : &v[0];
+    }
+}
+
+void
+SyntheticMesh::GetTopologyDescriptor(TopologyDescriptor & descriptor) const {
+
+    descriptor.numVertices        = GetNumVertices();
+    descriptor.numFaces           = GetNumFaces();
+    descriptor.numVertsPerFace    = dataOrNull(faceSizes);
+    descriptor.vertIndicesPerFace = dataOrNull(faceVerts);
+
+    descriptor.numCreases             = (int)creaseWeights.size();
+    descriptor.creaseVertexIndexPairs = dataOrNull(creaseVerts);
+    descriptor.creaseWeights          = dataOrNull(creaseWeights);
+
+    descriptor.numCorners          = (int)cornerWeights.size();
+    descriptor.cornerVertexIndices = dataOrNull(cornerVerts);
+    descriptor.cornerWeights       = dataOrNull(cornerWeights);
+
+    descriptor.numHoles    = (int)holes.size();
+    descriptor.holeIndices = dataOrNull(holes);
+
+    descriptor.isLeftHanded = false;
+
+    _uvChannel.numValues    = (int)uvs.size() / 2;
+    _uvChannel.valueIndices = dataOrNull(faceUVs);
+
+    descriptor.numFVarChannels = 1;
+    descriptor.fvarChannels    = &_uvChannel;
+}
+
+//------------------------------------------------------------------------------
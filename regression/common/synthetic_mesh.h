@@ -0,0 +1,133 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#ifndef SYNTHETIC_MESH_H
+#define SYNTHETIC_MESH_H
+
+#include <opensubdiv/far/topologyDescriptor.h>
+
+#include <vector>
+
+//------------------------------------------------------------------------------
+//
+//  Procedural generation of meshes of arbitrary size (thousands to tens of
+//  millions of faces) for scaling tests and benchmarks.
+//
+//  The mesh is built from a grid of quads -- wrapped into a torus or left
+//  open -- that is divided into tiles of 4x4 faces.  Features are added to
+//  each tile independently and deterministically (from the seed and the
+//  position of the tile), so a given set of options always produces the
+//  same mesh and the densities of all features can be controlled:
+//
+//    - extraordinary vertices : the edge shared by two quads is rotated,
+//                               creating two valence 3 and two valence 5
+//                               vertices while all faces remain quads
+//    - n-gons                 : two quads are merged into a hexagon
+//    - non-manifold features  : a "fin" face is attached to an interior
+//                               edge, which is then shared by three faces
+//    - creases                : runs of creased edges along the grid lines
+//    - corners                : individual sharp vertices
+//    - holes                  : faces tagged as holes
+//    - face-varying seams     : a uv channel with seams along the columns
+//                               at the boundaries of tiles (and where the
+//                               torus wraps around)
+//
+//  All densities are fractions in [0,1] of the relevant components, i.e.
+//  vertices, faces or edges. Since features are limited to one of each
+//  kind per tile, the densities of extraordinary vertices, merged faces
+//  and fins are at most 1/4, 1/8 and 1/16 respectively.
+//
+struct SyntheticMeshOptions {
+
+    SyntheticMeshOptions() :
+        numFaces(1024),
+        closed(true),
+        extraordinaryDensity(0.0f),
+        ngonDensity(0.0f),
+        nonManifoldDensity(0.0f),
+        creaseDensity(0.0f),
+        creaseLength(8),
+        creaseSharpness(2.0f),
+        cornerDensity(0.0f),
+        cornerSharpness(10.0f),
+        holeDensity(0.0f),
+        fvarSeamDensity(0.0f),
+        seed(0) { }
+
+    int      numFaces;              ///< approximate number of grid faces
+    bool     closed;                ///< torus if closed, else a planar grid
+
+    float    extraordinaryDensity;  ///< fraction of vertices
+    float    ngonDensity;           ///< fraction of faces
+    float    nonManifoldDensity;    ///< fraction of faces adding a fin
+
+    float    creaseDensity;         ///< fraction of edges
+    int      creaseLength;          ///< edges per run of creases
+    float    creaseSharpness;
+
+    float    cornerDensity;         ///< fraction of vertices
+    float    cornerSharpness;
+
+    float    holeDensity;           ///< fraction of faces
+
+    float    fvarSeamDensity;       ///< fraction of grid columns
+
+    unsigned seed;
+};
+
+class SyntheticMesh {
+public:
+    typedef OpenSubdiv::Far::TopologyDescriptor TopologyDescriptor;
+
+    static SyntheticMesh * Create(SyntheticMeshOptions const & options);
+
+    int GetNumVertices() const { return (int)positions.size() / 3; }
+
+    int GetNumFaces() const { return (int)faceSizes.size(); }
+
+    //  Initializes a descriptor referring to the data of this mesh (which
+    //  must remain valid while the descriptor is in use) -- the uv channel
+    //  is included as the single face-varying channel
+    void GetTopologyDescriptor(TopologyDescriptor & descriptor) const;
+
+    std::vector<int>   faceSizes;
+    std::vector<int>   faceVerts;
+    std::vector<float> positions;
+
+    std::vector<int>   creaseVerts;     // pairs of vertices
+    std::vector<float> creaseWeights;
+
+    std::vector<int>   cornerVerts;
+    std::vector<float> cornerWeights;
+
+    std::vector<int>   holes;
+
+    std::vector<int>   faceUVs;         // one per entry of faceVerts
+    std::vector<float> uvs;
+
+private:
+    mutable TopologyDescriptor::FVarChannel _uvChannel;
+};
+
+#endif /* SYNTHETIC_MESH_H */
@@ -22,8 +22,18 @@
 //   language governing permissions and limitations under the Apache License.
 //
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <opensubdiv/far/allocator.h>
+#include <opensubdiv/far/patchTableFactory.h>
+#include <opensubdiv/far/primvarArrayRefiner.h>
+#include <opensubdiv/far/stencilTableFactory.h>
+#include <opensubdiv/far/topologyDescriptor.h>
 
 
 #include "../../regression/common/hbr_utils.h"
@@ -32,6 +42,11 @@
 
 #include "init_shapes.h"
 
+#if defined(__linux__)
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
 //
 // Regression testing matching Far to Hbr (default CPU implementation)
 //
@@ -312,6 +327,1033 @@ areVerticesCompatibleWithHbr(Shape const & shape, FarTopologyRefiner const & ref
     return true;
 }
 
+//------------------------------------------------------------------------------
+// Parallel interpolation with the PrimvarRefiner dispatcher overloads
+//
+// Each component is computed by the same code whichever range it falls in,
+// so results must be bitwise identical to the serial entry points.
+//
+
+// Dispatcher running small ranges interleaved over several threads:
+struct ThreadDispatcher {
+    template <class TASK>
+    void operator()(int size, TASK const & task) const {
+        int const numThreads = 4, grainSize = 7;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; ++t) {
+            threads.push_back(std::thread([=, &task]() {
+                for (int begin = t * grainSize; begin < size;
+                        begin += numThreads * grainSize) {
+                    task(begin, std::min(begin + grainSize, size));
+                }
+            }));
+        }
+        for (int t = 0; t < numThreads; ++t) {
+            threads[t].join();
+        }
+    }
+};
+
+template <int N>
+struct PrimvarN {
+    void Clear() { std::memset(_data, 0, sizeof(_data)); }
+    void AddWithWeight(PrimvarN const & src, float weight) {
+        for (int i = 0; i < N; ++i) _data[i] += weight * src._data[i];
+    }
+    float _data[N];
+};
+
+template <int N>
+static int
+compareBitwise(char const * what, std::vector< PrimvarN<N> > const & a,
+                                  std::vector< PrimvarN<N> > const & b) {
+
+    assert(a.size() == b.size());
+    int count = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (std::memcmp(a[i]._data, b[i]._data, sizeof(a[i]._data)) != 0) {
+            ++count;
+        }
+    }
+    if (count) {
+        printf("  %s : %d of %d values differ\n", what, count, (int)a.size());
+    }
+    return count ? 1 : 0;
+}
+
+template <class DISPATCHER>
+static void
+interpolateAll(FarTopologyRefiner const & refiner,
+               std::vector< PrimvarN<3> > & vertices,
+               std::vector< PrimvarN<2> > & uvs,
+               std::vector< PrimvarN<3> > & limitPos,
+               std::vector< PrimvarN<3> > & limitTan1,
+               std::vector< PrimvarN<3> > & limitTan2,
+               std::vector< PrimvarN<2> > & limitUVs,
+               DISPATCHER const & dispatcher) {
+
+    OpenSubdiv::Far::PrimvarRefiner primvarRefiner(refiner);
+
+    int maxLevel = refiner.GetMaxLevel();
+    bool hasUVs = refiner.GetNumFVarChannels() > 0;
+
+    PrimvarN<3> * src = &vertices[0];
+    PrimvarN<2> * srcUV = hasUVs ? &uvs[0] : 0;
+    for (int level = 1; level <= maxLevel; ++level) {
+        PrimvarN<3> * dst = src + refiner.GetLevel(level - 1).GetNumVertices();
+        primvarRefiner.Interpolate(level, src, dst, dispatcher);
+        src = dst;
+
+        if (hasUVs) {
+            PrimvarN<2> * dstUV =
+                srcUV + refiner.GetLevel(level - 1).GetNumFVarValues(0);
+            primvarRefiner.InterpolateFaceVarying(level, srcUV, dstUV, 0,
+                                                  dispatcher);
+            srcUV = dstUV;
+        }
+    }
+
+    PrimvarN<3> * pos = &limitPos[0];
+    PrimvarN<3> * tan1 = &limitTan1[0];
+    PrimvarN<3> * tan2 = &limitTan2[0];
+    primvarRefiner.Limit(src, pos, tan1, tan2, dispatcher);
+    if (hasUVs) {
+        PrimvarN<2> * dstUV = &limitUVs[0];
+        primvarRefiner.LimitFaceVarying(srcUV, dstUV, 0, dispatcher);
+    }
+}
+
+// Serial dispatcher matching the non-dispatching entry points:
+struct SerialDispatcher {
+    template <class TASK>
+    void operator()(int size, TASK const & task) const { task(0, size); }
+};
+
+static int
+checkParallelInterpolation(Shape const & shape, int maxlevel) {
+
+    FarTopologyRefiner * refiner = FarTopologyRefinerFactory::Create(shape,
+        FarTopologyRefinerFactory::Options(GetSdcType(shape),
+                                           GetSdcOptions(shape)));
+    FarTopologyRefiner::UniformOptions options(maxlevel);
+    options.fullTopologyInLastLevel = true;
+    refiner->RefineUniform(options);
+
+    int numCoarseVerts = refiner->GetLevel(0).GetNumVertices();
+    int numLimitVerts = refiner->GetLevel(maxlevel).GetNumVertices();
+    bool hasUVs = refiner->GetNumFVarChannels() > 0;
+    int numUVsTotal = 0, numLimitUVs = 0;
+    if (hasUVs) {
+        for (int level = 0; level <= maxlevel; ++level) {
+            numUVsTotal += refiner->GetLevel(level).GetNumFVarValues(0);
+        }
+        numLimitUVs = refiner->GetLevel(maxlevel).GetNumFVarValues(0);
+    }
+
+    std::vector< PrimvarN<3> > vertices[2], pos[2], tan1[2], tan2[2];
+    std::vector< PrimvarN<2> > uvs[2], limitUVs[2];
+    for (int i = 0; i < 2; ++i) {
+        vertices[i].resize(refiner->GetNumVerticesTotal());
+        for (int v = 0; v < numCoarseVerts; ++v) {
+            std::memcpy(vertices[i][v]._data, &shape.verts[v * 3],
+                         3 * sizeof(float));
+        }
+        uvs[i].resize(numUVsTotal);
+        for (int v = 0; hasUVs && v < (int)shape.uvs.size() / 2; ++v) {
+            std::memcpy(uvs[i][v]._data, &shape.uvs[v * 2],
+                        2 * sizeof(float));
+        }
+        pos[i].resize(numLimitVerts);
+        tan1[i].resize(numLimitVerts);
+        tan2[i].resize(numLimitVerts);
+        limitUVs[i].resize(numLimitUVs);
+    }
+
+    interpolateAll(*refiner, vertices[0], uvs[0], pos[0], tan1[0], tan2[0],
+                   limitUVs[0], SerialDispatcher());
+    interpolateAll(*refiner, vertices[1], uvs[1], pos[1], tan1[1], tan2[1],
+                   limitUVs[1], ThreadDispatcher());
+
+    int failures = compareBitwise("parallel Interpolate", vertices[1], vertices[0]) +
+                   compareBitwise("parallel Limit position", pos[1], pos[0]) +
+                   compareBitwise("parallel Limit tangent 1", tan1[1], tan1[0]) +
+                   compareBitwise("parallel Limit tangent 2", tan2[1], tan2[0]);
+    if (hasUVs) {
+        failures += compareBitwise("parallel InterpolateFaceVarying", uvs[1], uvs[0]) +
+                    compareBitwise("parallel LimitFaceVarying", limitUVs[1], limitUVs[0]);
+    }
+
+    delete refiner;
+    return failures;
+}
+
+//------------------------------------------------------------------------------
+// Interpolation of raw arrays with the PrimvarArrayRefiner
+//
+// The same masks are applied in the same order as with the PrimvarRefiner,
+// so both the interleaved and separate array layouts must give results
+// bitwise identical to those of PrimvarN<N>.
+//
+
+template <int N>
+static int
+compareArrays(char const * what, std::vector<float> const & values,
+              int elementStride, std::vector< PrimvarN<N> > const & reference) {
+
+    int count = 0;
+    for (size_t v = 0; v < reference.size(); ++v) {
+        for (int i = 0; i < N; ++i) {
+            float value = elementStride ? values[i * elementStride + v]
+                                        : values[v * N + i];
+            if (std::memcmp(&value, &reference[v]._data[i], sizeof(float))) {
+                ++count;
+                break;
+            }
+        }
+    }
+    if (count) {
+        printf("  %s (%d elements) : %d of %d values differ\n", what, N, count,
+            (int)reference.size());
+    }
+    return count ? 1 : 0;
+}
+
+template <int N, class DISPATCHER>
+static int
+checkArrayInterpolation(FarTopologyRefiner const & refiner, Shape const & shape,
+                        bool separateArrays, DISPATCHER const & dispatcher) {
+
+    int maxLevel = refiner.GetMaxLevel();
+    bool hasUVs = refiner.GetNumFVarChannels() > 0;
+
+    int numVerts = refiner.GetNumVerticesTotal();
+    int numCoarseVerts = refiner.GetLevel(0).GetNumVertices();
+    int numLimitVerts = refiner.GetLevel(maxLevel).GetNumVertices();
+    int numValues = 0;
+    int numLimitValues = 0;
+    if (hasUVs) {
+        for (int level = 0; level <= maxLevel; ++level) {
+            numValues += refiner.GetLevel(level).GetNumFVarValues(0);
+        }
+        numLimitValues = refiner.GetLevel(maxLevel).GetNumFVarValues(0);
+    }
+
+    //  Reference results with the PrimvarRefiner:
+    std::vector< PrimvarN<N> > vertices(numVerts), values(numValues),
+        pos(numLimitVerts), tan1(numLimitVerts), tan2(numLimitVerts),
+        limitValues(numLimitValues);
+    for (int v = 0; v < numCoarseVerts; ++v) {
+        for (int i = 0; i < N; ++i) {
+            vertices[v]._data[i] = shape.verts[v * 3 + i % 3] + (float)i;
+        }
+    }
+    for (int v = 0; hasUVs && v < (int)shape.uvs.size() / 2; ++v) {
+        for (int i = 0; i < N; ++i) {
+            values[v]._data[i] = shape.uvs[v * 2 + i % 2] + (float)i;
+        }
+    }
+
+    OpenSubdiv::Far::PrimvarRefiner primvarRefiner(refiner);
+    PrimvarN<N> * src = &vertices[0];
+    PrimvarN<N> * srcValues = hasUVs ? &values[0] : 0;
+    for (int level = 1; level <= maxLevel; ++level) {
+        PrimvarN<N> * dst = src + refiner.GetLevel(level - 1).GetNumVertices();
+        primvarRefiner.Interpolate(level, src, dst);
+        src = dst;
+        if (hasUVs) {
+            PrimvarN<N> * dstValues =
+                srcValues + refiner.GetLevel(level - 1).GetNumFVarValues(0);
+            primvarRefiner.InterpolateFaceVarying(level, srcValues, dstValues);
+            srcValues = dstValues;
+        }
+    }
+    primvarRefiner.Limit(src, pos, tan1, tan2);
+    if (hasUVs) {
+        primvarRefiner.LimitFaceVarying(srcValues, limitValues);
+    }
+
+    //  Same computation with the PrimvarArrayRefiner -- with separate arrays
+    //  the element stride is the number of vertices (or values) of each array:
+    int vStride = separateArrays ? numVerts : 0;
+    int fvStride = separateArrays ? numValues : 0;
+    int posStride = separateArrays ? numLimitVerts : 0;
+    int limitValueStride = separateArrays ? numLimitValues : 0;
+
+    std::vector<float> vertexData(numVerts * N), valueData(numValues * N),
+        posData(numLimitVerts * N), tan1Data(numLimitVerts * N),
+        tan2Data(numLimitVerts * N), limitValueData(numLimitValues * N);
+    for (int v = 0; v < numCoarseVerts; ++v) {
+        for (int i = 0; i < N; ++i) {
+            vertexData[vStride ? (i * vStride + v) : (v * N + i)] =
+                vertices[v]._data[i];
+        }
+    }
+    for (int v = 0; hasUVs && v < (int)shape.uvs.size() / 2; ++v) {
+        for (int i = 0; i < N; ++i) {
+            valueData[fvStride ? (i * fvStride + v) : (v * N + i)] =
+                values[v]._data[i];
+        }
+    }
+
+    OpenSubdiv::Far::PrimvarArrayRefiner arrayRefiner(refiner);
+    int vOffset = 0, fvOffset = 0;
+    for (int level = 1; level <= maxLevel; ++level) {
+        int vNext = vOffset + refiner.GetLevel(level - 1).GetNumVertices();
+        int fvNext = hasUVs ?
+            fvOffset + refiner.GetLevel(level - 1).GetNumFVarValues(0) : 0;
+        if (separateArrays) {
+            arrayRefiner.InterpolateSoA(level, &vertexData[vOffset],
+                &vertexData[vNext], N, vStride, vStride, dispatcher);
+            if (hasUVs) {
+                arrayRefiner.InterpolateFaceVaryingSoA(level,
+                    &valueData[fvOffset], &valueData[fvNext], N, fvStride,
+                    fvStride, 0, dispatcher);
+            }
+        } else {
+            arrayRefiner.Interpolate(level, &vertexData[vOffset * N],
+                &vertexData[vNext * N], N, N, N, dispatcher);
+            if (hasUVs) {
+                arrayRefiner.InterpolateFaceVarying(level,
+                    &valueData[fvOffset * N], &valueData[fvNext * N], N, N, N,
+                    0, dispatcher);
+            }
+        }
+        vOffset = vNext;
+        fvOffset = fvNext;
+    }
+    if (separateArrays) {
+        arrayRefiner.LimitSoA(&vertexData[vOffset], &posData[0], &tan1Data[0],
+            &tan2Data[0], N, vStride, posStride, dispatcher);
+        if (hasUVs) {
+            arrayRefiner.LimitFaceVaryingSoA(&valueData[fvOffset],
+                &limitValueData[0], N, fvStride, limitValueStride, 0,
+                dispatcher);
+        }
+    } else {
+        arrayRefiner.Limit(&vertexData[vOffset * N], &posData[0], &tan1Data[0],
+            &tan2Data[0], N, N, N, dispatcher);
+        if (hasUVs) {
+            arrayRefiner.LimitFaceVarying(&valueData[fvOffset * N],
+                &limitValueData[0], N, N, N, 0, dispatcher);
+        }
+    }
+
+    int failures =
+        compareArrays("array Interpolate", vertexData, vStride, vertices) +
+        compareArrays("array Limit position", posData, posStride, pos) +
+        compareArrays("array Limit tangent 1", tan1Data, posStride, tan1) +
+        compareArrays("array Limit tangent 2", tan2Data, posStride, tan2);
+    if (hasUVs) {
+        failures +=
+            compareArrays("array InterpolateFaceVarying", valueData, fvStride,
+                          values) +
+            compareArrays("array LimitFaceVarying", limitValueData,
+                          limitValueStride, limitValues);
+    }
+    return failures;
+}
+
+static int
+checkArrayInterpolation(Shape const & shape, int maxlevel) {
+
+    FarTopologyRefiner * refiner = FarTopologyRefinerFactory::Create(shape,
+        FarTopologyRefinerFactory::Options(GetSdcType(shape),
+                                           GetSdcOptions(shape)));
+    FarTopologyRefiner::UniformOptions options(maxlevel);
+    options.fullTopologyInLastLevel = true;
+    refiner->RefineUniform(options);
+
+    int failures = 0;
+    for (int separate = 0; separate < 2; ++separate) {
+        failures += checkArrayInterpolation<1>(*refiner, shape, separate != 0,
+                                               SerialDispatcher());
+        failures += checkArrayInterpolation<3>(*refiner, shape, separate != 0,
+                                               SerialDispatcher());
+        failures += checkArrayInterpolation<4>(*refiner, shape, separate != 0,
+                                               ThreadDispatcher());
+        failures += checkArrayInterpolation<7>(*refiner, shape, separate != 0,
+                                               ThreadDispatcher());
+    }
+
+    delete refiner;
+    return failures;
+}
+
+//------------------------------------------------------------------------------
+// Release of excess capacity with ShrinkToFit()
+//
+// Shrinking only reallocates the containers, so tables constructed from a
+// shrunk refiner must be identical to those constructed before, and tables
+// must be left unchanged by shrinking them.
+//
+
+template <typename T>
+static bool
+equalVectors(std::vector<T> const & a, std::vector<T> const & b) {
+
+    return (a.size() == b.size()) &&
+           (a.empty() || !std::memcmp(&a[0], &b[0], a.size() * sizeof(T)));
+}
+
+static int
+compareStencilTables(char const * what, OpenSubdiv::Far::StencilTable const & a,
+                                        OpenSubdiv::Far::StencilTable const & b) {
+
+    if (a.GetNumControlVertices() != b.GetNumControlVertices() ||
+        !equalVectors(a.GetSizes(), b.GetSizes()) ||
+        !equalVectors(a.GetOffsets(), b.GetOffsets()) ||
+        !equalVectors(a.GetControlIndices(), b.GetControlIndices()) ||
+        !equalVectors(a.GetWeights(), b.GetWeights())) {
+        printf("  %s : stencil tables differ\n", what);
+        return 1;
+    }
+    return 0;
+}
+
+static int
+comparePatchTables(char const * what, OpenSubdiv::Far::PatchTable const & a,
+                                      OpenSubdiv::Far::PatchTable const & b) {
+
+    if (a.GetNumPatchesTotal() != b.GetNumPatchesTotal() ||
+        !equalVectors(a.GetPatchControlVerticesTable(),
+                      b.GetPatchControlVerticesTable()) ||
+        !equalVectors(a.GetPatchParamTable(), b.GetPatchParamTable())) {
+        printf("  %s : patch tables differ\n", what);
+        return 1;
+    }
+    int failures = 0;
+    if (a.GetLocalPointStencilTable() && b.GetLocalPointStencilTable()) {
+        failures += compareStencilTables(what, *a.GetLocalPointStencilTable(),
+                                               *b.GetLocalPointStencilTable());
+    } else if (a.GetLocalPointStencilTable() != b.GetLocalPointStencilTable()) {
+        printf("  %s : local point stencil tables differ\n", what);
+        ++failures;
+    }
+    return failures;
+}
+
+static int
+checkMemoryUsage(char const * what, OpenSubdiv::Far::MemoryUsage const & before,
+                 OpenSubdiv::Far::MemoryUsage const & after, bool noExcess) {
+
+    if (after.used != before.used || after.allocated > before.allocated ||
+        (noExcess && after.GetExcess() != 0)) {
+        printf("  %s : memory usage (%zu, %zu) after shrinking (%zu, %zu)\n",
+               what, after.used, after.allocated, before.used,
+               before.allocated);
+        return 1;
+    }
+    return 0;
+}
+
+static int
+checkShrinkToFit(Shape const & shape, int maxlevel) {
+
+    using namespace OpenSubdiv;
+
+    FarTopologyRefiner * refiner = FarTopologyRefinerFactory::Create(shape,
+        FarTopologyRefinerFactory::Options(GetSdcType(shape),
+                                           GetSdcOptions(shape)));
+
+    Far::PatchTableFactory::Options patchOptions(maxlevel);
+    patchOptions.SetEndCapType(
+        Far::PatchTableFactory::Options::ENDCAP_GREGORY_BASIS);
+    refiner->RefineAdaptive(patchOptions.GetRefineAdaptiveOptions());
+
+    Far::StencilTableFactory::Options stencilOptions;
+    stencilOptions.generateIntermediateLevels = true;
+    stencilOptions.generateOffsets = true;
+
+    Far::StencilTable const * stencils[2];
+    Far::PatchTable * patches[2];
+
+    stencils[0] = Far::StencilTableFactory::Create(*refiner, stencilOptions);
+    patches[0] = Far::PatchTableFactory::Create(*refiner, patchOptions);
+
+    //  Shrinking the refiner keeps all of its topology:
+    Far::MemoryUsage usage = refiner->GetMemoryUsage();
+    refiner->ShrinkToFit();
+
+    int failures = checkMemoryUsage("refiner ShrinkToFit", usage,
+                                    refiner->GetMemoryUsage(), false);
+
+    stencils[1] = Far::StencilTableFactory::Create(*refiner, stencilOptions);
+    patches[1] = Far::PatchTableFactory::Create(*refiner, patchOptions);
+
+    failures += compareStencilTables("stencils of shrunk refiner",
+                                     *stencils[1], *stencils[0]);
+    failures += comparePatchTables("patches of shrunk refiner",
+                                   *patches[1], *patches[0]);
+
+    //  Shrinking the tables releases all of their excess capacity:
+    //  (the factory returns the tables as const)
+    Far::StencilTable * shrunkStencils =
+        const_cast<Far::StencilTable *>(stencils[1]);
+    usage = shrunkStencils->GetMemoryUsage();
+    shrunkStencils->ShrinkToFit();
+
+    failures += checkMemoryUsage("StencilTable ShrinkToFit", usage,
+                                 shrunkStencils->GetMemoryUsage(), true);
+    failures += compareStencilTables("shrunk stencils",
+                                     *shrunkStencils, *stencils[0]);
+
+    usage = patches[1]->GetMemoryUsage();
+    patches[1]->ShrinkToFit();
+
+    failures += checkMemoryUsage("PatchTable ShrinkToFit", usage,
+                                 patches[1]->GetMemoryUsage(), true);
+    failures += comparePatchTables("shrunk patches", *patches[1], *patches[0]);
+
+    for (int i = 0; i < 2; ++i) {
+        delete stencils[i];
+        delete patches[i];
+    }
+    delete refiner;
+    return failures;
+}
+
+//------------------------------------------------------------------------------
+// Release of refined topology with ReleaseRefinedTopology()
+//
+// The face-vertices, holes and face-varying values of the last level must
+// be retained as requested, while the interpolation of primvars and the
+// construction of tables must fail with an error.
+//
+
+static int g_numErrors = 0;
+
+static void
+countError(OpenSubdiv::Far::ErrorType, const char *) {
+    ++g_numErrors;
+}
+
+static int
+checkReleaseRefinedTopology(Shape const & shape, int maxlevel) {
+
+    using namespace OpenSubdiv;
+
+    //  Every third face is a hole, so that holes are found at all levels:
+    std::vector<Far::Index> holes;
+    for (int f = 0; f < shape.GetNumFaces(); f += 3) {
+        holes.push_back(f);
+    }
+
+    Far::TopologyDescriptor desc;
+    desc.numVertices = (int)shape.verts.size() / 3;
+    desc.numFaces = shape.GetNumFaces();
+    desc.numVertsPerFace = &shape.nvertsPerFace[0];
+    desc.vertIndicesPerFace = &shape.faceverts[0];
+    desc.numHoles = (int)holes.size();
+    desc.holeIndices = &holes[0];
+
+    Far::TopologyDescriptor::FVarChannel uvChannel;
+    if (!shape.faceuvs.empty()) {
+        uvChannel.numValues = (int)shape.uvs.size() / 2;
+        uvChannel.valueIndices = &shape.faceuvs[0];
+        desc.numFVarChannels = 1;
+        desc.fvarChannels = &uvChannel;
+    }
+
+    typedef Far::TopologyRefinerFactory<Far::TopologyDescriptor> Factory;
+
+    int failures = 0;
+    for (int retain = 0; retain < 2; ++retain) {
+        Far::TopologyRefiner * refiner = Factory::Create(desc,
+            Factory::Options(GetSdcType(shape), GetSdcOptions(shape)));
+        refiner->RefineUniform(Far::TopologyRefiner::UniformOptions(maxlevel));
+
+        int numChannels = refiner->GetNumFVarChannels();
+        int numVertsTotal = refiner->GetNumVerticesTotal();
+
+        //  Copy of the last level before releasing the topology:
+        Far::TopologyLevel const & level = refiner->GetLevel(maxlevel);
+        int numFaces = level.GetNumFaces(),
+            numEdges = level.GetNumEdges(),
+            numVerts = level.GetNumVertices();
+
+        std::vector<int> faceVerts, faceValues, faceHoles;
+        for (int f = 0; f < numFaces; ++f) {
+            Far::ConstIndexArray fVerts = level.GetFaceVertices(f);
+            faceVerts.insert(faceVerts.end(), fVerts.begin(), fVerts.end());
+            faceHoles.push_back(level.IsFaceHole(f));
+            if (numChannels) {
+                Far::ConstIndexArray fValues = level.GetFaceFVarValues(f);
+                faceValues.insert(faceValues.end(), fValues.begin(), fValues.end());
+            }
+        }
+
+        Far::TopologyRefiner::ReleaseOptions options;
+        options.retainLastLevelFaceVertices = retain;
+        options.retainLastLevelFVarValues = retain;
+        refiner->ReleaseRefinedTopology(options);
+
+        Far::TopologyLevel const & released = refiner->GetLevel(maxlevel);
+        if (released.GetNumFaces() != numFaces ||
+            released.GetNumEdges() != numEdges ||
+            released.GetNumVertices() != numVerts ||
+            refiner->GetNumVerticesTotal() != numVertsTotal) {
+            printf("  ReleaseRefinedTopology : component counts differ\n");
+            ++failures;
+        }
+
+        if (retain) {
+            std::vector<int> retainedVerts, retainedValues, retainedHoles;
+            for (int f = 0; f < numFaces; ++f) {
+                Far::ConstIndexArray fVerts = released.GetFaceVertices(f);
+                retainedVerts.insert(retainedVerts.end(),
+                                     fVerts.begin(), fVerts.end());
+                retainedHoles.push_back(released.IsFaceHole(f));
+                if (numChannels) {
+                    Far::ConstIndexArray fValues =
+                        released.GetFaceFVarValues(f);
+                    retainedValues.insert(retainedValues.end(),
+                                          fValues.begin(), fValues.end());
+                }
+            }
+            if (retainedVerts != faceVerts || retainedHoles != faceHoles ||
+                retainedValues != faceValues) {
+                printf("  ReleaseRefinedTopology : retained last level "
+                       "differs\n");
+                ++failures;
+            }
+        }
+
+        //  Interpolation and table construction report errors:
+        g_numErrors = 0;
+        Far::SetErrorCallback(countError);
+
+        std::vector< PrimvarN<3> > vertices(numVertsTotal);
+        for (int v = 0; v < desc.numVertices; ++v) {
+            std::memcpy(vertices[v]._data, &shape.verts[v * 3],
+                        3 * sizeof(float));
+        }
+        std::vector< PrimvarN<3> > untouched(vertices);
+
+        Far::PrimvarRefiner primvarRefiner(*refiner);
+        PrimvarN<3> * src = &vertices[0];
+        PrimvarN<3> * dst = src + refiner->GetLevel(0).GetNumVertices();
+        primvarRefiner.Interpolate(1, src, dst);
+        primvarRefiner.InterpolateVarying(1, src, dst);
+
+        Far::StencilTable const * stencils =
+            Far::StencilTableFactory::Create(*refiner);
+
+        Far::SetErrorCallback(0);
+
+        if (g_numErrors != 3 || stencils) {
+            printf("  ReleaseRefinedTopology : %d of 3 errors reported\n",
+                   g_numErrors);
+            ++failures;
+        }
+        failures += compareBitwise("released Interpolate", vertices, untouched);
+
+        delete stencils;
+        delete refiner;
+    }
+    return failures;
+}
+
+//------------------------------------------------------------------------------
+// Allocators
+//
+// Refiners allocating through a TrackingAllocator (forwarding to huge pages)
+// must build the same tables as with the default allocator, and return all
+// of their memory to it -- even when another allocator has since been
+// assigned.
+//
+
+static int
+checkAllocators(Shape const & shape, int maxlevel) {
+
+    using namespace OpenSubdiv;
+
+    Far::PatchTableFactory::Options patchOptions(maxlevel);
+    patchOptions.SetEndCapType(
+        Far::PatchTableFactory::Options::ENDCAP_GREGORY_BASIS);
+
+    Far::StencilTableFactory::Options stencilOptions;
+    stencilOptions.generateIntermediateLevels = true;
+    stencilOptions.generateOffsets = true;
+
+    //  Huge pages are used for the larger blocks of most shapes:
+    Far::HugePageAllocator hugePages(16 * 1024);
+    Far::TrackingAllocator tracking(&hugePages);
+
+    Far::StencilTable const * stencils[2];
+    Far::PatchTable const * patches[2];
+    FarTopologyRefiner * refiners[2];
+
+    int failures = 0;
+    for (int i = 0; i < 2; ++i) {
+        Far::SetAllocator(i ? &tracking : 0);
+
+        refiners[i] = FarTopologyRefinerFactory::Create(shape,
+            FarTopologyRefinerFactory::Options(GetSdcType(shape),
+                                               GetSdcOptions(shape)));
+        refiners[i]->RefineAdaptive(patchOptions.GetRefineAdaptiveOptions());
+
+        stencils[i] = Far::StencilTableFactory::Create(*refiners[i],
+                                                       stencilOptions);
+        patches[i] = Far::PatchTableFactory::Create(*refiners[i],
+                                                    patchOptions);
+    }
+    Far::SetAllocator(0);
+
+    failures += compareStencilTables("stencils of tracked refiner",
+                                     *stencils[1], *stencils[0]);
+    failures += comparePatchTables("patches of tracked refiner",
+                                   *patches[1], *patches[0]);
+
+    if (tracking.GetNumAllocations() == 0 ||
+        tracking.GetCurrentBytes() == 0 ||
+        tracking.GetPeakBytes() < tracking.GetCurrentBytes()) {
+        printf("  TrackingAllocator : refiner allocations not tracked\n");
+        ++failures;
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        delete stencils[i];
+        delete patches[i];
+        delete refiners[i];
+    }
+
+    if (tracking.GetNumAllocations() != 0 || tracking.GetCurrentBytes() != 0) {
+        printf("  TrackingAllocator : %zu blocks (%zu bytes) not released\n",
+               tracking.GetNumAllocations(), tracking.GetCurrentBytes());
+        ++failures;
+    }
+    return failures;
+}
+
+//  Blocks of the HugePageAllocator are usable and, when mapped, aligned to
+//  huge pages and unmapped when deallocated:
+static int
+checkHugePageAllocator() {
+
+    using namespace OpenSubdiv;
+
+    size_t const threshold = 64 * 1024;
+    size_t const hugePageSize = 2 * 1024 * 1024;
+
+    Far::HugePageAllocator allocator(threshold);
+
+    size_t const sizes[] = { 100, threshold - 1, threshold,
+                             hugePageSize, 3 * hugePageSize + 5 };
+
+    int failures = 0;
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); ++i) {
+            unsigned char * block =
+                static_cast<unsigned char *>(allocator.Allocate(sizes[i]));
+
+#if defined(__linux__)
+            if ((sizes[i] >= threshold) &&
+                (reinterpret_cast<uintptr_t>(block) % hugePageSize)) {
+                printf("  HugePageAllocator : block of %zu bytes not aligned\n",
+                       sizes[i]);
+                ++failures;
+            }
+#endif
+            std::memset(block, 0xff, sizes[i]);
+            if (block[0] != 0xff || block[sizes[i] - 1] != 0xff) {
+                printf("  HugePageAllocator : block of %zu bytes not usable\n",
+                       sizes[i]);
+                ++failures;
+            }
+            allocator.Deallocate(block, sizes[i]);
+
+#if defined(__linux__)
+            //  mincore() fails with ENOMEM for pages that are not mapped
+            //  (including the page preceding the block within its mapping):
+            if (sizes[i] >= threshold) {
+                size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+                std::vector<unsigned char> residency(
+                    (sizes[i] + pageSize - 1) / pageSize);
+                if ((mincore(block, sizes[i], &residency[0]) == 0) ||
+                    (mincore(block - pageSize, pageSize, &residency[0]) == 0)) {
+                    printf("  HugePageAllocator : block of %zu bytes not "
+                           "unmapped\n", sizes[i]);
+                    ++failures;
+                }
+            }
+#endif
+        }
+    }
+    return failures;
+}
+
+//------------------------------------------------------------------------------
+// Edge input
+//
+// Refiners created from a TopologyDescriptor with its edges supplied (in any
+// order and orientation) must match those created from its face-vertices
+// alone, and inconsistent face-edges must be rejected.
+//
+
+static int
+compareBaseLevels(char const * what, FarTopologyLevel const & a,
+                  FarTopologyLevel const & b, std::vector<int> const & edgeMap) {
+
+    if (a.GetNumEdges() != b.GetNumEdges() ||
+        a.GetNumVertices() != b.GetNumVertices() ||
+        a.GetNumFaces() != b.GetNumFaces()) {
+        printf("  %s : component counts differ\n", what);
+        return 1;
+    }
+
+    int count = 0;
+    for (int f = 0; f < a.GetNumFaces(); ++f) {
+        OpenSubdiv::Far::ConstIndexArray eA = a.GetFaceEdges(f),
+                                         eB = b.GetFaceEdges(f);
+        bool same = (eA.size() == eB.size()) &&
+                    (a.IsFaceHole(f) == b.IsFaceHole(f));
+        for (int i = 0; same && (i < eA.size()); ++i) {
+            same = (edgeMap[eA[i]] == eB[i]);
+        }
+        count += !same;
+    }
+    for (int e = 0; e < a.GetNumEdges(); ++e) {
+        int eB = edgeMap[e];
+
+        OpenSubdiv::Far::ConstIndexArray fA = a.GetEdgeFaces(e),
+                                         fB = b.GetEdgeFaces(eB);
+        bool same = (fA.size() == fB.size()) &&
+                    (a.IsEdgeNonManifold(e) == b.IsEdgeNonManifold(eB)) &&
+                    (a.GetEdgeSharpness(e) == b.GetEdgeSharpness(eB));
+        for (int i = 0; same && (i < fA.size()); ++i) {
+            same = (fA[i] == fB[i]);
+        }
+        count += !same;
+    }
+    for (int v = 0; v < a.GetNumVertices(); ++v) {
+        OpenSubdiv::Far::ConstIndexArray fA = a.GetVertexFaces(v),
+                                         fB = b.GetVertexFaces(v),
+                                         eA = a.GetVertexEdges(v),
+                                         eB = b.GetVertexEdges(v);
+        bool same = (fA.size() == fB.size()) && (eA.size() == eB.size()) &&
+                    (a.IsVertexNonManifold(v) == b.IsVertexNonManifold(v)) &&
+                    (a.GetVertexSharpness(v) == b.GetVertexSharpness(v));
+
+        //  Incident components are only ordered around manifold vertices:
+        if (same && !a.IsVertexNonManifold(v)) {
+            for (int i = 0; same && (i < fA.size()); ++i) {
+                same = (fA[i] == fB[i]);
+            }
+            for (int i = 0; same && (i < eA.size()); ++i) {
+                same = (edgeMap[eA[i]] == eB[i]);
+            }
+        }
+        count += !same;
+    }
+    if (count) {
+        printf("  %s : %d components differ\n", what, count);
+    }
+    return count ? 1 : 0;
+}
+
+static int
+compareRefinedVertices(char const * what, Shape const & shape,
+                       FarTopologyRefiner & a, FarTopologyRefiner & b,
+                       int maxlevel) {
+
+    std::vector< PrimvarN<3> > vertices[2];
+    FarTopologyRefiner * refiners[2] = { &a, &b };
+    for (int i = 0; i < 2; ++i) {
+        FarTopologyRefiner & refiner = *refiners[i];
+        refiner.RefineUniform(FarTopologyRefiner::UniformOptions(maxlevel));
+
+        vertices[i].resize(refiner.GetNumVerticesTotal());
+        for (int v = 0; v < refiner.GetLevel(0).GetNumVertices(); ++v) {
+            std::memcpy(vertices[i][v]._data, &shape.verts[v * 3],
+                        3 * sizeof(float));
+        }
+
+        OpenSubdiv::Far::PrimvarRefiner primvarRefiner(refiner);
+        PrimvarN<3> * src = &vertices[i][0];
+        for (int level = 1; level <= maxlevel; ++level) {
+            PrimvarN<3> * dst =
+                src + refiner.GetLevel(level - 1).GetNumVertices();
+            primvarRefiner.Interpolate(level, src, dst);
+            src = dst;
+        }
+    }
+
+    for (int level = 1; level <= maxlevel; ++level) {
+        FarTopologyLevel const & levelA = a.GetLevel(level),
+                               & levelB = b.GetLevel(level);
+        if (levelA.GetNumFaces() != levelB.GetNumFaces() ||
+            levelA.GetNumEdges() != levelB.GetNumEdges() ||
+            levelA.GetNumVertices() != levelB.GetNumVertices()) {
+            printf("  %s : component counts of level %d differ\n",
+                   what, level);
+            return 1;
+        }
+    }
+    return compareBitwise(what, vertices[1], vertices[0]);
+}
+
+static int
+checkEdgeInput(Shape const & shape, int maxlevel) {
+
+    using namespace OpenSubdiv;
+
+    typedef Far::TopologyRefinerFactory<Far::TopologyDescriptor> Factory;
+
+    std::vector<Far::Index> creaseVerts, cornerVerts, holes;
+    std::vector<float> creaseWeights, cornerWeights;
+    for (int i = 0; i < (int)shape.tags.size(); ++i) {
+        Shape::tag const * t = shape.tags[i];
+
+        int numWeights = (int)t->floatargs.size();
+        if (t->name == "crease") {
+            for (int j = 0; j + 1 < (int)t->intargs.size(); j += 2) {
+                creaseVerts.push_back(t->intargs[j]);
+                creaseVerts.push_back(t->intargs[j + 1]);
+                creaseWeights.push_back(
+                    t->floatargs[std::min(j / 2, numWeights - 1)]);
+            }
+        } else if (t->name == "corner") {
+            for (int j = 0; j < (int)t->intargs.size(); ++j) {
+                cornerVerts.push_back(t->intargs[j]);
+                cornerWeights.push_back(
+                    t->floatargs[std::min(j, numWeights - 1)]);
+            }
+        } else if (t->name == "hole") {
+            holes.insert(holes.end(), t->intargs.begin(), t->intargs.end());
+        }
+    }
+
+    Far::TopologyDescriptor desc;
+    desc.numVertices = (int)shape.verts.size() / 3;
+    desc.numFaces = shape.GetNumFaces();
+    desc.numVertsPerFace = &shape.nvertsPerFace[0];
+    desc.vertIndicesPerFace = &shape.faceverts[0];
+    if (!creaseWeights.empty()) {
+        desc.numCreases = (int)creaseWeights.size();
+        desc.creaseVertexIndexPairs = &creaseVerts[0];
+        desc.creaseWeights = &creaseWeights[0];
+    }
+    if (!cornerWeights.empty()) {
+        desc.numCorners = (int)cornerWeights.size();
+        desc.cornerVertexIndices = &cornerVerts[0];
+        desc.cornerWeights = &cornerWeights[0];
+    }
+    if (!holes.empty()) {
+        desc.numHoles = (int)holes.size();
+        desc.holeIndices = &holes[0];
+    }
+
+    Factory::Options options(GetSdcType(shape), GetSdcOptions(shape));
+
+    int failures = 0;
+    for (int leftHanded = 0; leftHanded < 2; ++leftHanded) {
+        desc.isLeftHanded = (leftHanded != 0);
+        desc.numEdges = 0;
+
+        FarTopologyRefiner * reference = Factory::Create(desc, options);
+        FarTopologyLevel const & baseLevel = reference->GetLevel(0);
+
+        //  Edges cannot be supplied for degenerate edges or for faces with
+        //  an edge repeated:
+        int numEdges = baseLevel.GetNumEdges();
+        bool supported = true;
+        for (int e = 0; supported && (e < numEdges); ++e) {
+            Far::ConstIndexArray eVerts = baseLevel.GetEdgeVertices(e);
+            supported = (eVerts[0] != eVerts[1]);
+        }
+        for (int f = 0; supported && (f < desc.numFaces); ++f) {
+            Far::ConstIndexArray fEdges = baseLevel.GetFaceEdges(f);
+            for (int i = 1; supported && (i < fEdges.size()); ++i) {
+                supported = (std::find(fEdges.begin(), fEdges.begin() + i,
+                                       fEdges[i]) == fEdges.begin() + i);
+            }
+        }
+        if (!supported) {
+            delete reference;
+            return failures;
+        }
+
+        for (int permute = 0; permute < 2; ++permute) {
+
+            //  Edges are reversed in order and every other edge is flipped:
+            std::vector<int> edgeMap(numEdges);
+            std::vector<Far::Index> edgeVerts(2 * numEdges), faceEdges;
+            for (int e = 0; e < numEdges; ++e) {
+                edgeMap[e] = permute ? (numEdges - 1 - e) : e;
+
+                Far::ConstIndexArray eVerts = baseLevel.GetEdgeVertices(e);
+                bool flip = permute && (e & 1);
+                edgeVerts[2 * edgeMap[e]]     = eVerts[flip ? 1 : 0];
+                edgeVerts[2 * edgeMap[e] + 1] = eVerts[flip ? 0 : 1];
+            }
+            //  Face-edges of left-handed faces are supplied in reverse:
+            for (int f = 0; f < desc.numFaces; ++f) {
+                Far::ConstIndexArray fEdges = baseLevel.GetFaceEdges(f);
+                for (int i = 0; i < fEdges.size(); ++i) {
+                    int edge = leftHanded ? fEdges[fEdges.size() - 1 - i]
+                                          : fEdges[i];
+                    faceEdges.push_back(edgeMap[edge]);
+                }
+            }
+            desc.numEdges = numEdges;
+            desc.edgeVertIndices = &edgeVerts[0];
+            desc.edgeIndicesPerFace = &faceEdges[0];
+
+            FarTopologyRefiner * refiner = Factory::Create(desc, options);
+            if (!refiner) {
+                printf("  edge input : refiner not created\n");
+                ++failures;
+                continue;
+            }
+            failures += compareBaseLevels("edge input", baseLevel,
+                                          refiner->GetLevel(0), edgeMap);
+
+            //  Edges in their original order refine identically:
+            if (!permute) {
+                Far::TopologyDescriptor faceVertDesc(desc);
+                faceVertDesc.numEdges = 0;
+                FarTopologyRefiner * expected =
+                    Factory::Create(faceVertDesc, options);
+                failures += compareRefinedVertices("edge input", shape,
+                                                   *expected, *refiner,
+                                                   maxlevel);
+                delete expected;
+            }
+            delete refiner;
+        }
+
+        //  Face-edges inconsistent with the face-vertices are rejected:
+        std::vector<Far::Index> edgeVerts, faceEdges;
+        for (int e = 0; e < numEdges; ++e) {
+            Far::ConstIndexArray eVerts = baseLevel.GetEdgeVertices(e);
+            edgeVerts.push_back(eVerts[0]);
+            edgeVerts.push_back(eVerts[1]);
+        }
+        for (int f = 0; f < desc.numFaces; ++f) {
+            Far::ConstIndexArray fEdges = baseLevel.GetFaceEdges(f);
+            for (int i = 0; i < fEdges.size(); ++i) {
+                faceEdges.push_back(leftHanded ? fEdges[fEdges.size() - 1 - i]
+                                               : fEdges[i]);
+            }
+        }
+        std::swap(faceEdges[0], faceEdges[1]);
+        desc.edgeVertIndices = &edgeVerts[0];
+        desc.edgeIndicesPerFace = &faceEdges[0];
+
+        g_numErrors = 0;
+        Far::SetErrorCallback(countError);
+        FarTopologyRefiner * invalid = Factory::Create(desc, options);
+        Far::SetErrorCallback(0);
+        if (invalid || (g_numErrors == 0)) {
+            printf("  edge input : inconsistent face-edges not rejected\n");
+            ++failures;
+        }
+        delete invalid;
+        delete reference;
+    }
+    return failures;
+}
+
 //------------------------------------------------------------------------------
 static int
 checkMesh(Shape const & shape, std::string const& name, int maxlevel) {
@@ -335,6 +1377,15 @@ checkMesh(Shape const & shape, std::string const& name, int maxlevel) {
         printf("  warning : vertex data not compared with Hbr (%s)\n", warningDetail.c_str());
     }
 
+    delete refiner;
+
+    failureCount += checkParallelInterpolation(shape, 3);
+    failureCount += checkArrayInterpolation(shape, 2);
+    failureCount += checkShrinkToFit(shape, 3);
+    failureCount += checkReleaseRefinedTopology(shape, 2);
+    failureCount += checkAllocators(shape, 3);
+    failureCount += checkEdgeInput(shape, 3);
+
     return failureCount;
 }
 
@@ -350,6 +1401,8 @@ int main(int /* argc */, char ** /* argv */) {
     else
         printf("precision : %f\n",PRECISION);
 
+    total += checkHugePageAllocator();
+
     for (int i=0; i<(int)g_shapes.size(); ++i) {
         ShapeDesc const & desc = g_shapes[i];
 
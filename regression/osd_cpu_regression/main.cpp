@@ -0,0 +1,2859 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <opensubdiv/version.h>
+#include <opensubdiv/far/compactPatchVertices.h>
+#include <opensubdiv/far/patchMap.h>
+#include <opensubdiv/far/patchTableFactory.h>
+#include <opensubdiv/far/primvarRefiner.h>
+#include <opensubdiv/far/ptexIndices.h>
+#include <opensubdiv/far/stencilDependencyMap.h>
+#include <opensubdiv/far/stencilTableFactory.h>
+#include <opensubdiv/far/topologyDescriptor.h>
+#include <opensubdiv/osd/cpuEvaluator.h>
+#include <opensubdiv/osd/cpuPatchTable.h>
+#include <opensubdiv/osd/cpuUniformRefiner.h>
+#include <opensubdiv/osd/cpuVertexBuffer.h>
+#include <opensubdiv/osd/mesh.h>
+#include <opensubdiv/osd/numaEvaluator.h>
+#include <opensubdiv/osd/numaThreadPool.h>
+#include <opensubdiv/osd/patchBVH.h>
+#include <opensubdiv/osd/threadPool.h>
+#include <opensubdiv/osd/threadPoolEvaluator.h>
+#include <opensubdiv/osd/topologyCache.h>
+#ifdef OPENSUBDIV_HAS_OPENMP
+    #include <opensubdiv/osd/ompEvaluator.h>
+#endif
+#ifdef OPENSUBDIV_HAS_TBB
+    #include <opensubdiv/osd/tbbEvaluator.h>
+#endif
+
+#include "../../regression/common/far_utils.h"
+
+#include "init_shapes.h"
+
+using namespace OpenSubdiv;
+
+//
+// Regression testing of the Osd CPU evaluation paths against the serial
+// CpuEvaluator and Far reference paths.
+//
+// Notes:
+// - the parallel evaluators and the alternate data layouts share the serial
+//   kernels and only partition the work, so their results are compared
+//   bitwise.
+//
+// - alternate formulations which reorder the arithmetic are compared to
+//   PRECISION.
+//
+#define PRECISION 1e-5
+
+//------------------------------------------------------------------------------
+// Primvar class of N values used with the Far stencil and primvar refiners
+template <int N, typename REAL = float>
+struct Primvar {
+
+    void Clear() {
+        for (int i = 0; i < N; ++i) _data[i] = (REAL)0;
+    }
+
+    void AddWithWeight(Primvar const & src, REAL weight) {
+        for (int i = 0; i < N; ++i) _data[i] += weight * src._data[i];
+    }
+
+    REAL _data[N];
+};
+
+typedef Primvar<3> Vertex;
+
+//------------------------------------------------------------------------------
+// Adaptively refined mesh with its patches, stencils and a set of limit
+// coordinates evaluated by the tests
+struct TestMesh {
+
+    TestMesh(Shape const & shape, int level);
+    ~TestMesh();
+
+    int GetNumPatchCoords() const { return (int)patchCoords.size(); }
+
+    Far::TopologyRefiner * refiner;
+    Far::PatchTable const * patchTable;
+    Far::StencilTable const * stencilTable;
+    Osd::CpuPatchTable * cpuPatchTable;
+
+    int numCoarseVerts;
+    std::vector<float> vertexData;
+    std::vector<Osd::PatchCoord> patchCoords;
+};
+
+TestMesh::TestMesh(Shape const & shape, int level) {
+
+    refiner = Far::TopologyRefinerFactory<Shape>::Create(shape,
+        Far::TopologyRefinerFactory<Shape>::Options(
+            GetSdcType(shape), GetSdcOptions(shape)));
+
+    Far::PatchTableFactory::Options patchOptions(level);
+    patchOptions.SetEndCapType(
+        Far::PatchTableFactory::Options::ENDCAP_GREGORY_BASIS);
+
+    refiner->RefineAdaptive(patchOptions.GetRefineAdaptiveOptions());
+
+    Far::StencilTableFactory::Options stencilOptions;
+    stencilOptions.generateOffsets = true;
+    stencilOptions.generateIntermediateLevels = true;
+
+    stencilTable = Far::StencilTableFactory::Create(*refiner, stencilOptions);
+
+    patchTable = Far::PatchTableFactory::Create(*refiner, patchOptions);
+
+    if (Far::StencilTable const * stencilTableWithLocalPoints =
+        Far::StencilTableFactory::AppendLocalPointStencilTable(*refiner,
+            stencilTable, patchTable->GetLocalPointStencilTable())) {
+        delete stencilTable;
+        stencilTable = stencilTableWithLocalPoints;
+    }
+
+    cpuPatchTable = Osd::CpuPatchTable::Create(patchTable);
+
+    numCoarseVerts = refiner->GetLevel(0).GetNumVertices();
+
+    vertexData.resize((numCoarseVerts + stencilTable->GetNumStencils()) * 3);
+    std::copy(shape.verts.begin(), shape.verts.begin() + numCoarseVerts * 3,
+              vertexData.begin());
+
+    if (stencilTable->GetNumStencils() > 0) {
+        Vertex * vertices = reinterpret_cast<Vertex *>(&vertexData[0]);
+        stencilTable->UpdateValues(vertices, vertices + numCoarseVerts);
+    }
+
+    //  A uniform grid of coordinates on each ptex face -- no patches are
+    //  found for holes:
+    int const n = 3;
+
+    Far::PatchMap patchMap(*patchTable);
+    int numPtexFaces = Far::PtexIndices(*refiner).GetNumFaces();
+    for (int face = 0; face < numPtexFaces; ++face) {
+        for (int j = 0; j < n; ++j) {
+            for (int i = 0; i < n; ++i) {
+                float s = ((float)i + 0.5f) / (float)n;
+                float t = ((float)j + 0.5f) / (float)n;
+                if (Far::PatchTable::PatchHandle const * handle =
+                    patchMap.FindPatch(face, s, t)) {
+                    patchCoords.push_back(Osd::PatchCoord(*handle, s, t));
+                }
+            }
+        }
+    }
+}
+
+TestMesh::~TestMesh() {
+    delete cpuPatchTable;
+    delete patchTable;
+    delete stencilTable;
+    delete refiner;
+}
+
+//------------------------------------------------------------------------------
+// Compares two buffers -- a tolerance of 0 requires bitwise identical values,
+// otherwise it is relative to the magnitude of values greater than 1
+template <typename REAL>
+static int
+compareBuffers(char const * what, std::vector<REAL> const & result,
+               std::vector<REAL> const & reference, double tolerance = 0.0) {
+
+    if (result.size() != reference.size()) {
+        printf("  %s : size mismatch (%d != %d)\n", what,
+               (int)result.size(), (int)reference.size());
+        return 1;
+    }
+
+    int count = 0;
+    for (size_t i = 0; i < result.size(); ++i) {
+        double delta = std::abs((double)result[i] - (double)reference[i]);
+        double scale = std::max(1.0, std::abs((double)reference[i]));
+        bool failed = (tolerance > 0.0) ? !(delta <= tolerance * scale)
+                                        : (result[i] != reference[i]);
+        if (failed) {
+            if (count == 0) {
+                printf("  %s : element %d differs (%g != %g)\n", what, (int)i,
+                       (double)result[i], (double)reference[i]);
+            }
+            ++count;
+        }
+    }
+    if (count) {
+        printf("  %s : %d of %d elements differ\n", what, count,
+               (int)result.size());
+    }
+    return count ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+// Limit values and derivatives at the coordinates of a mesh
+template <typename REAL>
+struct LimitBuffers {
+
+    LimitBuffers(int numCoords, int length) :
+        desc(0, length, length) {
+        for (int i = 0; i < 6; ++i) {
+            data[i].assign(numCoords * length, (REAL)0);
+        }
+    }
+
+    REAL * P()   { return &data[0][0]; }
+    REAL * Du()  { return &data[1][0]; }
+    REAL * Dv()  { return &data[2][0]; }
+    REAL * Duu() { return &data[3][0]; }
+    REAL * Duv() { return &data[4][0]; }
+    REAL * Dvv() { return &data[5][0]; }
+
+    int Compare(char const * what, LimitBuffers const & reference,
+                int numOutputs = 6, double tolerance = 0.0) const {
+        static char const * names[] = { "P", "Du", "Dv", "Duu", "Duv", "Dvv" };
+        int failures = 0;
+        for (int i = 0; i < numOutputs; ++i) {
+            char label[128];
+            snprintf(label, sizeof(label), "%s %s", what, names[i]);
+            failures += compareBuffers(label, data[i], reference.data[i],
+                                       tolerance);
+        }
+        return failures;
+    }
+
+    Osd::BufferDescriptor desc;
+    std::vector<REAL> data[6];
+};
+
+//  Reference limit evaluation with the serial CpuEvaluator:
+static void
+evalReference(TestMesh & mesh, LimitBuffers<float> & limit) {
+
+    Osd::BufferDescriptor srcDesc(0, 3, 3);
+
+    Osd::CpuEvaluator::EvalPatches(&mesh.vertexData[0], srcDesc,
+        limit.P(),   limit.desc, limit.Du(),  limit.desc,
+        limit.Dv(),  limit.desc, limit.Duu(), limit.desc,
+        limit.Duv(), limit.desc, limit.Dvv(), limit.desc,
+        mesh.GetNumPatchCoords(), &mesh.patchCoords[0],
+        mesh.cpuPatchTable->GetPatchArrayBuffer(),
+        mesh.cpuPatchTable->GetPatchIndexBuffer(),
+        mesh.cpuPatchTable->GetPatchParamBuffer());
+}
+
+//------------------------------------------------------------------------------
+// Limit evaluation decoding the patch control vertices from a
+// Far::CompactPatchVertices
+template <class EVALUATOR>
+static int
+checkCompactPatches(char const * evaluatorName, TestMesh & mesh,
+                    Far::CompactPatchVertices const & patchVertices,
+                    LimitBuffers<float> const & reference) {
+
+    Osd::BufferDescriptor srcDesc(0, 3, 3);
+    int numCoords = mesh.GetNumPatchCoords();
+
+    LimitBuffers<float> limit(numCoords, 3);
+    EVALUATOR::EvalPatches(&mesh.vertexData[0], srcDesc,
+        limit.P(),   limit.desc, limit.Du(),  limit.desc,
+        limit.Dv(),  limit.desc, limit.Duu(), limit.desc,
+        limit.Duv(), limit.desc, limit.Dvv(), limit.desc,
+        numCoords, &mesh.patchCoords[0],
+        mesh.cpuPatchTable->GetPatchArrayBuffer(), &patchVertices,
+        mesh.cpuPatchTable->GetPatchParamBuffer());
+
+    LimitBuffers<float> limit1(numCoords, 3);
+    EVALUATOR::EvalPatches(&mesh.vertexData[0], srcDesc,
+        limit1.P(),  limit1.desc, limit1.Du(), limit1.desc,
+        limit1.Dv(), limit1.desc,
+        numCoords, &mesh.patchCoords[0],
+        mesh.cpuPatchTable->GetPatchArrayBuffer(), &patchVertices,
+        mesh.cpuPatchTable->GetPatchParamBuffer());
+
+    LimitBuffers<float> limit0(numCoords, 3);
+    EVALUATOR::EvalPatches(&mesh.vertexData[0], srcDesc,
+        limit0.P(),  limit0.desc,
+        numCoords, &mesh.patchCoords[0],
+        mesh.cpuPatchTable->GetPatchArrayBuffer(), &patchVertices,
+        mesh.cpuPatchTable->GetPatchParamBuffer());
+
+    std::string what = std::string(evaluatorName) + " compact";
+    return limit.Compare(what.c_str(), reference) +
+           limit1.Compare(what.c_str(), reference, 3) +
+           limit0.Compare(what.c_str(), reference, 1);
+}
+
+static int
+checkCompactPatches(TestMesh & mesh, LimitBuffers<float> const & reference) {
+
+    //  Use small blocks so that most meshes span several of them:
+    Far::CompactPatchVertices patchVertices(*mesh.patchTable, 4);
+
+    int failures = 0;
+    failures += checkCompactPatches<Osd::CpuEvaluator>(
+        "CpuEvaluator", mesh, patchVertices, reference);
+    failures += checkCompactPatches<Osd::ThreadPoolEvaluator>(
+        "ThreadPoolEvaluator", mesh, patchVertices, reference);
+#ifdef OPENSUBDIV_HAS_OPENMP
+    failures += checkCompactPatches<Osd::OmpEvaluator>(
+        "OmpEvaluator", mesh, patchVertices, reference);
+#endif
+#ifdef OPENSUBDIV_HAS_TBB
+    failures += checkCompactPatches<Osd::TbbEvaluator>(
+        "TbbEvaluator", mesh, patchVertices, reference);
+#endif
+    return failures;
+}
+
+//------------------------------------------------------------------------------
+// Uniform refinement of primvars of N elements with CpuUniformRefiner compared
+// to Far::PrimvarRefiner -- the primvars are interleaved with padding to
+// exercise the buffer descriptor
+static float
+primvarValue(Shape const & shape, int vertex, int element) {
+
+    return (element < 3) ? shape.verts[vertex * 3 + element]
+                         : std::sin((float)(vertex + element));
+}
+
+template <int N>
+static int
+checkUniformRefiner(Shape const & shape, int level) {
+
+    Far::TopologyRefiner * refiner =
+        Far::TopologyRefinerFactory<Shape>::Create(shape,
+            Far::TopologyRefinerFactory<Shape>::Options(
+                GetSdcType(shape), GetSdcOptions(shape)));
+    refiner->RefineUniform(Far::TopologyRefiner::UniformOptions(level));
+
+    Osd::CpuUniformRefiner * uniformRefiner =
+        Osd::CpuUniformRefiner::Create(*refiner);
+
+    int numCoarseVerts = refiner->GetLevel(0).GetNumVertices();
+    int numVertsTotal = refiner->GetNumVerticesTotal();
+
+    //  Reference primvars refined with Far::PrimvarRefiner:
+    std::vector< Primvar<N> > farVertices(numVertsTotal);
+    for (int i = 0; i < numCoarseVerts; ++i) {
+        for (int k = 0; k < N; ++k) {
+            farVertices[i]._data[k] = primvarValue(shape, i, k);
+        }
+    }
+    Far::PrimvarRefiner primvarRefiner(*refiner);
+    Primvar<N> * src = &farVertices[0];
+    for (int i = 1; i <= refiner->GetMaxLevel(); ++i) {
+        Primvar<N> * dst = src + refiner->GetLevel(i - 1).GetNumVertices();
+        primvarRefiner.Interpolate(i, src, dst);
+        src = dst;
+    }
+
+    std::vector<float> reference(numVertsTotal * N);
+    for (int i = 0; i < numVertsTotal; ++i) {
+        for (int k = 0; k < N; ++k) {
+            reference[i * N + k] = farVertices[i]._data[k];
+        }
+    }
+
+    char what[64];
+    snprintf(what, sizeof(what), "CpuUniformRefiner (%d elements)", N);
+
+    if (uniformRefiner == 0 ||
+        uniformRefiner->GetNumVerticesTotal() != numVertsTotal) {
+        printf("  %s : mismatched number of vertices\n", what);
+        delete uniformRefiner;
+        delete refiner;
+        return 1;
+    }
+
+    //  Refine all levels at once, and in two separate passes:
+    Osd::BufferDescriptor desc(1, N, N + 2);
+
+    int failures = 0;
+    for (int pass = 0; pass < 2; ++pass) {
+        std::vector<float> buffer(numVertsTotal * desc.stride, -1.0f);
+        for (int i = 0; i < numCoarseVerts; ++i) {
+            for (int k = 0; k < N; ++k) {
+                buffer[desc.offset + i * desc.stride + k] =
+                    primvarValue(shape, i, k);
+            }
+        }
+        if (pass == 0) {
+            uniformRefiner->Refine(&buffer[0], desc);
+        } else {
+            uniformRefiner->Refine(&buffer[0], desc, 1, 1);
+            uniformRefiner->Refine(&buffer[0], desc, 2);
+        }
+
+        std::vector<float> result(numVertsTotal * N);
+        for (int i = 0; i < numVertsTotal; ++i) {
+            for (int k = 0; k < N; ++k) {
+                result[i * N + k] = buffer[desc.offset + i * desc.stride + k];
+            }
+        }
+        failures += compareBuffers(what, result, reference, PRECISION);
+    }
+
+    delete uniformRefiner;
+    delete refiner;
+    return failures;
+}
+
+static int
+checkUniformRefiner(Shape const & shape, int level) {
+
+    //  Primvars of 3 and 4 elements use specialized kernels:
+    return checkUniformRefiner<3>(shape, level) +
+           checkUniformRefiner<4>(shape, level) +
+           checkUniformRefiner<5>(shape, level);
+}
+
+//------------------------------------------------------------------------------
+// Double precision evaluation -- stencils from a Far::StencilTableReal<double>
+// applied to a CpuVertexBufferReal<double> are compared to the Far stencil
+// table, and limit evaluation to the double precision basis of the
+// Far::PatchTable
+template <class EVALUATOR>
+static int
+checkDoublePrecision(char const * evaluatorName, TestMesh & mesh,
+                     Far::StencilTableReal<double> const & stencilTable,
+                     std::vector<double> const & stencilReference,
+                     LimitBuffers<double> const & reference) {
+
+    typedef Osd::CpuVertexBufferReal<double> VertexBuffer;
+
+    int numCoarseVerts = mesh.numCoarseVerts;
+    int numVerts = numCoarseVerts + stencilTable.GetNumStencils();
+
+    VertexBuffer * buffer = VertexBuffer::Create(3, numVerts);
+    std::vector<double> coarseVerts(mesh.vertexData.begin(),
+                                    mesh.vertexData.begin() + numCoarseVerts * 3);
+    buffer->UpdateData(&coarseVerts[0], 0, numCoarseVerts);
+
+    Osd::BufferDescriptor srcDesc(0, 3, 3);
+    Osd::BufferDescriptor dstDesc(numCoarseVerts * 3, 3, 3);
+    EVALUATOR::EvalStencils(buffer, srcDesc, buffer, dstDesc, &stencilTable);
+
+    std::vector<double> stencilResult(buffer->BindCpuBuffer(),
+                                      buffer->BindCpuBuffer() + numVerts * 3);
+    delete buffer;
+
+    std::string what = std::string(evaluatorName) + " double";
+    int failures = compareBuffers((what + " stencils").c_str(), stencilResult,
+                                  stencilReference);
+
+    std::vector<double> vertexData(mesh.vertexData.begin(),
+                                   mesh.vertexData.end());
+    int numCoords = mesh.GetNumPatchCoords();
+
+    LimitBuffers<double> limit(numCoords, 3);
+    EVALUATOR::EvalPatches(&vertexData[0], srcDesc,
+        limit.P(),   limit.desc, limit.Du(),  limit.desc,
+        limit.Dv(),  limit.desc, limit.Duu(), limit.desc,
+        limit.Duv(), limit.desc, limit.Dvv(), limit.desc,
+        numCoords, &mesh.patchCoords[0],
+        mesh.cpuPatchTable->GetPatchArrayBuffer(),
+        mesh.cpuPatchTable->GetPatchIndexBuffer(),
+        mesh.cpuPatchTable->GetPatchParamBuffer());
+
+    LimitBuffers<double> limit1(numCoords, 3);
+    EVALUATOR::EvalPatches(&vertexData[0], srcDesc,
+        limit1.P(),  limit1.desc, limit1.Du(), limit1.desc,
+        limit1.Dv(), limit1.desc,
+        numCoords, &mesh.patchCoords[0],
+        mesh.cpuPatchTable->GetPatchArrayBuffer(),
+        mesh.cpuPatchTable->GetPatchIndexBuffer(),
+        mesh.cpuPatchTable->GetPatchParamBuffer());
+
+    LimitBuffers<double> limit0(numCoords, 3);
+    EVALUATOR::EvalPatches(&vertexData[0], srcDesc,
+        limit0.P(),  limit0.desc,
+        numCoords, &mesh.patchCoords[0],
+        mesh.cpuPatchTable->GetPatchArrayBuffer(),
+        mesh.cpuPatchTable->GetPatchIndexBuffer(),
+        mesh.cpuPatchTable->GetPatchParamBuffer());
+
+    return failures + limit.Compare(what.c_str(), reference, 6, 1e-12) +
+                      limit1.Compare(what.c_str(), reference, 3, 1e-12) +
+                      limit0.Compare(what.c_str(), reference, 1, 1e-12);
+}
+
+static int
+checkDoublePrecision(TestMesh & mesh) {
+
+    Far::StencilTableFactoryReal<double>::Options stencilOptions;
+    stencilOptions.generateOffsets = true;
+    stencilOptions.generateIntermediateLevels = true;
+
+    Far::StencilTableReal<double> const * stencilTable =
+        Far::StencilTableFactoryReal<double>::Create(*mesh.refiner,
+                                                     stencilOptions);
+    if (stencilTable->GetNumStencils() == 0) {
+        delete stencilTable;
+        return 0;
+    }
+
+    //  Far reference stencil evaluation:
+    typedef Primvar<3, double> DoubleVertex;
+
+    int numCoarseVerts = mesh.numCoarseVerts;
+    int numVerts = numCoarseVerts + stencilTable->GetNumStencils();
+
+    std::vector<double> stencilReference(numVerts * 3);
+    std::copy(mesh.vertexData.begin(),
+              mesh.vertexData.begin() + numCoarseVerts * 3,
+              stencilReference.begin());
+    DoubleVertex * vertices =
+        reinterpret_cast<DoubleVertex *>(&stencilReference[0]);
+    stencilTable->UpdateValues(vertices, vertices + numCoarseVerts);
+
+    //  Far reference limit evaluation with the double precision basis:
+    int numCoords = mesh.GetNumPatchCoords();
+    LimitBuffers<double> limit(numCoords, 3);
+    for (int i = 0; i < numCoords; ++i) {
+        Osd::PatchCoord const & coord = mesh.patchCoords[i];
+
+        double w[6][20];
+        mesh.patchTable->EvaluateBasis(coord.handle, (double)coord.s,
+            (double)coord.t, w[0], w[1], w[2], w[3], w[4], w[5]);
+
+        Far::ConstIndexArray cvs =
+            mesh.patchTable->GetPatchVertices(coord.handle);
+        for (int j = 0; j < 6; ++j) {
+            double * dst = &limit.data[j][i * 3];
+            for (int cv = 0; cv < cvs.size(); ++cv) {
+                for (int k = 0; k < 3; ++k) {
+                    dst[k] += w[j][cv] * (double)mesh.vertexData[cvs[cv] * 3 + k];
+                }
+            }
+        }
+    }
+
+    int failures = 0;
+    failures += checkDoublePrecision<Osd::CpuEvaluator>(
+        "CpuEvaluator", mesh, *stencilTable, stencilReference, limit);
+    failures += checkDoublePrecision<Osd::ThreadPoolEvaluator>(
+        "ThreadPoolEvaluator", mesh, *stencilTable, stencilReference, limit);
+#ifdef OPENSUBDIV_HAS_OPENMP
+    failures += checkDoublePrecision<Osd::OmpEvaluator>(
+        "OmpEvaluator", mesh, *stencilTable, stencilReference, limit);
+#endif
+#ifdef OPENSUBDIV_HAS_TBB
+    failures += checkDoublePrecision<Osd::TbbEvaluator>(
+        "TbbEvaluator", mesh, *stencilTable, stencilReference, limit);
+#endif
+
+    delete stencilTable;
+    return failures;
+}
+
+//------------------------------------------------------------------------------
+// Instanced evaluation compared to the serial CpuEvaluator applied to each
+// instance in turn -- the instances are scaled copies of the mesh, and the
+// stencils are applied from an offset start to exercise the output indexing
+template <class EVALUATOR>
+static int
+checkInstanced(char const * evaluatorName, TestMesh & mesh,
+               std::vector<float> const & instances, int numInstances) {
+
+    Far::StencilTable const & stencilTable = *mesh.stencilTable;
+
+    int numVerts = (int)mesh.vertexData.size() / 3;
+    int instanceStride = numVerts * 3;
+    int start = stencilTable.GetNumStencils() / 3;
+    int end = stencilTable.GetNumStencils();
+    int numStencils = end - start;
+
+    Osd::BufferDescriptor desc(0, 3, 3);
+
+    //  Stencils, with destinations of numStencils vertices per instance:
+    std::vector<float> reference(numInstances * numStencils * 3, -1.0f);
+    std::vector<float> result(reference);
+    for (int i = 0; i < numInstances; ++i) {
+        Osd::CpuEvaluator::EvalStencils(&instances[i * instanceStride], desc,
+            &reference[i * numStencils * 3], desc,
+            &stencilTable.GetSizes()[0], &stencilTable.GetOffsets()[0],
+            &stencilTable.GetControlIndices()[0], &stencilTable.GetWeights()[0],
+            start, end);
+    }
+    EVALUATOR::EvalStencilsInstanced(&instances[0], desc, instanceStride,
+        &result[0], desc, numStencils * 3, numInstances,
+        &stencilTable.GetSizes()[0], &stencilTable.GetOffsets()[0],
+        &stencilTable.GetControlIndices()[0], &stencilTable.GetWeights()[0],
+        start, end);
+
+    std::string what = std::string(evaluatorName) + " instanced";
+    int failures = compareBuffers((what + " stencils").c_str(), result,
+                                  reference);
+
+    //  Limit positions and first derivatives:
+    int numCoords = mesh.GetNumPatchCoords();
+    int dstStride = numCoords * 3;
+
+    LimitBuffers<float> limitReference(numInstances * numCoords, 3);
+    LimitBuffers<float> limit(numInstances * numCoords, 3);
+    for (int i = 0; i < numInstances; ++i) {
+        Osd::CpuEvaluator::EvalPatches(&instances[i * instanceStride], desc,
+            limitReference.P() + i * dstStride,  limitReference.desc,
+            limitReference.Du() + i * dstStride, limitReference.desc,
+            limitReference.Dv() + i * dstStride, limitReference.desc,
+            numCoords, &mesh.patchCoords[0],
+            mesh.cpuPatchTable->GetPatchArrayBuffer(),
+            mesh.cpuPatchTable->GetPatchIndexBuffer(),
+            mesh.cpuPatchTable->GetPatchParamBuffer());
+    }
+    EVALUATOR::EvalPatchesInstanced(&instances[0], desc, instanceStride,
+        limit.P(), limit.desc, limit.Du(), limit.desc, limit.Dv(), limit.desc,
+        dstStride, numInstances, numCoords, &mesh.patchCoords[0],
+        mesh.cpuPatchTable->GetPatchArrayBuffer(),
+        mesh.cpuPatchTable->GetPatchIndexBuffer(),
+        mesh.cpuPatchTable->GetPatchParamBuffer());
+
+    return failures + limit.Compare(what.c_str(), limitReference, 3);
+}
+
+static int
+checkInstanced(TestMesh & mesh) {
+
+    if (mesh.stencilTable->GetNumStencils() == 0) return 0;
+
+    //  More instances than the instance blocks of the parallel evaluators:
+    int const numInstances = 20;
+
+    std::vector<float> instances;
+    for (int i = 0; i < numInstances; ++i) {
+        float scale = 1.0f + 0.1f * (float)i;
+        for (size_t k = 0; k < mesh.vertexData.size(); ++k) {
+            instances.push_back(mesh.vertexData[k] * scale);
+        }
+    }
+
+    int failures = 0;
+    failures += checkInstanced<Osd::CpuEvaluator>(
+        "CpuEvaluator", mesh, instances, numInstances);
+    failures += checkInstanced<Osd::ThreadPoolEvaluator>(
+        "ThreadPoolEvaluator", mesh, instances, numInstances);
+#ifdef OPENSUBDIV_HAS_OPENMP
+    failures += checkInstanced<Osd::OmpEvaluator>(
+        "OmpEvaluator", mesh, instances, numInstances);
+#endif
+#ifdef OPENSUBDIV_HAS_TBB
+    failures += checkInstanced<Osd::TbbEvaluator>(
+        "TbbEvaluator", mesh, instances, numInstances);
+#endif
+    return failures;
+}
+
+//------------------------------------------------------------------------------
+// Stencil evaluation under several grain policies compared to the serial
+// CpuEvaluator -- the policies only partition the stencils, so results must
+// be bitwise identical whatever the partition
+static Osd::GrainPolicy const g_grainPolicies[] = {
+    Osd::GrainPolicy(),
+    Osd::GrainPolicy(Osd::GrainPolicy::GRAIN_FIXED, 7, 0, 0),
+    Osd::GrainPolicy(Osd::GrainPolicy::GRAIN_BALANCED, 0, 50, 0),
+    Osd::GrainPolicy(Osd::GrainPolicy::GRAIN_BALANCED, 0, 1, 0),
+};
+
+template <class EVALUATOR>
+static int
+checkGrainPolicies(char const * evaluatorName, TestMesh & mesh) {
+
+    Far::StencilTable const & stencilTable = *mesh.stencilTable;
+
+    int numCoarseVerts = mesh.numCoarseVerts;
+    int numVerts = numCoarseVerts + stencilTable.GetNumStencils();
+    int numStencils = stencilTable.GetNumStencils();
+
+    Osd::BufferDescriptor srcDesc(0, 3, 3);
+    Osd::BufferDescriptor dstDesc(numCoarseVerts * 3, 3, 3);
+
+    std::vector<float> reference(mesh.vertexData.size(), -1.0f);
+    std::copy(mesh.vertexData.begin(),
+              mesh.vertexData.begin() + numCoarseVerts * 3, reference.begin());
+    Osd::CpuEvaluator::EvalStencils(&reference[0], srcDesc,
+        &reference[0], dstDesc,
+        &stencilTable.GetSizes()[0], &stencilTable.GetOffsets()[0],
+        &stencilTable.GetControlIndices()[0], &stencilTable.GetWeights()[0],
+        0, numStencils);
+
+    int failures = 0;
+    int numPolicies = (int)(sizeof(g_grainPolicies) / sizeof(g_grainPolicies[0]));
+    for (int i = 0; i < numPolicies; ++i) {
+        char what[128];
+
+        //  Raw pointers with the policy as argument:
+        std::vector<float> result(reference.size(), -1.0f);
+        std::copy(mesh.vertexData.begin(),
+                  mesh.vertexData.begin() + numCoarseVerts * 3, result.begin());
+        EVALUATOR::EvalStencils(&result[0], srcDesc, &result[0], dstDesc,
+            &stencilTable.GetSizes()[0], &stencilTable.GetOffsets()[0],
+            &stencilTable.GetControlIndices()[0],
+            &stencilTable.GetWeights()[0], 0, numStencils, g_grainPolicies[i]);
+
+        snprintf(what, sizeof(what), "%s stencils (grain policy %d)",
+                 evaluatorName, i);
+        failures += compareBuffers(what, result, reference);
+
+        //  Vertex buffer with the policy of an evaluator instance, all
+        //  stencils:
+        EVALUATOR evaluator(g_grainPolicies[i]);
+
+        Osd::CpuVertexBuffer * buffer = Osd::CpuVertexBuffer::Create(3, numVerts);
+        buffer->UpdateData(&mesh.vertexData[0], 0, numCoarseVerts);
+        EVALUATOR::EvalStencils(buffer, srcDesc, buffer, dstDesc, &stencilTable,
+                                &evaluator);
+
+        std::vector<float> bufferResult(buffer->BindCpuBuffer(),
+                                        buffer->BindCpuBuffer() + numVerts * 3);
+        delete buffer;
+
+        snprintf(what, sizeof(what), "%s instance stencils (grain policy %d)",
+                 evaluatorName, i);
+        failures += compareBuffers(what, bufferResult, mesh.vertexData);
+    }
+    return failures;
+}
+
+static int
+checkGrainPolicies(TestMesh & mesh) {
+
+    if (mesh.stencilTable->GetNumStencils() == 0) return 0;
+
+    int failures = 0;
+    failures += checkGrainPolicies<Osd::ThreadPoolEvaluator>(
+        "ThreadPoolEvaluator", mesh);
+#ifdef OPENSUBDIV_HAS_OPENMP
+    failures += checkGrainPolicies<Osd::OmpEvaluator>("OmpEvaluator", mesh);
+#endif
+#ifdef OPENSUBDIV_HAS_TBB
+    failures += checkGrainPolicies<Osd::TbbEvaluator>("TbbEvaluator", mesh);
+#endif
+    return failures;
+}
+
+//------------------------------------------------------------------------------
+// Limit normals and tangent frames : the fused evaluation must match the
+// frames computed from the derivatives of the reference evaluation, and
+// the parallel evaluators must match the CpuEvaluator bitwise
+
+struct FrameBuffers {
+
+    explicit FrameBuffers(int numPoints) : desc(0, 3, 3) {
+        for (int i = 0; i < 4; ++i) {
+            data[i].assign(numPoints * 3, 0.0f);
+        }
+    }
+
+    float * P()         { return &data[0][0]; }
+    float * Normal()    { return &data[1][0]; }
+    float * Tangent()   { return &data[2][0]; }
+    float * Bitangent() { return &data[3][0]; }
+
+    int Compare(char const * what, FrameBuffers const & reference) const {
+        static char const * names[] = { "P", "N", "T", "B" };
+        int failures = 0;
+        for (int i = 0; i < 4; ++i) {
+            char label[128];
+            snprintf(label, sizeof(label), "%s %s", what, names[i]);
+            failures += compareBuffers(label, data[i], reference.data[i]);
+        }
+        return failures;
+    }
+
+    Osd::BufferDescriptor desc;
+    std::vector<float> data[4];
+};
+
+static void
+cross(double const a[3], double const b[3], double c[3]) {
+    c[0] = a[1] * b[2] - a[2] * b[1];
+    c[1] = a[2] * b[0] - a[0] * b[2];
+    c[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+static double
+normalize(double v[3]) {
+    double length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    if (length > 0.0) {
+        v[0] /= length; v[1] /= length; v[2] /= length;
+    }
+    return length;
+}
+
+//  Compares the frames to those computed from the derivatives where these
+//  are not degenerate, and checks that all frames are orthonormal:
+static int
+compareFrames(char const * what, FrameBuffers const & frames,
+              std::vector<float> const & du, std::vector<float> const & dv) {
+
+    double const tolerance = 1e-4;
+
+    int numPoints = (int)du.size() / 3;
+    int count = 0;
+    for (int i = 0; i < numPoints; ++i) {
+        double f[3][3], r[3][3], d[2][3];
+        for (int k = 0; k < 3; ++k) {
+            d[0][k] = du[i * 3 + k];
+            d[1][k] = dv[i * 3 + k];
+            for (int j = 0; j < 3; ++j) {
+                f[j][k] = frames.data[j + 1][i * 3 + k];
+            }
+        }
+
+        bool failed = false;
+        for (int j = 0; j < 3; ++j) {
+            double dot0 = 0.0, dot1 = 0.0;
+            for (int k = 0; k < 3; ++k) {
+                dot0 += f[j][k] * f[j][k];
+                dot1 += f[j][k] * f[(j + 1) % 3][k];
+            }
+            failed |= !(std::abs(dot0 - 1.0) < tolerance) ||
+                      !(std::abs(dot1) < tolerance);
+        }
+
+        cross(d[0], d[1], r[0]);
+        double area = normalize(r[0]);
+        if (area > 1e-3 * normalize(d[0]) * normalize(d[1])) {
+            double dot = d[0][0] * r[0][0] + d[0][1] * r[0][1] +
+                         d[0][2] * r[0][2];
+            for (int k = 0; k < 3; ++k) {
+                r[1][k] = d[0][k] - dot * r[0][k];
+            }
+            normalize(r[1]);
+            cross(r[0], r[1], r[2]);
+
+            for (int j = 0; j < 3; ++j) {
+                for (int k = 0; k < 3; ++k) {
+                    failed |= !(std::abs(f[j][k] - r[j][k]) < tolerance);
+                }
+            }
+        }
+        if (failed) {
+            if (count == 0) {
+                printf("  %s : frame %d differs\n", what, i);
+            }
+            ++count;
+        }
+    }
+    if (count) {
+        printf("  %s : %d of %d frames differ\n", what, count, numPoints);
+    }
+    return count ? 1 : 0;
+}
+
+template <class EVALUATOR>
+static void
+evalPatchesNormals(TestMesh & mesh, FrameBuffers & frames) {
+
+    Osd::BufferDescriptor srcDesc(0, 3, 3);
+
+    EVALUATOR::EvalPatchesNormals(&mesh.vertexData[0], srcDesc,
+        frames.P(),       frames.desc, frames.Normal(),    frames.desc,
+        frames.Tangent(), frames.desc, frames.Bitangent(), frames.desc,
+        mesh.GetNumPatchCoords(), &mesh.patchCoords[0],
+        mesh.cpuPatchTable->GetPatchArrayBuffer(),
+        mesh.cpuPatchTable->GetPatchIndexBuffer(),
+        mesh.cpuPatchTable->GetPatchParamBuffer());
+}
+
+template <class EVALUATOR>
+static void
+evalStencilsNormals(TestMesh & mesh, Far::LimitStencilTable const & stencils,
+                    FrameBuffers & frames) {
+
+    Osd::BufferDescriptor srcDesc(0, 3, 3);
+
+    EVALUATOR::EvalStencilsNormals(&mesh.vertexData[0], srcDesc,
+        frames.P(),       frames.desc, frames.Normal(),    frames.desc,
+        frames.Tangent(), frames.desc, frames.Bitangent(), frames.desc,
+        &stencils.GetSizes()[0], &stencils.GetOffsets()[0],
+        &stencils.GetControlIndices()[0], &stencils.GetWeights()[0],
+        &stencils.GetDuWeights()[0], &stencils.GetDvWeights()[0],
+        NULL, NULL, NULL, 0, stencils.GetNumStencils());
+}
+
+template <class EVALUATOR>
+static int
+checkNormals(char const * evaluatorName, TestMesh & mesh,
+             Far::LimitStencilTable const & stencils,
+             FrameBuffers const & patchFrames,
+             FrameBuffers const & stencilFrames) {
+
+    FrameBuffers frames(mesh.GetNumPatchCoords());
+    evalPatchesNormals<EVALUATOR>(mesh, frames);
+
+    std::string what = std::string(evaluatorName) + " patch normals";
+    int failures = frames.Compare(what.c_str(), patchFrames);
+
+    FrameBuffers limitFrames(stencils.GetNumStencils());
+    evalStencilsNormals<EVALUATOR>(mesh, stencils, limitFrames);
+
+    what = std::string(evaluatorName) + " stencil normals";
+    return failures + limitFrames.Compare(what.c_str(), stencilFrames);
+}
+
+static int
+checkNormals(TestMesh & mesh, LimitBuffers<float> const & reference) {
+
+    int numCoords = mesh.GetNumPatchCoords();
+
+    //  Patches, compared to the reference derivatives:
+    FrameBuffers patchFrames(numCoords);
+    evalPatchesNormals<Osd::CpuEvaluator>(mesh, patchFrames);
+
+    int failures = 0;
+    failures += compareBuffers("CpuEvaluator patch normals P",
+                               patchFrames.data[0], reference.data[0]);
+    failures += compareFrames("CpuEvaluator patch normals", patchFrames,
+                              reference.data[1], reference.data[2]);
+
+    //  Limit stencils at the same locations, compared to the derivatives
+    //  evaluated with the stencils:
+    std::vector<float> s(numCoords), t(numCoords);
+    Far::LimitStencilTableFactory::LocationArrayVec locations(numCoords);
+    for (int i = 0; i < numCoords; ++i) {
+        Osd::PatchCoord const & coord = mesh.patchCoords[i];
+        s[i] = coord.s;
+        t[i] = coord.t;
+        locations[i].ptexIdx =
+            mesh.patchTable->GetPatchParam(coord.handle).GetFaceId();
+        locations[i].numLocations = 1;
+        locations[i].s = &s[i];
+        locations[i].t = &t[i];
+    }
+    Far::LimitStencilTable const * stencils =
+        Far::LimitStencilTableFactory::Create(*mesh.refiner, locations);
+
+    int numStencils = stencils->GetNumStencils();
+    Osd::BufferDescriptor srcDesc(0, 3, 3), dstDesc(0, 3, 3);
+    std::vector<float> P(numStencils * 3), du(numStencils * 3),
+                       dv(numStencils * 3);
+    Osd::CpuEvaluator::EvalStencils(&mesh.vertexData[0], srcDesc,
+        &P[0], dstDesc, &du[0], dstDesc, &dv[0], dstDesc,
+        &stencils->GetSizes()[0], &stencils->GetOffsets()[0],
+        &stencils->GetControlIndices()[0], &stencils->GetWeights()[0],
+        &stencils->GetDuWeights()[0], &stencils->GetDvWeights()[0],
+        0, numStencils);
+
+    FrameBuffers stencilFrames(numStencils);
+    evalStencilsNormals<Osd::CpuEvaluator>(mesh, *stencils, stencilFrames);
+
+    failures += compareBuffers("CpuEvaluator stencil normals P",
+                               stencilFrames.data[0], P);
+    failures += compareFrames("CpuEvaluator stencil normals", stencilFrames,
+                              du, dv);
+
+    failures += checkNormals<Osd::ThreadPoolEvaluator>("ThreadPoolEvaluator",
+        mesh, *stencils, patchFrames, stencilFrames);
+#ifdef OPENSUBDIV_HAS_OPENMP
+    failures += checkNormals<Osd::OmpEvaluator>("OmpEvaluator",
+        mesh, *stencils, patchFrames, stencilFrames);
+#endif
+#ifdef OPENSUBDIV_HAS_TBB
+    failures += checkNormals<Osd::TbbEvaluator>("TbbEvaluator",
+        mesh, *stencils, patchFrames, stencilFrames);
+#endif
+
+    delete stencils;
+    return failures;
+}
+
+//------------------------------------------------------------------------------
+// Incremental evaluation : the stencils gathered by StencilDependencyMap
+// must be those found by a scan of the table, and their evaluation must
+// update the results of a full evaluation bitwise
+
+static std::vector<Far::Index>
+scanDependentStencils(Far::StencilTable const & stencilTable,
+                      std::vector<Far::Index> const & sources) {
+
+    //  Stencils only refer to the results of earlier stencils, so a single
+    //  scan in order finds all of the dependencies:
+    int numControlVerts = stencilTable.GetNumControlVertices();
+    int numStencils = stencilTable.GetNumStencils();
+
+    std::vector<bool> changed(numControlVerts + numStencils, false);
+    for (int i = 0; i < (int)sources.size(); ++i) {
+        changed[sources[i]] = true;
+    }
+
+    std::vector<Far::Index> dependents;
+    for (int s = 0; s < numStencils; ++s) {
+        Far::Stencil stencil = stencilTable.GetStencil(s);
+        for (int j = 0; j < stencil.GetSize(); ++j) {
+            if (changed[stencil.GetVertexIndices()[j]]) {
+                changed[numControlVerts + s] = true;
+                dependents.push_back(s);
+                break;
+            }
+        }
+    }
+    return dependents;
+}
+
+static void
+evalAllStencils(Far::StencilTable const & stencilTable,
+                std::vector<float> & vertexData) {
+
+    Osd::BufferDescriptor srcDesc(0, 3, 3);
+    Osd::BufferDescriptor dstDesc(stencilTable.GetNumControlVertices() * 3, 3, 3);
+
+    Osd::CpuEvaluator::EvalStencils(&vertexData[0], srcDesc,
+        &vertexData[0], dstDesc,
+        &stencilTable.GetSizes()[0], &stencilTable.GetOffsets()[0],
+        &stencilTable.GetControlIndices()[0], &stencilTable.GetWeights()[0],
+        0, stencilTable.GetNumStencils());
+}
+
+template <class EVALUATOR>
+static int
+checkStencilsSubset(char const * evaluatorName,
+                    Far::StencilTable const & stencilTable,
+                    std::vector<float> const & vertexData,
+                    std::vector<float> const & changedData,
+                    std::vector<float> const & reference,
+                    std::vector<Far::Index> const & dependents) {
+
+    int numControlVerts = stencilTable.GetNumControlVertices();
+
+    Osd::BufferDescriptor srcDesc(0, 3, 3);
+    Osd::BufferDescriptor dstDesc(numControlVerts * 3, 3, 3);
+
+    //  The previous results, with the changed control vertices:
+    std::vector<float> result(vertexData);
+    std::copy(changedData.begin(), changedData.begin() + numControlVerts * 3,
+              result.begin());
+
+    EVALUATOR::EvalStencilsSubset(&result[0], srcDesc, &result[0], dstDesc,
+        &stencilTable.GetSizes()[0], &stencilTable.GetOffsets()[0],
+        &stencilTable.GetControlIndices()[0], &stencilTable.GetWeights()[0],
+        (int)dependents.size(), dependents.empty() ? 0 : &dependents[0]);
+
+    char what[64];
+    snprintf(what, sizeof(what), "%s stencils subset", evaluatorName);
+    return compareBuffers(what, result, reference);
+}
+
+static int
+checkStencilsSubset(Far::StencilTable const & stencilTable,
+                    std::vector<float> const & coarseData, bool parallel) {
+
+    int numControlVerts = stencilTable.GetNumControlVertices();
+    int numVerts = numControlVerts + stencilTable.GetNumStencils();
+
+    std::vector<float> vertexData(numVerts * 3, 0.0f);
+    std::copy(coarseData.begin(), coarseData.begin() + numControlVerts * 3,
+              vertexData.begin());
+    evalAllStencils(stencilTable, vertexData);
+
+    Far::StencilDependencyMap dependencyMap(stencilTable);
+
+    int failures = 0;
+
+    //  A single control vertex, and every fifth one:
+    std::vector<Far::Index> sourceSets[2];
+    sourceSets[0].push_back(numControlVerts / 2);
+    for (int i = 0; i < numControlVerts; i += 5) {
+        sourceSets[1].push_back(i);
+    }
+
+    for (int set = 0; set < 2; ++set) {
+        std::vector<Far::Index> const & sources = sourceSets[set];
+
+        std::vector<Far::Index> dependents;
+        dependencyMap.GetDependentStencils(
+            Far::ConstIndexArray(&sources[0], (int)sources.size()), dependents);
+
+        if (dependents != scanDependentStencils(stencilTable, sources)) {
+            printf("  failure : StencilDependencyMap : %d dependent stencils "
+                   "differ from those of the table\n", (int)dependents.size());
+            ++failures;
+            continue;
+        }
+
+        std::vector<float> changedData(vertexData);
+        for (int i = 0; i < (int)sources.size(); ++i) {
+            for (int k = 0; k < 3; ++k) {
+                changedData[sources[i] * 3 + k] += 0.25f * (float)(k + 1);
+            }
+        }
+        std::vector<float> reference(changedData);
+        evalAllStencils(stencilTable, reference);
+
+        failures += checkStencilsSubset<Osd::CpuEvaluator>("CpuEvaluator",
+            stencilTable, vertexData, changedData, reference, dependents);
+
+        //  Stencils referring to others are evaluated serially:
+        if (!parallel) continue;
+
+        failures += checkStencilsSubset<Osd::ThreadPoolEvaluator>(
+            "ThreadPoolEvaluator",
+            stencilTable, vertexData, changedData, reference, dependents);
+#ifdef OPENSUBDIV_HAS_OPENMP
+        failures += checkStencilsSubset<Osd::OmpEvaluator>("OmpEvaluator",
+            stencilTable, vertexData, changedData, reference, dependents);
+#endif
+#ifdef OPENSUBDIV_HAS_TBB
+        failures += checkStencilsSubset<Osd::TbbEvaluator>("TbbEvaluator",
+            stencilTable, vertexData, changedData, reference, dependents);
+#endif
+    }
+    return failures;
+}
+
+static int
+checkStencilsSubset(TestMesh & mesh) {
+
+    if (mesh.stencilTable->GetNumStencils() == 0) return 0;
+
+    int failures = checkStencilsSubset(*mesh.stencilTable, mesh.vertexData,
+                                       true);
+
+    //  Intermediate levels which are not factorized refer to the results
+    //  of the stencils of the previous level:
+    Far::StencilTableFactory::Options options;
+    options.generateOffsets = true;
+    options.generateIntermediateLevels = true;
+    options.factorizeIntermediateLevels = false;
+
+    Far::StencilTable const * stencilTable =
+        Far::StencilTableFactory::Create(*mesh.refiner, options);
+    failures += checkStencilsSubset(*stencilTable, mesh.vertexData, false);
+    delete stencilTable;
+
+    return failures;
+}
+
+//------------------------------------------------------------------------------
+// Packed output : the decoded elements must match the float evaluation to
+// the precision of their encoding, and the parallel evaluators must match
+// the CpuEvaluator bitwise
+
+typedef Osd::PackedBufferDescriptor PackedDesc;
+
+static float
+halfToFloat(unsigned short h) {
+
+    int exponent = (h >> 10) & 0x1f;
+    int mantissa = h & 0x3ff;
+
+    float value;
+    if (exponent == 0) {
+        value = std::ldexp((float)mantissa, -24);
+    } else if (exponent == 31) {
+        value = mantissa ? NAN : INFINITY;
+    } else {
+        value = std::ldexp((float)(mantissa | 0x400), exponent - 25);
+    }
+    return (h & 0x8000) ? -value : value;
+}
+
+static void
+octahedralDecode(short const encoded[2], float v[3]) {
+
+    float x = std::max(-1.0f, (float)encoded[0] / 32767.0f);
+    float y = std::max(-1.0f, (float)encoded[1] / 32767.0f);
+    float z = 1.0f - std::abs(x) - std::abs(y);
+    if (z < 0.0f) {
+        float ox = (1.0f - std::abs(y)) * ((x >= 0.0f) ? 1.0f : -1.0f);
+        float oy = (1.0f - std::abs(x)) * ((y >= 0.0f) ? 1.0f : -1.0f);
+        x = ox;
+        y = oy;
+    }
+    double n[3] = { x, y, z };
+    normalize(n);
+    for (int k = 0; k < 3; ++k) v[k] = (float)n[k];
+}
+
+//  Decodes the elements of a packed buffer to floats:
+static std::vector<float>
+decodePacked(std::vector<unsigned char> const & buffer, PackedDesc const & desc,
+             int numElements) {
+
+    std::vector<float> result(numElements * desc.length);
+    for (int i = 0; i < numElements; ++i) {
+        unsigned char const * e = &buffer[desc.offset + i * desc.stride];
+        float * v = &result[i * desc.length];
+
+        switch (desc.format) {
+        case PackedDesc::FORMAT_FLOAT:
+            memcpy(v, e, desc.length * sizeof(float));
+            break;
+        case PackedDesc::FORMAT_HALF:
+            for (int k = 0; k < desc.length; ++k) {
+                unsigned short h;
+                memcpy(&h, e + k * sizeof(h), sizeof(h));
+                v[k] = halfToFloat(h);
+            }
+            break;
+        case PackedDesc::FORMAT_SNORM16:
+            for (int k = 0; k < desc.length; ++k) {
+                short s;
+                memcpy(&s, e + k * sizeof(s), sizeof(s));
+                v[k] = std::max(-1.0f, (float)s / 32767.0f);
+            }
+            break;
+        case PackedDesc::FORMAT_UNORM16:
+            for (int k = 0; k < desc.length; ++k) {
+                unsigned short u;
+                memcpy(&u, e + k * sizeof(u), sizeof(u));
+                v[k] = (float)u / 65535.0f;
+            }
+            break;
+        case PackedDesc::FORMAT_OCT16: {
+                short s[2];
+                memcpy(s, e, sizeof(s));
+                octahedralDecode(s, v);
+            } break;
+        }
+    }
+    return result;
+}
+
+//  The float elements mapped by the transform of a descriptor:
+static std::vector<float>
+transformElements(std::vector<float> const & values, PackedDesc const & desc) {
+
+    std::vector<float> result(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        int k = (int)(i % desc.length);
+        result[i] = (values[i] - desc.origin[k]) * desc.scale[k];
+    }
+    return result;
+}
+
+//  Tolerance of an encoding, relative to values greater than 1 -- rounding
+//  to nearest is within half of the quantization step:
+static double
+encodingTolerance(PackedDesc::Format format) {
+
+    switch (format) {
+    case PackedDesc::FORMAT_HALF:    return 1.01 / 2048.0;
+    case PackedDesc::FORMAT_SNORM16: return 0.51 / 32767.0;
+    case PackedDesc::FORMAT_UNORM16: return 0.51 / 65535.0;
+    case PackedDesc::FORMAT_OCT16:   return 1e-4;
+    default:                         return 0.0;
+    }
+}
+
+//  Interleaved descriptors of three element positions, each of the formats
+//  with a transform mapping to their range:
+static std::vector<PackedDesc>
+packedPositionDescs(std::vector<float> const & positions) {
+
+    float lo[4] = { 0, 0, 0, 0 }, hi[4] = { 0, 0, 0, 0 };
+    for (size_t i = 0; i < positions.size(); ++i) {
+        int k = (int)(i % 3);
+        lo[k] = (i < 3) ? positions[i] : std::min(lo[k], positions[i]);
+        hi[k] = (i < 3) ? positions[i] : std::max(hi[k], positions[i]);
+    }
+
+    float center[4] = { 0, 0, 0, 0 }, half[4] = { 0.5f, 0.5f, 0.5f, 0.5f },
+          snormScale[4] = { 1, 1, 1, 1 }, unormScale[4] = { 1, 1, 1, 1 };
+    for (int k = 0; k < 3; ++k) {
+        float extent = hi[k] - lo[k];
+        center[k] = 0.5f * (lo[k] + hi[k]);
+        if (extent > 0.0f) {
+            snormScale[k] = 2.0f / extent;
+            unormScale[k] = 1.0f / extent;
+        }
+    }
+
+    //  FLOAT, HALF, SNORM16 and UNORM16 in a stride of 32 bytes:
+    int const stride = 32;
+
+    std::vector<PackedDesc> descs;
+    descs.push_back(PackedDesc(0,  3, stride, PackedDesc::FORMAT_FLOAT));
+    descs.back().SetTransform(center, half);
+    descs.push_back(PackedDesc(12, 3, stride, PackedDesc::FORMAT_HALF));
+    descs.push_back(PackedDesc(18, 3, stride, PackedDesc::FORMAT_SNORM16));
+    descs.back().SetTransform(center, snormScale);
+    descs.push_back(PackedDesc(24, 3, stride, PackedDesc::FORMAT_UNORM16));
+    descs.back().SetTransform(lo, unormScale);
+    return descs;
+}
+
+template <class EVALUATOR>
+static void
+evalStencilsPacked(Far::StencilTable const & stencils,
+                   std::vector<float> const & vertexData,
+                   std::vector<PackedDesc> const & descs, int start, int end,
+                   std::vector<unsigned char> & buffer) {
+
+    Osd::BufferDescriptor srcDesc(0, 3, 3);
+
+    buffer.assign((end - start) * descs[0].stride, 0);
+    for (int i = 0; i < (int)descs.size(); ++i) {
+        EVALUATOR::EvalStencilsPacked(&vertexData[0], srcDesc,
+            &buffer[0], descs[i],
+            &stencils.GetSizes()[0], &stencils.GetOffsets()[0],
+            &stencils.GetControlIndices()[0], &stencils.GetWeights()[0],
+            start, end);
+    }
+}
+
+template <class EVALUATOR>
+static void
+evalPatchesPacked(TestMesh & mesh, PackedDesc const & dstDesc,
+                  PackedDesc const & normalDesc,
+                  std::vector<unsigned char> & buffer) {
+
+    Osd::BufferDescriptor srcDesc(0, 3, 3);
+
+    buffer.assign(mesh.GetNumPatchCoords() * dstDesc.stride, 0);
+    EVALUATOR::EvalPatchesPacked(&mesh.vertexData[0], srcDesc,
+        &buffer[0], dstDesc, &buffer[0], normalDesc,
+        mesh.GetNumPatchCoords(), &mesh.patchCoords[0],
+        mesh.cpuPatchTable->GetPatchArrayBuffer(),
+        mesh.cpuPatchTable->GetPatchIndexBuffer(),
+        mesh.cpuPatchTable->GetPatchParamBuffer());
+}
+
+static int
+compareBytes(char const * what, std::vector<unsigned char> const & result,
+             std::vector<unsigned char> const & reference) {
+
+    if (result.size() != reference.size() ||
+        memcmp(&result[0], &reference[0], result.size()) != 0) {
+        printf("  %s : packed buffers differ\n", what);
+        return 1;
+    }
+    return 0;
+}
+
+template <class EVALUATOR>
+static int
+checkPacked(char const * evaluatorName, TestMesh & mesh,
+            std::vector<PackedDesc> const & descs,
+            std::vector<unsigned char> const & stencilBuffer,
+            std::vector<unsigned char> const & rangeBuffer,
+            PackedDesc const & dstDesc, PackedDesc const & normalDesc,
+            std::vector<unsigned char> const & patchBuffer) {
+
+    Far::StencilTable const & stencils = *mesh.stencilTable;
+    int numStencils = stencils.GetNumStencils();
+
+    std::vector<unsigned char> buffer;
+    evalStencilsPacked<EVALUATOR>(stencils, mesh.vertexData, descs,
+                                  0, numStencils, buffer);
+
+    std::string what = std::string(evaluatorName) + " packed stencils";
+    int failures = compareBytes(what.c_str(), buffer, stencilBuffer);
+
+    evalStencilsPacked<EVALUATOR>(stencils, mesh.vertexData, descs,
+                                  numStencils / 3, numStencils, buffer);
+
+    what = std::string(evaluatorName) + " packed stencils range";
+    failures += compareBytes(what.c_str(), buffer, rangeBuffer);
+
+    evalPatchesPacked<EVALUATOR>(mesh, dstDesc, normalDesc, buffer);
+
+    what = std::string(evaluatorName) + " packed patches";
+    return failures + compareBytes(what.c_str(), buffer, patchBuffer);
+}
+
+static int
+checkPacked(TestMesh & mesh, LimitBuffers<float> const & reference) {
+
+    Far::StencilTable const & stencils = *mesh.stencilTable;
+    int numStencils = stencils.GetNumStencils();
+
+    int failures = 0;
+
+    //  Stencils, compared to the float evaluation:
+    std::vector<unsigned char> stencilBuffer, rangeBuffer;
+    std::vector<PackedDesc> descs;
+    if (numStencils > 0) {
+        std::vector<float> vertexData(mesh.vertexData);
+        evalAllStencils(stencils, vertexData);
+
+        std::vector<float> values(vertexData.begin() + mesh.numCoarseVerts * 3,
+                                  vertexData.end());
+
+        descs = packedPositionDescs(values);
+        evalStencilsPacked<Osd::CpuEvaluator>(stencils, mesh.vertexData, descs,
+                                              0, numStencils, stencilBuffer);
+
+        for (int i = 0; i < (int)descs.size(); ++i) {
+            static char const * formats[] = {
+                "FLOAT", "HALF", "SNORM16", "UNORM16", "OCT16" };
+            char what[64];
+            snprintf(what, sizeof(what), "CpuEvaluator packed stencils %s",
+                     formats[descs[i].format]);
+            failures += compareBuffers(what,
+                decodePacked(stencilBuffer, descs[i], numStencils),
+                transformElements(values, descs[i]),
+                encodingTolerance(descs[i].format));
+        }
+
+        //  Outputs are relative to the first stencil evaluated:
+        int start = numStencils / 3;
+        evalStencilsPacked<Osd::CpuEvaluator>(stencils, mesh.vertexData, descs,
+                                              start, numStencils, rangeBuffer);
+        std::vector<unsigned char> expected(
+            stencilBuffer.begin() + start * descs[0].stride,
+            stencilBuffer.end());
+        failures += compareBytes("CpuEvaluator packed stencils range",
+                                 rangeBuffer, expected);
+    }
+
+    //  Patches with octahedral normals interleaved, compared to the float
+    //  evaluation and to the normals of EvalPatchesNormals():
+    int numCoords = mesh.GetNumPatchCoords();
+
+    PackedDesc dstDesc(0, 3, 16, PackedDesc::FORMAT_FLOAT);
+    PackedDesc normalDesc(12, 3, 16, PackedDesc::FORMAT_OCT16);
+
+    std::vector<unsigned char> patchBuffer;
+    evalPatchesPacked<Osd::CpuEvaluator>(mesh, dstDesc, normalDesc,
+                                         patchBuffer);
+
+    FrameBuffers frames(numCoords);
+    evalPatchesNormals<Osd::CpuEvaluator>(mesh, frames);
+
+    failures += compareBuffers("CpuEvaluator packed patches P",
+        decodePacked(patchBuffer, dstDesc, numCoords), reference.data[0]);
+    failures += compareBuffers("CpuEvaluator packed patches N",
+        decodePacked(patchBuffer, normalDesc, numCoords), frames.data[1],
+        encodingTolerance(PackedDesc::FORMAT_OCT16));
+
+    if (numStencils == 0) return failures;
+
+    failures += checkPacked<Osd::ThreadPoolEvaluator>("ThreadPoolEvaluator",
+        mesh, descs, stencilBuffer, rangeBuffer,
+        dstDesc, normalDesc, patchBuffer);
+#ifdef OPENSUBDIV_HAS_OPENMP
+    failures += checkPacked<Osd::OmpEvaluator>("OmpEvaluator",
+        mesh, descs, stencilBuffer, rangeBuffer,
+        dstDesc, normalDesc, patchBuffer);
+#endif
+#ifdef OPENSUBDIV_HAS_TBB
+    failures += checkPacked<Osd::TbbEvaluator>("TbbEvaluator",
+        mesh, descs, stencilBuffer, rangeBuffer,
+        dstDesc, normalDesc, patchBuffer);
+#endif
+    return failures;
+}
+
+//------------------------------------------------------------------------------
+// PatchBVH : hits must match those found by brute force on a dense
+// tessellation of the limit surface and lie on the limit surface, and the
+// stream of rays must match the single rays
+
+static double
+dot(double const a[3], double const b[3]) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+//  Triangles of the limit surface evaluated on a grid of each ptex face:
+struct LimitTessellation {
+
+    LimitTessellation(TestMesh & mesh, int resolution);
+
+    int GetNumTriangles() const { return (int)triangles.size() / 3; }
+
+    bool Intersect(double const origin[3], double const direction[3],
+                   double tMin, double tMax, double * tHit) const;
+
+    double FindDistance(double const point[3]) const;
+
+    std::vector<float> points;
+    std::vector<int>   triangles;
+    std::vector<double> spheres;    // center and radius of each triangle
+    double             diagonal;
+};
+
+LimitTessellation::LimitTessellation(TestMesh & mesh, int resolution) {
+
+    bool triFaces = (mesh.refiner->GetSchemeType() == Sdc::SCHEME_LOOP);
+
+    Far::PatchMap patchMap(*mesh.patchTable);
+
+    //  Grid vertices of each face (triangular faces use the lower half)
+    //  and their patch coordinates -- no patches are found for holes:
+    int n = resolution;
+    int numFaceVerts = (n + 1) * (n + 1);
+    int numPtexFaces = Far::PtexIndices(*mesh.refiner).GetNumFaces();
+
+    std::vector<int> vertIndices(numPtexFaces * numFaceVerts, -1);
+    std::vector<Osd::PatchCoord> coords;
+    for (int face = 0; face < numPtexFaces; ++face) {
+        for (int j = 0; j <= n; ++j) {
+            for (int i = 0; i <= n; ++i) {
+                if (triFaces && (i + j > n)) continue;
+
+                float s = (float)i / (float)n;
+                float t = (float)j / (float)n;
+                if (Far::PatchTable::PatchHandle const * handle =
+                    patchMap.FindPatch(face, s, t)) {
+                    vertIndices[face * numFaceVerts + j * (n + 1) + i] =
+                        (int)coords.size();
+                    coords.push_back(Osd::PatchCoord(*handle, s, t));
+                }
+            }
+        }
+    }
+
+    points.resize(coords.size() * 3);
+    Osd::BufferDescriptor srcDesc(0, 3, 3), dstDesc(0, 3, 3);
+    Osd::CpuEvaluator::EvalPatches(&mesh.vertexData[0], srcDesc,
+        &points[0], dstDesc, (int)coords.size(), &coords[0],
+        mesh.cpuPatchTable->GetPatchArrayBuffer(),
+        mesh.cpuPatchTable->GetPatchIndexBuffer(),
+        mesh.cpuPatchTable->GetPatchParamBuffer());
+
+    for (int face = 0; face < numPtexFaces; ++face) {
+        int const * v = &vertIndices[face * numFaceVerts];
+        for (int j = 0; j < n; ++j) {
+            for (int i = 0; i < n; ++i) {
+                int v00 = v[j * (n + 1) + i],     v10 = v[j * (n + 1) + i + 1],
+                    v01 = v[(j + 1) * (n + 1) + i];
+                int v11 = (triFaces && (i + j + 1 >= n)) ? -1 :
+                          v[(j + 1) * (n + 1) + i + 1];
+                if (triFaces && (i + j >= n)) continue;
+
+                if ((v00 >= 0) && (v10 >= 0) && (v01 >= 0)) {
+                    triangles.push_back(v00);
+                    triangles.push_back(v10);
+                    triangles.push_back(v01);
+                }
+                if ((v10 >= 0) && (v11 >= 0) && (v01 >= 0)) {
+                    triangles.push_back(v10);
+                    triangles.push_back(v11);
+                    triangles.push_back(v01);
+                }
+            }
+        }
+    }
+
+    double lower[3] = {  1e30,  1e30,  1e30 };
+    double upper[3] = { -1e30, -1e30, -1e30 };
+    for (size_t i = 0; i < points.size(); ++i) {
+        lower[i % 3] = std::min(lower[i % 3], (double)points[i]);
+        upper[i % 3] = std::max(upper[i % 3], (double)points[i]);
+    }
+    double d[3] = { upper[0] - lower[0], upper[1] - lower[1],
+                    upper[2] - lower[2] };
+    diagonal = points.empty() ? 0.0 : normalize(d);
+
+    spheres.resize(GetNumTriangles() * 4);
+    for (int tri = 0; tri < GetNumTriangles(); ++tri) {
+        double * sphere = &spheres[tri * 4];
+        for (int k = 0; k < 3; ++k) {
+            sphere[k] = (points[triangles[3 * tri + 0] * 3 + k] +
+                         points[triangles[3 * tri + 1] * 3 + k] +
+                         points[triangles[3 * tri + 2] * 3 + k]) / 3.0;
+        }
+        sphere[3] = 0.0;
+        for (int j = 0; j < 3; ++j) {
+            double r[3];
+            for (int k = 0; k < 3; ++k) {
+                r[k] = points[triangles[3 * tri + j] * 3 + k] - sphere[k];
+            }
+            sphere[3] = std::max(sphere[3], std::sqrt(dot(r, r)));
+        }
+    }
+}
+
+//  Nearest intersection with all triangles (Moller-Trumbore):
+bool
+LimitTessellation::Intersect(double const origin[3],
+                             double const direction[3],
+                             double tMin, double tMax, double * tHit) const {
+
+    bool found = false;
+    for (int tri = 0; tri < GetNumTriangles(); ++tri) {
+        double p[3][3];
+        for (int j = 0; j < 3; ++j) {
+            for (int k = 0; k < 3; ++k) {
+                p[j][k] = points[triangles[3 * tri + j] * 3 + k];
+            }
+        }
+        double e1[3], e2[3], s[3], h[3], q[3];
+        for (int k = 0; k < 3; ++k) {
+            e1[k] = p[1][k] - p[0][k];
+            e2[k] = p[2][k] - p[0][k];
+            s[k]  = origin[k] - p[0][k];
+        }
+        cross(direction, e2, h);
+        double det = e1[0] * h[0] + e1[1] * h[1] + e1[2] * h[2];
+        if (det == 0.0) continue;
+
+        double u = (s[0] * h[0] + s[1] * h[1] + s[2] * h[2]) / det;
+        if ((u < 0.0) || (u > 1.0)) continue;
+
+        cross(s, e1, q);
+        double v = (direction[0] * q[0] + direction[1] * q[1] +
+                    direction[2] * q[2]) / det;
+        if ((v < 0.0) || (u + v > 1.0)) continue;
+
+        double t = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) / det;
+        if ((t >= tMin) && (t <= tMax)) {
+            tMax  = t;
+            found = true;
+        }
+    }
+    *tHit = tMax;
+    return found;
+}
+
+//  Distance to the nearest point of all triangles (from the regions of
+//  the plane of each triangle nearest its vertices, edges and interior):
+double
+LimitTessellation::FindDistance(double const point[3]) const {
+
+    //  The nearest vertex bounds the distance of the triangles to visit:
+    double minDistance = 1e30;
+    for (int i = 0; i < (int)points.size(); i += 3) {
+        double d[3] = { points[i] - point[0], points[i + 1] - point[1],
+                        points[i + 2] - point[2] };
+        minDistance = std::min(minDistance, dot(d, d));
+    }
+    minDistance = std::sqrt(minDistance);
+
+    for (int tri = 0; tri < GetNumTriangles(); ++tri) {
+        //  Skip triangles entirely farther than the nearest point so far:
+        double const * sphere = &spheres[tri * 4];
+        double dc[3] = { point[0] - sphere[0], point[1] - sphere[1],
+                         point[2] - sphere[2] };
+        double reach = minDistance + sphere[3];
+        if (dot(dc, dc) > reach * reach) continue;
+
+        double a[3], b[3], c[3];
+        for (int k = 0; k < 3; ++k) {
+            a[k] = points[triangles[3 * tri + 0] * 3 + k];
+            b[k] = points[triangles[3 * tri + 1] * 3 + k];
+            c[k] = points[triangles[3 * tri + 2] * 3 + k];
+        }
+        double ab[3], ac[3], ap[3], bp[3], cp[3];
+        for (int k = 0; k < 3; ++k) {
+            ab[k] = b[k] - a[k];
+            ac[k] = c[k] - a[k];
+            ap[k] = point[k] - a[k];
+            bp[k] = point[k] - b[k];
+            cp[k] = point[k] - c[k];
+        }
+
+        double d1 = dot(ab, ap), d2 = dot(ac, ap);
+        double d3 = dot(ab, bp), d4 = dot(ac, bp);
+        double d5 = dot(ab, cp), d6 = dot(ac, cp);
+
+        double va = d3 * d6 - d5 * d4;
+        double vb = d5 * d2 - d1 * d6;
+        double vc = d1 * d4 - d3 * d2;
+
+        //  Weights of b and c of the nearest point:
+        double v, w;
+        if ((d1 <= 0.0) && (d2 <= 0.0)) {
+            v = 0.0, w = 0.0;
+        } else if ((d3 >= 0.0) && (d4 <= d3)) {
+            v = 1.0, w = 0.0;
+        } else if ((d6 >= 0.0) && (d5 <= d6)) {
+            v = 0.0, w = 1.0;
+        } else if ((vc <= 0.0) && (d1 >= 0.0) && (d3 <= 0.0)) {
+            v = d1 / (d1 - d3), w = 0.0;
+        } else if ((vb <= 0.0) && (d2 >= 0.0) && (d6 <= 0.0)) {
+            v = 0.0, w = d2 / (d2 - d6);
+        } else if ((va <= 0.0) && (d4 >= d3) && (d5 >= d6)) {
+            w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+            v = 1.0 - w;
+        } else {
+            v = vb / (va + vb + vc);
+            w = vc / (va + vb + vc);
+        }
+        double d[3];
+        for (int k = 0; k < 3; ++k) {
+            d[k] = ap[k] - v * ab[k] - w * ac[k];
+        }
+        minDistance = std::min(minDistance, normalize(d));
+    }
+    return minDistance;
+}
+
+static int
+checkPatchBVH(char const * what, TestMesh & mesh,
+              LimitTessellation const & tessellation,
+              std::vector<Osd::PatchBVH::Ray> const & rays, int numTargets,
+              Osd::PatchBVH::Options const & options) {
+
+    Osd::PatchBVH * bvh = Osd::PatchBVH::Create(*mesh.patchTable,
+        &mesh.vertexData[0], 3, options);
+
+    int numRays = (int)rays.size();
+
+    //  The tessellation deviates from the limit surface by much less than
+    //  the tolerance of the distance to its hits:
+    double const hitTolerance   = 1e-3 * tessellation.diagonal;
+    double const pointTolerance = 1e-4 * tessellation.diagonal;
+
+    std::vector<Osd::PatchBVH::Hit> hits(numRays);
+    std::vector<Osd::PatchCoord>    hitCoords;
+    std::vector<int>                hitRays;
+
+    int failures = 0;
+    for (int i = 0; i < numRays; ++i) {
+        Osd::PatchBVH::Ray const & ray = rays[i];
+        Osd::PatchBVH::Hit & hit = hits[i];
+
+        double origin[3], direction[3];
+        for (int k = 0; k < 3; ++k) {
+            origin[k]    = ray.origin[k];
+            direction[k] = ray.direction[k];
+        }
+        double length = normalize(direction);
+
+        double tRef;
+        bool hitRef = tessellation.Intersect(origin, direction,
+            ray.tMin * length, ray.tMax * length, &tRef);
+
+        //  Rays must hit the surface no farther than the target and than
+        //  the nearest hit of the tessellation (which misses some grazing
+        //  hits, so other hits are only required to be on the surface):
+        bool found = bvh->Intersect(ray, &hit);
+        if (!found && (hitRef || (i < numTargets))) {
+            printf("  %s : ray %d misses the surface\n", what, i);
+            ++failures;
+            continue;
+        }
+        if (!found) continue;
+
+        double tExpected = (i < numTargets) ? std::min(tRef, length) : tRef;
+        if (hit.t * length > tExpected + hitTolerance) {
+            printf("  %s : ray %d hits at distance %g (%g expected)\n",
+                   what, i, hit.t * length, tExpected);
+            ++failures;
+        }
+        if (mesh.patchTable->GetPatchParam(hit.handle).GetFaceId() !=
+            hit.faceId) {
+            printf("  %s : ray %d hits face %d of another patch\n",
+                   what, i, hit.faceId);
+            ++failures;
+        }
+        hitCoords.push_back(Osd::PatchCoord(hit.handle, hit.u, hit.v));
+        hitRays.push_back(i);
+    }
+
+    //  The limit surface evaluated at the hits is on the rays:
+    if (!hitCoords.empty()) {
+        std::vector<float> P(hitCoords.size() * 3);
+        Osd::BufferDescriptor srcDesc(0, 3, 3), dstDesc(0, 3, 3);
+        Osd::CpuEvaluator::EvalPatches(&mesh.vertexData[0], srcDesc,
+            &P[0], dstDesc, (int)hitCoords.size(), &hitCoords[0],
+            mesh.cpuPatchTable->GetPatchArrayBuffer(),
+            mesh.cpuPatchTable->GetPatchIndexBuffer(),
+            mesh.cpuPatchTable->GetPatchParamBuffer());
+
+        for (int i = 0; i < (int)hitRays.size(); ++i) {
+            Osd::PatchBVH::Ray const & ray = rays[hitRays[i]];
+            double d[3];
+            for (int k = 0; k < 3; ++k) {
+                d[k] = P[i * 3 + k] - (ray.origin[k] +
+                       hits[hitRays[i]].t * ray.direction[k]);
+            }
+            if (normalize(d) > pointTolerance) {
+                printf("  %s : hit of ray %d is not on the surface\n",
+                       what, hitRays[i]);
+                ++failures;
+            }
+        }
+    }
+
+    //  Streams of rays, serially and over the thread pool:
+    for (int pass = 0; pass < 2; ++pass) {
+        std::vector<Osd::PatchBVH::Hit> streamHits(numRays);
+        int numHits = bvh->IntersectStream(numRays, &rays[0], &streamHits[0],
+            pass ? options.threadPool : 0);
+
+        int count = 0, numExpected = 0;
+        for (int i = 0; i < numRays; ++i) {
+            numExpected += hits[i].IsValid();
+            if ((streamHits[i].IsValid() != hits[i].IsValid()) ||
+                (std::abs(streamHits[i].t - hits[i].t) >
+                 1e-5f * std::max(1.0f, hits[i].t))) {
+                ++count;
+            }
+        }
+        if (count || (numHits != numExpected)) {
+            printf("  %s : %d of %d hits of the stream differ\n",
+                   what, count, numRays);
+            ++failures;
+        }
+    }
+
+    delete bvh;
+    return failures;
+}
+
+//  Closest points must be as close as the nearest point of the
+//  tessellation (at the given distances), lie on the limit surface, and
+//  the stream of points must match the single points:
+static int
+checkPatchBVHClosest(char const * what, TestMesh & mesh,
+                     LimitTessellation const & tessellation,
+                     std::vector<float> const & points,
+                     std::vector<double> const & distances,
+                     float maxDistance,
+                     Osd::PatchBVH::Options const & options) {
+
+    Osd::PatchBVH * bvh = Osd::PatchBVH::Create(*mesh.patchTable,
+        &mesh.vertexData[0], 3, options);
+
+    int numPoints = (int)points.size() / 3;
+
+    double const distTolerance  = 1e-3 * tessellation.diagonal;
+    double const pointTolerance = 1e-4 * tessellation.diagonal;
+
+    std::vector<Osd::PatchBVH::ClosestPoint> closest(numPoints);
+    std::vector<Osd::PatchCoord>             closestCoords;
+    std::vector<int>                         closestPoints;
+
+    int failures = 0;
+    for (int i = 0; i < numPoints; ++i) {
+        float const * point = &points[i * 3];
+        Osd::PatchBVH::ClosestPoint & cp = closest[i];
+
+        double p[3] = { point[0], point[1], point[2] };
+        double distRef = distances[i];
+
+        //  Points near maxDistance may or may not be found:
+        bool found = bvh->FindClosestPoint(point, maxDistance, &cp);
+        if (!found) {
+            if (distRef < maxDistance - distTolerance) {
+                printf("  %s : no closest point found for point %d\n",
+                       what, i);
+                ++failures;
+            }
+            continue;
+        }
+        if (distRef > maxDistance + distTolerance) {
+            printf("  %s : point %d has a closest point beyond %g\n",
+                   what, i, maxDistance);
+            ++failures;
+        }
+        if (std::abs(cp.distance - distRef) > distTolerance) {
+            printf("  %s : point %d is at distance %g (%g expected)\n",
+                   what, i, cp.distance, distRef);
+            ++failures;
+        }
+        double d[3];
+        for (int k = 0; k < 3; ++k) {
+            d[k] = cp.point[k] - p[k];
+        }
+        if (std::abs(normalize(d) - cp.distance) > pointTolerance) {
+            printf("  %s : distance of point %d is not to its closest point\n",
+                   what, i);
+            ++failures;
+        }
+        if (mesh.patchTable->GetPatchParam(cp.handle).GetFaceId() !=
+            cp.faceId) {
+            printf("  %s : closest point of point %d is on face %d of "
+                   "another patch\n", what, i, cp.faceId);
+            ++failures;
+        }
+        closestCoords.push_back(Osd::PatchCoord(cp.handle, cp.u, cp.v));
+        closestPoints.push_back(i);
+    }
+
+    //  The limit surface evaluated at the closest points matches them:
+    if (!closestCoords.empty()) {
+        std::vector<float> P(closestCoords.size() * 3);
+        Osd::BufferDescriptor srcDesc(0, 3, 3), dstDesc(0, 3, 3);
+        Osd::CpuEvaluator::EvalPatches(&mesh.vertexData[0], srcDesc,
+            &P[0], dstDesc, (int)closestCoords.size(), &closestCoords[0],
+            mesh.cpuPatchTable->GetPatchArrayBuffer(),
+            mesh.cpuPatchTable->GetPatchIndexBuffer(),
+            mesh.cpuPatchTable->GetPatchParamBuffer());
+
+        for (int i = 0; i < (int)closestPoints.size(); ++i) {
+            Osd::PatchBVH::ClosestPoint const & cp =
+                closest[closestPoints[i]];
+            double d[3];
+            for (int k = 0; k < 3; ++k) {
+                d[k] = P[i * 3 + k] - cp.point[k];
+            }
+            if (normalize(d) > pointTolerance) {
+                printf("  %s : closest point of point %d is not on the "
+                       "surface\n", what, closestPoints[i]);
+                ++failures;
+            }
+        }
+    }
+
+    //  Streams of points, serially and over the thread pool:
+    for (int pass = 0; pass < 2; ++pass) {
+        std::vector<Osd::PatchBVH::ClosestPoint> streamClosest(numPoints);
+        int numFound = bvh->FindClosestPoints(numPoints, &points[0], 3,
+            maxDistance, &streamClosest[0], pass ? options.threadPool : 0);
+
+        int count = 0, numExpected = 0;
+        for (int i = 0; i < numPoints; ++i) {
+            numExpected += closest[i].IsValid();
+            if ((streamClosest[i].IsValid() != closest[i].IsValid()) ||
+                (std::abs(streamClosest[i].distance - closest[i].distance) >
+                 1e-5f * std::max(1.0f, closest[i].distance))) {
+                ++count;
+            }
+        }
+        if (count || (numFound != numExpected)) {
+            printf("  %s : %d of %d closest points of the stream differ\n",
+                   what, count, numPoints);
+            ++failures;
+        }
+    }
+
+    delete bvh;
+    return failures;
+}
+
+static int
+checkPatchBVH(TestMesh & mesh) {
+
+    LimitTessellation tessellation(mesh, 32);
+    if (tessellation.GetNumTriangles() == 0) return 0;
+
+    float diagonal = (float)tessellation.diagonal;
+
+    FrameBuffers frames(mesh.GetNumPatchCoords());
+    evalPatchesNormals<Osd::CpuEvaluator>(mesh, frames);
+
+    bool triFaces = (mesh.refiner->GetSchemeType() == Sdc::SCHEME_LOOP);
+
+    int const maxRays = 64;
+    int step = std::max(mesh.GetNumPatchCoords() / maxRays, 1);
+
+    //  Rays toward the limit surface along the normal at a subset of the
+    //  coordinates -- each hits the surface at t = 1 and may hit it before
+    //  (coordinates outside of triangular faces are not on the surface):
+    std::vector<int> coords;
+    for (int i = 0; i < mesh.GetNumPatchCoords(); i += step) {
+        Osd::PatchCoord const & coord = mesh.patchCoords[i];
+        if (triFaces && (coord.s + coord.t > 1.0f)) continue;
+        coords.push_back(i);
+    }
+
+    std::vector<Osd::PatchBVH::Ray> rays;
+    for (int i = 0; i < (int)coords.size(); ++i) {
+        float const * P = &frames.data[0][coords[i] * 3];
+        float const * N = &frames.data[1][coords[i] * 3];
+
+        Osd::PatchBVH::Ray ray;
+        for (int k = 0; k < 3; ++k) {
+            ray.origin[k]    = P[k] + 0.25f * diagonal * N[k];
+            ray.direction[k] = -0.25f * diagonal * N[k];
+        }
+        ray.tMin = 0.0f;
+        ray.tMax = 2.0f;
+        rays.push_back(ray);
+    }
+    int numTargets = (int)rays.size();
+
+    //  Rays along the tangent just below the surface cross curved patches
+    //  twice, and only the nearer hit is expected:
+    for (int i = 0; i < (int)coords.size(); ++i) {
+        float const * P = &frames.data[0][coords[i] * 3];
+        float const * N = &frames.data[1][coords[i] * 3];
+        float const * T = &frames.data[2][coords[i] * 3];
+
+        Osd::PatchBVH::Ray ray;
+        for (int k = 0; k < 3; ++k) {
+            ray.origin[k]    = P[k] - 0.01f * diagonal * N[k] -
+                               0.25f * diagonal * T[k];
+            ray.direction[k] = 0.5f * diagonal * T[k];
+        }
+        ray.tMin = 0.0f;
+        ray.tMax = 1.0f;
+        rays.push_back(ray);
+    }
+
+    //  Rays away from the bounds of the surface miss it:
+    for (int i = 0; i < 3; ++i) {
+        Osd::PatchBVH::Ray ray;
+        for (int k = 0; k < 3; ++k) {
+            ray.origin[k]    = tessellation.points[k] +
+                               ((k == i) ? 2.0f * diagonal : 0.0f);
+            ray.direction[k] = (k == i) ? 1.0f : 0.0f;
+        }
+        ray.tMin = 0.0f;
+        ray.tMax = 1.0e30f;
+        rays.push_back(ray);
+    }
+
+    //  The default sub-patches, and whole patches which the rays along the
+    //  tangents are more likely to cross twice:
+    Osd::PatchBVH::Options options;
+    options.threadPool = Osd::ThreadPoolEvaluator::GetThreadPool();
+
+    //  Points on the surface, above and below it at the same coordinates,
+    //  and beyond the maximum distance of the surface:
+    std::vector<float> points;
+    float const offsets[3] = { 0.0f, 0.1f * diagonal, -0.05f * diagonal };
+    for (int i = 0; i < (int)coords.size(); ++i) {
+        float const * P = &frames.data[0][coords[i] * 3];
+        float const * N = &frames.data[1][coords[i] * 3];
+        for (int j = 0; j < 3; ++j) {
+            for (int k = 0; k < 3; ++k) {
+                points.push_back(P[k] + offsets[j] * N[k]);
+            }
+        }
+    }
+    for (int i = 0; i < 3; ++i) {
+        for (int k = 0; k < 3; ++k) {
+            points.push_back(tessellation.points[k] +
+                             ((k == i) ? 2.0f * diagonal : 0.0f));
+        }
+    }
+    float maxDistance = 0.5f * diagonal;
+
+    std::vector<double> distances(points.size() / 3);
+    for (int i = 0; i < (int)distances.size(); ++i) {
+        double p[3] = { points[i * 3], points[i * 3 + 1], points[i * 3 + 2] };
+        distances[i] = tessellation.FindDistance(p);
+    }
+
+    int failures = checkPatchBVH("PatchBVH", mesh, tessellation,
+                                 rays, numTargets, options);
+    failures += checkPatchBVHClosest("PatchBVH closest", mesh,
+                                     tessellation, points, distances,
+                                     maxDistance, options);
+
+    options.subPatchDepth = 0;
+    failures += checkPatchBVH("PatchBVH (depth 0)", mesh, tessellation,
+                              rays, numTargets, options);
+    failures += checkPatchBVHClosest("PatchBVH closest (depth 0)", mesh,
+                                     tessellation, points, distances,
+                                     maxDistance, options);
+    return failures;
+}
+
+//------------------------------------------------------------------------------
+// TopologyCache : entries must match the refiner and tables created directly
+// from the topology, and be shared by identical topologies only
+
+//  Arrays of the TopologyDescriptor of a shape:
+struct ShapeTopology {
+
+    ShapeTopology(Shape const & shape);
+
+    void GetDescriptor(Far::TopologyDescriptor & desc) const;
+
+    int numVertices;
+    std::vector<int>   vertsPerFace;
+    std::vector<int>   vertIndices;
+    std::vector<int>   creaseVerts;
+    std::vector<float> creaseWeights;
+    std::vector<int>   cornerVerts;
+    std::vector<float> cornerWeights;
+    std::vector<int>   holes;
+};
+
+ShapeTopology::ShapeTopology(Shape const & shape) :
+    numVertices((int)shape.verts.size() / 3),
+    vertsPerFace(shape.nvertsPerFace), vertIndices(shape.faceverts) {
+
+    for (int i = 0; i < (int)shape.tags.size(); ++i) {
+        Shape::tag const * t = shape.tags[i];
+
+        int numWeights = (int)t->floatargs.size();
+        if (t->name == "crease") {
+            for (int j = 0; j + 1 < (int)t->intargs.size(); j += 2) {
+                creaseVerts.push_back(t->intargs[j]);
+                creaseVerts.push_back(t->intargs[j + 1]);
+                creaseWeights.push_back((numWeights > 1) ?
+                    t->floatargs[std::min(j / 2, numWeights - 1)] :
+                    t->floatargs[0]);
+            }
+        } else if (t->name == "corner") {
+            for (int j = 0; j < (int)t->intargs.size(); ++j) {
+                cornerVerts.push_back(t->intargs[j]);
+                cornerWeights.push_back((numWeights > 1) ?
+                    t->floatargs[std::min(j, numWeights - 1)] :
+                    t->floatargs[0]);
+            }
+        } else if (t->name == "hole") {
+            holes.insert(holes.end(), t->intargs.begin(), t->intargs.end());
+        }
+    }
+}
+
+void
+ShapeTopology::GetDescriptor(Far::TopologyDescriptor & desc) const {
+
+    desc = Far::TopologyDescriptor();
+    desc.numVertices        = numVertices;
+    desc.numFaces           = (int)vertsPerFace.size();
+    desc.numVertsPerFace    = &vertsPerFace[0];
+    desc.vertIndicesPerFace = &vertIndices[0];
+    if (!creaseWeights.empty()) {
+        desc.numCreases             = (int)creaseWeights.size();
+        desc.creaseVertexIndexPairs = &creaseVerts[0];
+        desc.creaseWeights          = &creaseWeights[0];
+    }
+    if (!cornerWeights.empty()) {
+        desc.numCorners          = (int)cornerWeights.size();
+        desc.cornerVertexIndices = &cornerVerts[0];
+        desc.cornerWeights       = &cornerWeights[0];
+    }
+    if (!holes.empty()) {
+        desc.numHoles    = (int)holes.size();
+        desc.holeIndices = &holes[0];
+    }
+}
+
+//  Compares the refiner and tables of an entry to those created directly
+//  with the same options:
+static int
+checkCacheEntry(char const * what, Osd::TopologyCache::Entry const & entry,
+                Far::TopologyDescriptor const & desc,
+                Osd::TopologyCache::Options const & options) {
+
+    typedef Far::TopologyRefinerFactory<Far::TopologyDescriptor> Factory;
+
+    Far::TopologyRefiner * refiner = Factory::Create(desc,
+        Factory::Options(options.schemeType, options.schemeOptions));
+    if (options.refineAdaptive) {
+        refiner->RefineAdaptive(
+            options.patchOptions.GetRefineAdaptiveOptions());
+    } else {
+        refiner->RefineUniform(
+            Far::TopologyRefiner::UniformOptions(options.uniformLevel));
+    }
+
+    Far::PatchTable const * patchTable = options.createPatchTable ?
+        Far::PatchTableFactory::Create(*refiner, options.patchOptions) : 0;
+
+    Far::StencilTable const * stencilTable = 0;
+    if (options.createStencilTable) {
+        Far::StencilTableFactory::Options stencilOptions;
+        stencilOptions.generateOffsets = true;
+        stencilOptions.generateIntermediateLevels = !refiner->IsUniform();
+        stencilTable = Far::StencilTableFactory::Create(*refiner,
+                                                        stencilOptions);
+        if (patchTable && patchTable->GetLocalPointStencilTable()) {
+            if (Far::StencilTable const * stencilTableWithLocalPoints =
+                Far::StencilTableFactory::AppendLocalPointStencilTable(
+                    *refiner, stencilTable,
+                    patchTable->GetLocalPointStencilTable())) {
+                delete stencilTable;
+                stencilTable = stencilTableWithLocalPoints;
+            }
+        }
+    }
+
+    int failures = 0;
+
+    Far::TopologyRefiner const * cached = entry.GetRefiner();
+    bool refinerMatches = (cached->GetNumLevels() == refiner->GetNumLevels());
+    for (int i = 0; refinerMatches && (i < refiner->GetNumLevels()); ++i) {
+        Far::TopologyLevel const & a = cached->GetLevel(i);
+        Far::TopologyLevel const & b = refiner->GetLevel(i);
+        refinerMatches = (a.GetNumVertices() == b.GetNumVertices()) &&
+                         (a.GetNumEdges()    == b.GetNumEdges()) &&
+                         (a.GetNumFaces()    == b.GetNumFaces());
+        for (int f = 0; refinerMatches && (f < b.GetNumFaces()); ++f) {
+            Far::ConstIndexArray aVerts = a.GetFaceVertices(f),
+                                 bVerts = b.GetFaceVertices(f);
+            refinerMatches = (aVerts.size() == bVerts.size()) &&
+                             std::equal(bVerts.begin(), bVerts.end(),
+                                        aVerts.begin()) &&
+                             (a.IsFaceHole(f) == b.IsFaceHole(f));
+        }
+    }
+    if (!refinerMatches) {
+        printf("  %s : refiner differs\n", what);
+        ++failures;
+    }
+
+    Far::PatchTable const * cachedPatches = entry.GetPatchTable();
+    if ((cachedPatches != 0) != (patchTable != 0)) {
+        printf("  %s : patch table %s\n", what,
+               patchTable ? "missing" : "not expected");
+        ++failures;
+    } else if (patchTable) {
+        bool matches =
+            (cachedPatches->GetNumPatchesTotal() ==
+             patchTable->GetNumPatchesTotal()) &&
+            (cachedPatches->GetNumLocalPoints() ==
+             patchTable->GetNumLocalPoints()) &&
+            (cachedPatches->GetPatchControlVerticesTable() ==
+             patchTable->GetPatchControlVerticesTable());
+        Far::PatchParamTable const & a = cachedPatches->GetPatchParamTable();
+        Far::PatchParamTable const & b = patchTable->GetPatchParamTable();
+        matches = matches && (a.size() == b.size());
+        for (int i = 0; matches && (i < (int)b.size()); ++i) {
+            matches = (a[i].field0 == b[i].field0) &&
+                      (a[i].field1 == b[i].field1);
+        }
+        if (!matches) {
+            printf("  %s : patch table differs\n", what);
+            ++failures;
+        }
+    }
+
+    Far::StencilTable const * cachedStencils = entry.GetStencilTable();
+    if ((cachedStencils != 0) != (stencilTable != 0)) {
+        printf("  %s : stencil table %s\n", what,
+               stencilTable ? "missing" : "not expected");
+        ++failures;
+    } else if (stencilTable) {
+        if ((cachedStencils->GetSizes() != stencilTable->GetSizes()) ||
+            (cachedStencils->GetOffsets() != stencilTable->GetOffsets()) ||
+            (cachedStencils->GetControlIndices() !=
+             stencilTable->GetControlIndices()) ||
+            (cachedStencils->GetWeights() != stencilTable->GetWeights())) {
+            printf("  %s : stencil table differs\n", what);
+            ++failures;
+        }
+    }
+
+    delete stencilTable;
+    delete patchTable;
+    delete refiner;
+    return failures;
+}
+
+//  Acquires the same topology from each task of a ParallelFor:
+class AcquireTask : public Osd::ThreadPool::Task {
+public:
+    AcquireTask(Osd::TopologyCache & cache,
+                Far::TopologyDescriptor const & desc,
+                Osd::TopologyCache::Options const & options,
+                Osd::TopologyCache::EntryPtr * entries) :
+        _cache(cache), _desc(desc), _options(options), _entries(entries) { }
+
+    virtual void Run(int begin, int end) const {
+        for (int i = begin; i < end; ++i) {
+            _entries[i] = _cache.Acquire(_desc, _options);
+        }
+    }
+
+private:
+    Osd::TopologyCache                & _cache;
+    Far::TopologyDescriptor const     & _desc;
+    Osd::TopologyCache::Options const & _options;
+    Osd::TopologyCache::EntryPtr      * _entries;
+};
+
+static int
+checkTopologyCache(Shape const & shape, int level) {
+
+    typedef Osd::TopologyCache::EntryPtr EntryPtr;
+
+    ShapeTopology topology(shape);
+    Far::TopologyDescriptor desc;
+    topology.GetDescriptor(desc);
+
+    Osd::TopologyCache::Options options;
+    options.schemeType    = GetSdcType(shape);
+    options.schemeOptions = GetSdcOptions(shape);
+    options.patchOptions  = Far::PatchTableFactory::Options(level);
+    options.patchOptions.SetEndCapType(
+        Far::PatchTableFactory::Options::ENDCAP_GREGORY_BASIS);
+
+    Osd::ThreadPool * threadPool = Osd::ThreadPoolEvaluator::GetThreadPool();
+
+    int failures = 0;
+
+    Osd::TopologyCache cache;
+    EntryPtr entry = cache.Acquire(desc, options);
+    if (!entry) {
+        printf("  TopologyCache : no entry for a valid topology\n");
+        return 1;
+    }
+    failures += checkCacheEntry("TopologyCache (adaptive)", *entry,
+                                desc, options);
+
+    //  Keys depend on the content of the topology only:
+    Osd::TopologyCache::Key key = Osd::TopologyCache::ComputeKey(desc,
+                                                                 options);
+    if ((key != entry->GetKey()) ||
+        (key != Osd::TopologyCache::ComputeKey(desc, options, threadPool))) {
+        printf("  TopologyCache : keys of the same topology differ\n");
+        ++failures;
+    }
+
+    ShapeTopology copy(shape);
+    Far::TopologyDescriptor copyDesc;
+    copy.GetDescriptor(copyDesc);
+    if ((cache.Acquire(copyDesc, options, threadPool) != entry) ||
+        (cache.Find(key) != entry) || (cache.GetNumEntries() != 1)) {
+        printf("  TopologyCache : identical topology not shared\n");
+        ++failures;
+    }
+
+    //  Different topology or options make different entries:
+    copy.holes.push_back((int)copy.vertsPerFace.size() - 1);
+    copy.GetDescriptor(copyDesc);
+    EntryPtr holeEntry = cache.Acquire(copyDesc, options);
+    if (!holeEntry || (holeEntry == entry) ||
+        (holeEntry->GetKey() == entry->GetKey())) {
+        printf("  TopologyCache : different topology shares an entry\n");
+        ++failures;
+    } else {
+        failures += checkCacheEntry("TopologyCache (hole)", *holeEntry,
+                                    copyDesc, options);
+    }
+
+    //  Changes of the arrays that retain their sizes change the key:
+    ShapeTopology rotated(shape);
+    std::rotate(rotated.vertIndices.begin(),
+                rotated.vertIndices.begin() + 1,
+                rotated.vertIndices.begin() + rotated.vertsPerFace[0]);
+    rotated.GetDescriptor(copyDesc);
+    bool keysDiffer =
+        (Osd::TopologyCache::ComputeKey(copyDesc, options) != key);
+
+    if (!topology.creaseWeights.empty()) {
+        ShapeTopology sharper(shape);
+        sharper.creaseWeights[0] += 1.0f;
+        sharper.GetDescriptor(copyDesc);
+        keysDiffer = keysDiffer &&
+            (Osd::TopologyCache::ComputeKey(copyDesc, options) != key);
+    }
+    if (!keysDiffer) {
+        printf("  TopologyCache : keys of different topologies match\n");
+        ++failures;
+    }
+
+    //  Edges, when supplied, are part of the key -- including their order:
+    Far::TopologyLevel const & baseLevel = entry->GetRefiner()->GetLevel(0);
+    int numEdges = baseLevel.GetNumEdges();
+    std::vector<Far::Index> edgeVerts, faceEdges;
+    for (int e = 0; e < numEdges; ++e) {
+        Far::ConstIndexArray verts = baseLevel.GetEdgeVertices(e);
+        edgeVerts.push_back(verts[0]);
+        edgeVerts.push_back(verts[1]);
+    }
+    for (int f = 0; f < baseLevel.GetNumFaces(); ++f) {
+        Far::ConstIndexArray edges = baseLevel.GetFaceEdges(f);
+        faceEdges.insert(faceEdges.end(), edges.begin(), edges.end());
+    }
+    Far::TopologyDescriptor edgeDesc(desc);
+    edgeDesc.numEdges           = numEdges;
+    edgeDesc.edgeVertIndices    = &edgeVerts[0];
+    edgeDesc.edgeIndicesPerFace = &faceEdges[0];
+    Osd::TopologyCache::Key edgeKey =
+        Osd::TopologyCache::ComputeKey(edgeDesc, options);
+
+    std::swap(edgeVerts[0], edgeVerts[1]);
+    if ((edgeKey == key) ||
+        (Osd::TopologyCache::ComputeKey(edgeDesc, options) == edgeKey)) {
+        printf("  TopologyCache : supplied edges do not change the key\n");
+        ++failures;
+    }
+
+    Osd::TopologyCache::Options uniformOptions(options);
+    uniformOptions.refineAdaptive     = false;
+    uniformOptions.uniformLevel       = level;
+    uniformOptions.createPatchTable   = false;
+    EntryPtr uniformEntry = cache.Acquire(desc, uniformOptions);
+    if (!uniformEntry || (uniformEntry == entry) ||
+        (uniformEntry->GetKey() == entry->GetKey())) {
+        printf("  TopologyCache : different options share an entry\n");
+        ++failures;
+    } else {
+        failures += checkCacheEntry("TopologyCache (uniform)", *uniformEntry,
+                                    desc, uniformOptions);
+    }
+    if (cache.GetNumEntries() != 3) {
+        printf("  TopologyCache : %d entries (3 expected)\n",
+               cache.GetNumEntries());
+        ++failures;
+    }
+
+    //  Only entries no longer referenced are pruned, and cleared entries
+    //  remain valid while referenced:
+    holeEntry.reset();
+    if ((cache.Prune() != 1) || (cache.GetNumEntries() != 2) ||
+        (cache.Find(key) != entry)) {
+        printf("  TopologyCache : Prune() removed referenced entries\n");
+        ++failures;
+    }
+    cache.Clear();
+    if ((cache.GetNumEntries() != 0) || cache.Find(key)) {
+        printf("  TopologyCache : Clear() retained entries\n");
+        ++failures;
+    }
+    failures += checkCacheEntry("TopologyCache (cleared)", *entry,
+                                desc, options);
+
+    //  Concurrent acquisitions create a single entry:
+    int const numTasks = 16;
+    std::vector<EntryPtr> entries(numTasks);
+    threadPool->ParallelFor(0, numTasks, 1,
+        AcquireTask(cache, desc, options, &entries[0]));
+    bool shared = (cache.GetNumEntries() == 1) && entries[0] &&
+                  (entries[0] != entry);
+    for (int i = 1; i < numTasks; ++i) {
+        shared = shared && (entries[i] == entries[0]);
+    }
+    if (!shared) {
+        printf("  TopologyCache : concurrent acquisitions not shared\n");
+        ++failures;
+    }
+    return failures;
+}
+
+//------------------------------------------------------------------------------
+// NumaEvaluator : the evaluation of the partitions of the stencils on the
+// threads of each (emulated) node must match the CpuEvaluator bitwise, and
+// the statistics of the nodes must account for all stencils and weights
+
+static int
+checkNumaStats(char const * what, Osd::NumaStencilTable const & table,
+               std::vector<Osd::NumaEvaluator::NodeStats> const & stats,
+               int numStencils, int numWeights) {
+
+    int stencilsTotal = 0, weightsTotal = 0, end = 0;
+    bool contiguous = true;
+    for (int i = 0; i < table.GetNumPartitions(); ++i) {
+        contiguous = contiguous && (table.GetPartitionBegin(i) == end) &&
+                     (stats[i].numStencils == table.GetPartitionEnd(i) -
+                                              table.GetPartitionBegin(i));
+        end = table.GetPartitionEnd(i);
+        stencilsTotal += stats[i].numStencils;
+        weightsTotal  += stats[i].numWeights;
+    }
+    if (!contiguous || (end != numStencils) ||
+        (stencilsTotal != numStencils) || (weightsTotal != numWeights)) {
+        printf("  %s : node statistics of %d stencils and %d weights "
+               "(%d and %d expected)\n", what, stencilsTotal, weightsTotal,
+               numStencils, numWeights);
+        return 1;
+    }
+    return 0;
+}
+
+static int
+checkNumaEvaluator(TestMesh & mesh) {
+
+    Far::StencilTable const & stencils = *mesh.stencilTable;
+    int numStencils = stencils.GetNumStencils();
+    if (numStencils == 0) return 0;
+
+    //  Limit stencils at the coordinates of the patches:
+    int numCoords = mesh.GetNumPatchCoords();
+    std::vector<float> s(numCoords), t(numCoords);
+    Far::LimitStencilTableFactory::LocationArrayVec locations(numCoords);
+    for (int i = 0; i < numCoords; ++i) {
+        Osd::PatchCoord const & coord = mesh.patchCoords[i];
+        s[i] = coord.s;
+        t[i] = coord.t;
+        locations[i].ptexIdx =
+            mesh.patchTable->GetPatchParam(coord.handle).GetFaceId();
+        locations[i].numLocations = 1;
+        locations[i].s = &s[i];
+        locations[i].t = &t[i];
+    }
+    Far::LimitStencilTable const * limitStencils =
+        Far::LimitStencilTableFactory::Create(*mesh.refiner, locations);
+    int numLimitStencils = limitStencils->GetNumStencils();
+
+    Osd::BufferDescriptor srcDesc(0, 3, 3), dstDesc(0, 3, 3);
+
+    //  References:
+    std::vector<float> P(numStencils * 3);
+    Osd::CpuEvaluator::EvalStencils(&mesh.vertexData[0], srcDesc,
+        &P[0], dstDesc,
+        &stencils.GetSizes()[0], &stencils.GetOffsets()[0],
+        &stencils.GetControlIndices()[0], &stencils.GetWeights()[0],
+        0, numStencils);
+
+    std::vector<float> limitP(numLimitStencils * 3),
+                       limitDu(numLimitStencils * 3),
+                       limitDv(numLimitStencils * 3);
+    Osd::CpuEvaluator::EvalStencils(&mesh.vertexData[0], srcDesc,
+        &limitP[0], dstDesc, &limitDu[0], dstDesc, &limitDv[0], dstDesc,
+        &limitStencils->GetSizes()[0], &limitStencils->GetOffsets()[0],
+        &limitStencils->GetControlIndices()[0],
+        &limitStencils->GetWeights()[0],
+        &limitStencils->GetDuWeights()[0], &limitStencils->GetDvWeights()[0],
+        0, numLimitStencils);
+
+    int failures = 0;
+    for (int numNodes = 1; numNodes <= 3; ++numNodes) {
+        Osd::NumaThreadPool pool(numNodes, 2);
+
+        char what[64];
+        snprintf(what, sizeof(what), "NumaEvaluator (%d nodes)", numNodes);
+
+        std::vector<Osd::NumaEvaluator::NodeStats> stats(numNodes);
+
+        Osd::NumaStencilTable * table =
+            Osd::NumaStencilTable::Create(&stencils, &pool);
+
+        std::vector<float> result(numStencils * 3, 1.0f);
+        table->FirstTouchBuffer(&result[0], dstDesc);
+        failures += compareBuffers(what, result,
+                                   std::vector<float>(numStencils * 3, 0.0f));
+
+        Osd::NumaEvaluator::EvalStencils(&mesh.vertexData[0], srcDesc,
+            &result[0], dstDesc, table, &stats[0]);
+        failures += compareBuffers(what, result, P);
+        failures += checkNumaStats(what, *table, stats, numStencils,
+                                   (int)stencils.GetControlIndices().size());
+        delete table;
+
+        snprintf(what, sizeof(what), "NumaEvaluator limit (%d nodes)",
+                 numNodes);
+
+        table = Osd::NumaStencilTable::Create(limitStencils, &pool);
+
+        std::vector<float> resultP(numLimitStencils * 3),
+                           resultDu(numLimitStencils * 3),
+                           resultDv(numLimitStencils * 3);
+        Osd::NumaEvaluator::EvalStencils(&mesh.vertexData[0], srcDesc,
+            &resultP[0], dstDesc, &resultDu[0], dstDesc,
+            &resultDv[0], dstDesc, table, &stats[0]);
+        failures += compareBuffers(what, resultP, limitP);
+        failures += compareBuffers(what, resultDu, limitDu);
+        failures += compareBuffers(what, resultDv, limitDv);
+        failures += checkNumaStats(what, *table, stats, numLimitStencils,
+            (int)limitStencils->GetControlIndices().size());
+        delete table;
+    }
+
+    delete limitStencils;
+    return failures;
+}
+
+//------------------------------------------------------------------------------
+// Osd::Mesh : the double buffered refinement of MeshAsyncRefine must match
+// the synchronous refinement, while the next frame is being updated
+
+//  Osd::Mesh draws its buffers : the CPU buffers bind their own memory
+class MeshVertexBuffer : public Osd::CpuVertexBuffer {
+public:
+    static MeshVertexBuffer * Create(int numElements, int numVertices,
+                                     void * /* deviceContext */ = NULL) {
+        return new MeshVertexBuffer(numElements, numVertices);
+    }
+
+    float * BindVBO(void * /* deviceContext */ = NULL) {
+        return BindCpuBuffer();
+    }
+
+protected:
+    MeshVertexBuffer(int numElements, int numVertices) :
+        Osd::CpuVertexBuffer(numElements, numVertices) { }
+};
+
+class MeshPatchTable : public Osd::CpuPatchTable {
+public:
+    typedef float * VertexBufferBinding;
+
+    static MeshPatchTable * Create(Far::PatchTable const * patchTable,
+                                   void * /* deviceContext */ = NULL) {
+        return new MeshPatchTable(patchTable);
+    }
+
+    explicit MeshPatchTable(Far::PatchTable const * patchTable) :
+        Osd::CpuPatchTable(patchTable) { }
+};
+
+typedef Osd::Mesh<MeshVertexBuffer, Far::StencilTable,
+                  Osd::CpuEvaluator, MeshPatchTable> CpuMesh;
+
+static void
+framePrimvars(Shape const & shape, int frame, int numElements,
+              std::vector<float> & data) {
+
+    int numVerts = (int)shape.verts.size() / 3;
+    data.resize(numVerts * numElements);
+    for (int i = 0; i < numVerts; ++i) {
+        for (int k = 0; k < numElements; ++k) {
+            data[i * numElements + k] =
+                (float)(frame + 1) * primvarValue(shape, i, k);
+        }
+    }
+}
+
+static int
+checkAsyncMesh(Shape const & shape, int level) {
+
+    Osd::MeshBitset syncBits, asyncBits;
+    syncBits.set(Osd::MeshAdaptive);
+    syncBits.set(Osd::MeshEndCapGregoryBasis);
+    asyncBits = syncBits;
+    asyncBits.set(Osd::MeshAsyncRefine);
+
+    CpuMesh * meshes[2];
+    Osd::MeshBitset bits[2] = { syncBits, asyncBits };
+    for (int i = 0; i < 2; ++i) {
+        Far::TopologyRefiner * refiner =
+            Far::TopologyRefinerFactory<Shape>::Create(shape,
+                Far::TopologyRefinerFactory<Shape>::Options(
+                    GetSdcType(shape), GetSdcOptions(shape)));
+        meshes[i] = new CpuMesh(refiner, 3, 1, level, bits[i]);
+    }
+    CpuMesh & syncMesh = *meshes[0];
+    CpuMesh & asyncMesh = *meshes[1];
+
+    int numCoarseVerts = (int)shape.verts.size() / 3;
+    int numVerts = syncMesh.GetNumVertices();
+
+    int failures = 0;
+    std::vector<float> vertexData, varyingData;
+
+    framePrimvars(shape, 0, 3, vertexData);
+    framePrimvars(shape, 0, 1, varyingData);
+    asyncMesh.UpdateVertexBuffer(&vertexData[0], 0, numCoarseVerts);
+    asyncMesh.UpdateVaryingBuffer(&varyingData[0], 0, numCoarseVerts);
+
+    for (int frame = 0; frame < 4; ++frame) {
+        framePrimvars(shape, frame, 3, vertexData);
+        framePrimvars(shape, frame, 1, varyingData);
+        syncMesh.UpdateVertexBuffer(&vertexData[0], 0, numCoarseVerts);
+        syncMesh.UpdateVaryingBuffer(&varyingData[0], 0, numCoarseVerts);
+        syncMesh.Refine();
+
+        //  Updates the next frame while the current one is refined:
+        asyncMesh.Refine();
+        framePrimvars(shape, frame + 1, 3, vertexData);
+        framePrimvars(shape, frame + 1, 1, varyingData);
+        asyncMesh.UpdateVertexBuffer(&vertexData[0], 0, numCoarseVerts);
+        asyncMesh.UpdateVaryingBuffer(&varyingData[0], 0, numCoarseVerts);
+        asyncMesh.Synchronize();
+
+        if (!asyncMesh.IsRefineComplete()) {
+            printf("  failure : async Mesh incomplete after Synchronize()\n");
+            ++failures;
+        }
+
+        char what[64];
+        float const * syncVerts = syncMesh.GetVertexBuffer()->BindCpuBuffer();
+        float const * asyncVerts = asyncMesh.GetVertexBuffer()->BindCpuBuffer();
+        snprintf(what, sizeof(what), "async Mesh vertices (frame %d)", frame);
+        failures += compareBuffers(what,
+            std::vector<float>(asyncVerts, asyncVerts + numVerts * 3),
+            std::vector<float>(syncVerts, syncVerts + numVerts * 3));
+
+        float const * syncVarying =
+            syncMesh.GetVaryingBuffer()->BindCpuBuffer();
+        float const * asyncVarying =
+            asyncMesh.GetVaryingBuffer()->BindCpuBuffer();
+        snprintf(what, sizeof(what), "async Mesh varying (frame %d)", frame);
+        failures += compareBuffers(what,
+            std::vector<float>(asyncVarying, asyncVarying + numVerts),
+            std::vector<float>(syncVarying, syncVarying + numVerts));
+    }
+
+    delete meshes[0];
+    delete meshes[1];
+    return failures;
+}
+
+//------------------------------------------------------------------------------
+// Thread pools : nested and concurrent calls to ParallelFor() must still
+// process every item exactly once, and concurrent calls to a NumaThreadPool
+// must be queued for its workers
+
+class FillTask : public Osd::ThreadPool::Task {
+public:
+    FillTask(std::vector<int> & items, int value) :
+        _items(items), _value(value) { }
+
+    virtual void Run(int begin, int end) const {
+        for (int i = begin; i < end; ++i) _items[i] += _value;
+    }
+private:
+    std::vector<int> & _items;
+    int _value;
+};
+
+class NestedTask : public Osd::ThreadPool::Task {
+public:
+    NestedTask(Osd::ThreadPool & pool, std::vector<int> & items, int rowSize) :
+        _pool(pool), _items(items), _rowSize(rowSize) { }
+
+    virtual void Run(int begin, int end) const {
+        FillTask fill(_items, 1);
+        for (int row = begin; row < end; ++row) {
+            _pool.ParallelFor(row * _rowSize, (row + 1) * _rowSize, 3, fill);
+        }
+    }
+private:
+    Osd::ThreadPool & _pool;
+    std::vector<int> & _items;
+    int _rowSize;
+};
+
+//  Fills the items while counting those processed by a given thread:
+class FillCountTask : public FillTask {
+public:
+    FillCountTask(std::vector<int> & items, std::thread::id thread,
+                  std::atomic<int> & count) :
+        FillTask(items, 1), _thread(thread), _count(count) { }
+
+    virtual void Run(int begin, int end) const {
+        FillTask::Run(begin, end);
+        if (std::this_thread::get_id() == _thread) _count += end - begin;
+    }
+private:
+    std::thread::id    _thread;
+    std::atomic<int> & _count;
+};
+
+static void
+submitFill(Osd::ThreadPool * pool, std::vector<int> * items,
+           std::atomic<int> * numOnClient) {
+
+    FillCountTask fill(*items, std::this_thread::get_id(), *numOnClient);
+    for (int i = 0; i < 50; ++i) {
+        pool->ParallelFor(0, (int)items->size(), 7, fill);
+    }
+}
+
+static int
+checkCounts(char const * what, std::vector<int> const & items, int expected) {
+
+    for (int i = 0; i < (int)items.size(); ++i) {
+        if (items[i] != expected) {
+            printf("  failure : %s : item %d processed %d times, expected %d\n",
+                   what, i, items[i], expected);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int
+checkThreadPool(char const * name, Osd::ThreadPool & pool,
+                bool queuesClients) {
+
+    printf("- %-25s\n", name);
+
+    int failures = 0;
+
+    //  Nested calls from within the tasks of a running job:
+    int numRows = 64, rowSize = 100;
+    std::vector<int> nested(numRows * rowSize, 0);
+    pool.ParallelFor(0, numRows, 1, NestedTask(pool, nested, rowSize));
+    failures += checkCounts("nested ParallelFor", nested, 1);
+
+    //  Concurrent calls from several client threads:
+    std::vector<int> items[4];
+    std::atomic<int> numOnClient(0);
+    std::vector<std::thread> clients;
+    for (int i = 0; i < 4; ++i) {
+        items[i].resize(1000, 0);
+        clients.push_back(
+            std::thread(submitFill, &pool, &items[i], &numOnClient));
+    }
+    for (int i = 0; i < 4; ++i) {
+        clients[i].join();
+    }
+    for (int i = 0; i < 4; ++i) {
+        failures += checkCounts("concurrent ParallelFor", items[i], 50);
+    }
+    if (queuesClients && (numOnClient > 0)) {
+        printf("  failure : concurrent ParallelFor : %d items processed by "
+               "the client threads\n", numOnClient.load());
+        ++failures;
+    }
+    return failures;
+}
+
+static int
+checkThreadPools() {
+
+    Osd::StdThreadPool stdPool(4);
+    int failures = checkThreadPool("StdThreadPool", stdPool, false);
+
+    //  Emulated nodes, whose workers process all items of queued calls:
+    Osd::NumaThreadPool numaPool(2, 2);
+    failures += checkThreadPool("NumaThreadPool", numaPool, true);
+    return failures;
+}
+
+//------------------------------------------------------------------------------
+static int
+checkMesh(Shape const & shape, std::string const & name, int level) {
+
+    static char const * schemes[] = { "Bilinear", "Catmark", "Loop" };
+    printf("- %-25s ( %-8s ): \n", name.c_str(), schemes[shape.scheme]);
+
+    TestMesh mesh(shape, level);
+    if (mesh.patchCoords.empty()) {
+        printf("  warning : no patches to evaluate\n");
+        return 0;
+    }
+
+    LimitBuffers<float> reference(mesh.GetNumPatchCoords(), 3);
+    evalReference(mesh, reference);
+
+    int failures = 0;
+    failures += checkCompactPatches(mesh, reference);
+    failures += checkUniformRefiner(shape, 3);
+    failures += checkDoublePrecision(mesh);
+    failures += checkInstanced(mesh);
+    failures += checkGrainPolicies(mesh);
+    failures += checkAsyncMesh(shape, level);
+    failures += checkStencilsSubset(mesh);
+    failures += checkNormals(mesh, reference);
+    failures += checkPacked(mesh, reference);
+    failures += checkPatchBVH(mesh);
+    failures += checkTopologyCache(shape, level);
+    failures += checkNumaEvaluator(mesh);
+    return failures;
+}
+
+//------------------------------------------------------------------------------
+int main(int /* argc */, char ** /* argv */) {
+
+    int level = 2, total = 0;
+
+    initShapes();
+
+    printf("precision : %f\n", PRECISION);
+
+    total += checkThreadPools();
+
+    for (int i = 0; i < (int)g_shapes.size(); ++i) {
+        ShapeDesc const & desc = g_shapes[i];
+
+        Shape * shape = Shape::parseObj(desc);
+        if (shape) {
+            total += checkMesh(*shape, desc.name, level);
+        }
+        delete shape;
+    }
+
+    if (total == 0) {
+        printf("All tests passed.\n");
+    } else {
+        printf("Total failures : %d\n", total);
+    }
+    return (total == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,184 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#ifndef PERF_SHAPES_H
+#define PERF_SHAPES_H
+
+#include "../common/shape_utils.h"
+
+#include <cmath>
+#include <map>
+
+//
+//  Procedurally generated shapes of arbitrary resolution, used to measure
+//  how the library scales beyond the small hand-authored shapes:
+//
+//    - grid   : a regular NxN grid of quads (boundary only irregularities)
+//    - sphere : a cube projected onto a sphere, 6xNxN quads and 8 valence 3
+//               extraordinary vertices
+//    - pole   : a disk of quads around a single vertex of valence N
+//
+
+//------------------------------------------------------------------------------
+static Shape *
+createGridShape(int res) {
+
+    Shape * shape = new Shape;
+    shape->scheme = kCatmark;
+
+    for (int j = 0; j <= res; ++j) {
+        for (int i = 0; i <= res; ++i) {
+            shape->verts.push_back((float)i / (float)res - 0.5f);
+            shape->verts.push_back((float)j / (float)res - 0.5f);
+            shape->verts.push_back(0.0f);
+        }
+    }
+    for (int j = 0; j < res; ++j) {
+        for (int i = 0; i < res; ++i) {
+            int v0 = j * (res + 1) + i;
+            shape->nvertsPerFace.push_back(4);
+            shape->faceverts.push_back(v0);
+            shape->faceverts.push_back(v0 + 1);
+            shape->faceverts.push_back(v0 + res + 2);
+            shape->faceverts.push_back(v0 + res + 1);
+        }
+    }
+    return shape;
+}
+
+//------------------------------------------------------------------------------
+static Shape *
+createSphereShape(int res) {
+
+    //  Origin and (u,v) axes of each side of the cube, oriented so that u x v
+    //  points outward:
+    static int const sides[6][3][3] = {
+        { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } },
+        { { 0, 0, 0 }, { 0, 0, 1 }, { 0, 1, 0 } },
+        { { 0, 1, 0 }, { 0, 0, 1 }, { 1, 0, 0 } },
+        { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 0, 1 } },
+        { { 0, 0, 1 }, { 1, 0, 0 }, { 0, 1, 0 } },
+        { { 0, 0, 0 }, { 0, 1, 0 }, { 1, 0, 0 } } };
+
+    Shape * shape = new Shape;
+    shape->scheme = kCatmark;
+
+    //  Points on the edges of the cube are shared by adjacent sides, so
+    //  identify them by their lattice coordinates:
+    std::map<long long, int> latticeVerts;
+
+    std::vector<int> sideVerts((res + 1) * (res + 1));
+
+    for (int side = 0; side < 6; ++side) {
+        int const * origin = sides[side][0];
+        int const * uAxis  = sides[side][1];
+        int const * vAxis  = sides[side][2];
+
+        for (int b = 0; b <= res; ++b) {
+            for (int a = 0; a <= res; ++a) {
+                int p[3];
+                for (int k = 0; k < 3; ++k) {
+                    p[k] = origin[k] * res + a * uAxis[k] + b * vAxis[k];
+                }
+                long long key = ((long long)p[0] * (res + 1) + p[1]) *
+                                (res + 1) + p[2];
+
+                std::map<long long, int>::iterator it = latticeVerts.find(key);
+                if (it == latticeVerts.end()) {
+                    float x = 2.0f * (float)p[0] / (float)res - 1.0f;
+                    float y = 2.0f * (float)p[1] / (float)res - 1.0f;
+                    float z = 2.0f * (float)p[2] / (float)res - 1.0f;
+                    float r = std::sqrt(x * x + y * y + z * z);
+
+                    it = latticeVerts.insert(
+                        std::make_pair(key, shape->GetNumVertices())).first;
+                    shape->verts.push_back(x / r);
+                    shape->verts.push_back(y / r);
+                    shape->verts.push_back(z / r);
+                }
+                sideVerts[b * (res + 1) + a] = it->second;
+            }
+        }
+        for (int b = 0; b < res; ++b) {
+            for (int a = 0; a < res; ++a) {
+                int v0 = b * (res + 1) + a;
+                shape->nvertsPerFace.push_back(4);
+                shape->faceverts.push_back(sideVerts[v0]);
+                shape->faceverts.push_back(sideVerts[v0 + 1]);
+                shape->faceverts.push_back(sideVerts[v0 + res + 2]);
+                shape->faceverts.push_back(sideVerts[v0 + res + 1]);
+            }
+        }
+    }
+    return shape;
+}
+
+//------------------------------------------------------------------------------
+static Shape *
+createPoleShape(int valence, int rings) {
+
+    Shape * shape = new Shape;
+    shape->scheme = kCatmark;
+
+    //  The pole vertex is surrounded by rings of 2 * valence vertices, the
+    //  first of which is connected to the pole by a fan of quads:
+    int ringSize = 2 * valence;
+
+    float const twoPi = 6.28318530717958647692f;
+
+    shape->verts.push_back(0.0f);
+    shape->verts.push_back(0.0f);
+    shape->verts.push_back(0.0f);
+    for (int r = 1; r <= rings; ++r) {
+        for (int k = 0; k < ringSize; ++k) {
+            float angle = twoPi * (float)k / (float)ringSize;
+            shape->verts.push_back((float)r * std::cos(angle));
+            shape->verts.push_back((float)r * std::sin(angle));
+            shape->verts.push_back(0.0f);
+        }
+    }
+
+    for (int i = 0; i < valence; ++i) {
+        shape->nvertsPerFace.push_back(4);
+        shape->faceverts.push_back(0);
+        shape->faceverts.push_back(1 + 2 * i);
+        shape->faceverts.push_back(1 + 2 * i + 1);
+        shape->faceverts.push_back(1 + (2 * i + 2) % ringSize);
+    }
+    for (int r = 1; r < rings; ++r) {
+        int inner = 1 + (r - 1) * ringSize;
+        int outer = inner + ringSize;
+        for (int k = 0; k < ringSize; ++k) {
+            int kNext = (k + 1) % ringSize;
+            shape->nvertsPerFace.push_back(4);
+            shape->faceverts.push_back(inner + k);
+            shape->faceverts.push_back(outer + k);
+            shape->faceverts.push_back(outer + kNext);
+            shape->faceverts.push_back(inner + kNext);
+        }
+    }
+    return shape;
+}
+
+#endif /* PERF_SHAPES_H */
@@ -0,0 +1,1592 @@
+//
+//   Copyright 2026 Pixar
+//
+//   Licensed under the Apache License, Version 2.0 (the "Apache License")
+//   with the following modification; you may not use this file except in
+//   compliance with the Apache License and the following modification to it:
+//   Section 6. Trademarks. is deleted and replaced with:
+//
+//   6. Trademarks. This License does not grant permission to use the trade
+//      names, trademarks, service marks, or product names of the Licensor
+//      and its affiliates, except as required to comply with Section 4(c) of
+//      the License and to reproduce the content of the NOTICE file.
+//
+//   You may obtain a copy of the Apache License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the Apache License with the above modification is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+//   KIND, either express or implied. See the Apache License for the specific
+//   language governing permissions and limitations under the Apache License.
+//
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <opensubdiv/version.h>
+#include <opensubdiv/far/primvarRefiner.h>
+#include <opensubdiv/far/stencilTableFactory.h>
+#include <opensubdiv/far/stencilDependencyMap.h>
+#include <opensubdiv/far/patchTableFactory.h>
+#include <opensubdiv/far/patchMap.h>
+#include <opensubdiv/far/ptexIndices.h>
+#include <opensubdiv/osd/cpuEvaluator.h>
+#include <opensubdiv/osd/cpuPatchTable.h>
+#include <opensubdiv/osd/numaEvaluator.h>
+#include <opensubdiv/osd/numaThreadPool.h>
+#include <opensubdiv/osd/patchBVH.h>
+#include <opensubdiv/osd/threadPoolEvaluator.h>
+#include <opensubdiv/osd/topologyCache.h>
+#ifdef OPENSUBDIV_HAS_OPENMP
+    #include <opensubdiv/osd/ompEvaluator.h>
+#endif
+#ifdef OPENSUBDIV_HAS_TBB
+    #include <opensubdiv/osd/tbbEvaluator.h>
+#endif
+#include <opensubdiv/bfr/refinerSurfaceFactory.h>
+#include <opensubdiv/bfr/surface.h>
+#include <opensubdiv/bfr/tessellation.h>
+
+#include "../../regression/common/far_utils.h"
+#include "../../regression/common/synthetic_mesh.h"
+#include "../../regression/common/obj_mesh.h"
+
+#include "perf_shapes.h"
+
+//------------------------------------------------------------------------------
+//
+//  perf_suite -- micro and macro benchmarks of the performance critical
+//  paths of Far, Osd and Bfr.
+//
+//  Each benchmark times repeated iterations of a single operation on a
+//  mesh until a minimum amount of time has been accumulated, reporting the
+//  mean and minimum time per iteration. Results can be written as JSON and
+//  compared against the JSON results of another build to detect
+//  regressions.
+//
+
+using namespace OpenSubdiv;
+
+//------------------------------------------------------------------------------
+//
+//  State of a running benchmark -- in the style of google-benchmark, the
+//  benchmark loops while KeepRunning() and pauses timing for any setup
+//  that is not to be measured:
+//
+class BenchState {
+public:
+    BenchState(double minTime, int maxIterations) :
+        _minDuration(minTime), _maxIterations(maxIterations),
+        _started(false), _iterations(0), _iterationTime(0),
+        _totalTime(0), _minTime(0), _items(0) { }
+
+    bool KeepRunning() {
+        if (_started) {
+            _iterationTime += secondsSince(_segmentStart);
+
+            _minTime = _iterations ? std::min(_minTime, _iterationTime)
+                                   : _iterationTime;
+            _totalTime += _iterationTime;
+            _iterationTime = 0;
+            ++_iterations;
+
+            //  Also bound the total time, including paused setup:
+            if ((_totalTime >= _minDuration) ||
+                (_iterations >= _maxIterations) ||
+                (secondsSince(_start) >= 10.0 * _minDuration)) {
+                return false;
+            }
+        } else {
+            _started = true;
+            _start = Clock::now();
+        }
+        _segmentStart = Clock::now();
+        return true;
+    }
+
+    void PauseTiming() {
+        _iterationTime += secondsSince(_segmentStart);
+    }
+
+    void ResumeTiming() {
+        _segmentStart = Clock::now();
+    }
+
+    //  Number of items (vertices, patches, ...) processed per iteration
+    void SetItemsProcessed(long items) { _items = items; }
+
+    int    GetIterations() const { return _iterations; }
+    double GetMeanTime() const   { return _iterations ? _totalTime / _iterations : 0; }
+    double GetMinTime() const    { return _minTime; }
+    long   GetItemsProcessed() const { return _items; }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    static double secondsSince(Clock::time_point t) {
+        return std::chrono::duration<double>(Clock::now() - t).count();
+    }
+
+    double _minDuration;
+    int    _maxIterations;
+
+    bool   _started;
+    int    _iterations;
+    double _iterationTime;
+    double _totalTime;
+    double _minTime;
+    long   _items;
+
+    Clock::time_point _start;
+    Clock::time_point _segmentStart;
+};
+
+//------------------------------------------------------------------------------
+//
+//  Data shared by all benchmarks of a mesh -- created once and not timed:
+//
+struct BenchOptions {
+    BenchOptions() :
+        level(2),
+        resolution(32),
+        coordsPerEdge(4),
+        numThreads(0),
+        minTime(0.25),
+        maxIterations(100000),
+        threshold(10.0) { }
+
+    int    level;
+    int    resolution;
+    int    coordsPerEdge;
+    int    numThreads;
+    double minTime;
+    int    maxIterations;
+    double threshold;
+};
+
+struct BenchMesh {
+    BenchMesh() :
+        shape(0), syntheticMesh(0), objMesh(0), positions(0),
+        baseRefiner(0), uniformRefiner(0), adaptiveRefiner(0),
+        stencilTable(0), patchTable(0), patchMap(0), cpuPatchTable(0),
+        numPtexFaces(0) { }
+
+    ~BenchMesh() {
+        delete cpuPatchTable;
+        delete patchMap;
+        delete patchTable;
+        delete stencilTable;
+        delete adaptiveRefiner;
+        delete uniformRefiner;
+        delete baseRefiner;
+        delete objMesh;
+        delete syntheticMesh;
+        delete shape;
+    }
+
+    std::string name;
+    //  Either a procedural Shape, a SyntheticMesh or an ObjMesh:
+    Shape const *         shape;
+    SyntheticMesh const * syntheticMesh;
+    ObjMesh const *       objMesh;
+    float const *         positions;
+
+    int level;
+    int coordsPerEdge;
+
+    Far::PatchTableFactory::Options patchOptions;
+
+    Far::TopologyRefiner * baseRefiner;
+    Far::TopologyRefiner * uniformRefiner;
+    Far::TopologyRefiner * adaptiveRefiner;
+
+    Far::StencilTable const * stencilTable;
+    Far::PatchTable const *   patchTable;
+    Far::PatchMap const *     patchMap;
+    Osd::CpuPatchTable *      cpuPatchTable;
+
+    //  Positions of all base, refined and local points of the adaptive
+    //  refinement:
+    std::vector<float> vertexData;
+
+    //  Coordinates evaluated on each ptex face:
+    int numPtexFaces;
+    std::vector<float> faceS;
+    std::vector<float> faceT;
+    std::vector<Osd::PatchCoord> patchCoords;
+};
+
+namespace {
+    //  Primvar type for Far interpolation of positions:
+    struct Vertex {
+        void Clear(void * = 0) { x = y = z = 0.0f; }
+
+        void AddWithWeight(Vertex const & src, float weight) {
+            x += weight * src.x;
+            y += weight * src.y;
+            z += weight * src.z;
+        }
+
+        float x, y, z;
+    };
+}
+
+static Far::TopologyRefiner *
+createRefiner(BenchMesh const & mesh) {
+
+    typedef Far::TopologyDescriptor Descriptor;
+
+    if (mesh.syntheticMesh) {
+        Descriptor descriptor;
+        mesh.syntheticMesh->GetTopologyDescriptor(descriptor);
+
+        Sdc::Options sdcOptions;
+        sdcOptions.SetVtxBoundaryInterpolation(
+            Sdc::Options::VTX_BOUNDARY_EDGE_ONLY);
+
+        return Far::TopologyRefinerFactory<Descriptor>::Create(descriptor,
+            Far::TopologyRefinerFactory<Descriptor>::Options(
+                Sdc::SCHEME_CATMARK, sdcOptions));
+    }
+    if (mesh.objMesh) {
+        Descriptor descriptor;
+        mesh.objMesh->GetTopologyDescriptor(descriptor);
+
+        return Far::TopologyRefinerFactory<Descriptor>::Create(descriptor,
+            Far::TopologyRefinerFactory<Descriptor>::Options(
+                Sdc::SCHEME_CATMARK, mesh.objMesh->sdcOptions));
+    }
+    return Far::TopologyRefinerFactory<Shape>::Create(*mesh.shape,
+        Far::TopologyRefinerFactory<Shape>::Options(
+            GetSdcType(*mesh.shape), GetSdcOptions(*mesh.shape)));
+}
+
+static BenchMesh *
+createBenchMesh(std::string const & name, Shape const * shape,
+                SyntheticMesh const * syntheticMesh, ObjMesh const * objMesh,
+                BenchOptions const & options) {
+
+    BenchMesh * mesh = new BenchMesh;
+    mesh->name = name;
+    mesh->shape = shape;
+    mesh->syntheticMesh = syntheticMesh;
+    mesh->objMesh = objMesh;
+    mesh->positions = syntheticMesh ? &syntheticMesh->positions[0] :
+                      objMesh       ? &objMesh->positions[0]
+                                    : &shape->verts[0];
+    mesh->level = options.level;
+    mesh->coordsPerEdge = options.coordsPerEdge;
+
+    mesh->patchOptions = Far::PatchTableFactory::Options(options.level);
+    mesh->patchOptions.SetEndCapType(
+        Far::PatchTableFactory::Options::ENDCAP_GREGORY_BASIS);
+
+    mesh->baseRefiner = createRefiner(*mesh);
+
+    mesh->uniformRefiner = createRefiner(*mesh);
+    mesh->uniformRefiner->RefineUniform(
+        Far::TopologyRefiner::UniformOptions(options.level));
+
+    mesh->adaptiveRefiner = createRefiner(*mesh);
+    mesh->adaptiveRefiner->RefineAdaptive(
+        mesh->patchOptions.GetRefineAdaptiveOptions());
+
+    Far::TopologyRefiner const & refiner = *mesh->adaptiveRefiner;
+
+    //  Stencils for all refined and local points:
+    Far::StencilTableFactory::Options stencilOptions;
+    stencilOptions.generateOffsets = true;
+    stencilOptions.generateIntermediateLevels = true;
+
+    Far::StencilTable const * stencilTable =
+        Far::StencilTableFactory::Create(refiner, stencilOptions);
+
+    mesh->patchTable = Far::PatchTableFactory::Create(refiner,
+                                                      mesh->patchOptions);
+
+    if (Far::StencilTable const * stencilTableWithLocalPoints =
+        Far::StencilTableFactory::AppendLocalPointStencilTable(refiner,
+            stencilTable, mesh->patchTable->GetLocalPointStencilTable())) {
+        delete stencilTable;
+        stencilTable = stencilTableWithLocalPoints;
+    }
+    mesh->stencilTable = stencilTable;
+
+    mesh->patchMap = new Far::PatchMap(*mesh->patchTable);
+    mesh->cpuPatchTable = Osd::CpuPatchTable::Create(mesh->patchTable);
+
+    int numCoarseVerts = refiner.GetLevel(0).GetNumVertices();
+    int numVerts = numCoarseVerts + stencilTable->GetNumStencils();
+
+    mesh->vertexData.resize(numVerts * 3, 0.0f);
+    std::copy(mesh->positions, mesh->positions + numCoarseVerts * 3,
+              mesh->vertexData.begin());
+
+    Vertex * vertices = reinterpret_cast<Vertex *>(&mesh->vertexData[0]);
+    stencilTable->UpdateValues(vertices, vertices + numCoarseVerts);
+
+    //  A uniform grid of coordinates on each ptex face:
+    int n = options.coordsPerEdge;
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i < n; ++i) {
+            mesh->faceS.push_back(((float)i + 0.5f) / (float)n);
+            mesh->faceT.push_back(((float)j + 0.5f) / (float)n);
+        }
+    }
+
+    mesh->numPtexFaces = Far::PtexIndices(refiner).GetNumFaces();
+    for (int face = 0; face < mesh->numPtexFaces; ++face) {
+        for (int i = 0; i < (int)mesh->faceS.size(); ++i) {
+            float s = mesh->faceS[i];
+            float t = mesh->faceT[i];
+            //  No patches are found for holes:
+            if (Far::PatchTable::PatchHandle const * handle =
+                mesh->patchMap->FindPatch(face, s, t)) {
+                mesh->patchCoords.push_back(Osd::PatchCoord(*handle, s, t));
+            }
+        }
+    }
+    return mesh;
+}
+
+//------------------------------------------------------------------------------
+//
+//  Far benchmarks:
+//
+namespace {
+    //  Topology of the base level of a mesh in the form of a descriptor,
+    //  including the edges to be optionally specified:
+    struct BaseTopology {
+        BaseTopology(Far::TopologyRefiner const & refiner) {
+            Far::TopologyLevel const & level = refiner.GetLevel(0);
+
+            for (int face = 0; face < level.GetNumFaces(); ++face) {
+                Far::ConstIndexArray fVerts = level.GetFaceVertices(face);
+                Far::ConstIndexArray fEdges = level.GetFaceEdges(face);
+
+                faceSizes.push_back(fVerts.size());
+                faceVerts.insert(faceVerts.end(), fVerts.begin(), fVerts.end());
+                faceEdges.insert(faceEdges.end(), fEdges.begin(), fEdges.end());
+            }
+            for (int edge = 0; edge < level.GetNumEdges(); ++edge) {
+                Far::ConstIndexArray eVerts = level.GetEdgeVertices(edge);
+                edgeVerts.insert(edgeVerts.end(), eVerts.begin(), eVerts.end());
+            }
+            descriptor.numVertices = level.GetNumVertices();
+            descriptor.numFaces = level.GetNumFaces();
+            descriptor.numVertsPerFace = &faceSizes[0];
+            descriptor.vertIndicesPerFace = &faceVerts[0];
+
+            options = Factory::Options(refiner.GetSchemeType(),
+                                       refiner.GetSchemeOptions());
+        }
+
+        void SpecifyEdges() {
+            descriptor.numEdges = (int)edgeVerts.size() / 2;
+            descriptor.edgeVertIndices = &edgeVerts[0];
+            descriptor.edgeIndicesPerFace = &faceEdges[0];
+        }
+
+        typedef Far::TopologyRefinerFactory<Far::TopologyDescriptor> Factory;
+
+        std::vector<int> faceSizes;
+        std::vector<int> faceVerts;
+        std::vector<int> faceEdges;
+        std::vector<int> edgeVerts;
+
+        Far::TopologyDescriptor descriptor;
+        Factory::Options        options;
+    };
+}
+
+static void
+benchTopologyRefinerFactory(BenchState & state, BenchMesh const & mesh,
+                            bool specifyEdges) {
+
+    BaseTopology topology(*mesh.baseRefiner);
+    if (specifyEdges) {
+        topology.SpecifyEdges();
+    }
+
+    while (state.KeepRunning()) {
+        Far::TopologyRefiner * refiner =
+            BaseTopology::Factory::Create(topology.descriptor,
+                                          topology.options);
+
+        state.PauseTiming();
+        state.SetItemsProcessed(refiner->GetLevel(0).GetNumFaces());
+        delete refiner;
+        state.ResumeTiming();
+    }
+}
+
+static void
+benchTopologyRefinerFactoryCreate(BenchState & state, BenchMesh const & mesh) {
+
+    benchTopologyRefinerFactory(state, mesh, false);
+}
+
+static void
+benchTopologyRefinerFactoryCreateWithEdges(BenchState & state,
+                                           BenchMesh const & mesh) {
+
+    benchTopologyRefinerFactory(state, mesh, true);
+}
+
+static void
+benchRefineUniform(BenchState & state, BenchMesh const & mesh) {
+
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        Far::TopologyRefiner * refiner = createRefiner(mesh);
+        state.ResumeTiming();
+
+        refiner->RefineUniform(
+            Far::TopologyRefiner::UniformOptions(mesh.level));
+
+        state.PauseTiming();
+        state.SetItemsProcessed(refiner->GetNumFacesTotal());
+        delete refiner;
+        state.ResumeTiming();
+    }
+}
+
+static void
+benchRefineAdaptive(BenchState & state, BenchMesh const & mesh) {
+
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        Far::TopologyRefiner * refiner = createRefiner(mesh);
+        state.ResumeTiming();
+
+        refiner->RefineAdaptive(mesh.patchOptions.GetRefineAdaptiveOptions());
+
+        state.PauseTiming();
+        state.SetItemsProcessed(refiner->GetNumFacesTotal());
+        delete refiner;
+        state.ResumeTiming();
+    }
+}
+
+static void
+benchStencilTableFactory(BenchState & state, BenchMesh const & mesh) {
+
+    Far::StencilTableFactory::Options options;
+    options.generateOffsets = true;
+    options.generateIntermediateLevels = true;
+
+    while (state.KeepRunning()) {
+        Far::StencilTable const * stencilTable =
+            Far::StencilTableFactory::Create(*mesh.adaptiveRefiner, options);
+
+        state.PauseTiming();
+        state.SetItemsProcessed(stencilTable->GetNumStencils());
+        delete stencilTable;
+        state.ResumeTiming();
+    }
+}
+
+static void
+benchLimitStencilTableFactory(BenchState & state, BenchMesh const & mesh) {
+
+    Far::LimitStencilTableFactory::LocationArrayVec locations(
+        mesh.numPtexFaces);
+    for (int face = 0; face < mesh.numPtexFaces; ++face) {
+        locations[face].ptexIdx = face;
+        locations[face].numLocations = (int)mesh.faceS.size();
+        locations[face].s = &mesh.faceS[0];
+        locations[face].t = &mesh.faceT[0];
+    }
+
+    //  The given stencils must also include the control vertices (and the
+    //  local points, which would otherwise be appended on each iteration):
+    Far::StencilTableFactory::Options options;
+    options.generateControlVerts = true;
+    options.generateOffsets = true;
+    options.generateIntermediateLevels = true;
+
+    Far::StencilTable const * cvStencils =
+        Far::StencilTableFactory::Create(*mesh.adaptiveRefiner, options);
+
+    if (Far::StencilTable const * cvStencilsWithLocalPoints =
+        Far::StencilTableFactory::AppendLocalPointStencilTable(
+            *mesh.adaptiveRefiner, cvStencils,
+            mesh.patchTable->GetLocalPointStencilTable())) {
+        delete cvStencils;
+        cvStencils = cvStencilsWithLocalPoints;
+    }
+
+    while (state.KeepRunning()) {
+        Far::LimitStencilTable const * limitStencilTable =
+            Far::LimitStencilTableFactory::Create(*mesh.adaptiveRefiner,
+                locations, cvStencils, mesh.patchTable);
+
+        state.PauseTiming();
+        state.SetItemsProcessed(limitStencilTable->GetNumStencils());
+        delete limitStencilTable;
+        state.ResumeTiming();
+    }
+    delete cvStencils;
+}
+
+static void
+benchPatchTableFactory(BenchState & state, BenchMesh const & mesh) {
+
+    while (state.KeepRunning()) {
+        Far::PatchTable const * patchTable =
+            Far::PatchTableFactory::Create(*mesh.adaptiveRefiner,
+                                           mesh.patchOptions);
+
+        state.PauseTiming();
+        state.SetItemsProcessed(patchTable->GetNumPatchesTotal());
+        delete patchTable;
+        state.ResumeTiming();
+    }
+}
+
+//  Sink for results that must not be optimized away:
+static volatile long g_sink = 0;
+
+static void
+benchPatchMapFindPatch(BenchState & state, BenchMesh const & mesh) {
+
+    int numCoords = (int)mesh.faceS.size();
+
+    while (state.KeepRunning()) {
+        long checksum = 0;
+        for (int face = 0; face < mesh.numPtexFaces; ++face) {
+            for (int i = 0; i < numCoords; ++i) {
+                Far::PatchTable::PatchHandle const * handle =
+                    mesh.patchMap->FindPatch(face, mesh.faceS[i],
+                                                   mesh.faceT[i]);
+                checksum += handle ? handle->patchIndex : 0;
+            }
+        }
+        g_sink = checksum;
+    }
+    state.SetItemsProcessed((long)mesh.numPtexFaces * numCoords);
+}
+
+static void
+benchPrimvarRefiner(BenchState & state, BenchMesh const & mesh) {
+
+    Far::TopologyRefiner const & refiner = *mesh.uniformRefiner;
+    Far::PrimvarRefiner primvarRefiner(refiner);
+
+    std::vector<Vertex> vertices(refiner.GetNumVerticesTotal());
+    memcpy(&vertices[0], mesh.positions,
+           refiner.GetLevel(0).GetNumVertices() * sizeof(Vertex));
+
+    while (state.KeepRunning()) {
+        Vertex * src = &vertices[0];
+        for (int level = 1; level <= refiner.GetMaxLevel(); ++level) {
+            Vertex * dst = src + refiner.GetLevel(level - 1).GetNumVertices();
+            primvarRefiner.Interpolate(level, src, dst);
+            src = dst;
+        }
+    }
+    state.SetItemsProcessed(refiner.GetNumVerticesTotal() -
+                            refiner.GetLevel(0).GetNumVertices());
+}
+
+//------------------------------------------------------------------------------
+//
+//  Osd benchmarks -- for each of the CPU evaluators:
+//
+template <class EVALUATOR>
+static void
+benchEvalStencils(BenchState & state, BenchMesh const & mesh) {
+
+    Far::StencilTable const & stencilTable = *mesh.stencilTable;
+
+    std::vector<float> vertexData(mesh.vertexData);
+
+    int numCoarseVerts = mesh.adaptiveRefiner->GetLevel(0).GetNumVertices();
+    int numStencils = stencilTable.GetNumStencils();
+
+    Osd::BufferDescriptor srcDesc(0, 3, 3);
+    Osd::BufferDescriptor dstDesc(numCoarseVerts * 3, 3, 3);
+
+    while (state.KeepRunning()) {
+        EVALUATOR::EvalStencils(&vertexData[0], srcDesc,
+                                &vertexData[0], dstDesc,
+                                &stencilTable.GetSizes()[0],
+                                &stencilTable.GetOffsets()[0],
+                                &stencilTable.GetControlIndices()[0],
+                                &stencilTable.GetWeights()[0],
+                                0, numStencils);
+    }
+    state.SetItemsProcessed(numStencils);
+}
+
+//  Evaluation of the stencils partitioned across the NUMA nodes (with the
+//  copy of the partitions excluded from the timing):
+static void
+benchNumaEvalStencils(BenchState & state, BenchMesh const & mesh) {
+
+    static Osd::NumaThreadPool threadPool;
+
+    Osd::NumaStencilTable * stencilTable =
+        Osd::NumaStencilTable::Create(mesh.stencilTable, &threadPool);
+
+    std::vector<float> vertexData(mesh.vertexData);
+
+    int numCoarseVerts = mesh.adaptiveRefiner->GetLevel(0).GetNumVertices();
+    int numStencils = stencilTable->GetNumStencils();
+
+    Osd::BufferDescriptor srcDesc(0, 3, 3);
+    Osd::BufferDescriptor dstDesc(numCoarseVerts * 3, 3, 3);
+
+    while (state.KeepRunning()) {
+        Osd::NumaEvaluator::EvalStencils(&vertexData[0], srcDesc,
+                                         &vertexData[0], dstDesc,
+                                         stencilTable);
+    }
+    state.SetItemsProcessed(numStencils);
+
+    delete stencilTable;
+}
+
+//  Re-evaluation of the stencils affected by a "brush" moving a contiguous
+//  range of about 1% of the control vertices (at least one), including the
+//  gathering of the affected stencils from the dependency map:
+template <class EVALUATOR>
+static void
+benchEvalStencilsSubset(BenchState & state, BenchMesh const & mesh) {
+
+    Far::StencilTable const & stencilTable = *mesh.stencilTable;
+    Far::StencilDependencyMap dependencyMap(stencilTable);
+
+    std::vector<float> vertexData(mesh.vertexData);
+
+    int numCoarseVerts = mesh.adaptiveRefiner->GetLevel(0).GetNumVertices();
+
+    std::vector<Far::Index> brush(std::max(1, numCoarseVerts / 100));
+    for (int i = 0; i < (int)brush.size(); ++i) {
+        brush[i] = (numCoarseVerts - (int)brush.size()) / 2 + i;
+    }
+
+    Osd::BufferDescriptor srcDesc(0, 3, 3);
+    Osd::BufferDescriptor dstDesc(numCoarseVerts * 3, 3, 3);
+
+    std::vector<Far::Index> stencils;
+    while (state.KeepRunning()) {
+        dependencyMap.GetDependentStencils(
+            Far::ConstIndexArray(&brush[0], (int)brush.size()), stencils);
+
+        EVALUATOR::EvalStencilsSubset(&vertexData[0], srcDesc,
+                                      &vertexData[0], dstDesc,
+                                      &stencilTable.GetSizes()[0],
+                                      &stencilTable.GetOffsets()[0],
+                                      &stencilTable.GetControlIndices()[0],
+                                      &stencilTable.GetWeights()[0],
+                                      (int)stencils.size(),
+                                      stencils.empty() ? 0 : &stencils[0]);
+    }
+    state.SetItemsProcessed((long)stencils.size());
+}
+
+template <class EVALUATOR>
+static void
+benchEvalPatches(BenchState & state, BenchMesh const & mesh) {
+
+    int numCoords = (int)mesh.patchCoords.size();
+
+    std::vector<float> P(numCoords * 3), dPdu(numCoords * 3),
+                       dPdv(numCoords * 3);
+
+    Osd::BufferDescriptor srcDesc(0, 3, 3);
+    Osd::BufferDescriptor dstDesc(0, 3, 3);
+
+    while (state.KeepRunning()) {
+        EVALUATOR::EvalPatches(&mesh.vertexData[0], srcDesc,
+                               &P[0], dstDesc,
+                               &dPdu[0], dstDesc,
+                               &dPdv[0], dstDesc,
+                               numCoords, &mesh.patchCoords[0],
+                               mesh.cpuPatchTable->GetPatchArrayBuffer(),
+                               mesh.cpuPatchTable->GetPatchIndexBuffer(),
+                               mesh.cpuPatchTable->GetPatchParamBuffer());
+    }
+    state.SetItemsProcessed(numCoords);
+}
+
+template <class EVALUATOR>
+static void
+benchEvalPatchesNormals(BenchState & state, BenchMesh const & mesh) {
+
+    int numCoords = (int)mesh.patchCoords.size();
+
+    //  Positions and normals interleaved in the output:
+    std::vector<float> PN(numCoords * 6);
+
+    Osd::BufferDescriptor srcDesc(0, 3, 3);
+    Osd::BufferDescriptor dstDesc(0, 3, 6);
+    Osd::BufferDescriptor normalDesc(3, 3, 6);
+
+    while (state.KeepRunning()) {
+        EVALUATOR::EvalPatchesNormals(&mesh.vertexData[0], srcDesc,
+                                      &PN[0], dstDesc,
+                                      &PN[0], normalDesc,
+                                      (float *)0, Osd::BufferDescriptor(),
+                                      (float *)0, Osd::BufferDescriptor(),
+                                      numCoords, &mesh.patchCoords[0],
+                                      mesh.cpuPatchTable->GetPatchArrayBuffer(),
+                                      mesh.cpuPatchTable->GetPatchIndexBuffer(),
+                                      mesh.cpuPatchTable->GetPatchParamBuffer());
+    }
+    state.SetItemsProcessed(numCoords);
+}
+
+template <class EVALUATOR>
+static void
+benchEvalPatchesPacked(BenchState & state, BenchMesh const & mesh) {
+
+    int numCoords = (int)mesh.patchCoords.size();
+
+    //  Half float positions and octahedral normals in 16 byte vertices:
+    std::vector<unsigned char> PN(numCoords * 16);
+
+    Osd::BufferDescriptor srcDesc(0, 3, 3);
+    Osd::PackedBufferDescriptor dstDesc(0, 3, 16,
+        Osd::PackedBufferDescriptor::FORMAT_HALF);
+    Osd::PackedBufferDescriptor normalDesc(8, 3, 16,
+        Osd::PackedBufferDescriptor::FORMAT_OCT16);
+
+    while (state.KeepRunning()) {
+        EVALUATOR::EvalPatchesPacked(&mesh.vertexData[0], srcDesc,
+                                     &PN[0], dstDesc,
+                                     &PN[0], normalDesc,
+                                     numCoords, &mesh.patchCoords[0],
+                                     mesh.cpuPatchTable->GetPatchArrayBuffer(),
+                                     mesh.cpuPatchTable->GetPatchIndexBuffer(),
+                                     mesh.cpuPatchTable->GetPatchParamBuffer());
+    }
+    state.SetItemsProcessed(numCoords);
+}
+
+static void
+benchPatchBVHCreate(BenchState & state, BenchMesh const & mesh) {
+
+    Osd::PatchBVH::Options options;
+    options.threadPool = Osd::ThreadPoolEvaluator::GetThreadPool();
+
+    while (state.KeepRunning()) {
+        Osd::PatchBVH * bvh = Osd::PatchBVH::Create(*mesh.patchTable,
+                                                    &mesh.vertexData[0], 3,
+                                                    options);
+        state.PauseTiming();
+        state.SetItemsProcessed(bvh->GetNumSubPatches());
+        delete bvh;
+        state.ResumeTiming();
+    }
+}
+
+static void
+benchPatchBVHIntersect(BenchState & state, BenchMesh const & mesh) {
+
+    int numCoords = (int)mesh.patchCoords.size();
+
+    Osd::PatchBVH::Options options;
+    options.threadPool = Osd::ThreadPoolEvaluator::GetThreadPool();
+
+    Osd::PatchBVH * bvh = Osd::PatchBVH::Create(*mesh.patchTable,
+                                                &mesh.vertexData[0], 3,
+                                                options);
+
+    //  Rays toward the limit surface at each coordinate, along the normal
+    //  from a short distance above it:
+    std::vector<float> P(numCoords * 3), dPdu(numCoords * 3),
+                       dPdv(numCoords * 3);
+
+    Osd::BufferDescriptor desc(0, 3, 3);
+    Osd::CpuEvaluator::EvalPatches(&mesh.vertexData[0], desc,
+                                   &P[0], desc, &dPdu[0], desc, &dPdv[0], desc,
+                                   numCoords, &mesh.patchCoords[0],
+                                   mesh.cpuPatchTable->GetPatchArrayBuffer(),
+                                   mesh.cpuPatchTable->GetPatchIndexBuffer(),
+                                   mesh.cpuPatchTable->GetPatchParamBuffer());
+
+    std::vector<Osd::PatchBVH::Ray> rays(numCoords);
+    std::vector<Osd::PatchBVH::Hit> hits(numCoords);
+    for (int i = 0; i < numCoords; ++i) {
+        float const * du = &dPdu[3 * i];
+        float const * dv = &dPdv[3 * i];
+        float N[3] = { du[1] * dv[2] - du[2] * dv[1],
+                       du[2] * dv[0] - du[0] * dv[2],
+                       du[0] * dv[1] - du[1] * dv[0] };
+        float len = std::sqrt(N[0] * N[0] + N[1] * N[1] + N[2] * N[2]);
+        if (len == 0.0f) len = 1.0f;
+
+        Osd::PatchBVH::Ray & ray = rays[i];
+        for (int k = 0; k < 3; ++k) {
+            ray.direction[k] = -N[k] / len;
+            ray.origin[k]    = P[3 * i + k] + 0.01f * N[k] / len;
+        }
+        ray.tMin = 0.0f;
+        ray.tMax = 1.0e30f;
+    }
+
+    while (state.KeepRunning()) {
+        g_sink = bvh->IntersectStream(numCoords, &rays[0], &hits[0],
+                                      options.threadPool);
+    }
+    state.SetItemsProcessed(numCoords);
+
+    delete bvh;
+}
+
+static void
+benchPatchBVHClosestPoints(BenchState & state, BenchMesh const & mesh) {
+
+    int numCoords = (int)mesh.patchCoords.size();
+
+    Osd::PatchBVH::Options options;
+    options.threadPool = Osd::ThreadPoolEvaluator::GetThreadPool();
+
+    Osd::PatchBVH * bvh = Osd::PatchBVH::Create(*mesh.patchTable,
+                                                &mesh.vertexData[0], 3,
+                                                options);
+
+    //  Points displaced from the limit surface at each coordinate:
+    std::vector<float> P(numCoords * 3), dPdu(numCoords * 3),
+                       dPdv(numCoords * 3);
+
+    Osd::BufferDescriptor desc(0, 3, 3);
+    Osd::CpuEvaluator::EvalPatches(&mesh.vertexData[0], desc,
+                                   &P[0], desc, &dPdu[0], desc, &dPdv[0], desc,
+                                   numCoords, &mesh.patchCoords[0],
+                                   mesh.cpuPatchTable->GetPatchArrayBuffer(),
+                                   mesh.cpuPatchTable->GetPatchIndexBuffer(),
+                                   mesh.cpuPatchTable->GetPatchParamBuffer());
+
+    for (int i = 0; i < numCoords; ++i) {
+        for (int k = 0; k < 3; ++k) {
+            P[3 * i + k] += 0.1f * (dPdu[3 * i + k] - dPdv[3 * i + k]);
+        }
+    }
+
+    std::vector<Osd::PatchBVH::ClosestPoint> closest(numCoords);
+
+    while (state.KeepRunning()) {
+        g_sink = bvh->FindClosestPoints(numCoords, &P[0], 3, 1.0e30f,
+                                        &closest[0], options.threadPool);
+    }
+    state.SetItemsProcessed(numCoords);
+
+    delete bvh;
+}
+
+static void
+benchTopologyCacheComputeKey(BenchState & state, BenchMesh const & mesh) {
+
+    //  Procedural shapes are described by their faces only:
+    Far::TopologyDescriptor descriptor;
+    if (mesh.syntheticMesh) {
+        mesh.syntheticMesh->GetTopologyDescriptor(descriptor);
+    } else if (mesh.objMesh) {
+        mesh.objMesh->GetTopologyDescriptor(descriptor);
+    } else {
+        descriptor.numVertices = (int)mesh.shape->verts.size() / 3;
+        descriptor.numFaces = (int)mesh.shape->nvertsPerFace.size();
+        descriptor.numVertsPerFace = &mesh.shape->nvertsPerFace[0];
+        descriptor.vertIndicesPerFace = &mesh.shape->faceverts[0];
+    }
+
+    Osd::TopologyCache::Options options;
+    options.patchOptions = mesh.patchOptions;
+
+    Osd::ThreadPool * threadPool = Osd::ThreadPoolEvaluator::GetThreadPool();
+
+    while (state.KeepRunning()) {
+        Osd::TopologyCache::Key key =
+            Osd::TopologyCache::ComputeKey(descriptor, options, threadPool);
+        g_sink = (long)key.hash[0];
+    }
+    state.SetItemsProcessed(descriptor.numFaces);
+}
+
+//------------------------------------------------------------------------------
+//
+//  Bfr benchmarks:
+//
+typedef Bfr::RefinerSurfaceFactory<> SurfaceFactory;
+typedef Bfr::Surface<float>          Surface;
+
+static void
+benchBfrSurfaceFactory(BenchState & state, BenchMesh const & mesh) {
+
+    Surface surface;
+
+    int numFaces = mesh.baseRefiner->GetLevel(0).GetNumFaces();
+
+    while (state.KeepRunning()) {
+        //  A new factory (and cache) per iteration to include cache misses:
+        state.PauseTiming();
+        SurfaceFactory * factory = new SurfaceFactory(*mesh.baseRefiner);
+        state.ResumeTiming();
+
+        for (int face = 0; face < numFaces; ++face) {
+            factory->InitVertexSurface(face, &surface);
+        }
+
+        state.PauseTiming();
+        delete factory;
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(numFaces);
+}
+
+namespace {
+    //  Surfaces and patch points of all faces, initialized for evaluation:
+    struct BfrFaceSurfaces {
+        BfrFaceSurfaces(BenchMesh const & mesh) {
+            SurfaceFactory factory(*mesh.baseRefiner);
+
+            int numFaces = mesh.baseRefiner->GetLevel(0).GetNumFaces();
+
+            surfaces.resize(numFaces);
+            patchPointOffsets.resize(numFaces + 1, 0);
+            for (int face = 0; face < numFaces; ++face) {
+                factory.InitVertexSurface(face, &surfaces[face]);
+
+                patchPointOffsets[face + 1] = patchPointOffsets[face] +
+                    surfaces[face].GetNumPatchPoints() * 3;
+            }
+
+            patchPoints.resize(patchPointOffsets[numFaces]);
+            for (int face = 0; face < numFaces; ++face) {
+                if (surfaces[face].IsValid()) {
+                    surfaces[face].PreparePatchPoints(
+                        mesh.positions, 3,
+                        &patchPoints[patchPointOffsets[face]], 3);
+                }
+            }
+        }
+
+        std::vector<Surface> surfaces;
+        std::vector<int>     patchPointOffsets;
+        std::vector<float>   patchPoints;
+    };
+}
+
+static void
+benchBfrSurfaceEvaluate(BenchState & state, BenchMesh const & mesh) {
+
+    BfrFaceSurfaces faces(mesh);
+
+    int numFaces = (int)faces.surfaces.size();
+
+    //  Evaluate the vertices of a uniform tessellation of each face:
+    std::vector<int>   coordOffsets(numFaces + 1, 0);
+    std::vector<float> coords;
+    for (int face = 0; face < numFaces; ++face) {
+        coordOffsets[face + 1] = coordOffsets[face];
+
+        Surface const & surface = faces.surfaces[face];
+        if (!surface.IsValid()) continue;
+
+        Bfr::Tessellation tess(surface.GetParameterization(),
+                               mesh.coordsPerEdge);
+        coords.resize(coords.size() + tess.GetNumCoords() * 2);
+        tess.GetCoords(&coords[coordOffsets[face] * 2]);
+
+        coordOffsets[face + 1] += tess.GetNumCoords();
+    }
+
+    float P[3], dPdu[3], dPdv[3];
+
+    while (state.KeepRunning()) {
+        for (int face = 0; face < numFaces; ++face) {
+            Surface const & surface = faces.surfaces[face];
+            if (!surface.IsValid()) continue;
+
+            float const * patchPoints =
+                &faces.patchPoints[faces.patchPointOffsets[face]];
+            for (int i = coordOffsets[face]; i < coordOffsets[face+1]; ++i) {
+                surface.Evaluate(&coords[2 * i], patchPoints, 3,
+                                 P, dPdu, dPdv);
+            }
+        }
+    }
+    state.SetItemsProcessed(coordOffsets[numFaces]);
+}
+
+static void
+benchBfrSurfaceEvaluateGrid(BenchState & state, BenchMesh const & mesh) {
+
+    BfrFaceSurfaces faces(mesh);
+
+    int numFaces = (int)faces.surfaces.size();
+
+    //  Evaluate a grid of the same resolution as the tessellation of each
+    //  quad face (other faces are skipped):
+    int N = std::max(mesh.coordsPerEdge + 1, 2);
+
+    std::vector<float> gridCoords(N);
+    for (int i = 0; i < N; ++i) {
+        gridCoords[i] = (float)i / (float)(N - 1);
+    }
+
+    std::vector<float> P(N * N * 3), dPdu(N * N * 3), dPdv(N * N * 3);
+
+    long numCoords = 0;
+    for (int face = 0; face < numFaces; ++face) {
+        Surface const & surface = faces.surfaces[face];
+        if (surface.IsValid() && (surface.GetFaceSize() == 4)) {
+            numCoords += N * N;
+        }
+    }
+
+    while (state.KeepRunning()) {
+        for (int face = 0; face < numFaces; ++face) {
+            Surface const & surface = faces.surfaces[face];
+            if (!surface.IsValid() || (surface.GetFaceSize() != 4)) continue;
+
+            float const * patchPoints =
+                &faces.patchPoints[faces.patchPointOffsets[face]];
+            surface.EvaluateGrid(N, &gridCoords[0], N, &gridCoords[0],
+                                 patchPoints, 3, &P[0], &dPdu[0], &dPdv[0]);
+        }
+    }
+    state.SetItemsProcessed(numCoords);
+}
+
+static void
+benchBfrTessellation(BenchState & state, BenchMesh const & mesh) {
+
+    BfrFaceSurfaces faces(mesh);
+
+    int numFaces = (int)faces.surfaces.size();
+
+    std::vector<float> coords;
+    std::vector<int>   facets;
+
+    while (state.KeepRunning()) {
+        for (int face = 0; face < numFaces; ++face) {
+            Surface const & surface = faces.surfaces[face];
+            if (!surface.IsValid()) continue;
+
+            Bfr::Tessellation tess(surface.GetParameterization(),
+                                   mesh.coordsPerEdge);
+
+            coords.resize(tess.GetNumCoords() * 2);
+            tess.GetCoords(&coords[0]);
+
+            facets.resize(tess.GetNumFacets() * tess.GetFacetSize());
+            tess.GetFacets(&facets[0]);
+        }
+    }
+    state.SetItemsProcessed(numFaces);
+}
+
+//------------------------------------------------------------------------------
+
+typedef void (*BenchFunc)(BenchState & state, BenchMesh const & mesh);
+
+struct BenchDesc {
+    char const * name;
+    BenchFunc    func;
+};
+
+static BenchDesc const g_benchmarks[] = {
+    { "TopologyRefinerFactory::Create",      benchTopologyRefinerFactoryCreate },
+    { "TopologyRefinerFactory::CreateWithEdges", benchTopologyRefinerFactoryCreateWithEdges },
+    { "TopologyRefiner::RefineUniform",      benchRefineUniform },
+    { "TopologyRefiner::RefineAdaptive",     benchRefineAdaptive },
+    { "StencilTableFactory::Create",         benchStencilTableFactory },
+    { "LimitStencilTableFactory::Create",    benchLimitStencilTableFactory },
+    { "PatchTableFactory::Create",           benchPatchTableFactory },
+    { "PatchMap::FindPatch",                 benchPatchMapFindPatch },
+    { "PrimvarRefiner::Interpolate",         benchPrimvarRefiner },
+
+    { "CpuEvaluator::EvalStencils",          benchEvalStencils<Osd::CpuEvaluator> },
+    { "CpuEvaluator::EvalStencilsSubset",    benchEvalStencilsSubset<Osd::CpuEvaluator> },
+    { "CpuEvaluator::EvalPatches",           benchEvalPatches<Osd::CpuEvaluator> },
+    { "CpuEvaluator::EvalPatchesNormals",    benchEvalPatchesNormals<Osd::CpuEvaluator> },
+    { "CpuEvaluator::EvalPatchesPacked",     benchEvalPatchesPacked<Osd::CpuEvaluator> },
+#ifdef OPENSUBDIV_HAS_OPENMP
+    { "OmpEvaluator::EvalStencils",          benchEvalStencils<Osd::OmpEvaluator> },
+    { "OmpEvaluator::EvalStencilsSubset",    benchEvalStencilsSubset<Osd::OmpEvaluator> },
+    { "OmpEvaluator::EvalPatches",           benchEvalPatches<Osd::OmpEvaluator> },
+    { "OmpEvaluator::EvalPatchesNormals",    benchEvalPatchesNormals<Osd::OmpEvaluator> },
+    { "OmpEvaluator::EvalPatchesPacked",     benchEvalPatchesPacked<Osd::OmpEvaluator> },
+#endif
+#ifdef OPENSUBDIV_HAS_TBB
+    { "TbbEvaluator::EvalStencils",          benchEvalStencils<Osd::TbbEvaluator> },
+    { "TbbEvaluator::EvalStencilsSubset",    benchEvalStencilsSubset<Osd::TbbEvaluator> },
+    { "TbbEvaluator::EvalPatches",           benchEvalPatches<Osd::TbbEvaluator> },
+    { "TbbEvaluator::EvalPatchesNormals",    benchEvalPatchesNormals<Osd::TbbEvaluator> },
+    { "TbbEvaluator::EvalPatchesPacked",     benchEvalPatchesPacked<Osd::TbbEvaluator> },
+#endif
+    { "ThreadPoolEvaluator::EvalStencils",   benchEvalStencils<Osd::ThreadPoolEvaluator> },
+    { "ThreadPoolEvaluator::EvalStencilsSubset", benchEvalStencilsSubset<Osd::ThreadPoolEvaluator> },
+    { "ThreadPoolEvaluator::EvalPatches",    benchEvalPatches<Osd::ThreadPoolEvaluator> },
+    { "ThreadPoolEvaluator::EvalPatchesNormals", benchEvalPatchesNormals<Osd::ThreadPoolEvaluator> },
+    { "ThreadPoolEvaluator::EvalPatchesPacked", benchEvalPatchesPacked<Osd::ThreadPoolEvaluator> },
+    { "NumaEvaluator::EvalStencils",         benchNumaEvalStencils },
+    { "PatchBVH::Create",                    benchPatchBVHCreate },
+    { "PatchBVH::IntersectStream",           benchPatchBVHIntersect },
+    { "PatchBVH::FindClosestPoints",         benchPatchBVHClosestPoints },
+    { "TopologyCache::ComputeKey",           benchTopologyCacheComputeKey },
+
+    { "Bfr::SurfaceFactory::InitVertexSurface", benchBfrSurfaceFactory },
+    { "Bfr::Surface::Evaluate",              benchBfrSurfaceEvaluate },
+    { "Bfr::Surface::EvaluateGrid",          benchBfrSurfaceEvaluateGrid },
+    { "Bfr::Tessellation",                   benchBfrTessellation },
+};
+
+static int const g_numBenchmarks =
+    (int)(sizeof(g_benchmarks) / sizeof(g_benchmarks[0]));
+
+struct BenchResult {
+    std::string name;
+    int    iterations;
+    double meanTime;
+    double minTime;
+    long   items;
+};
+
+//------------------------------------------------------------------------------
+//
+//  Printing and JSON output:
+//
+static void
+PrintHeader() {
+
+    printf("%-64s %12s %12s %10s %12s\n",
+           "Benchmark", "Time(ms)", "Min(ms)", "Iterations", "Items/s");
+    printf("%s\n", std::string(114, '-').c_str());
+}
+
+//  Memory of the tables of a mesh -- in bytes used and allocated, nested
+//  components indented:
+static void
+PrintMemoryUsage(Far::MemoryUsage const & usage, char const * label,
+                 int depth = 0) {
+
+    std::ostringstream name;
+    name << std::string(2 * depth + 2, ' ') << (label ? label : usage.name);
+    if (usage.index >= 0) {
+        name << " " << usage.index;
+    }
+    printf("%-64s %12zu %12zu\n", name.str().c_str(),
+           usage.used, usage.allocated);
+
+    for (size_t i = 0; i < usage.components.size(); ++i) {
+        PrintMemoryUsage(usage.components[i], 0, depth + 1);
+    }
+}
+
+static void
+PrintMemoryUsage(BenchMesh const & mesh) {
+
+    printf("%-64s %12s %12s\n", ("Memory/" + mesh.name).c_str(),
+           "Used(B)", "Alloc(B)");
+    PrintMemoryUsage(mesh.uniformRefiner->GetMemoryUsage(),
+                     "TopologyRefiner (uniform)");
+    PrintMemoryUsage(mesh.adaptiveRefiner->GetMemoryUsage(),
+                     "TopologyRefiner (adaptive)");
+    PrintMemoryUsage(mesh.stencilTable->GetMemoryUsage(), 0);
+    PrintMemoryUsage(mesh.patchTable->GetMemoryUsage(), 0);
+}
+
+static void
+PrintResult(BenchResult const & result) {
+
+    double itemsPerSecond = (result.meanTime > 0) ?
+        (double)result.items / result.meanTime : 0;
+
+    printf("%-64s %12.4f %12.4f %10d %12.4g\n", result.name.c_str(),
+           result.meanTime * 1000.0, result.minTime * 1000.0,
+           result.iterations, itemsPerSecond);
+}
+
+static std::string
+escapeJSON(std::string const & str) {
+
+    std::string escaped;
+    for (size_t i = 0; i < str.size(); ++i) {
+        if ((str[i] == '"') || (str[i] == '\\')) escaped += '\\';
+        escaped += str[i];
+    }
+    return escaped;
+}
+
+static bool
+WriteJSON(char const * filename, std::vector<BenchResult> const & results,
+          BenchOptions const & options) {
+
+    FILE * fp = fopen(filename, "w");
+    if (!fp) {
+        fprintf(stderr, "Error: cannot open '%s' for writing\n", filename);
+        return false;
+    }
+
+    char date[64];
+    time_t now = time(0);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+    //  One field per line, as expected by ReadJSON() below:
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"context\": {\n");
+    fprintf(fp, "    \"date\": \"%s\",\n", date);
+    fprintf(fp, "    \"library_version\": %d,\n", OPENSUBDIV_VERSION_NUMBER);
+    fprintf(fp, "    \"level\": %d,\n", options.level);
+    fprintf(fp, "    \"resolution\": %d,\n", options.resolution);
+    fprintf(fp, "    \"coords_per_edge\": %d,\n", options.coordsPerEdge);
+    fprintf(fp, "    \"num_threads\": %d,\n", options.numThreads);
+    fprintf(fp, "    \"time_unit\": \"s\"\n");
+    fprintf(fp, "  },\n");
+    fprintf(fp, "  \"benchmarks\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        BenchResult const & result = results[i];
+
+        fprintf(fp, "    {\n");
+        fprintf(fp, "      \"name\": \"%s\",\n",
+                escapeJSON(result.name).c_str());
+        fprintf(fp, "      \"iterations\": %d,\n", result.iterations);
+        fprintf(fp, "      \"real_time\": %.9g,\n", result.meanTime);
+        fprintf(fp, "      \"min_time\": %.9g,\n", result.minTime);
+        fprintf(fp, "      \"items_per_iteration\": %ld,\n", result.items);
+        fprintf(fp, "      \"items_per_second\": %.9g\n",
+                (result.meanTime > 0) ? result.items / result.meanTime : 0);
+        fprintf(fp, "    }%s\n", (i + 1 < results.size()) ? "," : "");
+    }
+    fprintf(fp, "  ]\n");
+    fprintf(fp, "}\n");
+
+    fclose(fp);
+    return true;
+}
+
+//  Reads the mean times of the benchmarks written by WriteJSON():
+static bool
+ReadJSON(char const * filename, std::map<std::string, double> & times) {
+
+    std::ifstream ifs(filename);
+    if (!ifs) {
+        fprintf(stderr, "Error: cannot open '%s'\n", filename);
+        return false;
+    }
+
+    std::string line, name;
+    while (std::getline(ifs, line)) {
+        size_t pos;
+        if ((pos = line.find("\"name\": \"")) != std::string::npos) {
+            pos += 9;
+            name.clear();
+            for (size_t i = pos; (i < line.size()) && (line[i] != '"'); ++i) {
+                if (line[i] == '\\') ++i;
+                if (i < line.size()) name += line[i];
+            }
+        } else if ((pos = line.find("\"real_time\": ")) != std::string::npos) {
+            times[name] = atof(line.c_str() + pos + 13);
+        }
+    }
+    return true;
+}
+
+//  Compares results against a baseline, returning the number of benchmarks
+//  slower than the baseline by more than the given threshold (percent):
+static int
+CompareResults(std::vector<BenchResult> const & results,
+               std::map<std::string, double> const & baseline,
+               double threshold) {
+
+    printf("\n%-64s %12s %12s %9s\n",
+           "Benchmark", "Base(ms)", "Time(ms)", "Change");
+    printf("%s\n", std::string(100, '-').c_str());
+
+    int numRegressions = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        BenchResult const & result = results[i];
+
+        std::map<std::string, double>::const_iterator it =
+            baseline.find(result.name);
+        if (it == baseline.end() || (it->second <= 0)) {
+            printf("%-64s %12s %12.4f %9s\n", result.name.c_str(), "-",
+                   result.meanTime * 1000.0, "new");
+            continue;
+        }
+
+        double change = (result.meanTime - it->second) / it->second * 100.0;
+        bool isRegression = (change > threshold);
+        numRegressions += isRegression;
+
+        printf("%-64s %12.4f %12.4f %+8.1f%%%s\n", result.name.c_str(),
+               it->second * 1000.0, result.meanTime * 1000.0, change,
+               isRegression ? "  REGRESSION" : "");
+    }
+    return numRegressions;
+}
+
+//------------------------------------------------------------------------------
+
+static int
+parseIntArg(char const * argString, int dfltValue = 0) {
+    char *argEndptr;
+    int argValue = (int) strtol(argString, &argEndptr, 10);
+    if (*argEndptr != 0) {
+        fprintf(stderr,
+                "Warning: non-integer option parameter '%s' ignored\n",
+                argString);
+        argValue = dfltValue;
+    }
+    return argValue;
+}
+
+static double
+parseFloatArg(char const * argString, double dfltValue = 0) {
+    char *argEndptr;
+    double argValue = strtod(argString, &argEndptr);
+    if (*argEndptr != 0) {
+        fprintf(stderr,
+                "Warning: non-numeric option parameter '%s' ignored\n",
+                argString);
+        argValue = dfltValue;
+    }
+    return argValue;
+}
+
+static void
+printUsage(char const * program) {
+
+    printf("Usage: %s [options] [file.obj ...]\n"
+           "  -l <level>         refinement level (default 2)\n"
+           "  -res <n>           resolution of the synthetic shapes (default 32)\n"
+           "  -shape <name>      grid, sphere, pole or synthetic (default the\n"
+           "                     first three, unless Obj files are given)\n"
+           "  -xord, -ngons, -nonmanifold, -creases, -corners, -holes,\n"
+           "  -seams <density>   features of the synthetic shape (default 0)\n"
+           "  -open, -seed <n>   open grid / random seed of the synthetic shape\n"
+           "  -coords <n>        n x n coordinates evaluated per face (default 4)\n"
+           "  -filter <str>      run only benchmarks whose name contains str\n"
+           "  -mintime <secs>    minimum time per benchmark (default 0.25)\n"
+           "  -maxiter <n>       maximum iterations per benchmark\n"
+           "  -threads <n>       threads used by the parallel evaluators\n"
+           "  -json <file>       write results as JSON\n"
+           "  -compare <file>    compare with the JSON results of a baseline\n"
+           "  -threshold <pct>   slowdown reported as regression (default 10)\n"
+           "  -memory            report the memory used by the tables of each\n"
+           "                     shape before benchmarking it\n"
+           "  -list              list the benchmarks\n",
+           program);
+}
+
+int main(int argc, char **argv)
+{
+    BenchOptions options;
+    SyntheticMeshOptions syntheticOptions;
+    std::vector<std::string> shapeNames;
+    std::vector<std::string> objFiles;
+    std::string filter;
+    char const * jsonFile = 0;
+    char const * compareFile = 0;
+    bool reportMemory = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strstr(argv[i], ".obj")) {
+            objFiles.push_back(std::string(argv[i]));
+        } else if (!strcmp(argv[i], "-l") && (i + 1 < argc)) {
+            options.level = parseIntArg(argv[++i], options.level);
+        } else if (!strcmp(argv[i], "-res") && (i + 1 < argc)) {
+            options.resolution = parseIntArg(argv[++i], options.resolution);
+        } else if (!strcmp(argv[i], "-shape") && (i + 1 < argc)) {
+            shapeNames.push_back(argv[++i]);
+        } else if (!strcmp(argv[i], "-xord") && (i + 1 < argc)) {
+            syntheticOptions.extraordinaryDensity =
+                (float)parseFloatArg(argv[++i]);
+        } else if (!strcmp(argv[i], "-ngons") && (i + 1 < argc)) {
+            syntheticOptions.ngonDensity = (float)parseFloatArg(argv[++i]);
+        } else if (!strcmp(argv[i], "-nonmanifold") && (i + 1 < argc)) {
+            syntheticOptions.nonManifoldDensity =
+                (float)parseFloatArg(argv[++i]);
+        } else if (!strcmp(argv[i], "-creases") && (i + 1 < argc)) {
+            syntheticOptions.creaseDensity = (float)parseFloatArg(argv[++i]);
+        } else if (!strcmp(argv[i], "-corners") && (i + 1 < argc)) {
+            syntheticOptions.cornerDensity = (float)parseFloatArg(argv[++i]);
+        } else if (!strcmp(argv[i], "-holes") && (i + 1 < argc)) {
+            syntheticOptions.holeDensity = (float)parseFloatArg(argv[++i]);
+        } else if (!strcmp(argv[i], "-seams") && (i + 1 < argc)) {
+            syntheticOptions.fvarSeamDensity = (float)parseFloatArg(argv[++i]);
+        } else if (!strcmp(argv[i], "-open")) {
+            syntheticOptions.closed = false;
+        } else if (!strcmp(argv[i], "-seed") && (i + 1 < argc)) {
+            syntheticOptions.seed = (unsigned)parseIntArg(argv[++i]);
+        } else if (!strcmp(argv[i], "-coords") && (i + 1 < argc)) {
+            options.coordsPerEdge = parseIntArg(argv[++i],
+                                                options.coordsPerEdge);
+        } else if (!strcmp(argv[i], "-filter") && (i + 1 < argc)) {
+            filter = argv[++i];
+        } else if (!strcmp(argv[i], "-mintime") && (i + 1 < argc)) {
+            options.minTime = parseFloatArg(argv[++i], options.minTime);
+        } else if (!strcmp(argv[i], "-maxiter") && (i + 1 < argc)) {
+            options.maxIterations = parseIntArg(argv[++i],
+                                                options.maxIterations);
+        } else if (!strcmp(argv[i], "-threads") && (i + 1 < argc)) {
+            options.numThreads = parseIntArg(argv[++i], options.numThreads);
+        } else if (!strcmp(argv[i], "-json") && (i + 1 < argc)) {
+            jsonFile = argv[++i];
+        } else if (!strcmp(argv[i], "-compare") && (i + 1 < argc)) {
+            compareFile = argv[++i];
+        } else if (!strcmp(argv[i], "-threshold") && (i + 1 < argc)) {
+            options.threshold = parseFloatArg(argv[++i], options.threshold);
+        } else if (!strcmp(argv[i], "-memory")) {
+            reportMemory = true;
+        } else if (!strcmp(argv[i], "-list")) {
+            for (int j = 0; j < g_numBenchmarks; ++j) {
+                printf("%s\n", g_benchmarks[j].name);
+            }
+            return 0;
+        } else if (!strcmp(argv[i], "-h") || !strcmp(argv[i], "-help")) {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            fprintf(stderr,
+                "Warning: unrecognized argument '%s' ignored\n", argv[i]);
+        }
+    }
+    options.level = std::max(options.level, 1);
+    options.resolution = std::max(options.resolution, 2);
+    options.coordsPerEdge = std::max(options.coordsPerEdge, 1);
+    options.maxIterations = std::max(options.maxIterations, 1);
+
+    std::map<std::string, double> baseline;
+    if (compareFile && !ReadJSON(compareFile, baseline)) {
+        return 1;
+    }
+
+    if (options.numThreads > 0) {
+#ifdef OPENSUBDIV_HAS_OPENMP
+        Osd::OmpEvaluator::SetNumThreads(options.numThreads);
+#endif
+#ifdef OPENSUBDIV_HAS_TBB
+        Osd::TbbEvaluator::SetNumThreads(options.numThreads);
+#endif
+        Osd::ThreadPoolEvaluator::SetNumThreads(options.numThreads);
+    }
+
+    //  Gather the shapes -- Obj files or the procedural shapes:
+    struct BenchShape {
+        std::string     name;
+        Shape *         shape;
+        SyntheticMesh * syntheticMesh;
+        ObjMesh *       objMesh;
+    };
+    std::vector<BenchShape> shapes;
+
+    for (size_t i = 0; i < objFiles.size(); ++i) {
+        char const * objFile = objFiles[i].c_str();
+        ObjMesh * objMesh = ObjMesh::Read(objFile, options.numThreads);
+        if (objMesh && objMesh->GetNumFaces()) {
+            BenchShape benchShape = { objFiles[i], 0, 0, objMesh };
+            shapes.push_back(benchShape);
+        } else {
+            fprintf(stderr, "Warning: cannot load shape file '%s'\n", objFile);
+            delete objMesh;
+        }
+    }
+    if (objFiles.empty() && shapeNames.empty()) {
+        shapeNames.push_back("grid");
+        shapeNames.push_back("sphere");
+        shapeNames.push_back("pole");
+    }
+
+    int res = options.resolution;
+    for (size_t i = 0; i < shapeNames.size(); ++i) {
+        std::ostringstream name;
+        Shape * shape = 0;
+        SyntheticMesh * syntheticMesh = 0;
+        if (shapeNames[i] == "grid") {
+            name << "grid_" << res;
+            shape = createGridShape(res);
+        } else if (shapeNames[i] == "sphere") {
+            //  Half the resolution on each of the six sides of the cube:
+            name << "sphere_" << res;
+            shape = createSphereShape(std::max(res / 2, 1));
+        } else if (shapeNames[i] == "pole") {
+            name << "pole_" << res;
+            shape = createPoleShape(res, std::max(res / 4, 2));
+        } else if (shapeNames[i] == "synthetic") {
+            //  Mesh of the given resolution with the specified features:
+            syntheticOptions.numFaces = res * res;
+            name << "synthetic_" << res;
+            syntheticMesh = SyntheticMesh::Create(syntheticOptions);
+        } else {
+            fprintf(stderr, "Warning: unknown shape '%s' ignored\n",
+                    shapeNames[i].c_str());
+            continue;
+        }
+        BenchShape benchShape = { name.str(), shape, syntheticMesh, 0 };
+        shapes.push_back(benchShape);
+    }
+
+    //  Run the selected benchmarks on each shape:
+    std::vector<BenchResult> results;
+
+    PrintHeader();
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        BenchMesh * mesh = createBenchMesh(shapes[i].name, shapes[i].shape,
+                                           shapes[i].syntheticMesh,
+                                           shapes[i].objMesh, options);
+        if (reportMemory) {
+            PrintMemoryUsage(*mesh);
+        }
+
+        for (int j = 0; j < g_numBenchmarks; ++j) {
+            std::ostringstream name;
+            name << g_benchmarks[j].name << "/" << mesh->name
+                 << "/" << options.level;
+
+            if (!filter.empty() &&
+                (name.str().find(filter) == std::string::npos)) {
+                continue;
+            }
+
+            BenchState state(options.minTime, options.maxIterations);
+            g_benchmarks[j].func(state, *mesh);
+
+            BenchResult result;
+            result.name       = name.str();
+            result.iterations = state.GetIterations();
+            result.meanTime   = state.GetMeanTime();
+            result.minTime    = state.GetMinTime();
+            result.items      = state.GetItemsProcessed();
+
+            PrintResult(result);
+            results.push_back(result);
+        }
+        delete mesh;
+    }
+
+    if (jsonFile && !WriteJSON(jsonFile, results, options)) {
+        return 1;
+    }
+
+    if (compareFile) {
+        int numRegressions =
+            CompareResults(results, baseline, options.threshold);
+        if (numRegressions) {
+            printf("\n%d benchmark(s) slower than the baseline by more "
+                   "than %g%%\n", numRegressions, options.threshold);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------